@@ -0,0 +1,316 @@
+// Minimal educational glTF 2.0 loader (C11).
+//
+// This module implements the synthetic scene generators used by gltf_bench.
+//
+// Responsibilities:
+//   - build JSON text with a small growable string builder
+//   - pack a JSON chunk and a BIN chunk into a GLB container
+//   - encode buffer payloads as base64 data: URIs
+//
+// Notes:
+//   - Output is deterministic for a given set of arguments so runs compare.
+//   - Only the public gltf.h API is used by gltf_bench; nothing here depends on
+//     the library.
+
+#include "bench_gen.h"
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ----------------------------------------------------------------------------
+// String builder
+// ----------------------------------------------------------------------------
+
+typedef struct bench_sb {
+  char* data;
+  size_t len;
+  size_t cap;
+  int failed;
+} bench_sb;
+
+static int bench_sb_reserve(bench_sb* sb, size_t extra) {
+  if (sb->failed) return 0;
+  if (sb->len + extra + 1u <= sb->cap) return 1;
+  size_t cap = sb->cap ? sb->cap : 4096u;
+  while (cap < sb->len + extra + 1u) cap *= 2u;
+  char* p = (char*)realloc(sb->data, cap);
+  if (!p) {
+    sb->failed = 1;
+    return 0;
+  }
+  sb->data = p;
+  sb->cap = cap;
+  return 1;
+}
+
+static void bench_sb_printf(bench_sb* sb, const char* fmt, ...) {
+  va_list ap;
+  va_start(ap, fmt);
+  const int n = vsnprintf(NULL, 0, fmt, ap);
+  va_end(ap);
+  if (n < 0 || !bench_sb_reserve(sb, (size_t)n)) {
+    sb->failed = 1;
+    return;
+  }
+  va_start(ap, fmt);
+  (void)vsnprintf(sb->data + sb->len, (size_t)n + 1u, fmt, ap);
+  va_end(ap);
+  sb->len += (size_t)n;
+}
+
+static void bench_sb_free(bench_sb* sb) {
+  free(sb->data);
+  memset(sb, 0, sizeof *sb);
+}
+
+// ----------------------------------------------------------------------------
+// Containers
+// ----------------------------------------------------------------------------
+
+static void bench_write_u32_le(uint8_t* p, uint32_t v) {
+  p[0] = (uint8_t)(v & 0xFFu);
+  p[1] = (uint8_t)((v >> 8u) & 0xFFu);
+  p[2] = (uint8_t)((v >> 16u) & 0xFFu);
+  p[3] = (uint8_t)((v >> 24u) & 0xFFu);
+}
+
+// Allocates a GLB with room for bin_len BIN bytes and writes the header and the
+// JSON chunk; the BIN payload is left for the caller at *out_bin (zeroed).
+static int bench_glb_begin(const bench_sb* json, size_t bin_len, bench_blob* out, uint8_t** out_bin) {
+  const size_t json_padded = (json->len + 3u) & ~(size_t)3u;
+  const size_t bin_padded = (bin_len + 3u) & ~(size_t)3u;
+  const size_t total = 12u + 8u + json_padded + 8u + bin_padded;
+  if (total > UINT32_MAX) return 0;
+
+  uint8_t* glb = (uint8_t*)calloc(1, total);
+  if (!glb) return 0;
+  bench_write_u32_le(glb + 0, 0x46546C67u); // 'glTF'
+  bench_write_u32_le(glb + 4, 2u);
+  bench_write_u32_le(glb + 8, (uint32_t)total);
+
+  size_t off = 12u;
+  bench_write_u32_le(glb + off + 0, (uint32_t)json_padded);
+  bench_write_u32_le(glb + off + 4, 0x4E4F534Au); // 'JSON'
+  off += 8u;
+  memcpy(glb + off, json->data, json->len);
+  memset(glb + off + json->len, 0x20, json_padded - json->len);
+  off += json_padded;
+
+  bench_write_u32_le(glb + off + 0, (uint32_t)bin_padded);
+  bench_write_u32_le(glb + off + 4, 0x004E4942u); // 'BIN\0'
+  off += 8u;
+
+  out->data = glb;
+  out->size = total;
+  *out_bin = glb + off;
+  return 1;
+}
+
+static int bench_blob_from_sb(bench_sb* sb, bench_blob* out) {
+  if (sb->failed) {
+    bench_sb_free(sb);
+    return 0;
+  }
+  out->data = (uint8_t*)sb->data;
+  out->size = sb->len;
+  memset(sb, 0, sizeof *sb);
+  return 1;
+}
+
+static const char k_bench_b64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Appends the base64 encoding of src[0, n) to sb.
+static void bench_sb_base64(bench_sb* sb, const uint8_t* src, size_t n) {
+  if (!bench_sb_reserve(sb, (n + 2u) / 3u * 4u)) return;
+  char* dst = sb->data + sb->len;
+  size_t i = 0;
+  for (; i + 3u <= n; i += 3u) {
+    const uint32_t v = ((uint32_t)src[i] << 16u) | ((uint32_t)src[i + 1u] << 8u) | src[i + 2u];
+    *dst++ = k_bench_b64[(v >> 18u) & 63u];
+    *dst++ = k_bench_b64[(v >> 12u) & 63u];
+    *dst++ = k_bench_b64[(v >> 6u) & 63u];
+    *dst++ = k_bench_b64[v & 63u];
+  }
+  if (i < n) {
+    uint32_t v = (uint32_t)src[i] << 16u;
+    if (i + 1u < n) v |= (uint32_t)src[i + 1u] << 8u;
+    *dst++ = k_bench_b64[(v >> 18u) & 63u];
+    *dst++ = k_bench_b64[(v >> 12u) & 63u];
+    *dst++ = i + 1u < n ? k_bench_b64[(v >> 6u) & 63u] : '=';
+    *dst++ = '=';
+  }
+  sb->len = (size_t)(dst - sb->data);
+  sb->data[sb->len] = '\0';
+}
+
+// ----------------------------------------------------------------------------
+// Generators
+// ----------------------------------------------------------------------------
+
+int bench_gen_mesh_glb(uint32_t grid, bench_blob* out) {
+  if (!out || grid == 0u || grid > 8192u) return 0;
+  memset(out, 0, sizeof *out);
+
+  const size_t side = (size_t)grid + 1u;
+  const size_t vcount = side * side;
+  const size_t icount = (size_t)grid * grid * 6u;
+  const size_t pos_off = 0;
+  const size_t nrm_off = pos_off + vcount * 12u;
+  const size_t uv_off = nrm_off + vcount * 12u;
+  const size_t idx_off = uv_off + vcount * 8u;
+  const size_t bin_len = idx_off + icount * 4u;
+
+  bench_sb json = {0};
+  bench_sb_printf(&json,
+                  "{\"asset\":{\"version\":\"2.0\",\"generator\":\"gltf_bench\"},"
+                  "\"scene\":0,\"scenes\":[{\"nodes\":[0]}],\"nodes\":[{\"mesh\":0}],"
+                  "\"meshes\":[{\"primitives\":[{\"attributes\":"
+                  "{\"POSITION\":0,\"NORMAL\":1,\"TEXCOORD_0\":2},\"indices\":3}]}],"
+                  "\"buffers\":[{\"byteLength\":%zu}],\"bufferViews\":["
+                  "{\"buffer\":0,\"byteOffset\":%zu,\"byteLength\":%zu,\"target\":34962},"
+                  "{\"buffer\":0,\"byteOffset\":%zu,\"byteLength\":%zu,\"target\":34962},"
+                  "{\"buffer\":0,\"byteOffset\":%zu,\"byteLength\":%zu,\"target\":34962},"
+                  "{\"buffer\":0,\"byteOffset\":%zu,\"byteLength\":%zu,\"target\":34963}],"
+                  "\"accessors\":["
+                  "{\"bufferView\":0,\"componentType\":5126,\"count\":%zu,\"type\":\"VEC3\","
+                  "\"min\":[0,0,0],\"max\":[%u,0,%u]},"
+                  "{\"bufferView\":1,\"componentType\":5126,\"count\":%zu,\"type\":\"VEC3\"},"
+                  "{\"bufferView\":2,\"componentType\":5126,\"count\":%zu,\"type\":\"VEC2\"},"
+                  "{\"bufferView\":3,\"componentType\":5125,\"count\":%zu,\"type\":\"SCALAR\"}]}",
+                  bin_len,
+                  pos_off, vcount * 12u, nrm_off, vcount * 12u, uv_off, vcount * 8u, idx_off, icount * 4u,
+                  vcount, grid, grid, vcount, vcount, icount);
+  if (json.failed) {
+    bench_sb_free(&json);
+    return 0;
+  }
+
+  uint8_t* bin = NULL;
+  const int ok = bench_glb_begin(&json, bin_len, out, &bin);
+  bench_sb_free(&json);
+  if (!ok) return 0;
+
+  const float inv = 1.0f / (float)grid;
+  for (size_t z = 0; z < side; z++) {
+    for (size_t x = 0; x < side; x++) {
+      const size_t v = z * side + x;
+      const float pos[3] = { (float)x, 0.0f, (float)z };
+      const float nrm[3] = { 0.0f, 1.0f, 0.0f };
+      const float uv[2] = { (float)x * inv, (float)z * inv };
+      memcpy(bin + pos_off + v * 12u, pos, sizeof pos);
+      memcpy(bin + nrm_off + v * 12u, nrm, sizeof nrm);
+      memcpy(bin + uv_off + v * 8u, uv, sizeof uv);
+    }
+  }
+  uint8_t* idx = bin + idx_off;
+  for (size_t z = 0; z < grid; z++) {
+    for (size_t x = 0; x < grid; x++) {
+      const uint32_t a = (uint32_t)(z * side + x);
+      const uint32_t b = a + 1u;
+      const uint32_t c = a + (uint32_t)side;
+      const uint32_t d = c + 1u;
+      const uint32_t quad[6] = { a, c, b, b, c, d };
+      memcpy(idx, quad, sizeof quad);
+      idx += sizeof quad;
+    }
+  }
+  return 1;
+}
+
+int bench_gen_hierarchy_gltf(uint32_t width, uint32_t depth, bench_blob* out) {
+  if (!out || width == 0u || depth == 0u || (uint64_t)width * depth >= UINT32_MAX) return 0;
+  memset(out, 0, sizeof *out);
+
+  bench_sb json = {0};
+  bench_sb_printf(&json,
+                  "{\"asset\":{\"version\":\"2.0\",\"generator\":\"gltf_bench\"},"
+                  "\"scene\":0,\"scenes\":[{\"nodes\":[0]}],\"nodes\":[{\"name\":\"root\",\"children\":[");
+  for (uint32_t c = 0; c < width && !json.failed; c++) {
+    bench_sb_printf(&json, c ? ",%u" : "%u", 1u + c * depth);
+  }
+  bench_sb_printf(&json, "]}");
+
+  // Node 1 + c * depth + d is level d of chain c.
+  for (uint32_t c = 0; c < width && !json.failed; c++) {
+    for (uint32_t d = 0; d < depth && !json.failed; d++) {
+      const uint32_t self = 1u + c * depth + d;
+      bench_sb_printf(&json,
+                      ",{\"name\":\"n%u\",\"translation\":[%u,%u,0.5],"
+                      "\"rotation\":[0,0.0499792,0,0.9987503],\"scale\":[1,1.001,1]",
+                      self, c % 97u, d % 89u);
+      if (d + 1u < depth) bench_sb_printf(&json, ",\"children\":[%u]", self + 1u);
+      bench_sb_printf(&json, "}");
+    }
+  }
+  bench_sb_printf(&json, "]}");
+  return bench_blob_from_sb(&json, out);
+}
+
+int bench_gen_datauri_gltf(uint32_t buffer_count, uint32_t buffer_bytes, bench_blob* out) {
+  if (!out || buffer_count == 0u || buffer_bytes < 4u) return 0;
+  memset(out, 0, sizeof *out);
+
+  buffer_bytes &= ~3u;
+  uint8_t* payload = (uint8_t*)malloc(buffer_bytes);
+  if (!payload) return 0;
+
+  bench_sb json = {0};
+  bench_sb_printf(&json, "{\"asset\":{\"version\":\"2.0\",\"generator\":\"gltf_bench\"},\"buffers\":[");
+  for (uint32_t b = 0; b < buffer_count && !json.failed; b++) {
+    for (uint32_t i = 0; i < buffer_bytes / 4u; i++) {
+      const float f = (float)(b + i);
+      memcpy(payload + i * 4u, &f, sizeof f);
+    }
+    bench_sb_printf(&json, "%s{\"byteLength\":%u,\"uri\":\"data:application/octet-stream;base64,",
+                    b ? "," : "", buffer_bytes);
+    bench_sb_base64(&json, payload, buffer_bytes);
+    bench_sb_printf(&json, "\"}");
+  }
+  free(payload);
+
+  bench_sb_printf(&json, "],\"bufferViews\":[");
+  for (uint32_t b = 0; b < buffer_count && !json.failed; b++) {
+    bench_sb_printf(&json, "%s{\"buffer\":%u,\"byteLength\":%u}", b ? "," : "", b, buffer_bytes);
+  }
+  bench_sb_printf(&json, "],\"accessors\":[");
+  for (uint32_t b = 0; b < buffer_count && !json.failed; b++) {
+    bench_sb_printf(&json, "%s{\"bufferView\":%u,\"componentType\":5126,\"count\":%u,\"type\":\"SCALAR\"}",
+                    b ? "," : "", b, buffer_bytes / 4u);
+  }
+  bench_sb_printf(&json, "]}");
+  return bench_blob_from_sb(&json, out);
+}
+
+int bench_gen_image_glb(const uint8_t* png, size_t png_size, bench_blob* out) {
+  if (!out || !png || png_size == 0u) return 0;
+  memset(out, 0, sizeof *out);
+
+  bench_sb json = {0};
+  bench_sb_printf(&json,
+                  "{\"asset\":{\"version\":\"2.0\",\"generator\":\"gltf_bench\"},"
+                  "\"buffers\":[{\"byteLength\":%zu}],"
+                  "\"bufferViews\":[{\"buffer\":0,\"byteLength\":%zu}],"
+                  "\"images\":[{\"bufferView\":0,\"mimeType\":\"image/png\"}]}",
+                  png_size, png_size);
+  if (json.failed) {
+    bench_sb_free(&json);
+    return 0;
+  }
+
+  uint8_t* bin = NULL;
+  const int ok = bench_glb_begin(&json, png_size, out, &bin);
+  bench_sb_free(&json);
+  if (!ok) return 0;
+  memcpy(bin, png, png_size);
+  return 1;
+}
+
+void bench_blob_free(bench_blob* b) {
+  if (!b) return;
+  free(b->data);
+  b->data = NULL;
+  b->size = 0;
+}
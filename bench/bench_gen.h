@@ -0,0 +1,41 @@
+// Minimal educational glTF 2.0 loader (C11).
+//
+// Synthetic inputs for gltf_bench.
+//
+// Every generator builds a complete file in memory (deterministic contents,
+// sized by its arguments) and returns it as a malloc()'d blob; gltf_bench
+// writes the blobs to disk for the file loaders.
+
+#ifndef GLTF_BENCH_GEN_H
+#define GLTF_BENCH_GEN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct bench_blob {
+  uint8_t* data; // malloc()'d, free via bench_blob_free()
+  size_t size;
+} bench_blob;
+
+// .glb with one indexed triangle mesh over a grid x grid quad grid:
+// (grid + 1)^2 vertices (POSITION, NORMAL, TEXCOORD_0 as f32) and
+// 2 * grid^2 triangles (u32 indices). Returns 0 on failure.
+int bench_gen_mesh_glb(uint32_t grid, bench_blob* out);
+
+// .gltf with no buffers and width chains of depth nodes under one root
+// (width * depth + 1 nodes), each node with a translation / rotation / scale.
+// Returns 0 on failure.
+int bench_gen_hierarchy_gltf(uint32_t width, uint32_t depth, bench_blob* out);
+
+// .gltf with buffer_count data: URI buffers of buffer_bytes bytes each (base64),
+// one bufferView and one f32 SCALAR accessor per buffer. Returns 0 on failure.
+int bench_gen_datauri_gltf(uint32_t buffer_count, uint32_t buffer_bytes, bench_blob* out);
+
+// .glb with one image stored in a bufferView (png: encoded image bytes).
+// Returns 0 on failure.
+int bench_gen_image_glb(const uint8_t* png, size_t png_size, bench_blob* out);
+
+// Frees a blob's bytes and clears it. Safe to call with NULL.
+void bench_blob_free(bench_blob* b);
+
+#endif // GLTF_BENCH_GEN_H
@@ -0,0 +1,570 @@
+// Minimal educational glTF 2.0 loader (C11).
+//
+// gltf_bench: loader and query throughput on synthetic scenes.
+//
+// Usage:
+//   gltf_bench [--scale S] [--iterations N] [--dir DIR] [--out FILE]
+//
+//   --scale       multiplies every scene size (default 1: a 1M vertex / 2M
+//                 triangle mesh, 100k nodes, 256 x 64 KiB data: URI buffers
+//                 and a 1 Mpixel PNG)
+//   --iterations  timed runs per benchmark (default 5); best and mean are kept
+//   --dir         where the generated files are written (default ".")
+//   --out         JSON report path (default stdout)
+//
+// The report is one JSON object: the configuration, one entry per benchmark
+// (seconds, MB/s over the input bytes, items/s in the benchmark's unit, bytes
+// allocated through the document allocator at peak) and the process peak RSS.
+
+// clock_gettime/getrusage are POSIX, not C11; request them explicitly (before any include).
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "gltf/gltf.h"
+
+#include "bench_gen.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <time.h>
+#endif
+
+#ifndef GLTF_ENABLE_IMAGES
+#define GLTF_ENABLE_IMAGES 0
+#endif
+
+// ----------------------------------------------------------------------------
+// Platform
+// ----------------------------------------------------------------------------
+
+static double bench_now(void) {
+#ifdef _WIN32
+  LARGE_INTEGER freq, t;
+  QueryPerformanceFrequency(&freq);
+  QueryPerformanceCounter(&t);
+  return (double)t.QuadPart / (double)freq.QuadPart;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+// Peak resident set size of the process so far, 0 if unknown.
+static uint64_t bench_peak_rss(void) {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS pmc;
+  if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof pmc)) return 0;
+  return (uint64_t)pmc.PeakWorkingSetSize;
+#else
+  struct rusage ru;
+  if (getrusage(RUSAGE_SELF, &ru) != 0) return 0;
+#ifdef __APPLE__
+  return (uint64_t)ru.ru_maxrss; // bytes
+#else
+  return (uint64_t)ru.ru_maxrss * 1024u; // KiB
+#endif
+#endif
+}
+
+static int bench_write_file(const char* path, const bench_blob* b) {
+  FILE* f = fopen(path, "wb");
+  if (!f) return 0;
+  const int ok = fwrite(b->data, 1, b->size, f) == b->size;
+  return fclose(f) == 0 && ok;
+}
+
+static int bench_read_file(const char* path, bench_blob* out) {
+  memset(out, 0, sizeof *out);
+  FILE* f = fopen(path, "rb");
+  if (!f) return 0;
+  int ok = fseek(f, 0, SEEK_END) == 0;
+  const long n = ok ? ftell(f) : -1;
+  ok = n > 0 && fseek(f, 0, SEEK_SET) == 0;
+  if (ok) {
+    out->data = (uint8_t*)malloc((size_t)n);
+    ok = out->data && fread(out->data, 1, (size_t)n, f) == (size_t)n;
+    out->size = ok ? (size_t)n : 0u;
+  }
+  fclose(f);
+  if (!ok) bench_blob_free(out);
+  return ok;
+}
+
+// ----------------------------------------------------------------------------
+// Counting allocator (document block + JSON tree)
+// ----------------------------------------------------------------------------
+
+// Each block is prefixed with its size so free() can account for it.
+typedef struct bench_alloc_stats {
+  size_t live;
+  size_t peak;
+} bench_alloc_stats;
+
+#define BENCH_ALLOC_HDR 16u
+
+static void* bench_alloc_malloc(void* user, size_t size) {
+  bench_alloc_stats* s = (bench_alloc_stats*)user;
+  uint8_t* p = (uint8_t*)malloc(size + BENCH_ALLOC_HDR);
+  if (!p) return NULL;
+  memcpy(p, &size, sizeof size);
+  s->live += size;
+  if (s->live > s->peak) s->peak = s->live;
+  return p + BENCH_ALLOC_HDR;
+}
+
+static void bench_alloc_free(void* user, void* ptr) {
+  bench_alloc_stats* s = (bench_alloc_stats*)user;
+  uint8_t* p = (uint8_t*)ptr - BENCH_ALLOC_HDR;
+  size_t size;
+  memcpy(&size, p, sizeof size);
+  s->live -= size;
+  free(p);
+}
+
+static void* bench_alloc_realloc(void* user, void* ptr, size_t old_size, size_t size) {
+  (void)old_size;
+  if (!ptr) return bench_alloc_malloc(user, size);
+  bench_alloc_stats* s = (bench_alloc_stats*)user;
+  uint8_t* p = (uint8_t*)ptr - BENCH_ALLOC_HDR;
+  size_t prev;
+  memcpy(&prev, p, sizeof prev);
+  uint8_t* q = (uint8_t*)realloc(p, size + BENCH_ALLOC_HDR);
+  if (!q) return NULL;
+  memcpy(q, &size, sizeof size);
+  s->live = s->live - prev + size;
+  if (s->live > s->peak) s->peak = s->live;
+  return q + BENCH_ALLOC_HDR;
+}
+
+// ----------------------------------------------------------------------------
+// Benchmarks
+// ----------------------------------------------------------------------------
+
+typedef struct bench_ctx {
+  uint32_t iterations;
+  FILE* out;
+  uint32_t result_count;
+
+  char mesh_path[1024];
+  char datauri_path[1024];
+  char hierarchy_path[1024];
+  bench_blob mesh_glb;
+  bench_blob image_glb;
+  size_t datauri_size;
+  size_t hierarchy_size;
+
+  uint32_t mesh_vertices;
+  uint32_t mesh_tris;
+  uint32_t hierarchy_nodes;
+  uint32_t image_pixels;
+} bench_ctx;
+
+// One timed operation: run() does the measured work for that iteration,
+// setup()/teardown() (optional) run around it untimed.
+typedef struct bench_case {
+  const char* name;
+  const char* unit;  // what items counts ("vertices", "tris", "nodes", ...)
+  uint64_t bytes;    // input bytes per iteration (0 = no MB/s)
+  uint64_t items;    // items per iteration (0 = no items/s)
+  int (*setup)(bench_ctx* ctx, void* state);
+  int (*run)(bench_ctx* ctx, void* state, gltf_error* err);
+  void (*teardown)(bench_ctx* ctx, void* state);
+  void* state;
+  bench_alloc_stats* alloc; // reported as alloc_peak_bytes when non-NULL
+} bench_case;
+
+static void bench_fail(const char* what, const gltf_error* err) {
+  const char* msg = err && err->message ? err->message : "unknown error";
+  const char* epath = err && err->path ? err->path : "";
+  fprintf(stderr, "gltf_bench: %s: %s path=%s\n", what, msg, epath);
+}
+
+static int bench_run_case(bench_ctx* ctx, const bench_case* c) {
+  double best = 0.0, total = 0.0;
+  if (c->alloc) memset(c->alloc, 0, sizeof *c->alloc);
+  for (uint32_t it = 0; it < ctx->iterations; it++) {
+    gltf_error err = {0};
+    if (c->setup && !c->setup(ctx, c->state)) {
+      bench_fail(c->name, NULL);
+      return 0;
+    }
+    const double t0 = bench_now();
+    const int ok = c->run(ctx, c->state, &err);
+    const double dt = bench_now() - t0;
+    if (c->teardown) c->teardown(ctx, c->state);
+    if (!ok) {
+      bench_fail(c->name, &err);
+      return 0;
+    }
+    total += dt;
+    if (it == 0 || dt < best) best = dt;
+  }
+  if (best <= 0.0) best = 1e-9;
+
+  fprintf(ctx->out, "%s\n    {\"name\":\"%s\",\"iterations\":%u,\"best_s\":%.9f,\"mean_s\":%.9f",
+          ctx->result_count ? "," : "", c->name, ctx->iterations, best, total / ctx->iterations);
+  if (c->bytes) {
+    fprintf(ctx->out, ",\"bytes\":%llu,\"mb_per_s\":%.3f",
+            (unsigned long long)c->bytes, (double)c->bytes / best / 1e6);
+  }
+  if (c->items) {
+    fprintf(ctx->out, ",\"unit\":\"%s\",\"items\":%llu,\"items_per_s\":%.1f",
+            c->unit, (unsigned long long)c->items, (double)c->items / best);
+  }
+  if (c->alloc) fprintf(ctx->out, ",\"alloc_peak_bytes\":%zu", c->alloc->peak);
+  fprintf(ctx->out, ",\"peak_rss_bytes\":%llu}", (unsigned long long)bench_peak_rss());
+  fflush(ctx->out);
+  ctx->result_count++;
+  return 1;
+}
+
+// Loads: state is a bench_load.
+typedef struct bench_load {
+  const char* path;           // gltf_load_file_ex() when set
+  const bench_blob* bytes;    // otherwise gltf_load_glb_bytes_ex()
+  bench_alloc_stats stats;
+  gltf_allocator allocator;
+  gltf_doc* doc;
+} bench_load;
+
+static int bench_load_run(bench_ctx* ctx, void* state, gltf_error* err) {
+  (void)ctx;
+  bench_load* l = (bench_load*)state;
+  gltf_load_options opts;
+  memset(&opts, 0, sizeof opts);
+  opts.allocator = &l->allocator;
+  const gltf_result r = l->path ? gltf_load_file_ex(l->path, &opts, &l->doc, err)
+                                : gltf_load_glb_bytes_ex(l->bytes->data, l->bytes->size, &opts, &l->doc, err);
+  return r == GLTF_OK;
+}
+
+static void bench_load_teardown(bench_ctx* ctx, void* state) {
+  (void)ctx;
+  bench_load* l = (bench_load*)state;
+  gltf_free(l->doc);
+  l->doc = NULL;
+}
+
+static void bench_load_init(bench_load* l, const char* path, const bench_blob* bytes) {
+  memset(l, 0, sizeof *l);
+  l->path = path;
+  l->bytes = bytes;
+  l->allocator.malloc = bench_alloc_malloc;
+  l->allocator.realloc = bench_alloc_realloc;
+  l->allocator.free = bench_alloc_free;
+  l->allocator.user = &l->stats;
+}
+
+// Queries on a loaded document: state is a bench_query.
+typedef struct bench_query {
+  const gltf_doc* doc;
+  float* floats;
+  uint32_t count;
+  uint64_t checksum; // keeps the work observable
+  gltf_world_cache* cache;
+  gltf_image_pixels pixels;
+} bench_query;
+
+static int bench_decode_run(bench_ctx* ctx, void* state, gltf_error* err) {
+  (void)ctx;
+  bench_query* q = (bench_query*)state;
+  if (gltf_accessor_read_f32_range(q->doc, 0, 0, q->count, q->floats, 3, err) != GLTF_OK) return 0;
+  q->checksum += (uint64_t)q->floats[q->count * 3u - 1u];
+  return 1;
+}
+
+static gltf_iter_result bench_tri_cb(const gltf_tri* tris, uint32_t tri_first, uint32_t tri_count, void* user) {
+  (void)tri_first;
+  uint64_t* sum = (uint64_t*)user;
+  for (uint32_t i = 0; i < tri_count; i++) *sum += tris[i].i0 ^ tris[i].i1 ^ tris[i].i2;
+  return GLTF_ITER_CONTINUE;
+}
+
+static int bench_tris_run(bench_ctx* ctx, void* state, gltf_error* err) {
+  (void)ctx;
+  bench_query* q = (bench_query*)state;
+  return gltf_doc_primitive_iterate_triangle_batches(q->doc, 0, 0, bench_tri_cb, &q->checksum, err) == GLTF_OK;
+}
+
+static int bench_world_setup(bench_ctx* ctx, void* state) {
+  (void)ctx;
+  bench_query* q = (bench_query*)state;
+  return gltf_world_cache_create(q->doc, &q->cache, NULL) == GLTF_OK;
+}
+
+static int bench_world_run(bench_ctx* ctx, void* state, gltf_error* err) {
+  (void)ctx;
+  bench_query* q = (bench_query*)state;
+  return gltf_compute_world_matrices(q->doc, 0, q->cache, err) == GLTF_OK;
+}
+
+static void bench_world_teardown(bench_ctx* ctx, void* state) {
+  (void)ctx;
+  bench_query* q = (bench_query*)state;
+  gltf_world_cache_free(q->cache);
+  q->cache = NULL;
+}
+
+static int bench_image_run(bench_ctx* ctx, void* state, gltf_error* err) {
+  (void)ctx;
+  bench_query* q = (bench_query*)state;
+  return gltf_image_decode_rgba8(q->doc, 0, &q->pixels, err) == GLTF_OK;
+}
+
+static void bench_image_teardown(bench_ctx* ctx, void* state) {
+  (void)ctx;
+  bench_query* q = (bench_query*)state;
+  gltf_image_pixels_free(&q->pixels);
+}
+
+// ----------------------------------------------------------------------------
+// Scene generation
+// ----------------------------------------------------------------------------
+
+static uint32_t bench_isqrt(uint64_t v) {
+  uint64_t r = 0;
+  while ((r + 1u) * (r + 1u) <= v) r++;
+  return (uint32_t)r;
+}
+
+static uint32_t bench_scaled(double base, double scale, uint32_t min_value) {
+  const double v = base * scale;
+  return v < (double)min_value ? min_value : v > 4e9 ? 4000000000u : (uint32_t)v;
+}
+
+static int bench_generate(bench_ctx* ctx, const char* dir, double scale) {
+  gltf_error err = {0};
+  bench_blob b = {0};
+
+  const uint32_t grid = bench_isqrt(bench_scaled(1e6, scale, 64u));
+  if (!bench_gen_mesh_glb(grid, &ctx->mesh_glb)) return 0;
+  ctx->mesh_vertices = (grid + 1u) * (grid + 1u);
+  ctx->mesh_tris = grid * grid * 2u;
+  (void)snprintf(ctx->mesh_path, sizeof ctx->mesh_path, "%s/bench_mesh.glb", dir);
+  if (!bench_write_file(ctx->mesh_path, &ctx->mesh_glb)) return 0;
+
+  const uint32_t width = bench_scaled(1000.0, scale, 1u);
+  const uint32_t depth = 100u;
+  if (!bench_gen_hierarchy_gltf(width, depth, &b)) return 0;
+  ctx->hierarchy_nodes = width * depth + 1u;
+  ctx->hierarchy_size = b.size;
+  (void)snprintf(ctx->hierarchy_path, sizeof ctx->hierarchy_path, "%s/bench_hierarchy.gltf", dir);
+  const int hier_ok = bench_write_file(ctx->hierarchy_path, &b);
+  bench_blob_free(&b);
+  if (!hier_ok) return 0;
+
+  if (!bench_gen_datauri_gltf(bench_scaled(256.0, scale, 1u), 64u * 1024u, &b)) return 0;
+  ctx->datauri_size = b.size;
+  (void)snprintf(ctx->datauri_path, sizeof ctx->datauri_path, "%s/bench_datauri.gltf", dir);
+  const int uri_ok = bench_write_file(ctx->datauri_path, &b);
+  bench_blob_free(&b);
+  if (!uri_ok) return 0;
+
+#if GLTF_ENABLE_IMAGES
+  // A smooth gradient with some noise so the PNG does not collapse to nothing.
+  const uint32_t side = bench_isqrt(bench_scaled(1024.0 * 1024.0, scale, 256u));
+  uint8_t* rgba = (uint8_t*)malloc((size_t)side * side * 4u);
+  if (!rgba) return 0;
+  uint32_t seed = 0x12345678u;
+  for (uint32_t y = 0; y < side; y++) {
+    for (uint32_t x = 0; x < side; x++) {
+      seed = seed * 1664525u + 1013904223u;
+      uint8_t* p = rgba + ((size_t)y * side + x) * 4u;
+      p[0] = (uint8_t)(x * 255u / side);
+      p[1] = (uint8_t)(y * 255u / side);
+      p[2] = (uint8_t)(seed >> 28u);
+      p[3] = 255u;
+    }
+  }
+  char png_path[1024];
+  (void)snprintf(png_path, sizeof png_path, "%s/bench_image.png", dir);
+  const gltf_result wr = gltf_write_png_rgba8(png_path, side, side, rgba, &err);
+  free(rgba);
+  if (wr != GLTF_OK) {
+    bench_fail("gltf_write_png_rgba8", &err);
+    return 0;
+  }
+  if (!bench_read_file(png_path, &b)) return 0;
+  const int img_ok = bench_gen_image_glb(b.data, b.size, &ctx->image_glb);
+  bench_blob_free(&b);
+  if (!img_ok) return 0;
+  ctx->image_pixels = side * side;
+#else
+  (void)err;
+#endif
+  return 1;
+}
+
+// ----------------------------------------------------------------------------
+// Driver
+// ----------------------------------------------------------------------------
+
+static void bench_usage(void) {
+  fprintf(stderr, "usage: gltf_bench [--scale S] [--iterations N] [--dir DIR] [--out FILE]\n");
+}
+
+static void bench_json_string(FILE* f, const char* s) {
+  fputc('"', f);
+  for (; *s; s++) {
+    if (*s == '"' || *s == '\\') fputc('\\', f);
+    if ((unsigned char)*s >= 0x20u) fputc(*s, f);
+  }
+  fputc('"', f);
+}
+
+// Runs the query benchmarks on one loaded document.
+static int bench_run_queries(bench_ctx* ctx, const char* path, const bench_case* cases, uint32_t count,
+                             bench_query* q) {
+  gltf_error err = {0};
+  gltf_doc* doc = NULL;
+  if (gltf_load_file(path, &doc, &err) != GLTF_OK) {
+    bench_fail(path, &err);
+    return 0;
+  }
+  q->doc = doc;
+  int ok = 1;
+  for (uint32_t i = 0; i < count && ok; i++) ok = bench_run_case(ctx, &cases[i]);
+  gltf_free(doc);
+  q->doc = NULL;
+  return ok;
+}
+
+int main(int argc, char** argv) {
+  double scale = 1.0;
+  long iterations = 5;
+  const char* dir = ".";
+  const char* out_path = NULL;
+
+  for (int i = 1; i < argc; i++) {
+    const char* a = argv[i];
+    const char* v = i + 1 < argc ? argv[i + 1] : NULL;
+    if (!v) {
+      bench_usage();
+      return 2;
+    }
+    if (strcmp(a, "--scale") == 0) scale = strtod(v, NULL);
+    else if (strcmp(a, "--iterations") == 0) iterations = strtol(v, NULL, 10);
+    else if (strcmp(a, "--dir") == 0) dir = v;
+    else if (strcmp(a, "--out") == 0) out_path = v;
+    else {
+      bench_usage();
+      return 2;
+    }
+    i++;
+  }
+  if (!(scale > 0.0) || iterations < 1 || iterations > 100000) {
+    bench_usage();
+    return 2;
+  }
+
+  bench_ctx ctx;
+  memset(&ctx, 0, sizeof ctx);
+  ctx.iterations = (uint32_t)iterations;
+  if (!bench_generate(&ctx, dir, scale)) {
+    fprintf(stderr, "gltf_bench: failed to generate scenes in %s\n", dir);
+    bench_blob_free(&ctx.mesh_glb);
+    bench_blob_free(&ctx.image_glb);
+    return 1;
+  }
+
+  ctx.out = out_path ? fopen(out_path, "w") : stdout;
+  if (!ctx.out) {
+    fprintf(stderr, "gltf_bench: cannot open %s\n", out_path);
+    bench_blob_free(&ctx.mesh_glb);
+    bench_blob_free(&ctx.image_glb);
+    return 1;
+  }
+
+  fprintf(ctx.out, "{\n  \"config\":{\"scale\":%g,\"iterations\":%u,\"dir\":", scale, ctx.iterations);
+  bench_json_string(ctx.out, dir);
+  fprintf(ctx.out,
+          ",\"images\":%s,\"mesh_vertices\":%u,\"mesh_tris\":%u,\"hierarchy_nodes\":%u,"
+          "\"datauri_bytes\":%zu,\"image_pixels\":%u},\n  \"results\":[",
+          GLTF_ENABLE_IMAGES ? "true" : "false", ctx.mesh_vertices, ctx.mesh_tris, ctx.hierarchy_nodes,
+          ctx.datauri_size, ctx.image_pixels);
+
+  int ok = 1;
+
+  // Loads.
+  bench_load loads[4];
+  bench_load_init(&loads[0], ctx.mesh_path, NULL);
+  bench_load_init(&loads[1], NULL, &ctx.mesh_glb);
+  bench_load_init(&loads[2], ctx.datauri_path, NULL);
+  bench_load_init(&loads[3], ctx.hierarchy_path, NULL);
+  const bench_case load_cases[4] = {
+    { "load_file_glb", "vertices", ctx.mesh_glb.size, ctx.mesh_vertices,
+      NULL, bench_load_run, bench_load_teardown, &loads[0], &loads[0].stats },
+    { "load_glb_bytes", "vertices", ctx.mesh_glb.size, ctx.mesh_vertices,
+      NULL, bench_load_run, bench_load_teardown, &loads[1], &loads[1].stats },
+    { "load_file_datauri", NULL, ctx.datauri_size, 0,
+      NULL, bench_load_run, bench_load_teardown, &loads[2], &loads[2].stats },
+    { "load_file_hierarchy", "nodes", ctx.hierarchy_size, ctx.hierarchy_nodes,
+      NULL, bench_load_run, bench_load_teardown, &loads[3], &loads[3].stats },
+  };
+  for (uint32_t i = 0; i < 4u && ok; i++) ok = bench_run_case(&ctx, &load_cases[i]);
+
+  // Mesh queries.
+  bench_query mesh_q;
+  memset(&mesh_q, 0, sizeof mesh_q);
+  mesh_q.count = ctx.mesh_vertices;
+  mesh_q.floats = (float*)malloc((size_t)ctx.mesh_vertices * 3u * sizeof(float));
+  if (!mesh_q.floats) ok = 0;
+  const bench_case mesh_cases[2] = {
+    { "accessor_decode_f32", "vertices", (uint64_t)ctx.mesh_vertices * 12u, ctx.mesh_vertices,
+      NULL, bench_decode_run, NULL, &mesh_q, NULL },
+    { "triangle_batches", "tris", (uint64_t)ctx.mesh_tris * 12u, ctx.mesh_tris,
+      NULL, bench_tris_run, NULL, &mesh_q, NULL },
+  };
+  if (ok) ok = bench_run_queries(&ctx, ctx.mesh_path, mesh_cases, 2u, &mesh_q);
+  free(mesh_q.floats);
+
+  // Hierarchy.
+  bench_query world_q;
+  memset(&world_q, 0, sizeof world_q);
+  const bench_case world_case = {
+    "world_matrices", "nodes", 0, ctx.hierarchy_nodes,
+    bench_world_setup, bench_world_run, bench_world_teardown, &world_q, NULL,
+  };
+  if (ok) ok = bench_run_queries(&ctx, ctx.hierarchy_path, &world_case, 1u, &world_q);
+
+#if GLTF_ENABLE_IMAGES
+  bench_query image_q;
+  memset(&image_q, 0, sizeof image_q);
+  const bench_case image_case = {
+    "image_decode_rgba8", "pixels", ctx.image_glb.size, ctx.image_pixels,
+    NULL, bench_image_run, bench_image_teardown, &image_q, NULL,
+  };
+  if (ok) {
+    gltf_error err = {0};
+    gltf_doc* doc = NULL;
+    if (gltf_load_glb_bytes(ctx.image_glb.data, ctx.image_glb.size, &doc, &err) != GLTF_OK) {
+      bench_fail("gltf_load_glb_bytes(image)", &err);
+      ok = 0;
+    } else {
+      image_q.doc = doc;
+      ok = bench_run_case(&ctx, &image_case);
+      gltf_free(doc);
+    }
+  }
+#endif
+
+  fprintf(ctx.out, "\n  ],\n  \"checksum\":%llu,\n  \"peak_rss_bytes\":%llu\n}\n",
+          (unsigned long long)mesh_q.checksum, (unsigned long long)bench_peak_rss());
+  if (out_path) fclose(ctx.out);
+  bench_blob_free(&ctx.mesh_glb);
+  bench_blob_free(&ctx.image_glb);
+  return ok ? 0 : 1;
+}
@@ -96,36 +96,52 @@ int main(int argc, char** argv) {
   uint32_t image_count = gltf_doc_image_count(doc);
   printf("images: %u\n", image_count);
 
+  // Decode everything up front, one task per image across a thread pool.
+  uint32_t* indices = (uint32_t*)malloc((image_count ? image_count : 1u) * sizeof(uint32_t));
+  gltf_image_decode_result* results =
+      (gltf_image_decode_result*)calloc(image_count ? image_count : 1u, sizeof(*results));
+  if (!indices || !results) die("out of memory");
+  for (uint32_t i = 0; i < image_count; ++i) indices[i] = i;
+
+  gltf_thread_pool* pool = NULL;
+  if (gltf_thread_pool_create(0, &pool, &err) != GLTF_OK) {
+    fprintf(stderr, "thread pool unavailable (%s), decoding serially\n", err.message);
+  }
+  (void)gltf_image_decode_rgba8_batch(doc, indices, image_count, results,
+                                      pool ? gltf_thread_pool_dispatch : NULL, pool, &err);
+  gltf_thread_pool_free(pool);
+
   for (uint32_t i = 0; i < image_count; ++i) {
-    gltf_image_pixels pixels = {0};
+    gltf_image_pixels* pixels = &results[i].pixels;
 
-    r = gltf_image_decode_rgba8(doc, i, &pixels, &err);
-    if (r != GLTF_OK) {
-      fprintf(stderr, "image[%u] decode failed: %s\n", i, err.message);
+    if (results[i].result != GLTF_OK) {
+      fprintf(stderr, "image[%u] decode failed: %s\n", i, results[i].error.message);
       continue;
     }
 
     char path_buf[512];
     snprintf(path_buf, sizeof(path_buf),
              "%s/image_%02u_%ux%u.png",
-             args.out_dir, i, pixels.width, pixels.height);
+             args.out_dir, i, pixels->width, pixels->height);
 
     r = gltf_write_png_rgba8(path_buf,
-                             pixels.width,
-                             pixels.height,
-                             pixels.pixels,
+                             pixels->width,
+                             pixels->height,
+                             pixels->pixels,
                              &err);
     if (r != GLTF_OK) {
       fprintf(stderr, "image[%u] write failed: %s\n", i, err.message);
-      gltf_image_pixels_free(&pixels);
+      gltf_image_pixels_free(pixels);
       continue;
     }
 
-    printf("image[%u]: %ux%u -> %s\n", i, pixels.width, pixels.height, path_buf);
+    printf("image[%u]: %ux%u -> %s\n", i, pixels->width, pixels->height, path_buf);
 
-    gltf_image_pixels_free(&pixels);
+    gltf_image_pixels_free(pixels);
   }
 
+  free(results);
+  free(indices);
   gltf_free(doc);
   return 0;
 }
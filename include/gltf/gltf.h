@@ -96,8 +96,35 @@ typedef enum gltf_attr_semantic {
   GLTF_ATTR_WEIGHTS,    // WEIGHTS_n
 } gltf_attr_semantic;
 
-
-// Loads a glTF 2.0 JSON (.gltf) file.
+// Fixed attribute slots of gltf_draw_primitive_view.attributes. Each primitive
+// resolves these once at load time; other attributes (TEXCOORD_4+, COLOR_1+,
+// JOINTS_1+, WEIGHTS_1+) are only reachable through the attribute queries.
+typedef enum gltf_attr_slot {
+  GLTF_ATTR_SLOT_POSITION = 0,
+  GLTF_ATTR_SLOT_NORMAL,
+  GLTF_ATTR_SLOT_TANGENT,
+  GLTF_ATTR_SLOT_TEXCOORD_0,
+  GLTF_ATTR_SLOT_TEXCOORD_1,
+  GLTF_ATTR_SLOT_TEXCOORD_2,
+  GLTF_ATTR_SLOT_TEXCOORD_3,
+  GLTF_ATTR_SLOT_COLOR_0,
+  GLTF_ATTR_SLOT_JOINTS_0,
+  GLTF_ATTR_SLOT_WEIGHTS_0,
+
+  GLTF_ATTR_SLOT_COUNT
+} gltf_attr_slot;
+
+// Object arrays searchable by name (gltf_doc_find_name*).
+typedef enum gltf_name_kind {
+  GLTF_NAME_NODE = 0,
+  GLTF_NAME_MESH,
+  GLTF_NAME_MATERIAL,
+
+  GLTF_NAME_KIND_COUNT
+} gltf_name_kind;
+
+
+// Loads a glTF 2.0 file (.gltf JSON or .glb binary container).
 //
 // Success:
 //   - returns GLTF_OK
@@ -107,6 +134,10 @@ typedef enum gltf_attr_semantic {
 //   - returns a non-OK code
 //   - *out_doc is set to NULL
 //   - out_err (if non-NULL) is filled with error context (see gltf_error)
+//
+// Notes:
+//   - The file is read once; JSON is parsed in place and a GLB BIN chunk is
+//     used directly from the file buffer (no second copy).
 gltf_result gltf_load_file(const char* path, gltf_doc** out_doc, gltf_error* out_err);
 
 // Loads a glTF 2.0 JSON document from an in-memory buffer.
@@ -148,11 +179,542 @@ gltf_result gltf_load_glb_bytes(const uint8_t* data,
                                 gltf_doc** out_doc,
                                 gltf_error* out_err);
 
+// Parallel work hooks shared by the loaders and the batch APIs (see "Task
+// dispatch" below).
+// One unit of work: task_index is in [0, task_count).
+typedef void (*gltf_task_fn)(void* task_user, uint32_t task_index);
+
+// Must call task(task_user, i) exactly once for every i in [0, task_count), in
+// any order and on any threads, and return only after all calls have returned
+// (their writes must be visible to the caller).
+typedef void (*gltf_dispatch_fn)(void* dispatch_user,
+                                 uint32_t task_count,
+                                 gltf_task_fn task,
+                                 void* task_user);
+
+// Load behavior flags for gltf_load_options.flags (combine with |).
+typedef enum gltf_load_flags {
+  GLTF_LOAD_DEFAULT = 0,
+
+  // GLB: buffers[0] points straight into the caller's bytes instead of a
+  // private copy of the BIN chunk. The caller must keep the bytes alive and
+  // unmodified until gltf_free(); gltf_free() does not release them.
+  GLTF_LOAD_BORROW_BIN = 1u << 0,
+
+  // GLB: parse the JSON chunk in place (yyjson insitu mode) instead of
+  // copying it first. The JSON chunk bytes are overwritten during parsing,
+  // and the YYJSON padding bytes after it (the BIN chunk header) are modified
+  // during the call and restored before it returns: the buffer must be
+  // writable and must not be read concurrently while loading.
+  GLTF_LOAD_JSON_INSITU = 1u << 1,
+
+  // gltf_load_file_ex(): memory-map the .glb and every external buffer file
+  // (mmap / MapViewOfFile) instead of reading them. Buffer bytes are paged in
+  // on demand, shared through the page cache and never copied; the mappings
+  // are released by gltf_free(). Files must not be truncated while mapped.
+  // Falls back to regular reads where mapping is not possible.
+  GLTF_LOAD_MMAP = 1u << 2,
+
+  // gltf_load_file_ex(): do not read external buffer files or decode buffer
+  // data: URIs at load time. Each buffer is loaded on first use by
+  // gltf_accessor_span() (and everything built on it) or by image decoding
+  // from a bufferView. First-touch loading is thread-safe. I/O errors are
+  // reported by the call that first touches the buffer (and retried on the
+  // next call).
+  GLTF_LOAD_LAZY_BUFFERS = 1u << 3,
+
+  // Build a name index for nodes, meshes and materials at load time: exact
+  // gltf_doc_find_name() lookups become a hash probe and
+  // gltf_doc_find_name_prefix() a binary search instead of full scans.
+  // Costs 12 to 20 bytes per object in the document block.
+  GLTF_LOAD_NAME_INDEX = 1u << 4,
+} gltf_load_flags;
+
+// Custom allocator for document memory (same shape as yyjson_alc).
+//
+// Notes:
+//   - malloc must return memory suitably aligned for any type (like malloc()).
+//   - realloc receives the current size of ptr; free is never called with NULL.
+//   - Used for the document block (the document and every parsed array,
+//     string and index list live in one allocation sized before parsing) and
+//     for the JSON parser's temporary tree. Buffer payloads and decoded images
+//     are still allocated with malloc().
+//   - The allocator (and user) must stay valid until gltf_free() of every
+//     document loaded with it; gltf_free() may be called from any thread.
+typedef struct gltf_allocator {
+  void* (*malloc)(void* user, size_t size);
+  void* (*realloc)(void* user, void* ptr, size_t old_size, size_t size);
+  void (*free)(void* user, void* ptr);
+  void* user;
+} gltf_allocator;
+
+// Top-level sections for gltf_load_options.sections (combine with |).
+//
+// Notes:
+//   - 0 loads everything (same as GLTF_LOAD_SECTION_ALL).
+//   - A skipped section is neither parsed nor sized: the document reads as if
+//     the asset had no such objects (counts are 0, lookups fail as out of
+//     range). References into skipped sections are not checked.
+//   - Without GLTF_LOAD_SECTION_BUFFERS no buffer file is opened and no data:
+//     URI is decoded; accessors still parse but reading them fails.
+//   - GLTF_LOAD_SECTION_IMAGES implies GLTF_LOAD_SECTION_ACCESSORS and
+//     GLTF_LOAD_SECTION_BUFFERS when an image is stored in a bufferView.
+typedef enum gltf_load_sections {
+  GLTF_LOAD_SECTION_SCENES    = 1u << 0, // scenes, nodes
+  GLTF_LOAD_SECTION_MESHES    = 1u << 1, // meshes, primitives
+  GLTF_LOAD_SECTION_ACCESSORS = 1u << 2, // accessors, bufferViews
+  GLTF_LOAD_SECTION_BUFFERS   = 1u << 3, // buffers and their bytes
+  GLTF_LOAD_SECTION_MATERIALS = 1u << 4, // materials, textures, samplers
+  GLTF_LOAD_SECTION_IMAGES    = 1u << 5, // images
+
+  GLTF_LOAD_SECTION_GEOMETRY = GLTF_LOAD_SECTION_SCENES | GLTF_LOAD_SECTION_MESHES |
+                               GLTF_LOAD_SECTION_ACCESSORS | GLTF_LOAD_SECTION_BUFFERS,
+  GLTF_LOAD_SECTION_ALL = GLTF_LOAD_SECTION_GEOMETRY | GLTF_LOAD_SECTION_MATERIALS |
+                          GLTF_LOAD_SECTION_IMAGES,
+} gltf_load_sections;
+
+// File access callbacks (gltf_load_options.io), replacing the OS file API
+// for every file a load opens: the .gltf/.glb itself, external buffers, and
+// URI images decoded later from the document.
+//
+// Notes:
+//   - open, size, read and close are required. open returns NULL on failure;
+//     size and read return nonzero on success. read fills exactly size bytes
+//     starting at offset.
+//   - map and release are optional (set both or neither). map returns a view
+//     of the whole file (NULL on failure) that stays valid until release,
+//     which may come after close. With map, buffers and the GLB BIN chunk are
+//     used in place (zero-copy), as with GLTF_LOAD_MMAP; without it, files
+//     are read into owned memory.
+//   - Paths are the resolved paths the OS API would have opened.
+//   - Callbacks may run on any thread (parallel loads, batch image decode).
+//   - The struct is copied into the document; user must stay valid until
+//     gltf_free() of every document loaded with it.
+//   - Modification times are unknown: gltf_load_file_cached() and the image
+//     cache only compare sizes for files served through io.
+typedef struct gltf_io {
+  void* (*open)(void* user, const char* path);
+  int (*size)(void* user, void* file, uint64_t* out_size);
+  int (*read)(void* user, void* file, uint64_t offset, void* dst, size_t size);
+  const uint8_t* (*map)(void* user, void* file, size_t size);
+  void (*release)(void* user, const uint8_t* data, size_t size);
+  void (*close)(void* user, void* file);
+  void* user;
+} gltf_io;
+
+// Load stages timed by gltf_load_stats (in the order a load runs them).
+typedef enum gltf_load_stage {
+  GLTF_LOAD_STAGE_READ = 0,     // reading or mapping the .gltf / .glb file
+  GLTF_LOAD_STAGE_JSON,         // yyjson parse
+  GLTF_LOAD_STAGE_PRESIZE,      // sizing and allocating the document block
+  GLTF_LOAD_STAGE_SCENES,
+  GLTF_LOAD_STAGE_NODES,
+  GLTF_LOAD_STAGE_MESHES,
+  GLTF_LOAD_STAGE_ACCESSORS,
+  GLTF_LOAD_STAGE_BUFFER_VIEWS,
+  GLTF_LOAD_STAGE_BUFFERS,      // buffer file reads / maps and data: URI decodes
+  GLTF_LOAD_STAGE_IMAGES,
+  GLTF_LOAD_STAGE_SAMPLERS,
+  GLTF_LOAD_STAGE_TEXTURES,
+  GLTF_LOAD_STAGE_MATERIALS,
+  GLTF_LOAD_STAGE_INDEX,        // primitive slot tables and the name index
+  GLTF_LOAD_STAGE_COUNT
+} gltf_load_stage;
+
+// Where a buffer's bytes came from during a load (gltf_buffer_stats.source).
+typedef enum gltf_buffer_stats_source {
+  GLTF_BUFFER_STATS_NONE = 0,     // not loaded (lazy, or section skipped)
+  GLTF_BUFFER_STATS_GLB_BIN,      // GLB BIN chunk (borrowed or copied)
+  GLTF_BUFFER_STATS_FILE_READ,    // external file read into memory
+  GLTF_BUFFER_STATS_FILE_MAPPED,  // external file memory-mapped
+  GLTF_BUFFER_STATS_DATA_URI,     // base64 data: URI decoded
+} gltf_buffer_stats_source;
+
+typedef struct gltf_buffer_stats {
+  uint32_t source;       // gltf_buffer_stats_source
+  uint64_t bytes;        // payload bytes made resident (byteLength)
+  uint64_t source_bytes; // bytes consumed: file size, BIN chunk or base64 text
+  double seconds;        // time spent reading / mapping the file or decoding the URI
+} gltf_buffer_stats;
+
+// Called on the loading thread when a stage starts (end == 0, seconds == 0)
+// and when it finishes (end == 1, seconds = wall time of the stage), also when
+// the stage fails. Stages a load does not run are not reported.
+typedef void (*gltf_load_trace_fn)(void* user, gltf_load_stage stage, int end, double seconds);
+
+// Statistics for one load (gltf_load_options.stats).
+//
+// Notes:
+//   - The library clears every output field at the start of the load and
+//     fills them in as it goes, so a failed load reports the stages it ran.
+//   - Filled by gltf_load_file_ex() and gltf_load_glb_bytes_ex()
+//     (gltf_load_file_cached() only when it loads the source file). Not used
+//     by gltf_load_files(), gltf_load_baked() or gltf_glb_stream.
+//   - Compiled out when the library is built with GLTF_ENABLE_STATS=OFF:
+//     loads then cost nothing extra and leave collected == 0.
+//   - The document block is sized before parsing and never grows, so string
+//     and index storage report capacity against what parsing used.
+//   - Buffers loaded later (GLTF_LOAD_LAZY_BUFFERS) are reported as
+//     GLTF_BUFFER_STATS_NONE and not counted.
+typedef struct gltf_load_stats {
+  // Optional inputs (kept across loads):
+  gltf_buffer_stats* buffers; // receives min(buffer_count, buffers_cap) entries
+  uint32_t buffers_cap;
+  gltf_load_trace_fn trace;   // NULL = no trace
+  void* trace_user;
+
+  // Outputs:
+  uint32_t collected;                            // 1 when built with stats
+  double stage_seconds[GLTF_LOAD_STAGE_COUNT];  // wall time per stage
+  uint64_t file_bytes;          // size of the .gltf / .glb (read, mapped or passed in)
+  uint32_t buffer_count;        // buffers in the document
+  uint64_t buffer_read_bytes;   // external buffer files read into memory
+  uint64_t buffer_mapped_bytes; // external buffer files mapped
+  uint64_t data_uri_bytes;      // bytes decoded from data: URIs
+  uint64_t data_uri_text_bytes; // base64 text those came from
+  // Time spent inside the BUFFERS stage, summed over buffers. With a
+  // dispatch hook buffers load in parallel, so the sums may exceed the stage.
+  double buffer_io_seconds;     // reading and mapping external buffer files
+  double data_uri_seconds;      // decoding base64 data: URIs
+
+  uint64_t block_bytes;         // document block allocated (gltf_allocator)
+  uint64_t block_used_bytes;    // of which carved by parsing
+  uint64_t string_cap_bytes;    // string pool capacity
+  uint64_t string_used_bytes;   // string pool used
+  uint32_t index_cap;           // index list capacity (uint32_t entries)
+  uint32_t index_used;          // index list entries used
+  uint64_t json_alloc_bytes;    // bytes requested by the JSON parser
+  uint32_t json_alloc_count;    // JSON parser allocations
+  // Everything the load allocated from the heap: the block, the JSON tree,
+  // the file contents (when read) and owned buffer payloads.
+  uint64_t heap_bytes;
+} gltf_load_stats;
+
+// Returns a short lowercase name for stage ("read", "json", ...), or "unknown".
+const char* gltf_load_stage_name(gltf_load_stage stage);
+
+// Optional load options.
+//
+// Notes:
+//   - Zero-initialize for defaults; passing NULL is the same as all zeros.
+//   - The options are only read during the load call (the allocator is copied).
+typedef struct gltf_load_options {
+  uint32_t flags;                  // gltf_load_flags
+  const gltf_allocator* allocator; // NULL = malloc/realloc/free
+  uint32_t sections;               // gltf_load_sections, 0 = all
+
+  // .gltf: read external buffer files and decode data: URI buffers as
+  // parallel tasks (one per buffer) instead of one after another. NULL loads
+  // serially. Not used with GLTF_LOAD_LAZY_BUFFERS (nothing is read up front).
+  gltf_dispatch_fn dispatch;
+  void* dispatch_user;
+
+  const gltf_io* io; // NULL = OS file API
+
+  gltf_load_stats* stats; // NULL = no statistics (see gltf_load_stats)
+} gltf_load_options;
+
+// Loads a .gltf or .glb file with options (see gltf_load_file()).
+//
+// Success / Failure:
+//   - same as gltf_load_file()
+//
+// Notes:
+//   - opts may be NULL (same as gltf_load_file()).
+//   - GLTF_LOAD_BORROW_BIN / GLTF_LOAD_JSON_INSITU are implied for files.
+//   - .gltf data: URI buffers are decoded over the file's own text, which the
+//     document keeps (shrunk to the decoded bytes) instead of a second copy.
+gltf_result gltf_load_file_ex(const char* path,
+                              const gltf_load_options* opts,
+                              gltf_doc** out_doc,
+                              gltf_error* out_err);
+
+// Loads a .glb from memory with options (see gltf_load_glb_bytes()).
+//
+// Success / Failure:
+//   - same as gltf_load_glb_bytes()
+//
+// Notes:
+//   - Without flags this behaves exactly like gltf_load_glb_bytes() and
+//     'data' is never written.
+//   - GLTF_LOAD_BORROW_BIN makes the document keep a pointer into 'data'.
+//   - GLTF_LOAD_JSON_INSITU modifies the JSON chunk; it is skipped (falls back
+//     to a copy) if the JSON chunk is the last bytes of 'data'.
+gltf_result gltf_load_glb_bytes_ex(uint8_t* data,
+                                   size_t size,
+                                   const gltf_load_options* opts,
+                                   gltf_doc** out_doc,
+                                   gltf_error* out_err);
+
+// Per-file outcome of gltf_load_files().
+typedef struct gltf_load_result {
+  gltf_result result; // GLTF_OK or the code gltf_load_file_ex() returned
+  gltf_error error;   // error context when result != GLTF_OK
+  gltf_doc* doc;      // loaded document (free with gltf_free()), NULL on failure
+} gltf_load_result;
+
+// Loads several .gltf / .glb files in parallel (one task per file, each
+// loaded with gltf_load_file_ex() and opts).
+//
+// out_results[i] receives the outcome for paths[i]. Tasks run through
+// dispatch (see gltf_dispatch_fn); NULL loads serially on the calling thread.
+//
+// On success (every file loaded):
+//   - returns GLTF_OK
+//
+// On failure:
+//   - returns GLTF_ERR_INVALID for invalid arguments (out_results untouched)
+//   - otherwise returns the code of the first failed entry and copies its
+//     error into out_err; every entry of out_results is still filled in, and
+//     the caller owns the documents that did load
+//
+// Notes:
+//   - opts->dispatch is not used inside the tasks: buffers of each file are
+//     loaded serially, since the files already run in parallel (and a thread
+//     pool must not be dispatched to from its own tasks).
+gltf_result gltf_load_files(const char* const* paths,
+                            uint32_t count,
+                            const gltf_load_options* opts,
+                            gltf_load_result* out_results,
+                            gltf_dispatch_fn dispatch,
+                            void* dispatch_user,
+                            gltf_error* out_err);
+
 // Frees all memory owned by the document.
 // Safe to call with NULL.
 void gltf_free(gltf_doc* doc);
 
 
+// ----------------------------------------------------------------------------
+// Streaming GLB
+// ----------------------------------------------------------------------------
+//
+// Loads a .glb as its bytes arrive (e.g. over the network). The document is
+// built as soon as the JSON chunk (and the BIN chunk header, if any) has been
+// fed; the BIN chunk is then written straight into the buffer the document
+// borrows, and each bufferView can be checked for readiness while the rest
+// of the file downloads.
+//
+// Notes:
+//   - One thread feeds the stream and calls gltf_glb_stream_doc(). Once the
+//     document has been handed to them, other threads may read it and call
+//     gltf_glb_stream_buffer_view_ready() during later feeds, but must only
+//     touch bytes of views that are reported ready.
+//   - The document is read-only until gltf_glb_stream_finish() hands it over;
+//     do not gltf_free() the pointer from gltf_glb_stream_doc().
+
+typedef struct gltf_glb_stream gltf_glb_stream;
+
+// Creates an empty stream.
+//
+// On success: returns GLTF_OK and sets *out_stream (free with
+//   gltf_glb_stream_finish() or gltf_glb_stream_free()).
+// On failure: returns GLTF_ERR_INVALID for invalid arguments (an incomplete
+//   allocator) or GLTF_ERR_IO when out of memory; *out_stream is set to NULL.
+//
+// Notes:
+//   - opts may be NULL. allocator and sections apply as for
+//     gltf_load_glb_bytes_ex(); of the flags only GLTF_LOAD_NAME_INDEX is
+//     used, and dispatch and io are not.
+gltf_result gltf_glb_stream_create(const gltf_load_options* opts,
+                                   gltf_glb_stream** out_stream,
+                                   gltf_error* out_err);
+
+// Appends the next size bytes of the file.
+//
+// On success: returns GLTF_OK. The document exists once the JSON chunk has
+//   been parsed (see gltf_glb_stream_doc()).
+// On failure: returns the error the equivalent gltf_load_glb_bytes() would
+//   report (GLTF_ERR_INVALID for a bad container, GLTF_ERR_PARSE for bad
+//   JSON), or GLTF_ERR_INVALID for bytes past the header's length. The stream
+//   is then failed: later feeds return the same error.
+gltf_result gltf_glb_stream_feed(gltf_glb_stream* stream,
+                                 const uint8_t* data,
+                                 size_t size,
+                                 gltf_error* out_err);
+
+// Returns the document parsed so far, or NULL until the JSON chunk is in.
+const gltf_doc* gltf_glb_stream_doc(const gltf_glb_stream* stream);
+
+// Returns 1 if every byte of bufferViews[buffer_view_index] has arrived
+// (views outside the BIN chunk, e.g. data: URIs, are ready with the
+// document), 0 otherwise or if the index is out of range.
+int gltf_glb_stream_buffer_view_ready(const gltf_glb_stream* stream, uint32_t buffer_view_index);
+
+// Completes the stream and frees it.
+//
+// On success: returns GLTF_OK and sets *out_doc (free with gltf_free()); it is
+//   the same document gltf_glb_stream_doc() returned.
+// On failure: returns the stream's error, or GLTF_ERR_INVALID if the file is
+//   incomplete; *out_doc is set to NULL.
+//
+// Notes:
+//   - The stream is freed in either case.
+gltf_result gltf_glb_stream_finish(gltf_glb_stream* stream,
+                                   gltf_doc** out_doc,
+                                   gltf_error* out_err);
+
+// Abandons a stream, freeing it and its document.
+// Safe to call with NULL.
+void gltf_glb_stream_free(gltf_glb_stream* stream);
+
+// ----------------------------------------------------------------------------
+// Baked documents (binary cache)
+// ----------------------------------------------------------------------------
+//
+// A baked file is a fully parsed document written out as one position-
+// independent image. gltf_load_baked() maps it copy-on-write and rebases a
+// handful of pointers instead of parsing JSON, so reloads cost about an mmap.
+//
+// Notes:
+//   - Baked files are a cache, not an interchange format: they are tied to
+//     this library version and to the host ABI (pointer size, byte order,
+//     struct layout). Loading a mismatching file fails with
+//     GLTF_ERR_UNSUPPORTED; rebuild it from the source asset.
+//   - External buffer files and image URIs are referenced by the paths the
+//     source document resolved at load time (relative paths stay relative to
+//     the working directory).
+
+// Flags for gltf_doc_save_baked() (combine with |).
+typedef enum gltf_bake_flags {
+  GLTF_BAKE_DEFAULT = 0,
+
+  // Embed the bytes of every buffer, including external buffer files.
+  // By default only buffers without a file of their own (GLB BIN chunk,
+  // data: URIs) are embedded; external files are loaded on first use.
+  GLTF_BAKE_BUFFERS = 1u << 0,
+} gltf_bake_flags;
+
+// Writes doc to path as a baked file (see gltf_bake_flags).
+//
+// On success:
+//   - returns GLTF_OK
+//
+// On failure:
+//   - returns GLTF_ERR_INVALID for invalid arguments
+//   - returns GLTF_ERR_IO if a buffer cannot be loaded or the file cannot be written
+//   - an existing file at path is left untouched (the file is written to a
+//     temporary name and renamed into place)
+//
+// Notes:
+//   - Lazily loaded buffers that must be embedded are loaded first.
+gltf_result gltf_doc_save_baked(const gltf_doc* doc,
+                                const char* path,
+                                uint32_t flags,
+                                gltf_error* out_err);
+
+// Loads a file written by gltf_doc_save_baked().
+//
+// On success:
+//   - returns GLTF_OK and sets *out_doc (free with gltf_free())
+//
+// On failure:
+//   - returns GLTF_ERR_IO if the file cannot be mapped
+//   - returns GLTF_ERR_UNSUPPORTED for another version / ABI
+//   - returns GLTF_ERR_PARSE if the file is truncated or inconsistent
+//   - *out_doc is set to NULL
+//
+// Notes:
+//   - opts may be NULL. GLTF_LOAD_MMAP applies to external buffers, which
+//     are always loaded on first use (as with GLTF_LOAD_LAZY_BUFFERS).
+//   - opts->sections is ignored: the document holds the sections it was
+//     loaded with before baking.
+//   - The file must not be truncated or rewritten in place while loaded
+//     (gltf_doc_save_baked() replaces files atomically).
+gltf_result gltf_load_baked(const char* path,
+                            const gltf_load_options* opts,
+                            gltf_doc** out_doc,
+                            gltf_error* out_err);
+
+// Loads path through a baked cache file at cache_path.
+//
+// The cache is used when it was baked from a file with the same size and
+// modification time as path and holds every section in opts->sections;
+// otherwise path is loaded with gltf_load_file_ex() and the cache is
+// rewritten (best effort: failing to write it does not fail the load).
+//
+// Success / Failure:
+//   - same as gltf_load_file_ex()
+gltf_result gltf_load_file_cached(const char* path,
+                                  const char* cache_path,
+                                  const gltf_load_options* opts,
+                                  gltf_doc** out_doc,
+                                  gltf_error* out_err);
+
+
+// ----------------------------------------------------------------------------
+// Repacking (GLB <-> .gltf + .bin)
+// ----------------------------------------------------------------------------
+//
+// gltf_repack_file() converts an asset between the GLB container and a .gltf
+// with one external .bin, merging every buffer that holds bytes into a single
+// one on the way. The source JSON is kept as written (extensions and extras included); only
+// "buffers" and the buffer references of bufferViews are rewritten.
+//
+// Notes:
+//   - Buffer bytes are never gathered in memory: GLB BIN chunks and external
+//     buffer files are mapped and written straight to the output, and data:
+//     URIs are decoded in place inside the source JSON text. Peak memory is
+//     a small multiple of the JSON size, whatever the size of the buffers.
+//   - Image URIs are kept verbatim, so relative image files must sit next to
+//     the output as they did next to the input.
+
+// Output container of gltf_repack_file().
+typedef enum gltf_repack_format {
+  GLTF_REPACK_GLB  = 1, // one .glb with a BIN chunk
+  GLTF_REPACK_GLTF = 2, // .gltf JSON + one external .bin
+} gltf_repack_format;
+
+// Flags for gltf_repack_options.flags (combine with |).
+typedef enum gltf_repack_flags {
+  GLTF_REPACK_DEFAULT = 0,
+
+  // Indent the output JSON (default: minified).
+  GLTF_REPACK_PRETTY_JSON = 1u << 0,
+} gltf_repack_flags;
+
+typedef struct gltf_repack_options {
+  uint32_t format;    // gltf_repack_format
+  uint32_t flags;     // gltf_repack_flags
+
+  // Start alignment of each source buffer inside the merged buffer
+  // (0 = 16). Must be a power of two >= 4; gaps are zero-filled.
+  uint32_t alignment;
+
+  // GLTF_REPACK_GLTF: uri of the .bin, relative to the output file.
+  // NULL = the output file name with its extension replaced by ".bin".
+  const char* bin_uri;
+} gltf_repack_options;
+
+// Rewrites the .gltf or .glb at in_path as out_path in opts->format.
+//
+// On success:
+//   - returns GLTF_OK
+//   - writes out_path (and, for GLTF_REPACK_GLTF with buffers, the .bin next
+//     to it); an asset without buffers gets no BIN chunk / .bin file
+//
+// On failure:
+//   - returns GLTF_ERR_INVALID for invalid arguments or options, or a GLB
+//     with a bad header / chunk table
+//   - returns GLTF_ERR_PARSE for invalid JSON, buffers or buffer references
+//     (including a source whose size does not match its byteLength)
+//   - returns GLTF_ERR_RANGE if the merged buffer exceeds 4 GiB
+//   - returns GLTF_ERR_IO if a file cannot be read or written
+//   - existing output files are left untouched (each file is written to a
+//     temporary name and renamed into place)
+//
+// Notes:
+//   - Buffer sources resolve as in gltf_load_file(): external uris relative
+//     to in_path, a buffer without uri is the GLB BIN chunk.
+//   - EXT_meshopt_compression buffer references are rewritten as well.
+//     Uri-less meshopt fallback buffers ("fallback": true) hold no bytes;
+//     they are kept as written, after the merged buffer, instead of merged.
+gltf_result gltf_repack_file(const char* in_path,
+                             const char* out_path,
+                             const gltf_repack_options* opts,
+                             gltf_error* out_err);
+
+
 // ----------------------------------------------------------------------------
 // Scenes / Nodes / Meshes (basic)
 // ----------------------------------------------------------------------------
@@ -235,6 +797,40 @@ int gltf_doc_node_child(const gltf_doc* doc,
 // Returns NULL if doc is NULL or mesh_index is out of range.
 const char* gltf_doc_mesh_name(const gltf_doc* doc, uint32_t mesh_index);
 
+// Finds the object of the given kind whose name is exactly name.
+//
+// On success:
+//   - returns the lowest index with that name
+//
+// On failure (doc or name NULL, kind out of range, no such name):
+//   - returns -1
+//
+// Notes:
+//   - Names are compared byte-wise (no Unicode normalization).
+//   - O(1) with GLTF_LOAD_NAME_INDEX, a linear scan otherwise.
+int32_t gltf_doc_find_name(const gltf_doc* doc, gltf_name_kind kind, const char* name);
+
+// Finds the objects of the given kind whose name starts with prefix.
+//
+// On success:
+//   - returns the number of matching objects
+//   - writes the first min(count, max_indices) of them to out_indices,
+//     ordered by name (byte-wise, shorter first) and then by index
+//
+// On failure (doc or prefix NULL, kind out of range):
+//   - returns 0
+//
+// Notes:
+//   - out_indices may be NULL when max_indices is 0 (count only).
+//   - An empty prefix matches every named object; unnamed ones never match.
+//   - With GLTF_LOAD_NAME_INDEX this is a binary search plus the copy;
+//     otherwise every object is compared.
+uint32_t gltf_doc_find_name_prefix(const gltf_doc* doc,
+                                   gltf_name_kind kind,
+                                   const char* prefix,
+                                   uint32_t* out_indices,
+                                   uint32_t max_indices);
+
 
 // ----------------------------------------------------------------------------
 // Mesh primitives
@@ -410,14 +1006,25 @@ gltf_result gltf_mesh_primitive_indices_span(const gltf_doc* doc,
 //   - indices is {NULL, 0, 0, 0}
 //   - index_component_type == 0
 //   - index_count equals positions.count
+//
+// Attributes:
+//   - attributes[slot] spans the slot's accessor (see gltf_attr_slot); bit
+//     (1u << slot) of attribute_mask is set for present slots, absent slots
+//     are {NULL, 0, 0, 0} with component type 0
+//   - attributes[GLTF_ATTR_SLOT_POSITION] equals positions
 typedef struct gltf_draw_primitive_view {
   gltf_span positions;            // VEC3 position data
   gltf_span indices;              // SCALAR indices (may be empty for non-indexed)
   uint32_t  index_count;          // indices.count or positions.count if non-indexed
   uint32_t  index_component_type; // GLTF_COMP_U8/U16/U32, or 0 if non-indexed
+
+  gltf_span attributes[GLTF_ATTR_SLOT_COUNT];
+  uint32_t  attribute_component_type[GLTF_ATTR_SLOT_COUNT]; // gltf_component_type
+  uint32_t  attribute_mask;       // 1u << gltf_attr_slot per present slot
+  uint32_t  normalized_mask;      // 1u << gltf_attr_slot per normalized accessor
 } gltf_draw_primitive_view;
 
-// Builds a draw-ready primitive view (positions + indices metadata).
+// Builds a draw-ready primitive view (positions, indices and attribute slots).
 //
 // On success:
 //   - returns GLTF_OK
@@ -425,8 +1032,13 @@ typedef struct gltf_draw_primitive_view {
 //
 // On failure:
 //   - returns GLTF_ERR_INVALID if arguments are invalid
-//   - returns GLTF_ERR_PARSE if the primitive/accessor layout is invalid
+//   - returns GLTF_ERR_PARSE if the primitive has no POSITION, or the layout
+//     of its indices or of a present slot's accessor is invalid
 //   - out_view is not modified
+//
+// Notes:
+//   - Accessor layouts are validated when the document is loaded, so this is
+//     a table lookup per slot (plus first-use loading of lazy buffers).
 gltf_result gltf_mesh_primitive_view(const gltf_doc* doc,
                                      uint32_t mesh_index,
                                      uint32_t prim_i,
@@ -529,6 +1141,10 @@ int gltf_doc_accessor_info(const gltf_doc* doc,
                            uint32_t* out_type,
                            int* out_normalized);
 
+// Returns accessor.sparse.count for the accessor at accessor_index, or 0 if
+// the accessor is not sparse (or doc is NULL / the index is out of range).
+uint32_t gltf_doc_accessor_sparse_count(const gltf_doc* doc, uint32_t accessor_index);
+
 // Returns a span-like view over the accessor's underlying buffer data.
 //
 // The returned span provides direct read-only access to the raw bytes
@@ -538,6 +1154,16 @@ int gltf_doc_accessor_info(const gltf_doc* doc,
 //   - accessor.byteOffset
 //   - bufferView.byteStride (if present)
 //
+// Sparse accessors:
+//   - The first call materializes the accessor once into a document-owned
+//     dense copy: the bufferView elements (zeros without a bufferView) with
+//     every sparse value written over its index. The span points at that copy
+//     (stride == elem_size) and every later call returns it as is.
+//   - Materialization reads the base, indices and values bufferViews. On a
+//     gltf_glb_stream document it fails with GLTF_ERR_IO (and caches
+//     nothing) until gltf_glb_stream_buffer_view_ready() reports all three.
+//   - A sparse index past accessor.count fails with GLTF_ERR_PARSE.
+//
 // On success:
 //   - returns GLTF_OK
 //   - fills out_span with a valid view into document-owned memory
@@ -545,6 +1171,8 @@ int gltf_doc_accessor_info(const gltf_doc* doc,
 // On failure:
 //   - returns GLTF_ERR_INVALID if arguments are invalid
 //   - returns GLTF_ERR_PARSE if the accessor or buffer layout is invalid
+//   - returns GLTF_ERR_IO if buffer data cannot be loaded, or a streamed
+//     sparse accessor's bufferViews have not arrived yet
 //   - out_span is not modified
 //
 // The returned span is valid until gltf_free() is called on the document.
@@ -587,19 +1215,88 @@ gltf_result gltf_accessor_read_f32(const gltf_doc* doc,
                                    uint32_t out_cap,
                                    gltf_error* out_err);
 
+// Decodes elements [first, first + count) of the accessor into floats.
+//
+// This is the bulk form of gltf_accessor_read_f32(): the accessor layout is
+// validated once and the range is decoded with kernels specialized per
+// componentType (SIMD where available for f32 and u8/i8/u16/i16, normalized or not).
+// Results are identical to calling gltf_accessor_read_f32() per element.
+//
+// Output layout:
+//   - element e is written to dst[e * dst_stride + 0 .. comp_count - 1]
+//   - dst_stride is in floats; 0 means tightly packed (dst_stride == comp_count)
+//   - dst must hold at least (count - 1) * dst_stride + comp_count floats
+//
+// On success:
+//   - returns GLTF_OK
+//   - writes count decoded elements to dst
+//
+// On failure:
+//   - returns GLTF_ERR_INVALID if arguments are invalid, the range is out of
+//     bounds, or dst_stride is smaller than the component count
+//   - returns GLTF_ERR_PARSE if the accessor layout is invalid
+//   - dst is not modified
+gltf_result gltf_accessor_read_f32_range(const gltf_doc* doc,
+                                         uint32_t accessor_index,
+                                         uint32_t first,
+                                         uint32_t count,
+                                         float* dst,
+                                         uint32_t dst_stride,
+                                         gltf_error* out_err);
+
+// Reads indices [first, first + count) of an index accessor as uint32_t.
+//
+// The accessor must be SCALAR, non-normalized, and U8/U16/U32; this is checked
+// once for the whole range. Tightly packed u8/u16 indices are widened with SIMD
+// where available and u32 indices are copied directly.
+//
+// out_min_index / out_max_index are optional (may be NULL). Together with
+// POSITION.count they let callers bounds-check a whole index range in one step.
+// For count == 0 they are set to UINT32_MAX and 0 respectively.
+//
+// On success:
+//   - returns GLTF_OK
+//   - writes count indices to dst and the optional min/max outputs
+//
+// On failure:
+//   - returns GLTF_ERR_INVALID if arguments are invalid or the range is out of bounds
+//   - returns GLTF_ERR_PARSE if the accessor is not a valid index accessor
+//   - dst and the min/max outputs are not modified
+gltf_result gltf_accessor_read_indices_u32(const gltf_doc* doc,
+                                           uint32_t accessor_index,
+                                           uint32_t first,
+                                           uint32_t count,
+                                           uint32_t* dst,
+                                           uint32_t* out_min_index,
+                                           uint32_t* out_max_index,
+                                           gltf_error* out_err);
+
 
 // ----------------------------------------------------------------------------
 // Utilities
 // ----------------------------------------------------------------------------
 
-// Computes an axis-aligned bounding box (AABB) for a VEC3 POSITION accessor.
+// Flags for the AABB helpers.
+typedef enum gltf_aabb_flags {
+  GLTF_AABB_DEFAULT = 0,
+  // Use accessor.min / accessor.max when present instead of scanning the data.
+  // Those fields are trusted as-is (the glTF spec requires them for POSITION).
+  GLTF_AABB_USE_ACCESSOR_BOUNDS = 1u << 0,
+} gltf_aabb_flags;
+
+// Computes an axis-aligned bounding box (AABB) over the first three components
+// of an accessor (typically POSITION).
 //
-// This utility reads POSITION data directly via gltf_accessor_span().
+// Supported encodings:
+//   - F32
+//   - U8/I8/U16/I16, normalized or not (KHR_mesh_quantization)
 //
-// Requirements:
-//   - accessor must be VEC3
-//   - componentType must be F32
-//   - accessor must be non-normalized
+// Values are decoded exactly like gltf_accessor_read_f32(); quantized data is
+// reduced in its integer domain with SIMD kernels where available. NaN
+// components are ignored.
+//
+// With GLTF_AABB_USE_ACCESSOR_BOUNDS, accessor.min/max (normalized if the
+// accessor is) are returned without reading buffer data when both are present.
 //
 // On success:
 //   - returns GLTF_OK
@@ -608,14 +1305,75 @@ gltf_result gltf_accessor_read_f32(const gltf_doc* doc,
 //
 // On failure:
 //   - returns GLTF_ERR_INVALID if arguments are invalid
-//   - returns GLTF_ERR_PARSE if accessor type/layout is not supported
+//   - returns GLTF_ERR_PARSE if the accessor has fewer than 3 components, no
+//     elements, an unsupported componentType, or an invalid layout
 //   - outputs are not modified
+gltf_result gltf_accessor_aabb3(const gltf_doc* doc,
+                                uint32_t accessor_index,
+                                uint32_t flags,
+                                float out_min3[3],
+                                float out_max3[3],
+                                gltf_error* out_err);
+
+// Same as gltf_accessor_aabb3(doc, accessor_index, GLTF_AABB_DEFAULT, ...).
+//
+// Kept for compatibility; despite the name, quantized encodings are accepted.
 gltf_result gltf_compute_aabb_pos3_f32_span(const gltf_doc* doc,
                                            uint32_t accessor_index,
                                            float out_min3[3],
                                            float out_max3[3],
                                            gltf_error* out_err);
 
+// Computes the mesh-space AABB of a mesh: the union of the POSITION bounds of
+// all its primitives (primitives without POSITION are skipped).
+//
+// On success:
+//   - returns GLTF_OK
+//   - writes min/max xyz to out_min3/out_max3
+//
+// On failure:
+//   - returns GLTF_ERR_INVALID if arguments are invalid or mesh_index is out of range
+//   - returns GLTF_ERR_PARSE if no primitive has POSITION, or as gltf_accessor_aabb3()
+//   - outputs are not modified
+gltf_result gltf_mesh_aabb(const gltf_doc* doc,
+                           uint32_t mesh_index,
+                           uint32_t flags,
+                           float out_min3[3],
+                           float out_max3[3],
+                           gltf_error* out_err);
+
+// Opaque cache for computed world matrices (see "Scene graph evaluation").
+typedef struct gltf_world_cache gltf_world_cache;
+
+// Computes world-space AABBs for every node of the scene in a world cache.
+//
+// Each mesh AABB is computed once (see gltf_mesh_aabb()) and transformed by the
+// node's world matrix from gltf_world_matrix(), giving the tight box of the
+// transformed mesh box.
+//
+// Output layout (arrays of doc node_count entries):
+//   - out_min3[n * 3 + 0..2], out_max3[n * 3 + 0..2]
+//   - out_has_bounds[n] (optional, may be NULL): 1 if node n has world bounds
+//
+// Nodes without a mesh, whose mesh has no POSITION, or that the cached scene
+// does not reach get an empty box (min = +inf, max = -inf) and has_bounds 0.
+//
+// On success:
+//   - returns GLTF_OK
+//
+// On failure:
+//   - returns GLTF_ERR_INVALID if arguments are invalid
+//   - returns GLTF_ERR_IO on allocation failure
+//   - returns the mesh AABB error for meshes with an invalid POSITION layout
+//   - outputs are partially written
+gltf_result gltf_compute_node_world_aabbs(const gltf_doc* doc,
+                                          const gltf_world_cache* cache,
+                                          uint32_t flags,
+                                          float* out_min3,
+                                          float* out_max3,
+                                          uint8_t* out_has_bounds,
+                                          gltf_error* out_err);
+
 
 // ----------------------------------------------------------------------------
 // Triangle iteration (primitive topology)
@@ -677,13 +1435,456 @@ gltf_result gltf_doc_primitive_iterate_triangles(const gltf_doc* doc,
                                                 void* user,
                                                 gltf_error* out_err);
 
+// Maximum number of triangles delivered per batch callback.
+#define GLTF_TRI_BATCH_MAX 1024u
+
+// Called for each block of generated triangles.
+//
+// Parameters:
+//   - tris: tri_count triangles, winding already applied (valid only during the call)
+//   - tri_first: triangle index of tris[0] within this primitive
+//   - tri_count: 1..batch_max
+//   - user: user context pointer passed to the iterator
+//
+// Return:
+//   - GLTF_ITER_CONTINUE to keep iterating
+//   - GLTF_ITER_STOP to stop early (iterator returns GLTF_OK)
+typedef gltf_iter_result (*gltf_tri_batch_cb)(const gltf_tri* tris,
+                                             uint32_t tri_first,
+                                             uint32_t tri_count,
+                                             void* user);
+
+// Returns the number of triangles a primitive produces.
+//
+// Validates the primitive exactly like gltf_doc_primitive_iterate_triangles()
+// (POSITION layout, index accessor layout, mode, TRIANGLES count % 3).
+//
+// On success:
+//   - returns GLTF_OK
+//   - writes the triangle count to *out_tri_count (0 if POSITION.count == 0)
+//
+// On failure:
+//   - returns the same codes as gltf_doc_primitive_iterate_triangles()
+//   - *out_tri_count is not modified
+gltf_result gltf_doc_primitive_triangle_count(const gltf_doc* doc,
+                                              uint32_t primitive_index,
+                                              uint32_t* out_tri_count,
+                                              gltf_error* out_err);
+
+// Iterates triangles produced by a primitive in blocks.
+//
+// Same triangles, order and winding as gltf_doc_primitive_iterate_triangles(),
+// but indices are decoded in bulk and cb is invoked once per block of up to
+// batch_max triangles (0 or values above GLTF_TRI_BATCH_MAX mean GLTF_TRI_BATCH_MAX).
+//
+// Notes:
+//   - A block is fully decoded and range-checked before it is delivered; an
+//     invalid index fails the call without delivering the block containing it.
+//
+// On success:
+//   - returns GLTF_OK
+//   - invokes cb for each block until completion or early stop
+//
+// On failure:
+//   - returns the same codes as gltf_doc_primitive_iterate_triangles()
+gltf_result gltf_doc_primitive_iterate_triangle_batches(const gltf_doc* doc,
+                                                        uint32_t primitive_index,
+                                                        uint32_t batch_max,
+                                                        gltf_tri_batch_cb cb,
+                                                        void* user,
+                                                        gltf_error* out_err);
+
+// Iterates triangles [tri_first, tri_first + tri_count) of a primitive in blocks.
+//
+// Like gltf_doc_primitive_iterate_triangle_batches() restricted to a range;
+// tri_count == UINT32_MAX means "to the end". The tri_first passed to cb is the
+// absolute triangle index, and TRIANGLE_STRIP winding parity follows it, so any
+// split of the range yields exactly the triangles of a full iteration.
+//
+// Thread-safety:
+//   - Disjoint (or overlapping) ranges of the same document may be iterated
+//     concurrently from multiple threads.
+//
+// On success:
+//   - returns GLTF_OK
+//   - invokes cb for each block until completion or early stop
+//
+// On failure:
+//   - returns GLTF_ERR_INVALID if the range exceeds the primitive's triangle count
+//   - otherwise the same codes as gltf_doc_primitive_iterate_triangles()
+gltf_result gltf_doc_primitive_iterate_triangle_range(const gltf_doc* doc,
+                                                      uint32_t primitive_index,
+                                                      uint32_t tri_first,
+                                                      uint32_t tri_count,
+                                                      uint32_t batch_max,
+                                                      gltf_tri_batch_cb cb,
+                                                      void* user,
+                                                      gltf_error* out_err);
+
+// One unit of parallel triangle work: a triangle range of one primitive.
+typedef struct gltf_tri_work_item {
+  uint32_t primitive_index;
+  uint32_t tri_first;
+  uint32_t tri_count;
+} gltf_tri_work_item;
+
+// Splits a primitive's triangles into work items of about target_tris_per_item.
+//
+// The primitive is cut into ceil(tri_count / target_tris_per_item) contiguous
+// ranges whose sizes differ by at most one triangle. Each item can be fed to
+// gltf_doc_primitive_iterate_triangle_range() or gltf_doc_primitive_read_triangles().
+//
+// Two-call pattern:
+//   - items == NULL: only *out_item_count is written
+//   - otherwise items[0..items_cap) receives the items
+//
+// On success:
+//   - returns GLTF_OK
+//   - writes the number of items to *out_item_count (0 for an empty primitive)
+//
+// On failure:
+//   - returns GLTF_ERR_INVALID for invalid arguments (target_tris_per_item == 0)
+//     or if items_cap is too small (*out_item_count still holds the required count)
+//   - otherwise the same codes as gltf_doc_primitive_iterate_triangles()
+gltf_result gltf_doc_primitive_triangle_work_items(const gltf_doc* doc,
+                                                   uint32_t primitive_index,
+                                                   uint32_t target_tris_per_item,
+                                                   gltf_tri_work_item* items,
+                                                   uint32_t items_cap,
+                                                   uint32_t* out_item_count,
+                                                   gltf_error* out_err);
+
+// Enumerates work items across all triangle primitives of the document.
+//
+// Every primitive with a TRIANGLES/TRIANGLE_STRIP/TRIANGLE_FAN mode is split as
+// in gltf_doc_primitive_triangle_work_items(); items are ordered by primitive
+// index, then by tri_first. Point and line primitives are skipped. Items never
+// span primitives, so primitives smaller than the target yield one smaller item.
+//
+// On success / failure: same contract as gltf_doc_primitive_triangle_work_items().
+gltf_result gltf_doc_triangle_work_items(const gltf_doc* doc,
+                                         uint32_t target_tris_per_item,
+                                         gltf_tri_work_item* items,
+                                         uint32_t items_cap,
+                                         uint32_t* out_item_count,
+                                         gltf_error* out_err);
+
+// Writes triangles [tri_first, tri_first + tri_count) of a primitive to dst.
+//
+// Works for every supported mode; winding is applied as in
+// gltf_doc_primitive_iterate_triangles(). For GLTF_PRIM_TRIANGLES the index
+// list is decoded directly into dst (gltf_tri is three packed uint32_t).
+//
+// On success:
+//   - returns GLTF_OK
+//   - writes tri_count triangles to dst
+//
+// On failure:
+//   - returns GLTF_ERR_INVALID if arguments are invalid or the range exceeds
+//     the primitive's triangle count
+//   - otherwise the same codes as gltf_doc_primitive_iterate_triangles()
+//   - dst contents are unspecified
+gltf_result gltf_doc_primitive_read_triangles(const gltf_doc* doc,
+                                              uint32_t primitive_index,
+                                              uint32_t tri_first,
+                                              uint32_t tri_count,
+                                              gltf_tri* dst,
+                                              gltf_error* out_err);
+
+
+// ----------------------------------------------------------------------------
+// Vertex packing
+// ----------------------------------------------------------------------------
+//
+// Writes the attribute slots of a primitive into one interleaved vertex buffer
+// described by a gltf_vertex_layout, converting each attribute to its target
+// format on the way. Attributes are decoded in blocks straight from their
+// spans; conversions run on 4-wide SIMD where available and match the scalar
+// code bit for bit.
+
+// Target encodings of a packed attribute.
+//
+// Conversions from the decoded float value v (normalized accessors are
+// decoded to [0, 1] / [-1, 1] first):
+//   - F32: v as is
+//   - F16: IEEE binary16, round to nearest even (overflow: infinity)
+//   - SNORM16 / SNORM8: round(clamp(v, -1, 1) * 32767 / 127)
+//   - UNORM16 / UNORM8: round(clamp(v, 0, 1) * 65535 / 255)
+//   - U16 / U8: round(clamp(v, 0, 65535 / 255)), for JOINTS_0
+//   - OCT_SNORM16: the first 3 components as a unit vector, octahedral-mapped
+//     to 2 x SNORM16 (always 2 components)
+// Rounding is to nearest even; NaN clamps to the upper bound.
+typedef enum gltf_vertex_format {
+  GLTF_VERTEX_F32 = 0,
+  GLTF_VERTEX_F16,
+  GLTF_VERTEX_SNORM16,
+  GLTF_VERTEX_UNORM16,
+  GLTF_VERTEX_SNORM8,
+  GLTF_VERTEX_UNORM8,
+  GLTF_VERTEX_U16,
+  GLTF_VERTEX_U8,
+  GLTF_VERTEX_OCT_SNORM16,
+} gltf_vertex_format;
+
+// One attribute of a packed vertex.
+typedef struct gltf_vertex_attrib {
+  uint32_t slot;       // gltf_attr_slot to read
+  uint32_t format;     // gltf_vertex_format to write
+  uint32_t components; // 1..4 components written (ignored for OCT_SNORM16)
+  uint32_t offset;     // byte offset within the vertex
+} gltf_vertex_attrib;
+
+// Interleaved vertex layout: attrib_count attributes in stride-byte vertices.
+//
+// Notes:
+//   - Components the accessor lacks are filled from (0, 0, 0, 1), and slots
+//     the primitive lacks are written as that default in full.
+//   - Bytes of a vertex that no attribute covers are left untouched.
+//   - Values are stored in host byte order, without alignment requirements.
+typedef struct gltf_vertex_layout {
+  const gltf_vertex_attrib* attribs;
+  uint32_t attrib_count;
+  uint32_t stride;
+} gltf_vertex_layout;
+
+// Returns the number of vertices of a primitive (its POSITION count).
+//
+// On success:
+//   - returns GLTF_OK
+//   - writes the count to *out_vertex_count
+//
+// On failure:
+//   - returns GLTF_ERR_INVALID for invalid arguments or an out-of-range primitive
+//   - returns GLTF_ERR_PARSE if the primitive has no valid POSITION accessor
+//   - *out_vertex_count is not modified
+gltf_result gltf_doc_primitive_vertex_count(const gltf_doc* doc,
+                                            uint32_t primitive_index,
+                                            uint32_t* out_vertex_count,
+                                            gltf_error* out_err);
+
+// Packs vertices [first, first + count) of a primitive into dst.
+//
+// Vertex first + i is written to dst + i * layout->stride; dst must hold
+// count * layout->stride bytes. Disjoint ranges and primitives may be packed
+// from several threads at once.
+//
+// On success:
+//   - returns GLTF_OK
+//   - writes count vertices to dst
+//
+// On failure:
+//   - returns GLTF_ERR_INVALID for invalid arguments, a bad layout (unknown
+//     slot or format, components outside 1..4, an attribute past stride) or a
+//     range past the vertex count
+//   - returns GLTF_ERR_PARSE if POSITION or a packed slot has an invalid
+//     layout, more than 4 components, or fewer elements than POSITION
+//   - dst contents are unspecified
+gltf_result gltf_doc_primitive_pack_vertices(const gltf_doc* doc,
+                                             uint32_t primitive_index,
+                                             const gltf_vertex_layout* layout,
+                                             uint32_t first,
+                                             uint32_t count,
+                                             void* dst,
+                                             gltf_error* out_err);
+
+// One gltf_doc_pack_vertices_batch() entry: the inputs of a
+// gltf_doc_primitive_pack_vertices() call and its outcome.
+typedef struct gltf_vertex_pack_job {
+  uint32_t primitive_index;
+  uint32_t first;
+  uint32_t count;
+  void* dst;
+
+  gltf_result result; // written by the batch
+  gltf_error error;   // written by the batch
+} gltf_vertex_pack_job;
+
+// Packs several primitives (or ranges of one) with a shared layout, one task
+// per job through dispatch (see gltf_dispatch_fn; NULL runs serially).
+//
+// On success (every job packed):
+//   - returns GLTF_OK
+//
+// On failure:
+//   - returns GLTF_ERR_INVALID for invalid arguments (jobs untouched)
+//   - otherwise returns the code of the first failed job and copies its error
+//     into out_err; every job's result and error are still filled in
+gltf_result gltf_doc_pack_vertices_batch(const gltf_doc* doc,
+                                         const gltf_vertex_layout* layout,
+                                         gltf_vertex_pack_job* jobs,
+                                         uint32_t job_count,
+                                         gltf_dispatch_fn dispatch,
+                                         void* dispatch_user,
+                                         gltf_error* out_err);
+
+// ----------------------------------------------------------------------------
+// Mesh optimization
+// ----------------------------------------------------------------------------
+//
+// Optional post-load stage that reorders the triangles of a primitive for the
+// GPU: vertex cache locality (Tipsify, Sander et al. 2007), then optionally
+// overdraw (clusters of the cache-ordered list sorted front to back in a
+// view-independent way), and a vertex fetch remap that renumbers vertices in
+// first-use order. The result is a fresh u16/u32 index buffer; the document
+// is not modified.
+
+// Post-transform cache size assumed when gltf_mesh_opt_options.cache_size is 0.
+#define GLTF_MESH_OPT_DEFAULT_CACHE_SIZE 16u
+
+// Flags for gltf_mesh_opt_options.flags.
+typedef enum gltf_mesh_opt_flags {
+  GLTF_MESH_OPT_VERTEX_CACHE = 1u << 0, // reorder triangles for the vertex cache
+  GLTF_MESH_OPT_OVERDRAW = 1u << 1,     // then reorder clusters to reduce overdraw (reads POSITION)
+  GLTF_MESH_OPT_VERTEX_FETCH = 1u << 2, // renumber vertices in first-use order (see vertex_remap)
+} gltf_mesh_opt_flags;
+
+// Options for gltf_doc_primitive_optimize_indices().
+//
+// Notes:
+//   - Zero-initialize and set flags; NULL options mean GLTF_MESH_OPT_VERTEX_CACHE
+//     with the defaults below.
+//   - flags == 0 only converts the primitive's triangles to an index buffer.
+typedef struct gltf_mesh_opt_options {
+  uint32_t flags;             // gltf_mesh_opt_flags
+  uint32_t cache_size;        // FIFO entries, 0 = GLTF_MESH_OPT_DEFAULT_CACHE_SIZE (max 256)
+  float overdraw_threshold;   // max cluster ACMR growth for overdraw splits, <= 0 = 1.05
+  uint32_t index_component_type; // 0 (u16 when every index fits), GLTF_COMP_U16 or GLTF_COMP_U32
+} gltf_mesh_opt_options;
+
+// An optimized index buffer.
+typedef struct gltf_optimized_indices {
+  void* indices;                 // index_count indices; owned, free via gltf_optimized_indices_free()
+  uint32_t index_count;          // 3 * triangle count
+  uint32_t index_component_type; // GLTF_COMP_U16 or GLTF_COMP_U32
+
+  // GLTF_MESH_OPT_VERTEX_FETCH only (NULL otherwise): vertex i of the
+  // reordered vertex buffer is source vertex vertex_remap[i]. Unreferenced
+  // source vertices are dropped. Owned like indices.
+  uint32_t* vertex_remap;
+  uint32_t vertex_count; // entries of vertex_remap, or the source vertex count
+} gltf_optimized_indices;
+
+// Builds an optimized index buffer for a primitive's triangles.
+//
+// Triangles come from gltf_doc_primitive_read_triangles() (every triangle
+// mode, winding preserved); the output is a triangle list. The same triangles
+// are kept, only their order (and with VERTEX_FETCH their vertex numbers)
+// changes. Different primitives may be optimized from several threads at once.
+//
+// On success:
+//   - returns GLTF_OK
+//   - fills *out (index_count == 0 and indices == NULL for an empty primitive)
+//
+// On failure:
+//   - returns GLTF_ERR_INVALID for invalid arguments or options, or if
+//     GLTF_COMP_U16 was requested and an index does not fit
+//   - returns GLTF_ERR_PARSE for an invalid primitive (see
+//     gltf_doc_primitive_read_triangles()) or an index past the POSITION count
+//   - returns GLTF_ERR_IO if scratch memory cannot be allocated
+//   - *out is not modified
+gltf_result gltf_doc_primitive_optimize_indices(const gltf_doc* doc,
+                                                uint32_t primitive_index,
+                                                const gltf_mesh_opt_options* options,
+                                                gltf_optimized_indices* out,
+                                                gltf_error* out_err);
+
+// Frees the buffers of a gltf_optimized_indices and zeroes it.
+// Safe to call with NULL or an already freed value.
+void gltf_optimized_indices_free(gltf_optimized_indices* p);
+
+// One gltf_doc_optimize_indices_batch() entry.
+typedef struct gltf_mesh_opt_job {
+  uint32_t primitive_index;
+
+  gltf_result result;         // written by the batch
+  gltf_error error;           // written by the batch
+  gltf_optimized_indices out; // written by the batch; zeroed when result != GLTF_OK
+} gltf_mesh_opt_job;
+
+// Optimizes several primitives with shared options, one task per job through
+// dispatch (see gltf_dispatch_fn; NULL runs serially). Suited to a bake step.
+//
+// On success (every job optimized):
+//   - returns GLTF_OK; the caller frees each job's out
+//
+// On failure:
+//   - returns GLTF_ERR_INVALID for invalid arguments (jobs untouched)
+//   - otherwise returns the code of the first failed job and copies its error
+//     into out_err; every job is still filled in (free the successful ones)
+gltf_result gltf_doc_optimize_indices_batch(const gltf_doc* doc,
+                                            const gltf_mesh_opt_options* options,
+                                            gltf_mesh_opt_job* jobs,
+                                            uint32_t job_count,
+                                            gltf_dispatch_fn dispatch,
+                                            void* dispatch_user,
+                                            gltf_error* out_err);
+
+// Average cache miss ratio (post-transform vertex cache misses per triangle)
+// of a triangle list under a FIFO cache of cache_size entries (0 =
+// GLTF_MESH_OPT_DEFAULT_CACHE_SIZE). Lower is better; 3.0 is the worst case.
+//
+// On success:
+//   - returns GLTF_OK and writes the ratio to *out_acmr (0 for no triangles)
+//
+// On failure:
+//   - returns GLTF_ERR_INVALID for invalid arguments, index_count % 3 != 0 or
+//     an index >= vertex_count
+//   - returns GLTF_ERR_IO if scratch memory cannot be allocated
+gltf_result gltf_analyze_vertex_cache(const uint32_t* indices,
+                                      uint32_t index_count,
+                                      uint32_t vertex_count,
+                                      uint32_t cache_size,
+                                      float* out_acmr,
+                                      gltf_error* out_err);
+
+// ----------------------------------------------------------------------------
+// Task dispatch (optional parallelism)
+// ----------------------------------------------------------------------------
+//
+// Functions that can run in parallel take a gltf_dispatch_fn and its user
+// pointer. The library never creates threads on its own: pass your job
+// system's dispatcher, the built-in gltf_thread_pool_dispatch() with a pool, or
+// NULL to run everything on the calling thread. gltf_task_fn and
+// gltf_dispatch_fn are declared with the load options.
+
+// Small built-in thread pool (fixed worker threads, no work stealing).
+typedef struct gltf_thread_pool gltf_thread_pool;
+
+// Creates a pool with thread_count worker threads; 0 picks the number of
+// logical CPUs minus one. The calling thread also runs tasks while it waits.
+//
+// On success:
+//   - returns GLTF_OK
+//   - *out_pool is set to a pool freed with gltf_thread_pool_free()
+//
+// On failure:
+//   - returns GLTF_ERR_INVALID for invalid arguments
+//   - returns GLTF_ERR_IO if memory or threads cannot be allocated
+//   - *out_pool is set to NULL
+gltf_result gltf_thread_pool_create(uint32_t thread_count,
+                                    gltf_thread_pool** out_pool,
+                                    gltf_error* out_err);
+
+// Stops and joins the workers. Safe to call with NULL.
+void gltf_thread_pool_free(gltf_thread_pool* pool);
+
+// gltf_dispatch_fn for a gltf_thread_pool (pass the pool as dispatch_user).
+//
+// Concurrent calls on one pool are serialized. Tasks must not dispatch to the
+// same pool again (that deadlocks).
+void gltf_thread_pool_dispatch(void* pool,
+                               uint32_t task_count,
+                               gltf_task_fn task,
+                               void* task_user);
+
 
 // ----------------------------------------------------------------------------
 // Scene graph evaluation (node transforms)
 // ----------------------------------------------------------------------------
 
 // Opaque cache for computed world matrices.
-// Created per-document and reused across scenes/runs.
+// Created per-document and reused across scenes/runs. Matrices are stored per
+// node, so nodes shared by several scenes are computed once.
 typedef struct gltf_world_cache gltf_world_cache;
 
 // Creates a cache sized for the document's node count.
@@ -703,7 +1904,31 @@ gltf_result gltf_world_cache_create(const gltf_doc* doc,
                                     gltf_world_cache** out_cache,
                                     gltf_error* out_err);
 
-// Frees a cache created with gltf_world_cache_create().
+// Creation flags for gltf_world_cache_create_ex().
+typedef enum gltf_world_cache_flags {
+  GLTF_WORLD_CACHE_DEFAULT = 0,
+  // Keep node TRS in a structure-of-arrays layout inside the cache and compose
+  // local matrices four nodes at a time (SSE2/NEON when available). Worth it
+  // for large hierarchies that are fully re-evaluated often (skinned
+  // characters); costs 26 floats of extra storage per node.
+  GLTF_WORLD_CACHE_SOA = 1u << 0,
+} gltf_world_cache_flags;
+
+// Same as gltf_world_cache_create() with creation flags (gltf_world_cache_flags).
+//
+// Results match the default cache up to float rounding; every other function
+// behaves the same for both layouts.
+//
+// On failure:
+//   - returns GLTF_ERR_INVALID for invalid arguments or unknown flags
+//   - returns GLTF_ERR_IO if allocation fails
+//   - *out_cache is set to NULL
+gltf_result gltf_world_cache_create_ex(const gltf_doc* doc,
+                                       uint32_t flags,
+                                       gltf_world_cache** out_cache,
+                                       gltf_error* out_err);
+
+// Frees a cache created with gltf_world_cache_create() or _create_ex().
 // Safe to call with NULL.
 void gltf_world_cache_free(gltf_world_cache* cache);
 
@@ -719,6 +1944,11 @@ void gltf_world_cache_free(gltf_world_cache* cache);
 //
 // Matrices are column-major (glTF convention).
 //
+// The scene becomes the one gltf_world_matrix() answers for. Only matrices
+// that are not already current are evaluated: switching back to a scene
+// computed earlier is free unless overrides changed it (pending overrides are
+// applied first, as by gltf_update_world_matrices()).
+//
 // On success:
 //   - returns GLTF_OK
 //
@@ -730,6 +1960,21 @@ gltf_result gltf_compute_world_matrices(const gltf_doc* doc,
                                        gltf_world_cache* cache,
                                        gltf_error* out_err);
 
+// Same as gltf_compute_world_matrices(), evaluating each depth level of the
+// flattened scene in parallel through dispatch (NULL runs serially).
+//
+// Levels are split into chunks of a few hundred nodes; narrow levels run on
+// the calling thread. Results are identical to the serial computation. Wide
+// scenes (many roots or many siblings) benefit; a single deep chain does not.
+//
+// Same success/failure contract as gltf_compute_world_matrices().
+gltf_result gltf_compute_world_matrices_parallel(const gltf_doc* doc,
+                                                 uint32_t scene_index,
+                                                 gltf_world_cache* cache,
+                                                 gltf_dispatch_fn dispatch,
+                                                 void* dispatch_user,
+                                                 gltf_error* out_err);
+
 // Returns the computed world matrix for a node (column-major).
 //
 // Requirements:
@@ -765,6 +2010,67 @@ int gltf_node_local_matrix(const gltf_doc* doc,
                            uint32_t node_index,
                            float out_m16[16]);
 
+// Overrides a node's local transform inside a world cache (TRS form).
+//
+// The document is not modified; the override applies to every evaluation done
+// with this cache. NULL components keep the document's value for that node.
+// local = T * R * S, as for document nodes.
+//
+// The node is marked dirty: gltf_update_world_matrices() recomputes it and its
+// descendants, and gltf_compute_world_matrices() always includes overrides.
+//
+// On success:
+//   - returns GLTF_OK
+//
+// On failure:
+//   - returns GLTF_ERR_INVALID for invalid arguments or node_index out of range
+//   - returns GLTF_ERR_IO if the override storage cannot be allocated
+gltf_result gltf_world_cache_set_local_trs(const gltf_doc* doc,
+                                           gltf_world_cache* cache,
+                                           uint32_t node_index,
+                                           const float translation[3],
+                                           const float rotation[4],
+                                           const float scale[3],
+                                           gltf_error* out_err);
+
+// Overrides a node's local transform inside a world cache (column-major matrix).
+//
+// Same contract as gltf_world_cache_set_local_trs().
+gltf_result gltf_world_cache_set_local_matrix(const gltf_doc* doc,
+                                              gltf_world_cache* cache,
+                                              uint32_t node_index,
+                                              const float m16[16],
+                                              gltf_error* out_err);
+
+// Removes a node's local override (the document's TRS/matrix applies again).
+//
+// The node is marked dirty if it had an override. Same failure codes as
+// gltf_world_cache_set_local_trs().
+gltf_result gltf_world_cache_clear_local(const gltf_doc* doc,
+                                         gltf_world_cache* cache,
+                                         uint32_t node_index,
+                                         gltf_error* out_err);
+
+// Recomputes world matrices of dirty nodes and their descendants only.
+//
+// Cost is proportional to the size of the dirty subtrees, not to the scene.
+// Subtrees are updated for every computed scene that contains them; dirty
+// nodes no scene has computed yet are evaluated by the next
+// gltf_compute_world_matrices() that reaches them.
+//
+// Requirements:
+//   - gltf_compute_world_matrices() must have succeeded for this cache
+//
+// On success:
+//   - returns GLTF_OK (nothing to do if no node is dirty)
+//
+// On failure:
+//   - returns GLTF_ERR_INVALID for invalid arguments or if the cache holds no
+//     computed matrices
+gltf_result gltf_update_world_matrices(const gltf_doc* doc,
+                                       gltf_world_cache* cache,
+                                       gltf_error* out_err);
+
 
 // ----------------------------------------------------------------------------
 // Materials / Textures (glTF 2.0 core)
@@ -1067,6 +2373,74 @@ gltf_result gltf_image_decode_rgba8(const gltf_doc* doc,
                                     gltf_image_pixels* out_pixels,
                                     gltf_error* out_err);
 
+// Image header information (no pixel decode).
+typedef struct gltf_image_info {
+  uint32_t width;
+  uint32_t height;
+  uint32_t channels; // 1 = grey, 2 = grey+alpha, 3 = RGB, 4 = RGBA
+} gltf_image_info;
+
+// Reads the dimensions and native channel count of doc.images[image_index]
+// from its header. URI images only read the file header; data URI and
+// bufferView images are not decoded beyond the header.
+//
+// On success: returns GLTF_OK and fills out_info.
+// On failure: returns non-OK and out_info is not modified.
+gltf_result gltf_image_get_info(const gltf_doc* doc,
+                                uint32_t image_index,
+                                gltf_image_info* out_info,
+                                gltf_error* out_err);
+
+// Decodes doc.images[image_index] into a caller-owned buffer.
+//
+// channels selects the output layout (1..4, converted like stb_image's
+// req_comp); 0 keeps the native channel count. Rows start every row_pitch
+// bytes (0 = tightly packed, width * channels). dst_size must cover
+// row_pitch * (height - 1) + width * channels bytes; use gltf_image_get_info()
+// to size it. Padding bytes between rows are left untouched.
+//
+// On success: returns GLTF_OK, fills dst and (if non-NULL) out_info with the
+//   written dimensions and channel count.
+// On failure: returns non-OK; GLTF_ERR_INVALID when dst is too small or the
+//   pitch is shorter than a row (checked before decoding).
+gltf_result gltf_image_decode_into(const gltf_doc* doc,
+                                   uint32_t image_index,
+                                   uint32_t channels,
+                                   uint8_t* dst,
+                                   size_t dst_size,
+                                   uint32_t row_pitch,
+                                   gltf_image_info* out_info,
+                                   gltf_error* out_err);
+
+// Per-image outcome of gltf_image_decode_rgba8_batch().
+typedef struct gltf_image_decode_result {
+  gltf_result result;       // GLTF_OK or the code gltf_image_decode_rgba8() returned
+  gltf_error error;         // error context when result != GLTF_OK
+  gltf_image_pixels pixels; // valid when result == GLTF_OK; free via gltf_image_pixels_free()
+} gltf_image_decode_result;
+
+// Decodes several images in parallel (one task per image: read + decode).
+//
+// out_results[i] receives the outcome for image_indices[i]; the same index may
+// appear more than once. Tasks run through dispatch (see gltf_dispatch_fn);
+// NULL decodes serially on the calling thread.
+//
+// On success (every image decoded):
+//   - returns GLTF_OK
+//
+// On failure:
+//   - returns GLTF_ERR_INVALID for invalid arguments (out_results untouched)
+//   - otherwise returns the code of the first failed entry and copies its
+//     error into out_err; every entry of out_results is still filled in, and
+//     the successful ones own pixels
+gltf_result gltf_image_decode_rgba8_batch(const gltf_doc* doc,
+                                          const uint32_t* image_indices,
+                                          uint32_t count,
+                                          gltf_image_decode_result* out_results,
+                                          gltf_dispatch_fn dispatch,
+                                          void* dispatch_user,
+                                          gltf_error* out_err);
+
 // Convenience: write RGBA8 buffer as PNG to disk (used by examples).
 gltf_result gltf_write_png_rgba8(const char* path,
                                  uint32_t width,
@@ -1079,6 +2453,150 @@ gltf_result gltf_write_png_rgba8(const char* path,
 void gltf_image_pixels_free(gltf_image_pixels* p);
 
 
+// ----------------------------------------------------------------------------
+// Mip chains
+// ----------------------------------------------------------------------------
+//
+// Builds every mip level of an RGBA8 image in one allocation. Each level is
+// downsampled 2:1 from the previous one (odd sizes round down, minimum 1) until
+// 1x1. Filtering runs in float; sRGB images are filtered in linear light and
+// re-encoded (alpha is always linear). Rows of a level are split into tasks
+// through an optional gltf_dispatch_fn; the output does not depend on it.
+// Temporary float storage is about the size of the chain itself (level 1 is
+// filtered straight from the RGBA8 level 0).
+
+typedef enum gltf_mip_filter {
+  GLTF_MIP_BOX = 0,    // 2x2 average
+  GLTF_MIP_KAISER = 1  // 6-tap separable Kaiser-windowed sinc (sharper, may ring)
+} gltf_mip_filter;
+
+typedef enum gltf_mip_flags {
+  GLTF_MIP_SRGB = 1u << 0,                // color channels are sRGB encoded
+  GLTF_MIP_SRGB_FROM_MATERIALS = 1u << 1  // decode only: sRGB if gltf_image_is_srgb()
+} gltf_mip_flags;
+
+#define GLTF_MIP_MAX_LEVELS 32u
+
+typedef struct gltf_mip_level {
+  uint32_t width;
+  uint32_t height;
+  uint32_t stride_bytes; // width * 4
+  size_t offset;         // byte offset of the level in gltf_mip_chain.data
+} gltf_mip_level;
+
+typedef struct gltf_mip_chain {
+  uint32_t level_count;                       // levels[0] is the full image
+  gltf_mip_level levels[GLTF_MIP_MAX_LEVELS];
+  uint8_t* data;                              // all levels, level 0 first; free via gltf_mip_chain_free()
+  size_t size;                                // total bytes in data
+} gltf_mip_chain;
+
+// Returns 1 if doc.images[image_index] holds color data (referenced by a
+// material base color or emissive texture), which glTF stores as sRGB.
+// Returns 0 otherwise (including invalid arguments).
+int gltf_image_is_srgb(const gltf_doc* doc, uint32_t image_index);
+
+// Builds a mip chain from RGBA8 pixels. stride_bytes = 0 means width * 4.
+// flags: GLTF_MIP_SRGB or 0.
+//
+// On success: returns GLTF_OK and fills out_chain (level 0 is a copy of the input).
+// On failure: returns non-OK and out_chain is not modified.
+gltf_result gltf_image_build_mips_rgba8(const uint8_t* rgba,
+                                        uint32_t width,
+                                        uint32_t height,
+                                        uint32_t stride_bytes,
+                                        gltf_mip_filter filter,
+                                        uint32_t flags,
+                                        gltf_dispatch_fn dispatch,
+                                        void* dispatch_user,
+                                        gltf_mip_chain* out_chain,
+                                        gltf_error* out_err);
+
+// Decodes doc.images[image_index] once and builds the remaining levels
+// behind it: the decoded RGBA8 buffer is reallocated to the chain size and
+// becomes level 0, so it is copied only if realloc() has to move it.
+// flags: any of gltf_mip_flags.
+//
+// On success: returns GLTF_OK and fills out_chain.
+// On failure: returns non-OK and out_chain is not modified; returns
+//   GLTF_ERR_UNSUPPORTED when built with GLTF_ENABLE_IMAGES=0.
+gltf_result gltf_image_decode_mips_rgba8(const gltf_doc* doc,
+                                         uint32_t image_index,
+                                         gltf_mip_filter filter,
+                                         uint32_t flags,
+                                         gltf_dispatch_fn dispatch,
+                                         void* dispatch_user,
+                                         gltf_mip_chain* out_chain,
+                                         gltf_error* out_err);
+
+// Frees a chain built by the functions above. Safe to call with NULL.
+void gltf_mip_chain_free(gltf_mip_chain* chain);
+
+
+// ----------------------------------------------------------------------------
+// Decoded image cache
+// ----------------------------------------------------------------------------
+//
+// Shares decoded RGBA8 images across documents and threads. Entries are keyed
+// by source identity, so the same texture referenced from several documents is
+// decoded once:
+//   - URI images: resolved path + file size + modification time (a rewritten
+//     file is decoded again)
+//   - data URI / bufferView images: 64-bit content hash + length
+//
+// Entries are reference counted. Unreferenced entries stay cached in LRU order
+// and are evicted once the decoded bytes exceed the budget.
+//
+// All functions are thread-safe. Concurrent misses on the same image wait for
+// a single decode.
+
+typedef struct gltf_image_cache gltf_image_cache;
+
+typedef struct gltf_image_cache_stats {
+  uint64_t bytes;     // decoded bytes currently held
+  uint32_t entries;   // cached images (referenced or not)
+  uint64_t hits;
+  uint64_t misses;
+  uint64_t evictions;
+} gltf_image_cache_stats;
+
+// Creates an empty cache. byte_budget limits the decoded bytes kept for
+// unreferenced entries (0 = unlimited); referenced entries are never evicted.
+//
+// On success: returns GLTF_OK and writes *out_cache.
+// On failure: returns non-OK and writes *out_cache = NULL.
+gltf_result gltf_image_cache_create(uint64_t byte_budget,
+                                    gltf_image_cache** out_cache,
+                                    gltf_error* out_err);
+
+// Frees the cache and every entry. All acquired pixels must be released first.
+// Safe to call with NULL.
+void gltf_image_cache_free(gltf_image_cache* cache);
+
+// Returns the decoded RGBA8 pixels for doc.images[image_index], decoding on a
+// miss. The pixels are shared and read-only; they stay valid until the matching
+// gltf_image_cache_release() (the document may be freed earlier).
+//
+// On success: returns GLTF_OK and writes *out_pixels.
+// On failure: returns non-OK and writes *out_pixels = NULL; returns
+//   GLTF_ERR_UNSUPPORTED when built with GLTF_ENABLE_IMAGES=0.
+gltf_result gltf_image_cache_acquire_rgba8(gltf_image_cache* cache,
+                                           const gltf_doc* doc,
+                                           uint32_t image_index,
+                                           const gltf_image_pixels** out_pixels,
+                                           gltf_error* out_err);
+
+// Drops one reference taken by gltf_image_cache_acquire_rgba8().
+// Safe to call with NULL pixels.
+void gltf_image_cache_release(gltf_image_cache* cache, const gltf_image_pixels* pixels);
+
+// Changes the byte budget and evicts unreferenced entries past it.
+void gltf_image_cache_set_budget(gltf_image_cache* cache, uint64_t byte_budget);
+
+// Snapshot of the cache counters.
+void gltf_image_cache_get_stats(gltf_image_cache* cache, gltf_image_cache_stats* out_stats);
+
+
 #ifdef __cplusplus
 }
 #endif
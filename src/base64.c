@@ -5,14 +5,21 @@
 // Responsibilities:
 //   - compute a safe upper bound for decoded size
 //   - decode base64 payloads while skipping ASCII whitespace
+//   - vectorized bulk decode of whitespace-free runs (SSE2/SSSE3/AVX2/NEON)
 //
 // Notes:
 //   - This is an internal helper used by src/gltf_parse.c.
 //   - The decoder is strict: padding must be final; only whitespace may follow.
+//   - The bulk kernels only consume whole blocks made of the 64 alphabet
+//     characters; padding, whitespace, invalid bytes and the tail are left to
+//     the scalar loop, so both paths accept exactly the same inputs.
 
 
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
+
+#include "gltf_simd.h"
 
 #define B64_INVALID 0u
 #define B64_PAD     0xFEu
@@ -49,6 +56,203 @@ static const uint8_t k_b64_lut[256] = {
   ['\v'] = B64_SKIP,
 };
 
+
+// ----------------------------------------------------------------------------
+// Bulk decode (SIMD)
+// ----------------------------------------------------------------------------
+//
+// Each kernel decodes whole blocks of alphabet characters starting at in[*io_i]
+// into out[*io_o] and advances both positions. It stops at the first block
+// holding any other byte, or when the next block (plus the kernel's store
+// overrun) would not fit in the output. Stores may write up to 4 (SSSE3) or 8
+// (AVX2) bytes past the decoded block, always inside out_cap.
+
+#if GLTF_SIMD_SSE2
+
+// Maps 16 alphabet characters to their 6-bit values. Returns 0 if any byte is
+// outside the alphabet.
+static inline int b64_translate_sse2(__m128i in, __m128i* out_values) {
+#if GLTF_SIMD_SSSE3
+  // Nibble-classification lookup (Mula & Lemire).
+  const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                       0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+  const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                       0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i nib = _mm_set1_epi8(0x0F);
+
+  const __m128i hi = _mm_and_si128(_mm_srli_epi32(in, 4), nib);
+  const __m128i lo = _mm_and_si128(in, nib);
+  const __m128i bad = _mm_and_si128(_mm_shuffle_epi8(lut_lo, lo), _mm_shuffle_epi8(lut_hi, hi));
+  if (_mm_movemask_epi8(_mm_cmpeq_epi8(bad, _mm_setzero_si128())) != 0xFFFF) return 0;
+
+  const __m128i slash = _mm_cmpeq_epi8(in, _mm_set1_epi8('/'));
+  *out_values = _mm_add_epi8(in, _mm_shuffle_epi8(lut_roll, _mm_add_epi8(slash, hi)));
+  return 1;
+#else
+  // Range compares; bytes >= 0x80 are negative and match no range.
+#define B64_RANGE(lo_c, hi_c) \
+  _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8((char)((lo_c) - 1))), \
+                _mm_cmplt_epi8(in, _mm_set1_epi8((char)((hi_c) + 1))))
+  const __m128i upper = B64_RANGE('A', 'Z');
+  const __m128i lower = B64_RANGE('a', 'z');
+  const __m128i digit = B64_RANGE('0', '9');
+#undef B64_RANGE
+  const __m128i plus = _mm_cmpeq_epi8(in, _mm_set1_epi8('+'));
+  const __m128i slash = _mm_cmpeq_epi8(in, _mm_set1_epi8('/'));
+
+  const __m128i any = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(_mm_or_si128(digit, plus), slash));
+  if (_mm_movemask_epi8(any) != 0xFFFF) return 0;
+
+  __m128i roll = _mm_and_si128(upper, _mm_set1_epi8(-65));
+  roll = _mm_or_si128(roll, _mm_and_si128(lower, _mm_set1_epi8(-71)));
+  roll = _mm_or_si128(roll, _mm_and_si128(digit, _mm_set1_epi8(4)));
+  roll = _mm_or_si128(roll, _mm_and_si128(plus, _mm_set1_epi8(19)));
+  roll = _mm_or_si128(roll, _mm_and_si128(slash, _mm_set1_epi8(16)));
+  *out_values = _mm_add_epi8(in, roll);
+  return 1;
+#endif
+}
+
+// Packs 16 6-bit values (4 per 32-bit lane) into 24-bit groups, one per lane,
+// with the first output byte in bits 16..23.
+static inline __m128i b64_pack_sse2(__m128i v) {
+#if GLTF_SIMD_SSSE3
+  const __m128i ab = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+#else
+  const __m128i ab = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(v, _mm_set1_epi16(0x00FF)), 6),
+                                  _mm_srli_epi16(v, 8));
+#endif
+  return _mm_madd_epi16(ab, _mm_set1_epi32(0x00011000));
+}
+
+static void b64_decode_bulk(const char* in, size_t in_len, uint8_t* out, size_t out_cap,
+                            size_t* io_i, size_t* io_o) {
+  size_t i = *io_i, o = *io_o;
+
+#if GLTF_SIMD_AVX2
+  {
+    const __m256i lut_lo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                            0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                                            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                            0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lut_hi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                            0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                            0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lut_roll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                              0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i gather = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+    const __m256i nib = _mm256_set1_epi8(0x0F);
+
+    while (in_len - i >= 32u && out_cap - o >= 32u) {
+      const __m256i c = _mm256_loadu_si256((const __m256i*)(const void*)(in + i));
+      const __m256i hi = _mm256_and_si256(_mm256_srli_epi32(c, 4), nib);
+      const __m256i lo = _mm256_and_si256(c, nib);
+      const __m256i bad = _mm256_and_si256(_mm256_shuffle_epi8(lut_lo, lo), _mm256_shuffle_epi8(lut_hi, hi));
+      if (!_mm256_testz_si256(bad, bad)) break;
+
+      const __m256i slash = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('/'));
+      const __m256i v = _mm256_add_epi8(c, _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(slash, hi)));
+      const __m256i ab = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+      const __m256i abcd = _mm256_madd_epi16(ab, _mm256_set1_epi32(0x00011000));
+      const __m256i bytes = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(abcd, gather), lanes);
+      _mm256_storeu_si256((__m256i*)(void*)(out + o), bytes);
+      i += 32u;
+      o += 24u;
+    }
+  }
+#endif
+
+  while (in_len - i >= 16u && out_cap - o >= 16u) {
+    __m128i v;
+    if (!b64_translate_sse2(_mm_loadu_si128((const __m128i*)(const void*)(in + i)), &v)) break;
+    const __m128i abcd = b64_pack_sse2(v);
+#if GLTF_SIMD_SSSE3
+    const __m128i gather = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    _mm_storeu_si128((__m128i*)(void*)(out + o), _mm_shuffle_epi8(abcd, gather));
+#else
+    uint32_t g[4];
+    _mm_storeu_si128((__m128i*)(void*)g, abcd);
+    for (int k = 0; k < 4; k++) {
+      out[o + (size_t)k * 3u + 0u] = (uint8_t)(g[k] >> 16u);
+      out[o + (size_t)k * 3u + 1u] = (uint8_t)(g[k] >> 8u);
+      out[o + (size_t)k * 3u + 2u] = (uint8_t)g[k];
+    }
+#endif
+    i += 16u;
+    o += 12u;
+  }
+
+  *io_i = i;
+  *io_o = o;
+}
+
+#elif GLTF_SIMD_NEON
+
+// Maps 16 characters to 6-bit values; lanes outside the alphabet get 0xFF in *bad.
+static inline uint8x16_t b64_translate_neon(uint8x16_t c, uint8x16_t* bad) {
+  const uint8x16_t upper = vcleq_u8(vsubq_u8(c, vdupq_n_u8('A')), vdupq_n_u8(25));
+  const uint8x16_t lower = vcleq_u8(vsubq_u8(c, vdupq_n_u8('a')), vdupq_n_u8(25));
+  const uint8x16_t digit = vcleq_u8(vsubq_u8(c, vdupq_n_u8('0')), vdupq_n_u8(9));
+  const uint8x16_t plus = vceqq_u8(c, vdupq_n_u8('+'));
+  const uint8x16_t slash = vceqq_u8(c, vdupq_n_u8('/'));
+
+  uint8x16_t roll = vandq_u8(upper, vdupq_n_u8((uint8_t)-65));
+  roll = vorrq_u8(roll, vandq_u8(lower, vdupq_n_u8((uint8_t)-71)));
+  roll = vorrq_u8(roll, vandq_u8(digit, vdupq_n_u8(4)));
+  roll = vorrq_u8(roll, vandq_u8(plus, vdupq_n_u8(19)));
+  roll = vorrq_u8(roll, vandq_u8(slash, vdupq_n_u8(16)));
+
+  const uint8x16_t any = vorrq_u8(vorrq_u8(upper, lower), vorrq_u8(vorrq_u8(digit, plus), slash));
+  *bad = vorrq_u8(*bad, vmvnq_u8(any));
+  return vaddq_u8(c, roll);
+}
+
+static void b64_decode_bulk(const char* in, size_t in_len, uint8_t* out, size_t out_cap,
+                            size_t* io_i, size_t* io_o) {
+  size_t i = *io_i, o = *io_o;
+
+  // vld4 deinterleaves 64 characters into the a/b/c/d positions of 16 quads.
+  while (in_len - i >= 64u && out_cap - o >= 48u) {
+    const uint8x16x4_t q = vld4q_u8((const uint8_t*)(in + i));
+    uint8x16_t bad = vdupq_n_u8(0);
+    const uint8x16_t a = b64_translate_neon(q.val[0], &bad);
+    const uint8x16_t b = b64_translate_neon(q.val[1], &bad);
+    const uint8x16_t c = b64_translate_neon(q.val[2], &bad);
+    const uint8x16_t d = b64_translate_neon(q.val[3], &bad);
+    if (vmaxvq_u8(bad) != 0) break;
+
+    uint8x16x3_t r;
+    r.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+    r.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(c, 2));
+    r.val[2] = vorrq_u8(vshlq_n_u8(c, 6), d);
+    vst3q_u8(out + o, r);
+    i += 64u;
+    o += 48u;
+  }
+
+  *io_i = i;
+  *io_o = o;
+}
+
+#else
+
+static void b64_decode_bulk(const char* in, size_t in_len, uint8_t* out, size_t out_cap,
+                            size_t* io_i, size_t* io_o) {
+  (void)in;
+  (void)in_len;
+  (void)out;
+  (void)out_cap;
+  (void)io_i;
+  (void)io_o;
+}
+
+#endif
+
+
 // ----------------------------------------------------------------------------
 // Base64 decode
 // ----------------------------------------------------------------------------
@@ -76,7 +280,18 @@ int gltf_base64_decode(const char* in, size_t in_len,
   int qn = 0;
   int finished = 0;
 
+  // The bulk kernel runs at quad boundaries; after it stops (whitespace,
+  // padding, bad byte, tail) it is retried once the scalar loop has moved past
+  // the blocking block, which keeps line-wrapped payloads mostly vectorized.
+  size_t bulk_at = 0;
+
   for (size_t i = 0; i < in_len; i++) {
+    if (qn == 0 && !finished && i >= bulk_at) {
+      b64_decode_bulk(in, in_len, out, out_cap, &i, &o);
+      bulk_at = i + 16u;
+      if (i >= in_len) break;
+    }
+
     const uint8_t c = (uint8_t)(unsigned char)in[i];
     const uint8_t t = k_b64_lut[c];
 
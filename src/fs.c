@@ -6,6 +6,10 @@
 //   - compute a directory prefix length from a path
 //   - join a base directory and leaf path into a malloc()'d string
 //   - read an entire file (or an expected number of bytes)
+//   - map a file read-only or copy-on-write (mmap / MapViewOfFile) and unmap it
+//   - replace a file atomically by renaming a temporary over it
+//   - read a file's size and modification time (cache invalidation)
+//   - route reads and maps through a caller's gltf_io instead (the *_io variants)
 //
 // Notes:
 //   - These helpers are internal; public API contracts live in include/gltf/gltf.h.
@@ -13,17 +17,40 @@
 //     recognized when built with _WIN32.
 
 
+// mmap/open/fstat are POSIX, not C11; request them explicitly (before any include).
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include <stdint.h>
 #include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
+#include "gltf/gltf.h" // gltf_io
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #ifndef GLTF_FS_MAX_FILE_SIZE
 // Hard cap to keep APIs that use uint32_t lengths safe.
 #define GLTF_FS_MAX_FILE_SIZE ((size_t)0xFFFFFFFFu)
 #endif
 
+// gltf_fs_read_file() appends this many zero bytes after the file contents so
+// the buffer can be handed to yyjson's in-place reader (YYJSON_PADDING_SIZE).
+#define GLTF_FS_READ_PADDING 4u
+
 typedef enum gltf_fs_status {
   GLTF_FS_OK = 0,
   GLTF_FS_INVALID,
@@ -206,6 +233,7 @@ int gltf_path_is_relative(const char* path) {
 
 // Reads whole file into memory.
 // - On success: *out_data is malloc-owned (free by caller), *out_size is set.
+//   The buffer is followed by GLTF_FS_READ_PADDING zero bytes (not counted in size).
 // - On failure: *out_data == NULL, *out_size == 0.
 gltf_fs_status gltf_fs_read_file(const char* path, uint8_t** out_data, size_t* out_size) {
   if (out_data) *out_data = NULL;
@@ -242,11 +270,12 @@ gltf_fs_status gltf_fs_read_file(const char* path, uint8_t** out_data, size_t* o
     return GLTF_FS_IO;
   }
 
-  uint8_t* buf = (uint8_t*)malloc(size ? size : 1); // malloc(0) can be NULL; avoid that
+  uint8_t* buf = (uint8_t*)malloc(size + GLTF_FS_READ_PADDING);
   if (!buf) {
     fclose(f);
     return GLTF_FS_OOM;
   }
+  memset(buf + size, 0, GLTF_FS_READ_PADDING);
 
   size_t got = fread(buf, 1, size, f);
   if (got != size) {
@@ -261,3 +290,315 @@ gltf_fs_status gltf_fs_read_file(const char* path, uint8_t** out_data, size_t* o
   *out_size = size;
   return GLTF_FS_OK;
 }
+
+// ----------------------------------------------------------------------------
+// Memory mapping
+// ----------------------------------------------------------------------------
+
+// Maps a whole file read-only, or copy-on-write when 'writable' is set
+// (writes stay private to the process and never reach the file).
+static gltf_fs_status gltf_fs_map_impl(const char* path,
+                                       uint32_t expected_len,
+                                       int writable,
+                                       const uint8_t** out_data,
+                                       size_t* out_size) {
+  if (!path || !out_data || !out_size) return GLTF_FS_INVALID;
+  *out_data = NULL;
+  *out_size = 0;
+
+#ifdef _WIN32
+  HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE) return GLTF_FS_IO;
+
+  LARGE_INTEGER li;
+  if (!GetFileSizeEx(file, &li) || li.QuadPart < 0) {
+    CloseHandle(file);
+    return GLTF_FS_IO;
+  }
+  const uint64_t sz = (uint64_t)li.QuadPart;
+#else
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) return GLTF_FS_IO;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < 0) {
+    close(fd);
+    return GLTF_FS_IO;
+  }
+  const uint64_t sz = (uint64_t)st.st_size;
+#endif
+
+  gltf_fs_status status = GLTF_FS_OK;
+  if (sz > UINT32_MAX || sz > (uint64_t)SIZE_MAX) {
+    status = GLTF_FS_TOO_LARGE;
+  } else if (expected_len != 0 && sz != (uint64_t)expected_len) {
+    status = GLTF_FS_SIZE_MISMATCH;
+  }
+
+  const uint8_t* data = NULL;
+  if (status == GLTF_FS_OK && sz > 0) {
+#ifdef _WIN32
+    HANDLE mapping = CreateFileMappingA(file, NULL, writable ? PAGE_WRITECOPY : PAGE_READONLY,
+                                        0, 0, NULL);
+    if (mapping) {
+      data = (const uint8_t*)MapViewOfFile(mapping, writable ? FILE_MAP_COPY : FILE_MAP_READ,
+                                           0, 0, (SIZE_T)sz);
+      CloseHandle(mapping); // the view keeps the mapping object alive
+    }
+#else
+    void* p = mmap(NULL, (size_t)sz, writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                   MAP_PRIVATE, fd, 0);
+    data = (p == MAP_FAILED) ? NULL : (const uint8_t*)p;
+#endif
+    if (!data) status = GLTF_FS_IO;
+  }
+
+#ifdef _WIN32
+  CloseHandle(file);
+#else
+  close(fd);
+#endif
+
+  if (status != GLTF_FS_OK) return status;
+  *out_data = data;
+  *out_size = (size_t)sz;
+  return GLTF_FS_OK;
+}
+
+// Maps a whole file read-only.
+// - On success: *out_data/*out_size describe the mapping; release it with
+//   gltf_fs_unmap(). An empty file succeeds with *out_data == NULL.
+// - If expected_len is non-zero, the file size must match exactly.
+// - The file handle is closed before returning; the mapping keeps the pages.
+gltf_fs_status gltf_fs_map_file(const char* path,
+                                uint32_t expected_len,
+                                const uint8_t** out_data,
+                                size_t* out_size) {
+  return gltf_fs_map_impl(path, expected_len, 0, out_data, out_size);
+}
+
+// Maps a whole file copy-on-write: the pages may be modified in memory, the
+// file is never written. Otherwise the same as gltf_fs_map_file().
+gltf_fs_status gltf_fs_map_file_private(const char* path,
+                                        uint8_t** out_data,
+                                        size_t* out_size) {
+  if (!out_data) return GLTF_FS_INVALID;
+  const uint8_t* data = NULL;
+  gltf_fs_status st = gltf_fs_map_impl(path, 0, 1, &data, out_size);
+  *out_data = (uint8_t*)(uintptr_t)data;
+  return st;
+}
+
+// Releases a mapping returned by gltf_fs_map_file() (NULL-safe).
+void gltf_fs_unmap(const uint8_t* data, size_t size) {
+  if (!data) return;
+#ifdef _WIN32
+  (void)size;
+  UnmapViewOfFile(data);
+#else
+  munmap((void*)(uintptr_t)data, size);
+#endif
+}
+
+
+// ----------------------------------------------------------------------------
+// File replacement
+// ----------------------------------------------------------------------------
+
+// Renames from over to, replacing an existing file atomically (where the
+// platform allows it); existing mappings of the old file stay valid.
+gltf_fs_status gltf_fs_replace_file(const char* from, const char* to) {
+  if (!from || !to) return GLTF_FS_INVALID;
+#ifdef _WIN32
+  return MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING) ? GLTF_FS_OK : GLTF_FS_IO;
+#else
+  return rename(from, to) == 0 ? GLTF_FS_OK : GLTF_FS_IO;
+#endif
+}
+
+
+// ----------------------------------------------------------------------------
+// File identity
+// ----------------------------------------------------------------------------
+
+// Reads a file's size and last modification time (nanoseconds since an
+// unspecified, per-platform epoch; only meant for change detection).
+gltf_fs_status gltf_fs_stat(const char* path, uint64_t* out_size, int64_t* out_mtime_ns) {
+  if (!path || !out_size || !out_mtime_ns) return GLTF_FS_INVALID;
+
+#ifdef _WIN32
+  WIN32_FILE_ATTRIBUTE_DATA fad;
+  if (!GetFileAttributesExA(path, GetFileExInfoStandard, &fad)) return GLTF_FS_IO;
+  *out_size = ((uint64_t)fad.nFileSizeHigh << 32) | (uint64_t)fad.nFileSizeLow;
+  const uint64_t ticks = ((uint64_t)fad.ftLastWriteTime.dwHighDateTime << 32) |
+                         (uint64_t)fad.ftLastWriteTime.dwLowDateTime;
+  *out_mtime_ns = (int64_t)(ticks * 100u);
+#else
+  struct stat st;
+  if (stat(path, &st) != 0 || st.st_size < 0) return GLTF_FS_IO;
+  *out_size = (uint64_t)st.st_size;
+#if defined(__APPLE__)
+  *out_mtime_ns = (int64_t)st.st_mtimespec.tv_sec * 1000000000 + (int64_t)st.st_mtimespec.tv_nsec;
+#else
+  *out_mtime_ns = (int64_t)st.st_mtim.tv_sec * 1000000000 + (int64_t)st.st_mtim.tv_nsec;
+#endif
+#endif
+  return GLTF_FS_OK;
+}
+
+
+// ----------------------------------------------------------------------------
+// Custom I/O (gltf_io)
+// ----------------------------------------------------------------------------
+//
+// Each *_io function behaves like its plain counterpart; io == NULL calls it.
+
+// Opens path through io and queries its size. Returns NULL on failure.
+static void* gltf_fs_io_open(const gltf_io* io, const char* path, uint64_t* out_size) {
+  void* file = io->open(io->user, path);
+  if (!file) return NULL;
+  if (!io->size(io->user, file, out_size)) {
+    io->close(io->user, file);
+    return NULL;
+  }
+  return file;
+}
+
+gltf_fs_status gltf_fs_read_file_io(const gltf_io* io,
+                                    const char* path,
+                                    uint8_t** out_data,
+                                    size_t* out_size) {
+  if (!io) return gltf_fs_read_file(path, out_data, out_size);
+  if (out_data) *out_data = NULL;
+  if (out_size) *out_size = 0;
+  if (!path || !out_data || !out_size) return GLTF_FS_BAD_ARGUMENT;
+
+  uint64_t sz = 0;
+  void* file = gltf_fs_io_open(io, path, &sz);
+  if (!file) return GLTF_FS_IO;
+  if (sz > (uint64_t)GLTF_FS_MAX_FILE_SIZE) {
+    io->close(io->user, file);
+    return GLTF_FS_TOO_LARGE;
+  }
+
+  const size_t size = (size_t)sz;
+  uint8_t* buf = (uint8_t*)malloc(size + GLTF_FS_READ_PADDING);
+  if (!buf) {
+    io->close(io->user, file);
+    return GLTF_FS_OOM;
+  }
+  memset(buf + size, 0, GLTF_FS_READ_PADDING);
+
+  const int ok = size == 0 || io->read(io->user, file, 0, buf, size);
+  io->close(io->user, file);
+  if (!ok) {
+    free(buf);
+    return GLTF_FS_IO;
+  }
+
+  *out_data = buf;
+  *out_size = size;
+  return GLTF_FS_OK;
+}
+
+gltf_fs_status gltf_fs_read_file_exact_u32_io(const gltf_io* io,
+                                              const char* path,
+                                              uint32_t expected_len,
+                                              uint8_t** out_data,
+                                              uint32_t* out_len) {
+  if (!io) return gltf_fs_read_file_exact_u32(path, expected_len, out_data, out_len);
+  if (!path || !out_data) return GLTF_FS_INVALID;
+  *out_data = NULL;
+  if (out_len) *out_len = 0;
+
+  uint64_t sz = 0;
+  void* file = gltf_fs_io_open(io, path, &sz);
+  if (!file) return GLTF_FS_IO;
+
+  gltf_fs_status st = GLTF_FS_OK;
+  if (sz > UINT32_MAX) {
+    st = GLTF_FS_TOO_LARGE;
+  } else if (expected_len != 0 && sz != (uint64_t)expected_len) {
+    st = GLTF_FS_SIZE_MISMATCH;
+  }
+
+  uint8_t* data = NULL;
+  if (st == GLTF_FS_OK && sz > 0) {
+    data = (uint8_t*)malloc((size_t)sz);
+    if (!data) {
+      st = GLTF_FS_OOM;
+    } else if (!io->read(io->user, file, 0, data, (size_t)sz)) {
+      free(data);
+      data = NULL;
+      st = GLTF_FS_IO;
+    }
+  }
+  io->close(io->user, file);
+  if (st != GLTF_FS_OK) return st;
+
+  *out_data = data;
+  if (out_len) *out_len = (uint32_t)sz;
+  return GLTF_FS_OK;
+}
+
+// Fails with GLTF_FS_IO when io has no map callback (callers fall back to a
+// read, as they do when the OS cannot map a file).
+gltf_fs_status gltf_fs_map_file_io(const gltf_io* io,
+                                   const char* path,
+                                   uint32_t expected_len,
+                                   const uint8_t** out_data,
+                                   size_t* out_size) {
+  if (!io) return gltf_fs_map_file(path, expected_len, out_data, out_size);
+  if (!path || !out_data || !out_size) return GLTF_FS_INVALID;
+  *out_data = NULL;
+  *out_size = 0;
+  if (!io->map) return GLTF_FS_IO;
+
+  uint64_t sz = 0;
+  void* file = gltf_fs_io_open(io, path, &sz);
+  if (!file) return GLTF_FS_IO;
+
+  gltf_fs_status st = GLTF_FS_OK;
+  if (sz > UINT32_MAX || sz > (uint64_t)SIZE_MAX) {
+    st = GLTF_FS_TOO_LARGE;
+  } else if (expected_len != 0 && sz != (uint64_t)expected_len) {
+    st = GLTF_FS_SIZE_MISMATCH;
+  }
+
+  const uint8_t* data = NULL;
+  if (st == GLTF_FS_OK && sz > 0) {
+    data = io->map(io->user, file, (size_t)sz);
+    if (!data) st = GLTF_FS_IO;
+  }
+  io->close(io->user, file);
+  if (st != GLTF_FS_OK) return st;
+
+  *out_data = data;
+  *out_size = (size_t)sz;
+  return GLTF_FS_OK;
+}
+
+void gltf_fs_unmap_io(const gltf_io* io, const uint8_t* data, size_t size) {
+  if (!io) {
+    gltf_fs_unmap(data, size);
+  } else if (data) {
+    io->release(io->user, data, size);
+  }
+}
+
+// io has no notion of modification time: *out_mtime_ns is 0 (files served
+// through io are treated as immutable once their size is known).
+gltf_fs_status gltf_fs_stat_io(const gltf_io* io,
+                               const char* path,
+                               uint64_t* out_size,
+                               int64_t* out_mtime_ns) {
+  if (!io) return gltf_fs_stat(path, out_size, out_mtime_ns);
+  if (!path || !out_size || !out_mtime_ns) return GLTF_FS_INVALID;
+
+  void* file = gltf_fs_io_open(io, path, out_size);
+  if (!file) return GLTF_FS_IO;
+  io->close(io->user, file);
+  *out_mtime_ns = 0;
+  return GLTF_FS_OK;
+}
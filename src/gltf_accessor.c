@@ -5,7 +5,12 @@
 // Responsibilities:
 //   - validate accessor/bufferView ranges and byte layout
 //   - compute a safe span (ptr/count/stride/elem_size) over document-owned data
+//   - materialize sparse accessors once into a dense document-owned copy
+//   - split that into a residency-free layout (validated once at load for
+//     primitive attributes) and a cheap layout -> span step
 //   - decode a single accessor element into floats
+//   - decode element ranges into floats (validated once, bulk kernels)
+//   - read index ranges as u32 with min/max
 //
 // Notes:
 //   - This file does not define the public contracts; see include/gltf/gltf.h.
@@ -24,6 +29,11 @@ uint32_t gltf_doc_accessor_count(const gltf_doc* doc) {
   return doc ? doc->accessor_count : 0u;
 }
 
+uint32_t gltf_doc_accessor_sparse_count(const gltf_doc* doc, uint32_t accessor_index) {
+  if (!doc || accessor_index >= doc->accessor_count) return 0u;
+  return doc->accessors[accessor_index].sparse.count;
+}
+
 int gltf_doc_accessor_info(const gltf_doc* doc,
                            uint32_t accessor_index,
                            uint32_t* out_count,
@@ -42,20 +52,33 @@ int gltf_doc_accessor_info(const gltf_doc* doc,
   return 1;
 }
 
-gltf_result gltf_accessor_span(const gltf_doc* doc,
-                               uint32_t accessor_index,
-                               gltf_span* out_span,
-                               gltf_error* out_err) {
-  if (!doc || !out_span) {
-    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
-    return GLTF_ERR_INVALID;
+// Packed element size of an accessor (components * component size).
+static gltf_result gltf_accessor_elem_size(const gltf_accessor* a, uint32_t* out_size, gltf_error* out_err) {
+  uint32_t comp_count = 0;
+  uint32_t comp_size = 0;
+  if (!gltf_accessor_component_count(a->type, &comp_count)) {
+    gltf_set_err(out_err, "invalid accessor type", "root.accessors[].type", 1, 1);
+    return GLTF_ERR_PARSE;
   }
-  if (accessor_index >= doc->accessor_count) {
-    gltf_set_err(out_err, "accessor out of range", "root.accessors[]", 1, 1);
-    return GLTF_ERR_INVALID;
+  if (!gltf_component_size_bytes(a->component_type, &comp_size)) {
+    gltf_set_err(out_err, "invalid componentType", "root.accessors[].componentType", 1, 1);
+    return GLTF_ERR_PARSE;
   }
 
-  const gltf_accessor* a = &doc->accessors[accessor_index];
+  if (comp_count > UINT32_MAX / comp_size) {
+    gltf_set_err(out_err, "accessor element size overflow", "root.accessors[]", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+  *out_size = comp_count * comp_size;
+  return GLTF_OK;
+}
+
+// Layout of the accessor's elements in its own bufferView (for sparse
+// accessors: the base values the sparse section is applied over).
+static gltf_result gltf_accessor_view_layout(const gltf_doc* doc,
+                                             const gltf_accessor* a,
+                                             gltf_span_layout* out_layout,
+                                             gltf_error* out_err) {
   if (a->buffer_view < 0) {
     gltf_set_err(out_err, "accessor has no bufferView", "root.accessors[].bufferView", 1, 1);
     return GLTF_ERR_PARSE;
@@ -72,28 +95,9 @@ gltf_result gltf_accessor_span(const gltf_doc* doc,
     return GLTF_ERR_PARSE;
   }
 
-  const gltf_buffer* b = &doc->buffers[bv->buffer];
-  if (b->byte_length > 0 && !b->data) {
-    gltf_set_err(out_err, "buffer data not loaded", "root.buffers[]", 1, 1);
-    return GLTF_ERR_PARSE;
-  }
-
-  uint32_t comp_count = 0;
-  uint32_t comp_size = 0;
-  if (!gltf_accessor_component_count(a->type, &comp_count)) {
-    gltf_set_err(out_err, "invalid accessor type", "root.accessors[].type", 1, 1);
-    return GLTF_ERR_PARSE;
-  }
-  if (!gltf_component_size_bytes(a->component_type, &comp_size)) {
-    gltf_set_err(out_err, "invalid componentType", "root.accessors[].componentType", 1, 1);
-    return GLTF_ERR_PARSE;
-  }
-
-  if (comp_count > UINT32_MAX / comp_size) {
-    gltf_set_err(out_err, "accessor element size overflow", "root.accessors[]", 1, 1);
-    return GLTF_ERR_PARSE;
-  }
-  const uint32_t elem_size = comp_count * comp_size;
+  uint32_t elem_size = 0;
+  gltf_result r = gltf_accessor_elem_size(a, &elem_size, out_err);
+  if (r != GLTF_OK) return r;
   const uint32_t stride = (bv->byte_stride != 0) ? bv->byte_stride : elem_size;
   if (stride < elem_size) {
     gltf_set_err(out_err,
@@ -136,12 +140,254 @@ gltf_result gltf_accessor_span(const gltf_doc* doc,
     }
   }
 
+  out_layout->byte_offset = base;
+  out_layout->buffer = bv->buffer;
+  out_layout->count = a->count;
+  out_layout->stride = stride;
+  out_layout->elem_size = elem_size;
+  out_layout->dense = 0;
+  return GLTF_OK;
+}
+
+// Checks that [offset, offset + bytes) of a sparse indices/values bufferView
+// lies inside the view (tightly packed, as the spec requires).
+static gltf_result gltf_sparse_view_check(const gltf_doc* doc,
+                                          uint32_t view,
+                                          uint32_t offset,
+                                          uint64_t bytes,
+                                          const char* path,
+                                          gltf_error* out_err) {
+  if (view >= doc->buffer_view_count) {
+    gltf_set_err(out_err, "bufferView out of range", path, 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+  const gltf_buffer_view* bv = &doc->buffer_views[view];
+  if (bv->buffer >= doc->buffer_count) {
+    gltf_set_err(out_err, "buffer out of range", "root.bufferViews[].buffer", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+  if ((uint64_t)offset + bytes > (uint64_t)bv->byte_length) {
+    gltf_set_err(out_err, "sparse range out of bufferView bounds", path, 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+  return GLTF_OK;
+}
+
+// Dense layout of a sparse accessor: count tightly packed elements in
+// sparse_dense[dense - 1], built on first use by gltf_span_from_layout().
+static gltf_result gltf_accessor_sparse_layout(const gltf_doc* doc,
+                                               uint32_t accessor_index,
+                                               gltf_span_layout* out_layout,
+                                               gltf_error* out_err) {
+  const gltf_accessor* a = &doc->accessors[accessor_index];
+  const gltf_accessor_sparse* sp = &a->sparse;
+
+  // Baked documents carry these fields as file bytes.
+  if (sp->dense >= doc->sparse_dense_count || doc->sparse_dense[sp->dense].accessor != accessor_index ||
+      sp->count > a->count) {
+    gltf_set_err(out_err, "invalid sparse accessor", "root.accessors[].sparse", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+
+  uint32_t elem_size = 0;
+  gltf_result r = gltf_accessor_elem_size(a, &elem_size, out_err);
+  if (r != GLTF_OK) return r;
+  if ((uint64_t)a->count * elem_size > (uint64_t)(SIZE_MAX / 2u)) {
+    gltf_set_err(out_err, "accessor range overflow", "root.accessors[]", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+  if (a->buffer_view >= 0) {
+    gltf_span_layout base;
+    r = gltf_accessor_view_layout(doc, a, &base, out_err);
+    if (r != GLTF_OK) return r;
+  }
+
+  if (!(sp->indices_component_type == GLTF_COMP_U8 || sp->indices_component_type == GLTF_COMP_U16 ||
+        sp->indices_component_type == GLTF_COMP_U32)) {
+    gltf_set_err(out_err, "sparse indices componentType not U8/U16/U32",
+                 "root.accessors[].sparse.indices.componentType", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+  uint32_t index_size = 0;
+  (void)gltf_component_size_bytes(sp->indices_component_type, &index_size);
+  r = gltf_sparse_view_check(doc, sp->indices_view, sp->indices_offset, (uint64_t)sp->count * index_size,
+                             "root.accessors[].sparse.indices", out_err);
+  if (r != GLTF_OK) return r;
+  r = gltf_sparse_view_check(doc, sp->values_view, sp->values_offset, (uint64_t)sp->count * elem_size,
+                             "root.accessors[].sparse.values", out_err);
+  if (r != GLTF_OK) return r;
+
+  out_layout->byte_offset = 0;
+  out_layout->buffer = 0;
+  out_layout->count = a->count;
+  out_layout->stride = elem_size;
+  out_layout->elem_size = elem_size;
+  out_layout->dense = sp->dense + 1u;
+  return GLTF_OK;
+}
+
+gltf_result gltf_accessor_layout(const gltf_doc* doc,
+                                 uint32_t accessor_index,
+                                 gltf_span_layout* out_layout,
+                                 gltf_error* out_err) {
+  if (accessor_index >= doc->accessor_count) {
+    gltf_set_err(out_err, "accessor out of range", "root.accessors[]", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+
+  const gltf_accessor* a = &doc->accessors[accessor_index];
+  if (a->sparse.count > 0) return gltf_accessor_sparse_layout(doc, accessor_index, out_layout, out_err);
+  return gltf_accessor_view_layout(doc, a, out_layout, out_err);
+}
+
+// Pointer to bytes [offset, ...) of a resident bufferView's buffer.
+static const uint8_t* gltf_sparse_view_ptr(const gltf_doc* doc, uint32_t view, uint32_t offset) {
+  const gltf_buffer_view* bv = &doc->buffer_views[view];
+  const uint8_t* data = doc->buffers[bv->buffer].data;
+  return data ? data + bv->byte_offset + offset : NULL;
+}
+
+// Returns 1 unless the view lies in the BIN chunk of a gltf_glb_stream
+// document and has not fully arrived yet.
+static int gltf_sparse_view_arrived(const gltf_doc* doc, uint32_t view) {
+  if (!doc->stream_have) return 1;
+  const gltf_buffer_view* bv = &doc->buffer_views[view];
+  if (bv->buffer != 0u) return 1;
+  const uint64_t end = (uint64_t)bv->byte_offset + (uint64_t)bv->byte_length;
+  return end <= (uint64_t)gltf_atomic_load_acquire_u32(doc->stream_have);
+}
+
+// Builds sparse_dense[layout->dense - 1] once: the base elements (or zeros),
+// then every sparse value written over its index.
+static gltf_result gltf_sparse_materialize(const gltf_doc* doc,
+                                           const gltf_span_layout* layout,
+                                           gltf_error* out_err) {
+  gltf_doc* d = (gltf_doc*)(uintptr_t)doc;
+  gltf_sparse_dense* dense = &d->sparse_dense[layout->dense - 1u];
+  const gltf_accessor* a = &doc->accessors[dense->accessor];
+  const gltf_accessor_sparse* sp = &a->sparse;
+  const uint32_t elem = layout->elem_size;
+
+  // A streamed copy built from missing bytes would be cached for good.
+  if ((a->buffer_view >= 0 && !gltf_sparse_view_arrived(doc, (uint32_t)a->buffer_view)) ||
+      !gltf_sparse_view_arrived(doc, sp->indices_view) || !gltf_sparse_view_arrived(doc, sp->values_view)) {
+    gltf_set_err(out_err, "buffer view not ready", "root.accessors[].sparse", 1, 1);
+    return GLTF_ERR_IO;
+  }
+
+  // Source buffers first: lazy loads take doc->lock themselves.
+  gltf_span base = { NULL, 0, 0, 0 };
+  gltf_result r = GLTF_OK;
+  if (a->buffer_view >= 0) {
+    gltf_span_layout bl;
+    r = gltf_accessor_view_layout(doc, a, &bl, out_err);
+    if (r == GLTF_OK) r = gltf_span_from_layout(doc, &bl, &base, out_err);
+    if (r != GLTF_OK) return r;
+  }
+  r = gltf_buffer_ensure_resident(doc, doc->buffer_views[sp->indices_view].buffer, out_err);
+  if (r == GLTF_OK) r = gltf_buffer_ensure_resident(doc, doc->buffer_views[sp->values_view].buffer, out_err);
+  if (r != GLTF_OK) return r;
+  const uint8_t* indices = gltf_sparse_view_ptr(doc, sp->indices_view, sp->indices_offset);
+  const uint8_t* values = gltf_sparse_view_ptr(doc, sp->values_view, sp->values_offset);
+  if (!indices || !values || (a->buffer_view >= 0 && !base.ptr)) {
+    gltf_set_err(out_err, "buffer data not loaded", "root.buffers[]", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+
+  gltf_mutex_lock(&d->lock);
+  if (!dense->ready) {
+    const size_t bytes = (size_t)layout->count * elem;
+    uint8_t* data = (uint8_t*)malloc(bytes ? bytes : 1u);
+    if (!data) {
+      gltf_set_err(out_err, "out of memory", "root.accessors[].sparse", 1, 1);
+      r = GLTF_ERR_IO;
+    } else {
+      if (!base.ptr) {
+        memset(data, 0, bytes);
+      } else if (base.stride == elem) {
+        memcpy(data, base.ptr, bytes);
+      } else {
+        for (uint32_t i = 0; i < layout->count; i++) {
+          memcpy(data + (size_t)i * elem, base.ptr + (size_t)i * base.stride, elem);
+        }
+      }
+      for (uint32_t i = 0; i < sp->count && r == GLTF_OK; i++) {
+        uint32_t e = 0;
+        switch (sp->indices_component_type) {
+          case GLTF_COMP_U8:  e = indices[i]; break;
+          case GLTF_COMP_U16: e = rd_u16_le(indices + (size_t)i * 2u); break;
+          default:            e = rd_u32_le(indices + (size_t)i * 4u); break;
+        }
+        if (e >= layout->count) {
+          gltf_set_err(out_err, "sparse index out of range", "root.accessors[].sparse.indices", 1, 1);
+          r = GLTF_ERR_PARSE;
+          break;
+        }
+        memcpy(data + (size_t)e * elem, values + (size_t)i * elem, elem);
+      }
+      if (r == GLTF_OK) {
+        dense->data = data;
+        gltf_atomic_store_release_u32(&dense->ready, 1u);
+      } else {
+        free(data);
+      }
+    }
+  }
+  gltf_mutex_unlock(&d->lock);
+  return r;
+}
+
+gltf_result gltf_span_from_layout(const gltf_doc* doc,
+                                  const gltf_span_layout* layout,
+                                  gltf_span* out_span,
+                                  gltf_error* out_err) {
+  if (layout->dense) {
+    const gltf_sparse_dense* dense = &doc->sparse_dense[layout->dense - 1u];
+    if (!gltf_atomic_load_acquire_u32(&dense->ready)) {
+      gltf_result r = gltf_sparse_materialize(doc, layout, out_err);
+      if (r != GLTF_OK) return r;
+    }
+    out_span->ptr = layout->count > 0 ? dense->data : NULL;
+    out_span->count = layout->count;
+    out_span->stride = layout->stride;
+    out_span->elem_size = layout->elem_size;
+    return GLTF_OK;
+  }
+
+  gltf_result lr = gltf_buffer_ensure_resident(doc, layout->buffer, out_err);
+  if (lr != GLTF_OK) {
+    return lr;
+  }
+
+  const gltf_buffer* b = &doc->buffers[layout->buffer];
+  if (b->byte_length > 0 && !b->data) {
+    gltf_set_err(out_err, "buffer data not loaded", "root.buffers[]", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+
   gltf_span sp;
-  sp.ptr = (b->data && a->count > 0) ? (const uint8_t*)(b->data + base) : NULL;
-  sp.count = a->count;
-  sp.stride = stride;
-  sp.elem_size = elem_size;
+  sp.ptr = (b->data && layout->count > 0) ? (const uint8_t*)(b->data + layout->byte_offset) : NULL;
+  sp.count = layout->count;
+  sp.stride = layout->stride;
+  sp.elem_size = layout->elem_size;
   *out_span = sp;
+  return GLTF_OK;
+}
+
+gltf_result gltf_accessor_span(const gltf_doc* doc,
+                               uint32_t accessor_index,
+                               gltf_span* out_span,
+                               gltf_error* out_err) {
+  if (!doc || !out_span) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+
+  gltf_span_layout layout;
+  gltf_result r = gltf_accessor_layout(doc, accessor_index, &layout, out_err);
+  if (r != GLTF_OK) return r;
+  r = gltf_span_from_layout(doc, &layout, out_span, out_err);
+  if (r != GLTF_OK) return r;
   gltf_set_err(out_err, NULL, NULL, 0, 0);
   return GLTF_OK;
 }
@@ -208,3 +454,138 @@ gltf_result gltf_accessor_read_f32(const gltf_doc* doc,
 
   return GLTF_OK;
 }
+
+gltf_result gltf_accessor_read_f32_range(const gltf_doc* doc,
+                                         uint32_t accessor_index,
+                                         uint32_t first,
+                                         uint32_t count,
+                                         float* dst,
+                                         uint32_t dst_stride,
+                                         gltf_error* out_err) {
+  if (!doc || (!dst && count > 0)) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+  if (accessor_index >= doc->accessor_count) {
+    gltf_set_err(out_err, "accessor out of range", "root.accessors[]", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+
+  const gltf_accessor* a = &doc->accessors[accessor_index];
+  uint32_t comp_count = 0;
+  if (!gltf_accessor_component_count(a->type, &comp_count)) {
+    gltf_set_err(out_err, "invalid accessor type", "root.accessors[].type", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+  if (dst_stride == 0) {
+    dst_stride = comp_count;
+  }
+  if (dst_stride < comp_count) {
+    gltf_set_err(out_err, "dst_stride smaller than component count", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+
+  gltf_span sp;
+  gltf_result r = gltf_accessor_span(doc, accessor_index, &sp, out_err);
+  if (r != GLTF_OK) {
+    return r;
+  }
+  if (first > sp.count || count > sp.count - first) {
+    gltf_set_err(out_err, "element range out of range", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+  if (count == 0) {
+    return GLTF_OK;
+  }
+  if (!sp.ptr) {
+    gltf_set_err(out_err, "span has no data", "root", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+
+  r = gltf_decode_elements_to_f32(sp.ptr + (size_t)first * (size_t)sp.stride,
+                                  (size_t)sp.stride,
+                                  (size_t)count,
+                                  comp_count,
+                                  a->component_type,
+                                  a->normalized ? 1 : 0,
+                                  dst,
+                                  (size_t)dst_stride);
+  if (r != GLTF_OK) {
+    gltf_set_err(out_err, "failed to decode component", "root.accessors[]", 1, 1);
+    return r;
+  }
+  return GLTF_OK;
+}
+
+gltf_result gltf_accessor_read_indices_u32(const gltf_doc* doc,
+                                           uint32_t accessor_index,
+                                           uint32_t first,
+                                           uint32_t count,
+                                           uint32_t* dst,
+                                           uint32_t* out_min_index,
+                                           uint32_t* out_max_index,
+                                           gltf_error* out_err) {
+  if (!doc || (!dst && count > 0)) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+  if (accessor_index >= doc->accessor_count) {
+    gltf_set_err(out_err, "accessor out of range", "root.accessors[]", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+
+  const gltf_accessor* a = &doc->accessors[accessor_index];
+
+  // indices must be SCALAR and non-normalized
+  if (a->type != GLTF_ACCESSOR_SCALAR) {
+    gltf_set_err(out_err, "indices accessor not SCALAR", "root.accessors[].type", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+  if (a->normalized) {
+    gltf_set_err(out_err,
+                 "indices accessor must not be normalized",
+                 "root.accessors[].normalized",
+                 1,
+                 1);
+    return GLTF_ERR_PARSE;
+  }
+  if (!(a->component_type == GLTF_COMP_U8 || a->component_type == GLTF_COMP_U16 ||
+        a->component_type == GLTF_COMP_U32)) {
+    gltf_set_err(out_err,
+                 "indices componentType not U8/U16/U32",
+                 "root.accessors[].componentType",
+                 1,
+                 1);
+    return GLTF_ERR_PARSE;
+  }
+  if (first > a->count || count > a->count - first) {
+    gltf_set_err(out_err, "index out of range", "root.accessors[]", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+
+  if (count == 0) {
+    if (out_min_index) *out_min_index = UINT32_MAX;
+    if (out_max_index) *out_max_index = 0;
+    return GLTF_OK;
+  }
+
+  gltf_span sp;
+  gltf_result r = gltf_accessor_span(doc, accessor_index, &sp, out_err);
+  if (r != GLTF_OK) {
+    gltf_set_err(out_err, "failed to get indices accessor span", "root.accessors[]", 1, 1);
+    return r;
+  }
+  if (!sp.ptr) {
+    gltf_set_err(out_err, "indices span is null", "root.accessors[]", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+
+  gltf_decode_indices_u32(sp.ptr + (size_t)first * (size_t)sp.stride,
+                          (size_t)sp.stride,
+                          (size_t)count,
+                          a->component_type,
+                          dst,
+                          out_min_index,
+                          out_max_index);
+  return GLTF_OK;
+}
@@ -0,0 +1,576 @@
+// Minimal educational glTF 2.0 loader (C11).
+//
+// Baked documents: a parsed gltf_doc written out as a binary cache file.
+//
+// Responsibilities:
+//   - write a document block (+ buffer bytes) as a position-independent file
+//   - map a baked file copy-on-write and rebase its pointers into a live doc
+//   - load through a baked cache keyed by the source file's size and mtime
+//
+// File layout (host byte order; sections start 16-byte aligned):
+//   - gltf_baked_header
+//   - the document block: gltf_doc, its arrays, string arena and index pool,
+//     with every pointer stored as (offset from the file start + 1), 0 = NULL
+//   - embedded buffer bytes
+//
+// Notes:
+//   - Only pointer fields are rewritten on load (gltf_doc, buffers, images,
+//     materials); the pages holding everything else are never touched, so they
+//     stay shared with the page cache.
+//   - Loading checks every rebased pointer against the file bounds. Index
+//     values inside the arrays are trusted as written by gltf_doc_save_baked().
+//
+// Public API contracts are documented in include/gltf/gltf.h.
+
+
+#include "gltf_internal.h"
+
+
+// ----------------------------------------------------------------------------
+// Internal helpers (fs)
+// ----------------------------------------------------------------------------
+
+// File system helpers implemented in src/fs.c.
+typedef enum gltf_fs_status {
+  GLTF_FS_OK = 0,
+  GLTF_FS_INVALID,
+  GLTF_FS_IO,
+  GLTF_FS_OOM,
+  GLTF_FS_SIZE_MISMATCH,
+  GLTF_FS_TOO_LARGE,
+  GLTF_FS_BAD_ARGUMENT
+} gltf_fs_status;
+
+char* gltf_fs_join_dir_leaf(const char* dir_prefix, size_t dir_len, const char* leaf);
+
+gltf_fs_status gltf_fs_map_file_private(const char* path, uint8_t** out_data, size_t* out_size);
+
+void gltf_fs_unmap(const uint8_t* data, size_t size);
+
+gltf_fs_status gltf_fs_replace_file(const char* from, const char* to);
+
+gltf_fs_status gltf_fs_stat_io(const gltf_io* io,
+                               const char* path,
+                               uint64_t* out_size,
+                               int64_t* out_mtime_ns);
+
+
+// ----------------------------------------------------------------------------
+// Format
+// ----------------------------------------------------------------------------
+
+#define GLTF_BAKED_MAGIC 0x42544C47u // 'GLTB'
+
+// Bump whenever the document block layout or its pointer set changes.
+#define GLTF_BAKED_VERSION 6u
+
+typedef struct gltf_baked_header {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t abi;             // gltf_baked_abi() of the writer
+  uint32_t buffer_count;    // copy of doc->buffer_count (consistency check)
+  uint64_t block_offset;    // file offset of the document block
+  uint64_t block_size;
+  uint64_t file_size;
+  uint64_t source_size;     // gltf_load_file_cached(): source file identity,
+  int64_t source_mtime_ns;  // zero for gltf_doc_save_baked()
+  uint32_t sections;        // copy of doc->sections
+  uint32_t reserved;
+} gltf_baked_header;
+
+static uint64_t gltf_baked_align(uint64_t v) {
+  return (v + (GLTF_DOC_BLOCK_ALIGN - 1u)) & ~(uint64_t)(GLTF_DOC_BLOCK_ALIGN - 1u);
+}
+
+// Fingerprint of everything the raw block layout depends on.
+static uint32_t gltf_baked_abi(void) {
+  const uint32_t probe = 1u;
+  const uint64_t v[] = {
+    sizeof(void*), sizeof(size_t), *(const uint8_t*)&probe,
+    sizeof(gltf_doc), sizeof(gltf_scene), sizeof(gltf_node), sizeof(gltf_mesh),
+    sizeof(gltf_primitive), sizeof(gltf_prim_attr), sizeof(gltf_accessor),
+    sizeof(gltf_buffer_view), sizeof(gltf_buffer), sizeof(gltf_image_bytes), sizeof(gltf_sparse_dense),
+    sizeof(gltf_material), sizeof(gltf_texture), sizeof(gltf_image), sizeof(gltf_sampler),
+  };
+  const uint8_t* p = (const uint8_t*)v;
+  uint32_t h = 2166136261u; // FNV-1a 32
+  for (size_t i = 0; i < sizeof v; i++) {
+    h = (h ^ p[i]) * 16777619u;
+  }
+  return h;
+}
+
+
+// ----------------------------------------------------------------------------
+// Writing
+// ----------------------------------------------------------------------------
+
+// Stored form of a pointer into the source block. Returns 0 if p is neither
+// NULL nor inside [block, block + block_size].
+static int gltf_bake_ptr(const void* p,
+                         const uint8_t* block,
+                         size_t block_size,
+                         uint64_t block_offset,
+                         uintptr_t* out) {
+  const uint8_t* q = (const uint8_t*)p;
+  if (!q) {
+    *out = 0;
+    return 1;
+  }
+  if (q < block || (size_t)(q - block) > block_size) return 0;
+  *out = (uintptr_t)(block_offset + (uint64_t)(q - block) + 1u);
+  return 1;
+}
+
+static int gltf_bake_write_all(FILE* f, const void* data, size_t size, uint64_t* io_pos) {
+  static const uint8_t k_zeros[GLTF_DOC_BLOCK_ALIGN] = {0};
+  if (size > 0 && fwrite(data, 1, size, f) != size) return 0;
+  *io_pos += size;
+
+  const uint64_t pad = gltf_baked_align(*io_pos) - *io_pos;
+  if (pad > 0 && fwrite(k_zeros, 1, (size_t)pad, f) != (size_t)pad) return 0;
+  *io_pos += pad;
+  return 1;
+}
+
+static gltf_result gltf_bake_write(const gltf_doc* doc,
+                                   const char* path,
+                                   uint32_t flags,
+                                   uint64_t source_size,
+                                   int64_t source_mtime_ns,
+                                   gltf_error* out_err) {
+#define GLTF_BAKE_PTR(dst, src_ptr)                                                   \
+  do {                                                                                \
+    uintptr_t v_ = 0;                                                                 \
+    if (!gltf_bake_ptr((src_ptr), block, block_size, block_offset, &v_)) goto bad_ptr; \
+    memcpy(&(dst), &v_, sizeof v_);                                                   \
+  } while (0)
+
+  const uint8_t* block = (const uint8_t*)doc;
+  const size_t block_size = (size_t)(doc->block_end - block);
+  const uint64_t block_offset = gltf_baked_align(sizeof(gltf_baked_header));
+
+  // Embedded buffers must be resident before their bytes are copied.
+  int* embed = NULL;
+  if (doc->buffer_count > 0) {
+    embed = (int*)calloc(doc->buffer_count, sizeof(int));
+    if (!embed) {
+      gltf_set_err(out_err, "out of memory", path, 1, 1);
+      return GLTF_ERR_IO;
+    }
+  }
+  for (uint32_t i = 0; i < doc->buffer_count; i++) {
+    const char* uri = arena_get_str(&doc->arena, doc->buffers[i].uri);
+    const int external = uri && strncmp(uri, "data:", 5) != 0;
+    embed[i] = !external || (flags & GLTF_BAKE_BUFFERS);
+    if (embed[i]) {
+      gltf_result r = gltf_buffer_ensure_resident(doc, i, out_err);
+      if (r != GLTF_OK) {
+        free(embed);
+        return r;
+      }
+    }
+  }
+
+  uint8_t* img = (uint8_t*)malloc(block_size);
+  if (!img) {
+    free(embed);
+    gltf_set_err(out_err, "out of memory", path, 1, 1);
+    return GLTF_ERR_IO;
+  }
+  memcpy(img, block, block_size);
+
+  gltf_doc* d = (gltf_doc*)(void*)img;
+  gltf_buffer* buffers = (gltf_buffer*)(void*)(img + ((const uint8_t*)doc->buffers - block));
+  gltf_image* images = (gltf_image*)(void*)(img + ((const uint8_t*)doc->images - block));
+  gltf_material* materials = (gltf_material*)(void*)(img + ((const uint8_t*)doc->materials - block));
+  gltf_image_bytes* image_bytes = (gltf_image_bytes*)(void*)(img + ((const uint8_t*)doc->image_bytes - block));
+  gltf_sparse_dense* sparse_dense = (gltf_sparse_dense*)(void*)(img + ((const uint8_t*)doc->sparse_dense - block));
+  uint8_t* arena = img + (doc->arena.data - block);
+
+  // Buffers: embedded bytes follow the block; external files are referenced
+  // by their resolved path (appended to the arena, which is presized for it).
+  uint64_t data_offset = block_offset + gltf_baked_align(block_size);
+  for (uint32_t i = 0; i < doc->buffer_count; i++) {
+    const gltf_buffer* src = &doc->buffers[i];
+    gltf_buffer* b = &buffers[i];
+
+    if (!embed[i] && !gltf_str_is_valid(src->path)) {
+      const char* doc_dir = arena_get_str(&doc->arena, doc->doc_dir);
+      char* full = gltf_fs_join_dir_leaf(doc_dir, doc_dir ? strlen(doc_dir) : 0u,
+                                         arena_get_str(&doc->arena, src->uri));
+      const size_t len = full ? strlen(full) : 0u;
+      if (full && d->arena.size + len + 1u <= d->arena.cap && d->arena.size + len < UINT32_MAX) {
+        memcpy(arena + d->arena.size, full, len + 1u);
+        b->path.off = (uint32_t)d->arena.size;
+        b->path.len = (uint32_t)len;
+        d->arena.size += len + 1u;
+      } else {
+        // No room for the path: embed the bytes instead.
+        gltf_result r = gltf_buffer_ensure_resident(doc, i, out_err);
+        if (r != GLTF_OK) {
+          free(full);
+          free(img);
+          free(embed);
+          return r;
+        }
+        embed[i] = 1;
+      }
+      free(full);
+    }
+
+    if (embed[i]) {
+      const uintptr_t v = src->byte_length ? (uintptr_t)(data_offset + 1u) : 0u;
+      memcpy(&b->data, &v, sizeof v);
+      b->storage = GLTF_BUFFER_BORROWED;
+      b->pending = 0u;
+      data_offset += gltf_baked_align(src->byte_length);
+    } else {
+      b->data = NULL;
+      b->storage = GLTF_BUFFER_OWNED;
+      b->pending = 1u;
+    }
+  }
+
+  // Pointers into the block.
+  GLTF_BAKE_PTR(d->scenes, doc->scenes);
+  GLTF_BAKE_PTR(d->nodes, doc->nodes);
+  GLTF_BAKE_PTR(d->meshes, doc->meshes);
+  GLTF_BAKE_PTR(d->primitives, doc->primitives);
+  GLTF_BAKE_PTR(d->prim_attrs, doc->prim_attrs);
+  GLTF_BAKE_PTR(d->buffers, doc->buffers);
+  GLTF_BAKE_PTR(d->buffer_views, doc->buffer_views);
+  GLTF_BAKE_PTR(d->accessors, doc->accessors);
+  GLTF_BAKE_PTR(d->materials, doc->materials);
+  GLTF_BAKE_PTR(d->textures, doc->textures);
+  GLTF_BAKE_PTR(d->images, doc->images);
+  GLTF_BAKE_PTR(d->samplers, doc->samplers);
+  GLTF_BAKE_PTR(d->image_bytes, doc->image_bytes);
+  GLTF_BAKE_PTR(d->sparse_dense, doc->sparse_dense);
+  GLTF_BAKE_PTR(d->indices_u32, doc->indices_u32);
+  GLTF_BAKE_PTR(d->arena.data, doc->arena.data);
+  for (uint32_t k = 0; k < GLTF_NAME_KIND_COUNT; k++) {
+    GLTF_BAKE_PTR(d->name_index[k].slots, doc->name_index[k].slots);
+    GLTF_BAKE_PTR(d->name_index[k].sorted, doc->name_index[k].sorted);
+  }
+
+  for (uint32_t i = 0; i < doc->image_count; i++) {
+    const gltf_image* src = &doc->images[i];
+    GLTF_BAKE_PTR(images[i].name, src->name);
+    GLTF_BAKE_PTR(images[i].uri, src->uri);
+    GLTF_BAKE_PTR(images[i].resolved, src->resolved);
+    GLTF_BAKE_PTR(images[i].mime_type, src->mime_type);
+    memset(&image_bytes[i], 0, sizeof(gltf_image_bytes));
+  }
+  for (uint32_t i = 0; i < doc->material_count; i++) {
+    GLTF_BAKE_PTR(materials[i].name, doc->materials[i].name);
+  }
+  for (uint32_t i = 0; i < doc->sparse_dense_count; i++) {
+    sparse_dense[i].data = NULL;
+    sparse_dense[i].ready = 0u;
+  }
+
+  // Process-local state is rebuilt by the loader.
+  memset(&d->alc, 0, sizeof d->alc);
+  d->block_next = NULL;
+  d->block_end = NULL;
+  d->block_mapped = 0;
+  d->load_flags = 0;
+  memset(&d->io, 0, sizeof d->io);
+  memset(&d->lock, 0, sizeof d->lock);
+  d->file_bytes = NULL;
+  d->file_bytes_alc = 0;
+  d->file_map = NULL;
+  d->file_map_size = 0;
+  d->stream_have = NULL;
+
+  gltf_baked_header h;
+  memset(&h, 0, sizeof h);
+  h.magic = GLTF_BAKED_MAGIC;
+  h.version = GLTF_BAKED_VERSION;
+  h.abi = gltf_baked_abi();
+  h.buffer_count = doc->buffer_count;
+  h.block_offset = block_offset;
+  h.block_size = block_size;
+  h.file_size = data_offset;
+  h.source_size = source_size;
+  h.source_mtime_ns = source_mtime_ns;
+  h.sections = doc->sections;
+
+  // Written next to the target and renamed over it, so readers that still
+  // map the old file keep seeing consistent bytes.
+  const size_t path_len = strlen(path);
+  char* tmp = (char*)malloc(path_len + 5u);
+  if (!tmp) {
+    free(img);
+    free(embed);
+    gltf_set_err(out_err, "out of memory", path, 1, 1);
+    return GLTF_ERR_IO;
+  }
+  memcpy(tmp, path, path_len);
+  memcpy(tmp + path_len, ".tmp", 5u);
+
+  FILE* f = fopen(tmp, "wb");
+  int ok = f != NULL;
+  uint64_t pos = 0;
+  ok = ok && gltf_bake_write_all(f, &h, sizeof h, &pos);
+  ok = ok && gltf_bake_write_all(f, img, block_size, &pos);
+  for (uint32_t i = 0; ok && i < doc->buffer_count; i++) {
+    if (embed[i]) ok = gltf_bake_write_all(f, doc->buffers[i].data, doc->buffers[i].byte_length, &pos);
+  }
+  if (f && fclose(f) != 0) ok = 0;
+  ok = ok && pos == data_offset && gltf_fs_replace_file(tmp, path) == GLTF_FS_OK;
+  if (!ok && f) (void)remove(tmp);
+
+  free(tmp);
+  free(img);
+  free(embed);
+  if (!ok) {
+    gltf_set_err(out_err, "failed to write baked file", path, 1, 1);
+    return GLTF_ERR_IO;
+  }
+  gltf_set_err(out_err, NULL, NULL, 0, 0);
+  return GLTF_OK;
+
+bad_ptr:
+  free(img);
+  free(embed);
+  gltf_set_err(out_err, "document pointer outside its block", path, 1, 1);
+  return GLTF_ERR_INVALID;
+
+#undef GLTF_BAKE_PTR
+}
+
+gltf_result gltf_doc_save_baked(const gltf_doc* doc,
+                                const char* path,
+                                uint32_t flags,
+                                gltf_error* out_err) {
+  if (!doc || !path) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+  return gltf_bake_write(doc, path, flags, 0u, 0, out_err);
+}
+
+
+// ----------------------------------------------------------------------------
+// Loading
+// ----------------------------------------------------------------------------
+
+// Bounds of the region a stored pointer may refer to (file offsets).
+typedef struct gltf_baked_range {
+  uint8_t* base;
+  uint64_t lo;
+  uint64_t hi;
+} gltf_baked_range;
+
+// Rebases a stored pointer that must cover count x size bytes inside r.
+// NULL is accepted only for empty ranges.
+static int gltf_baked_rebase(void* field, const gltf_baked_range* r, size_t count, size_t size) {
+  uintptr_t v;
+  memcpy(&v, field, sizeof v);
+
+  void* p = NULL;
+  if (v != 0) {
+    const uint64_t off = (uint64_t)v - 1u;
+    const size_t bytes = gltf_block_bytes(count, size);
+    if (bytes == SIZE_MAX || off < r->lo || off > r->hi || r->hi - off < (uint64_t)(count * size)) return 0;
+    p = r->base + off;
+  } else if (count > 0) {
+    return 0;
+  }
+  memcpy(field, &p, sizeof p);
+  return 1;
+}
+
+// Rebases a stored string pointer; it must start inside the arena and be
+// NUL-terminated before the arena's used end.
+static int gltf_baked_rebase_str(const char** field, const gltf_arena* arena, uint8_t* base) {
+  uintptr_t v;
+  memcpy(&v, (const void*)field, sizeof v);
+  if (v == 0) return 1;
+
+  const uint8_t* p = base + ((uint64_t)v - 1u);
+  if (p < arena->data || p >= arena->data + arena->size) return 0;
+  if (!memchr(p, '\0', (size_t)(arena->data + arena->size - p))) return 0;
+  *field = (const char*)p;
+  return 1;
+}
+
+static gltf_result gltf_load_baked_impl(const char* path,
+                                        const gltf_load_options* opts,
+                                        int check_source,
+                                        uint64_t source_size,
+                                        int64_t source_mtime_ns,
+                                        uint32_t sections,
+                                        gltf_doc** out_doc,
+                                        gltf_error* out_err) {
+  *out_doc = NULL;
+
+  uint8_t* map = NULL;
+  size_t map_size = 0;
+  if (gltf_fs_map_file_private(path, &map, &map_size) != GLTF_FS_OK) {
+    gltf_set_err(out_err, "failed to map baked file", path, 1, 1);
+    return GLTF_ERR_IO;
+  }
+
+  gltf_result rc = GLTF_ERR_PARSE;
+  const char* msg = "truncated or inconsistent baked file";
+  gltf_baked_header h;
+
+  if (map_size < sizeof h) goto fail;
+  memcpy(&h, map, sizeof h);
+  if (h.magic != GLTF_BAKED_MAGIC) {
+    msg = "not a baked file";
+    goto fail;
+  }
+  if (h.version != GLTF_BAKED_VERSION || h.abi != gltf_baked_abi()) {
+    rc = GLTF_ERR_UNSUPPORTED;
+    msg = "baked file from another version or platform";
+    goto fail;
+  }
+  if (check_source && (h.source_size != source_size || h.source_mtime_ns != source_mtime_ns ||
+                       (h.sections & sections) != sections)) {
+    rc = GLTF_ERR_UNSUPPORTED;
+    msg = "baked file is stale";
+    goto fail;
+  }
+  if (h.file_size != (uint64_t)map_size || h.block_offset < sizeof h ||
+      (h.block_offset % GLTF_DOC_BLOCK_ALIGN) != 0 || h.block_size < sizeof(gltf_doc) ||
+      h.block_offset > h.file_size || h.file_size - h.block_offset < h.block_size) {
+    goto fail;
+  }
+
+  gltf_doc* doc = (gltf_doc*)(void*)(map + h.block_offset);
+  if (doc->buffer_count != h.buffer_count || doc->sections != h.sections ||
+      doc->arena.size > doc->arena.cap ||
+      doc->indices_count > doc->indices_cap) {
+    goto fail;
+  }
+
+  const gltf_baked_range block = { map, h.block_offset, h.block_offset + h.block_size };
+  const gltf_baked_range data = { map, block.hi, h.file_size };
+
+  int ok = 1;
+  ok = ok && gltf_baked_rebase(&doc->scenes, &block, doc->scene_count, sizeof(gltf_scene));
+  ok = ok && gltf_baked_rebase(&doc->nodes, &block, doc->node_count, sizeof(gltf_node));
+  ok = ok && gltf_baked_rebase(&doc->meshes, &block, doc->mesh_count, sizeof(gltf_mesh));
+  ok = ok && gltf_baked_rebase(&doc->primitives, &block, doc->primitive_count, sizeof(gltf_primitive));
+  ok = ok && gltf_baked_rebase(&doc->prim_attrs, &block, doc->prim_attr_count, sizeof(gltf_prim_attr));
+  ok = ok && gltf_baked_rebase(&doc->buffers, &block, doc->buffer_count, sizeof(gltf_buffer));
+  ok = ok && gltf_baked_rebase(&doc->buffer_views, &block, doc->buffer_view_count, sizeof(gltf_buffer_view));
+  ok = ok && gltf_baked_rebase(&doc->accessors, &block, doc->accessor_count, sizeof(gltf_accessor));
+  ok = ok && gltf_baked_rebase(&doc->materials, &block, doc->material_count, sizeof(gltf_material));
+  ok = ok && gltf_baked_rebase(&doc->textures, &block, doc->texture_count, sizeof(gltf_texture));
+  ok = ok && gltf_baked_rebase(&doc->images, &block, doc->image_count, sizeof(gltf_image));
+  ok = ok && gltf_baked_rebase(&doc->samplers, &block, doc->sampler_count, sizeof(gltf_sampler));
+  ok = ok && gltf_baked_rebase(&doc->image_bytes, &block, doc->image_count, sizeof(gltf_image_bytes));
+  ok = ok && gltf_baked_rebase(&doc->sparse_dense, &block, doc->sparse_dense_count, sizeof(gltf_sparse_dense));
+  ok = ok && gltf_baked_rebase(&doc->indices_u32, &block, doc->indices_cap, sizeof(uint32_t));
+  ok = ok && gltf_baked_rebase(&doc->arena.data, &block, doc->arena.cap, 1u);
+  for (uint32_t k = 0; ok && k < GLTF_NAME_KIND_COUNT; k++) {
+    gltf_name_index* ni = &doc->name_index[k];
+    ok = gltf_baked_rebase(&ni->slots, &block, ni->slot_cap, sizeof(uint32_t)) &&
+         gltf_baked_rebase(&ni->sorted, &block, ni->sorted_count, sizeof(uint32_t));
+  }
+  if (!ok) goto fail;
+
+  for (uint32_t i = 0; ok && i < doc->image_count; i++) {
+    gltf_image* img = &doc->images[i];
+    ok = gltf_baked_rebase_str(&img->name, &doc->arena, map) &&
+         gltf_baked_rebase_str(&img->uri, &doc->arena, map) &&
+         gltf_baked_rebase_str(&img->resolved, &doc->arena, map) &&
+         gltf_baked_rebase_str(&img->mime_type, &doc->arena, map);
+    memset(&doc->image_bytes[i], 0, sizeof(gltf_image_bytes));
+  }
+  for (uint32_t i = 0; ok && i < doc->material_count; i++) {
+    ok = gltf_baked_rebase_str(&doc->materials[i].name, &doc->arena, map);
+  }
+  for (uint32_t i = 0; ok && i < doc->sparse_dense_count; i++) {
+    doc->sparse_dense[i].data = NULL;
+    doc->sparse_dense[i].ready = 0u;
+  }
+  if (!ok) goto fail;
+
+  for (uint32_t i = 0; i < doc->buffer_count; i++) {
+    gltf_buffer* b = &doc->buffers[i];
+    if (b->pending) {
+      // External file, loaded on first use.
+      if (b->data || !arena_get_str(&doc->arena, b->path)) goto fail;
+      b->storage = GLTF_BUFFER_OWNED;
+    } else {
+      if (!gltf_baked_rebase(&b->data, &data, b->byte_length, 1u)) goto fail;
+      b->storage = GLTF_BUFFER_BORROWED;
+    }
+  }
+
+  // Process-local state.
+  const uint32_t flags = opts ? opts->flags : GLTF_LOAD_DEFAULT;
+  doc->alc = (opts && opts->allocator) ? *opts->allocator : *gltf_allocator_default();
+  doc->block_next = map + block.hi;
+  doc->block_end = map + block.hi;
+  doc->block_mapped = 1u;
+  doc->load_flags = GLTF_LOAD_CTX_LAZY_BUFFERS | ((flags & GLTF_LOAD_MMAP) ? GLTF_LOAD_CTX_MMAP : 0u);
+  if (opts && opts->io) doc->io = *opts->io; // lazy buffers and URI images
+  doc->file_bytes = NULL;
+  doc->file_bytes_alc = 0;
+  doc->file_map = map;
+  doc->file_map_size = map_size;
+  gltf_mutex_init(&doc->lock);
+
+  *out_doc = doc;
+  gltf_set_err(out_err, NULL, NULL, 0, 0);
+  return GLTF_OK;
+
+fail:
+  gltf_fs_unmap(map, map_size);
+  gltf_set_err(out_err, msg, path, 1, 1);
+  return rc;
+}
+
+gltf_result gltf_load_baked(const char* path,
+                            const gltf_load_options* opts,
+                            gltf_doc** out_doc,
+                            gltf_error* out_err) {
+  if (out_doc) *out_doc = NULL;
+  if (!path || !out_doc) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+  return gltf_load_baked_impl(path, opts, 0, 0u, 0, 0u, out_doc, out_err);
+}
+
+gltf_result gltf_load_file_cached(const char* path,
+                                  const char* cache_path,
+                                  const gltf_load_options* opts,
+                                  gltf_doc** out_doc,
+                                  gltf_error* out_err) {
+  if (out_doc) *out_doc = NULL;
+  if (!path || !cache_path || !out_doc || !out_err) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+
+  // The identity is taken before parsing, so a file modified mid-load leaves
+  // a cache that is already stale.
+  uint64_t size = 0;
+  int64_t mtime_ns = 0;
+  const int have_identity = gltf_fs_stat_io(opts ? opts->io : NULL, path, &size, &mtime_ns) == GLTF_FS_OK;
+  // The cache may hold more sections than asked for, never fewer.
+  const uint32_t requested = (opts && opts->sections) ? (opts->sections & GLTF_LOAD_SECTION_ALL)
+                                                      : GLTF_LOAD_SECTION_ALL;
+  if (have_identity &&
+      gltf_load_baked_impl(cache_path, opts, 1, size, mtime_ns, requested, out_doc, out_err) == GLTF_OK) {
+    return GLTF_OK;
+  }
+
+  gltf_result rc = gltf_load_file_ex(path, opts, out_doc, out_err);
+  if (rc != GLTF_OK) return rc;
+
+  if (have_identity) {
+    gltf_error ignored = {0};
+    (void)gltf_bake_write(*out_doc, cache_path, GLTF_BAKE_DEFAULT, size, mtime_ns, &ignored);
+  }
+  gltf_set_err(out_err, NULL, NULL, 0, 0);
+  return GLTF_OK;
+}
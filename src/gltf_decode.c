@@ -7,12 +7,19 @@
 //   - read little-endian scalars from unaligned byte streams
 //   - map accessor type/componentType to sizes and component counts
 //   - decode a single component to float (optionally normalized)
+//   - decode runs of elements to float with SIMD kernels for common encodings
+//   - widen u8/u16/u32 index runs to u32 while tracking min/max
+//   - reduce VEC3 runs to per-component min/max (float and quantized encodings)
 //
 // Notes:
 //   - This file does not define the public contracts; see include/gltf/gltf.h.
+//   - Bulk kernels match gltf_decode_component_to_f32() bit for bit.
 
 
 #include "gltf_internal.h"
+#include "gltf_simd.h"
+
+#include <math.h>
 
 
 // ----------------------------------------------------------------------------
@@ -132,3 +139,822 @@ gltf_result gltf_decode_component_to_f32(const uint8_t* p,
     return GLTF_ERR_PARSE;
   }
 }
+
+// ----------------------------------------------------------------------------
+// Bulk decode
+// ----------------------------------------------------------------------------
+
+// Scalar loops, one per component encoding. Normalization follows
+// gltf_decode_component_to_f32(): signed MIN maps to -1.0f, which is the same
+// as clamping v / MAX to -1.0f.
+
+static void decode_run_scalar(const uint8_t* p,
+                              size_t n,
+                              uint32_t component_type,
+                              int normalized,
+                              float* dst) {
+  switch (component_type) {
+  case GLTF_COMP_F32:
+    for (size_t i = 0; i < n; i++) {
+      uint32_t u = rd_u32_le(p + i * 4u);
+      memcpy(&dst[i], &u, sizeof u);
+    }
+    break;
+  case GLTF_COMP_U8:
+    for (size_t i = 0; i < n; i++) {
+      dst[i] = normalized ? (float)p[i] / 255.0f : (float)p[i];
+    }
+    break;
+  case GLTF_COMP_I8:
+    for (size_t i = 0; i < n; i++) {
+      const float v = (float)(int8_t)p[i];
+      dst[i] = normalized ? ((v == -128.0f) ? -1.0f : v / 127.0f) : v;
+    }
+    break;
+  case GLTF_COMP_U16:
+    for (size_t i = 0; i < n; i++) {
+      const float v = (float)rd_u16_le(p + i * 2u);
+      dst[i] = normalized ? v / 65535.0f : v;
+    }
+    break;
+  case GLTF_COMP_I16:
+    for (size_t i = 0; i < n; i++) {
+      const float v = (float)(int16_t)rd_u16_le(p + i * 2u);
+      dst[i] = normalized ? ((v == -32768.0f) ? -1.0f : v / 32767.0f) : v;
+    }
+    break;
+  case GLTF_COMP_U32:
+    for (size_t i = 0; i < n; i++) {
+      const uint32_t v = rd_u32_le(p + i * 4u);
+      dst[i] = normalized ? (float)((double)v / 4294967295.0) : (float)v;
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+// Vectorized prefix of a run; returns the number of components written.
+// The remaining tail is left to decode_run_scalar().
+
+#if GLTF_SIMD_SSE2
+
+static size_t decode_run_simd(const uint8_t* p,
+                              size_t n,
+                              uint32_t component_type,
+                              int normalized,
+                              float* dst) {
+  size_t i = 0;
+  const __m128i zero = _mm_setzero_si128();
+
+  switch (component_type) {
+  case GLTF_COMP_U8: {
+#if GLTF_SIMD_AVX2
+    const __m256 k8 = _mm256_set1_ps(normalized ? 255.0f : 1.0f);
+    for (; i + 8u <= n; i += 8u) {
+      __m128i b = _mm_loadl_epi64((const __m128i*)(const void*)(p + i));
+      __m256 f = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(b));
+      _mm256_storeu_ps(dst + i, _mm256_div_ps(f, k8));
+    }
+#endif
+    const __m128 k = _mm_set1_ps(normalized ? 255.0f : 1.0f);
+    for (; i + 16u <= n; i += 16u) {
+      __m128i b = _mm_loadu_si128((const __m128i*)(const void*)(p + i));
+      __m128i lo = _mm_unpacklo_epi8(b, zero);
+      __m128i hi = _mm_unpackhi_epi8(b, zero);
+      _mm_storeu_ps(dst + i + 0u, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), k));
+      _mm_storeu_ps(dst + i + 4u, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), k));
+      _mm_storeu_ps(dst + i + 8u, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), k));
+      _mm_storeu_ps(dst + i + 12u, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), k));
+    }
+    break;
+  }
+
+  case GLTF_COMP_I8: {
+    const __m128 k = _mm_set1_ps(normalized ? 127.0f : 1.0f);
+    const __m128 lo_clamp = _mm_set1_ps(normalized ? -1.0f : -128.0f);
+    for (; i + 16u <= n; i += 16u) {
+      __m128i b = _mm_loadu_si128((const __m128i*)(const void*)(p + i));
+      // Sign-extend 8 -> 16 -> 32 by duplicating into the high half and shifting.
+      __m128i lo = _mm_srai_epi16(_mm_unpacklo_epi8(b, b), 8);
+      __m128i hi = _mm_srai_epi16(_mm_unpackhi_epi8(b, b), 8);
+      __m128i w[4] = {
+        _mm_srai_epi32(_mm_unpacklo_epi16(lo, lo), 16),
+        _mm_srai_epi32(_mm_unpackhi_epi16(lo, lo), 16),
+        _mm_srai_epi32(_mm_unpacklo_epi16(hi, hi), 16),
+        _mm_srai_epi32(_mm_unpackhi_epi16(hi, hi), 16),
+      };
+      for (int q = 0; q < 4; q++) {
+        __m128 f = _mm_div_ps(_mm_cvtepi32_ps(w[q]), k);
+        _mm_storeu_ps(dst + i + (size_t)q * 4u, _mm_max_ps(f, lo_clamp));
+      }
+    }
+    break;
+  }
+
+  case GLTF_COMP_U16: {
+#if GLTF_SIMD_AVX2
+    const __m256 k8 = _mm256_set1_ps(normalized ? 65535.0f : 1.0f);
+    for (; i + 8u <= n; i += 8u) {
+      __m128i h = _mm_loadu_si128((const __m128i*)(const void*)(p + i * 2u));
+      __m256 f = _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(h));
+      _mm256_storeu_ps(dst + i, _mm256_div_ps(f, k8));
+    }
+#endif
+    const __m128 k = _mm_set1_ps(normalized ? 65535.0f : 1.0f);
+    for (; i + 8u <= n; i += 8u) {
+      __m128i h = _mm_loadu_si128((const __m128i*)(const void*)(p + i * 2u));
+      _mm_storeu_ps(dst + i + 0u, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(h, zero)), k));
+      _mm_storeu_ps(dst + i + 4u, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(h, zero)), k));
+    }
+    break;
+  }
+
+  case GLTF_COMP_I16: {
+    const __m128 k = _mm_set1_ps(normalized ? 32767.0f : 1.0f);
+    const __m128 lo_clamp = _mm_set1_ps(normalized ? -1.0f : -32768.0f);
+    for (; i + 8u <= n; i += 8u) {
+      __m128i h = _mm_loadu_si128((const __m128i*)(const void*)(p + i * 2u));
+      __m128i w0 = _mm_srai_epi32(_mm_unpacklo_epi16(h, h), 16);
+      __m128i w1 = _mm_srai_epi32(_mm_unpackhi_epi16(h, h), 16);
+      _mm_storeu_ps(dst + i + 0u, _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(w0), k), lo_clamp));
+      _mm_storeu_ps(dst + i + 4u, _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(w1), k), lo_clamp));
+    }
+    break;
+  }
+
+  default:
+    break;
+  }
+  return i;
+}
+
+#elif GLTF_SIMD_NEON
+
+static size_t decode_run_simd(const uint8_t* p,
+                              size_t n,
+                              uint32_t component_type,
+                              int normalized,
+                              float* dst) {
+  size_t i = 0;
+
+  switch (component_type) {
+  case GLTF_COMP_U8: {
+    const float32x4_t k = vdupq_n_f32(normalized ? 255.0f : 1.0f);
+    for (; i + 16u <= n; i += 16u) {
+      uint8x16_t b = vld1q_u8(p + i);
+      uint16x8_t lo = vmovl_u8(vget_low_u8(b));
+      uint16x8_t hi = vmovl_u8(vget_high_u8(b));
+      vst1q_f32(dst + i + 0u, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo))), k));
+      vst1q_f32(dst + i + 4u, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo))), k));
+      vst1q_f32(dst + i + 8u, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi))), k));
+      vst1q_f32(dst + i + 12u, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi))), k));
+    }
+    break;
+  }
+
+  case GLTF_COMP_I8: {
+    const float32x4_t k = vdupq_n_f32(normalized ? 127.0f : 1.0f);
+    const float32x4_t lo_clamp = vdupq_n_f32(normalized ? -1.0f : -128.0f);
+    for (; i + 16u <= n; i += 16u) {
+      int8x16_t b = vld1q_s8((const int8_t*)(p + i));
+      int16x8_t lo = vmovl_s8(vget_low_s8(b));
+      int16x8_t hi = vmovl_s8(vget_high_s8(b));
+      int32x4_t w[4] = {
+        vmovl_s16(vget_low_s16(lo)),
+        vmovl_s16(vget_high_s16(lo)),
+        vmovl_s16(vget_low_s16(hi)),
+        vmovl_s16(vget_high_s16(hi)),
+      };
+      for (int q = 0; q < 4; q++) {
+        float32x4_t f = vdivq_f32(vcvtq_f32_s32(w[q]), k);
+        vst1q_f32(dst + i + (size_t)q * 4u, vmaxq_f32(f, lo_clamp));
+      }
+    }
+    break;
+  }
+
+  case GLTF_COMP_U16: {
+    const float32x4_t k = vdupq_n_f32(normalized ? 65535.0f : 1.0f);
+    for (; i + 8u <= n; i += 8u) {
+      uint16x8_t h = vreinterpretq_u16_u8(vld1q_u8(p + i * 2u));
+      vst1q_f32(dst + i + 0u, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(h))), k));
+      vst1q_f32(dst + i + 4u, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(h))), k));
+    }
+    break;
+  }
+
+  case GLTF_COMP_I16: {
+    const float32x4_t k = vdupq_n_f32(normalized ? 32767.0f : 1.0f);
+    const float32x4_t lo_clamp = vdupq_n_f32(normalized ? -1.0f : -32768.0f);
+    for (; i + 8u <= n; i += 8u) {
+      int16x8_t h = vreinterpretq_s16_u8(vld1q_u8(p + i * 2u));
+      float32x4_t f0 = vdivq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(h))), k);
+      float32x4_t f1 = vdivq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(h))), k);
+      vst1q_f32(dst + i + 0u, vmaxq_f32(f0, lo_clamp));
+      vst1q_f32(dst + i + 4u, vmaxq_f32(f1, lo_clamp));
+    }
+    break;
+  }
+
+  default:
+    break;
+  }
+  return i;
+}
+
+#else
+
+static size_t decode_run_simd(const uint8_t* p,
+                              size_t n,
+                              uint32_t component_type,
+                              int normalized,
+                              float* dst) {
+  (void)p;
+  (void)n;
+  (void)component_type;
+  (void)normalized;
+  (void)dst;
+  return 0;
+}
+
+#endif
+
+// Decodes n tightly packed components.
+static void decode_run(const uint8_t* p,
+                       size_t n,
+                       uint32_t component_type,
+                       int normalized,
+                       float* dst) {
+#if GLTF_HOST_LITTLE_ENDIAN
+  if (component_type == GLTF_COMP_F32) {
+    memcpy(dst, p, n * sizeof(float));
+    return;
+  }
+#endif
+  size_t done = decode_run_simd(p, n, component_type, normalized, dst);
+  if (done < n) {
+    uint32_t comp_size = 0;
+    (void)gltf_component_size_bytes(component_type, &comp_size);
+    decode_run_scalar(p + done * comp_size, n - done, component_type, normalized, dst + done);
+  }
+}
+
+gltf_result gltf_decode_elements_to_f32(const uint8_t* src,
+                                        size_t src_stride,
+                                        size_t count,
+                                        uint32_t comp_count,
+                                        uint32_t component_type,
+                                        int normalized,
+                                        float* dst,
+                                        size_t dst_stride) {
+  uint32_t comp_size = 0;
+  if (!gltf_component_size_bytes(component_type, &comp_size)) return GLTF_ERR_PARSE;
+  if (count == 0) return GLTF_OK;
+  if (!src || !dst || comp_count == 0) return GLTF_ERR_INVALID;
+
+  const size_t elem_size = (size_t)comp_count * comp_size;
+  if (src_stride == elem_size && dst_stride == comp_count) {
+    // Both sides tightly packed: one contiguous run.
+    decode_run(src, count * comp_count, component_type, normalized, dst);
+    return GLTF_OK;
+  }
+
+  // Interleaved source and/or strided destination: decode element by element.
+  // Elements are small, so this stays on the scalar loops except for f32 copies.
+  for (size_t i = 0; i < count; i++) {
+    decode_run(src + i * src_stride, comp_count, component_type, normalized, dst + i * dst_stride);
+  }
+  return GLTF_OK;
+}
+
+// ----------------------------------------------------------------------------
+// Index decode (u8/u16/u32 -> u32)
+// ----------------------------------------------------------------------------
+
+// decode_indices_simd widens tightly packed indices; it returns how many it
+// wrote and folds them into *lo / *hi. The tail is left to the scalar loop.
+
+#if GLTF_SIMD_SSE2
+
+// SSE2 has no unsigned 32-bit min/max: compare with the sign bit flipped.
+static inline __m128i idx_min_u32_sse2(__m128i a, __m128i b) {
+  const __m128i bias = _mm_set1_epi32((int)0x80000000u);
+  __m128i gt = _mm_cmpgt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+  return _mm_or_si128(_mm_and_si128(gt, b), _mm_andnot_si128(gt, a));
+}
+
+static inline __m128i idx_max_u32_sse2(__m128i a, __m128i b) {
+  const __m128i bias = _mm_set1_epi32((int)0x80000000u);
+  __m128i gt = _mm_cmpgt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+  return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
+}
+
+static void idx_reduce_u32x4(__m128i vlo, __m128i vhi, uint32_t* lo, uint32_t* hi) {
+  uint32_t a[4], b[4];
+  _mm_storeu_si128((__m128i*)(void*)a, vlo);
+  _mm_storeu_si128((__m128i*)(void*)b, vhi);
+  for (int k = 0; k < 4; k++) {
+    if (a[k] < *lo) *lo = a[k];
+    if (b[k] > *hi) *hi = b[k];
+  }
+}
+
+static size_t decode_indices_simd(const uint8_t* p,
+                                  size_t n,
+                                  uint32_t component_type,
+                                  uint32_t* dst,
+                                  uint32_t* lo,
+                                  uint32_t* hi) {
+  size_t i = 0;
+  const __m128i zero = _mm_setzero_si128();
+
+  switch (component_type) {
+  case GLTF_COMP_U8: {
+    if (n < 16u) break;
+    __m128i vlo = _mm_set1_epi8((char)0xFF);
+    __m128i vhi = zero;
+    for (; i + 16u <= n; i += 16u) {
+      __m128i b = _mm_loadu_si128((const __m128i*)(const void*)(p + i));
+      vlo = _mm_min_epu8(vlo, b);
+      vhi = _mm_max_epu8(vhi, b);
+      __m128i w0 = _mm_unpacklo_epi8(b, zero);
+      __m128i w1 = _mm_unpackhi_epi8(b, zero);
+      _mm_storeu_si128((__m128i*)(void*)(dst + i + 0u), _mm_unpacklo_epi16(w0, zero));
+      _mm_storeu_si128((__m128i*)(void*)(dst + i + 4u), _mm_unpackhi_epi16(w0, zero));
+      _mm_storeu_si128((__m128i*)(void*)(dst + i + 8u), _mm_unpacklo_epi16(w1, zero));
+      _mm_storeu_si128((__m128i*)(void*)(dst + i + 12u), _mm_unpackhi_epi16(w1, zero));
+    }
+    uint8_t a[16], b[16];
+    _mm_storeu_si128((__m128i*)(void*)a, vlo);
+    _mm_storeu_si128((__m128i*)(void*)b, vhi);
+    for (int k = 0; k < 16; k++) {
+      if (a[k] < *lo) *lo = a[k];
+      if (b[k] > *hi) *hi = b[k];
+    }
+    break;
+  }
+
+  case GLTF_COMP_U16: {
+    if (n < 8u) break;
+    // Signed 16-bit min/max on values biased by 0x8000.
+    const __m128i bias = _mm_set1_epi16((short)0x8000);
+    __m128i vlo = _mm_set1_epi16(0x7FFF);
+    __m128i vhi = _mm_set1_epi16((short)0x8000);
+    for (; i + 8u <= n; i += 8u) {
+      __m128i h = _mm_loadu_si128((const __m128i*)(const void*)(p + i * 2u));
+      __m128i hb = _mm_xor_si128(h, bias);
+      vlo = _mm_min_epi16(vlo, hb);
+      vhi = _mm_max_epi16(vhi, hb);
+      _mm_storeu_si128((__m128i*)(void*)(dst + i + 0u), _mm_unpacklo_epi16(h, zero));
+      _mm_storeu_si128((__m128i*)(void*)(dst + i + 4u), _mm_unpackhi_epi16(h, zero));
+    }
+    uint16_t a[8], b[8];
+    _mm_storeu_si128((__m128i*)(void*)a, _mm_xor_si128(vlo, bias));
+    _mm_storeu_si128((__m128i*)(void*)b, _mm_xor_si128(vhi, bias));
+    for (int k = 0; k < 8; k++) {
+      if (a[k] < *lo) *lo = a[k];
+      if (b[k] > *hi) *hi = b[k];
+    }
+    break;
+  }
+
+  case GLTF_COMP_U32: {
+    if (n < 4u) break;
+    __m128i vlo = _mm_set1_epi32(-1);
+    __m128i vhi = zero;
+    for (; i + 4u <= n; i += 4u) {
+      __m128i v = _mm_loadu_si128((const __m128i*)(const void*)(p + i * 4u));
+      vlo = idx_min_u32_sse2(vlo, v);
+      vhi = idx_max_u32_sse2(vhi, v);
+      _mm_storeu_si128((__m128i*)(void*)(dst + i), v);
+    }
+    idx_reduce_u32x4(vlo, vhi, lo, hi);
+    break;
+  }
+
+  default:
+    break;
+  }
+  return i;
+}
+
+#elif GLTF_SIMD_NEON
+
+static size_t decode_indices_simd(const uint8_t* p,
+                                  size_t n,
+                                  uint32_t component_type,
+                                  uint32_t* dst,
+                                  uint32_t* lo,
+                                  uint32_t* hi) {
+  size_t i = 0;
+
+  switch (component_type) {
+  case GLTF_COMP_U8: {
+    if (n < 16u) break;
+    uint8x16_t vlo = vdupq_n_u8(0xFF);
+    uint8x16_t vhi = vdupq_n_u8(0);
+    for (; i + 16u <= n; i += 16u) {
+      uint8x16_t b = vld1q_u8(p + i);
+      vlo = vminq_u8(vlo, b);
+      vhi = vmaxq_u8(vhi, b);
+      uint16x8_t w0 = vmovl_u8(vget_low_u8(b));
+      uint16x8_t w1 = vmovl_u8(vget_high_u8(b));
+      vst1q_u32(dst + i + 0u, vmovl_u16(vget_low_u16(w0)));
+      vst1q_u32(dst + i + 4u, vmovl_u16(vget_high_u16(w0)));
+      vst1q_u32(dst + i + 8u, vmovl_u16(vget_low_u16(w1)));
+      vst1q_u32(dst + i + 12u, vmovl_u16(vget_high_u16(w1)));
+    }
+    if (vminvq_u8(vlo) < *lo) *lo = vminvq_u8(vlo);
+    if (vmaxvq_u8(vhi) > *hi) *hi = vmaxvq_u8(vhi);
+    break;
+  }
+
+  case GLTF_COMP_U16: {
+    if (n < 8u) break;
+    uint16x8_t vlo = vdupq_n_u16(0xFFFF);
+    uint16x8_t vhi = vdupq_n_u16(0);
+    for (; i + 8u <= n; i += 8u) {
+      uint16x8_t h = vreinterpretq_u16_u8(vld1q_u8(p + i * 2u));
+      vlo = vminq_u16(vlo, h);
+      vhi = vmaxq_u16(vhi, h);
+      vst1q_u32(dst + i + 0u, vmovl_u16(vget_low_u16(h)));
+      vst1q_u32(dst + i + 4u, vmovl_u16(vget_high_u16(h)));
+    }
+    if (vminvq_u16(vlo) < *lo) *lo = vminvq_u16(vlo);
+    if (vmaxvq_u16(vhi) > *hi) *hi = vmaxvq_u16(vhi);
+    break;
+  }
+
+  case GLTF_COMP_U32: {
+    if (n < 4u) break;
+    uint32x4_t vlo = vdupq_n_u32(0xFFFFFFFFu);
+    uint32x4_t vhi = vdupq_n_u32(0);
+    for (; i + 4u <= n; i += 4u) {
+      uint32x4_t v = vreinterpretq_u32_u8(vld1q_u8(p + i * 4u));
+      vlo = vminq_u32(vlo, v);
+      vhi = vmaxq_u32(vhi, v);
+      vst1q_u32(dst + i, v);
+    }
+    if (vminvq_u32(vlo) < *lo) *lo = vminvq_u32(vlo);
+    if (vmaxvq_u32(vhi) > *hi) *hi = vmaxvq_u32(vhi);
+    break;
+  }
+
+  default:
+    break;
+  }
+  return i;
+}
+
+#else
+
+static size_t decode_indices_simd(const uint8_t* p,
+                                  size_t n,
+                                  uint32_t component_type,
+                                  uint32_t* dst,
+                                  uint32_t* lo,
+                                  uint32_t* hi) {
+  (void)p;
+  (void)n;
+  (void)component_type;
+  (void)dst;
+  (void)lo;
+  (void)hi;
+  return 0;
+}
+
+#endif
+
+void gltf_decode_indices_u32(const uint8_t* src,
+                             size_t src_stride,
+                             size_t count,
+                             uint32_t component_type,
+                             uint32_t* dst,
+                             uint32_t* out_min,
+                             uint32_t* out_max) {
+  uint32_t comp_size = 0;
+  (void)gltf_component_size_bytes(component_type, &comp_size);
+
+  uint32_t lo = UINT32_MAX;
+  uint32_t hi = 0;
+  size_t i = 0;
+
+  // The vector loads reinterpret raw little-endian bytes.
+  if (GLTF_HOST_LITTLE_ENDIAN && src_stride == comp_size) {
+    i = decode_indices_simd(src, count, component_type, dst, &lo, &hi);
+  }
+
+  // Tail (or strided source): one switch, then a tight per-type loop.
+  const uint8_t* p = src + i * src_stride;
+  switch (component_type) {
+  case GLTF_COMP_U8:
+    for (; i < count; i++, p += src_stride) {
+      const uint32_t v = p[0];
+      dst[i] = v;
+      if (v < lo) lo = v;
+      if (v > hi) hi = v;
+    }
+    break;
+  case GLTF_COMP_U16:
+    for (; i < count; i++, p += src_stride) {
+      const uint32_t v = rd_u16_le(p);
+      dst[i] = v;
+      if (v < lo) lo = v;
+      if (v > hi) hi = v;
+    }
+    break;
+  default:
+    for (; i < count; i++, p += src_stride) {
+      const uint32_t v = rd_u32_le(p);
+      dst[i] = v;
+      if (v < lo) lo = v;
+      if (v > hi) hi = v;
+    }
+    break;
+  }
+
+  if (out_min) *out_min = lo;
+  if (out_max) *out_max = hi;
+}
+
+// ----------------------------------------------------------------------------
+// Bounds (first three components)
+// ----------------------------------------------------------------------------
+
+// Integer encodings are reduced in their raw domain and converted once at the
+// end: normalization is monotonic, so min/max commute with it. NaN floats are
+// skipped (v < lo and v > hi are both false), matching the scalar comparisons.
+//
+// The vector paths load a full 16/8/4-byte lane group per element. That reads
+// past the third component, so they stop before the last element, whose bytes
+// may end the buffer; it is folded in by the scalar loop.
+
+typedef struct minmax3_acc {
+  float flo[3], fhi[3];
+  int32_t ilo[3], ihi[3];
+} minmax3_acc;
+
+static void minmax3_scalar(const uint8_t* p,
+                           size_t stride,
+                           size_t i,
+                           size_t count,
+                           uint32_t component_type,
+                           minmax3_acc* acc) {
+  for (p += i * stride; i < count; i++, p += stride) {
+    for (uint32_t c = 0; c < 3u; c++) {
+      int32_t v = 0;
+      switch (component_type) {
+      case GLTF_COMP_F32: {
+        const uint32_t u = rd_u32_le(p + c * 4u);
+        float f;
+        memcpy(&f, &u, sizeof f);
+        if (f < acc->flo[c]) acc->flo[c] = f;
+        if (f > acc->fhi[c]) acc->fhi[c] = f;
+        continue;
+      }
+      case GLTF_COMP_U8: v = p[c]; break;
+      case GLTF_COMP_I8: v = (int8_t)p[c]; break;
+      case GLTF_COMP_U16: v = rd_u16_le(p + c * 2u); break;
+      default: v = (int16_t)rd_u16_le(p + c * 2u); break;
+      }
+      if (v < acc->ilo[c]) acc->ilo[c] = v;
+      if (v > acc->ihi[c]) acc->ihi[c] = v;
+    }
+  }
+}
+
+#if GLTF_SIMD_SSE2
+
+static size_t minmax3_simd(const uint8_t* p,
+                           size_t stride,
+                           size_t count,
+                           uint32_t component_type,
+                           minmax3_acc* acc) {
+  if (count < 2u) return 0;
+  const size_t n = count - 1u;
+
+  if (component_type == GLTF_COMP_F32) {
+    __m128 lo = _mm_set1_ps(acc->flo[0]);
+    __m128 hi = _mm_set1_ps(acc->fhi[0]);
+    for (size_t i = 0; i < n; i++, p += stride) {
+      const __m128 v = _mm_loadu_ps((const float*)(const void*)p);
+      lo = _mm_min_ps(v, lo); // (v < lo) ? v : lo
+      hi = _mm_max_ps(v, hi); // (v > hi) ? v : hi
+    }
+    float a[4], b[4];
+    _mm_storeu_ps(a, lo);
+    _mm_storeu_ps(b, hi);
+    for (uint32_t c = 0; c < 3u; c++) {
+      if (a[c] < acc->flo[c]) acc->flo[c] = a[c];
+      if (b[c] > acc->fhi[c]) acc->fhi[c] = b[c];
+    }
+    return n;
+  }
+
+  if (component_type == GLTF_COMP_U16 || component_type == GLTF_COMP_I16) {
+    // Signed 16-bit min/max; u16 is biased by 0x8000 into the signed range.
+    const __m128i bias = _mm_set1_epi16(component_type == GLTF_COMP_U16 ? (short)0x8000 : 0);
+    __m128i lo = _mm_set1_epi16(0x7FFF);
+    __m128i hi = _mm_set1_epi16((short)0x8000);
+    for (size_t i = 0; i < n; i++, p += stride) {
+      const __m128i v = _mm_xor_si128(_mm_loadl_epi64((const __m128i*)(const void*)p), bias);
+      lo = _mm_min_epi16(v, lo);
+      hi = _mm_max_epi16(v, hi);
+    }
+    int16_t a[8], b[8];
+    _mm_storeu_si128((__m128i*)(void*)a, _mm_xor_si128(lo, bias));
+    _mm_storeu_si128((__m128i*)(void*)b, _mm_xor_si128(hi, bias));
+    for (uint32_t c = 0; c < 3u; c++) {
+      const int32_t l = (component_type == GLTF_COMP_U16) ? (int32_t)(uint16_t)a[c] : a[c];
+      const int32_t h = (component_type == GLTF_COMP_U16) ? (int32_t)(uint16_t)b[c] : b[c];
+      if (l < acc->ilo[c]) acc->ilo[c] = l;
+      if (h > acc->ihi[c]) acc->ihi[c] = h;
+    }
+    return n;
+  }
+
+  if (component_type == GLTF_COMP_U8 || component_type == GLTF_COMP_I8) {
+    // Unsigned 8-bit min/max; i8 is biased by 0x80 into the unsigned range.
+    const __m128i bias = _mm_set1_epi8(component_type == GLTF_COMP_I8 ? (char)0x80 : 0);
+    __m128i lo = _mm_set1_epi8((char)0xFF);
+    __m128i hi = _mm_setzero_si128();
+    for (size_t i = 0; i < n; i++, p += stride) {
+      int32_t w;
+      memcpy(&w, p, sizeof w);
+      const __m128i v = _mm_xor_si128(_mm_cvtsi32_si128(w), bias);
+      lo = _mm_min_epu8(v, lo);
+      hi = _mm_max_epu8(v, hi);
+    }
+    uint8_t a[16], b[16];
+    _mm_storeu_si128((__m128i*)(void*)a, _mm_xor_si128(lo, bias));
+    _mm_storeu_si128((__m128i*)(void*)b, _mm_xor_si128(hi, bias));
+    for (uint32_t c = 0; c < 3u; c++) {
+      const int32_t l = (component_type == GLTF_COMP_I8) ? (int32_t)(int8_t)a[c] : (int32_t)a[c];
+      const int32_t h = (component_type == GLTF_COMP_I8) ? (int32_t)(int8_t)b[c] : (int32_t)b[c];
+      if (l < acc->ilo[c]) acc->ilo[c] = l;
+      if (h > acc->ihi[c]) acc->ihi[c] = h;
+    }
+    return n;
+  }
+
+  return 0;
+}
+
+#elif GLTF_SIMD_NEON
+
+static size_t minmax3_simd(const uint8_t* p,
+                           size_t stride,
+                           size_t count,
+                           uint32_t component_type,
+                           minmax3_acc* acc) {
+  if (count < 2u) return 0;
+  const size_t n = count - 1u;
+
+  if (component_type == GLTF_COMP_F32) {
+    // vminq_f32 propagates NaN; compare + select keeps the scalar semantics.
+    float32x4_t lo = vdupq_n_f32(acc->flo[0]);
+    float32x4_t hi = vdupq_n_f32(acc->fhi[0]);
+    for (size_t i = 0; i < n; i++, p += stride) {
+      const float32x4_t v = vld1q_f32((const float*)(const void*)p);
+      lo = vbslq_f32(vcltq_f32(v, lo), v, lo);
+      hi = vbslq_f32(vcgtq_f32(v, hi), v, hi);
+    }
+    float a[4], b[4];
+    vst1q_f32(a, lo);
+    vst1q_f32(b, hi);
+    for (uint32_t c = 0; c < 3u; c++) {
+      if (a[c] < acc->flo[c]) acc->flo[c] = a[c];
+      if (b[c] > acc->fhi[c]) acc->fhi[c] = b[c];
+    }
+    return n;
+  }
+
+  if (component_type == GLTF_COMP_I16) {
+    int16x4_t lo = vdup_n_s16(INT16_MAX);
+    int16x4_t hi = vdup_n_s16(INT16_MIN);
+    for (size_t i = 0; i < n; i++, p += stride) {
+      const int16x4_t v = vreinterpret_s16_u8(vld1_u8(p));
+      lo = vmin_s16(v, lo);
+      hi = vmax_s16(v, hi);
+    }
+    int16_t a[4], b[4];
+    vst1_s16(a, lo);
+    vst1_s16(b, hi);
+    for (uint32_t c = 0; c < 3u; c++) {
+      if (a[c] < acc->ilo[c]) acc->ilo[c] = a[c];
+      if (b[c] > acc->ihi[c]) acc->ihi[c] = b[c];
+    }
+    return n;
+  }
+
+  if (component_type == GLTF_COMP_U16) {
+    uint16x4_t lo = vdup_n_u16(UINT16_MAX);
+    uint16x4_t hi = vdup_n_u16(0);
+    for (size_t i = 0; i < n; i++, p += stride) {
+      const uint16x4_t v = vreinterpret_u16_u8(vld1_u8(p));
+      lo = vmin_u16(v, lo);
+      hi = vmax_u16(v, hi);
+    }
+    uint16_t a[4], b[4];
+    vst1_u16(a, lo);
+    vst1_u16(b, hi);
+    for (uint32_t c = 0; c < 3u; c++) {
+      if (a[c] < acc->ilo[c]) acc->ilo[c] = a[c];
+      if (b[c] > acc->ihi[c]) acc->ihi[c] = b[c];
+    }
+    return n;
+  }
+
+  if (component_type == GLTF_COMP_U8 || component_type == GLTF_COMP_I8) {
+    // Unsigned 8-bit min/max; i8 is biased by 0x80 into the unsigned range.
+    const uint8x8_t bias = vdup_n_u8(component_type == GLTF_COMP_I8 ? 0x80u : 0u);
+    uint8x8_t lo = vdup_n_u8(0xFFu);
+    uint8x8_t hi = vdup_n_u8(0u);
+    for (size_t i = 0; i < n; i++, p += stride) {
+      uint32_t w;
+      memcpy(&w, p, sizeof w);
+      const uint8x8_t v = veor_u8(vcreate_u8((uint64_t)w), bias);
+      lo = vmin_u8(v, lo);
+      hi = vmax_u8(v, hi);
+    }
+    uint8_t a[8], b[8];
+    vst1_u8(a, veor_u8(lo, bias));
+    vst1_u8(b, veor_u8(hi, bias));
+    for (uint32_t c = 0; c < 3u; c++) {
+      const int32_t l = (component_type == GLTF_COMP_I8) ? (int32_t)(int8_t)a[c] : (int32_t)a[c];
+      const int32_t h = (component_type == GLTF_COMP_I8) ? (int32_t)(int8_t)b[c] : (int32_t)b[c];
+      if (l < acc->ilo[c]) acc->ilo[c] = l;
+      if (h > acc->ihi[c]) acc->ihi[c] = h;
+    }
+    return n;
+  }
+
+  return 0;
+}
+
+#else
+
+static size_t minmax3_simd(const uint8_t* p,
+                           size_t stride,
+                           size_t count,
+                           uint32_t component_type,
+                           minmax3_acc* acc) {
+  (void)p;
+  (void)stride;
+  (void)count;
+  (void)component_type;
+  (void)acc;
+  return 0;
+}
+
+#endif
+
+// Converts a raw integer component to float exactly like the element decoder.
+static float minmax3_raw_to_f32(int32_t raw, uint32_t component_type, int normalized) {
+  uint8_t b[2];
+  b[0] = (uint8_t)((uint32_t)raw & 0xFFu);
+  b[1] = (uint8_t)(((uint32_t)raw >> 8u) & 0xFFu);
+  float f = 0.0f;
+  decode_run_scalar(b, 1u, component_type, normalized, &f);
+  return f;
+}
+
+gltf_result gltf_decode_minmax3_f32(const uint8_t* src,
+                                    size_t src_stride,
+                                    size_t count,
+                                    uint32_t component_type,
+                                    int normalized,
+                                    float out_min3[3],
+                                    float out_max3[3]) {
+  if (!(component_type == GLTF_COMP_F32 || component_type == GLTF_COMP_U8 ||
+        component_type == GLTF_COMP_I8 || component_type == GLTF_COMP_U16 ||
+        component_type == GLTF_COMP_I16)) {
+    return GLTF_ERR_PARSE;
+  }
+
+  minmax3_acc acc;
+  for (uint32_t c = 0; c < 3u; c++) {
+    acc.flo[c] = INFINITY;
+    acc.fhi[c] = -INFINITY;
+    acc.ilo[c] = INT32_MAX;
+    acc.ihi[c] = INT32_MIN;
+  }
+
+  size_t i = 0;
+  if (GLTF_HOST_LITTLE_ENDIAN) {
+    i = minmax3_simd(src, src_stride, count, component_type, &acc);
+  }
+  minmax3_scalar(src, src_stride, i, count, component_type, &acc);
+
+  for (uint32_t c = 0; c < 3u; c++) {
+    if (component_type == GLTF_COMP_F32) {
+      out_min3[c] = acc.flo[c];
+      out_max3[c] = acc.fhi[c];
+    } else {
+      out_min3[c] = minmax3_raw_to_f32(acc.ilo[c], component_type, normalized);
+      out_max3[c] = minmax3_raw_to_f32(acc.ihi[c], component_type, normalized);
+    }
+  }
+  return GLTF_OK;
+}
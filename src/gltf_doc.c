@@ -6,6 +6,7 @@
 //   - load and validate a .gltf JSON document
 //   - populate document-owned arrays (scenes/nodes/meshes/primitives/...)
 //   - load buffers from external files and data: URIs
+//   - load several files as parallel tasks (gltf_load_files)
 //   - free all document-owned memory
 //
 // Notes:
@@ -31,9 +32,25 @@ typedef enum gltf_fs_status {
   GLTF_FS_BAD_ARGUMENT
 } gltf_fs_status;
 
+// Zero bytes gltf_fs_read_file() appends after the file contents (see src/fs.c).
+#define GLTF_FS_READ_PADDING 4u
+
 size_t gltf_fs_dir_len(const char* path);
 
-gltf_fs_status gltf_fs_read_file(const char* path, uint8_t** out_data, size_t* out_size);
+gltf_fs_status gltf_fs_read_file_io(const gltf_io* io,
+                                    const char* path,
+                                    uint8_t** out_data,
+                                    size_t* out_size);
+
+gltf_fs_status gltf_fs_map_file_io(const gltf_io* io,
+                                   const char* path,
+                                   uint32_t expected_len,
+                                   const uint8_t** out_data,
+                                   size_t* out_size);
+
+void gltf_fs_unmap(const uint8_t* data, size_t size);
+
+void gltf_fs_unmap_io(const gltf_io* io, const uint8_t* data, size_t size);
 
 
 // ----------------------------------------------------------------------------
@@ -112,6 +129,15 @@ static gltf_result gltf_load_json_string_ex(uint8_t* json_text,
     }                                    \
   } while (0)
 
+// GLTF_TRY, timed as one load stage (the stage also ends when expr fails).
+#define GLTF_STAGE(_stage, expr)                          \
+  do {                                                    \
+    const double _t0 = gltf_stats_begin(stats, (_stage)); \
+    gltf_result _sr = (expr);                             \
+    gltf_stats_end(stats, (_stage), _t0);                 \
+    GLTF_TRY(_sr);                                        \
+  } while (0)
+
   gltf_doc* doc = NULL;
   yyjson_doc* json_doc = NULL;
   yyjson_read_err err;
@@ -126,32 +152,65 @@ static gltf_result gltf_load_json_string_ex(uint8_t* json_text,
     return GLTF_ERR_INVALID;
   }
 
-  json_doc = yyjson_read_opts((char*)json_text, json_len, flg, NULL, &err);
+  if (ctx->flags & GLTF_LOAD_CTX_JSON_INSITU) {
+    // Caller guarantees YYJSON_PADDING_SIZE zero bytes after json_len.
+    flg |= YYJSON_READ_INSITU;
+  }
+
+  // gltf_allocator has the same layout as yyjson_alc.
+  const gltf_allocator* alc = ctx->allocator ? ctx->allocator : gltf_allocator_default();
+  const yyjson_alc doc_alc = { alc->malloc, alc->realloc, alc->free, alc->user };
+  gltf_load_stats* stats = ctx->stats;
+  gltf_stats_alc counting;
+  const yyjson_alc json_alc = gltf_stats_json_alc(stats, &doc_alc, &counting);
+
+  double t0 = gltf_stats_begin(stats, GLTF_LOAD_STAGE_JSON);
+  json_doc = yyjson_read_opts((char*)json_text, json_len, flg, &json_alc, &err);
+  gltf_stats_end(stats, GLTF_LOAD_STAGE_JSON, t0);
   if (!json_doc) {
     GLTF_FAIL(GLTF_ERR_PARSE, err.msg, "root", 1, 1);
   }
 
-  doc = (gltf_doc*)calloc(1, sizeof(gltf_doc));
+  // Root
+  yyjson_val* root = yyjson_doc_get_root(json_doc);
+  if (!root || !yyjson_is_obj(root)) {
+    GLTF_FAIL(GLTF_ERR_PARSE, "must be object", "root", 1, 1);
+  }
+
+  // One block for the document, its arrays, strings and index lists.
+  t0 = gltf_stats_begin(stats, GLTF_LOAD_STAGE_PRESIZE);
+  const int has_dir = !(ctx->flags & GLTF_LOAD_CTX_GLB) && ctx->doc_dir;
+  const uint32_t sections = gltf_load_sections_resolve(root, ctx->sections);
+  gltf_doc_sizes sizes;
+  gltf_doc_presize(root, has_dir ? strlen(ctx->doc_dir) : 0u, sections, ctx->flags, &sizes);
+  if (ctx->flags & GLTF_LOAD_CTX_NAME_INDEX) {
+    sizes.block_bytes = gltf_size_add(sizes.block_bytes, gltf_name_index_presize(root, sections));
+  }
+
+  doc = gltf_doc_block_create(alc, sizes.block_bytes);
+  gltf_stats_end(stats, GLTF_LOAD_STAGE_PRESIZE, t0);
   if (!doc) {
     GLTF_FAIL(GLTF_ERR_IO, "out of memory", "root", 1, 1);
   }
-
-  arena_init(&doc->arena, GLTF_ARENA_INITIAL_CAPACITY);
-  if (!doc->arena.data) {
+  gltf_stats_block(stats, sizes.block_bytes);
+  gltf_mutex_init(&doc->lock);
+  doc->load_flags = ctx->flags;
+  doc->sections = sections;
+
+  arena_init(&doc->arena, (uint8_t*)gltf_doc_carve(doc, sizes.string_bytes, 1u), sizes.string_bytes);
+  doc->indices_cap = sizes.index_count;
+  if (sizes.index_count > 0) {
+    doc->indices_u32 = (uint32_t*)gltf_doc_carve(doc, sizes.index_count, sizeof(uint32_t));
+  }
+  if (!doc->arena.data || (sizes.index_count > 0 && !doc->indices_u32)) {
     GLTF_FAIL(GLTF_ERR_IO, "out of memory", "root", 1, 1);
   }
 
-  if (!(ctx->flags & GLTF_LOAD_CTX_GLB) && ctx->doc_dir) {
+  if (has_dir) {
     // init doc_dir (directory of the .gltf file)
     GLTF_TRY(gltf_init_doc_dir(doc, ctx->doc_dir, out_err));
   }
 
-  // Root
-  yyjson_val* root = yyjson_doc_get_root(json_doc);
-  if (!root || !yyjson_is_obj(root)) {
-    GLTF_FAIL(GLTF_ERR_PARSE, "must be object", "root", 1, 1);
-  }
-
   // Default scene
   GLTF_TRY(
     gltf_json_get_i32(
@@ -162,36 +221,50 @@ static gltf_result gltf_load_json_string_ex(uint8_t* json_text,
       "root.scene",
       out_err)
   );
+  if (!(sections & GLTF_LOAD_SECTION_SCENES)) {
+    doc->default_scene = GLTF_DOC_DEFAULT_SCENE_INVALID;
+  }
 
-  // Scenes
-  GLTF_TRY(gltf_parse_scenes(doc, root, out_err));
-
-  // Nodes
-  GLTF_TRY(gltf_parse_nodes(doc, root, out_err));
-
-  // Meshes
-  GLTF_TRY(gltf_parse_meshes(doc, root, out_err));
+  // Sections the caller did not ask for stay empty (count 0, NULL arrays).
+  if (sections & GLTF_LOAD_SECTION_SCENES) {
+    GLTF_STAGE(GLTF_LOAD_STAGE_SCENES, gltf_parse_scenes(doc, root, out_err));
+    GLTF_STAGE(GLTF_LOAD_STAGE_NODES, gltf_parse_nodes(doc, root, out_err));
+  }
 
-  // Accessors
-  GLTF_TRY(gltf_parse_accessors(doc, root, out_err));
+  if (sections & GLTF_LOAD_SECTION_MESHES) {
+    GLTF_STAGE(GLTF_LOAD_STAGE_MESHES, gltf_parse_meshes(doc, root, out_err));
+  }
 
-  // BufferViews
-  GLTF_TRY(gltf_parse_buffer_views(doc, root, out_err));
+  if (sections & GLTF_LOAD_SECTION_ACCESSORS) {
+    GLTF_STAGE(GLTF_LOAD_STAGE_ACCESSORS, gltf_parse_accessors(doc, root, out_err));
+    GLTF_STAGE(GLTF_LOAD_STAGE_BUFFER_VIEWS, gltf_parse_buffer_views(doc, root, out_err));
+  }
 
-  // Buffers
-  GLTF_TRY(gltf_parse_buffers(doc, root, ctx, out_err));
+  // Buffers (the only stage that does I/O)
+  if (sections & GLTF_LOAD_SECTION_BUFFERS) {
+    GLTF_STAGE(GLTF_LOAD_STAGE_BUFFERS, gltf_parse_buffers(doc, root, ctx, out_err));
+    gltf_stats_buffers(stats, doc, root, ctx);
+  }
 
-  // Images
-  GLTF_TRY(gltf_parse_images(doc, root, out_err));
-  
-  // Samplers
-  GLTF_TRY(gltf_parse_samplers(doc, root, out_err));
+  if (sections & GLTF_LOAD_SECTION_IMAGES) {
+    GLTF_STAGE(GLTF_LOAD_STAGE_IMAGES, gltf_parse_images(doc, root, out_err));
+  }
 
-  // Textures
-  GLTF_TRY(gltf_parse_textures(doc, root, out_err));
+  // Samplers, textures, materials
+  if (sections & GLTF_LOAD_SECTION_MATERIALS) {
+    GLTF_STAGE(GLTF_LOAD_STAGE_SAMPLERS, gltf_parse_samplers(doc, root, out_err));
+    GLTF_STAGE(GLTF_LOAD_STAGE_TEXTURES, gltf_parse_textures(doc, root, out_err));
+    GLTF_STAGE(GLTF_LOAD_STAGE_MATERIALS, gltf_parse_materials(doc, root, out_err));
+  }
 
-  // Materials
-  GLTF_TRY(gltf_parse_materials(doc, root, out_err));
+  // Primitive slot tables need meshes, accessors and buffer counts in place.
+  t0 = gltf_stats_begin(stats, GLTF_LOAD_STAGE_INDEX);
+  gltf_doc_build_prim_slots(doc);
+  const int indexed = !(ctx->flags & GLTF_LOAD_CTX_NAME_INDEX) || gltf_doc_build_name_index(doc);
+  gltf_stats_end(stats, GLTF_LOAD_STAGE_INDEX, t0);
+  if (!indexed) {
+    GLTF_FAIL(GLTF_ERR_IO, "out of memory", "root", 1, 1);
+  }
 
   yyjson_val* asset_val = yyjson_obj_get(root, "asset");
   if (!asset_val || !yyjson_is_obj(asset_val)) {
@@ -219,6 +292,7 @@ static gltf_result gltf_load_json_string_ex(uint8_t* json_text,
     }
   }
 
+  gltf_stats_doc(stats, doc);
   yyjson_doc_free(json_doc);
   json_doc = NULL;
 
@@ -226,19 +300,87 @@ static gltf_result gltf_load_json_string_ex(uint8_t* json_text,
   gltf_set_err(out_err, NULL, NULL, 0, 0);
   return GLTF_OK;
 
+#undef GLTF_STAGE
 #undef GLTF_TRY
 #undef GLTF_FAIL
 }
 
 
+// An allocator, when given, must provide all three functions.
+static int gltf_load_options_valid(const gltf_load_options* opts) {
+  const gltf_allocator* a = opts ? opts->allocator : NULL;
+  const gltf_io* io = opts ? opts->io : NULL;
+  if (a && !(a->malloc && a->realloc && a->free)) return 0;
+  return !io || (io->open && io->size && io->read && io->close && !io->map == !io->release);
+}
+
 static int gltf_is_glb_bytes(const uint8_t* data, size_t size) {
   if (!data || size < 12) return 0;
   return rd_u32_le(data + 0) == 0x46546C67u; // 'glTF'
 }
 
+static gltf_result gltf_load_glb_internal(const uint8_t* data,
+                                          size_t size,
+                                          size_t readable_size,
+                                          uint32_t flags,
+                                          const gltf_allocator* alc,
+                                          uint32_t sections,
+                                          gltf_load_stats* stats,
+                                          gltf_doc** out_doc,
+                                          gltf_error* out_err);
+
+// Keeps the .gltf text block as storage for the data-URI buffers decoded over
+// it: they are moved to the front (16-byte aligned, in text order) and the
+// block is shrunk to fit. Returns 1 if the document took the block.
+static int gltf_doc_adopt_text(gltf_doc* doc, uint8_t* text, size_t text_size) {
+  size_t* offs = NULL; // offs[i] = offset + 1 of moved buffers, 0 otherwise
+  size_t used = 0;
+  int compact = 1;
+
+  for (uint32_t i = 0; i < doc->buffer_count; i++) {
+    gltf_buffer* b = &doc->buffers[i];
+    if (b->storage != GLTF_BUFFER_BORROWED || b->data < text || b->data >= text + text_size) continue;
+    doc->file_bytes = text;
+    if (!compact) continue;
+    if (!offs) offs = (size_t*)calloc(doc->buffer_count, sizeof(size_t));
+    if (!offs || (size_t)(b->data - text) < used) {
+      compact = 0; // out of memory or not in text order: keep the block as is
+      continue;
+    }
+
+    // The destination never passes the source: each payload is preceded by its
+    // own (4/3 larger) base64 text and at least the "data:;base64," prefix.
+    size_t off = (used + 15u) & ~(size_t)15u;
+    if (off > (size_t)(b->data - text)) off = used;
+    memmove(text + off, b->data, b->byte_length);
+    b->data = text + off;
+    offs[i] = off + 1u;
+    used = off + b->byte_length;
+  }
+
+  if (doc->file_bytes && compact) {
+    uint8_t* shrunk = (uint8_t*)realloc(text, used ? used : 1u);
+    if (shrunk) {
+      doc->file_bytes = shrunk;
+      for (uint32_t i = 0; i < doc->buffer_count; i++) {
+        if (offs[i]) doc->buffers[i].data = shrunk + (offs[i] - 1u);
+      }
+    }
+  }
+  free(offs);
+  return doc->file_bytes != NULL;
+}
+
 gltf_result gltf_load_file(const char* path,
                            gltf_doc** out_doc,
                            gltf_error* out_err) {
+  return gltf_load_file_ex(path, NULL, out_doc, out_err);
+}
+
+gltf_result gltf_load_file_ex(const char* path,
+                              const gltf_load_options* opts,
+                              gltf_doc** out_doc,
+                              gltf_error* out_err) {
   if (out_doc) {
     *out_doc = NULL;
   }
@@ -248,25 +390,104 @@ gltf_result gltf_load_file(const char* path,
     return GLTF_ERR_INVALID;
   }
 
+  if (!gltf_load_options_valid(opts)) {
+    gltf_set_err(out_err, "incomplete allocator or io", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+
+  const uint32_t flags = opts ? opts->flags : GLTF_LOAD_DEFAULT;
+  const gltf_allocator* alc = opts ? opts->allocator : NULL;
+  const uint32_t sections = opts ? opts->sections : 0u;
+  const gltf_io* io = opts ? opts->io : NULL;
+  gltf_load_stats* stats = opts ? opts->stats : NULL;
+  gltf_stats_reset(stats);
+
+  if ((flags & GLTF_LOAD_MMAP) || (io && io->map)) {
+    // GLB: map the whole file and let buffers[0] borrow the BIN chunk from the
+    // mapping (read-only, so the JSON chunk is copied rather than parsed in place).
+    const uint8_t* map = NULL;
+    size_t map_size = 0;
+    const double t0 = gltf_stats_begin(stats, GLTF_LOAD_STAGE_READ);
+    const int mapped = gltf_fs_map_file_io(io, path, 0, &map, &map_size) == GLTF_FS_OK;
+    gltf_stats_end(stats, GLTF_LOAD_STAGE_READ, t0);
+    if (mapped && gltf_is_glb_bytes(map, map_size)) {
+      gltf_stats_file(stats, map_size, 0u);
+      gltf_result rc = gltf_load_glb_internal(map,
+                                              map_size,
+                                              map_size,
+                                              GLTF_LOAD_BORROW_BIN,
+                                              alc,
+                                              sections,
+                                              stats,
+                                              out_doc,
+                                              out_err);
+      if (rc == GLTF_OK && io) (*out_doc)->io = *io;
+      if (rc == GLTF_OK && (*out_doc)->buffer_count > 0 &&
+          (*out_doc)->buffers[0].storage == GLTF_BUFFER_BORROWED) {
+        (*out_doc)->file_map = map;
+        (*out_doc)->file_map_size = map_size;
+      } else {
+        gltf_fs_unmap_io(io, map, map_size);
+      }
+      return rc;
+    }
+    // .gltf (or mapping failed): read the JSON below; external buffers get mapped.
+    gltf_fs_unmap_io(io, map, map_size);
+  }
+
   uint8_t* data = NULL;
   size_t size = 0;
-  int st = gltf_fs_read_file(path, &data, &size);
+  const double t0 = gltf_stats_begin(stats, GLTF_LOAD_STAGE_READ);
+  int st = gltf_fs_read_file_io(io, path, &data, &size);
+  gltf_stats_end(stats, GLTF_LOAD_STAGE_READ, t0);
   if (st != GLTF_FS_OK) {
     gltf_set_err(out_err, "failed to read file", path, 1, 1);
     return GLTF_ERR_IO;
   }
+  gltf_stats_file(stats, size, (uint64_t)size + GLTF_FS_READ_PADDING);
 
   gltf_result rc;
 
-  // GLB
+  // GLB: the file buffer is ours, so parse JSON in place and let buffers[0]
+  // borrow the BIN chunk; the document then takes ownership of the bytes.
   if (gltf_is_glb_bytes(data, size)) {
-    rc = gltf_load_glb_bytes(data, size, out_doc, out_err);
-    free(data);
+    rc = gltf_load_glb_internal(data,
+                                size,
+                                size + GLTF_FS_READ_PADDING,
+                                GLTF_LOAD_BORROW_BIN | GLTF_LOAD_JSON_INSITU,
+                                alc,
+                                sections,
+                                stats,
+                                out_doc,
+                                out_err);
+    if (rc == GLTF_OK && io) (*out_doc)->io = *io;
+    if (rc == GLTF_OK && (*out_doc)->buffer_count > 0 &&
+        (*out_doc)->buffers[0].storage == GLTF_BUFFER_BORROWED) {
+      (*out_doc)->file_bytes = data;
+    } else {
+      free(data);
+    }
     return rc;
   }
 
-  // glTF JSON
+  // glTF JSON (file buffer is zero-padded, parse in place)
   gltf_load_context ctx = {0};
+  ctx.flags = GLTF_LOAD_CTX_JSON_INSITU;
+  ctx.allocator = alc;
+  ctx.sections = sections;
+  ctx.dispatch = opts ? opts->dispatch : NULL;
+  ctx.dispatch_user = opts ? opts->dispatch_user : NULL;
+  ctx.io = io;
+  ctx.stats = stats;
+  if (flags & GLTF_LOAD_MMAP) {
+    ctx.flags |= GLTF_LOAD_CTX_MMAP;
+  }
+  if (flags & GLTF_LOAD_LAZY_BUFFERS) {
+    ctx.flags |= GLTF_LOAD_CTX_LAZY_BUFFERS;
+  }
+  if (flags & GLTF_LOAD_NAME_INDEX) {
+    ctx.flags |= GLTF_LOAD_CTX_NAME_INDEX;
+  }
 
   // directory for external resources
   size_t dir_len = gltf_fs_dir_len(path);
@@ -282,7 +503,16 @@ gltf_result gltf_load_file(const char* path,
     ctx.doc_dir = dir;
   }
 
+  // Data-URI buffers decode over the text; the document then keeps the block.
+  ctx.flags |= GLTF_LOAD_CTX_DECODE_INSITU;
+  ctx.json_text = data;
+  ctx.json_text_size = size;
+
   rc = gltf_load_json_string_ex(data, (uint32_t)size, &ctx, out_doc, out_err);
+  if (rc == GLTF_OK && io) (*out_doc)->io = *io;
+  if (rc == GLTF_OK && gltf_doc_adopt_text(*out_doc, data, size)) {
+    data = NULL;
+  }
 
   free((void*)ctx.doc_dir);
   free(data);
@@ -297,16 +527,17 @@ gltf_result gltf_load_json_string(uint8_t* json_text,
   return gltf_load_json_string_ex(json_text, json_len, &ctx, out_doc, out_err);
 }
 
-gltf_result gltf_load_glb_bytes(const uint8_t* data,
-                                size_t size,
-                                gltf_doc** out_doc,
-                                gltf_error* out_err) {
-  if (!data || !out_doc || !out_err) {
-    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
-    return GLTF_ERR_INVALID;
-  }
-
-  *out_doc = NULL;
+gltf_result gltf_glb_split(const uint8_t* data,
+                           size_t size,
+                           const uint8_t** out_json,
+                           uint32_t* out_json_len,
+                           const uint8_t** out_bin,
+                           uint32_t* out_bin_len,
+                           gltf_error* out_err) {
+  *out_json = NULL;
+  *out_json_len = 0;
+  *out_bin = NULL;
+  *out_bin_len = 0;
 
   if (size < 12) {
     gltf_set_err(out_err, "file too small", "root", 1, 1);
@@ -337,7 +568,6 @@ gltf_result gltf_load_glb_bytes(const uint8_t* data,
 
   const uint8_t* json_ptr = NULL;
   uint32_t json_len = 0;
-
   const uint8_t* bin_ptr = NULL;
   uint32_t bin_len = 0;
   
@@ -407,14 +637,60 @@ gltf_result gltf_load_glb_bytes(const uint8_t* data,
     return GLTF_ERR_INVALID;
   }
 
-  // copy JSON to NUL-terminated string
-  uint8_t* json_text = (uint8_t*)malloc((size_t)(json_len + 1u));
-  if (!json_text) {
-    gltf_set_err(out_err, "out of memory", "root", 1, 1);
-    return GLTF_ERR_IO;
+  *out_json = json_ptr;
+  *out_json_len = json_len;
+  *out_bin = bin_ptr;
+  *out_bin_len = bin_len;
+  return GLTF_OK;
+}
+
+// Loads a GLB from data[0..size).
+//
+// Notes:
+//   - readable_size >= size is how many bytes may be read (and temporarily
+//     written) at data; in-place JSON parsing borrows the 4 bytes after the
+//     JSON chunk as yyjson padding and restores them afterwards.
+//   - GLTF_LOAD_JSON_INSITU requires data to be writable.
+static gltf_result gltf_load_glb_internal(const uint8_t* data,
+                                          size_t size,
+                                          size_t readable_size,
+                                          uint32_t flags,
+                                          const gltf_allocator* alc,
+                                          uint32_t sections,
+                                          gltf_load_stats* stats,
+                                          gltf_doc** out_doc,
+                                          gltf_error* out_err) {
+  if (!data || !out_doc || !out_err) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    return GLTF_ERR_INVALID;
   }
-  memcpy(json_text, json_ptr, json_len);
-  json_text[json_len] = '\0';
+
+  *out_doc = NULL;
+
+  const uint8_t* json_ptr = NULL;
+  uint32_t json_len = 0;
+  const uint8_t* bin_ptr = NULL;
+  uint32_t bin_len = 0;
+  gltf_result rc = gltf_glb_split(data, size, &json_ptr, &json_len, &bin_ptr, &bin_len, out_err);
+  if (rc != GLTF_OK) return rc;
+
+  const size_t json_end = (size_t)(json_ptr - data) + (size_t)json_len;
+  return gltf_load_glb_chunks(json_ptr, json_len, readable_size - json_end, bin_ptr, bin_len,
+                              flags, alc, sections, stats, out_doc, out_err);
+}
+
+gltf_result gltf_load_glb_chunks(const uint8_t* json_ptr,
+                                 uint32_t json_len,
+                                 size_t json_tail,
+                                 const uint8_t* bin_ptr,
+                                 uint32_t bin_len,
+                                 uint32_t flags,
+                                 const gltf_allocator* alc,
+                                 uint32_t sections,
+                                 gltf_load_stats* stats,
+                                 gltf_doc** out_doc,
+                                 gltf_error* out_err) {
+  *out_doc = NULL;
 
   gltf_doc* doc = NULL;
   gltf_load_context ctx = {
@@ -422,11 +698,48 @@ gltf_result gltf_load_glb_bytes(const uint8_t* data,
     .internal_bin_size = (bin_ptr && bin_len) ? bin_len : 0,
     .doc_dir           = NULL,
     .flags             = GLTF_LOAD_CTX_GLB,
+    .allocator         = alc,
+    .sections          = sections,
+    .stats             = stats,
   };
-  gltf_result rc = gltf_load_json_string_ex(json_text, json_len, &ctx, &doc, out_err);
+  if (flags & GLTF_LOAD_BORROW_BIN) {
+    ctx.flags |= GLTF_LOAD_CTX_BORROW_BIN;
+  }
+  if (flags & GLTF_LOAD_NAME_INDEX) {
+    ctx.flags |= GLTF_LOAD_CTX_NAME_INDEX;
+  }
 
-  free(json_text);
-  json_text = NULL;
+  gltf_result rc;
+
+  if ((flags & GLTF_LOAD_JSON_INSITU) && json_tail >= YYJSON_PADDING_SIZE) {
+    // In-place parse: zero the bytes following the JSON chunk (the BIN chunk
+    // header, or caller padding) for the duration of the parse only.
+    uint8_t* json_text = (uint8_t*)(uintptr_t)json_ptr;
+    uint8_t saved[YYJSON_PADDING_SIZE];
+    memcpy(saved, json_text + json_len, sizeof saved);
+    memset(json_text + json_len, 0, sizeof saved);
+
+    ctx.flags |= GLTF_LOAD_CTX_JSON_INSITU;
+    rc = gltf_load_json_string_ex(json_text, json_len, &ctx, &doc, out_err);
+
+    memcpy(json_text + json_len, saved, sizeof saved);
+  } else {
+    // copy JSON to NUL-terminated string
+    const gltf_allocator* a = alc ? alc : gltf_allocator_default();
+    uint8_t* json_text = (uint8_t*)a->malloc(a->user, (size_t)json_len + 1u);
+    if (!json_text) {
+      gltf_set_err(out_err, "out of memory", "root", 1, 1);
+      return GLTF_ERR_IO;
+    }
+    memcpy(json_text, json_ptr, json_len);
+    json_text[json_len] = '\0';
+    gltf_stats_heap(stats, (uint64_t)json_len + 1u);
+
+    rc = gltf_load_json_string_ex(json_text, json_len, &ctx, &doc, out_err);
+
+    a->free(a->user, json_text);
+    json_text = NULL;
+  }
 
   if (rc != GLTF_OK) {
     return rc;
@@ -437,27 +750,168 @@ gltf_result gltf_load_glb_bytes(const uint8_t* data,
   return GLTF_OK;
 }
 
+gltf_result gltf_load_glb_bytes(const uint8_t* data,
+                                size_t size,
+                                gltf_doc** out_doc,
+                                gltf_error* out_err) {
+  return gltf_load_glb_internal(data, size, size, GLTF_LOAD_DEFAULT, NULL, 0u, NULL, out_doc, out_err);
+}
+
+gltf_result gltf_load_glb_bytes_ex(uint8_t* data,
+                                   size_t size,
+                                   const gltf_load_options* opts,
+                                   gltf_doc** out_doc,
+                                   gltf_error* out_err) {
+  if (!gltf_load_options_valid(opts)) {
+    if (out_doc) *out_doc = NULL;
+    gltf_set_err(out_err, "incomplete allocator or io", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+  const uint32_t flags = opts ? opts->flags : GLTF_LOAD_DEFAULT;
+  gltf_load_stats* stats = opts ? opts->stats : NULL;
+  gltf_stats_reset(stats);
+  gltf_stats_file(stats, size, 0u);
+  return gltf_load_glb_internal(data,
+                                size,
+                                size,
+                                flags,
+                                opts ? opts->allocator : NULL,
+                                opts ? opts->sections : 0u,
+                                stats,
+                                out_doc,
+                                out_err);
+}
+
+// ----------------------------------------------------------------------------
+// Batch loading
+// ----------------------------------------------------------------------------
+
+typedef struct gltf_load_batch {
+  const char* const* paths;
+  gltf_load_options opts; // dispatch cleared: files are the unit of parallelism
+  const gltf_load_options* opts_ptr;
+  gltf_load_result* results;
+} gltf_load_batch;
+
+// One task: load a single file. Tasks touch only their own result.
+static void gltf_load_batch_task(void* user, uint32_t task_index) {
+  const gltf_load_batch* b = (const gltf_load_batch*)user;
+  gltf_load_result* res = &b->results[task_index];
+  gltf_doc* doc = NULL;
+  gltf_error err = {0};
+
+  res->result = gltf_load_file_ex(b->paths[task_index], b->opts_ptr, &doc, &err);
+  res->error = err;
+  res->doc = doc;
+}
+
+// Loads a list of files, one dispatched task per entry.
+// Every result is filled; returns the first failure code (if any).
+gltf_result gltf_load_files(const char* const* paths,
+                            uint32_t count,
+                            const gltf_load_options* opts,
+                            gltf_load_result* out_results,
+                            gltf_dispatch_fn dispatch,
+                            void* dispatch_user,
+                            gltf_error* out_err) {
+  if (count > 0 && (!paths || !out_results)) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+  if (count == 0) return GLTF_OK;
+
+  gltf_load_batch batch;
+  memset(&batch, 0, sizeof batch);
+  batch.paths = paths;
+  if (opts) {
+    batch.opts = *opts;
+    batch.opts.dispatch = NULL;
+    batch.opts.dispatch_user = NULL;
+    batch.opts.stats = NULL; // one stats struct cannot serve parallel loads
+    batch.opts_ptr = &batch.opts;
+  }
+  batch.results = out_results;
+
+  if (dispatch) {
+    dispatch(dispatch_user, count, gltf_load_batch_task, &batch);
+  } else {
+    for (uint32_t i = 0; i < count; i++) gltf_load_batch_task(&batch, i);
+  }
+
+  for (uint32_t i = 0; i < count; i++) {
+    if (out_results[i].result != GLTF_OK) {
+      if (out_err) *out_err = out_results[i].error;
+      return out_results[i].result;
+    }
+  }
+  return GLTF_OK;
+}
+
+// ----------------------------------------------------------------------------
+// Lazy buffers
+// ----------------------------------------------------------------------------
+
+gltf_result gltf_buffer_resolve_lazy(const gltf_doc* doc,
+                                     uint32_t buffer_index,
+                                     gltf_error* out_err) {
+  // Buffers are document-owned; first-touch loading fills them in behind the
+  // const handle, serialized by doc->lock (double-checked via 'pending').
+  gltf_doc* d = (gltf_doc*)(uintptr_t)doc;
+  gltf_buffer* b = &d->buffers[buffer_index];
+  gltf_result r = GLTF_OK;
+
+  gltf_mutex_lock(&d->lock);
+  if (b->pending) {
+    const char* path = gltf_str_is_valid(b->path) ? arena_get_str(&d->arena, b->path) : NULL;
+    const char* uri = path ? NULL : arena_get_str(&d->arena, b->uri);
+    r = gltf_load_buffer_source(b, path, uri, d->load_flags, gltf_doc_io(d), out_err);
+    if (r == GLTF_OK) {
+      gltf_atomic_store_release_u32(&b->pending, 0u);
+    }
+  }
+  gltf_mutex_unlock(&d->lock);
+  return r;
+}
+
 void gltf_free(gltf_doc* doc) {
   if (doc) {
-    free(doc->scenes);
-    free(doc->nodes);
-    free(doc->meshes);
-    free(doc->primitives);
-    free(doc->prim_attrs);
+    const gltf_io io = doc->io;
+    const gltf_io* iop = io.open ? &io : NULL;
     if (doc->buffers) {
       for (uint32_t i = 0; i < doc->buffer_count; i++) {
-        free(doc->buffers[i].data);
+        if (doc->buffers[i].storage == GLTF_BUFFER_OWNED) {
+          free(doc->buffers[i].data);
+        } else if (doc->buffers[i].storage == GLTF_BUFFER_MAPPED) {
+          gltf_fs_unmap_io(iop, doc->buffers[i].data, (size_t)doc->buffers[i].byte_length);
+        }
       }
     }
-    free(doc->buffers);
-    free(doc->buffer_views);
-    free(doc->materials);
-    free(doc->textures);
-    free(doc->images);
-    free(doc->samplers);
-    free(doc->accessors);
-    free(doc->indices_u32);
-    free(doc->arena.data);
-    free(doc);
+    if (doc->image_bytes) {
+      for (uint32_t i = 0; i < doc->image_count; i++) free(doc->image_bytes[i].data);
+    }
+    if (doc->sparse_dense) {
+      for (uint32_t i = 0; i < doc->sparse_dense_count; i++) free(doc->sparse_dense[i].data);
+    }
+    if (doc->file_bytes_alc) {
+      doc->alc.free(doc->alc.user, doc->file_bytes);
+    } else {
+      free(doc->file_bytes);
+    }
+    gltf_mutex_destroy(&doc->lock);
+
+    // Every array, string and index list lives in the block that starts at
+    // doc: allocator memory, or the file mapping of a baked document.
+    const uint8_t* map = doc->file_map;
+    const size_t map_size = doc->file_map_size;
+    const gltf_allocator alc = doc->alc;
+    const uint32_t block_mapped = doc->block_mapped;
+    if (!block_mapped) alc.free(alc.user, doc);
+
+    // A baked file is always an OS mapping; a mapped .glb came through io.
+    if (block_mapped) {
+      gltf_fs_unmap(map, map_size);
+    } else {
+      gltf_fs_unmap_io(iop, map, map_size);
+    }
   }
 }
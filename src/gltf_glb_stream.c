@@ -0,0 +1,345 @@
+// Minimal educational glTF 2.0 loader (C11).
+//
+// Streaming GLB: build a document from a .glb that arrives in pieces.
+//
+// Responsibilities:
+//   - parse the GLB header and chunk headers incrementally
+//   - parse the JSON chunk as soon as it (and the BIN chunk header) is in
+//   - write BIN chunk bytes in place into the buffer the document borrows
+//   - report per-bufferView readiness while the BIN chunk is still arriving
+//
+// Notes:
+//   - Container validation matches gltf_load_glb_bytes() (same messages).
+//   - bin_have is the only field that changes while reader threads use the
+//     document: it is published with release semantics after the bytes below
+//     it have been written.
+//
+// Public API contracts are documented in include/gltf/gltf.h.
+
+
+#include "gltf_internal.h"
+
+
+// ----------------------------------------------------------------------------
+// State
+// ----------------------------------------------------------------------------
+
+typedef enum gltf_glb_stream_state {
+  GLTF_GLB_STREAM_HEADER = 0,   // 12-byte file header
+  GLTF_GLB_STREAM_CHUNK_HEADER, // 8-byte chunk header
+  GLTF_GLB_STREAM_JSON,         // JSON chunk payload
+  GLTF_GLB_STREAM_BIN,          // BIN chunk payload
+  GLTF_GLB_STREAM_SKIP,         // payload of an unknown chunk
+  GLTF_GLB_STREAM_DONE,         // all `length` bytes received
+  GLTF_GLB_STREAM_FAILED
+} gltf_glb_stream_state;
+
+struct gltf_glb_stream {
+  gltf_allocator alc;     // the options' allocator, or the default
+  uint32_t sections;
+  uint32_t flags; // GLTF_LOAD_NAME_INDEX from the options
+
+  gltf_glb_stream_state state;
+  uint8_t head[12];       // header bytes being collected
+  uint32_t head_have;
+  uint32_t length;        // total file size from the GLB header
+  uint32_t offset;        // bytes consumed so far
+  uint32_t chunk_left;    // payload bytes left in the current chunk
+  uint32_t chunk_count;
+
+  uint8_t* json;          // [json_len + YYJSON_PADDING_SIZE], freed once parsed
+  uint32_t json_len;
+  uint32_t json_have;
+
+  uint8_t* bin;           // [bin_len], or NULL before the BIN chunk header
+  uint32_t bin_len;
+  volatile uint32_t bin_have; // atomic: bytes of bin written
+  int bin_owned;          // 1 if the stream (not doc->file_bytes) frees bin
+
+  gltf_doc* doc;
+
+  gltf_result fail_rc;
+  gltf_error fail_err;
+};
+
+static gltf_result glb_stream_fail(gltf_glb_stream* s,
+                                   gltf_result rc,
+                                   const char* message,
+                                   gltf_error* out_err) {
+  if (message) gltf_set_err(&s->fail_err, message, "root", 1, 1);
+  s->fail_rc = rc;
+  s->state = GLTF_GLB_STREAM_FAILED;
+  if (out_err) *out_err = s->fail_err;
+  return rc;
+}
+
+// Builds the document from the JSON chunk and the (allocated, not yet filled)
+// BIN chunk, then drops the JSON text.
+static gltf_result glb_stream_parse(gltf_glb_stream* s, gltf_error* out_err) {
+  gltf_result rc = gltf_load_glb_chunks(s->json,
+                                        s->json_len,
+                                        YYJSON_PADDING_SIZE,
+                                        s->bin,
+                                        s->bin_len,
+                                        GLTF_LOAD_BORROW_BIN | GLTF_LOAD_JSON_INSITU | s->flags,
+                                        &s->alc,
+                                        s->sections,
+                                        NULL,
+                                        &s->doc,
+                                        &s->fail_err);
+  s->alc.free(s->alc.user, s->json);
+  s->json = NULL;
+  if (rc != GLTF_OK) return glb_stream_fail(s, rc, NULL, out_err);
+
+  // buffers[0] writes land in the document's own storage; readers that
+  // build cached copies (sparse accessors) check how much has arrived.
+  if (s->bin && s->doc->buffer_count > 0 && s->doc->buffers[0].data == s->bin) {
+    s->doc->file_bytes = s->bin;
+    s->doc->file_bytes_alc = 1u;
+    s->doc->stream_have = &s->bin_have;
+    s->bin_owned = 0;
+  }
+  return GLTF_OK;
+}
+
+// Moves to the next chunk header, or to DONE (parsing a document that has no
+// BIN chunk) at the end of the file.
+static gltf_result glb_stream_next_chunk(gltf_glb_stream* s, gltf_error* out_err) {
+  s->head_have = 0;
+  if (s->offset == s->length) {
+    s->state = GLTF_GLB_STREAM_DONE;
+    return s->doc ? GLTF_OK : glb_stream_parse(s, out_err);
+  }
+  if (s->length - s->offset < 8u) {
+    return glb_stream_fail(s, GLTF_ERR_INVALID, "truncated chunk header", out_err);
+  }
+  s->state = GLTF_GLB_STREAM_CHUNK_HEADER;
+  return GLTF_OK;
+}
+
+static gltf_result glb_stream_header(gltf_glb_stream* s, gltf_error* out_err) {
+  const uint32_t magic = rd_u32_le(s->head + 0);
+  const uint32_t version = rd_u32_le(s->head + 4);
+  s->length = rd_u32_le(s->head + 8);
+
+  if (magic != 0x46546C67u) { // 'glTF'
+    return glb_stream_fail(s, GLTF_ERR_INVALID, "bad magic", out_err);
+  }
+  if (version != 2u) {
+    return glb_stream_fail(s, GLTF_ERR_INVALID, "unsupported glb version", out_err);
+  }
+  if (s->length < 12u) {
+    return glb_stream_fail(s, GLTF_ERR_INVALID, "glb length mismatch", out_err);
+  }
+  if (s->length == 12u) {
+    return glb_stream_fail(s, GLTF_ERR_INVALID, "missing JSON chunk", out_err);
+  }
+  return glb_stream_next_chunk(s, out_err);
+}
+
+static gltf_result glb_stream_chunk_header(gltf_glb_stream* s, gltf_error* out_err) {
+  const uint32_t chunk_len = rd_u32_le(s->head + 0);
+  const uint32_t chunk_type = rd_u32_le(s->head + 4);
+
+  if (chunk_len > s->length - s->offset) {
+    return glb_stream_fail(s, GLTF_ERR_INVALID, "chunk out of bounds", out_err);
+  }
+  if ((chunk_len & 3u) != 0u) {
+    return glb_stream_fail(s, GLTF_ERR_INVALID, "chunk length not 4-byte aligned", out_err);
+  }
+
+  const uint32_t index = s->chunk_count++;
+  s->chunk_left = chunk_len;
+
+  if (chunk_type == 0x4E4F534Au) { // 'JSON'
+    if (index != 0) {
+      return glb_stream_fail(s, GLTF_ERR_INVALID, "duplicate JSON chunk", out_err);
+    }
+    if (chunk_len == 0) {
+      return glb_stream_fail(s, GLTF_ERR_INVALID, "missing JSON chunk", out_err);
+    }
+    const size_t json_size = (size_t)chunk_len + YYJSON_PADDING_SIZE;
+    s->json = (uint8_t*)s->alc.malloc(s->alc.user, json_size);
+    if (!s->json) return glb_stream_fail(s, GLTF_ERR_IO, "out of memory", out_err);
+    memset(s->json, 0, json_size);
+    s->json_len = chunk_len;
+    s->state = GLTF_GLB_STREAM_JSON;
+    return GLTF_OK;
+  }
+
+  if (index == 0) {
+    return glb_stream_fail(s, GLTF_ERR_INVALID, "JSON chunk must be first", out_err);
+  }
+
+  if (chunk_type == 0x004E4942u) { // 'BIN\0'
+    if (s->bin) {
+      return glb_stream_fail(s, GLTF_ERR_INVALID, "duplicate BIN chunk", out_err);
+    }
+    s->bin = (uint8_t*)s->alc.malloc(s->alc.user, chunk_len ? (size_t)chunk_len : 1u);
+    if (!s->bin) return glb_stream_fail(s, GLTF_ERR_IO, "out of memory", out_err);
+    s->bin_len = chunk_len;
+    s->bin_owned = 1;
+    s->state = GLTF_GLB_STREAM_BIN;
+    if (!s->doc) {
+      gltf_result rc = glb_stream_parse(s, out_err);
+      if (rc != GLTF_OK) return rc;
+    }
+    return chunk_len ? GLTF_OK : glb_stream_next_chunk(s, out_err);
+  }
+
+  // Unknown chunk type: ignore its payload.
+  s->state = GLTF_GLB_STREAM_SKIP;
+  return chunk_len ? GLTF_OK : glb_stream_next_chunk(s, out_err);
+}
+
+
+// ----------------------------------------------------------------------------
+// Public API
+// ----------------------------------------------------------------------------
+
+gltf_result gltf_glb_stream_create(const gltf_load_options* opts,
+                                   gltf_glb_stream** out_stream,
+                                   gltf_error* out_err) {
+  if (out_stream) *out_stream = NULL;
+  const gltf_allocator* a = opts ? opts->allocator : NULL;
+  if (!out_stream || (a && !(a->malloc && a->realloc && a->free))) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+
+  if (!a) a = gltf_allocator_default();
+  gltf_glb_stream* s = (gltf_glb_stream*)a->malloc(a->user, sizeof(gltf_glb_stream));
+  if (!s) {
+    gltf_set_err(out_err, "out of memory", "root", 1, 1);
+    return GLTF_ERR_IO;
+  }
+  memset(s, 0, sizeof *s);
+  s->alc = *a;
+  s->sections = opts ? opts->sections : 0u;
+  s->flags = opts ? (opts->flags & GLTF_LOAD_NAME_INDEX) : 0u;
+  s->state = GLTF_GLB_STREAM_HEADER;
+
+  *out_stream = s;
+  gltf_set_err(out_err, NULL, NULL, 0, 0);
+  return GLTF_OK;
+}
+
+gltf_result gltf_glb_stream_feed(gltf_glb_stream* s,
+                                 const uint8_t* data,
+                                 size_t size,
+                                 gltf_error* out_err) {
+  if (!s || (!data && size > 0)) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+  if (s->state == GLTF_GLB_STREAM_FAILED) {
+    if (out_err) *out_err = s->fail_err;
+    return s->fail_rc;
+  }
+
+  while (size > 0) {
+    if (s->state == GLTF_GLB_STREAM_DONE) {
+      return glb_stream_fail(s, GLTF_ERR_INVALID, "glb length mismatch", out_err);
+    }
+
+    gltf_result rc = GLTF_OK;
+    size_t n = 0;
+    switch (s->state) {
+      case GLTF_GLB_STREAM_HEADER:
+      case GLTF_GLB_STREAM_CHUNK_HEADER: {
+        const uint32_t need = (s->state == GLTF_GLB_STREAM_HEADER ? 12u : 8u) - s->head_have;
+        n = size < need ? size : need;
+        memcpy(s->head + s->head_have, data, n);
+        s->head_have += (uint32_t)n;
+        s->offset += (uint32_t)n;
+        if (n == need) {
+          rc = s->state == GLTF_GLB_STREAM_HEADER ? glb_stream_header(s, out_err)
+                                                  : glb_stream_chunk_header(s, out_err);
+        }
+        break;
+      }
+
+      case GLTF_GLB_STREAM_JSON:
+      case GLTF_GLB_STREAM_BIN:
+      case GLTF_GLB_STREAM_SKIP: {
+        n = size < s->chunk_left ? size : s->chunk_left;
+        if (s->state == GLTF_GLB_STREAM_JSON) {
+          memcpy(s->json + s->json_have, data, n);
+          s->json_have += (uint32_t)n;
+        } else if (s->state == GLTF_GLB_STREAM_BIN) {
+          const uint32_t have = s->bin_have;
+          memcpy(s->bin + have, data, n);
+          gltf_atomic_store_release_u32(&s->bin_have, have + (uint32_t)n);
+        }
+        s->chunk_left -= (uint32_t)n;
+        s->offset += (uint32_t)n;
+        if (s->chunk_left == 0) rc = glb_stream_next_chunk(s, out_err);
+        break;
+      }
+
+      default:
+        return glb_stream_fail(s, GLTF_ERR_INVALID, "invalid stream state", out_err);
+    }
+    if (rc != GLTF_OK) return rc;
+    data += n;
+    size -= n;
+  }
+
+  gltf_set_err(out_err, NULL, NULL, 0, 0);
+  return GLTF_OK;
+}
+
+const gltf_doc* gltf_glb_stream_doc(const gltf_glb_stream* s) {
+  return s && s->state != GLTF_GLB_STREAM_FAILED ? s->doc : NULL;
+}
+
+int gltf_glb_stream_buffer_view_ready(const gltf_glb_stream* s, uint32_t buffer_view_index) {
+  // Not gated on state: doc and bin are set once, before readers can see doc.
+  const gltf_doc* doc = s ? s->doc : NULL;
+  if (!doc || buffer_view_index >= doc->buffer_view_count) return 0;
+
+  const gltf_buffer_view* bv = &doc->buffer_views[buffer_view_index];
+  if (bv->buffer >= doc->buffer_count) return 0;
+  const gltf_buffer* b = &doc->buffers[bv->buffer];
+  if (!s->bin || b->data != s->bin) return b->data != NULL;
+
+  const uint64_t end = (uint64_t)bv->byte_offset + (uint64_t)bv->byte_length;
+  return end <= (uint64_t)gltf_atomic_load_acquire_u32(&s->bin_have);
+}
+
+gltf_result gltf_glb_stream_finish(gltf_glb_stream* s,
+                                   gltf_doc** out_doc,
+                                   gltf_error* out_err) {
+  if (out_doc) *out_doc = NULL;
+  if (!s || !out_doc) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    gltf_glb_stream_free(s);
+    return GLTF_ERR_INVALID;
+  }
+
+  gltf_result rc = GLTF_OK;
+  if (s->state == GLTF_GLB_STREAM_FAILED) {
+    if (out_err) *out_err = s->fail_err;
+    rc = s->fail_rc;
+  } else if (s->state != GLTF_GLB_STREAM_DONE) {
+    gltf_set_err(out_err, s->length ? "glb length mismatch" : "file too small", "root", 1, 1);
+    rc = GLTF_ERR_INVALID;
+  } else {
+    s->doc->stream_have = NULL; // every byte is in; the counter goes with s
+    *out_doc = s->doc;
+    s->doc = NULL;
+    gltf_set_err(out_err, NULL, NULL, 0, 0);
+  }
+
+  gltf_glb_stream_free(s);
+  return rc;
+}
+
+void gltf_glb_stream_free(gltf_glb_stream* s) {
+  if (!s) return;
+  const gltf_allocator alc = s->alc;
+  gltf_free(s->doc); // owns bin unless bin_owned
+  if (s->bin_owned) alc.free(alc.user, s->bin);
+  if (s->json) alc.free(alc.user, s->json);
+  alc.free(alc.user, s);
+}
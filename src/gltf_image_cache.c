@@ -0,0 +1,418 @@
+// Minimal educational glTF 2.0 loader (C11).
+//
+// Decoded image cache shared across documents and threads.
+//
+// Responsibilities:
+//   - key decoded RGBA8 images by source identity:
+//       * URI images: resolved path + file size + modification time
+//       * data URI / bufferView images: content hash (FNV-1a 64) + length
+//   - reference-count entries handed out by gltf_image_cache_acquire_rgba8()
+//   - keep unreferenced entries in LRU order and evict past the byte budget
+//
+// Notes:
+//   - One mutex guards the table; decoding runs outside it. Concurrent misses
+//     on the same key wait for the first decode instead of repeating it.
+//   - Content keys are not compared byte-for-byte; a 64-bit hash plus length
+//     collision would alias two images.
+//
+// Public API contracts are documented in include/gltf/gltf.h.
+
+
+#include "gltf_internal.h"
+
+
+// ----------------------------------------------------------------------------
+// Internal helpers (fs)
+// ----------------------------------------------------------------------------
+
+// File system helpers implemented in src/fs.c.
+typedef enum gltf_fs_status {
+  GLTF_FS_OK = 0,
+  GLTF_FS_INVALID,
+  GLTF_FS_IO,
+  GLTF_FS_OOM,
+  GLTF_FS_SIZE_MISMATCH,
+  GLTF_FS_TOO_LARGE
+} gltf_fs_status;
+
+gltf_fs_status gltf_fs_stat_io(const gltf_io* io,
+                               const char* path,
+                               uint64_t* out_size,
+                               int64_t* out_mtime_ns);
+
+
+// ----------------------------------------------------------------------------
+// Types
+// ----------------------------------------------------------------------------
+
+typedef struct gltf_image_key {
+  uint64_t hash;      // FNV-1a of the path (URI) or of the encoded content
+  uint64_t size;      // file size or content length
+  int64_t mtime_ns;   // URI images only
+  const char* path;   // URI images only (owned copy), NULL for content keys
+} gltf_image_key;
+
+typedef struct gltf_image_entry {
+  gltf_image_pixels pixels;        // first member: release() maps pixels back to the entry
+  gltf_image_key key;
+  size_t bytes;                    // pixel bytes, counted once loaded
+  uint32_t refs;
+  int loading;                     // decode in progress (pixels not ready)
+  int detached;                    // removed from the table while referenced
+  struct gltf_image_entry* next;   // bucket chain
+  struct gltf_image_entry* lru_prev;
+  struct gltf_image_entry* lru_next;
+} gltf_image_entry;
+
+struct gltf_image_cache {
+  gltf_mutex lock;
+  gltf_cond loaded;                // broadcast when a pending decode finishes
+  gltf_image_entry** buckets;
+  uint32_t bucket_count;           // power of two
+  uint32_t entry_count;
+  uint64_t budget;                 // 0 = unlimited
+  uint64_t bytes;                  // decoded bytes held by loaded entries
+  gltf_image_entry* lru_head;      // most recently released
+  gltf_image_entry* lru_tail;      // next eviction candidate
+  gltf_image_cache_stats stats;
+};
+
+
+// ----------------------------------------------------------------------------
+// Keys
+// ----------------------------------------------------------------------------
+
+#if GLTF_ENABLE_IMAGES
+
+static uint64_t fnv1a64(const void* data, size_t size) {
+  const uint8_t* p = (const uint8_t*)data;
+  uint64_t h = 14695981039346656037ull;
+  for (size_t i = 0; i < size; i++) {
+    h ^= p[i];
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+static int key_equal(const gltf_image_key* a, const gltf_image_key* b) {
+  if (a->hash != b->hash || a->size != b->size || a->mtime_ns != b->mtime_ns) return 0;
+  if (!a->path || !b->path) return a->path == b->path;
+  return strcmp(a->path, b->path) == 0;
+}
+
+// Same source, any version (a URI image whose file changed).
+static int key_same_source(const gltf_image_key* a, const gltf_image_key* b) {
+  return a->path && b->path && a->hash == b->hash && strcmp(a->path, b->path) == 0;
+}
+
+// Builds the key for doc.images[image_index]. bufferView images already need
+// their bytes for hashing; those are returned in *out_blob for the decode.
+static gltf_result image_key(const gltf_doc* doc,
+                             uint32_t image_index,
+                             gltf_image_key* out_key,
+                             gltf_blob* out_blob,
+                             gltf_error* out_err) {
+  const gltf_image* img = &doc->images[image_index];
+  gltf_image_key k = {0};
+
+  if (img->kind == GLTF_IMAGE_URI) {
+    const char* path = img->resolved ? img->resolved : img->uri;
+    if (!path) {
+      gltf_set_err(out_err, "image uri missing", NULL, 0, 0);
+      return GLTF_ERR_PARSE;
+    }
+    if (gltf_fs_stat_io(gltf_doc_io(doc), path, &k.size, &k.mtime_ns) != GLTF_FS_OK) {
+      gltf_set_err(out_err, "failed to read image file", path, 0, 0);
+      return GLTF_ERR_IO;
+    }
+    k.path = path;
+    k.hash = fnv1a64(path, strlen(path));
+  } else if (img->kind == GLTF_IMAGE_DATA_URI) {
+    const char* payload = gltf_data_uri_base64_payload(img->uri);
+    if (!payload) {
+      gltf_set_err(out_err, "invalid data uri (expected ;base64,)", NULL, 0, 0);
+      return GLTF_ERR_PARSE;
+    }
+    k.size = strlen(payload);
+    k.hash = fnv1a64(payload, (size_t)k.size);
+  } else {
+    gltf_result r = gltf_image_load_bytes(doc, image_index, out_blob, out_err);
+    if (r != GLTF_OK) return r;
+    k.size = out_blob->size;
+    k.hash = fnv1a64(out_blob->data, out_blob->size);
+  }
+
+  *out_key = k;
+  return GLTF_OK;
+}
+
+#endif
+
+
+// ----------------------------------------------------------------------------
+// Table / LRU (cache->lock held)
+// ----------------------------------------------------------------------------
+
+static gltf_image_entry** bucket_of(gltf_image_cache* c, uint64_t hash) {
+  return &c->buckets[(uint32_t)(hash ^ (hash >> 32)) & (c->bucket_count - 1u)];
+}
+
+static void lru_unlink(gltf_image_cache* c, gltf_image_entry* e) {
+  if (e->lru_prev) e->lru_prev->lru_next = e->lru_next; else if (c->lru_head == e) c->lru_head = e->lru_next;
+  if (e->lru_next) e->lru_next->lru_prev = e->lru_prev; else if (c->lru_tail == e) c->lru_tail = e->lru_prev;
+  e->lru_prev = e->lru_next = NULL;
+}
+
+static void lru_push_head(gltf_image_cache* c, gltf_image_entry* e) {
+  e->lru_prev = NULL;
+  e->lru_next = c->lru_head;
+  if (c->lru_head) c->lru_head->lru_prev = e; else c->lru_tail = e;
+  c->lru_head = e;
+}
+
+static void table_unlink(gltf_image_cache* c, gltf_image_entry* e) {
+  for (gltf_image_entry** pp = bucket_of(c, e->key.hash); *pp; pp = &(*pp)->next) {
+    if (*pp == e) {
+      *pp = e->next;
+      e->next = NULL;
+      c->entry_count--;
+      return;
+    }
+  }
+}
+
+static void entry_destroy(gltf_image_entry* e) {
+  free(e->pixels.pixels);
+  free((void*)e->key.path);
+  free(e);
+}
+
+// Unlinks an entry from the table; it is freed now or by its last release().
+static void entry_remove(gltf_image_cache* c, gltf_image_entry* e) {
+  table_unlink(c, e);
+  c->bytes -= e->bytes;
+  if (e->refs == 0) {
+    lru_unlink(c, e);
+    entry_destroy(e);
+  } else {
+    e->detached = 1;
+  }
+}
+
+static void evict_over_budget(gltf_image_cache* c) {
+  while (c->budget != 0 && c->bytes > c->budget && c->lru_tail) {
+    c->stats.evictions++;
+    entry_remove(c, c->lru_tail);
+  }
+}
+
+#if GLTF_ENABLE_IMAGES
+// Doubles the bucket array at load factor 1 (silently keeps the old array on OOM).
+static void table_grow(gltf_image_cache* c) {
+  if (c->entry_count < c->bucket_count) return;
+  const uint32_t n = c->bucket_count * 2u;
+  gltf_image_entry** nb = (gltf_image_entry**)calloc(n, sizeof(nb[0]));
+  if (!nb) return;
+  for (uint32_t i = 0; i < c->bucket_count; i++) {
+    gltf_image_entry* e = c->buckets[i];
+    while (e) {
+      gltf_image_entry* next = e->next;
+      gltf_image_entry** b = &nb[(uint32_t)(e->key.hash ^ (e->key.hash >> 32)) & (n - 1u)];
+      e->next = *b;
+      *b = e;
+      e = next;
+    }
+  }
+  free(c->buckets);
+  c->buckets = nb;
+  c->bucket_count = n;
+}
+#endif
+
+
+// ----------------------------------------------------------------------------
+// Public API
+// ----------------------------------------------------------------------------
+
+
+gltf_result gltf_image_cache_create(uint64_t byte_budget,
+                                    gltf_image_cache** out_cache,
+                                    gltf_error* out_err) {
+  if (!out_cache) {
+    gltf_set_err(out_err, "invalid args", NULL, 0, 0);
+    return GLTF_ERR_INVALID;
+  }
+  *out_cache = NULL;
+
+  gltf_image_cache* c = (gltf_image_cache*)calloc(1, sizeof(*c));
+  if (c) {
+    c->bucket_count = 64u;
+    c->buckets = (gltf_image_entry**)calloc(c->bucket_count, sizeof(c->buckets[0]));
+  }
+  if (!c || !c->buckets) {
+    free(c);
+    gltf_set_err(out_err, "oom", NULL, 0, 0);
+    return GLTF_ERR_IO;
+  }
+  c->budget = byte_budget;
+  gltf_mutex_init(&c->lock);
+  gltf_cond_init(&c->loaded);
+
+  *out_cache = c;
+  return GLTF_OK;
+}
+
+void gltf_image_cache_free(gltf_image_cache* cache) {
+  if (!cache) return;
+  for (uint32_t i = 0; i < cache->bucket_count; i++) {
+    gltf_image_entry* e = cache->buckets[i];
+    while (e) {
+      gltf_image_entry* next = e->next;
+      entry_destroy(e);
+      e = next;
+    }
+  }
+  free(cache->buckets);
+  gltf_cond_destroy(&cache->loaded);
+  gltf_mutex_destroy(&cache->lock);
+  free(cache);
+}
+
+void gltf_image_cache_set_budget(gltf_image_cache* cache, uint64_t byte_budget) {
+  if (!cache) return;
+  gltf_mutex_lock(&cache->lock);
+  cache->budget = byte_budget;
+  evict_over_budget(cache);
+  gltf_mutex_unlock(&cache->lock);
+}
+
+void gltf_image_cache_get_stats(gltf_image_cache* cache, gltf_image_cache_stats* out_stats) {
+  if (!cache || !out_stats) return;
+  gltf_mutex_lock(&cache->lock);
+  *out_stats = cache->stats;
+  out_stats->entries = cache->entry_count;
+  out_stats->bytes = cache->bytes;
+  gltf_mutex_unlock(&cache->lock);
+}
+
+gltf_result gltf_image_cache_acquire_rgba8(gltf_image_cache* cache,
+                                           const gltf_doc* doc,
+                                           uint32_t image_index,
+                                           const gltf_image_pixels** out_pixels,
+                                           gltf_error* out_err) {
+  if (!cache || !doc || !out_pixels) {
+    gltf_set_err(out_err, "invalid args", NULL, 0, 0);
+    return GLTF_ERR_INVALID;
+  }
+  *out_pixels = NULL;
+  if (image_index >= doc->image_count) {
+    gltf_set_err(out_err, "image_index out of range", NULL, 0, 0);
+    return GLTF_ERR_RANGE;
+  }
+#if !GLTF_ENABLE_IMAGES
+  gltf_set_err(out_err, "images: not compiled in", NULL, 0, 0);
+  return GLTF_ERR_UNSUPPORTED;
+#else
+  gltf_image_key key;
+  gltf_blob blob = {0};
+  gltf_result r = image_key(doc, image_index, &key, &blob, out_err);
+  if (r != GLTF_OK) return r;
+
+  gltf_image_entry* e = NULL;
+  gltf_mutex_lock(&cache->lock);
+  for (;;) {
+    gltf_image_entry* stale = NULL;
+    e = NULL;
+    for (gltf_image_entry* it = *bucket_of(cache, key.hash); it; it = it->next) {
+      if (key_equal(&it->key, &key)) {
+        e = it;
+        break;
+      }
+      if (!stale && key_same_source(&it->key, &key)) stale = it;
+    }
+    if (e && e->loading) {
+      gltf_cond_wait(&cache->loaded, &cache->lock);
+      continue;  // the entry may have failed and been removed
+    }
+    // The file changed on disk: drop the old version unless it is loading.
+    if (!e && stale && !stale->loading) entry_remove(cache, stale);
+    break;
+  }
+
+  if (e) {
+    if (e->refs++ == 0) lru_unlink(cache, e);
+    cache->stats.hits++;
+    gltf_mutex_unlock(&cache->lock);
+    gltf_blob_free(&blob);
+    *out_pixels = &e->pixels;
+    return GLTF_OK;
+  }
+
+  // Miss: publish a pending entry, decode outside the lock.
+  e = (gltf_image_entry*)calloc(1, sizeof(*e));
+  char* path_copy = NULL;
+  if (e && key.path) {
+    const size_t len = strlen(key.path);
+    path_copy = (char*)malloc(len + 1u);
+    if (path_copy) memcpy(path_copy, key.path, len + 1u);
+  }
+  if (!e || (key.path && !path_copy)) {
+    gltf_mutex_unlock(&cache->lock);
+    free(e);
+    gltf_blob_free(&blob);
+    gltf_set_err(out_err, "oom", NULL, 0, 0);
+    return GLTF_ERR_IO;
+  }
+  e->key = key;
+  e->key.path = path_copy;
+  e->refs = 1;
+  e->loading = 1;
+  gltf_image_entry** b = bucket_of(cache, key.hash);
+  e->next = *b;
+  *b = e;
+  cache->entry_count++;
+  cache->stats.misses++;
+  table_grow(cache);
+  gltf_mutex_unlock(&cache->lock);
+
+  gltf_image_pixels pixels = {0};
+  if (!blob.data) r = gltf_image_load_bytes(doc, image_index, &blob, out_err);
+  if (r == GLTF_OK) r = gltf_image_decode_blob_rgba8(&blob, &pixels, out_err);
+  gltf_blob_free(&blob);
+
+  gltf_mutex_lock(&cache->lock);
+  e->loading = 0;
+  if (r != GLTF_OK) {
+    table_unlink(cache, e);
+    gltf_cond_broadcast(&cache->loaded);
+    gltf_mutex_unlock(&cache->lock);
+    entry_destroy(e);
+    return r;
+  }
+  e->pixels = pixels;
+  e->bytes = (size_t)pixels.stride_bytes * pixels.height;
+  cache->bytes += e->bytes;
+  evict_over_budget(cache);
+  gltf_cond_broadcast(&cache->loaded);
+  gltf_mutex_unlock(&cache->lock);
+
+  *out_pixels = &e->pixels;
+  return GLTF_OK;
+#endif
+}
+
+void gltf_image_cache_release(gltf_image_cache* cache, const gltf_image_pixels* pixels) {
+  if (!cache || !pixels) return;
+  gltf_image_entry* e = (gltf_image_entry*)(uintptr_t)pixels;
+
+  gltf_mutex_lock(&cache->lock);
+  if (--e->refs == 0) {
+    if (e->detached) {
+      entry_destroy(e);
+    } else {
+      lru_push_head(cache, e);
+      evict_over_budget(cache);
+    }
+  }
+  gltf_mutex_unlock(&cache->lock);
+}
@@ -0,0 +1,516 @@
+// Minimal educational glTF 2.0 loader (C11).
+//
+// Mip-chain generation for decoded RGBA8 images.
+//
+// Responsibilities:
+//   - lay out every level of a chain in one allocation (level 0 first)
+//   - downsample 2:1 per level with a box or Kaiser-windowed sinc filter
+//   - filter in linear light for sRGB images (alpha is always linear)
+//   - split each level into row bands through a gltf_dispatch_fn
+//   - tell sRGB images apart from data images using material texture slots
+//
+// Notes:
+//   - Filtering runs on float RGBA texels, one gltf_f32x4 per texel. Level 1
+//     is filtered straight from RGBA8 level 0 and every later level from the
+//     float copy of the previous one, so quantization error does not
+//     accumulate down the chain and no float copy of level 0 is made.
+//   - Results do not depend on the dispatcher or the thread count.
+//
+// Public API contracts are documented in include/gltf/gltf.h.
+
+
+#include "gltf_internal.h"
+#include "gltf_simd.h"
+
+#include <math.h>
+
+
+// ----------------------------------------------------------------------------
+// Layout / transfer tables
+// ----------------------------------------------------------------------------
+
+// Resolution of the linear -> sRGB encode table.
+#define GLTF_MIP_ENC_SIZE 4096u
+
+// Texels per dispatched task (rows are never split).
+#define GLTF_MIP_TASK_TEXELS 16384u
+
+// Kaiser filter: 6 taps at source offsets -2.5 .. +2.5 around each output
+// texel center, alpha 4, support radius 1.5 output texels.
+#define GLTF_MIP_KAISER_TAPS 6
+
+// Kaiser: most tasks a level is split into (each owns a ring of filtered rows).
+#define GLTF_MIP_KAISER_TASKS 64u
+
+static uint32_t mip_level_count(uint32_t w, uint32_t h) {
+  uint32_t n = 1;
+  while (w > 1u || h > 1u) {
+    w = w > 1u ? w / 2u : 1u;
+    h = h > 1u ? h / 2u : 1u;
+    n++;
+  }
+  return n;
+}
+
+// Fills out->levels and out->size for a w x h RGBA8 chain (data untouched).
+static int mip_layout(uint32_t w, uint32_t h, gltf_mip_chain* out) {
+  size_t off = 0;
+  if (w > UINT32_MAX / 4u) return 0;
+  out->level_count = mip_level_count(w, h);
+  for (uint32_t l = 0; l < out->level_count; l++) {
+    gltf_mip_level* lv = &out->levels[l];
+    lv->width = w;
+    lv->height = h;
+    lv->stride_bytes = w * 4u;
+    lv->offset = off;
+    const size_t bytes = (size_t)lv->stride_bytes * h;
+    if (bytes / h != lv->stride_bytes || off > SIZE_MAX - bytes) return 0;
+    off += bytes;
+    w = w > 1u ? w / 2u : 1u;
+    h = h > 1u ? h / 2u : 1u;
+  }
+  out->size = off;
+  return 1;
+}
+
+static float srgb_to_linear(float c) {
+  return c <= 0.04045f ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+}
+
+static float linear_to_srgb(float c) {
+  return c <= 0.0031308f ? c * 12.92f : 1.055f * powf(c, 1.0f / 2.4f) - 0.055f;
+}
+
+static double bessel_i0(double x) {
+  double sum = 1.0, term = 1.0;
+  for (int k = 1; k < 32; k++) {
+    const double q = x / (2.0 * k);
+    term *= q * q;
+    sum += term;
+  }
+  return sum;
+}
+
+static void kaiser_weights(float w[GLTF_MIP_KAISER_TAPS]) {
+  const double pi = 3.14159265358979323846;
+  const double alpha = 4.0, radius = 1.5;
+  double wd[GLTF_MIP_KAISER_TAPS], sum = 0.0;
+  for (int k = 0; k < GLTF_MIP_KAISER_TAPS; k++) {
+    const double t = ((double)k - 2.5) * 0.5; // distance in output texels
+    const double sinc = sin(pi * t) / (pi * t);
+    const double r = t / radius;
+    wd[k] = sinc * bessel_i0(alpha * sqrt(1.0 - r * r)) / bessel_i0(alpha);
+    sum += wd[k];
+  }
+  for (int k = 0; k < GLTF_MIP_KAISER_TAPS; k++) w[k] = (float)(wd[k] / sum);
+}
+
+
+// ----------------------------------------------------------------------------
+// Row kernels
+// ----------------------------------------------------------------------------
+
+typedef struct mip_job mip_job;
+typedef void (*mip_band_fn)(const mip_job* j, uint32_t y0, uint32_t y1, float* scratch);
+
+struct mip_job {
+  const uint8_t* src;      // level 0 input (may alias the chain's level 0)
+  uint32_t src_stride;
+  gltf_mip_chain* chain;
+  int srgb;
+  float kaiser[GLTF_MIP_KAISER_TAPS];
+
+  float* fsrc;             // float texels of the level being read (NULL: RGBA8 level 0)
+  float* fdst;             // float texels of the level being written
+  float* ftask;            // Kaiser: per-task scratch, ftask_floats each
+  size_t ftask_floats;
+  uint32_t level;          // level being written (0 = copy pass)
+  uint32_t sw, sh, dw, dh; // source / destination dimensions of the pass
+
+  mip_band_fn band;
+  uint32_t rows;           // rows covered by the current pass
+  uint32_t band_rows;      // rows per task
+
+  float dec[256];          // u8 -> linear
+  uint8_t enc[GLTF_MIP_ENC_SIZE]; // linear -> u8 (sRGB encoded)
+};
+
+static void mip_task(void* user, uint32_t task_index) {
+  const mip_job* j = (const mip_job*)user;
+  const uint32_t y0 = task_index * j->band_rows;
+  const uint32_t y1 = (j->rows - y0 < j->band_rows) ? j->rows : y0 + j->band_rows;
+  float* scratch = j->ftask ? j->ftask + (size_t)task_index * j->ftask_floats : NULL;
+  j->band(j, y0, y1, scratch);
+}
+
+// Splits rows into at most max_tasks bands and runs them.
+static void mip_run(mip_job* j, mip_band_fn band, uint32_t rows, uint32_t row_texels, uint32_t max_tasks,
+                    gltf_dispatch_fn dispatch, void* dispatch_user) {
+  j->band = band;
+  j->rows = rows;
+  j->band_rows = row_texels >= GLTF_MIP_TASK_TEXELS ? 1u : GLTF_MIP_TASK_TEXELS / row_texels;
+  uint32_t tasks = (rows + j->band_rows - 1u) / j->band_rows;
+  if (tasks > max_tasks) {
+    j->band_rows = (rows + max_tasks - 1u) / max_tasks;
+    tasks = (rows + j->band_rows - 1u) / j->band_rows;
+  }
+  if (!dispatch || tasks < 2u) {
+    j->band_rows = rows;
+    mip_task(j, 0);
+    return;
+  }
+  dispatch(dispatch_user, tasks, mip_task, j);
+}
+
+static uint8_t quantize_unorm(float v) {
+  v = v < 0.0f ? 0.0f : v > 1.0f ? 1.0f : v;
+  return (uint8_t)(v * 255.0f + 0.5f);
+}
+
+// Writes one row of float texels to the current level of the chain.
+static void store_row(const mip_job* j, const float* texels, uint32_t y) {
+  const gltf_mip_level* lv = &j->chain->levels[j->level];
+  uint8_t* dst = j->chain->data + lv->offset + (size_t)y * lv->stride_bytes;
+  for (uint32_t x = 0; x < lv->width; x++) {
+    const float* t = texels + (size_t)x * 4u;
+    for (int c = 0; c < 3; c++) {
+      if (j->srgb) {
+        float v = t[c] < 0.0f ? 0.0f : t[c] > 1.0f ? 1.0f : t[c];
+        dst[x * 4u + (uint32_t)c] = j->enc[(uint32_t)(v * (float)(GLTF_MIP_ENC_SIZE - 1u) + 0.5f)];
+      } else {
+        dst[x * 4u + (uint32_t)c] = quantize_unorm(t[c]);
+      }
+    }
+    dst[x * 4u + 3u] = quantize_unorm(t[3]);
+  }
+}
+
+static const uint8_t* level0_row(const mip_job* j, uint32_t y) {
+  return j->chain->data + (size_t)y * j->chain->levels[0].stride_bytes;
+}
+
+// Expands n RGBA8 texels to float (linear light for sRGB color channels).
+static void expand_texels(const mip_job* j, const uint8_t* s, uint32_t n, float* f) {
+  for (uint32_t x = 0; x < n; x++) {
+    for (int c = 0; c < 3; c++) {
+      f[x * 4u + (uint32_t)c] = j->srgb ? j->dec[s[x * 4u + (uint32_t)c]] : (float)s[x * 4u + (uint32_t)c] / 255.0f;
+    }
+    f[x * 4u + 3u] = (float)s[x * 4u + 3u] / 255.0f;
+  }
+}
+
+static gltf_f32x4 load_texel_u8(const mip_job* j, const uint8_t* s) {
+  float f[4];
+  expand_texels(j, s, 1u, f);
+  return gltf_f32x4_load(f);
+}
+
+// Level 0: copy the input rows into the chain.
+static void band_copy(const mip_job* j, uint32_t y0, uint32_t y1, float* scratch) {
+  (void)scratch;
+  const gltf_mip_level* lv = &j->chain->levels[0];
+  for (uint32_t y = y0; y < y1; y++) {
+    const uint8_t* s = j->src + (size_t)y * j->src_stride;
+    uint8_t* d = j->chain->data + (size_t)y * lv->stride_bytes;
+    if (s != d) memcpy(d, s, lv->stride_bytes);
+  }
+}
+
+// Box: average of the 2x2 footprint (clamped at odd edges).
+static void band_box(const mip_job* j, uint32_t y0, uint32_t y1, float* scratch) {
+  (void)scratch;
+  const gltf_f32x4 quarter = gltf_f32x4_set1(0.25f);
+  for (uint32_t y = y0; y < y1; y++) {
+    const uint32_t sy0 = 2u * y, sy1 = (2u * y + 1u < j->sh) ? 2u * y + 1u : j->sh - 1u;
+    float* out = j->fdst + (size_t)y * j->dw * 4u;
+
+    for (uint32_t x = 0; x < j->dw; x++) {
+      const uint32_t x0 = 2u * x, x1 = (2u * x + 1u < j->sw) ? 2u * x + 1u : j->sw - 1u;
+      gltf_f32x4 a, b;
+      if (j->fsrc) {
+        const float* r0 = j->fsrc + (size_t)sy0 * j->sw * 4u;
+        const float* r1 = j->fsrc + (size_t)sy1 * j->sw * 4u;
+        a = gltf_f32x4_add(gltf_f32x4_load(r0 + x0 * 4u), gltf_f32x4_load(r0 + x1 * 4u));
+        b = gltf_f32x4_add(gltf_f32x4_load(r1 + x0 * 4u), gltf_f32x4_load(r1 + x1 * 4u));
+      } else {
+        // Level 1: each level 0 texel is read once, so convert it here.
+        const uint8_t* r0 = level0_row(j, sy0);
+        const uint8_t* r1 = level0_row(j, sy1);
+        a = gltf_f32x4_add(load_texel_u8(j, r0 + x0 * 4u), load_texel_u8(j, r0 + x1 * 4u));
+        b = gltf_f32x4_add(load_texel_u8(j, r1 + x0 * 4u), load_texel_u8(j, r1 + x1 * 4u));
+      }
+      gltf_f32x4_store(out + x * 4u, gltf_f32x4_mul(gltf_f32x4_add(a, b), quarter));
+    }
+    store_row(j, out, y);
+  }
+}
+
+static uint32_t clamp_tap(int64_t i, uint32_t n) {
+  return i < 0 ? 0u : i >= (int64_t)n ? n - 1u : (uint32_t)i;
+}
+
+// Kaiser, horizontal pass: source row y -> out (dst_w texels). line holds
+// the float copy of an RGBA8 level 0 row.
+static void kaiser_h(const mip_job* j, uint32_t y, float* line, float* out) {
+  const float* in = line;
+  if (j->fsrc) {
+    in = j->fsrc + (size_t)y * j->sw * 4u;
+  } else {
+    expand_texels(j, level0_row(j, y), j->sw, line);
+  }
+  gltf_f32x4 w[GLTF_MIP_KAISER_TAPS];
+  for (int k = 0; k < GLTF_MIP_KAISER_TAPS; k++) w[k] = gltf_f32x4_set1(j->kaiser[k]);
+
+  for (uint32_t x = 0; x < j->dw; x++) {
+    gltf_f32x4 acc = gltf_f32x4_set1(0.0f);
+    for (int k = 0; k < GLTF_MIP_KAISER_TAPS; k++) {
+      const uint32_t sx = clamp_tap((int64_t)2 * x - 2 + k, j->sw);
+      acc = gltf_f32x4_add(acc, gltf_f32x4_mul(gltf_f32x4_load(in + sx * 4u), w[k]));
+    }
+    gltf_f32x4_store(out + x * 4u, acc);
+  }
+}
+
+// Kaiser: destination rows y0..y1. scratch is a ring of GLTF_MIP_KAISER_TAPS
+// horizontally filtered rows (source row r in slot r % taps) followed by one
+// source row; consecutive output rows share 4 of their 6 filtered rows.
+static void band_kaiser(const mip_job* j, uint32_t y0, uint32_t y1, float* scratch) {
+  const size_t row_floats = (size_t)j->dw * 4u;
+  float* line = scratch + GLTF_MIP_KAISER_TAPS * row_floats;
+  gltf_f32x4 w[GLTF_MIP_KAISER_TAPS];
+  for (int k = 0; k < GLTF_MIP_KAISER_TAPS; k++) w[k] = gltf_f32x4_set1(j->kaiser[k]);
+
+  int64_t next = (int64_t)2 * y0 - 2; // first source row not filtered yet
+  for (uint32_t y = y0; y < y1; y++) {
+    const int64_t lo = (int64_t)2 * y - 2;
+    for (; next < lo + GLTF_MIP_KAISER_TAPS; next++) {
+      float* slot = scratch + (size_t)((next + GLTF_MIP_KAISER_TAPS) % GLTF_MIP_KAISER_TAPS) * row_floats;
+      kaiser_h(j, clamp_tap(next, j->sh), line, slot);
+    }
+
+    const float* rows[GLTF_MIP_KAISER_TAPS];
+    for (int k = 0; k < GLTF_MIP_KAISER_TAPS; k++) {
+      rows[k] = scratch + (size_t)((lo + k + GLTF_MIP_KAISER_TAPS) % GLTF_MIP_KAISER_TAPS) * row_floats;
+    }
+    float* out = j->fdst + (size_t)y * j->dw * 4u;
+    for (uint32_t x = 0; x < j->dw; x++) {
+      gltf_f32x4 acc = gltf_f32x4_set1(0.0f);
+      for (int k = 0; k < GLTF_MIP_KAISER_TAPS; k++) {
+        acc = gltf_f32x4_add(acc, gltf_f32x4_mul(gltf_f32x4_load(rows[k] + x * 4u), w[k]));
+      }
+      gltf_f32x4_store(out + x * 4u, acc);
+    }
+    store_row(j, out, y);
+  }
+}
+
+
+// ----------------------------------------------------------------------------
+// Chain builder
+// ----------------------------------------------------------------------------
+
+static size_t mip_level_floats(const gltf_mip_chain* chain, uint32_t l) {
+  if (l >= chain->level_count) return 0u;
+  return (size_t)chain->levels[l].width * chain->levels[l].height * 4u;
+}
+
+// Fills every level of a chain whose layout and data are already allocated.
+// src may point at the chain's own level 0.
+//
+// Float scratch holds levels 1 and 2 (odd and even levels below reuse them)
+// plus, for Kaiser, a few filtered rows per task: about the size of the
+// RGBA8 chain, never a float copy of level 0.
+static gltf_result mip_build(gltf_mip_chain* chain,
+                             const uint8_t* src,
+                             uint32_t src_stride,
+                             gltf_mip_filter filter,
+                             int srgb,
+                             gltf_dispatch_fn dispatch,
+                             void* dispatch_user,
+                             gltf_error* out_err) {
+  const uint32_t w = chain->levels[0].width, h = chain->levels[0].height;
+  const size_t n1 = mip_level_floats(chain, 1u);
+  const size_t n2 = mip_level_floats(chain, 2u);
+  uint32_t ktasks = 0;
+  size_t ktask_floats = 0;
+  if (filter == GLTF_MIP_KAISER && chain->level_count > 1u) {
+    const uint32_t h1 = chain->levels[1].height;
+    ktasks = !dispatch ? 1u : h1 < GLTF_MIP_KAISER_TASKS ? h1 : GLTF_MIP_KAISER_TASKS;
+    ktask_floats = ((size_t)GLTF_MIP_KAISER_TAPS * chain->levels[1].width + w) * 4u;
+  }
+  const uint64_t floats = (uint64_t)n1 + n2 + (uint64_t)ktasks * ktask_floats;
+
+  mip_job* j = (mip_job*)calloc(1, sizeof(*j));
+  float* scratch = NULL;
+  if (j && floats > 0u && floats <= SIZE_MAX / sizeof(float)) {
+    scratch = (float*)malloc((size_t)floats * sizeof(float));
+  }
+  if (!j || (floats > 0u && !scratch)) {
+    free(j);
+    gltf_set_err(out_err, "oom", NULL, 0, 0);
+    return GLTF_ERR_IO;
+  }
+
+  j->src = src;
+  j->src_stride = src_stride;
+  j->chain = chain;
+  j->srgb = srgb;
+  kaiser_weights(j->kaiser);
+  if (srgb) {
+    for (uint32_t i = 0; i < 256u; i++) j->dec[i] = srgb_to_linear((float)i / 255.0f);
+    for (uint32_t i = 0; i < GLTF_MIP_ENC_SIZE; i++) {
+      j->enc[i] = quantize_unorm(linear_to_srgb((float)i / (float)(GLTF_MIP_ENC_SIZE - 1u)));
+    }
+  }
+
+  float* fa = scratch;                          // odd levels
+  float* fb = scratch ? scratch + n1 : NULL;    // even levels
+  j->ftask = ktasks ? scratch + n1 + n2 : NULL;
+  j->ftask_floats = ktask_floats;
+
+  j->level = 0;
+  mip_run(j, band_copy, h, w, UINT32_MAX, dispatch, dispatch_user);
+
+  // Level 1 is read from RGBA8 level 0; each later level from the float
+  // buffer that holds the previous one.
+  for (uint32_t l = 1; l < chain->level_count; l++) {
+    j->level = l;
+    j->fsrc = l == 1u ? NULL : (l & 1u) ? fb : fa;
+    j->fdst = (l & 1u) ? fa : fb;
+    j->sw = chain->levels[l - 1u].width;
+    j->sh = chain->levels[l - 1u].height;
+    j->dw = chain->levels[l].width;
+    j->dh = chain->levels[l].height;
+    if (filter == GLTF_MIP_KAISER) {
+      mip_run(j, band_kaiser, j->dh, j->dw * GLTF_MIP_KAISER_TAPS * 3u, ktasks, dispatch, dispatch_user);
+    } else {
+      mip_run(j, band_box, j->dh, j->dw * 4u, UINT32_MAX, dispatch, dispatch_user);
+    }
+  }
+
+  free(scratch);
+  free(j);
+  return GLTF_OK;
+}
+
+static gltf_result mip_chain_alloc(uint32_t w, uint32_t h, gltf_mip_chain* out, gltf_error* out_err) {
+  memset(out, 0, sizeof(*out));
+  if (!mip_layout(w, h, out)) {
+    gltf_set_err(out_err, "image too large", NULL, 0, 0);
+    return GLTF_ERR_IO;
+  }
+  out->data = (uint8_t*)malloc(out->size);
+  if (!out->data) {
+    gltf_set_err(out_err, "oom", NULL, 0, 0);
+    return GLTF_ERR_IO;
+  }
+  return GLTF_OK;
+}
+
+
+// ----------------------------------------------------------------------------
+// Public API
+// ----------------------------------------------------------------------------
+
+
+int gltf_image_is_srgb(const gltf_doc* doc, uint32_t image_index) {
+  if (!doc || image_index >= doc->image_count) return 0;
+  for (uint32_t m = 0; m < doc->material_count; m++) {
+    const gltf_material* mat = &doc->materials[m];
+    const int32_t slots[2] = { mat->pbr.base_color_texture.index, mat->emissive_texture.index };
+    for (int s = 0; s < 2; s++) {
+      if (slots[s] < 0 || (uint32_t)slots[s] >= doc->texture_count) continue;
+      if (doc->textures[slots[s]].source == (int32_t)image_index) return 1;
+    }
+  }
+  return 0;
+}
+
+gltf_result gltf_image_build_mips_rgba8(const uint8_t* rgba,
+                                        uint32_t width,
+                                        uint32_t height,
+                                        uint32_t stride_bytes,
+                                        gltf_mip_filter filter,
+                                        uint32_t flags,
+                                        gltf_dispatch_fn dispatch,
+                                        void* dispatch_user,
+                                        gltf_mip_chain* out_chain,
+                                        gltf_error* out_err) {
+  if (!rgba || !out_chain || width == 0 || height == 0 || width > UINT32_MAX / 4u ||
+      (filter != GLTF_MIP_BOX && filter != GLTF_MIP_KAISER) || (flags & ~(uint32_t)GLTF_MIP_SRGB) != 0) {
+    gltf_set_err(out_err, "invalid args", NULL, 0, 0);
+    return GLTF_ERR_INVALID;
+  }
+  if (stride_bytes == 0) stride_bytes = width * 4u;
+  if (stride_bytes < width * 4u) {
+    gltf_set_err(out_err, "stride_bytes shorter than a row", NULL, 0, 0);
+    return GLTF_ERR_INVALID;
+  }
+
+  gltf_mip_chain chain;
+  gltf_result r = mip_chain_alloc(width, height, &chain, out_err);
+  if (r == GLTF_OK) {
+    r = mip_build(&chain, rgba, stride_bytes, filter, (flags & GLTF_MIP_SRGB) != 0, dispatch,
+                  dispatch_user, out_err);
+  }
+  if (r != GLTF_OK) {
+    free(chain.data);
+    return r;
+  }
+  *out_chain = chain;
+  return GLTF_OK;
+}
+
+gltf_result gltf_image_decode_mips_rgba8(const gltf_doc* doc,
+                                         uint32_t image_index,
+                                         gltf_mip_filter filter,
+                                         uint32_t flags,
+                                         gltf_dispatch_fn dispatch,
+                                         void* dispatch_user,
+                                         gltf_mip_chain* out_chain,
+                                         gltf_error* out_err) {
+  if (!doc || !out_chain || (filter != GLTF_MIP_BOX && filter != GLTF_MIP_KAISER) ||
+      (flags & ~(uint32_t)(GLTF_MIP_SRGB | GLTF_MIP_SRGB_FROM_MATERIALS)) != 0) {
+    gltf_set_err(out_err, "invalid args", NULL, 0, 0);
+    return GLTF_ERR_INVALID;
+  }
+
+  // Decode once, grow the decoded image into the chain (level 0 sits at
+  // offset 0), then filter in place.
+  gltf_image_pixels pixels = {0};
+  gltf_result r = gltf_image_decode_rgba8(doc, image_index, &pixels, out_err);
+  if (r != GLTF_OK) return r;
+
+  gltf_mip_chain chain;
+  memset(&chain, 0, sizeof(chain));
+  if (!mip_layout(pixels.width, pixels.height, &chain)) {
+    gltf_image_pixels_free(&pixels);
+    gltf_set_err(out_err, "image too large", NULL, 0, 0);
+    return GLTF_ERR_IO;
+  }
+  chain.data = (uint8_t*)realloc(pixels.pixels, chain.size);
+  if (!chain.data) {
+    gltf_image_pixels_free(&pixels);
+    gltf_set_err(out_err, "oom", NULL, 0, 0);
+    return GLTF_ERR_IO;
+  }
+
+  const int srgb = (flags & GLTF_MIP_SRGB) != 0 ||
+                   ((flags & GLTF_MIP_SRGB_FROM_MATERIALS) != 0 && gltf_image_is_srgb(doc, image_index));
+  r = mip_build(&chain, chain.data, chain.levels[0].stride_bytes, filter, srgb, dispatch,
+                dispatch_user, out_err);
+  if (r != GLTF_OK) {
+    free(chain.data);
+    return r;
+  }
+  *out_chain = chain;
+  return GLTF_OK;
+}
+
+void gltf_mip_chain_free(gltf_mip_chain* chain) {
+  if (!chain) return;
+  free(chain->data);
+  chain->data = NULL;
+  chain->size = 0;
+  chain->level_count = 0;
+}
@@ -6,17 +6,25 @@
 // Responsibilities:
 //   - resolve image sources (URI, data URI, bufferView)
 //   - decode PNG/JPEG bytes into RGBA8 via stb_image
+//   - probe image headers and decode into caller buffers (1-4 channels, pitch)
+//   - batch decoding through a gltf_dispatch_fn (one task per image)
 //   - write RGBA8 buffers to PNG via stb_image_write
 //
 // Notes:
 //   - Public API contracts live in include/gltf/gltf.h.
 //   - Image decoding is optional and controlled by GLTF_ENABLE_IMAGES.
 //   - Error paths are passed in by the caller to keep messages consistent.
+//   - Data URI images are base64-decoded once per document (doc.image_bytes).
 
 
 #include "gltf_internal.h"
 
 #if GLTF_ENABLE_IMAGES
+  // Decoded images come from plain malloc, so they are handed out as is
+  // (gltf_image_pixels_free() / realloc() into a mip chain).
+  #define STBI_MALLOC(sz) malloc(sz)
+  #define STBI_REALLOC(p, newsz) realloc(p, newsz)
+  #define STBI_FREE(p) free(p)
   #define STB_IMAGE_IMPLEMENTATION
   #define STB_IMAGE_WRITE_IMPLEMENTATION
   #include "stb_image.h"
@@ -24,18 +32,6 @@
 #endif
 
 
-// Temporary byte buffer used while resolving image sources.
-//
-// Ownership:
-//   - owned = 1 => data is heap-allocated and must be freed by gltf_blob_free()
-//   - owned = 0 => data points into doc-owned memory (must not be freed)
-typedef struct gltf_blob {
-  const uint8_t* data;
-  size_t size;
-  int owned;
-} gltf_blob;
-
-
 // ----------------------------------------------------------------------------
 // Internal helpers (base64)
 // ----------------------------------------------------------------------------
@@ -61,13 +57,23 @@ typedef enum gltf_fs_status {
   GLTF_FS_IO,
   GLTF_FS_OOM,
   GLTF_FS_SIZE_MISMATCH,
-  GLTF_FS_TOO_LARGE
+  GLTF_FS_TOO_LARGE,
+  GLTF_FS_BAD_ARGUMENT
 } gltf_fs_status;
 
-gltf_fs_status gltf_fs_read_file_exact_u32(const char* path,
-                                           uint32_t expected_len,
-                                           uint8_t** out_data,
-                                           uint32_t* out_len);
+gltf_fs_status gltf_fs_read_file_exact_u32_io(const gltf_io* io,
+                                              const char* path,
+                                              uint32_t expected_len,
+                                              uint8_t** out_data,
+                                              uint32_t* out_len);
+
+gltf_fs_status gltf_fs_map_file_io(const gltf_io* io,
+                                   const char* path,
+                                   uint32_t expected_len,
+                                   const uint8_t** out_data,
+                                   size_t* out_size);
+
+void gltf_fs_unmap_io(const gltf_io* io, const uint8_t* data, size_t size);
 
 
 // ----------------------------------------------------------------------------
@@ -84,7 +90,7 @@ static int mul_size_t(size_t a, size_t b, size_t* out) {
 
 // Extracts the base64 payload pointer from a data URI.
 // Returns NULL if the URI is not a base64 data URI.
-static const char* gltf_data_uri_base64_payload(const char* uri) {
+const char* gltf_data_uri_base64_payload(const char* uri) {
   // Expected: data:<mime>;base64,<payload>
   // We only need the part after ";base64,".
   if (!uri) return NULL;
@@ -97,13 +103,59 @@ static const char* gltf_data_uri_base64_payload(const char* uri) {
   return marker + 8; // strlen(";base64,") == 8
 }
 
+// Decodes the base64 payload of a data-URI image into a new block.
+static gltf_result decode_data_uri_image(const gltf_image* img,
+                                         uint8_t** out_data,
+                                         size_t* out_size,
+                                         gltf_error* out_err) {
+  if (!img->uri) {
+    gltf_set_err(out_err, "data uri missing", NULL, 0, 0);
+    return GLTF_ERR_PARSE;
+  }
+
+  const char* payload = gltf_data_uri_base64_payload(img->uri);
+  if (!payload) {
+    gltf_set_err(out_err, "invalid data uri (expected ;base64,)", NULL, 0, 0);
+    return GLTF_ERR_PARSE;
+  }
+
+  const size_t payload_len = strlen(payload);
+
+  size_t cap = gltf_base64_max_decoded_size(payload_len);
+  if (cap == SIZE_MAX) {
+    gltf_set_err(out_err, "data uri payload too large", NULL, 0, 0);
+    return GLTF_ERR_PARSE;
+  }
+
+  uint8_t* decoded = NULL;
+  if (cap > 0) {
+    decoded = (uint8_t*)malloc(cap);
+    if (!decoded) {
+      gltf_set_err(out_err, "out of memory allocating decoded image", NULL, 0, 0);
+      return GLTF_ERR_IO;
+    }
+  }
+
+  size_t decoded_size = 0;
+  int ok = gltf_base64_decode(payload, payload_len, decoded, cap, &decoded_size);
+  if (!ok) {
+    free(decoded);
+    gltf_set_err(out_err, "base64 decode failed", NULL, 0, 0);
+    return GLTF_ERR_PARSE;
+  }
+
+  *out_data = decoded;
+  *out_size = decoded_size;
+  return GLTF_OK;
+}
+
 // Resolves an image reference into compressed bytes (PNG/JPEG/etc.).
 // On success, fills out_blob with bytes and ownership flag.
 // On failure, out_blob is not modified.
-static gltf_result gltf_image_load_bytes(const gltf_doc* doc,
-                                          uint32_t image_index,
-                                          gltf_blob* out_blob,
-                                          gltf_error* out_err) {
+gltf_result gltf_image_load_bytes(const gltf_doc* doc,
+                                  uint32_t image_index,
+                                  gltf_blob* out_blob,
+                                  gltf_error* out_err) {
   if (!doc || !out_blob) {
     gltf_set_err(out_err, "invalid args", NULL, 0, 0);
     return GLTF_ERR_INVALID;
@@ -126,10 +178,23 @@ static gltf_result gltf_image_load_bytes(const gltf_doc* doc,
         return GLTF_ERR_PARSE;
       }
 
+      // Served in place when the document's io can map files.
+      const gltf_io* io = gltf_doc_io(doc);
+      if (io && io->map) {
+        const uint8_t* mapped = NULL;
+        size_t mapped_size = 0;
+        if (gltf_fs_map_file_io(io, path, 0, &mapped, &mapped_size) == GLTF_FS_OK) {
+          b.data = mapped;
+          b.size = mapped_size;
+          b.io = io;
+          break;
+        }
+      }
+
       uint8_t* data = NULL;
       uint32_t size_u32 = 0;
 
-      gltf_fs_status fs = gltf_fs_read_file_exact_u32(path, 0, &data, &size_u32);
+      gltf_fs_status fs = gltf_fs_read_file_exact_u32_io(io, path, 0, &data, &size_u32);
       if (fs != GLTF_FS_OK) {
         switch (fs) {
           case GLTF_FS_INVALID:
@@ -156,45 +221,22 @@ static gltf_result gltf_image_load_bytes(const gltf_doc* doc,
     }
 
     case GLTF_IMAGE_DATA_URI: {
-      if (!img->uri) {
-        gltf_set_err(out_err, "data uri missing", NULL, 0, 0);
-        return GLTF_ERR_PARSE;
-      }
-
-      const char* payload = gltf_data_uri_base64_payload(img->uri);
-      if (!payload) {
-        gltf_set_err(out_err, "invalid data uri (expected ;base64,)", NULL, 0, 0);
-        return GLTF_ERR_PARSE;
-      }
-
-      const size_t payload_len = strlen(payload);
-
-      size_t cap = gltf_base64_max_decoded_size(payload_len);
-      if (cap == SIZE_MAX) {
-        gltf_set_err(out_err, "data uri payload too large", NULL, 0, 0);
-        return GLTF_ERR_PARSE;
-      }
-
-      uint8_t* decoded = NULL;
-      if (cap > 0) {
-        decoded = (uint8_t*)malloc(cap);
-        if (!decoded) {
-          gltf_set_err(out_err, "out of memory allocating decoded image", NULL, 0, 0);
-          return GLTF_ERR_IO;
+      // Decoded once per document; later calls share the bytes.
+      gltf_image_bytes* ib = &((gltf_doc*)(uintptr_t)doc)->image_bytes[image_index];
+      if (!gltf_atomic_load_acquire_u32(&ib->ready)) {
+        gltf_mutex_lock((gltf_mutex*)(uintptr_t)&doc->lock);
+        gltf_result r = GLTF_OK;
+        if (!ib->ready) {
+          r = decode_data_uri_image(img, &ib->data, &ib->size, out_err);
+          if (r == GLTF_OK) gltf_atomic_store_release_u32(&ib->ready, 1u);
         }
+        gltf_mutex_unlock((gltf_mutex*)(uintptr_t)&doc->lock);
+        if (r != GLTF_OK) return r;
       }
 
-      size_t decoded_size = 0;
-      int ok = gltf_base64_decode(payload, payload_len, decoded, cap, &decoded_size);
-      if (!ok) {
-        free(decoded);
-        gltf_set_err(out_err, "base64 decode failed", NULL, 0, 0);
-        return GLTF_ERR_PARSE;
-      }
-
-      b.data = decoded;
-      b.size = decoded_size;
-      b.owned = 1;
+      b.data = ib->data;
+      b.size = ib->size;
+      b.owned = 0;
       break;
     }
 
@@ -217,11 +259,20 @@ static gltf_result gltf_image_load_bytes(const gltf_doc* doc,
         return GLTF_ERR_RANGE;
       }
 
+      gltf_result lr = gltf_buffer_ensure_resident(doc, bv->buffer, out_err);
+      if (lr != GLTF_OK) {
+        return lr;
+      }
+
       const gltf_buffer* buf = &doc->buffers[bv->buffer];
       if (!buf->data) {
         gltf_set_err(out_err, "buffer data not loaded", NULL, 0, 0);
         return GLTF_ERR_PARSE;
       }
+      if ((uint64_t)bv->byte_offset + (uint64_t)bv->byte_length > (uint64_t)buf->byte_length) {
+        gltf_set_err(out_err, "image bufferView out of buffer bounds", NULL, 0, 0);
+        return GLTF_ERR_RANGE;
+      }
 
       b.data = (const uint8_t*)buf->data + (size_t)bv->byte_offset;
       b.size = (size_t)bv->byte_length;
@@ -240,14 +291,17 @@ static gltf_result gltf_image_load_bytes(const gltf_doc* doc,
 }
 
 // Releases a blob if it owns its memory and clears the fields.
-static void gltf_blob_free(gltf_blob* b) {
+void gltf_blob_free(gltf_blob* b) {
   if (!b) return;
-  if (b->owned && b->data) {
+  if (b->io) {
+    gltf_fs_unmap_io(b->io, b->data, b->size);
+  } else if (b->owned && b->data) {
     free((void*)b->data);
   }
   b->data = NULL;
   b->size = 0;
   b->owned = 0;
+  b->io = NULL;
 }
 
 
@@ -296,15 +350,36 @@ gltf_result gltf_image_decode_rgba8(const gltf_doc* doc,
     return r;
   }
 
-  // decode to RGBA8 using stb_image
+  r = gltf_image_decode_blob_rgba8(&blob, out_pixels, out_err);
+  gltf_blob_free(&blob);
+  return r;
+#else
+  (void)doc;
+  (void)image_index;
+  (void)out_pixels;
+  gltf_set_err(out_err, "images: not compiled in", NULL, 0, 0);
+  return GLTF_ERR_UNSUPPORTED;
+#endif
+}
+
+// Decodes compressed bytes to RGBA8 using stb_image.
+// On failure, out_pixels is not modified.
+gltf_result gltf_image_decode_blob_rgba8(const gltf_blob* blob,
+                                         gltf_image_pixels* out_pixels,
+                                         gltf_error* out_err) {
+#if GLTF_ENABLE_IMAGES
+  if (blob->size > (size_t)INT32_MAX) {
+    gltf_set_err(out_err, "image too large", NULL, 0, 0);
+    return GLTF_ERR_IO;
+  }
+
   int w = 0, h = 0, comp = 0;
   unsigned char* tmp = stbi_load_from_memory(
-      (const unsigned char*)blob.data,
-      (int)blob.size,
+      (const unsigned char*)blob->data,
+      (int)blob->size,
       &w, &h, &comp,
       4 // force RGBA
   );
-  gltf_blob_free(&blob);
 
   if (!tmp || w <= 0 || h <= 0) {
     gltf_set_err(out_err, "image decode failed", NULL, 0, 0);
@@ -312,7 +387,6 @@ gltf_result gltf_image_decode_rgba8(const gltf_doc* doc,
     return GLTF_ERR_PARSE;
   }
 
-  // allocate output buffer (caller-owned via free)
   size_t bytes = 0, wh = 0;
   if (!mul_size_t((size_t)w, (size_t)h, &wh) || !mul_size_t(wh, 4u, &bytes)) {
     stbi_image_free(tmp);
@@ -320,35 +394,224 @@ gltf_result gltf_image_decode_rgba8(const gltf_doc* doc,
     return GLTF_ERR_IO;
   }
 
-  uint8_t* pixels = (uint8_t*)malloc(bytes);
-  if (!pixels) {
-    stbi_image_free(tmp);
-    gltf_set_err(out_err, "out of memory", NULL, 0, 0);
-    return GLTF_ERR_IO;
-  }
-
-  memcpy(pixels, tmp, bytes);
-  stbi_image_free(tmp);
-
   // commit (so out_pixels not modified on failure above)
   gltf_image_pixels out = {0};
   out.format = GLTF_PIXEL_RGBA8;
   out.width = (uint32_t)w;
   out.height = (uint32_t)h;
   out.stride_bytes = (uint32_t)w * 4u;
-  out.pixels = pixels;
+  out.pixels = tmp; // stb's own malloc'd buffer: caller-owned via free
 
   *out_pixels = out;
   return GLTF_OK;
+#else
+  (void)blob;
+  (void)out_pixels;
+  gltf_set_err(out_err, "images: not compiled in", NULL, 0, 0);
+  return GLTF_ERR_UNSUPPORTED;
+#endif
+}
+
+// Reads width/height/channel count from the image header without decoding
+// pixels. URI images are probed on disk (only the header is read).
+gltf_result gltf_image_get_info(const gltf_doc* doc,
+                                uint32_t image_index,
+                                gltf_image_info* out_info,
+                                gltf_error* out_err) {
+#if GLTF_ENABLE_IMAGES
+  if (!doc || !out_info) {
+    gltf_set_err(out_err, "invalid args", NULL, 0, 0);
+    return GLTF_ERR_INVALID;
+  }
+  if (image_index >= doc->image_count) {
+    gltf_set_err(out_err, "image_index out of range", NULL, 0, 0);
+    return GLTF_ERR_RANGE;
+  }
+
+  const gltf_image* img = &doc->images[image_index];
+  int w = 0, h = 0, comp = 0, ok = 0;
+
+  // Files served through gltf_io go through gltf_image_load_bytes() below.
+  if (img->kind == GLTF_IMAGE_URI && (img->resolved || img->uri) && !gltf_doc_io(doc)) {
+    const char* path = img->resolved ? img->resolved : img->uri;
+    ok = stbi_info(path, &w, &h, &comp);
+    if (!ok) {
+      gltf_set_err(out_err, "image header unreadable", path, 0, 0);
+      return GLTF_ERR_PARSE;
+    }
+  } else {
+    gltf_blob blob = {0};
+    gltf_result r = gltf_image_load_bytes(doc, image_index, &blob, out_err);
+    if (r != GLTF_OK) return r;
+    if (blob.size <= (size_t)INT32_MAX) {
+      ok = stbi_info_from_memory((const unsigned char*)blob.data, (int)blob.size, &w, &h, &comp);
+    }
+    gltf_blob_free(&blob);
+    if (!ok) {
+      gltf_set_err(out_err, "image header unreadable", NULL, 0, 0);
+      return GLTF_ERR_PARSE;
+    }
+  }
+
+  if (w <= 0 || h <= 0 || comp < 1 || comp > 4) {
+    gltf_set_err(out_err, "image header unreadable", NULL, 0, 0);
+    return GLTF_ERR_PARSE;
+  }
+
+  out_info->width = (uint32_t)w;
+  out_info->height = (uint32_t)h;
+  out_info->channels = (uint32_t)comp;
+  return GLTF_OK;
 #else
   (void)doc;
   (void)image_index;
-  (void)out_pixels;
+  (void)out_info;
   gltf_set_err(out_err, "images: not compiled in", NULL, 0, 0);
   return GLTF_ERR_UNSUPPORTED;
 #endif
 }
 
+// Decodes doc.images[image_index] straight into a caller-owned buffer.
+//
+// The header is checked against dst_size/row_pitch before decoding, so an
+// undersized buffer costs no decode. stb_image still decodes into its own
+// scratch allocation; rows are copied out once with the requested pitch.
+gltf_result gltf_image_decode_into(const gltf_doc* doc,
+                                   uint32_t image_index,
+                                   uint32_t channels,
+                                   uint8_t* dst,
+                                   size_t dst_size,
+                                   uint32_t row_pitch,
+                                   gltf_image_info* out_info,
+                                   gltf_error* out_err) {
+#if GLTF_ENABLE_IMAGES
+  if (!doc || !dst || channels > 4u) {
+    gltf_set_err(out_err, "invalid args", NULL, 0, 0);
+    return GLTF_ERR_INVALID;
+  }
+  if (image_index >= doc->image_count) {
+    gltf_set_err(out_err, "image_index out of range", NULL, 0, 0);
+    return GLTF_ERR_RANGE;
+  }
+
+  gltf_blob blob = {0};
+  gltf_result r = gltf_image_load_bytes(doc, image_index, &blob, out_err);
+  if (r != GLTF_OK) return r;
+  if (blob.size > (size_t)INT32_MAX) {
+    gltf_blob_free(&blob);
+    gltf_set_err(out_err, "image too large", NULL, 0, 0);
+    return GLTF_ERR_IO;
+  }
+
+  int w = 0, h = 0, comp = 0;
+  if (!stbi_info_from_memory((const unsigned char*)blob.data, (int)blob.size, &w, &h, &comp) ||
+      w <= 0 || h <= 0 || comp < 1 || comp > 4) {
+    gltf_blob_free(&blob);
+    gltf_set_err(out_err, "image decode failed", NULL, 0, 0);
+    return GLTF_ERR_PARSE;
+  }
+
+  const uint32_t c = channels ? channels : (uint32_t)comp;
+  size_t row = 0, need = 0;
+  if (!mul_size_t((size_t)w, (size_t)c, &row) || row > UINT32_MAX) {
+    gltf_blob_free(&blob);
+    gltf_set_err(out_err, "image too large", NULL, 0, 0);
+    return GLTF_ERR_IO;
+  }
+  const size_t pitch = row_pitch ? (size_t)row_pitch : row;
+  if (pitch < row || !mul_size_t(pitch, (size_t)h - 1u, &need) || need > SIZE_MAX - row ||
+      need + row > dst_size) {
+    gltf_blob_free(&blob);
+    gltf_set_err(out_err, "destination buffer too small", NULL, 0, 0);
+    return GLTF_ERR_INVALID;
+  }
+
+  int dw = 0, dh = 0, dcomp = 0;
+  unsigned char* tmp = stbi_load_from_memory((const unsigned char*)blob.data, (int)blob.size,
+                                             &dw, &dh, &dcomp, (int)c);
+  gltf_blob_free(&blob);
+  if (!tmp || dw != w || dh != h) {
+    if (tmp) stbi_image_free(tmp);
+    gltf_set_err(out_err, "image decode failed", NULL, 0, 0);
+    return GLTF_ERR_PARSE;
+  }
+
+  if (pitch == row) {
+    memcpy(dst, tmp, row * (size_t)h);
+  } else {
+    for (size_t y = 0; y < (size_t)h; y++) memcpy(dst + y * pitch, tmp + y * row, row);
+  }
+  stbi_image_free(tmp);
+
+  if (out_info) {
+    out_info->width = (uint32_t)w;
+    out_info->height = (uint32_t)h;
+    out_info->channels = c;
+  }
+  return GLTF_OK;
+#else
+  (void)doc;
+  (void)image_index;
+  (void)channels;
+  (void)dst;
+  (void)dst_size;
+  (void)row_pitch;
+  (void)out_info;
+  gltf_set_err(out_err, "images: not compiled in", NULL, 0, 0);
+  return GLTF_ERR_UNSUPPORTED;
+#endif
+}
+
+typedef struct gltf_image_batch {
+  const gltf_doc* doc;
+  const uint32_t* indices;
+  gltf_image_decode_result* results;
+} gltf_image_batch;
+
+// One task: file read (or base64 / bufferView) and decode of a single image.
+// Tasks touch only their own result; buffer residency is thread-safe.
+static void gltf_image_batch_task(void* user, uint32_t task_index) {
+  const gltf_image_batch* b = (const gltf_image_batch*)user;
+  gltf_image_decode_result* res = &b->results[task_index];
+  gltf_image_pixels pixels = {0};
+  gltf_error err = {0};
+
+  res->result = gltf_image_decode_rgba8(b->doc, b->indices[task_index], &pixels, &err);
+  res->error = err;
+  res->pixels = pixels;
+}
+
+// Decodes a list of images, one dispatched task per entry.
+// Every result is filled; returns the first failure code (if any).
+gltf_result gltf_image_decode_rgba8_batch(const gltf_doc* doc,
+                                          const uint32_t* image_indices,
+                                          uint32_t count,
+                                          gltf_image_decode_result* out_results,
+                                          gltf_dispatch_fn dispatch,
+                                          void* dispatch_user,
+                                          gltf_error* out_err) {
+  if (!doc || (count > 0 && (!image_indices || !out_results))) {
+    gltf_set_err(out_err, "invalid args", NULL, 0, 0);
+    return GLTF_ERR_INVALID;
+  }
+  if (count == 0) return GLTF_OK;
+
+  gltf_image_batch batch = { doc, image_indices, out_results };
+  if (dispatch) {
+    dispatch(dispatch_user, count, gltf_image_batch_task, &batch);
+  } else {
+    for (uint32_t i = 0; i < count; i++) gltf_image_batch_task(&batch, i);
+  }
+
+  for (uint32_t i = 0; i < count; i++) {
+    if (out_results[i].result != GLTF_OK) {
+      if (out_err) *out_err = out_results[i].error;
+      return out_results[i].result;
+    }
+  }
+  return GLTF_OK;
+}
+
 // Writes an RGBA8 pixel buffer to a PNG file on disk.
 // On success, returns GLTF_OK.
 // On failure, returns GLTF_ERR_* and fills out_err if provided.
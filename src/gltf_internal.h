@@ -7,6 +7,11 @@
 //   - Keep comments here short; avoid duplicating public contracts.
 
 
+// Some modules use POSIX APIs (threads, mmap); request them before any include.
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "gltf/gltf.h"
 
 #include <stdio.h>
@@ -14,9 +19,10 @@
 #include <string.h>
 #include <yyjson.h>
 
+#include "gltf_thread.h"
+
 #define GLTF_STR_INVALID_OFF 0xFFFFFFFFu
-#define GLTF_ARENA_INITIAL_CAPACITY (16 * 1024)
-#define GLTF_INDICES_INITIAL_CAP 256u
+#define GLTF_DOC_BLOCK_ALIGN 16u
 #define GLTF_DOC_DEFAULT_SCENE_INVALID -1
 
 
@@ -24,6 +30,12 @@
 typedef enum gltf_load_ctx_flags {
   GLTF_LOAD_CTX_NONE = 0,
   GLTF_LOAD_CTX_GLB  = 1 << 0,  // forbid external uri, allow internal_bin
+  GLTF_LOAD_CTX_BORROW_BIN = 1 << 1,  // buffers[0] points into internal_bin (no copy)
+  GLTF_LOAD_CTX_JSON_INSITU = 1 << 2, // json_text is writable and zero-padded
+  GLTF_LOAD_CTX_MMAP = 1 << 3,        // map external buffer files instead of reading
+  GLTF_LOAD_CTX_LAZY_BUFFERS = 1 << 4, // defer external/data-uri buffers to first use
+  GLTF_LOAD_CTX_DECODE_INSITU = 1 << 5, // decode data-uri buffers over json_text (caller adopts it)
+  GLTF_LOAD_CTX_NAME_INDEX = 1 << 6,    // build doc->name_index after parsing
 } gltf_load_ctx_flags;
 
 // Optional context passed to loaders (bin override, doc dir, flags).
@@ -37,6 +49,28 @@ typedef struct gltf_load_context {
 
   // Optional behavior flags
   uint32_t flags;
+
+  // Allocator for the document block and the yyjson tree (NULL = libc).
+  const gltf_allocator* allocator;
+
+  // gltf_load_sections to parse (0 = all).
+  uint32_t sections;
+
+  // If non-NULL, external buffer reads and data-URI decodes are dispatched as
+  // one task per buffer after the buffers array has been parsed.
+  gltf_dispatch_fn dispatch;
+  void* dispatch_user;
+
+  // File access callbacks for external buffers (NULL = OS file API).
+  const gltf_io* io;
+
+  // GLTF_LOAD_CTX_DECODE_INSITU: the JSON text block. Data-URI buffers whose
+  // string lies inside it are decoded in place and borrow from it.
+  uint8_t* json_text;
+  size_t json_text_size;
+
+  // Statistics for this load (gltf_load_options.stats), or NULL.
+  gltf_load_stats* stats;
 } gltf_load_context;
 
 // Half-open range into doc->indices_u32: [first, first + count).
@@ -45,7 +79,8 @@ typedef struct gltf_range_u32 {
   uint32_t count;
 } gltf_range_u32;
 
-// Growable byte pool for all document strings (UTF-8, NUL-terminated).
+// Fixed-capacity byte pool for all document strings (UTF-8, NUL-terminated),
+// carved from the document block with its exact size precomputed.
 typedef struct gltf_arena {
   uint8_t* data;
   size_t size; // bytes used
@@ -80,12 +115,35 @@ typedef struct gltf_node {
   float scale[3];       // default (1,1,1)
 } gltf_node;
 
+// Validated byte layout of an accessor (see gltf_accessor_layout()): a span
+// without the buffer pointer, which lazy or streamed buffers only get later.
+typedef struct gltf_span_layout {
+  size_t byte_offset;         // from the start of buffers[buffer]
+  uint32_t buffer;
+  uint32_t count;
+  uint32_t stride;
+  uint32_t elem_size;
+  uint32_t dense;             // sparse accessors: 1 + sparse_dense index (buffer unused), else 0
+} gltf_span_layout;
+
+// One entry of a primitive's slot table (gltf_attr_slot, then indices).
+typedef struct gltf_prim_slot {
+  int32_t accessor;           // accessor index, or -1 if absent
+  uint32_t valid;             // 1 if layout passed gltf_accessor_layout()
+  gltf_span_layout layout;
+} gltf_prim_slot;
+
+#define GLTF_PRIM_SLOT_INDICES GLTF_ATTR_SLOT_COUNT
+
 // Parsed glTF primitive.
 typedef struct gltf_primitive {
   uint32_t attributes_first;
   uint32_t attributes_count;
   int32_t indices_accessor;   // accessor index for indices, or -1 if non-indexed
   gltf_prim_mode mode;        // default TRIANGLES (4)
+
+  // Filled by gltf_doc_build_prim_slots() once the document is parsed.
+  gltf_prim_slot slots[GLTF_ATTR_SLOT_COUNT + 1];
 } gltf_primitive;
 
 // Parsed glTF primitive attribute (semantic + set index + accessor).
@@ -102,6 +160,19 @@ typedef struct gltf_mesh {
   uint32_t primitive_count; // number of primitives in this mesh
 } gltf_mesh;
 
+// accessor.sparse: count elements replaced by values at indices. The data is
+// materialized once per document into a dense copy (see
+// gltf_accessor_layout()); readers only ever see that copy.
+typedef struct gltf_accessor_sparse {
+  uint32_t count;                  // number of replaced elements (0 = not sparse)
+  uint32_t indices_view;           // sparse.indices.bufferView
+  uint32_t indices_offset;         // sparse.indices.byteOffset
+  uint32_t indices_component_type; // sparse.indices.componentType (U8/U16/U32)
+  uint32_t values_view;            // sparse.values.bufferView
+  uint32_t values_offset;          // sparse.values.byteOffset
+  uint32_t dense;                  // index into doc->sparse_dense
+} gltf_accessor_sparse;
+
 // Parsed glTF accessor (typed view into bufferView data).
 typedef struct gltf_accessor {
   int32_t buffer_view;     // index into doc->buffer_views, or -1 if absent
@@ -110,7 +181,11 @@ typedef struct gltf_accessor {
   uint32_t count;          // number of elements
   uint8_t type;            // element type: SCALAR, VEC2, VEC3, VEC4, MAT2, MAT3, MAT4
   uint8_t normalized;      // 0/1: whether integer components should be normalized
-  uint16_t _pad;           // padding for alignment
+  uint8_t has_bounds;      // 0/1: min/max present (only kept for <= 4 components)
+  uint8_t _pad;            // padding for alignment
+  float min[4];            // accessor.min, raw component values (not normalized)
+  float max[4];            // accessor.max, raw component values (not normalized)
+  gltf_accessor_sparse sparse; // accessor.sparse (count == 0 if absent)
 } gltf_accessor;
 
 // Parsed glTF bufferView (slice of a buffer + optional stride).
@@ -123,21 +198,78 @@ typedef struct gltf_buffer_view {
                         // GL_ELEMENT_ARRAY_BUFFER, etc.)
 } gltf_buffer_view;
 
+// Who owns gltf_buffer.data (decides what gltf_free() does with it).
+typedef enum gltf_buffer_storage {
+  GLTF_BUFFER_OWNED = 0, // malloc()'d by the loader, freed by gltf_free()
+  GLTF_BUFFER_BORROWED,  // points into caller memory, doc->file_bytes or doc->file_map
+  GLTF_BUFFER_MAPPED,    // read-only file mapping of byte_length bytes, unmapped by gltf_free()
+} gltf_buffer_storage;
+
 // Parsed glTF buffer (URI + loaded bytes).
 typedef struct gltf_buffer {
-  gltf_str uri;         // source: file path or data URI
-  uint32_t byte_length; // size of loaded data in bytes
-  uint8_t* data;        // loaded bytes (owned by doc), size == byte_length
+  gltf_str uri;                // source: file path or data URI
+  uint32_t byte_length;        // size of loaded data in bytes
+  uint8_t* data;               // loaded bytes, size == byte_length
+  gltf_buffer_storage storage; // ownership of data
+
+  // Lazy loading (GLTF_LOAD_LAZY_BUFFERS): data is resolved on first use.
+  gltf_str path;               // resolved external file path (invalid for data URIs)
+  volatile uint32_t pending;   // 1 until data is resident (atomic, see gltf_buffer_ensure_resident)
 } gltf_buffer;
 
+// Dense copy of a sparse accessor, produced once per document on first use.
+typedef struct gltf_sparse_dense {
+  uint8_t* data;           // count * elem_size bytes, malloc()'d, freed by gltf_free()
+  uint32_t accessor;       // accessor this copy belongs to
+  volatile uint32_t ready; // 1 once data is set (atomic, under doc->lock)
+} gltf_sparse_dense;
+
+// Decoded bytes of a data-URI image, produced once per document on first use.
+typedef struct gltf_image_bytes {
+  uint8_t* data;           // malloc()'d, freed by gltf_free()
+  size_t size;
+  volatile uint32_t ready; // 1 once data/size are set (atomic, under doc->lock)
+} gltf_image_bytes;
+
+// Name lookup tables for one gltf_name_kind (GLTF_LOAD_NAME_INDEX).
+//
+// Notes:
+//   - slots is an open-addressing hash table (linear probing) of object
+//     index + 1 (0 = empty), keyed by the name bytes in doc->arena. A name
+//     given to several objects keeps only its lowest index.
+//   - sorted lists every named object ordered by name bytes (then index), so
+//     a prefix is one contiguous run found by binary search.
+typedef struct gltf_name_index {
+  uint32_t* slots;       // slot_cap entries (a power of two), NULL if not built
+  uint32_t slot_cap;
+  uint32_t* sorted;      // sorted_count entries
+  uint32_t sorted_count;
+} gltf_name_index;
+
 // Internal document layout (opaque to users).
 //
 // Notes:
 //   - All memory is owned by the document and freed in gltf_free().
+//   - The struct itself, every parsed array, the string arena and the index
+//     pool share one allocation (the document block, see gltf_doc_presize());
+//     buffer payloads, decoded image bytes and file_bytes are separate.
+//   - Every pointer field (here and in the array elements) is rebased by
+//     src/gltf_baked.c; keep it in sync and bump GLTF_BAKED_VERSION.
 //   - Relationships are expressed via indices:
 //       scenes -> nodes -> meshes -> primitives -> accessors -> bufferViews -> buffers
 //       materials -> textures -> images (+ optional samplers)
 struct gltf_doc {
+  // Allocator the document block came from (copied from the load options).
+  gltf_allocator alc;
+
+  // Unused tail of the document block: [block_next, block_end).
+  uint8_t* block_next;
+  uint8_t* block_end;
+
+  // 1 if the block lives inside file_map (gltf_load_baked()) rather than in
+  // memory from alc.
+  uint32_t block_mapped;
+
   // asset.version is small; store inline for quick access and no arena lookup.
   char asset_version[8];
 
@@ -162,6 +294,7 @@ struct gltf_doc {
   uint32_t buffer_count;
   uint32_t buffer_view_count;
   uint32_t accessor_count;
+  uint32_t sparse_dense_count; // accessors with a sparse section
 
   // Material / texture arrays (0 if absent).
   uint32_t material_count;
@@ -187,10 +320,12 @@ struct gltf_doc {
   gltf_texture* textures;         // [texture_count]
   gltf_image* images;             // [image_count]
   gltf_sampler* samplers;         // [sampler_count]
+  gltf_image_bytes* image_bytes;  // [image_count], data-URI images only
+  gltf_sparse_dense* sparse_dense; // [sparse_dense_count], one per sparse accessor
 
   // Shared index pool for all variable-length arrays (owned).
   //
-  // Stored as a single growable array to avoid per-object allocations.
+  // Stored as a single presized array to avoid per-object allocations.
   // Referenced via gltf_range_u32 (half-open ranges).
   //
   // Currently used by:
@@ -204,6 +339,43 @@ struct gltf_doc {
   uint32_t indices_count; // number of valid entries
   uint32_t indices_cap;   // allocated entries
 
+  // gltf_load_ctx_flags the document was loaded with (lazy buffers reuse them).
+  uint32_t load_flags;
+
+  // gltf_load_sections that were parsed (never 0; see gltf_load_sections_resolve()).
+  uint32_t sections;
+
+  // Name lookup tables per gltf_name_kind (slots NULL without GLTF_LOAD_NAME_INDEX).
+  gltf_name_index name_index[GLTF_NAME_KIND_COUNT];
+
+  // File access callbacks copied from the load options (open == NULL: OS file
+  // API). Lazy buffers, URI images and MAPPED buffer releases go through them.
+  gltf_io io;
+
+  // Serializes lazy buffer loading, data-URI image decoding and sparse
+  // accessor materialization across threads.
+  gltf_mutex lock;
+
+  // Whole-file bytes kept alive because buffers borrow from them
+  // (gltf_load_file and gltf_glb_stream only), or NULL: buffers[0] borrows the
+  // GLB BIN chunk, or data-URI buffers of a .gltf were decoded over the JSON
+  // text and compacted to its front.
+  uint8_t* file_bytes;
+  // 1 if file_bytes came from alc (the BIN chunk of a gltf_glb_stream) rather
+  // than from malloc.
+  uint32_t file_bytes_alc;
+
+  // Read-only mapping of the whole .glb that buffers[0] borrows from
+  // (gltf_load_file_ex with GLTF_LOAD_MMAP), the copy-on-write mapping of a
+  // baked file (gltf_load_baked), or NULL.
+  const uint8_t* file_map;
+  size_t file_map_size;
+
+  // gltf_glb_stream documents whose buffers[0] is the BIN chunk still being
+  // fed: bytes of it written so far (read with acquire), or NULL for every
+  // other document and once gltf_glb_stream_finish() hands the document over.
+  const volatile uint32_t* stream_have;
+
   // Arena storage for all strings (owned).
   //
   // Stores UTF-8 NUL-terminated strings:
@@ -246,11 +418,55 @@ void gltf_set_err_if(gltf_error* out_err,
                      int line, int col);
 
 
+// ----------------------------------------------------------------------------
+// Document block (src/gltf_memory.c)
+// ----------------------------------------------------------------------------
+
+// malloc/realloc/free wrappers used when no allocator is given.
+const gltf_allocator* gltf_allocator_default(void);
+
+// Bytes of the block that count x size bytes occupy (aligned and saturating;
+// SIZE_MAX on overflow, so sums stay saturated with gltf_size_add()).
+size_t gltf_block_bytes(size_t count, size_t size);
+
+// a + b, or SIZE_MAX on overflow.
+size_t gltf_size_add(size_t a, size_t b);
+
+// Allocates a zeroed document block of block_size bytes (including the
+// gltf_doc itself, which sits at its start). Returns NULL on failure.
+gltf_doc* gltf_doc_block_create(const gltf_allocator* alc, size_t block_size);
+
+// Carves count x size zeroed bytes from the block tail, or NULL if the
+// presized block is exhausted (treated as out of memory).
+void* gltf_doc_carve(gltf_doc* doc, size_t count, size_t size);
+
+// Sizes of the document block for one glTF root (see gltf_doc_presize()).
+typedef struct gltf_doc_sizes {
+  size_t block_bytes;   // whole block (gltf_doc + arrays + strings + indices), SIZE_MAX if too large
+  size_t string_bytes;  // arena capacity
+  uint32_t index_count; // indices_u32 capacity
+} gltf_doc_sizes;
+
+// Computes an upper bound of everything the gltf_parse_* functions carve for
+// root and the resolved sections: the gltf_doc, their arrays, strings (with doc_dir_len bytes of
+// directory prefix per resolved URI) and index lists (src/gltf_parse.c). ctx_flags
+// (gltf_load_ctx_flags) decide which buffer URIs are copied.
+void gltf_doc_presize(yyjson_val* root,
+                      size_t doc_dir_len,
+                      uint32_t sections,
+                      uint32_t ctx_flags,
+                      gltf_doc_sizes* out);
+
+// The gltf_load_sections to parse for a requested mask: 0 becomes all, and
+// sections other sections depend on in this asset are added.
+uint32_t gltf_load_sections_resolve(yyjson_val* root, uint32_t requested);
+
 // ----------------------------------------------------------------------------
 // Arena (strings) (src/gltf_memory.c)
 // ----------------------------------------------------------------------------
 
-void arena_init(gltf_arena* arena, size_t initial_cap);
+// Uses data[0..cap) as string storage; the arena never grows.
+void arena_init(gltf_arena* arena, uint8_t* data, size_t cap);
 
 int arena_reserve(gltf_arena* arena, size_t additional_bytes);
 
@@ -279,6 +495,37 @@ gltf_result gltf_decode_component_to_f32(const uint8_t* p,
                                          int normalized,
                                          float* out);
 
+// Decodes count elements of comp_count components each.
+// src_stride is in bytes, dst_stride in floats; both must be >= one element.
+gltf_result gltf_decode_elements_to_f32(const uint8_t* src,
+                                        size_t src_stride,
+                                        size_t count,
+                                        uint32_t comp_count,
+                                        uint32_t component_type,
+                                        int normalized,
+                                        float* dst,
+                                        size_t dst_stride);
+
+// Widens count U8/U16/U32 indices to u32 and reports their min/max
+// (UINT32_MAX / 0 when count == 0). component_type must already be validated.
+void gltf_decode_indices_u32(const uint8_t* src,
+                             size_t src_stride,
+                             size_t count,
+                             uint32_t component_type,
+                             uint32_t* dst,
+                             uint32_t* out_min,
+                             uint32_t* out_max);
+
+// Per-component min/max of the first three components of count >= 1 elements,
+// decoded like gltf_decode_component_to_f32(). Supports F32, U8/I8, U16/I16.
+gltf_result gltf_decode_minmax3_f32(const uint8_t* src,
+                                    size_t src_stride,
+                                    size_t count,
+                                    uint32_t component_type,
+                                    int normalized,
+                                    float out_min3[3],
+                                    float out_max3[3]);
+
 // ----------------------------------------------------------------------------
 // Optional scalars (src/gltf_parse.c)
 // ----------------------------------------------------------------------------
@@ -437,12 +684,281 @@ gltf_result gltf_parse_materials(gltf_doc* doc,
                                  yyjson_val* root,
                                  gltf_error* out_err);
 
+// Loads the bytes of buffers[buffer_index] from its external file (path) or
+// data URI (uri) into b->data. Used at parse time and for lazy loading.
+gltf_result gltf_load_buffer_source(gltf_buffer* b,
+                                    const char* path,
+                                    const char* uri,
+                                    uint32_t ctx_flags,
+                                    const gltf_io* io,
+                                    gltf_error* out_err);
+
 gltf_result gltf_decode_data_uri(const char* uri,
                                  uint32_t expected_len,
                                  uint8_t** out_bytes,
                                  uint32_t* out_len,
                                  gltf_error* out_err);
 
+// Decodes a data URI in place (uri must be writable); *out_bytes points into
+// uri and holds exactly expected_len bytes.
+gltf_result gltf_decode_data_uri_insitu(char* uri,
+                                        uint32_t expected_len,
+                                        uint8_t** out_bytes,
+                                        gltf_error* out_err);
+
+// The document's file access callbacks, or NULL for the OS file API.
+static inline const gltf_io* gltf_doc_io(const gltf_doc* doc) {
+  return doc->io.open ? &doc->io : NULL;
+}
+
+// ----------------------------------------------------------------------------
+// Accessor layouts and primitive slots (src/gltf_accessor.c, src/gltf_primitive.c)
+// ----------------------------------------------------------------------------
+
+// Validates accessors[accessor_index] against its bufferView without touching
+// buffer bytes (same checks and messages as gltf_accessor_span()). Sparse
+// accessors also have their sparse views validated and get a dense layout.
+gltf_result gltf_accessor_layout(const gltf_doc* doc,
+                                 uint32_t accessor_index,
+                                 gltf_span_layout* out_layout,
+                                 gltf_error* out_err);
+
+// Makes the layout's buffer resident and points a span at it (dense layouts:
+// materializes the sparse accessor on first use).
+gltf_result gltf_span_from_layout(const gltf_doc* doc,
+                                  const gltf_span_layout* layout,
+                                  gltf_span* out_span,
+                                  gltf_error* out_err);
+
+// Fills primitives[].slots from prim_attrs and the accessors (load time).
+void gltf_doc_build_prim_slots(gltf_doc* doc);
+
+// ----------------------------------------------------------------------------
+// Name index (src/gltf_names.c)
+// ----------------------------------------------------------------------------
+
+// Document block bytes gltf_doc_build_name_index() carves for root and the
+// resolved sections.
+size_t gltf_name_index_presize(yyjson_val* root, uint32_t sections);
+
+// Fills doc->name_index once nodes, meshes and materials are parsed.
+// Returns 0 if the presized block is exhausted.
+int gltf_doc_build_name_index(gltf_doc* doc);
+
+// Span of primitives[primitive_index].slots[slot]. The slot must be present;
+// an invalid layout reports the error gltf_accessor_span() would.
+gltf_result gltf_prim_slot_span(const gltf_doc* doc,
+                                uint32_t primitive_index,
+                                uint32_t slot,
+                                gltf_span* out_span,
+                                gltf_error* out_err);
+
+// ----------------------------------------------------------------------------
+// GLB chunks (src/gltf_doc.c)
+// ----------------------------------------------------------------------------
+
+// Validates the GLB header and chunk table of data[0..size) and returns the
+// JSON and (optional, else NULL / 0) BIN chunk payloads, which point into data.
+// Unknown chunks are skipped; failures return GLTF_ERR_INVALID.
+gltf_result gltf_glb_split(const uint8_t* data,
+                           size_t size,
+                           const uint8_t** out_json,
+                           uint32_t* out_json_len,
+                           const uint8_t** out_bin,
+                           uint32_t* out_bin_len,
+                           gltf_error* out_err);
+
+// Builds a document from the JSON and (optional) BIN chunk payloads of a GLB.
+// json_tail is how many bytes after the JSON chunk may be read and temporarily
+// written (in-place parsing needs YYJSON_PADDING_SIZE of them).
+// gltf_load_flags: BORROW_BIN points buffers[0] at bin_ptr, which then only
+// needs to be allocated (its bytes are not read here). stats may be NULL.
+gltf_result gltf_load_glb_chunks(const uint8_t* json_ptr,
+                                 uint32_t json_len,
+                                 size_t json_tail,
+                                 const uint8_t* bin_ptr,
+                                 uint32_t bin_len,
+                                 uint32_t flags,
+                                 const gltf_allocator* alc,
+                                 uint32_t sections,
+                                 gltf_load_stats* stats,
+                                 gltf_doc** out_doc,
+                                 gltf_error* out_err);
+
+// ----------------------------------------------------------------------------
+// Load statistics (src/gltf_stats.c)
+// ----------------------------------------------------------------------------
+//
+// Every hook takes the (possibly NULL) gltf_load_stats of the load and returns
+// at once when it is NULL. With GLTF_ENABLE_STATS=0 the hooks are empty inline
+// functions and nothing is timed or counted.
+
+#ifndef GLTF_ENABLE_STATS
+#define GLTF_ENABLE_STATS 1
+#endif
+
+// yyjson allocator that counts requests into a gltf_load_stats, forwarding to
+// the load's allocator.
+typedef struct gltf_stats_alc {
+  yyjson_alc inner;
+  gltf_load_stats* stats;
+} gltf_stats_alc;
+
+#if GLTF_ENABLE_STATS
+
+// Clears the outputs of s (inputs are kept) and marks it collected.
+void gltf_stats_reset(gltf_load_stats* s);
+
+// Starts timing stage; returns the start time for gltf_stats_end().
+double gltf_stats_begin(gltf_load_stats* s, gltf_load_stage stage);
+void gltf_stats_end(gltf_load_stats* s, gltf_load_stage stage, double t0);
+
+// Returns the current time, or 0 for a NULL s. Safe to call from buffer tasks.
+double gltf_stats_clock(const gltf_load_stats* s);
+
+// Adds seconds spent loading buffer index: decoding its data URI (data_uri
+// != 0) or reading / mapping its file. Loading thread only.
+void gltf_stats_buffer_time(gltf_load_stats* s, uint32_t index, int data_uri, double seconds);
+
+// Adds bytes the load allocated outside the document allocator.
+void gltf_stats_heap(gltf_load_stats* s, uint64_t bytes);
+
+// Records the size of the loaded file (heap_bytes: bytes read into memory).
+void gltf_stats_file(gltf_load_stats* s, uint64_t file_bytes, uint64_t heap_bytes);
+
+// Returns the allocator yyjson should use: a counting wrapper around alc
+// (stored in w) when s is non-NULL, otherwise alc itself.
+yyjson_alc gltf_stats_json_alc(gltf_load_stats* s, const yyjson_alc* alc, gltf_stats_alc* w);
+
+// Records the document block size right after it was allocated.
+void gltf_stats_block(gltf_load_stats* s, size_t block_bytes);
+
+// Classifies every loaded buffer (root: the glTF JSON root).
+void gltf_stats_buffers(gltf_load_stats* s,
+                        const gltf_doc* doc,
+                        yyjson_val* root,
+                        const gltf_load_context* ctx);
+
+// Records how much of the block, string pool and index list parsing used.
+void gltf_stats_doc(gltf_load_stats* s, const gltf_doc* doc);
+
+#else
+
+// Nothing is collected; only the flag is cleared so callers can tell.
+static inline void gltf_stats_reset(gltf_load_stats* s) {
+  if (s) s->collected = 0u;
+}
+static inline double gltf_stats_begin(gltf_load_stats* s, gltf_load_stage stage) {
+  (void)s;
+  (void)stage;
+  return 0.0;
+}
+static inline void gltf_stats_end(gltf_load_stats* s, gltf_load_stage stage, double t0) {
+  (void)s;
+  (void)stage;
+  (void)t0;
+}
+static inline double gltf_stats_clock(const gltf_load_stats* s) {
+  (void)s;
+  return 0.0;
+}
+static inline void gltf_stats_buffer_time(gltf_load_stats* s, uint32_t index, int data_uri, double seconds) {
+  (void)s;
+  (void)index;
+  (void)data_uri;
+  (void)seconds;
+}
+static inline void gltf_stats_heap(gltf_load_stats* s, uint64_t bytes) {
+  (void)s;
+  (void)bytes;
+}
+static inline void gltf_stats_file(gltf_load_stats* s, uint64_t file_bytes, uint64_t heap_bytes) {
+  (void)s;
+  (void)file_bytes;
+  (void)heap_bytes;
+}
+static inline yyjson_alc gltf_stats_json_alc(gltf_load_stats* s, const yyjson_alc* alc, gltf_stats_alc* w) {
+  (void)s;
+  (void)w;
+  return *alc;
+}
+static inline void gltf_stats_block(gltf_load_stats* s, size_t block_bytes) {
+  (void)s;
+  (void)block_bytes;
+}
+static inline void gltf_stats_buffers(gltf_load_stats* s,
+                                      const gltf_doc* doc,
+                                      yyjson_val* root,
+                                      const gltf_load_context* ctx) {
+  (void)s;
+  (void)doc;
+  (void)root;
+  (void)ctx;
+}
+static inline void gltf_stats_doc(gltf_load_stats* s, const gltf_doc* doc) {
+  (void)s;
+  (void)doc;
+}
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Lazy buffers (src/gltf_doc.c)
+// ----------------------------------------------------------------------------
+
+// Slow path of gltf_buffer_ensure_resident(): loads a pending buffer under doc->lock.
+gltf_result gltf_buffer_resolve_lazy(const gltf_doc* doc,
+                                     uint32_t buffer_index,
+                                     gltf_error* out_err);
+
+// Makes buffers[buffer_index].data resident (no-op unless loaded lazily).
+// Safe to call concurrently; buffer_index must be in range.
+static inline gltf_result gltf_buffer_ensure_resident(const gltf_doc* doc,
+                                                      uint32_t buffer_index,
+                                                      gltf_error* out_err) {
+  if (gltf_atomic_load_acquire_u32(&doc->buffers[buffer_index].pending) == 0) {
+    return GLTF_OK;
+  }
+  return gltf_buffer_resolve_lazy(doc, buffer_index, out_err);
+}
+
+// ----------------------------------------------------------------------------
+// Image sources (src/gltf_images.c)
+// ----------------------------------------------------------------------------
+
+// Temporary byte buffer used while resolving image sources.
+//
+// Ownership:
+//   - owned = 1 => data is heap-allocated and must be freed by gltf_blob_free()
+//   - owned = 0 => data points into doc-owned memory (must not be freed); this
+//     includes bufferView bytes and data URIs decoded once into doc.image_bytes
+//   - io != NULL => data is a mapping from io->map (the document's gltf_io),
+//     released by gltf_blob_free()
+typedef struct gltf_blob {
+  const uint8_t* data;
+  size_t size;
+  int owned;
+  const gltf_io* io;
+} gltf_blob;
+
+// Resolves doc.images[image_index] into compressed bytes (PNG/JPEG/...).
+gltf_result gltf_image_load_bytes(const gltf_doc* doc,
+                                  uint32_t image_index,
+                                  gltf_blob* out_blob,
+                                  gltf_error* out_err);
+
+// Releases a blob if it owns its memory and clears the fields.
+void gltf_blob_free(gltf_blob* b);
+
+// Decodes compressed bytes into malloc'd RGBA8 pixels.
+gltf_result gltf_image_decode_blob_rgba8(const gltf_blob* blob,
+                                         gltf_image_pixels* out_pixels,
+                                         gltf_error* out_err);
+
+// Returns the base64 payload of a data URI, or NULL.
+const char* gltf_data_uri_base64_payload(const char* uri);
+
+
 // ----------------------------------------------------------------------------
 // Little-endian reads from an unaligned byte stream (src/gltf_decode.c).
 // ----------------------------------------------------------------------------
@@ -456,7 +972,25 @@ uint32_t rd_u32_le(const uint8_t* p);
 // Scene graph evaluation (internal)
 // ----------------------------------------------------------------------------
 
-// Cache for computed node world matrices for a single scene.
+// Flattened hierarchy of one scene, built the first time the scene is computed.
+//
+//   - order[0..order_count) lists the nodes reachable from the scene roots,
+//     parents before children, grouped by depth: level d occupies
+//     order[level_first[d] .. level_first[d + 1])
+//   - parent[node] is the node's parent in that order (UINT32_MAX for roots)
+//   - order_pos[node] is the node's position in order (UINT32_MAX if unreachable)
+typedef struct gltf_world_scene {
+  uint32_t* order;       // node_count entries, order_count used
+  uint32_t* parent;      // node_count entries
+  uint32_t* order_pos;   // node_count entries
+  uint32_t* level_first; // node_count + 1 entries, level_count + 1 used
+  uint32_t order_count;
+  uint32_t level_count;
+  uint8_t built;         // order arrays hold this scene
+  uint8_t valid;         // every node in order has an up-to-date world matrix
+} gltf_world_scene;
+
+// Cache for computed node world matrices, shared by all scenes of a document.
 //
 // Lifetime:
 //   - created by gltf_world_cache_create()
@@ -465,18 +999,62 @@ uint32_t rd_u32_le(const uint8_t* p);
 //
 // Meaning:
 //   - world_m16[node*16+0 .. node*16+15] holds node world matrix (column-major)
-//   - state[node] tracks DFS progress:
-//       0 = UNVISITED, 1 = VISITING, 2 = DONE
+//   - world_parent[node] is the parent that matrix was computed under
+//     (UINT32_MAX for a root); it is only meaningful if world_gen[node] == gen
+//   - scenes[s] holds the flattened order of scene s (see gltf_world_scene)
 //
 // Notes:
-//   - Valid only after gltf_compute_world_matrices() succeeds.
-//   - scene_index tells which scene the cache currently represents.
-//   - A node may remain UNVISITED if it is unreachable from scene roots.
+//   - World matrices are per node, not per scene: a node reached with the same
+//     parent in several scenes is computed once. Computing a scene only
+//     evaluates nodes that are not current (world_gen/world_parent mismatch)
+//     or whose parent was just recomputed (stamp[node] == epoch).
+//   - A scene that is still valid costs nothing to compute again. Scenes only
+//     disagree on a node's parent in non-conforming files (a node used as a
+//     root in one scene and as a child in another); recomputing such a node
+//     bumps gen, which invalidates every other scene.
+//   - Scene orders are allocated on first use; everything else is sized for
+//     node_count at creation time.
+//   - scene_index tells which scene gltf_world_matrix() answers for.
+//   - Local overrides live in local_m16 (allocated on first use together with
+//     local_flags and dirty). Dirty nodes are recomputed with their
+//     descendants before any evaluation, following world_parent links, so
+//     every scene sharing them stays valid.
+//   - With GLTF_WORLD_CACHE_SOA, soa_trs holds every node's TRS as ten float
+//     streams (tx ty tz rx ry rz rw sx sy sz), each soa_stride floats long and
+//     padded with identity values; stream k of node i is
+//     soa_trs[k * soa_stride + i]. Full evaluations compose soa_local_m16 four
+//     nodes at a time from it. The override arrays are allocated up front.
+
+enum {
+  GLTF_WORLD_LOCAL_OVERRIDE = 1u << 0, // local_m16[node] replaces the document's TRS/matrix
+  GLTF_WORLD_LOCAL_DIRTY = 1u << 1,    // node is queued in dirty[]
+  GLTF_WORLD_LOCAL_TRS = 1u << 2,      // SoA mode: soa_trs[node] replaces the document's matrix
+};
 
 typedef struct gltf_world_cache {
-  uint32_t node_count;  // must match doc->node_count
-  float* world_m16;     // node_count * 16 floats, column-major mat4
-  uint8_t* state;       // node_count bytes, DFS state per node
-  uint32_t scene_index; // scene for which matrices were computed
-  int valid;            // 1 if world_m16/state are consistent for scene_index
+  uint32_t node_count;   // must match doc->node_count
+  uint32_t flags;        // GLTF_WORLD_CACHE_* creation flags
+  float* world_m16;      // node_count * 16 floats, column-major mat4
+  uint32_t* world_parent; // node_count entries
+  uint32_t* world_gen;   // node_count entries
+  uint32_t gen;          // current generation (never 0)
+  volatile uint32_t conflict; // set by evaluation when a node changes parent
+
+  gltf_world_scene* scenes; // scene_count entries
+  uint32_t scene_count;
+
+  uint32_t* stamp;       // node_count entries, epoch of the last recompute
+  uint32_t* stack;       // node_count entries, subtree traversal
+  uint32_t epoch;        // bumped for every evaluation pass
+
+  float* local_m16;      // node_count * 16 floats, NULL until the first override
+  uint8_t* local_flags;  // node_count bytes, GLTF_WORLD_LOCAL_* bits
+  uint32_t* dirty;       // node_count entries, dirty_count used
+  uint32_t dirty_count;
+
+  float* soa_trs;        // 10 * soa_stride floats, NULL unless GLTF_WORLD_CACHE_SOA
+  float* soa_local_m16;  // soa_stride * 16 floats, composed local matrices
+  uint32_t soa_stride;   // node_count rounded up to a multiple of 4
+
+  uint32_t scene_index;  // scene answered by gltf_world_matrix(), UINT32_MAX if none
 } gltf_world_cache;
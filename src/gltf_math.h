@@ -16,6 +16,8 @@
 // Operations:
 //   - mat4_identity(m): sets m to the identity matrix
 //   - mat4_mul(a, b, out): computes matrix product out = a * b
+//   - mat4_mul_f32x4(a, b, out): same product, one column per 4-wide operation
+//   - mat4_compose_trs_x4(...): T * R * S for four nodes at once (SoA input)
 //
 // Design goals:
 //   - small and dependency-free
@@ -33,6 +35,8 @@
 
 #include <string.h>
 
+#include "gltf_simd.h"
+
 
 static inline void mat4_identity(float m[16]) {
     memset(m, 0, 16 * sizeof(float));
@@ -101,3 +105,73 @@ static inline void mat4_mul(const float a[16], const float b[16], float out[16])
   }
   memcpy(out, r, sizeof(r));
 }
+
+// out = a * b, computing each output column as a 4-wide linear combination of
+// a's columns. Same products and summation order as mat4_mul(). out may alias
+// a or b.
+static inline void mat4_mul_f32x4(const float a[16], const float b[16], float out[16]) {
+  const gltf_f32x4 a0 = gltf_f32x4_load(a + 0);
+  const gltf_f32x4 a1 = gltf_f32x4_load(a + 4);
+  const gltf_f32x4 a2 = gltf_f32x4_load(a + 8);
+  const gltf_f32x4 a3 = gltf_f32x4_load(a + 12);
+  gltf_f32x4 r[4];
+  for (int c = 0; c < 4; ++c) {
+    gltf_f32x4 v = gltf_f32x4_mul(a0, gltf_f32x4_set1(b[c*4 + 0]));
+    v = gltf_f32x4_add(v, gltf_f32x4_mul(a1, gltf_f32x4_set1(b[c*4 + 1])));
+    v = gltf_f32x4_add(v, gltf_f32x4_mul(a2, gltf_f32x4_set1(b[c*4 + 2])));
+    v = gltf_f32x4_add(v, gltf_f32x4_mul(a3, gltf_f32x4_set1(b[c*4 + 3])));
+    r[c] = v;
+  }
+  for (int c = 0; c < 4; ++c) gltf_f32x4_store(out + c*4, r[c]);
+}
+
+// Builds local = T * R * S for four nodes whose TRS components are given as
+// 4-wide streams (t[0..2], q[0..3] = x,y,z,w, s[0..2]); writes four column-major
+// matrices to out[0..63]. Per lane this is exactly mat4_from_quat() followed by
+// mat4_apply_scale() and mat4_apply_translation().
+static inline void mat4_compose_trs_x4(const gltf_f32x4 t[3],
+                                       const gltf_f32x4 q[4],
+                                       const gltf_f32x4 s[3],
+                                       float out[64]) {
+  const gltf_f32x4 one = gltf_f32x4_set1(1.f);
+  const gltf_f32x4 two = gltf_f32x4_set1(2.f);
+  const gltf_f32x4 zero = gltf_f32x4_set1(0.f);
+  const gltf_f32x4 x = q[0], y = q[1], z = q[2], w = q[3];
+
+  const gltf_f32x4 xx = gltf_f32x4_mul(x, x), yy = gltf_f32x4_mul(y, y), zz = gltf_f32x4_mul(z, z);
+  const gltf_f32x4 xy = gltf_f32x4_mul(x, y), xz = gltf_f32x4_mul(x, z), yz = gltf_f32x4_mul(y, z);
+  const gltf_f32x4 wx = gltf_f32x4_mul(w, x), wy = gltf_f32x4_mul(w, y), wz = gltf_f32x4_mul(w, z);
+
+  // m[k] for k = col*4 + row, one lane per node.
+  gltf_f32x4 m[16];
+  m[0]  = gltf_f32x4_mul(gltf_f32x4_sub(one, gltf_f32x4_mul(two, gltf_f32x4_add(yy, zz))), s[0]);
+  m[1]  = gltf_f32x4_mul(gltf_f32x4_mul(two, gltf_f32x4_add(xy, wz)), s[0]);
+  m[2]  = gltf_f32x4_mul(gltf_f32x4_mul(two, gltf_f32x4_sub(xz, wy)), s[0]);
+  m[3]  = zero;
+
+  m[4]  = gltf_f32x4_mul(gltf_f32x4_mul(two, gltf_f32x4_sub(xy, wz)), s[1]);
+  m[5]  = gltf_f32x4_mul(gltf_f32x4_sub(one, gltf_f32x4_mul(two, gltf_f32x4_add(xx, zz))), s[1]);
+  m[6]  = gltf_f32x4_mul(gltf_f32x4_mul(two, gltf_f32x4_add(yz, wx)), s[1]);
+  m[7]  = zero;
+
+  m[8]  = gltf_f32x4_mul(gltf_f32x4_mul(two, gltf_f32x4_add(xz, wy)), s[2]);
+  m[9]  = gltf_f32x4_mul(gltf_f32x4_mul(two, gltf_f32x4_sub(yz, wx)), s[2]);
+  m[10] = gltf_f32x4_mul(gltf_f32x4_sub(one, gltf_f32x4_mul(two, gltf_f32x4_add(xx, yy))), s[2]);
+  m[11] = zero;
+
+  m[12] = t[0];
+  m[13] = t[1];
+  m[14] = t[2];
+  m[15] = one;
+
+  // Each 4x4 block (one matrix column across four nodes) transposes into that
+  // column for each node.
+  for (int c = 0; c < 4; ++c) {
+    gltf_f32x4 r0 = m[c*4 + 0], r1 = m[c*4 + 1], r2 = m[c*4 + 2], r3 = m[c*4 + 3];
+    gltf_f32x4_transpose(&r0, &r1, &r2, &r3);
+    gltf_f32x4_store(out + 0*16 + c*4, r0);
+    gltf_f32x4_store(out + 1*16 + c*4, r1);
+    gltf_f32x4_store(out + 2*16 + c*4, r2);
+    gltf_f32x4_store(out + 3*16 + c*4, r3);
+  }
+}
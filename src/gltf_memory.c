@@ -3,33 +3,99 @@
 // This module provides small internal allocators used by the document.
 //
 // Responsibilities:
-//   - grow-only arena storage for document-owned strings
+//   - the document block: one allocation carved into the doc and its arrays
+//   - fixed-capacity arena storage for document-owned strings
 //   - shared u32 index pool for expanded index data
 //
 // Notes:
 //   - These helpers are internal; public API contracts live in include/gltf/gltf.h.
-//   - The arena owns its memory; returned views are offsets into arena storage.
+//   - Block sizes are computed up front (gltf_doc_presize()), so nothing here
+//     grows: running out of presized space is reported as an allocation failure.
+//   - Returned string views are offsets into arena storage.
 
 
 #include "gltf_internal.h"
 
 
+// ----------------------------------------------------------------------------
+// Document block
+// ----------------------------------------------------------------------------
+
+static void* gltf_libc_malloc(void* user, size_t size) {
+  (void)user;
+  return malloc(size);
+}
+
+static void* gltf_libc_realloc(void* user, void* ptr, size_t old_size, size_t size) {
+  (void)user;
+  (void)old_size;
+  return realloc(ptr, size);
+}
+
+static void gltf_libc_free(void* user, void* ptr) {
+  (void)user;
+  free(ptr);
+}
+
+const gltf_allocator* gltf_allocator_default(void) {
+  static const gltf_allocator k_libc = { gltf_libc_malloc, gltf_libc_realloc, gltf_libc_free, NULL };
+  return &k_libc;
+}
+
+size_t gltf_size_add(size_t a, size_t b) {
+  return (a > SIZE_MAX - b) ? SIZE_MAX : a + b;
+}
+
+size_t gltf_block_bytes(size_t count, size_t size) {
+  if (size != 0 && count > (SIZE_MAX - GLTF_DOC_BLOCK_ALIGN) / size) return SIZE_MAX;
+  return (count * size + (GLTF_DOC_BLOCK_ALIGN - 1u)) & ~(size_t)(GLTF_DOC_BLOCK_ALIGN - 1u);
+}
+
+gltf_doc* gltf_doc_block_create(const gltf_allocator* alc, size_t block_size) {
+  const size_t head = gltf_block_bytes(1, sizeof(gltf_doc));
+  if (block_size < head || block_size == SIZE_MAX) return NULL;
+
+  uint8_t* block = (uint8_t*)alc->malloc(alc->user, block_size);
+  if (!block) return NULL;
+
+  // Only the doc header is cleared here; carved ranges are zeroed on demand.
+  gltf_doc* doc = (gltf_doc*)(void*)block;
+  memset(doc, 0, sizeof(gltf_doc));
+  doc->alc = *alc;
+  doc->block_next = block + head;
+  doc->block_end = block + block_size;
+  return doc;
+}
+
+void* gltf_doc_carve(gltf_doc* doc, size_t count, size_t size) {
+  const size_t bytes = gltf_block_bytes(count, size);
+  if (bytes > (size_t)(doc->block_end - doc->block_next)) return NULL;
+
+  void* p = doc->block_next;
+  doc->block_next += bytes;
+  memset(p, 0, bytes);
+  return p;
+}
+
+
 // ----------------------------------------------------------------------------
 // Arena (strings)
 // ----------------------------------------------------------------------------
-// Simple grow-only byte arena used to store document-owned strings.
+// Fixed-capacity byte arena used to store document-owned strings.
 //
 // Notes:
 //   - arena_strdup() stores a NUL-terminated copy; returned gltf_str refers to the
 //     bytes (excluding the terminator).
-//   - Operations fail (return 0 / invalid) on overflow or allocation failure.
+//   - The storage never moves, so const char* views into it stay valid for the
+//     document's lifetime.
+//   - Operations fail (return 0 / invalid) on overflow or when the capacity
+//     is exhausted.
 
 
-void arena_init(gltf_arena* arena, size_t initial_cap) {
-  if (initial_cap == 0) initial_cap = GLTF_ARENA_INITIAL_CAPACITY;
-  arena->data = (uint8_t*)malloc(initial_cap);
+void arena_init(gltf_arena* arena, uint8_t* data, size_t cap) {
+  arena->data = data;
   arena->size = 0;
-  arena->cap = arena->data ? initial_cap : 0;
+  arena->cap = data ? cap : 0;
 }
 
 int arena_reserve(gltf_arena* arena, size_t additional_bytes) {
@@ -38,24 +104,7 @@ int arena_reserve(gltf_arena* arena, size_t additional_bytes) {
   const size_t required = arena->size + additional_bytes;
 
   if (required > UINT32_MAX) return 0;
-  if (required <= arena->cap) return 1;
-
-  size_t new_cap = arena->cap ? arena->cap : GLTF_ARENA_INITIAL_CAPACITY;
-  while (new_cap < required) {
-    if (new_cap > SIZE_MAX / 2) {
-      new_cap = required;
-      break;
-    }
-    new_cap *= 2;
-  }
-
-  uint8_t* new_data = (uint8_t*)realloc(arena->data, new_cap);
-  if (!new_data) return 0;
-
-  arena->data = new_data;
-  arena->cap = new_cap;
-
-  return 1;
+  return required <= arena->cap;
 }
 
 gltf_str arena_strdup(gltf_arena* arena, const char* s) {
@@ -83,33 +132,11 @@ const char* arena_get_str(const gltf_arena* arena, gltf_str s) {
 // ----------------------------------------------------------------------------
 // Indices (shared u32 pool)
 // ----------------------------------------------------------------------------
-// Growable array used to store decoded indices as u32.
+// Presized array (carved from the document block) used to store index lists as u32.
 
 int indices_reserve(gltf_doc* doc, uint32_t additional) {
   if (additional > UINT32_MAX - doc->indices_count) return 0;
-
-  uint32_t required = doc->indices_count + additional;
-
-  if (required <= doc->indices_cap) return 1;
-
-  uint32_t new_cap = doc->indices_cap ? doc->indices_cap : GLTF_INDICES_INITIAL_CAP;
-  while (new_cap < required) {
-    if (new_cap > UINT32_MAX / 2) {
-      new_cap = required;
-      break;
-    }
-    new_cap *= 2;
-    if ((size_t)new_cap > SIZE_MAX / sizeof(uint32_t)) return 0;
-  }
-
-  size_t bytes = (size_t)new_cap * sizeof(uint32_t);
-  uint32_t* p = (uint32_t*)realloc(doc->indices_u32, bytes);
-
-  if (!p) return 0;
-
-  doc->indices_u32 = p;
-  doc->indices_cap = new_cap;
-  return 1;
+  return doc->indices_count + additional <= doc->indices_cap;
 }
 
 int indices_push_u32(gltf_doc* doc, uint32_t v) {
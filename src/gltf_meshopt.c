@@ -0,0 +1,562 @@
+// Minimal educational glTF 2.0 loader (C11).
+//
+// This module implements index buffer optimization for primitives.
+//
+// Responsibilities:
+//   - read a primitive's triangles and reorder them for the post-transform
+//     vertex cache (Tipsify: fan around a vertex, then continue from the
+//     cached vertex with the most remaining triangles)
+//   - split the cache-ordered list into clusters and sort them so outward
+//     facing clusters draw first (view-independent overdraw reduction)
+//   - renumber vertices in first-use order (vertex fetch remap)
+//   - optimize lists of primitives through a gltf_dispatch_fn
+//
+// Notes:
+//   - Public API contracts are documented in include/gltf/gltf.h.
+//   - Every pass is deterministic; the cache model is a FIFO of cache_size
+//     entries, the same one gltf_analyze_vertex_cache() measures.
+
+
+#include "gltf_internal.h"
+
+
+#define GLTF_MESH_OPT_MAX_CACHE_SIZE 256u
+#define GLTF_MESH_OPT_DEFAULT_THRESHOLD 1.05f
+
+// No vertex assigned yet (vertex fetch remap).
+#define GLTF_MESH_OPT_UNUSED 0xFFFFFFFFu
+
+
+// ----------------------------------------------------------------------------
+// FIFO cache model
+// ----------------------------------------------------------------------------
+//
+// stamp[v] is the "time" vertex v entered the cache; time advances by one per
+// miss. v is cached while time - stamp[v] <= cache_size. Starting time at
+// cache_size + 1 with zeroed stamps makes every vertex a miss, and adding
+// cache_size + 1 to time flushes the cache.
+
+static inline int gltf_fifo_touch(uint32_t* stamp, uint32_t* time, uint32_t cache_size, uint32_t v) {
+  if (*time - stamp[v] <= cache_size) return 0;
+  stamp[v] = (*time)++;
+  return 1;
+}
+
+gltf_result gltf_analyze_vertex_cache(const uint32_t* indices,
+                                      uint32_t index_count,
+                                      uint32_t vertex_count,
+                                      uint32_t cache_size,
+                                      float* out_acmr,
+                                      gltf_error* out_err) {
+  if (cache_size == 0) cache_size = GLTF_MESH_OPT_DEFAULT_CACHE_SIZE;
+  if (!out_acmr || (index_count > 0 && !indices) || index_count % 3u != 0 ||
+      cache_size > GLTF_MESH_OPT_MAX_CACHE_SIZE || index_count > UINT32_MAX - GLTF_MESH_OPT_MAX_CACHE_SIZE - 1u) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+  for (uint32_t i = 0; i < index_count; i++) {
+    if (indices[i] >= vertex_count) {
+      gltf_set_err(out_err, "index out of range", "indices", 1, 1);
+      return GLTF_ERR_INVALID;
+    }
+  }
+  if (index_count == 0) {
+    *out_acmr = 0.0f;
+    gltf_set_err(out_err, NULL, NULL, 0, 0);
+    return GLTF_OK;
+  }
+
+  uint32_t* stamp = (uint32_t*)calloc(vertex_count, sizeof(uint32_t));
+  if (!stamp) {
+    gltf_set_err(out_err, "out of memory", "root", 1, 1);
+    return GLTF_ERR_IO;
+  }
+  uint32_t time = cache_size + 1u;
+  uint32_t misses = 0;
+  for (uint32_t i = 0; i < index_count; i++) misses += (uint32_t)gltf_fifo_touch(stamp, &time, cache_size, indices[i]);
+  free(stamp);
+
+  *out_acmr = (float)((double)misses / (double)(index_count / 3u));
+  gltf_set_err(out_err, NULL, NULL, 0, 0);
+  return GLTF_OK;
+}
+
+
+// ----------------------------------------------------------------------------
+// Vertex cache order (Tipsify)
+// ----------------------------------------------------------------------------
+
+// Reorders the tri_count triangles of in into out (3 * tri_count indices).
+// Returns 0 on allocation failure.
+static int gltf_meshopt_tipsify(const uint32_t* in,
+                                uint32_t tri_count,
+                                uint32_t vertex_count,
+                                uint32_t cache_size,
+                                uint32_t* out) {
+  const size_t corners = (size_t)tri_count * 3u;
+
+  // offsets | adjacency | live | stamp | emitted | dead-end stack | candidates
+  const size_t words = ((size_t)vertex_count + 1u) + corners + (size_t)vertex_count * 2u + tri_count + corners * 2u;
+  uint32_t* mem = (uint32_t*)calloc(words, sizeof(uint32_t));
+  if (!mem) return 0;
+  uint32_t* offsets = mem;
+  uint32_t* adj = offsets + vertex_count + 1u;
+  uint32_t* live = adj + corners;
+  uint32_t* stamp = live + vertex_count;
+  uint32_t* emitted = stamp + vertex_count;
+  uint32_t* dead = emitted + tri_count;
+  uint32_t* cand = dead + corners;
+
+  // Vertex -> triangle adjacency (CSR); live[v] = triangles left that use v.
+  for (size_t i = 0; i < corners; i++) live[in[i]]++;
+  for (uint32_t v = 0; v < vertex_count; v++) offsets[v + 1u] = offsets[v] + live[v];
+  for (uint32_t t = 0; t < tri_count; t++) {
+    for (uint32_t c = 0; c < 3u; c++) {
+      const uint32_t v = in[(size_t)t * 3u + c];
+      adj[offsets[v + 1u] - live[v]] = t;
+      live[v]--;
+    }
+  }
+  for (uint32_t v = 0; v < vertex_count; v++) live[v] = offsets[v + 1u] - offsets[v];
+
+  uint32_t time = cache_size + 1u;
+  uint32_t cursor = 0;
+  size_t dead_top = 0;
+  size_t written = 0;
+
+  while (cursor < vertex_count && live[cursor] == 0) cursor++;
+  int64_t fan = cursor < vertex_count ? (int64_t)cursor : -1;
+
+  while (fan >= 0) {
+    // Emit every remaining triangle around the fanning vertex.
+    size_t cand_count = 0;
+    const uint32_t f = (uint32_t)fan;
+    for (uint32_t j = offsets[f]; j < offsets[f + 1u]; j++) {
+      const uint32_t t = adj[j];
+      if (emitted[t]) continue;
+      emitted[t] = 1u;
+      for (uint32_t c = 0; c < 3u; c++) {
+        const uint32_t v = in[(size_t)t * 3u + c];
+        out[written++] = v;
+        dead[dead_top++] = v;
+        cand[cand_count++] = v;
+        live[v]--;
+        (void)gltf_fifo_touch(stamp, &time, cache_size, v);
+      }
+    }
+
+    // Next fan: the candidate that stays cached while its fan is emitted and
+    // entered the cache earliest; otherwise the most recent live vertex.
+    fan = -1;
+    int64_t best = -1;
+    for (size_t c = 0; c < cand_count; c++) {
+      const uint32_t v = cand[c];
+      if (live[v] == 0) continue;
+      const uint64_t age = (uint64_t)(time - stamp[v]);
+      const int64_t priority = age + 2u * (uint64_t)live[v] <= cache_size ? (int64_t)age : 0;
+      if (priority > best) {
+        best = priority;
+        fan = (int64_t)v;
+      }
+    }
+    while (fan < 0 && dead_top > 0) {
+      const uint32_t v = dead[--dead_top];
+      if (live[v] > 0) fan = (int64_t)v;
+    }
+    if (fan < 0) {
+      while (cursor < vertex_count && live[cursor] == 0) cursor++;
+      if (cursor < vertex_count) fan = (int64_t)cursor;
+    }
+  }
+
+  free(mem);
+  return 1;
+}
+
+
+// ----------------------------------------------------------------------------
+// Overdraw order
+// ----------------------------------------------------------------------------
+
+typedef struct gltf_meshopt_cluster {
+  float key; // larger draws first
+  uint32_t first;
+  uint32_t count;
+} gltf_meshopt_cluster;
+
+static int gltf_meshopt_cluster_less(const gltf_meshopt_cluster* a, const gltf_meshopt_cluster* b) {
+  return a->key > b->key || (a->key == b->key && a->first < b->first);
+}
+
+// Heap sort of clusters by gltf_meshopt_cluster_less().
+static void gltf_meshopt_sift_down(gltf_meshopt_cluster* c, uint32_t root, uint32_t n) {
+  for (;;) {
+    uint32_t child = root * 2u + 1u;
+    if (child >= n) return;
+    if (child + 1u < n && gltf_meshopt_cluster_less(&c[child], &c[child + 1u])) child++;
+    if (!gltf_meshopt_cluster_less(&c[root], &c[child])) return;
+    const gltf_meshopt_cluster t = c[root];
+    c[root] = c[child];
+    c[child] = t;
+    root = child;
+  }
+}
+
+static void gltf_meshopt_sort_clusters(gltf_meshopt_cluster* c, uint32_t n) {
+  for (uint32_t i = n / 2u; i-- > 0;) gltf_meshopt_sift_down(c, i, n);
+  for (uint32_t end = n; end-- > 1u;) {
+    const gltf_meshopt_cluster t = c[0];
+    c[0] = c[end];
+    c[end] = t;
+    gltf_meshopt_sift_down(c, 0u, end);
+  }
+}
+
+// Cross product of the triangle's edges (twice its area-weighted normal) and
+// the sum of its corners (three times its centroid).
+static void gltf_meshopt_tri_geometry(const float* pos, const uint32_t* tri, float n[3], float s[3]) {
+  const float* a = pos + (size_t)tri[0] * 3u;
+  const float* b = pos + (size_t)tri[1] * 3u;
+  const float* c = pos + (size_t)tri[2] * 3u;
+  const float e0[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+  const float e1[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+  n[0] = e0[1] * e1[2] - e0[2] * e1[1];
+  n[1] = e0[2] * e1[0] - e0[0] * e1[2];
+  n[2] = e0[0] * e1[1] - e0[1] * e1[0];
+  for (uint32_t k = 0; k < 3u; k++) s[k] = a[k] + b[k] + c[k];
+}
+
+// Area of a triangle up to a constant factor, without sqrt: the L1 norm of
+// its normal. Only used as a centroid weight.
+static float gltf_meshopt_area_weight(const float n[3]) {
+  const float w = (n[0] < 0.0f ? -n[0] : n[0]) + (n[1] < 0.0f ? -n[1] : n[1]) + (n[2] < 0.0f ? -n[2] : n[2]);
+  return w == w ? w : 0.0f; // NaN positions weigh nothing
+}
+
+// Reorders the clusters of idx in place (Sander et al. 2007): the list is cut
+// where a triangle misses on all three vertices (hard boundaries), and again
+// inside a piece wherever its ACMR so far drops to threshold times the piece's
+// ACMR (soft boundaries). Clusters then sort by how much they face away from
+// the mesh centroid, so the outside of a closed mesh draws before what it
+// hides. Returns 0 on allocation failure.
+static int gltf_meshopt_overdraw(uint32_t* idx,
+                                 uint32_t tri_count,
+                                 const float* pos,
+                                 uint32_t vertex_count,
+                                 uint32_t cache_size,
+                                 float threshold) {
+  uint32_t* stamp = (uint32_t*)calloc(vertex_count, sizeof(uint32_t));
+  uint32_t* hard = (uint32_t*)malloc(((size_t)tri_count + 1u) * sizeof(uint32_t));
+  gltf_meshopt_cluster* clusters = (gltf_meshopt_cluster*)malloc((size_t)tri_count * sizeof(gltf_meshopt_cluster));
+  uint32_t* sorted = (uint32_t*)malloc((size_t)tri_count * 3u * sizeof(uint32_t));
+  if (!stamp || !hard || !clusters || !sorted) {
+    free(stamp);
+    free(hard);
+    free(clusters);
+    free(sorted);
+    return 0;
+  }
+
+  // Hard boundaries.
+  uint32_t time = cache_size + 1u;
+  uint32_t hard_count = 0;
+  for (uint32_t t = 0; t < tri_count; t++) {
+    uint32_t misses = 0;
+    for (uint32_t c = 0; c < 3u; c++) misses += (uint32_t)gltf_fifo_touch(stamp, &time, cache_size, idx[t * 3u + c]);
+    if (t == 0 || misses == 3u) hard[hard_count++] = t;
+  }
+  hard[hard_count] = tri_count;
+
+  // Soft boundaries, with the cache flushed at the start of every piece.
+  uint32_t cluster_count = 0;
+  for (uint32_t h = 0; h < hard_count; h++) {
+    const uint32_t begin = hard[h];
+    const uint32_t end = hard[h + 1u];
+
+    time += cache_size + 1u;
+    uint32_t misses = 0;
+    for (uint32_t t = begin; t < end; t++) {
+      for (uint32_t c = 0; c < 3u; c++) misses += (uint32_t)gltf_fifo_touch(stamp, &time, cache_size, idx[t * 3u + c]);
+    }
+    const float limit = threshold * (float)misses / (float)(end - begin);
+
+    time += cache_size + 1u;
+    uint32_t start = begin;
+    misses = 0;
+    for (uint32_t t = begin; t < end; t++) {
+      for (uint32_t c = 0; c < 3u; c++) misses += (uint32_t)gltf_fifo_touch(stamp, &time, cache_size, idx[t * 3u + c]);
+      if (t + 1u < end && (float)misses <= limit * (float)(t + 1u - start)) {
+        clusters[cluster_count].first = start;
+        clusters[cluster_count].count = t + 1u - start;
+        cluster_count++;
+        start = t + 1u;
+        misses = 0;
+        time += cache_size + 1u;
+      }
+    }
+    clusters[cluster_count].first = start;
+    clusters[cluster_count].count = end - start;
+    cluster_count++;
+  }
+
+  // Area-weighted mesh centroid.
+  double center[3] = { 0.0, 0.0, 0.0 };
+  double total = 0.0;
+  for (uint32_t t = 0; t < tri_count; t++) {
+    float n[3], s[3];
+    gltf_meshopt_tri_geometry(pos, idx + (size_t)t * 3u, n, s);
+    const float w = gltf_meshopt_area_weight(n);
+    for (uint32_t k = 0; k < 3u; k++) center[k] += (double)w * s[k];
+    total += w;
+  }
+  for (uint32_t k = 0; k < 3u; k++) center[k] = total > 0.0 ? center[k] / (3.0 * total) : 0.0;
+
+  // Key: signed distance of the cluster centroid from the mesh centroid along
+  // the cluster normal. d / |n| is compared as d * |d| / |n|^2 (no sqrt).
+  for (uint32_t ci = 0; ci < cluster_count; ci++) {
+    gltf_meshopt_cluster* cl = &clusters[ci];
+    double nsum[3] = { 0.0, 0.0, 0.0 };
+    double csum[3] = { 0.0, 0.0, 0.0 };
+    double wsum = 0.0;
+    for (uint32_t t = cl->first; t < cl->first + cl->count; t++) {
+      float n[3], s[3];
+      gltf_meshopt_tri_geometry(pos, idx + (size_t)t * 3u, n, s);
+      const float w = gltf_meshopt_area_weight(n);
+      for (uint32_t k = 0; k < 3u; k++) {
+        nsum[k] += n[k];
+        csum[k] += (double)w * s[k];
+      }
+      wsum += w;
+    }
+    const double len2 = nsum[0] * nsum[0] + nsum[1] * nsum[1] + nsum[2] * nsum[2];
+    double d = 0.0;
+    if (wsum > 0.0) {
+      for (uint32_t k = 0; k < 3u; k++) d += (csum[k] / (3.0 * wsum) - center[k]) * nsum[k];
+    }
+    const double key = len2 > 0.0 ? d * (d < 0.0 ? -d : d) / len2 : 0.0;
+    cl->key = key == key ? (float)key : 0.0f;
+  }
+
+  gltf_meshopt_sort_clusters(clusters, cluster_count);
+  size_t written = 0;
+  for (uint32_t ci = 0; ci < cluster_count; ci++) {
+    const size_t n = (size_t)clusters[ci].count * 3u;
+    memcpy(sorted + written, idx + (size_t)clusters[ci].first * 3u, n * sizeof(uint32_t));
+    written += n;
+  }
+  memcpy(idx, sorted, written * sizeof(uint32_t));
+
+  free(stamp);
+  free(hard);
+  free(clusters);
+  free(sorted);
+  return 1;
+}
+
+
+// ----------------------------------------------------------------------------
+// Primitive optimization
+// ----------------------------------------------------------------------------
+
+static int gltf_meshopt_options_valid(const gltf_mesh_opt_options* o) {
+  const uint32_t known = GLTF_MESH_OPT_VERTEX_CACHE | GLTF_MESH_OPT_OVERDRAW | GLTF_MESH_OPT_VERTEX_FETCH;
+  if ((o->flags & ~known) != 0 || o->cache_size > GLTF_MESH_OPT_MAX_CACHE_SIZE) return 0;
+  return o->index_component_type == 0 || o->index_component_type == GLTF_COMP_U16 ||
+         o->index_component_type == GLTF_COMP_U32;
+}
+
+gltf_result gltf_doc_primitive_optimize_indices(const gltf_doc* doc,
+                                                uint32_t primitive_index,
+                                                const gltf_mesh_opt_options* options,
+                                                gltf_optimized_indices* out,
+                                                gltf_error* out_err) {
+  gltf_mesh_opt_options opts = {0};
+  opts.flags = GLTF_MESH_OPT_VERTEX_CACHE;
+  if (options) opts = *options;
+  if (!doc || !out || !gltf_meshopt_options_valid(&opts)) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+  const uint32_t cache_size = opts.cache_size ? opts.cache_size : GLTF_MESH_OPT_DEFAULT_CACHE_SIZE;
+  const float threshold = opts.overdraw_threshold > 0.0f ? opts.overdraw_threshold : GLTF_MESH_OPT_DEFAULT_THRESHOLD;
+
+  uint32_t vertex_count = 0;
+  uint32_t tri_count = 0;
+  gltf_result r = gltf_doc_primitive_vertex_count(doc, primitive_index, &vertex_count, out_err);
+  if (r != GLTF_OK) return r;
+  r = gltf_doc_primitive_triangle_count(doc, primitive_index, &tri_count, out_err);
+  if (r != GLTF_OK) return r;
+  if (tri_count > (UINT32_MAX - GLTF_MESH_OPT_MAX_CACHE_SIZE - 1u) / 3u) {
+    gltf_set_err(out_err, "too many triangles", "root.meshes[].primitives[]", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+  const uint32_t index_count = tri_count * 3u;
+
+  uint32_t* idx = NULL;
+  uint32_t* remap = NULL;
+  float* pos = NULL;
+  if (tri_count > 0) {
+    idx = (uint32_t*)malloc((size_t)index_count * sizeof(uint32_t));
+    if (!idx) goto oom;
+    r = gltf_doc_primitive_read_triangles(doc, primitive_index, 0, tri_count, (gltf_tri*)idx, out_err);
+    if (r != GLTF_OK) {
+      free(idx);
+      return r;
+    }
+    for (uint32_t i = 0; i < index_count; i++) {
+      if (idx[i] >= vertex_count) {
+        free(idx);
+        gltf_set_err(out_err, "index out of range", "root.meshes[].primitives[].indices", 1, 1);
+        return GLTF_ERR_PARSE;
+      }
+    }
+
+    if (opts.flags & GLTF_MESH_OPT_VERTEX_CACHE) {
+      uint32_t* ordered = (uint32_t*)malloc((size_t)index_count * sizeof(uint32_t));
+      if (!ordered || !gltf_meshopt_tipsify(idx, tri_count, vertex_count, cache_size, ordered)) {
+        free(ordered);
+        goto oom;
+      }
+      free(idx);
+      idx = ordered;
+    }
+
+    if (opts.flags & GLTF_MESH_OPT_OVERDRAW) {
+      pos = (float*)malloc((size_t)vertex_count * 3u * sizeof(float));
+      if (!pos) goto oom;
+      const gltf_vertex_attrib attrib = { GLTF_ATTR_SLOT_POSITION, GLTF_VERTEX_F32, 3u, 0u };
+      const gltf_vertex_layout layout = { &attrib, 1u, 3u * (uint32_t)sizeof(float) };
+      r = gltf_doc_primitive_pack_vertices(doc, primitive_index, &layout, 0, vertex_count, pos, out_err);
+      if (r != GLTF_OK) {
+        free(pos);
+        free(idx);
+        return r;
+      }
+      if (!gltf_meshopt_overdraw(idx, tri_count, pos, vertex_count, cache_size, threshold)) goto oom;
+      free(pos);
+      pos = NULL;
+    }
+  }
+
+  // Vertex fetch: map[v] is the new number of source vertex v.
+  uint32_t out_vertex_count = vertex_count;
+  if (opts.flags & GLTF_MESH_OPT_VERTEX_FETCH) {
+    out_vertex_count = 0;
+    if (vertex_count > 0 && index_count > 0) {
+      uint32_t* map = (uint32_t*)malloc((size_t)vertex_count * sizeof(uint32_t));
+      remap = (uint32_t*)malloc((size_t)vertex_count * sizeof(uint32_t));
+      if (!map || !remap) {
+        free(map);
+        goto oom;
+      }
+      memset(map, 0xFF, (size_t)vertex_count * sizeof(uint32_t));
+      for (uint32_t i = 0; i < index_count; i++) {
+        const uint32_t v = idx[i];
+        if (map[v] == GLTF_MESH_OPT_UNUSED) {
+          map[v] = out_vertex_count;
+          remap[out_vertex_count++] = v;
+        }
+        idx[i] = map[v];
+      }
+      free(map);
+      uint32_t* trimmed = (uint32_t*)realloc(remap, (size_t)out_vertex_count * sizeof(uint32_t));
+      if (trimmed) remap = trimmed;
+    }
+  }
+
+  uint32_t max_index = 0;
+  for (uint32_t i = 0; i < index_count; i++) {
+    if (idx[i] > max_index) max_index = idx[i];
+  }
+  uint32_t type = opts.index_component_type;
+  if (type == 0) type = max_index <= 0xFFFFu ? GLTF_COMP_U16 : GLTF_COMP_U32;
+  if (type == GLTF_COMP_U16 && max_index > 0xFFFFu) {
+    free(idx);
+    free(remap);
+    gltf_set_err(out_err, "indices do not fit in 16 bits", "options.index_component_type", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+
+  void* indices = idx;
+  if (type == GLTF_COMP_U16 && index_count > 0) {
+    uint16_t* narrow = (uint16_t*)malloc((size_t)index_count * sizeof(uint16_t));
+    if (!narrow) goto oom;
+    for (uint32_t i = 0; i < index_count; i++) narrow[i] = (uint16_t)idx[i];
+    free(idx);
+    indices = narrow;
+  }
+
+  out->indices = indices;
+  out->index_count = index_count;
+  out->index_component_type = type;
+  out->vertex_remap = remap;
+  out->vertex_count = out_vertex_count;
+  gltf_set_err(out_err, NULL, NULL, 0, 0);
+  return GLTF_OK;
+
+oom:
+  free(idx);
+  free(remap);
+  free(pos);
+  gltf_set_err(out_err, "out of memory", "root", 1, 1);
+  return GLTF_ERR_IO;
+}
+
+void gltf_optimized_indices_free(gltf_optimized_indices* p) {
+  if (!p) return;
+  free(p->indices);
+  free(p->vertex_remap);
+  memset(p, 0, sizeof *p);
+}
+
+
+// ----------------------------------------------------------------------------
+// Batches
+// ----------------------------------------------------------------------------
+
+typedef struct gltf_meshopt_batch {
+  const gltf_doc* doc;
+  const gltf_mesh_opt_options* options;
+  gltf_mesh_opt_job* jobs;
+} gltf_meshopt_batch;
+
+// One task per job; tasks touch only their own job.
+static void gltf_meshopt_batch_task(void* user, uint32_t task_index) {
+  const gltf_meshopt_batch* b = (const gltf_meshopt_batch*)user;
+  gltf_mesh_opt_job* job = &b->jobs[task_index];
+  gltf_error err = {0};
+
+  memset(&job->out, 0, sizeof job->out);
+  job->result = gltf_doc_primitive_optimize_indices(b->doc, job->primitive_index, b->options, &job->out, &err);
+  job->error = err;
+}
+
+gltf_result gltf_doc_optimize_indices_batch(const gltf_doc* doc,
+                                            const gltf_mesh_opt_options* options,
+                                            gltf_mesh_opt_job* jobs,
+                                            uint32_t job_count,
+                                            gltf_dispatch_fn dispatch,
+                                            void* dispatch_user,
+                                            gltf_error* out_err) {
+  if (!doc || (job_count > 0 && !jobs)) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+  if (job_count == 0) return GLTF_OK;
+
+  gltf_meshopt_batch batch = { doc, options, jobs };
+  if (dispatch) {
+    dispatch(dispatch_user, job_count, gltf_meshopt_batch_task, &batch);
+  } else {
+    for (uint32_t i = 0; i < job_count; i++) gltf_meshopt_batch_task(&batch, i);
+  }
+
+  for (uint32_t i = 0; i < job_count; i++) {
+    if (jobs[i].result != GLTF_OK) {
+      if (out_err) *out_err = jobs[i].error;
+      return jobs[i].result;
+    }
+  }
+  gltf_set_err(out_err, NULL, NULL, 0, 0);
+  return GLTF_OK;
+}
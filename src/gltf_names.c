@@ -0,0 +1,290 @@
+// Minimal educational glTF 2.0 loader (C11).
+//
+// This module implements name lookups for nodes, meshes and materials.
+//
+// Responsibilities:
+//   - build the optional per-kind name index at load time (hash slots +
+//     name-sorted list, carved from the document block)
+//   - find objects by exact name or by name prefix, through the index when it
+//     was built and by scanning otherwise
+//
+// Notes:
+//   - Public API contracts are documented in include/gltf/gltf.h.
+//   - Both paths return the same results: lowest index for exact names, name
+//     order (then index) for prefixes.
+
+
+#include "gltf_internal.h"
+
+
+// ----------------------------------------------------------------------------
+// Names per kind
+// ----------------------------------------------------------------------------
+
+typedef struct gltf_name_ref {
+  const char* ptr;
+  size_t len;
+} gltf_name_ref;
+
+static uint32_t gltf_name_count(const gltf_doc* doc, uint32_t kind) {
+  switch (kind) {
+    case GLTF_NAME_NODE:     return doc->node_count;
+    case GLTF_NAME_MESH:     return doc->mesh_count;
+    case GLTF_NAME_MATERIAL: return doc->material_count;
+    default:                 return 0u;
+  }
+}
+
+// Name of object i, or 0 if it is unnamed.
+static int gltf_name_get(const gltf_doc* doc, uint32_t kind, uint32_t i, gltf_name_ref* out) {
+  const char* p = NULL;
+  size_t len = 0;
+  switch (kind) {
+    case GLTF_NAME_NODE:
+      p = arena_get_str(&doc->arena, doc->nodes[i].name);
+      len = doc->nodes[i].name.len;
+      break;
+    case GLTF_NAME_MESH:
+      p = arena_get_str(&doc->arena, doc->meshes[i].name);
+      len = doc->meshes[i].name.len;
+      break;
+    case GLTF_NAME_MATERIAL:
+      p = doc->materials[i].name;
+      len = p ? strlen(p) : 0u;
+      break;
+    default:
+      break;
+  }
+  if (!p) return 0;
+  out->ptr = p;
+  out->len = len;
+  return 1;
+}
+
+static int gltf_name_equal(gltf_name_ref a, gltf_name_ref b) {
+  return a.len == b.len && memcmp(a.ptr, b.ptr, a.len) == 0;
+}
+
+// Byte-wise order, shorter first on a common prefix.
+static int gltf_name_compare(gltf_name_ref a, gltf_name_ref b) {
+  const size_t n = a.len < b.len ? a.len : b.len;
+  const int c = n ? memcmp(a.ptr, b.ptr, n) : 0;
+  if (c != 0) return c;
+  return (a.len > b.len) - (a.len < b.len);
+}
+
+static int gltf_name_has_prefix(gltf_name_ref name, gltf_name_ref prefix) {
+  return name.len >= prefix.len && memcmp(name.ptr, prefix.ptr, prefix.len) == 0;
+}
+
+// Order of gltf_doc_find_name_prefix() results: name, then index. Both
+// objects must be named.
+static int gltf_name_less(const gltf_doc* doc, uint32_t kind, uint32_t a, uint32_t b) {
+  gltf_name_ref na = { NULL, 0u };
+  gltf_name_ref nb = { NULL, 0u };
+  (void)gltf_name_get(doc, kind, a, &na);
+  (void)gltf_name_get(doc, kind, b, &nb);
+  const int c = gltf_name_compare(na, nb);
+  return c < 0 || (c == 0 && a < b);
+}
+
+// FNV-1a.
+static uint32_t gltf_name_hash(gltf_name_ref name) {
+  uint32_t h = 2166136261u;
+  for (size_t i = 0; i < name.len; i++) {
+    h ^= (uint8_t)name.ptr[i];
+    h *= 16777619u;
+  }
+  return h;
+}
+
+
+// ----------------------------------------------------------------------------
+// Index build
+// ----------------------------------------------------------------------------
+
+// Smallest power of two >= 2 * count (at least 2): load factor <= 1/2.
+static size_t gltf_name_slot_cap(size_t count) {
+  size_t cap = 2u;
+  while (cap < count * 2u && cap < ((size_t)1 << 31)) cap *= 2u;
+  return cap;
+}
+
+static size_t gltf_name_index_bytes(size_t count) {
+  return gltf_size_add(gltf_block_bytes(gltf_name_slot_cap(count), sizeof(uint32_t)),
+                       gltf_block_bytes(count, sizeof(uint32_t)));
+}
+
+size_t gltf_name_index_presize(yyjson_val* root, uint32_t sections) {
+  size_t bytes = 0;
+  const size_t nodes = (sections & GLTF_LOAD_SECTION_SCENES) ? yyjson_arr_size(yyjson_obj_get(root, "nodes")) : 0u;
+  const size_t meshes = (sections & GLTF_LOAD_SECTION_MESHES) ? yyjson_arr_size(yyjson_obj_get(root, "meshes")) : 0u;
+  const size_t materials =
+    (sections & GLTF_LOAD_SECTION_MATERIALS) ? yyjson_arr_size(yyjson_obj_get(root, "materials")) : 0u;
+  bytes = gltf_size_add(bytes, gltf_name_index_bytes(nodes));
+  bytes = gltf_size_add(bytes, gltf_name_index_bytes(meshes));
+  bytes = gltf_size_add(bytes, gltf_name_index_bytes(materials));
+  return bytes;
+}
+
+// Heap sort of idx[0..n) by gltf_name_less() (in place, no scratch memory).
+static void gltf_name_sift_down(const gltf_doc* doc, uint32_t kind, uint32_t* idx, uint32_t root, uint32_t n) {
+  for (;;) {
+    uint32_t child = root * 2u + 1u;
+    if (child >= n) return;
+    if (child + 1u < n && gltf_name_less(doc, kind, idx[child], idx[child + 1u])) child++;
+    if (!gltf_name_less(doc, kind, idx[root], idx[child])) return;
+    const uint32_t t = idx[root];
+    idx[root] = idx[child];
+    idx[child] = t;
+    root = child;
+  }
+}
+
+static void gltf_name_sort(const gltf_doc* doc, uint32_t kind, uint32_t* idx, uint32_t n) {
+  for (uint32_t i = n / 2u; i-- > 0;) gltf_name_sift_down(doc, kind, idx, i, n);
+  for (uint32_t end = n; end-- > 1u;) {
+    const uint32_t t = idx[0];
+    idx[0] = idx[end];
+    idx[end] = t;
+    gltf_name_sift_down(doc, kind, idx, 0u, end);
+  }
+}
+
+int gltf_doc_build_name_index(gltf_doc* doc) {
+  for (uint32_t kind = 0; kind < GLTF_NAME_KIND_COUNT; kind++) {
+    gltf_name_index* ni = &doc->name_index[kind];
+    const uint32_t count = gltf_name_count(doc, kind);
+    const size_t cap = gltf_name_slot_cap(count);
+
+    ni->slots = (uint32_t*)gltf_doc_carve(doc, cap, sizeof(uint32_t));
+    ni->sorted = (uint32_t*)gltf_doc_carve(doc, count, sizeof(uint32_t));
+    if (!ni->slots || !ni->sorted) return 0;
+    ni->slot_cap = (uint32_t)cap;
+
+    const uint32_t mask = ni->slot_cap - 1u;
+    for (uint32_t i = 0; i < count; i++) {
+      gltf_name_ref name;
+      if (!gltf_name_get(doc, kind, i, &name)) continue;
+      ni->sorted[ni->sorted_count++] = i;
+
+      // Ascending insertion keeps the lowest index of duplicate names.
+      uint32_t s = gltf_name_hash(name) & mask;
+      for (;;) {
+        const uint32_t e = ni->slots[s];
+        if (e == 0u) {
+          ni->slots[s] = i + 1u;
+          break;
+        }
+        gltf_name_ref other = { NULL, 0u };
+        (void)gltf_name_get(doc, kind, e - 1u, &other);
+        if (gltf_name_equal(name, other)) break;
+        s = (s + 1u) & mask;
+      }
+    }
+    gltf_name_sort(doc, kind, ni->sorted, ni->sorted_count);
+  }
+  return 1;
+}
+
+
+// ----------------------------------------------------------------------------
+// Lookups
+// ----------------------------------------------------------------------------
+
+// The kind's index, or NULL if it was not built. Entries are range-checked on
+// use, so a baked file cannot point them past the arrays.
+static const gltf_name_index* gltf_name_index_get(const gltf_doc* doc, uint32_t kind) {
+  const gltf_name_index* ni = &doc->name_index[kind];
+  return ni->slots && ni->slot_cap > 0u ? ni : NULL;
+}
+
+// Name of sorted[i], or 0 if the entry is out of range or unnamed.
+static int gltf_name_sorted_at(const gltf_doc* doc,
+                               uint32_t kind,
+                               const gltf_name_index* ni,
+                               uint32_t i,
+                               gltf_name_ref* out) {
+  const uint32_t e = ni->sorted[i];
+  return e < gltf_name_count(doc, kind) && gltf_name_get(doc, kind, e, out);
+}
+
+int32_t gltf_doc_find_name(const gltf_doc* doc, gltf_name_kind kind, const char* name) {
+  if (!doc || !name || (uint32_t)kind >= GLTF_NAME_KIND_COUNT) return -1;
+
+  const gltf_name_ref key = { name, strlen(name) };
+  const uint32_t count = gltf_name_count(doc, kind);
+  const gltf_name_index* ni = gltf_name_index_get(doc, kind);
+  gltf_name_ref other;
+
+  if (ni) {
+    const uint32_t mask = ni->slot_cap - 1u;
+    uint32_t s = gltf_name_hash(key) & mask;
+    for (uint32_t probes = 0; probes < ni->slot_cap; probes++) {
+      const uint32_t e = ni->slots[s];
+      if (e == 0u || e > count) return -1;
+      if (gltf_name_get(doc, kind, e - 1u, &other) && gltf_name_equal(key, other)) return (int32_t)(e - 1u);
+      s = (s + 1u) & mask;
+    }
+    return -1;
+  }
+
+  for (uint32_t i = 0; i < count; i++) {
+    if (gltf_name_get(doc, kind, i, &other) && gltf_name_equal(key, other)) return (int32_t)i;
+  }
+  return -1;
+}
+
+uint32_t gltf_doc_find_name_prefix(const gltf_doc* doc,
+                                   gltf_name_kind kind,
+                                   const char* prefix,
+                                   uint32_t* out_indices,
+                                   uint32_t max_indices) {
+  if (!doc || !prefix || (uint32_t)kind >= GLTF_NAME_KIND_COUNT) return 0u;
+  if (!out_indices) max_indices = 0;
+
+  const gltf_name_ref key = { prefix, strlen(prefix) };
+  const uint32_t count = gltf_name_count(doc, kind);
+  const gltf_name_index* ni = gltf_name_index_get(doc, kind);
+  gltf_name_ref name;
+
+  if (ni) {
+    const uint32_t n = ni->sorted_count <= count ? ni->sorted_count : 0u;
+
+    // First name >= prefix; the matches follow it contiguously.
+    uint32_t lo = 0, hi = n;
+    while (lo < hi) {
+      const uint32_t mid = lo + (hi - lo) / 2u;
+      if (!gltf_name_sorted_at(doc, kind, ni, mid, &name)) return 0u;
+      if (gltf_name_compare(name, key) < 0) {
+        lo = mid + 1u;
+      } else {
+        hi = mid;
+      }
+    }
+    uint32_t matches = 0;
+    for (uint32_t i = lo; i < n; i++) {
+      if (!gltf_name_sorted_at(doc, kind, ni, i, &name)) return 0u;
+      if (!gltf_name_has_prefix(name, key)) break;
+      if (matches < max_indices) out_indices[matches] = ni->sorted[i];
+      matches++;
+    }
+    return matches;
+  }
+
+  // Scan, keeping the first max_indices matches in result order.
+  uint32_t matches = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    if (!gltf_name_get(doc, kind, i, &name) || !gltf_name_has_prefix(name, key)) continue;
+    uint32_t kept = matches < max_indices ? matches : max_indices;
+    matches++;
+    if (kept == max_indices && (kept == 0u || !gltf_name_less(doc, kind, i, out_indices[kept - 1u]))) continue;
+    if (kept == max_indices) kept--;
+    while (kept > 0u && gltf_name_less(doc, kind, i, out_indices[kept - 1u])) {
+      out_indices[kept] = out_indices[kept - 1u];
+      kept--;
+    }
+    out_indices[kept] = i;
+  }
+  return matches;
+}
@@ -0,0 +1,424 @@
+// Minimal educational glTF 2.0 loader (C11).
+//
+// This module implements interleaved vertex packing of primitive attributes.
+//
+// Responsibilities:
+//   - validate a gltf_vertex_layout against a primitive's slot table
+//   - decode each packed slot in blocks (bulk accessor decode kernels) and
+//     expand it to 4 components with the (0, 0, 0, 1) defaults
+//   - convert blocks to the target formats (f32, f16, snorm/unorm, integers,
+//     octahedral normals) and scatter them into the interleaved vertices
+//   - pack lists of primitives / ranges through a gltf_dispatch_fn
+//
+// Notes:
+//   - Public API contracts are documented in include/gltf/gltf.h.
+//   - Conversions use gltf_f32x4 (one IEEE operation per lane), and the f16
+//     SSE2 kernel mirrors the scalar integer code, so every backend writes
+//     the same bytes.
+
+
+#include "gltf_internal.h"
+#include "gltf_simd.h"
+
+
+// Vertices decoded and converted per block.
+#define GLTF_PACK_BLOCK 64u
+
+// x + M - M rounds |x| < 2^22 to the nearest integer (ties to even).
+#define GLTF_PACK_ROUND_MAGIC 12582912.0f
+
+
+// ----------------------------------------------------------------------------
+// Formats
+// ----------------------------------------------------------------------------
+
+// Bytes of one component, or 0 for an unknown format.
+static uint32_t gltf_pack_format_size(uint32_t format) {
+  switch (format) {
+    case GLTF_VERTEX_F32:         return 4u;
+    case GLTF_VERTEX_F16:
+    case GLTF_VERTEX_SNORM16:
+    case GLTF_VERTEX_UNORM16:
+    case GLTF_VERTEX_U16:
+    case GLTF_VERTEX_OCT_SNORM16: return 2u;
+    case GLTF_VERTEX_SNORM8:
+    case GLTF_VERTEX_UNORM8:
+    case GLTF_VERTEX_U8:          return 1u;
+    default:                      return 0u;
+  }
+}
+
+static uint32_t gltf_pack_components(const gltf_vertex_attrib* a) {
+  return a->format == GLTF_VERTEX_OCT_SNORM16 ? 2u : a->components;
+}
+
+static int gltf_pack_layout_valid(const gltf_vertex_layout* layout) {
+  if (!layout || layout->stride == 0 || (layout->attrib_count > 0 && !layout->attribs)) return 0;
+  for (uint32_t i = 0; i < layout->attrib_count; i++) {
+    const gltf_vertex_attrib* a = &layout->attribs[i];
+    const uint32_t size = gltf_pack_format_size(a->format);
+    const uint32_t comps = gltf_pack_components(a);
+    if (a->slot >= GLTF_ATTR_SLOT_COUNT || size == 0 || comps == 0 || comps > 4u) return 0;
+    if ((uint64_t)a->offset + (uint64_t)size * comps > layout->stride) return 0;
+  }
+  return 1;
+}
+
+// Clamp range and scale of the normalized and integer formats.
+static void gltf_pack_norm_params(uint32_t format, float* lo, float* hi, float* scale) {
+  *lo = 0.0f;
+  *hi = 1.0f;
+  switch (format) {
+    case GLTF_VERTEX_SNORM16:
+    case GLTF_VERTEX_OCT_SNORM16: *lo = -1.0f; *scale = 32767.0f; break;
+    case GLTF_VERTEX_UNORM16:     *scale = 65535.0f; break;
+    case GLTF_VERTEX_SNORM8:      *lo = -1.0f; *scale = 127.0f; break;
+    case GLTF_VERTEX_UNORM8:      *scale = 255.0f; break;
+    case GLTF_VERTEX_U16:         *hi = 65535.0f; *scale = 1.0f; break;
+    default:                      *hi = 255.0f; *scale = 1.0f; break; // U8
+  }
+}
+
+// clamp(v, lo, hi) * scale, rounded; NaN becomes hi * scale.
+static inline gltf_f32x4 gltf_pack_norm4(gltf_f32x4 v, gltf_f32x4 lo, gltf_f32x4 hi, gltf_f32x4 scale) {
+  const gltf_f32x4 magic = gltf_f32x4_set1(GLTF_PACK_ROUND_MAGIC);
+  v = gltf_f32x4_max(gltf_f32x4_min(v, hi), lo);
+  return gltf_f32x4_sub(gltf_f32x4_add(gltf_f32x4_mul(v, scale), magic), magic);
+}
+
+// Stores comps rounded values (exact integers) as the format's integer type.
+static void gltf_pack_store_ints(uint8_t* dst, const float* r, uint32_t comps, uint32_t format) {
+  for (uint32_t k = 0; k < comps; k++) {
+    switch (format) {
+      case GLTF_VERTEX_SNORM16:
+      case GLTF_VERTEX_OCT_SNORM16: {
+        const int16_t v = (int16_t)r[k];
+        memcpy(dst + k * 2u, &v, sizeof v);
+        break;
+      }
+      case GLTF_VERTEX_UNORM16:
+      case GLTF_VERTEX_U16: {
+        const uint16_t v = (uint16_t)r[k];
+        memcpy(dst + k * 2u, &v, sizeof v);
+        break;
+      }
+      case GLTF_VERTEX_SNORM8:
+        dst[k] = (uint8_t)(int8_t)r[k];
+        break;
+      default: // UNORM8, U8
+        dst[k] = (uint8_t)r[k];
+        break;
+    }
+  }
+}
+
+
+// ----------------------------------------------------------------------------
+// f32 -> f16
+// ----------------------------------------------------------------------------
+//
+// Round to nearest even. Overflow gives infinity, NaN a quiet NaN (0x7E00),
+// results below the normal range are rounded into the subnormals. The SSE2
+// kernel runs the same integer steps on 4 lanes.
+
+#if !GLTF_SIMD_SSE2
+
+static uint16_t gltf_f32_to_f16(float f) {
+  uint32_t x;
+  memcpy(&x, &f, sizeof x);
+  const uint32_t sign = x & 0x80000000u;
+  x ^= sign;
+
+  uint32_t h;
+  if (x >= 0x47800000u) {
+    h = x > 0x7F800000u ? 0x7E00u : 0x7C00u;
+  } else if (x < 0x38800000u) {
+    // Adding 0.5f lines the half subnormal grid up with the float mantissa.
+    float t;
+    memcpy(&t, &x, sizeof t);
+    t += 0.5f;
+    memcpy(&h, &t, sizeof h);
+    h -= 0x3F000000u;
+  } else {
+    const uint32_t odd = (x >> 13) & 1u;
+    x += 0xC8000FFFu; // rebias exponent (15 - 127) and add the rounding bias
+    h = (x + odd) >> 13;
+  }
+  return (uint16_t)(h | (sign >> 16));
+}
+
+#else
+
+// gltf_f32_to_f16() on 4 lanes (results in the low 16 bits of each lane).
+static inline __m128i gltf_f32x4_to_f16(__m128 v) {
+  __m128i x = _mm_castps_si128(v);
+  const __m128i sign = _mm_and_si128(x, _mm_set1_epi32((int)0x80000000u));
+  x = _mm_xor_si128(x, sign);
+
+  const __m128i is_big = _mm_cmpgt_epi32(x, _mm_set1_epi32(0x477FFFFF));
+  const __m128i is_nan = _mm_cmpgt_epi32(x, _mm_set1_epi32(0x7F800000));
+  const __m128i is_small = _mm_cmplt_epi32(x, _mm_set1_epi32(0x38800000));
+
+  const __m128i big = _mm_or_si128(_mm_set1_epi32(0x7C00), _mm_and_si128(is_nan, _mm_set1_epi32(0x0200)));
+  const __m128i small = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(x), _mm_set1_ps(0.5f))),
+                                      _mm_set1_epi32(0x3F000000));
+  const __m128i odd = _mm_and_si128(_mm_srli_epi32(x, 13), _mm_set1_epi32(1));
+  const __m128i normal =
+    _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(x, _mm_set1_epi32((int)0xC8000FFFu)), odd), 13);
+
+  __m128i h = _mm_or_si128(_mm_and_si128(is_small, small), _mm_andnot_si128(is_small, normal));
+  h = _mm_or_si128(_mm_and_si128(is_big, big), _mm_andnot_si128(is_big, h));
+  return _mm_or_si128(h, _mm_srli_epi32(sign, 16));
+}
+
+#endif
+
+static void gltf_pack_f16(uint8_t* dst, const float* v, uint32_t comps) {
+  uint32_t h[4];
+#if GLTF_SIMD_SSE2
+  _mm_storeu_si128((__m128i*)h, gltf_f32x4_to_f16(_mm_loadu_ps(v)));
+#else
+  for (uint32_t k = 0; k < comps; k++) h[k] = gltf_f32_to_f16(v[k]);
+#endif
+  for (uint32_t k = 0; k < comps; k++) {
+    const uint16_t x = (uint16_t)h[k];
+    memcpy(dst + k * 2u, &x, sizeof x);
+  }
+}
+
+
+// ----------------------------------------------------------------------------
+// Block conversion
+// ----------------------------------------------------------------------------
+
+// Octahedral mapping of 4 vectors (lanes of x, y, z) to [-1, 1]^2.
+static void gltf_pack_oct4(gltf_f32x4 x, gltf_f32x4 y, gltf_f32x4 z, gltf_f32x4* out_u, gltf_f32x4* out_v) {
+  const gltf_f32x4 zero = gltf_f32x4_set1(0.0f);
+  const gltf_f32x4 one = gltf_f32x4_set1(1.0f);
+  const gltf_f32x4 minus_one = gltf_f32x4_set1(-1.0f);
+
+  gltf_f32x4 l1 = gltf_f32x4_add(gltf_f32x4_add(gltf_f32x4_abs(x), gltf_f32x4_abs(y)), gltf_f32x4_abs(z));
+  l1 = gltf_f32x4_max(l1, gltf_f32x4_set1(1e-30f)); // zero vectors map to (0, 0)
+  const gltf_f32x4 px = gltf_f32x4_div(x, l1);
+  const gltf_f32x4 py = gltf_f32x4_div(y, l1);
+
+  // Lower hemisphere: fold over the diagonals.
+  const gltf_f32x4 sx = gltf_f32x4_select_lt(px, zero, minus_one, one);
+  const gltf_f32x4 sy = gltf_f32x4_select_lt(py, zero, minus_one, one);
+  const gltf_f32x4 fx = gltf_f32x4_mul(gltf_f32x4_sub(one, gltf_f32x4_abs(py)), sx);
+  const gltf_f32x4 fy = gltf_f32x4_mul(gltf_f32x4_sub(one, gltf_f32x4_abs(px)), sy);
+  *out_u = gltf_f32x4_select_lt(z, zero, fx, px);
+  *out_v = gltf_f32x4_select_lt(z, zero, fy, py);
+}
+
+// Converts n expanded vertices (4 floats each; v4 holds a multiple of 4
+// vertices) and writes them at dst, stride bytes apart.
+static void gltf_pack_block(const gltf_vertex_attrib* a, const float* v4, uint32_t n, uint8_t* dst, uint32_t stride) {
+  const uint32_t comps = gltf_pack_components(a);
+  if (a->format == GLTF_VERTEX_F32) {
+    for (uint32_t i = 0; i < n; i++) memcpy(dst + (size_t)i * stride, v4 + i * 4u, comps * sizeof(float));
+    return;
+  }
+  if (a->format == GLTF_VERTEX_F16) {
+    for (uint32_t i = 0; i < n; i++) gltf_pack_f16(dst + (size_t)i * stride, v4 + i * 4u, comps);
+    return;
+  }
+
+  float lo, hi, scale;
+  gltf_pack_norm_params(a->format, &lo, &hi, &scale);
+  const gltf_f32x4 vlo = gltf_f32x4_set1(lo), vhi = gltf_f32x4_set1(hi), vscale = gltf_f32x4_set1(scale);
+  float r[4];
+
+  if (a->format == GLTF_VERTEX_OCT_SNORM16) {
+    for (uint32_t i = 0; i < n; i += 4u) {
+      gltf_f32x4 x = gltf_f32x4_load(v4 + i * 4u);
+      gltf_f32x4 y = gltf_f32x4_load(v4 + i * 4u + 4u);
+      gltf_f32x4 z = gltf_f32x4_load(v4 + i * 4u + 8u);
+      gltf_f32x4 w = gltf_f32x4_load(v4 + i * 4u + 12u);
+      gltf_f32x4_transpose(&x, &y, &z, &w);
+
+      gltf_f32x4 u, v;
+      gltf_pack_oct4(x, y, z, &u, &v);
+      float ru[4], rv[4];
+      gltf_f32x4_store(ru, gltf_pack_norm4(u, vlo, vhi, vscale));
+      gltf_f32x4_store(rv, gltf_pack_norm4(v, vlo, vhi, vscale));
+      for (uint32_t k = 0; k < 4u && i + k < n; k++) {
+        r[0] = ru[k];
+        r[1] = rv[k];
+        gltf_pack_store_ints(dst + (size_t)(i + k) * stride, r, 2u, a->format);
+      }
+    }
+    return;
+  }
+
+  for (uint32_t i = 0; i < n; i++) {
+    gltf_f32x4_store(r, gltf_pack_norm4(gltf_f32x4_load(v4 + i * 4u), vlo, vhi, vscale));
+    gltf_pack_store_ints(dst + (size_t)i * stride, r, comps, a->format);
+  }
+}
+
+
+// ----------------------------------------------------------------------------
+// Primitive packing
+// ----------------------------------------------------------------------------
+
+gltf_result gltf_doc_primitive_vertex_count(const gltf_doc* doc,
+                                            uint32_t primitive_index,
+                                            uint32_t* out_vertex_count,
+                                            gltf_error* out_err) {
+  if (!doc || !out_vertex_count || primitive_index >= doc->primitive_count) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+
+  const gltf_prim_slot* pos = &doc->primitives[primitive_index].slots[GLTF_ATTR_SLOT_POSITION];
+  if (pos->accessor < 0) {
+    gltf_set_err(out_err, "primitive has no POSITION", "root.meshes[].primitives[].attributes", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+  if (!pos->valid) {
+    gltf_span sp;
+    return gltf_prim_slot_span(doc, primitive_index, GLTF_ATTR_SLOT_POSITION, &sp, out_err);
+  }
+  *out_vertex_count = pos->layout.count;
+  gltf_set_err(out_err, NULL, NULL, 0, 0);
+  return GLTF_OK;
+}
+
+gltf_result gltf_doc_primitive_pack_vertices(const gltf_doc* doc,
+                                             uint32_t primitive_index,
+                                             const gltf_vertex_layout* layout,
+                                             uint32_t first,
+                                             uint32_t count,
+                                             void* dst,
+                                             gltf_error* out_err) {
+  if (!doc || (!dst && count > 0)) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+  if (!gltf_pack_layout_valid(layout)) {
+    gltf_set_err(out_err, "invalid vertex layout", "layout", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+
+  uint32_t vertex_count = 0;
+  gltf_result r = gltf_doc_primitive_vertex_count(doc, primitive_index, &vertex_count, out_err);
+  if (r != GLTF_OK) return r;
+  if (first > vertex_count || count > vertex_count - first) {
+    gltf_set_err(out_err, "vertex range out of range", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+
+  uint8_t* out = (uint8_t*)dst;
+  float decoded[GLTF_PACK_BLOCK * 4u];
+  float v4[GLTF_PACK_BLOCK * 4u];
+
+  for (uint32_t ai = 0; ai < layout->attrib_count && count > 0; ai++) {
+    const gltf_vertex_attrib* a = &layout->attribs[ai];
+    const gltf_prim_slot* ps = &doc->primitives[primitive_index].slots[a->slot];
+
+    // Source of this slot (none: every vertex is the default).
+    gltf_span sp = { NULL, 0, 0, 0 };
+    const gltf_accessor* acc = NULL;
+    uint32_t cc = 0;
+    if (ps->accessor >= 0) {
+      r = gltf_prim_slot_span(doc, primitive_index, a->slot, &sp, out_err);
+      if (r != GLTF_OK) return r;
+      acc = &doc->accessors[ps->accessor];
+      if (!gltf_accessor_component_count(acc->type, &cc) || cc > 4u) {
+        gltf_set_err(out_err, "attribute has more than 4 components", "root.accessors[].type", 1, 1);
+        return GLTF_ERR_PARSE;
+      }
+      if (sp.count < vertex_count) {
+        gltf_set_err(out_err, "attribute count smaller than POSITION count", "root.accessors[].count", 1, 1);
+        return GLTF_ERR_PARSE;
+      }
+      if (!sp.ptr) {
+        gltf_set_err(out_err, "span has no data", "root", 1, 1);
+        return GLTF_ERR_PARSE;
+      }
+    }
+
+    for (uint32_t b = 0; b < count; b += GLTF_PACK_BLOCK) {
+      const uint32_t n = count - b < GLTF_PACK_BLOCK ? count - b : GLTF_PACK_BLOCK;
+      if (acc) {
+        r = gltf_decode_elements_to_f32(sp.ptr + (size_t)(first + b) * sp.stride, sp.stride, n, cc,
+                                        acc->component_type, acc->normalized ? 1 : 0, decoded, cc);
+        if (r != GLTF_OK) {
+          gltf_set_err(out_err, "failed to decode component", "root.accessors[]", 1, 1);
+          return r;
+        }
+      }
+
+      // Expand to (x, y, z, w) with the (0, 0, 0, 1) defaults; the padding up
+      // to a multiple of 4 vertices feeds the 4-vertex kernels.
+      const uint32_t padded = (n + 3u) & ~3u;
+      for (uint32_t i = 0; i < padded; i++) {
+        float* e = v4 + i * 4u;
+        e[0] = 0.0f;
+        e[1] = 0.0f;
+        e[2] = 0.0f;
+        e[3] = 1.0f;
+        if (i < n) {
+          for (uint32_t k = 0; k < cc; k++) e[k] = decoded[i * cc + k];
+        }
+      }
+      gltf_pack_block(a, v4, n, out + (size_t)b * layout->stride + a->offset, layout->stride);
+    }
+  }
+
+  gltf_set_err(out_err, NULL, NULL, 0, 0);
+  return GLTF_OK;
+}
+
+
+// ----------------------------------------------------------------------------
+// Batches
+// ----------------------------------------------------------------------------
+
+typedef struct gltf_pack_batch {
+  const gltf_doc* doc;
+  const gltf_vertex_layout* layout;
+  gltf_vertex_pack_job* jobs;
+} gltf_pack_batch;
+
+// One task per job; tasks touch only their own job and destination.
+static void gltf_pack_batch_task(void* user, uint32_t task_index) {
+  const gltf_pack_batch* b = (const gltf_pack_batch*)user;
+  gltf_vertex_pack_job* job = &b->jobs[task_index];
+  gltf_error err = {0};
+
+  job->result = gltf_doc_primitive_pack_vertices(b->doc, job->primitive_index, b->layout, job->first, job->count,
+                                                 job->dst, &err);
+  job->error = err;
+}
+
+gltf_result gltf_doc_pack_vertices_batch(const gltf_doc* doc,
+                                         const gltf_vertex_layout* layout,
+                                         gltf_vertex_pack_job* jobs,
+                                         uint32_t job_count,
+                                         gltf_dispatch_fn dispatch,
+                                         void* dispatch_user,
+                                         gltf_error* out_err) {
+  if (!doc || !layout || (job_count > 0 && !jobs)) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+  if (job_count == 0) return GLTF_OK;
+
+  gltf_pack_batch batch = { doc, layout, jobs };
+  if (dispatch) {
+    dispatch(dispatch_user, job_count, gltf_pack_batch_task, &batch);
+  } else {
+    for (uint32_t i = 0; i < job_count; i++) gltf_pack_batch_task(&batch, i);
+  }
+
+  for (uint32_t i = 0; i < job_count; i++) {
+    if (jobs[i].result != GLTF_OK) {
+      if (out_err) *out_err = jobs[i].error;
+      return jobs[i].result;
+    }
+  }
+  gltf_set_err(out_err, NULL, NULL, 0, 0);
+  return GLTF_OK;
+}
@@ -26,7 +26,8 @@ typedef enum gltf_fs_status {
   GLTF_FS_IO,
   GLTF_FS_OOM,
   GLTF_FS_SIZE_MISMATCH,
-  GLTF_FS_TOO_LARGE
+  GLTF_FS_TOO_LARGE,
+  GLTF_FS_BAD_ARGUMENT
 } gltf_fs_status;
 
 size_t gltf_fs_dir_len(const char* path);
@@ -35,10 +36,17 @@ char* gltf_fs_join_dir_leaf(const char* dir_prefix,
                             size_t dir_len,
                             const char* leaf);
 
-gltf_fs_status gltf_fs_read_file_exact_u32(const char* path,
-                                           uint32_t expected_len,
-                                           uint8_t** out_data,
-                                           uint32_t* out_len);
+gltf_fs_status gltf_fs_map_file_io(const gltf_io* io,
+                                   const char* path,
+                                   uint32_t expected_len,
+                                   const uint8_t** out_data,
+                                   size_t* out_size);
+
+gltf_fs_status gltf_fs_read_file_exact_u32_io(const gltf_io* io,
+                                              const char* path,
+                                              uint32_t expected_len,
+                                              uint8_t** out_data,
+                                              uint32_t* out_len);
 
 int gltf_path_is_relative(const char* path);
 
@@ -534,6 +542,170 @@ gltf_attr_semantic gltf_parse_semantic(const char* key, uint32_t* out_set_index)
   return GLTF_ATTR_UNKNOWN;
 }
 
+// ----------------------------------------------------------------------------
+// Document presizing
+// ----------------------------------------------------------------------------
+// Walks the yyjson tree once and sums what the parse functions below carve.
+// Shapes are not validated here; anything invalid is rejected while parsing,
+// so the counts only need to be upper bounds for valid input.
+
+// Primitives of all meshes and the attribute keys of those primitives.
+static void gltf_count_mesh_primitives(yyjson_val* meshes_val, size_t* out_prims, size_t* out_attrs) {
+  size_t prims = 0, attrs = 0;
+  size_t mesh_idx, mesh_max, prim_idx, prim_max;
+  yyjson_val *mesh_val, *prim_val;
+  yyjson_arr_foreach(meshes_val, mesh_idx, mesh_max, mesh_val) {
+    yyjson_val* primitives_val = yyjson_obj_get(mesh_val, "primitives");
+    prims = gltf_size_add(prims, yyjson_arr_size(primitives_val));
+    yyjson_arr_foreach(primitives_val, prim_idx, prim_max, prim_val) {
+      attrs = gltf_size_add(attrs, yyjson_obj_size(yyjson_obj_get(prim_val, "attributes")));
+    }
+  }
+  *out_prims = prims;
+  *out_attrs = attrs;
+}
+
+// Arena bytes for obj[key] if it is a string (including the terminator).
+static size_t gltf_presize_str(yyjson_val* obj, const char* key) {
+  yyjson_val* v = yyjson_obj_get(obj, key);
+  return yyjson_is_str(v) ? gltf_size_add(yyjson_get_len(v), 1u) : 0u;
+}
+
+uint32_t gltf_load_sections_resolve(yyjson_val* root, uint32_t requested) {
+  uint32_t sections = requested ? (requested & GLTF_LOAD_SECTION_ALL) : GLTF_LOAD_SECTION_ALL;
+
+  // Images stored in a bufferView are read through bufferViews and buffers.
+  if ((sections & GLTF_LOAD_SECTION_IMAGES) &&
+      (sections & (GLTF_LOAD_SECTION_ACCESSORS | GLTF_LOAD_SECTION_BUFFERS)) !=
+        (GLTF_LOAD_SECTION_ACCESSORS | GLTF_LOAD_SECTION_BUFFERS)) {
+    size_t idx, max;
+    yyjson_val* it = NULL;
+    yyjson_arr_foreach(yyjson_obj_get(root, "images"), idx, max, it) {
+      if (yyjson_obj_get(it, "bufferView")) {
+        sections |= GLTF_LOAD_SECTION_ACCESSORS | GLTF_LOAD_SECTION_BUFFERS;
+        break;
+      }
+    }
+  }
+  return sections;
+}
+
+// Number of accessors with a "sparse" member (one dense copy slot each).
+static size_t gltf_count_sparse_accessors(yyjson_val* accessors_val) {
+  size_t count = 0, idx, max;
+  yyjson_val* it = NULL;
+  yyjson_arr_foreach(accessors_val, idx, max, it) {
+    if (yyjson_obj_get(it, "sparse")) count++;
+  }
+  return count;
+}
+
+void gltf_doc_presize(yyjson_val* root,
+                      size_t doc_dir_len,
+                      uint32_t sections,
+                      uint32_t ctx_flags,
+                      gltf_doc_sizes* out) {
+  size_t arrays = gltf_block_bytes(1, sizeof(gltf_doc));
+  size_t strings = gltf_size_add(doc_dir_len, 1u); // doc_dir
+  size_t indices = 0;
+  size_t idx, max;
+  yyjson_val* it = NULL;
+  yyjson_val* a = NULL;
+
+  strings = gltf_size_add(strings, gltf_presize_str(yyjson_obj_get(root, "asset"), "generator"));
+
+  if (sections & GLTF_LOAD_SECTION_SCENES) {
+    a = yyjson_obj_get(root, "scenes");
+    arrays = gltf_size_add(arrays, gltf_block_bytes(yyjson_arr_size(a), sizeof(gltf_scene)));
+    yyjson_arr_foreach(a, idx, max, it) {
+      strings = gltf_size_add(strings, gltf_presize_str(it, "name"));
+      indices = gltf_size_add(indices, yyjson_arr_size(yyjson_obj_get(it, "nodes")));
+    }
+
+    a = yyjson_obj_get(root, "nodes");
+    arrays = gltf_size_add(arrays, gltf_block_bytes(yyjson_arr_size(a), sizeof(gltf_node)));
+    yyjson_arr_foreach(a, idx, max, it) {
+      strings = gltf_size_add(strings, gltf_presize_str(it, "name"));
+      indices = gltf_size_add(indices, yyjson_arr_size(yyjson_obj_get(it, "children")));
+    }
+  }
+
+  if (sections & GLTF_LOAD_SECTION_MESHES) {
+    a = yyjson_obj_get(root, "meshes");
+    size_t prims = 0, attrs = 0;
+    gltf_count_mesh_primitives(a, &prims, &attrs);
+    arrays = gltf_size_add(arrays, gltf_block_bytes(yyjson_arr_size(a), sizeof(gltf_mesh)));
+    arrays = gltf_size_add(arrays, gltf_block_bytes(prims, sizeof(gltf_primitive)));
+    arrays = gltf_size_add(arrays, gltf_block_bytes(attrs, sizeof(gltf_prim_attr)));
+    yyjson_arr_foreach(a, idx, max, it) {
+      strings = gltf_size_add(strings, gltf_presize_str(it, "name"));
+    }
+  }
+
+  if (sections & GLTF_LOAD_SECTION_ACCESSORS) {
+    a = yyjson_obj_get(root, "accessors");
+    arrays = gltf_size_add(arrays, gltf_block_bytes(yyjson_arr_size(a), sizeof(gltf_accessor)));
+    arrays = gltf_size_add(arrays, gltf_block_bytes(gltf_count_sparse_accessors(a), sizeof(gltf_sparse_dense)));
+    arrays = gltf_size_add(arrays, gltf_block_bytes(yyjson_arr_size(yyjson_obj_get(root, "bufferViews")),
+                                                    sizeof(gltf_buffer_view)));
+  }
+
+  // Buffer URIs: external ones get the raw copy plus a resolved directory +
+  // leaf path (lazy loads and baking store it). Data URIs are decoded from
+  // the JSON text and only copied when decoding is deferred (lazy).
+  if (sections & GLTF_LOAD_SECTION_BUFFERS) {
+    const int lazy = (ctx_flags & GLTF_LOAD_CTX_LAZY_BUFFERS) != 0;
+    a = yyjson_obj_get(root, "buffers");
+    arrays = gltf_size_add(arrays, gltf_block_bytes(yyjson_arr_size(a), sizeof(gltf_buffer)));
+    yyjson_arr_foreach(a, idx, max, it) {
+      const size_t uri = gltf_presize_str(it, "uri");
+      if (!uri) continue;
+      if (strncmp(yyjson_get_str(yyjson_obj_get(it, "uri")), "data:", 5) != 0) {
+        strings = gltf_size_add(strings, gltf_size_add(gltf_size_add(uri, uri), doc_dir_len));
+      } else if (lazy) {
+        strings = gltf_size_add(strings, uri);
+      }
+    }
+  }
+
+  if (sections & GLTF_LOAD_SECTION_IMAGES) {
+    a = yyjson_obj_get(root, "images");
+    arrays = gltf_size_add(arrays, gltf_block_bytes(yyjson_arr_size(a), sizeof(gltf_image)));
+    arrays = gltf_size_add(arrays, gltf_block_bytes(yyjson_arr_size(a), sizeof(gltf_image_bytes)));
+    yyjson_arr_foreach(a, idx, max, it) {
+      const size_t uri = gltf_presize_str(it, "uri");
+      strings = gltf_size_add(strings, gltf_presize_str(it, "name"));
+      strings = gltf_size_add(strings, gltf_presize_str(it, "mimeType"));
+      // Image URIs are always copied; only file URIs get a resolved path.
+      strings = gltf_size_add(strings, uri);
+      if (uri && strncmp(yyjson_get_str(yyjson_obj_get(it, "uri")), "data:", 5) != 0) {
+        strings = gltf_size_add(strings, gltf_size_add(uri, doc_dir_len));
+      }
+    }
+  }
+
+  if (sections & GLTF_LOAD_SECTION_MATERIALS) {
+    arrays = gltf_size_add(arrays, gltf_block_bytes(yyjson_arr_size(yyjson_obj_get(root, "samplers")),
+                                                    sizeof(gltf_sampler)));
+    arrays = gltf_size_add(arrays, gltf_block_bytes(yyjson_arr_size(yyjson_obj_get(root, "textures")),
+                                                    sizeof(gltf_texture)));
+
+    a = yyjson_obj_get(root, "materials");
+    arrays = gltf_size_add(arrays, gltf_block_bytes(yyjson_arr_size(a), sizeof(gltf_material)));
+    yyjson_arr_foreach(a, idx, max, it) {
+      strings = gltf_size_add(strings, gltf_presize_str(it, "name"));
+    }
+  }
+
+  size_t total = gltf_size_add(arrays, gltf_block_bytes(strings, 1u));
+  total = gltf_size_add(total, gltf_block_bytes(indices, sizeof(uint32_t)));
+  if (indices > UINT32_MAX || strings > UINT32_MAX) total = SIZE_MAX;
+
+  out->block_bytes = total;
+  out->string_bytes = strings;
+  out->index_count = indices > UINT32_MAX ? UINT32_MAX : (uint32_t)indices;
+}
+
 // ----------------------------------------------------------------------------
 // Parsing utilities for gltf_doc.c
 // ----------------------------------------------------------------------------
@@ -559,7 +731,7 @@ gltf_result gltf_parse_scenes(gltf_doc* doc,
   doc->scene_count = (unsigned)yyjson_arr_size(scenes_val);
   if (doc->scene_count == 0) return GLTF_OK;
 
-  doc->scenes = (gltf_scene*)calloc(doc->scene_count, sizeof(gltf_scene));
+  doc->scenes = (gltf_scene*)gltf_doc_carve(doc, doc->scene_count, sizeof(gltf_scene));
   if (!doc->scenes) {
     gltf_set_err(out_err, "out of memory", "root.scenes", 1, 1);
     return GLTF_ERR_IO;
@@ -617,7 +789,7 @@ gltf_result gltf_parse_nodes(gltf_doc* doc,
   doc->node_count = (unsigned)yyjson_arr_size(nodes_val);
   if (doc->node_count == 0) return GLTF_OK;
 
-  doc->nodes = (gltf_node*)calloc(doc->node_count, sizeof(gltf_node));
+  doc->nodes = (gltf_node*)gltf_doc_carve(doc, doc->node_count, sizeof(gltf_node));
   if (!doc->nodes) {
     gltf_set_err(out_err, "out of memory", "root.nodes", 1, 1);
     return GLTF_ERR_IO;
@@ -728,12 +900,35 @@ gltf_result gltf_parse_meshes(gltf_doc* doc,
   doc->mesh_count = (unsigned)yyjson_arr_size(meshes_val);
   if (doc->mesh_count == 0) return GLTF_OK;
 
-  doc->meshes = (gltf_mesh*)calloc(doc->mesh_count, sizeof(gltf_mesh));
+  doc->meshes = (gltf_mesh*)gltf_doc_carve(doc, doc->mesh_count, sizeof(gltf_mesh));
   if (!doc->meshes) {
     gltf_set_err(out_err, "out of memory", "root.meshes", 1, 1);
     return GLTF_ERR_IO;
   }
 
+  // Primitives and attributes of all meshes are carved once (attributes are
+  // sized for every key; unknown semantics are skipped below).
+  size_t total_prims = 0, total_attrs = 0;
+  gltf_count_mesh_primitives(meshes_val, &total_prims, &total_attrs);
+  if (total_prims > UINT32_MAX || total_attrs > UINT32_MAX) {
+    gltf_set_err(out_err, "too many primitives", "root.meshes[].primitives", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+  if (total_prims > 0) {
+    doc->primitives = (gltf_primitive*)gltf_doc_carve(doc, total_prims, sizeof(gltf_primitive));
+    if (!doc->primitives) {
+      gltf_set_err(out_err, "out of memory", "root.meshes[].primitives", 1, 1);
+      return GLTF_ERR_IO;
+    }
+  }
+  if (total_attrs > 0) {
+    doc->prim_attrs = (gltf_prim_attr*)gltf_doc_carve(doc, total_attrs, sizeof(gltf_prim_attr));
+    if (!doc->prim_attrs) {
+      gltf_set_err(out_err, "out of memory", "root.meshes[].primitives", 1, 1);
+      return GLTF_ERR_IO;
+    }
+  }
+
   size_t mesh_idx, mesh_max;
   yyjson_val* mesh_val = NULL;
   yyjson_arr_foreach(meshes_val, mesh_idx, mesh_max, mesh_val) {
@@ -771,22 +966,6 @@ gltf_result gltf_parse_meshes(gltf_doc* doc,
     primitive_count = (uint32_t)_primitive_count;
 
     if (primitive_count > 0) {
-      size_t new_count = (size_t)doc->primitive_count + (size_t)primitive_count;
-
-      if (new_count > SIZE_MAX / sizeof(gltf_primitive)) {
-        gltf_set_err(out_err, "too many primitives", "root.meshes[].primitives", 1, 1);
-        return GLTF_ERR_IO;
-      }
-
-      size_t prim_size = new_count * sizeof(gltf_primitive);
-      gltf_primitive* primitives = (gltf_primitive*)realloc(doc->primitives, prim_size);
-      if (!primitives) {
-        gltf_set_err(out_err, "out of memory", "root.meshes[].primitives", 1, 1);
-        return GLTF_ERR_IO;
-      }
-      memset(&primitives[doc->primitive_count], 0, primitive_count * sizeof(gltf_primitive));
-      doc->primitives = primitives;
-
       size_t prim_idx, prim_max;
       yyjson_val* prim_val = NULL;
       yyjson_arr_foreach(primitives_val, prim_idx, prim_max, prim_val) {
@@ -808,57 +987,31 @@ gltf_result gltf_parse_meshes(gltf_doc* doc,
         uint32_t attr_first = doc->prim_attr_count;
         uint32_t attr_count = 0;
 
-        // pass 1: count known attrs
-        uint32_t known = 0;
-
         size_t attributes_idx, attributes_max;
         yyjson_val *key, *val;
         yyjson_obj_foreach(attributes_val, attributes_idx, attributes_max, key, val) {
-          uint32_t set = 0;
-          gltf_attr_semantic sem = gltf_parse_semantic(yyjson_get_str(key), &set);
-          if (sem == GLTF_ATTR_UNKNOWN) continue;
-          known++;
-        }
-
-        if (known > 0) {
-          // reserve once
-          size_t new_attr_count = (size_t)doc->prim_attr_count + (size_t)known;
-          if (new_attr_count > SIZE_MAX / sizeof(gltf_prim_attr)) {
-            gltf_set_err(out_err, "too many primitive attributes", "root.meshes[].primitives", 1, 1);
-            return GLTF_ERR_IO;
+          uint32_t out_set_index;
+          gltf_attr_semantic semantic = gltf_parse_semantic(
+            yyjson_get_str(key),
+            &out_set_index
+          );
+
+          if (semantic == GLTF_ATTR_UNKNOWN) {
+            // Ignore unknown semantics.
+            continue;
           }
-          size_t prim_attr_size = new_attr_count * sizeof(gltf_prim_attr);
-          gltf_prim_attr* prim_attrs = (gltf_prim_attr*)realloc(doc->prim_attrs, prim_attr_size);
-          if (!prim_attrs) {
-            gltf_set_err(out_err, "out of memory", "root.meshes[].primitives", 1, 1);
-            return GLTF_ERR_IO;
-          }
-          doc->prim_attrs = prim_attrs;
-
-          yyjson_obj_foreach(attributes_val, attributes_idx, attributes_max, key, val) {
-            uint32_t out_set_index;
-            gltf_attr_semantic semantic = gltf_parse_semantic(
-              yyjson_get_str(key),
-              &out_set_index
-            );
-
-            if (semantic == GLTF_ATTR_UNKNOWN) {
-              // Ignore unknown semantics.
-              continue;
-            }
-            if (!yyjson_is_uint(val)) {
-              gltf_set_err(out_err, "must be unsigned integer", "root.meshes[].primitives[].attributes[]", 1, 1);
-              return GLTF_ERR_PARSE;
-            }
-
-            gltf_prim_attr attr;
-            attr.semantic = semantic;
-            attr.set_index = out_set_index;
-            attr.accessor_index = (uint32_t)yyjson_get_uint(val);
-            doc->prim_attrs[doc->prim_attr_count++] = attr;
-
-            attr_count++;
+          if (!yyjson_is_uint(val)) {
+            gltf_set_err(out_err, "must be unsigned integer", "root.meshes[].primitives[].attributes[]", 1, 1);
+            return GLTF_ERR_PARSE;
           }
+
+          gltf_prim_attr attr;
+          attr.semantic = semantic;
+          attr.set_index = out_set_index;
+          attr.accessor_index = (uint32_t)yyjson_get_uint(val);
+          doc->prim_attrs[doc->prim_attr_count++] = attr;
+
+          attr_count++;
         }
 
         uint32_t primitive_idx = primitive_first + (uint32_t)prim_idx;
@@ -900,6 +1053,122 @@ gltf_result gltf_parse_meshes(gltf_doc* doc,
   return GLTF_OK;
 }
 
+// Rounds a JSON number to the nearest float on the requested side, so a box
+// built from accessor.min/max never shrinks when narrowed from double.
+static float gltf_f32_round_outward(double d, int toward_positive) {
+  float f = (float)d;
+  if ((double)f == d || d != d) return f;
+
+  const int too_big = (double)f > d;
+  if (too_big == !toward_positive) {
+    uint32_t u;
+    memcpy(&u, &f, sizeof u);
+    if (f == 0.0f) {
+      u = toward_positive ? 0x00000001u : 0x80000001u;
+    } else if ((f > 0.0f) == (toward_positive != 0)) {
+      u++;  // away from zero
+    } else {
+      u--;  // toward zero
+    }
+    memcpy(&f, &u, sizeof f);
+  }
+  return f;
+}
+
+// Parses accessor.min / accessor.max.
+//
+// Both are optional and only feed the AABB fast path, so malformed bounds
+// (not a number array with one entry per component) are ignored rather than
+// failing the load: has_bounds stays 0. Values are only retained for types
+// with <= 4 components.
+static void gltf_parse_accessor_bounds(yyjson_val* accessor_val, gltf_accessor* a) {
+  yyjson_val* vals[2] = { yyjson_obj_get(accessor_val, "min"), yyjson_obj_get(accessor_val, "max") };
+  float bounds[2][4];
+
+  a->has_bounds = 0u;
+  uint32_t n = 0;
+  if (!vals[0] || !vals[1] || !gltf_accessor_component_count(a->type, &n) || n > 4u) return;
+
+  for (int k = 0; k < 2; k++) {
+    yyjson_val* v = vals[k];
+    if (!yyjson_is_arr(v) || (uint32_t)yyjson_arr_size(v) != n) return;
+
+    size_t idx, max;
+    yyjson_val* val = NULL;
+    yyjson_arr_foreach(v, idx, max, val) {
+      if (!yyjson_is_num(val)) return;
+      bounds[k][idx] = gltf_f32_round_outward(yyjson_get_num(val), k);
+    }
+  }
+
+  memcpy(a->min, bounds[0], n * sizeof(float));
+  memcpy(a->max, bounds[1], n * sizeof(float));
+  a->has_bounds = 1u;
+}
+
+// Parses accessor.sparse (optional) and assigns its dense copy slot.
+//
+// Index and value views are only range-checked by gltf_accessor_layout(),
+// like the accessor's own bufferView.
+static gltf_result gltf_parse_accessor_sparse(gltf_doc* doc,
+                                              yyjson_val* accessor_val,
+                                              gltf_accessor* a,
+                                              uint32_t accessor_index,
+                                              gltf_error* out_err) {
+  yyjson_val* sparse_val = yyjson_obj_get(accessor_val, "sparse");
+  if (!sparse_val) return GLTF_OK;
+  if (!yyjson_is_obj(sparse_val)) {
+    gltf_set_err(out_err, "must be object", "root.accessors[].sparse", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+
+  gltf_accessor_sparse* sp = &a->sparse;
+  gltf_result r = gltf_json_get_u32_req(sparse_val, "count", &sp->count, "root.accessors[].sparse.count", out_err);
+  if (r != GLTF_OK) return r;
+  if (sp->count == 0 || sp->count > a->count) {
+    gltf_set_err(out_err, "sparse count must be in 1..accessor.count", "root.accessors[].sparse.count", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+
+  yyjson_val* indices_val = yyjson_obj_get(sparse_val, "indices");
+  yyjson_val* values_val = yyjson_obj_get(sparse_val, "values");
+  if (!yyjson_is_obj(indices_val)) {
+    gltf_set_err(out_err, "must be object", "root.accessors[].sparse.indices", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+  if (!yyjson_is_obj(values_val)) {
+    gltf_set_err(out_err, "must be object", "root.accessors[].sparse.values", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+
+  r = gltf_json_get_u32_req(indices_val, "bufferView", &sp->indices_view,
+                            "root.accessors[].sparse.indices.bufferView", out_err);
+  if (r != GLTF_OK) return r;
+  r = gltf_json_get_u32(indices_val, "byteOffset", 0, &sp->indices_offset,
+                        "root.accessors[].sparse.indices.byteOffset", out_err);
+  if (r != GLTF_OK) return r;
+  r = gltf_json_get_u32_req(indices_val, "componentType", &sp->indices_component_type,
+                            "root.accessors[].sparse.indices.componentType", out_err);
+  if (r != GLTF_OK) return r;
+  if (sp->indices_component_type != GLTF_COMP_U8 && sp->indices_component_type != GLTF_COMP_U16 &&
+      sp->indices_component_type != GLTF_COMP_U32) {
+    gltf_set_err(out_err, "sparse indices componentType not U8/U16/U32",
+                 "root.accessors[].sparse.indices.componentType", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+
+  r = gltf_json_get_u32_req(values_val, "bufferView", &sp->values_view,
+                            "root.accessors[].sparse.values.bufferView", out_err);
+  if (r != GLTF_OK) return r;
+  r = gltf_json_get_u32(values_val, "byteOffset", 0, &sp->values_offset,
+                        "root.accessors[].sparse.values.byteOffset", out_err);
+  if (r != GLTF_OK) return r;
+
+  sp->dense = doc->sparse_dense_count++;
+  doc->sparse_dense[sp->dense].accessor = accessor_index;
+  return GLTF_OK;
+}
+
 gltf_result gltf_parse_accessors(gltf_doc* doc,
                                  yyjson_val* root,
                                  gltf_error* out_err) {
@@ -921,8 +1190,10 @@ gltf_result gltf_parse_accessors(gltf_doc* doc,
   doc->accessor_count = (unsigned)yyjson_arr_size(accessors_val);
   if (doc->accessor_count == 0) return GLTF_OK;
 
-  doc->accessors = (gltf_accessor*)calloc(doc->accessor_count, sizeof(gltf_accessor));
-  if (!doc->accessors) {
+  doc->accessors = (gltf_accessor*)gltf_doc_carve(doc, doc->accessor_count, sizeof(gltf_accessor));
+  doc->sparse_dense = (gltf_sparse_dense*)gltf_doc_carve(doc, gltf_count_sparse_accessors(accessors_val),
+                                                         sizeof(gltf_sparse_dense));
+  if (!doc->accessors || !doc->sparse_dense) {
     gltf_set_err(out_err, "out of memory", "root.accessors", 1, 1);
     return GLTF_ERR_IO;
   }
@@ -985,6 +1256,12 @@ gltf_result gltf_parse_accessors(gltf_doc* doc,
       "root.accessors[].normalized",
       out_err);
     if (r != GLTF_OK) return r;
+
+    gltf_parse_accessor_bounds(accessor_val, &doc->accessors[accessor_idx]);
+
+    r = gltf_parse_accessor_sparse(doc, accessor_val, &doc->accessors[accessor_idx], (uint32_t)accessor_idx,
+                                   out_err);
+    if (r != GLTF_OK) return r;
   }
 
   return GLTF_OK;
@@ -1011,7 +1288,7 @@ gltf_result gltf_parse_buffer_views(gltf_doc* doc,
   doc->buffer_view_count = (unsigned)yyjson_arr_size(buffer_views_val);
   if (doc->buffer_view_count == 0) return GLTF_OK;
 
-  doc->buffer_views = (gltf_buffer_view*)calloc(doc->buffer_view_count, sizeof(gltf_buffer_view));
+  doc->buffer_views = (gltf_buffer_view*)gltf_doc_carve(doc, doc->buffer_view_count, sizeof(gltf_buffer_view));
   if (!doc->buffer_views) {
     gltf_set_err(out_err, "out of memory", "root.bufferViews", 1, 1);
     return GLTF_ERR_IO;
@@ -1072,15 +1349,118 @@ gltf_result gltf_parse_buffer_views(gltf_doc* doc,
   return GLTF_OK;
 }
 
-gltf_result gltf_parse_buffers(gltf_doc* doc,
-                               yyjson_val* root,
-                               const gltf_load_context* ctx,
-                               gltf_error* out_err) {
-  if (!doc || !root || !ctx) {
-    gltf_set_err(out_err, "invalid arguments", "root.buffers", 1, 1);
+gltf_result gltf_load_buffer_source(gltf_buffer* b,
+                                    const char* path,
+                                    const char* uri,
+                                    uint32_t ctx_flags,
+                                    const gltf_io* io,
+                                    gltf_error* out_err) {
+  if (!b || (!path && !uri)) {
+    gltf_set_err(out_err, "invalid arguments", "root.buffers[]", 1, 1);
     return GLTF_ERR_INVALID;
   }
 
+  if (!path) {
+    // Data URI (base64)
+    uint8_t* bytes = NULL;
+    uint32_t out_len = 0;
+    gltf_result r = gltf_decode_data_uri(uri, b->byte_length, &bytes, &out_len, out_err);
+    if (r != GLTF_OK) return r;
+    b->data = bytes;
+    b->storage = GLTF_BUFFER_OWNED;
+    return GLTF_OK;
+  }
+
+  // External file
+  uint32_t actual_len = 0;
+  uint8_t* data = NULL;
+  gltf_fs_status st = GLTF_FS_IO;
+  if (((ctx_flags & GLTF_LOAD_CTX_MMAP) || (io && io->map)) && b->byte_length > 0) {
+    const uint8_t* mapped = NULL;
+    size_t mapped_size = 0;
+    st = gltf_fs_map_file_io(io, path, b->byte_length, &mapped, &mapped_size);
+    if (st == GLTF_FS_OK) {
+      b->data = (uint8_t*)(uintptr_t)mapped;
+      b->storage = GLTF_BUFFER_MAPPED;
+    }
+  }
+  if (st != GLTF_FS_OK && st != GLTF_FS_SIZE_MISMATCH) {
+    // Not mapped (disabled, or mapping unsupported here): read into memory.
+    st = gltf_fs_read_file_exact_u32_io(io, path, b->byte_length, &data, &actual_len);
+    if (st == GLTF_FS_OK) {
+      b->data = data;
+      b->storage = GLTF_BUFFER_OWNED;
+    }
+  }
+
+  switch (st) {
+  case GLTF_FS_OK:
+    return GLTF_OK;
+  case GLTF_FS_SIZE_MISMATCH:
+    gltf_set_err(out_err, "buffer file size does not match byteLength", "root.buffers[].byteLength", 1, 1);
+    return GLTF_ERR_PARSE;
+  case GLTF_FS_OOM:
+    gltf_set_err(out_err, "out of memory", "root.buffers[].byteLength", 1, 1);
+    return GLTF_ERR_IO;
+  case GLTF_FS_TOO_LARGE:
+    gltf_set_err(out_err, "buffer file too large", "root.buffers[].uri", 1, 1);
+    return GLTF_ERR_PARSE;
+  default:
+    gltf_set_err(out_err, "failed to read buffer file", "root.buffers[].uri", 1, 1);
+    return GLTF_ERR_IO;
+  }
+}
+
+// One buffer load deferred by gltf_parse_buffers() to a dispatched task.
+typedef struct gltf_buffer_job {
+  gltf_buffer* buffer;
+  char* path;        // external file (malloc'd), or NULL
+  const char* uri;   // data URI in the JSON tree, or NULL
+  char* insitu_uri;  // data URI inside the writable JSON text, or NULL
+  uint32_t index;    // position in root.buffers
+  gltf_result result;
+  gltf_error error;
+  double seconds;    // time the task spent (stats only)
+} gltf_buffer_job;
+
+typedef struct gltf_buffer_batch {
+  gltf_buffer_job* jobs;
+  uint32_t ctx_flags;
+  const gltf_io* io;
+  const gltf_load_stats* stats; // clock only; the loading thread sums jobs
+} gltf_buffer_batch;
+
+// One task: read or decode a single buffer. Tasks touch only their own job
+// and buffer; in-place decodes write disjoint ranges of the JSON text.
+static void gltf_buffer_job_task(void* user, uint32_t task_index) {
+  const gltf_buffer_batch* batch = (const gltf_buffer_batch*)user;
+  gltf_buffer_job* job = &batch->jobs[task_index];
+  gltf_error err = {0};
+  const double t0 = gltf_stats_clock(batch->stats);
+
+  if (job->insitu_uri) {
+    uint8_t* data = NULL;
+    job->result = gltf_decode_data_uri_insitu(job->insitu_uri, job->buffer->byte_length, &data, &err);
+    if (job->result == GLTF_OK) {
+      job->buffer->data = data;
+      job->buffer->storage = GLTF_BUFFER_BORROWED;
+    }
+  } else {
+    job->result = gltf_load_buffer_source(job->buffer, job->path, job->uri, batch->ctx_flags, batch->io, &err);
+  }
+  job->seconds = gltf_stats_clock(batch->stats) - t0;
+  job->error = err;
+}
+
+// Parses root.buffers. With jobs != NULL, each load that would block (file
+// read, data-URI decode) is appended to jobs instead of being run.
+static gltf_result gltf_parse_buffers_impl(gltf_doc* doc,
+                                           yyjson_val* root,
+                                           const gltf_load_context* ctx,
+                                           gltf_buffer_job* jobs,
+                                           uint32_t* io_job_count,
+                                           gltf_error* out_err) {
+
   yyjson_val* buffers_val = yyjson_obj_get(root, "buffers");
   if (!buffers_val) {
     doc->buffer_count = 0;
@@ -1094,7 +1474,7 @@ gltf_result gltf_parse_buffers(gltf_doc* doc,
   doc->buffer_count = (unsigned)yyjson_arr_size(buffers_val);
   if (doc->buffer_count == 0) return GLTF_OK;
 
-  doc->buffers = (gltf_buffer*)calloc(doc->buffer_count, sizeof(gltf_buffer));
+  doc->buffers = (gltf_buffer*)gltf_doc_carve(doc, doc->buffer_count, sizeof(gltf_buffer));
   if (!doc->buffers) {
     gltf_set_err(out_err, "out of memory", "root.buffers", 1, 1);
     return GLTF_ERR_IO;
@@ -1112,6 +1492,8 @@ gltf_result gltf_parse_buffers(gltf_doc* doc,
       gltf_set_err(out_err, "must be object", "root.buffers[]", 1, 1);
       return GLTF_ERR_PARSE;
     }
+    doc->buffers[buffer_idx].uri = gltf_str_invalid();
+    doc->buffers[buffer_idx].path = gltf_str_invalid();
 
     gltf_result r = gltf_json_get_u32_req(
       buffer_val,
@@ -1134,6 +1516,13 @@ gltf_result gltf_parse_buffers(gltf_doc* doc,
           return GLTF_ERR_PARSE;
         }
 
+        if (ctx->flags & GLTF_LOAD_CTX_BORROW_BIN) {
+          // Zero-copy: the caller (or doc->file_bytes) keeps the BIN chunk alive.
+          doc->buffers[0].data = (uint8_t*)(uintptr_t)ctx->internal_bin;
+          doc->buffers[0].storage = GLTF_BUFFER_BORROWED;
+          return GLTF_OK;
+        }
+
         doc->buffers[0].data = (uint8_t*)malloc((size_t)doc->buffers[0].byte_length);
         if (!doc->buffers[0].data) {
             gltf_set_err(out_err, "out of memory", "root.buffers[0].data", 1, 1);
@@ -1157,14 +1546,20 @@ gltf_result gltf_parse_buffers(gltf_doc* doc,
       }
 
       const char* uri = yyjson_get_str(uri_val);
-      gltf_str v = arena_strdup(&doc->arena, uri);
-      if (!gltf_str_is_valid(v)) {
-        gltf_set_err(out_err, "out of memory", "root.buffers[].uri", 1, 1);
-        return GLTF_ERR_IO;
+      const int is_data = strncmp(uri, "data:", 5) == 0;
+
+      // Data URIs are only copied when decoding is deferred; otherwise the
+      // payload is decoded straight from the JSON string.
+      if (!is_data || (ctx->flags & GLTF_LOAD_CTX_LAZY_BUFFERS)) {
+        gltf_str v = arena_strdup(&doc->arena, uri);
+        if (!gltf_str_is_valid(v)) {
+          gltf_set_err(out_err, "out of memory", "root.buffers[].uri", 1, 1);
+          return GLTF_ERR_IO;
+        }
+        doc->buffers[buffer_idx].uri = v;
       }
-      doc->buffers[buffer_idx].uri = v;
 
-      if (strncmp(uri, "data:", 5) != 0) {
+      if (!is_data) {
         // External file
 
         if (!ctx->doc_dir) {
@@ -1183,39 +1578,76 @@ gltf_result gltf_parse_buffers(gltf_doc* doc,
           return GLTF_ERR_IO;
         }
 
-        uint32_t actual_len = 0;
-        uint8_t* data = NULL;
-        gltf_fs_status st = gltf_fs_read_file_exact_u32(full,
-                                                        doc->buffers[buffer_idx].byte_length,
-                                                        &data,
-                                                        &actual_len);
+        if (ctx->flags & GLTF_LOAD_CTX_LAZY_BUFFERS) {
+          // Deferred: remember the resolved path, read on first use.
+          doc->buffers[buffer_idx].path = arena_strdup(&doc->arena, full);
+          free(full);
+          if (!gltf_str_is_valid(doc->buffers[buffer_idx].path)) {
+            gltf_set_err(out_err, "out of memory", "root.buffers[].uri", 1, 1);
+            return GLTF_ERR_IO;
+          }
+          doc->buffers[buffer_idx].pending = 1u;
+          continue;
+        }
+
+        if (jobs) {
+          gltf_buffer_job* job = &jobs[(*io_job_count)++];
+          job->buffer = &doc->buffers[buffer_idx];
+          job->index = (uint32_t)buffer_idx;
+          job->path = full;
+          continue;
+        }
+
+        const double t0 = gltf_stats_clock(ctx->stats);
+        r = gltf_load_buffer_source(&doc->buffers[buffer_idx], full, NULL, ctx->flags, ctx->io, out_err);
+        gltf_stats_buffer_time(ctx->stats, (uint32_t)buffer_idx, 0, gltf_stats_clock(ctx->stats) - t0);
         free(full);
+        if (r != GLTF_OK) return r;
+      } else {
+        // Data URI (base64); the uri copy in the arena is the deferred source.
+        if (ctx->flags & GLTF_LOAD_CTX_LAZY_BUFFERS) {
+          doc->buffers[buffer_idx].pending = 1u;
+          continue;
+        }
+
+        const uint8_t* u = (const uint8_t*)uri;
+        if ((ctx->flags & GLTF_LOAD_CTX_DECODE_INSITU) && ctx->json_text &&
+            u >= ctx->json_text && u < ctx->json_text + ctx->json_text_size) {
+          // The string lives in the (writable) JSON text: decode over it.
+          char* text_uri = (char*)ctx->json_text + (u - ctx->json_text);
+          if (jobs) {
+            gltf_buffer_job* job = &jobs[(*io_job_count)++];
+            job->buffer = &doc->buffers[buffer_idx];
+            job->index = (uint32_t)buffer_idx;
+            job->insitu_uri = text_uri;
+            continue;
+          }
 
-        switch (st) {
-        case GLTF_FS_OK:
+          uint8_t* data = NULL;
+          const double t0 = gltf_stats_clock(ctx->stats);
+          r = gltf_decode_data_uri_insitu(text_uri,
+                                          doc->buffers[buffer_idx].byte_length,
+                                          &data,
+                                          out_err);
+          gltf_stats_buffer_time(ctx->stats, (uint32_t)buffer_idx, 1, gltf_stats_clock(ctx->stats) - t0);
+          if (r != GLTF_OK) return r;
           doc->buffers[buffer_idx].data = data;
-          break;
-        case GLTF_FS_SIZE_MISMATCH:
-          gltf_set_err(out_err, "buffer file size does not match byteLength", "root.buffers[].byteLength", 1, 1);
-          return GLTF_ERR_PARSE;
-        case GLTF_FS_OOM:
-          gltf_set_err(out_err, "out of memory", "root.buffers[].byteLength", 1, 1);
-          return GLTF_ERR_IO;
-        case GLTF_FS_TOO_LARGE:
-          gltf_set_err(out_err, "buffer file too large", "root.buffers[].uri", 1, 1);
-          return GLTF_ERR_PARSE;
-        default:
-          gltf_set_err(out_err, "failed to read buffer file", "root.buffers[].uri", 1, 1);
-          return GLTF_ERR_IO;
+          doc->buffers[buffer_idx].storage = GLTF_BUFFER_BORROWED;
+          continue;
+        }
+
+        if (jobs) {
+          gltf_buffer_job* job = &jobs[(*io_job_count)++];
+          job->buffer = &doc->buffers[buffer_idx];
+          job->index = (uint32_t)buffer_idx;
+          job->uri = uri;
+          continue;
         }
-      } else {
-        // Data URI (base64)
 
-        uint8_t* bytes = NULL;
-        uint32_t out_len = 0;
-        r = gltf_decode_data_uri(uri, doc->buffers[buffer_idx].byte_length, &bytes, &out_len, out_err);
+        const double t0 = gltf_stats_clock(ctx->stats);
+        r = gltf_load_buffer_source(&doc->buffers[buffer_idx], NULL, uri, ctx->flags, ctx->io, out_err);
+        gltf_stats_buffer_time(ctx->stats, (uint32_t)buffer_idx, 1, gltf_stats_clock(ctx->stats) - t0);
         if (r != GLTF_OK) return r;
-        doc->buffers[buffer_idx].data = bytes;
       }
     }
   }
@@ -1223,6 +1655,53 @@ gltf_result gltf_parse_buffers(gltf_doc* doc,
   return GLTF_OK;
 }
 
+gltf_result gltf_parse_buffers(gltf_doc* doc,
+                               yyjson_val* root,
+                               const gltf_load_context* ctx,
+                               gltf_error* out_err) {
+  if (!doc || !root || !ctx) {
+    gltf_set_err(out_err, "invalid arguments", "root.buffers", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+
+  // Serial: nothing to overlap, or nothing is read up front.
+  const size_t count = yyjson_arr_size(yyjson_obj_get(root, "buffers"));
+  if (!ctx->dispatch || count < 2 ||
+      (ctx->flags & (GLTF_LOAD_CTX_GLB | GLTF_LOAD_CTX_LAZY_BUFFERS))) {
+    return gltf_parse_buffers_impl(doc, root, ctx, NULL, NULL, out_err);
+  }
+
+  gltf_buffer_job* jobs = (gltf_buffer_job*)calloc(count, sizeof(gltf_buffer_job));
+  if (!jobs) {
+    gltf_set_err(out_err, "out of memory", "root.buffers", 1, 1);
+    return GLTF_ERR_IO;
+  }
+
+  uint32_t job_count = 0;
+  gltf_result r = gltf_parse_buffers_impl(doc, root, ctx, jobs, &job_count, out_err);
+  if (r == GLTF_OK && job_count > 0) {
+    gltf_buffer_batch batch = { jobs, ctx->flags, ctx->io, ctx->stats };
+    ctx->dispatch(ctx->dispatch_user, job_count, gltf_buffer_job_task, &batch);
+
+    for (uint32_t i = 0; i < job_count; i++) {
+      gltf_stats_buffer_time(ctx->stats, jobs[i].index, jobs[i].path == NULL, jobs[i].seconds);
+    }
+
+    // Report the first failure in buffer order, as the serial path would.
+    for (uint32_t i = 0; i < job_count; i++) {
+      if (jobs[i].result != GLTF_OK) {
+        if (out_err) *out_err = jobs[i].error;
+        r = jobs[i].result;
+        break;
+      }
+    }
+  }
+
+  for (uint32_t i = 0; i < job_count; i++) free(jobs[i].path);
+  free(jobs);
+  return r;
+}
+
 gltf_result gltf_parse_images(gltf_doc* doc,
                               yyjson_val* root,
                               gltf_error* out_err) {
@@ -1244,8 +1723,9 @@ gltf_result gltf_parse_images(gltf_doc* doc,
   doc->image_count = (unsigned)yyjson_arr_size(images_val);
   if (doc->image_count == 0) return GLTF_OK;
 
-  doc->images = (gltf_image*)calloc(doc->image_count, sizeof(gltf_image));
-  if (!doc->images) {
+  doc->images = (gltf_image*)gltf_doc_carve(doc, doc->image_count, sizeof(gltf_image));
+  doc->image_bytes = (gltf_image_bytes*)gltf_doc_carve(doc, doc->image_count, sizeof(gltf_image_bytes));
+  if (!doc->images || !doc->image_bytes) {
     gltf_set_err(out_err, "out of memory", "root.images", 1, 1);
     return GLTF_ERR_IO;
   }
@@ -1364,7 +1844,7 @@ gltf_result gltf_parse_samplers(gltf_doc* doc,
   doc->sampler_count = (unsigned)yyjson_arr_size(samplers_val);
   if (doc->sampler_count == 0) return GLTF_OK;
 
-  doc->samplers = (gltf_sampler*)calloc(doc->sampler_count, sizeof(gltf_sampler));
+  doc->samplers = (gltf_sampler*)gltf_doc_carve(doc, doc->sampler_count, sizeof(gltf_sampler));
   if (!doc->samplers) {
     gltf_set_err(out_err, "out of memory", "root.samplers", 1, 1);
     return GLTF_ERR_IO;
@@ -1439,7 +1919,7 @@ gltf_result gltf_parse_textures(gltf_doc* doc,
   doc->texture_count = (unsigned)yyjson_arr_size(textures_val);
   if (doc->texture_count == 0) return GLTF_OK;
 
-  doc->textures = (gltf_texture*)calloc(doc->texture_count, sizeof(gltf_texture));
+  doc->textures = (gltf_texture*)gltf_doc_carve(doc, doc->texture_count, sizeof(gltf_texture));
   if (!doc->textures) {
     gltf_set_err(out_err, "out of memory", "root.textures", 1, 1);
     return GLTF_ERR_IO;
@@ -1496,7 +1976,7 @@ gltf_result gltf_parse_materials(gltf_doc* doc,
   doc->material_count = (unsigned)yyjson_arr_size(materials_val);
   if (doc->material_count == 0) return GLTF_OK;
 
-  doc->materials = (gltf_material*)calloc(doc->material_count, sizeof(gltf_material));
+  doc->materials = (gltf_material*)gltf_doc_carve(doc, doc->material_count, sizeof(gltf_material));
   if (!doc->materials) {
     gltf_set_err(out_err, "out of memory", "root.materials", 1, 1);
     return GLTF_ERR_IO;
@@ -1920,3 +2400,36 @@ gltf_result gltf_decode_data_uri(const char* uri,
   *out_len = (uint32_t)decoded_len;
   return GLTF_OK;
 }
+
+// Decodes a base64 data URI over its own characters (output never overtakes
+// input: 3 bytes per 4 characters). On success *out_bytes points into uri.
+gltf_result gltf_decode_data_uri_insitu(char* uri,
+                                        uint32_t expected_len,
+                                        uint8_t** out_bytes,
+                                        gltf_error* out_err) {
+  const char* tag = ";base64,";
+  char* p = (strncmp(uri, "data:", 5) == 0) ? strstr(uri, tag) : NULL;
+  if (!p) {
+    gltf_set_err(out_err, "only base64 data URIs are supported", "root.buffers[].uri", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+
+  uint8_t* payload = (uint8_t*)p + strlen(tag);
+  size_t decoded_len = 0;
+  if (!gltf_base64_decode((const char*)payload, strlen((const char*)payload), payload,
+                          (size_t)expected_len, &decoded_len)) {
+    gltf_set_err(out_err, "invalid base64 payload", "root.buffers[].uri", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+  if (decoded_len != (size_t)expected_len) {
+    gltf_set_err(out_err,
+                 "decoded buffer length does not match byteLength",
+                 "root.buffers[].byteLength",
+                 1,
+                 1);
+    return GLTF_ERR_PARSE;
+  }
+
+  *out_bytes = payload;
+  return GLTF_OK;
+}
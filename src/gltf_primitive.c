@@ -4,17 +4,77 @@
 //
 // Responsibilities:
 //   - map mesh + prim_i to a primitive index
-//   - expose POSITION/indices accessors and spans
+//   - build each primitive's slot table (fixed attributes + indices, with
+//     accessor layouts validated once at load)
+//   - expose POSITION/indices accessors and spans, and draw views of all slots
 //   - read individual POSITION/indices elements (decoded)
+//   - generate triangles (per triangle, in batches, or into caller arrays)
+//   - split triangle ranges into work items for parallel processing
 //
 // Notes:
 //   - Public API contracts are documented in include/gltf/gltf.h.
-//   - This loader exposes only POSITION and optional indices.
+//   - Triangle extraction uses only POSITION and optional indices.
 
 
 #include "gltf_internal.h"
 
 
+// ----------------------------------------------------------------------------
+// Slot tables
+// ----------------------------------------------------------------------------
+
+// Slot of (semantic, set_index), or GLTF_ATTR_SLOT_COUNT if it has none.
+static uint32_t gltf_attr_slot_of(gltf_attr_semantic semantic, uint32_t set_index) {
+  switch (semantic) {
+    case GLTF_ATTR_POSITION: return set_index == 0 ? GLTF_ATTR_SLOT_POSITION : GLTF_ATTR_SLOT_COUNT;
+    case GLTF_ATTR_NORMAL:   return set_index == 0 ? GLTF_ATTR_SLOT_NORMAL : GLTF_ATTR_SLOT_COUNT;
+    case GLTF_ATTR_TANGENT:  return set_index == 0 ? GLTF_ATTR_SLOT_TANGENT : GLTF_ATTR_SLOT_COUNT;
+    case GLTF_ATTR_TEXCOORD: return set_index < 4u ? GLTF_ATTR_SLOT_TEXCOORD_0 + set_index : GLTF_ATTR_SLOT_COUNT;
+    case GLTF_ATTR_COLOR:    return set_index == 0 ? GLTF_ATTR_SLOT_COLOR_0 : GLTF_ATTR_SLOT_COUNT;
+    case GLTF_ATTR_JOINTS:   return set_index == 0 ? GLTF_ATTR_SLOT_JOINTS_0 : GLTF_ATTR_SLOT_COUNT;
+    case GLTF_ATTR_WEIGHTS:  return set_index == 0 ? GLTF_ATTR_SLOT_WEIGHTS_0 : GLTF_ATTR_SLOT_COUNT;
+    default:                 return GLTF_ATTR_SLOT_COUNT;
+  }
+}
+
+static void gltf_prim_slot_set(const gltf_doc* doc, gltf_prim_slot* slot, int32_t accessor) {
+  slot->accessor = accessor;
+  slot->valid = accessor >= 0 &&
+                gltf_accessor_layout(doc, (uint32_t)accessor, &slot->layout, NULL) == GLTF_OK;
+}
+
+void gltf_doc_build_prim_slots(gltf_doc* doc) {
+  for (uint32_t p = 0; p < doc->primitive_count; p++) {
+    gltf_primitive* prim = &doc->primitives[p];
+    memset(prim->slots, 0, sizeof prim->slots);
+    for (uint32_t s = 0; s <= GLTF_PRIM_SLOT_INDICES; s++) prim->slots[s].accessor = -1;
+
+    // First attribute wins, as in a linear scan.
+    for (uint32_t i = 0; i < prim->attributes_count; i++) {
+      const gltf_prim_attr* attr = &doc->prim_attrs[prim->attributes_first + i];
+      const uint32_t s = gltf_attr_slot_of(attr->semantic, attr->set_index);
+      if (s < GLTF_ATTR_SLOT_COUNT && prim->slots[s].accessor < 0) {
+        gltf_prim_slot_set(doc, &prim->slots[s], (int32_t)attr->accessor_index);
+      }
+    }
+    gltf_prim_slot_set(doc, &prim->slots[GLTF_PRIM_SLOT_INDICES], prim->indices_accessor);
+  }
+}
+
+gltf_result gltf_prim_slot_span(const gltf_doc* doc,
+                                uint32_t primitive_index,
+                                uint32_t slot,
+                                gltf_span* out_span,
+                                gltf_error* out_err) {
+  const gltf_prim_slot* ps = &doc->primitives[primitive_index].slots[slot];
+  if (!ps->valid) {
+    // Re-run the checks for the error details.
+    return gltf_accessor_span(doc, (uint32_t)ps->accessor, out_span, out_err);
+  }
+  return gltf_span_from_layout(doc, &ps->layout, out_span, out_err);
+}
+
+
 // ----------------------------------------------------------------------------
 // Mesh primitives (POSITION/indices)
 // ----------------------------------------------------------------------------
@@ -29,63 +89,7 @@ static gltf_result gltf_read_index_u32_from_accessor(const gltf_doc* doc,
     gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
     return GLTF_ERR_INVALID;
   }
-  if (indices_accessor >= doc->accessor_count) {
-    gltf_set_err(out_err, "accessor out of range", "root.accessors[]", 1, 1);
-    return GLTF_ERR_INVALID;
-  }
-
-  const gltf_accessor* a = &doc->accessors[indices_accessor];
-
-  // indices must be SCALAR and non-normalized
-  if (a->type != GLTF_ACCESSOR_SCALAR) {
-    gltf_set_err(out_err, "indices accessor not SCALAR", "root.accessors[].type", 1, 1);
-    return GLTF_ERR_PARSE;
-  }
-  if (a->normalized) {
-    gltf_set_err(out_err, "indices accessor must not be normalized", "root.accessors[].normalized", 1, 1);
-    return GLTF_ERR_PARSE;
-  }
-  if (!(a->component_type == GLTF_COMP_U8 ||
-        a->component_type == GLTF_COMP_U16 ||
-        a->component_type == GLTF_COMP_U32)) {
-    gltf_set_err(out_err, "indices componentType not U8/U16/U32", "root.accessors[].componentType", 1, 1);
-    return GLTF_ERR_PARSE;
-  }
-
-  if (index_i >= a->count) {
-    gltf_set_err(out_err, "index out of range", "root.accessors[]", 1, 1);
-    return GLTF_ERR_INVALID;
-  }
-
-  gltf_span span;
-  gltf_result r = gltf_accessor_span(doc, indices_accessor, &span, out_err);
-  if (r != GLTF_OK) {
-    gltf_set_err(out_err, "failed to get indices accessor span", "root.accessors[]", 1, 1);
-    return r;
-  }
-  if (!span.ptr) {
-    gltf_set_err(out_err, "indices span is null", "root.accessors[]", 1, 1);
-    return GLTF_ERR_PARSE;
-  }
-
-  uint32_t comp_size = 0;
-  if (!gltf_component_size_bytes(a->component_type, &comp_size)) {
-    gltf_set_err(out_err, "invalid componentType", "root.accessors[].componentType", 1, 1);
-    return GLTF_ERR_PARSE;
-  }
-
-  const uint32_t stride = (span.stride != 0) ? span.stride : comp_size;
-  const uint8_t* p = span.ptr + (size_t)index_i * (size_t)stride;
-
-  switch (a->component_type) {
-    case GLTF_COMP_U8:  *out = (uint32_t)p[0]; return GLTF_OK;
-    case GLTF_COMP_U16: *out = (uint32_t)rd_u16_le(p); return GLTF_OK;
-    case GLTF_COMP_U32: *out = rd_u32_le(p); return GLTF_OK;
-    default: break;
-  }
-
-  gltf_set_err(out_err, "invalid index componentType", "root.accessors[].componentType", 1, 1);
-  return GLTF_ERR_PARSE;
+  return gltf_accessor_read_indices_u32(doc, indices_accessor, index_i, 1, out, NULL, NULL, out_err);
 }
 
 uint32_t gltf_doc_mesh_primitive_count(const gltf_doc* doc, uint32_t mesh_index) {
@@ -164,14 +168,7 @@ gltf_result gltf_mesh_primitive_position_span(const gltf_doc* doc,
   }
 
   const uint32_t primitive_index = mesh->primitive_first + prim_i;
-  uint32_t pos_accessor = 0;
-
-  if (!gltf_doc_primitive_find_attribute(
-      doc,
-      primitive_index,
-      GLTF_ATTR_POSITION,
-      0,
-      &pos_accessor)) {
+  if (doc->primitives[primitive_index].slots[GLTF_ATTR_SLOT_POSITION].accessor < 0) {
     gltf_set_err(
       out_err,
       "primitive has no POSITION attribute",
@@ -182,7 +179,7 @@ gltf_result gltf_mesh_primitive_position_span(const gltf_doc* doc,
     return GLTF_ERR_PARSE;
   }
 
-  return gltf_accessor_span(doc, pos_accessor, out_span, out_err);
+  return gltf_prim_slot_span(doc, primitive_index, GLTF_ATTR_SLOT_POSITION, out_span, out_err);
 }
 
 gltf_result gltf_mesh_primitive_read_position_f32(const gltf_doc* doc,
@@ -389,14 +386,43 @@ gltf_result gltf_mesh_primitive_view(const gltf_doc* doc,
     return GLTF_ERR_INVALID;
   }
 
-  const gltf_primitive* prim = &doc->primitives[mesh->primitive_first + prim_i];
+  const uint32_t primitive_index = mesh->primitive_first + prim_i;
+  const gltf_primitive* prim = &doc->primitives[primitive_index];
+  if (prim->slots[GLTF_ATTR_SLOT_POSITION].accessor < 0) {
+    gltf_set_err(out_err,
+                 "primitive has no POSITION attribute",
+                 "root.meshes[].primitives[].attributes.POSITION",
+                 1,
+                 1);
+    return GLTF_ERR_PARSE;
+  }
 
-  if (prim->indices_accessor >= 0) {
-    const gltf_accessor* a = &doc->accessors[(uint32_t)prim->indices_accessor];
-    out_view->index_count = a->count;
+  gltf_draw_primitive_view v;
+  memset(&v, 0, sizeof v);
+  for (uint32_t s = 0; s < GLTF_ATTR_SLOT_COUNT; s++) {
+    const int32_t acc = prim->slots[s].accessor;
+    if (acc < 0) continue;
+    gltf_result r = gltf_prim_slot_span(doc, primitive_index, s, &v.attributes[s], out_err);
+    if (r != GLTF_OK) return r;
+    const gltf_accessor* a = &doc->accessors[(uint32_t)acc];
+    v.attribute_component_type[s] = a->component_type;
+    v.attribute_mask |= 1u << s;
+    if (a->normalized) v.normalized_mask |= 1u << s;
+  }
+  v.positions = v.attributes[GLTF_ATTR_SLOT_POSITION];
+
+  const int32_t idx = prim->slots[GLTF_PRIM_SLOT_INDICES].accessor;
+  if (idx >= 0) {
+    gltf_result r = gltf_prim_slot_span(doc, primitive_index, GLTF_PRIM_SLOT_INDICES, &v.indices, out_err);
+    if (r != GLTF_OK) return r;
+    v.index_count = v.indices.count;
+    v.index_component_type = doc->accessors[(uint32_t)idx].component_type;
   } else {
-    out_view->index_count = 0;
+    v.index_count = v.positions.count;
   }
+
+  *out_view = v;
+  gltf_set_err(out_err, NULL, NULL, 0, 0);
   return GLTF_OK;
 }
 
@@ -461,7 +487,15 @@ int gltf_doc_primitive_find_attribute(const gltf_doc* doc,
   if (primitive_index >= doc->primitive_count) return 0;
 
   const gltf_primitive* prim = &doc->primitives[primitive_index];
-  
+
+  // Fixed slots are a table lookup; other sets fall back to a scan.
+  const uint32_t slot = gltf_attr_slot_of(semantic, set_index);
+  if (slot < GLTF_ATTR_SLOT_COUNT) {
+    if (prim->slots[slot].accessor < 0) return 0;
+    *out_accessor_index = (uint32_t)prim->slots[slot].accessor;
+    return 1;
+  }
+
   for (uint32_t i = 0; i < prim->attributes_count; i++) {
     const gltf_prim_attr* attr = &doc->prim_attrs[prim->attributes_first + i];
     if (attr->semantic == semantic && attr->set_index == set_index) {
@@ -474,50 +508,32 @@ int gltf_doc_primitive_find_attribute(const gltf_doc* doc,
 }
 
 
-static inline gltf_result gltf_get_vertex_index(const gltf_doc* doc,
-                                                int has_idx,
-                                                uint32_t idx_accessor,
-                                                uint32_t idx_i,
-                                                uint32_t v_count,
-                                                uint32_t* out,
-                                                gltf_error* out_err) {
-  if (!doc || !out) {
-    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
-    return GLTF_ERR_INVALID;
-  }
-
-  if (has_idx) {
-    gltf_result r;
-    r = gltf_read_index_u32_from_accessor(doc, idx_accessor, idx_i, out, out_err);
-    if (r != GLTF_OK) {
-      return r;
-    }
-  } else {
-    *out = idx_i;
-  }
-
-  if (*out >= v_count) {
-    gltf_set_err(out_err, "index out of range", "root.accessors[]", 1, 1);
-    return GLTF_ERR_PARSE;
-  }
-
-  return GLTF_OK;
-}
+// ----------------------------------------------------------------------------
+// Triangle extraction
+// ----------------------------------------------------------------------------
 
-gltf_result gltf_doc_primitive_iterate_triangles(const gltf_doc* doc,
-                                                 uint32_t primitive_index,
-                                                 gltf_tri_cb cb,
-                                                 void* user,
-                                                 gltf_error* out_err) {
-  if (!doc || !cb) {
-    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
-    return GLTF_ERR_INVALID;
-  }
+// Everything about a primitive's topology that is validated once up front.
+typedef struct gltf_tri_src {
+  gltf_prim_mode mode;
+  int has_idx;
+  uint32_t idx_accessor;
+  uint32_t index_count; // indices (or vertices, when non-indexed)
+  uint32_t v_count;
+  uint32_t tri_count;
+} gltf_tri_src;
+
+static gltf_result gltf_tri_src_init(const gltf_doc* doc,
+                                     uint32_t primitive_index,
+                                     gltf_tri_src* out,
+                                     gltf_error* out_err) {
   if (primitive_index >= doc->primitive_count) {
     gltf_set_err(out_err, "primitive out of range", "root.primitives[]", 1, 1);
     return GLTF_ERR_INVALID;
   }
 
+  memset(out, 0, sizeof(*out));
+  out->mode = doc->primitives[primitive_index].mode;
+
   uint32_t pos_accessor = 0;
   int ret = gltf_doc_primitive_find_attribute(doc, primitive_index, GLTF_ATTR_POSITION, 0, &pos_accessor);
   if (!ret) {
@@ -546,19 +562,19 @@ gltf_result gltf_doc_primitive_iterate_triangles(const gltf_doc* doc,
     return GLTF_ERR_PARSE;
   }
 
-  if (v_count == 0) return GLTF_OK;
+  if (v_count == 0) return GLTF_OK;  // no triangles
   if (v_type != GLTF_ACCESSOR_VEC3) return GLTF_ERR_PARSE;
   if (v_comp != GLTF_COMP_F32) return GLTF_ERR_PARSE;
   if (v_norm) return GLTF_ERR_PARSE;
 
   int32_t idx_accessor = -1;
   int has_idx = gltf_doc_primitive_indices_accessor(doc, primitive_index, &idx_accessor);
-  
-  uint32_t i_count = 0, i_comp = 0, i_type = 0;
-  int i_norm = 0;
 
+  uint32_t n = v_count;
   if (has_idx) {
-    ret = gltf_doc_accessor_info(doc, (uint32_t)idx_accessor, &i_count, &i_comp, &i_type, &i_norm);
+    uint32_t i_comp = 0, i_type = 0;
+    int i_norm = 0;
+    ret = gltf_doc_accessor_info(doc, (uint32_t)idx_accessor, &n, &i_comp, &i_type, &i_norm);
 
     if (!ret) {
       gltf_set_err(out_err, "failed to get indices accessor info", "root.accessors[]", 1, 1);
@@ -581,96 +597,344 @@ gltf_result gltf_doc_primitive_iterate_triangles(const gltf_doc* doc,
     }
   }
 
-  switch (doc->primitives[primitive_index].mode) {
-    case GLTF_PRIM_TRIANGLES: {
-      uint32_t n = has_idx ? i_count : v_count;
-      
+  uint32_t tri_count = 0;
+  switch (out->mode) {
+    case GLTF_PRIM_TRIANGLES:
       if ((n % 3) != 0) {
         gltf_set_err(out_err, "TRIANGLES require count divisible by 3", "root.primitives[]", 1, 1);
         return GLTF_ERR_PARSE;
       }
+      tri_count = n / 3;
+      break;
 
-      uint32_t tri_count = n / 3;
+    case GLTF_PRIM_TRIANGLE_STRIP:
+    case GLTF_PRIM_TRIANGLE_FAN:
+      tri_count = (n < 3) ? 0 : n - 2;
+      break;
 
-      for (uint32_t t = 0; t < tri_count; t++) {
-        gltf_tri tri;
-        gltf_result r;
+    default:
+      gltf_set_err(out_err, "unsupported primitive mode", "root.primitives[].mode", 1, 1);
+      return GLTF_ERR_INVALID;
+  }
 
-        r = gltf_get_vertex_index(doc, has_idx, (uint32_t)idx_accessor, t * 3 + 0, v_count, &tri.i0, out_err);
-        if (r != GLTF_OK) return r;
-        r = gltf_get_vertex_index(doc, has_idx, (uint32_t)idx_accessor, t * 3 + 1, v_count, &tri.i1, out_err);
-        if (r != GLTF_OK) return r;
-        r = gltf_get_vertex_index(doc, has_idx, (uint32_t)idx_accessor, t * 3 + 2, v_count, &tri.i2, out_err);
-        if (r != GLTF_OK) return r;
+  out->has_idx = has_idx;
+  out->idx_accessor = has_idx ? (uint32_t)idx_accessor : 0u;
+  out->index_count = n;
+  out->v_count = v_count;
+  out->tri_count = tri_count;
+  return GLTF_OK;
+}
 
-        gltf_iter_result cb_r = cb(&tri, t, user);
-        if (cb_r == GLTF_ITER_STOP) {
-          return GLTF_OK;
-        }
-      }
-      break;
-    }
+// Reads count vertex indices starting at first and checks them against POSITION.count.
+static gltf_result gltf_tri_src_indices(const gltf_doc* doc,
+                                        const gltf_tri_src* src,
+                                        uint32_t first,
+                                        uint32_t count,
+                                        uint32_t* dst,
+                                        gltf_error* out_err) {
+  if (!src->has_idx) {
+    // Identity indices; index_count == v_count so they are in range.
+    for (uint32_t i = 0; i < count; i++) dst[i] = first + i;
+    return GLTF_OK;
+  }
+
+  uint32_t max_index = 0;
+  gltf_result r =
+    gltf_accessor_read_indices_u32(doc, src->idx_accessor, first, count, dst, NULL, &max_index, out_err);
+  if (r != GLTF_OK) return r;
+
+  if (count > 0 && max_index >= src->v_count) {
+    gltf_set_err(out_err, "index out of range", "root.accessors[]", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+  return GLTF_OK;
+}
 
-    case GLTF_PRIM_TRIANGLE_STRIP: {
-      uint32_t n = has_idx ? i_count : v_count;
+// Writes triangles [tri_first, tri_first + tri_count) with winding applied.
+// The range must already be clamped to src->tri_count.
+static gltf_result gltf_tri_src_read(const gltf_doc* doc,
+                                     const gltf_tri_src* src,
+                                     uint32_t tri_first,
+                                     uint32_t tri_count,
+                                     gltf_tri* dst,
+                                     gltf_error* out_err) {
+  uint32_t scratch[GLTF_TRI_BATCH_MAX + 2u];
+  gltf_result r;
 
-      if (n < 3) return GLTF_OK;
+  if (src->mode == GLTF_PRIM_TRIANGLES && sizeof(gltf_tri) == 3u * sizeof(uint32_t)) {
+    // gltf_tri is three packed uint32_t: decode the index list straight into dst.
+    return gltf_tri_src_indices(doc, src, tri_first * 3u, tri_count * 3u, (uint32_t*)(void*)dst, out_err);
+  }
 
-      const uint32_t tri_count = n - 2;
-      for (uint32_t t = 0; t < tri_count; t++) {
-        gltf_tri tri;
-        gltf_result r;
+  uint32_t fan_center = 0;
+  if (src->mode == GLTF_PRIM_TRIANGLE_FAN && tri_count > 0) {
+    r = gltf_tri_src_indices(doc, src, 0, 1, &fan_center, out_err);
+    if (r != GLTF_OK) return r;
+  }
 
-        r = gltf_get_vertex_index(doc, has_idx, (uint32_t)idx_accessor, t + 0, v_count, &tri.i0, out_err);
-        if (r != GLTF_OK) return r;
-        r = gltf_get_vertex_index(doc, has_idx, (uint32_t)idx_accessor, t + 1, v_count, &tri.i1, out_err);
+  while (tri_count > 0) {
+    const uint32_t n = (tri_count < GLTF_TRI_BATCH_MAX) ? tri_count : GLTF_TRI_BATCH_MAX;
+
+    switch (src->mode) {
+      case GLTF_PRIM_TRIANGLES:
+        r = gltf_tri_src_indices(doc, src, tri_first * 3u, n * 3u, scratch, out_err);
         if (r != GLTF_OK) return r;
-        r = gltf_get_vertex_index(doc, has_idx, (uint32_t)idx_accessor, t + 2, v_count, &tri.i2, out_err);
+        for (uint32_t k = 0; k < n; k++) {
+          dst[k].i0 = scratch[k * 3u + 0u];
+          dst[k].i1 = scratch[k * 3u + 1u];
+          dst[k].i2 = scratch[k * 3u + 2u];
+        }
+        break;
+
+      case GLTF_PRIM_TRIANGLE_STRIP:
+        // Triangle t uses indices t, t+1, t+2; odd t swaps the first two to
+        // keep orientation. Parity is taken from the absolute triangle index.
+        r = gltf_tri_src_indices(doc, src, tri_first, n + 2u, scratch, out_err);
         if (r != GLTF_OK) return r;
-        
-        if ((t & 1u) != 0u) {  // odd
-          uint32_t i_ = tri.i0;
-          tri.i0 = tri.i1;
-          tri.i1 = i_;
+        for (uint32_t k = 0; k < n; k++) {
+          const uint32_t odd = (tri_first + k) & 1u;
+          dst[k].i0 = scratch[k + odd];
+          dst[k].i1 = scratch[k + 1u - odd];
+          dst[k].i2 = scratch[k + 2u];
         }
+        break;
 
-        gltf_iter_result cb_r = cb(&tri, t, user);
-        if (cb_r == GLTF_ITER_STOP) {
-          return GLTF_OK;
+      default: // GLTF_PRIM_TRIANGLE_FAN
+        // Triangle t uses indices 0, t+1, t+2.
+        r = gltf_tri_src_indices(doc, src, tri_first + 1u, n + 1u, scratch, out_err);
+        if (r != GLTF_OK) return r;
+        for (uint32_t k = 0; k < n; k++) {
+          dst[k].i0 = fan_center;
+          dst[k].i1 = scratch[k];
+          dst[k].i2 = scratch[k + 1u];
         }
-      }
-      break;
+        break;
     }
 
-    case GLTF_PRIM_TRIANGLE_FAN: {
-      uint32_t tri_index = 0;
-      uint32_t n = has_idx ? i_count : v_count;
+    dst += n;
+    tri_first += n;
+    tri_count -= n;
+  }
+  return GLTF_OK;
+}
 
-      if (n < 3) return GLTF_OK;
+gltf_result gltf_doc_primitive_triangle_count(const gltf_doc* doc,
+                                              uint32_t primitive_index,
+                                              uint32_t* out_tri_count,
+                                              gltf_error* out_err) {
+  if (!doc || !out_tri_count) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
 
-      for (uint32_t t = 2; t < n; t++, tri_index++) {
-        gltf_tri tri;
-        gltf_result r;
+  gltf_tri_src src;
+  gltf_result r = gltf_tri_src_init(doc, primitive_index, &src, out_err);
+  if (r != GLTF_OK) return r;
 
-        r = gltf_get_vertex_index(doc, has_idx, (uint32_t)idx_accessor, 0, v_count, &tri.i0, out_err);
-        if (r != GLTF_OK) return r;
-        r = gltf_get_vertex_index(doc, has_idx, (uint32_t)idx_accessor, t - 1, v_count, &tri.i1, out_err);
-        if (r != GLTF_OK) return r;
-        r = gltf_get_vertex_index(doc, has_idx, (uint32_t)idx_accessor, t, v_count, &tri.i2, out_err);
-        if (r != GLTF_OK) return r;
+  *out_tri_count = src.tri_count;
+  return GLTF_OK;
+}
 
-        gltf_iter_result cb_r = cb(&tri, tri_index, user);
-        if (cb_r == GLTF_ITER_STOP) {
-          return GLTF_OK;
-        }
-      }
-      break;
+gltf_result gltf_doc_primitive_read_triangles(const gltf_doc* doc,
+                                              uint32_t primitive_index,
+                                              uint32_t tri_first,
+                                              uint32_t tri_count,
+                                              gltf_tri* dst,
+                                              gltf_error* out_err) {
+  if (!doc || (!dst && tri_count > 0)) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+
+  gltf_tri_src src;
+  gltf_result r = gltf_tri_src_init(doc, primitive_index, &src, out_err);
+  if (r != GLTF_OK) return r;
+
+  if (tri_first > src.tri_count || tri_count > src.tri_count - tri_first) {
+    gltf_set_err(out_err, "triangle range out of range", "root.primitives[]", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+  return gltf_tri_src_read(doc, &src, tri_first, tri_count, dst, out_err);
+}
+
+gltf_result gltf_doc_primitive_iterate_triangle_range(const gltf_doc* doc,
+                                                      uint32_t primitive_index,
+                                                      uint32_t tri_first,
+                                                      uint32_t tri_count,
+                                                      uint32_t batch_max,
+                                                      gltf_tri_batch_cb cb,
+                                                      void* user,
+                                                      gltf_error* out_err) {
+  if (!doc || !cb) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+  if (batch_max == 0 || batch_max > GLTF_TRI_BATCH_MAX) {
+    batch_max = GLTF_TRI_BATCH_MAX;
+  }
+
+  gltf_tri_src src;
+  gltf_result r = gltf_tri_src_init(doc, primitive_index, &src, out_err);
+  if (r != GLTF_OK) return r;
+
+  if (tri_count == UINT32_MAX) {
+    if (tri_first > src.tri_count) tri_first = src.tri_count;
+    tri_count = src.tri_count - tri_first;
+  }
+  if (tri_first > src.tri_count || tri_count > src.tri_count - tri_first) {
+    gltf_set_err(out_err, "triangle range out of range", "root.primitives[]", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+
+  gltf_tri batch[GLTF_TRI_BATCH_MAX];
+  const uint32_t end = tri_first + tri_count;
+  for (uint32_t t = tri_first; t < end; t += batch_max) {
+    const uint32_t remaining = end - t;
+    const uint32_t n = (remaining < batch_max) ? remaining : batch_max;
+
+    r = gltf_tri_src_read(doc, &src, t, n, batch, out_err);
+    if (r != GLTF_OK) return r;
+
+    if (cb(batch, t, n, user) == GLTF_ITER_STOP) {
+      return GLTF_OK;
     }
+  }
+  return GLTF_OK;
+}
 
-    default:
-      gltf_set_err(out_err, "unsupported primitive mode", "root.primitives[].mode", 1, 1);
-      return GLTF_ERR_INVALID;
+gltf_result gltf_doc_primitive_iterate_triangle_batches(const gltf_doc* doc,
+                                                        uint32_t primitive_index,
+                                                        uint32_t batch_max,
+                                                        gltf_tri_batch_cb cb,
+                                                        void* user,
+                                                        gltf_error* out_err) {
+  return gltf_doc_primitive_iterate_triangle_range(
+    doc, primitive_index, 0, UINT32_MAX, batch_max, cb, user, out_err);
+}
+
+// ----------------------------------------------------------------------------
+// Triangle work items (parallel iteration)
+// ----------------------------------------------------------------------------
+
+// Appends ceil(tri_count / target) evenly sized items for one primitive.
+// Items are only written while *io_count < items_cap; *io_count always advances.
+static void gltf_tri_split(uint32_t primitive_index,
+                           uint32_t tri_count,
+                           uint32_t target,
+                           gltf_tri_work_item* items,
+                           uint32_t items_cap,
+                           uint32_t* io_count) {
+  if (tri_count == 0) return;
+
+  const uint32_t chunks = tri_count / target + ((tri_count % target) ? 1u : 0u);
+  const uint32_t base = tri_count / chunks;
+  const uint32_t extra = tri_count % chunks; // first 'extra' chunks get one more
+
+  uint32_t first = 0;
+  for (uint32_t c = 0; c < chunks; c++) {
+    const uint32_t n = base + ((c < extra) ? 1u : 0u);
+    if (items && *io_count < items_cap) {
+      items[*io_count].primitive_index = primitive_index;
+      items[*io_count].tri_first = first;
+      items[*io_count].tri_count = n;
+    }
+    (*io_count)++;
+    first += n;
   }
+}
+
+gltf_result gltf_doc_primitive_triangle_work_items(const gltf_doc* doc,
+                                                   uint32_t primitive_index,
+                                                   uint32_t target_tris_per_item,
+                                                   gltf_tri_work_item* items,
+                                                   uint32_t items_cap,
+                                                   uint32_t* out_item_count,
+                                                   gltf_error* out_err) {
+  if (!doc || !out_item_count || target_tris_per_item == 0) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+
+  gltf_tri_src src;
+  gltf_result r = gltf_tri_src_init(doc, primitive_index, &src, out_err);
+  if (r != GLTF_OK) return r;
+
+  uint32_t n = 0;
+  gltf_tri_split(primitive_index, src.tri_count, target_tris_per_item, items, items_cap, &n);
+  *out_item_count = n;
 
+  if (items && n > items_cap) {
+    gltf_set_err(out_err, "output buffer too small", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
   return GLTF_OK;
 }
+
+gltf_result gltf_doc_triangle_work_items(const gltf_doc* doc,
+                                         uint32_t target_tris_per_item,
+                                         gltf_tri_work_item* items,
+                                         uint32_t items_cap,
+                                         uint32_t* out_item_count,
+                                         gltf_error* out_err) {
+  if (!doc || !out_item_count || target_tris_per_item == 0) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+
+  uint32_t n = 0;
+  for (uint32_t p = 0; p < doc->primitive_count; p++) {
+    const gltf_prim_mode mode = doc->primitives[p].mode;
+    if (!(mode == GLTF_PRIM_TRIANGLES || mode == GLTF_PRIM_TRIANGLE_STRIP ||
+          mode == GLTF_PRIM_TRIANGLE_FAN)) {
+      continue;  // points/lines produce no triangles
+    }
+
+    gltf_tri_src src;
+    gltf_result r = gltf_tri_src_init(doc, p, &src, out_err);
+    if (r != GLTF_OK) return r;
+
+    gltf_tri_split(p, src.tri_count, target_tris_per_item, items, items_cap, &n);
+  }
+  *out_item_count = n;
+
+  if (items && n > items_cap) {
+    gltf_set_err(out_err, "output buffer too small", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+  return GLTF_OK;
+}
+
+typedef struct gltf_tri_forward {
+  gltf_tri_cb cb;
+  void* user;
+} gltf_tri_forward;
+
+static gltf_iter_result gltf_tri_forward_batch(const gltf_tri* tris,
+                                               uint32_t tri_first,
+                                               uint32_t tri_count,
+                                               void* user) {
+  const gltf_tri_forward* fw = (const gltf_tri_forward*)user;
+  for (uint32_t k = 0; k < tri_count; k++) {
+    if (fw->cb(&tris[k], tri_first + k, fw->user) == GLTF_ITER_STOP) {
+      return GLTF_ITER_STOP;
+    }
+  }
+  return GLTF_ITER_CONTINUE;
+}
+
+gltf_result gltf_doc_primitive_iterate_triangles(const gltf_doc* doc,
+                                                 uint32_t primitive_index,
+                                                 gltf_tri_cb cb,
+                                                 void* user,
+                                                 gltf_error* out_err) {
+  if (!doc || !cb) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+
+  gltf_tri_forward fw;
+  fw.cb = cb;
+  fw.user = user;
+  return gltf_doc_primitive_iterate_triangle_batches(
+    doc, primitive_index, GLTF_TRI_BATCH_MAX, gltf_tri_forward_batch, &fw, out_err);
+}
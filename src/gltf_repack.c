@@ -0,0 +1,555 @@
+// Minimal educational glTF 2.0 loader (C11).
+//
+// Repacking: rewrites a .gltf / .glb as GLB or .gltf + .bin without loading
+// a document.
+//
+// Responsibilities:
+//   - read the source JSON (the JSON chunk of a mapped GLB, or the .gltf text)
+//     into one writable, padded buffer and parse it in place
+//   - resolve every buffer to bytes that are already in memory or mapped: the
+//     GLB BIN chunk, a mapped external file, or a data URI decoded over its
+//     own characters in the JSON text
+//   - lay the buffers out back to back (aligned) in one merged buffer and
+//     rebase bufferViews (and EXT_meshopt_compression) onto it; meshopt
+//     fallback buffers carry no bytes and stay separate buffers after it
+//   - stream the new JSON, then every source buffer, into the output file(s)
+//
+// Notes:
+//   - Nothing proportional to the buffer data is allocated; the kernel pages
+//     the mapped sources in while fwrite() copies them out.
+//   - copy_file_range()/sendfile() are not used: the GLB output interleaves
+//     headers, alignment gaps and decoded data URIs with file ranges, and
+//     both need non-portable feature macros here.
+//   - Public API contracts are documented in include/gltf/gltf.h.
+
+
+#include "gltf_internal.h"
+
+
+// ----------------------------------------------------------------------------
+// Internal helpers (fs)
+// ----------------------------------------------------------------------------
+
+// File system helpers implemented in src/fs.c.
+typedef enum gltf_fs_status {
+  GLTF_FS_OK = 0,
+  GLTF_FS_INVALID,
+  GLTF_FS_IO,
+  GLTF_FS_OOM,
+  GLTF_FS_SIZE_MISMATCH,
+  GLTF_FS_TOO_LARGE,
+  GLTF_FS_BAD_ARGUMENT
+} gltf_fs_status;
+
+size_t gltf_fs_dir_len(const char* path);
+
+char* gltf_fs_join_dir_leaf(const char* dir_prefix, size_t dir_len, const char* leaf);
+
+gltf_fs_status gltf_fs_map_file(const char* path,
+                                uint32_t expected_len,
+                                const uint8_t** out_data,
+                                size_t* out_size);
+
+void gltf_fs_unmap(const uint8_t* data, size_t size);
+
+gltf_fs_status gltf_fs_replace_file(const char* from, const char* to);
+
+
+// ----------------------------------------------------------------------------
+// State
+// ----------------------------------------------------------------------------
+
+#define GLTF_REPACK_DEFAULT_ALIGNMENT 16u
+
+// One source buffer, placed at offset in the merged buffer (or kept as
+// output buffer out_buffer if it is a meshopt fallback buffer).
+typedef struct gltf_repack_source {
+  const uint8_t* data;  // byte_length bytes (NULL when empty or fallback)
+  uint32_t byte_length;
+  uint64_t offset;
+  uint32_t fallback;    // EXT_meshopt_compression fallback: no bytes, not merged
+  uint32_t out_buffer;  // index in the output buffers array
+  const uint8_t* map;   // mapping owned by this source, or NULL
+  size_t map_size;
+} gltf_repack_source;
+
+typedef struct gltf_repack_state {
+  uint8_t* json_text;       // source JSON + YYJSON_PADDING_SIZE, parsed in place
+  const uint8_t* file_map;  // mapped input file (GLB: kept for the BIN chunk)
+  size_t file_map_size;
+  const uint8_t* bin;       // GLB BIN chunk payload, or NULL
+  uint32_t bin_len;
+
+  yyjson_doc* doc;
+  yyjson_mut_doc* out;
+  char* out_json;           // written output JSON
+  size_t out_json_len;
+
+  gltf_repack_source* sources;
+  uint32_t source_count;
+  uint32_t merged_count;    // sources placed in the merged buffer
+  uint64_t total;           // merged buffer byteLength
+} gltf_repack_state;
+
+static void gltf_repack_state_free(gltf_repack_state* s) {
+  for (uint32_t i = 0; i < s->source_count; i++) {
+    gltf_fs_unmap(s->sources[i].map, s->sources[i].map_size);
+  }
+  free(s->sources);
+  free(s->out_json);
+  yyjson_mut_doc_free(s->out);
+  yyjson_doc_free(s->doc);
+  gltf_fs_unmap(s->file_map, s->file_map_size);
+  free(s->json_text);
+}
+
+static uint64_t gltf_repack_align(uint64_t v, uint64_t alignment) {
+  return (v + (alignment - 1u)) & ~(alignment - 1u);
+}
+
+
+// ----------------------------------------------------------------------------
+// Reading
+// ----------------------------------------------------------------------------
+
+// Maps in_path and copies its JSON (the whole .gltf, or the GLB JSON chunk)
+// into a padded writable buffer; a GLB stays mapped for its BIN chunk.
+static gltf_result gltf_repack_read(gltf_repack_state* s, const char* in_path, gltf_error* out_err) {
+  if (gltf_fs_map_file(in_path, 0, &s->file_map, &s->file_map_size) != GLTF_FS_OK) {
+    gltf_set_err(out_err, "failed to read file", in_path, 1, 1);
+    return GLTF_ERR_IO;
+  }
+
+  const uint8_t* json = s->file_map;
+  uint32_t json_len = (uint32_t)s->file_map_size;
+  const int is_glb = s->file_map_size >= 4u && rd_u32_le(s->file_map) == 0x46546C67u; // 'glTF'
+  if (is_glb) {
+    gltf_result r = gltf_glb_split(s->file_map, s->file_map_size, &json, &json_len,
+                                   &s->bin, &s->bin_len, out_err);
+    if (r != GLTF_OK) return r;
+  }
+
+  s->json_text = (uint8_t*)malloc((size_t)json_len + YYJSON_PADDING_SIZE);
+  if (!s->json_text) {
+    gltf_set_err(out_err, "out of memory", "root", 1, 1);
+    return GLTF_ERR_IO;
+  }
+  if (json_len > 0) memcpy(s->json_text, json, json_len);
+  memset(s->json_text + json_len, 0, YYJSON_PADDING_SIZE);
+
+  if (!is_glb) {
+    gltf_fs_unmap(s->file_map, s->file_map_size);
+    s->file_map = NULL;
+    s->file_map_size = 0;
+  }
+
+  yyjson_read_err err;
+  s->doc = yyjson_read_opts((char*)s->json_text, json_len, YYJSON_READ_INSITU, NULL, &err);
+  if (!s->doc) {
+    gltf_set_err(out_err, err.msg, "root", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+  if (!yyjson_is_obj(yyjson_doc_get_root(s->doc))) {
+    gltf_set_err(out_err, "must be object", "root", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+  return GLTF_OK;
+}
+
+// Resolves every buffer to in-memory or mapped bytes and lays them out in the
+// merged buffer.
+static gltf_result gltf_repack_sources(gltf_repack_state* s,
+                                       const char* in_path,
+                                       uint32_t alignment,
+                                       gltf_error* out_err) {
+  yyjson_val* buffers = yyjson_obj_get(yyjson_doc_get_root(s->doc), "buffers");
+  if (!buffers) return GLTF_OK;
+  if (!yyjson_is_arr(buffers)) {
+    gltf_set_err(out_err, "must be array", "root.buffers", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+
+  const size_t count = yyjson_arr_size(buffers);
+  if (count == 0) return GLTF_OK;
+  if (count > UINT32_MAX) {
+    gltf_set_err(out_err, "too many buffers", "root.buffers", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+  s->sources = (gltf_repack_source*)calloc(count, sizeof(gltf_repack_source));
+  if (!s->sources) {
+    gltf_set_err(out_err, "out of memory", "root.buffers", 1, 1);
+    return GLTF_ERR_IO;
+  }
+
+  const size_t dir_len = gltf_fs_dir_len(in_path);
+  size_t idx, max;
+  yyjson_val* buf;
+  yyjson_arr_foreach(buffers, idx, max, buf) {
+    gltf_repack_source* src = &s->sources[idx];
+    s->source_count = (uint32_t)idx + 1u;
+
+    if (!yyjson_is_obj(buf)) {
+      gltf_set_err(out_err, "must be object", "root.buffers[]", 1, 1);
+      return GLTF_ERR_PARSE;
+    }
+    yyjson_val* len_val = yyjson_obj_get(buf, "byteLength");
+    if (!yyjson_is_uint(len_val) || yyjson_get_uint(len_val) > UINT32_MAX) {
+      gltf_set_err(out_err, "must be uint32", "root.buffers[].byteLength", 1, 1);
+      return GLTF_ERR_PARSE;
+    }
+    src->byte_length = (uint32_t)yyjson_get_uint(len_val);
+
+    yyjson_val* uri_val = yyjson_obj_get(buf, "uri");
+    if (uri_val && !yyjson_is_str(uri_val)) {
+      gltf_set_err(out_err, "must be string", "root.buffers[].uri", 1, 1);
+      return GLTF_ERR_PARSE;
+    }
+    const char* uri = yyjson_get_str(uri_val);
+
+    yyjson_val* meshopt = yyjson_obj_get(yyjson_obj_get(buf, "extensions"), "EXT_meshopt_compression");
+    if (!uri && yyjson_is_true(yyjson_obj_get(meshopt, "fallback"))) {
+      // Placeholder for decoders without meshopt support: it has no bytes,
+      // so it is kept as its own uri-less buffer instead of zero-filled.
+      src->fallback = 1u;
+      continue;
+    }
+
+    if (!uri) {
+      // GLB BIN chunk (may be longer than byteLength by its padding).
+      if (idx != 0 || !s->bin || src->byte_length > s->bin_len) {
+        gltf_set_err(out_err, "buffer without uri requires a GLB BIN chunk", "root.buffers[].uri", 1, 1);
+        return GLTF_ERR_PARSE;
+      }
+      src->data = s->bin;
+    } else if (strncmp(uri, "data:", 5) == 0) {
+      // The string lives in json_text (in-place parse): decode over it.
+      uint8_t* data = NULL;
+      gltf_result r = gltf_decode_data_uri_insitu((char*)(uintptr_t)uri, src->byte_length, &data, out_err);
+      if (r != GLTF_OK) return r;
+      src->data = data;
+    } else if (src->byte_length > 0) {
+      char* full = gltf_fs_join_dir_leaf(in_path, dir_len, uri);
+      if (!full) {
+        gltf_set_err(out_err, "out of memory", "root.buffers[].uri", 1, 1);
+        return GLTF_ERR_IO;
+      }
+      gltf_fs_status st = gltf_fs_map_file(full, src->byte_length, &src->map, &src->map_size);
+      free(full);
+      if (st == GLTF_FS_SIZE_MISMATCH) {
+        gltf_set_err(out_err, "buffer file size does not match byteLength", "root.buffers[].byteLength", 1, 1);
+        return GLTF_ERR_PARSE;
+      }
+      if (st != GLTF_FS_OK) {
+        gltf_set_err(out_err, "failed to read buffer file", "root.buffers[].uri", 1, 1);
+        return GLTF_ERR_IO;
+      }
+      src->data = src->map;
+    }
+
+    src->offset = gltf_repack_align(s->total, alignment);
+    s->total = src->offset + src->byte_length;
+    s->merged_count++;
+    if (s->total > UINT32_MAX) {
+      gltf_set_err(out_err, "merged buffer exceeds 4 GiB", "root.buffers", 1, 1);
+      return GLTF_ERR_RANGE;
+    }
+  }
+
+  // Output buffers: the merged one first, then the fallbacks in source order.
+  uint32_t next = s->merged_count ? 1u : 0u;
+  for (uint32_t i = 0; i < s->source_count; i++) {
+    s->sources[i].out_buffer = s->sources[i].fallback ? next++ : 0u;
+  }
+  return GLTF_OK;
+}
+
+
+// ----------------------------------------------------------------------------
+// JSON rewrite
+// ----------------------------------------------------------------------------
+
+// Points a {buffer, byteOffset} object at its output buffer (offsets only
+// move for sources placed in the merged buffer).
+static gltf_result gltf_repack_rebase(const gltf_repack_state* s,
+                                      yyjson_mut_doc* out,
+                                      yyjson_mut_val* obj,
+                                      const char* path,
+                                      gltf_error* out_err) {
+  yyjson_mut_val* buffer = yyjson_mut_obj_get(obj, "buffer");
+  if (!yyjson_mut_is_uint(buffer) || yyjson_mut_get_uint(buffer) >= s->source_count) {
+    gltf_set_err(out_err, "buffer index out of range", path, 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+  const gltf_repack_source* src = &s->sources[yyjson_mut_get_uint(buffer)];
+  yyjson_mut_set_uint(buffer, src->out_buffer);
+
+  yyjson_mut_val* offset = yyjson_mut_obj_get(obj, "byteOffset");
+  if (offset && !yyjson_mut_is_uint(offset)) {
+    gltf_set_err(out_err, "must be uint", path, 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+  if (src->fallback || src->offset == 0) return GLTF_OK;
+  if (offset) {
+    yyjson_mut_set_uint(offset, yyjson_mut_get_uint(offset) + src->offset);
+  } else if (!yyjson_mut_obj_add_uint(out, obj, "byteOffset", src->offset)) {
+    gltf_set_err(out_err, "out of memory", path, 1, 1);
+    return GLTF_ERR_IO;
+  }
+  return GLTF_OK;
+}
+
+static gltf_result gltf_repack_buffer_views(const gltf_repack_state* s,
+                                            yyjson_mut_doc* out,
+                                            yyjson_mut_val* views,
+                                            gltf_error* out_err) {
+  if (!yyjson_mut_is_arr(views)) {
+    gltf_set_err(out_err, "must be array", "root.bufferViews", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+  size_t idx, max;
+  yyjson_mut_val* view;
+  yyjson_mut_arr_foreach(views, idx, max, view) {
+    if (!yyjson_mut_is_obj(view)) {
+      gltf_set_err(out_err, "must be object", "root.bufferViews[]", 1, 1);
+      return GLTF_ERR_PARSE;
+    }
+    gltf_result r = gltf_repack_rebase(s, out, view, "root.bufferViews[].buffer", out_err);
+    if (r != GLTF_OK) return r;
+
+    yyjson_mut_val* meshopt = yyjson_mut_obj_get(yyjson_mut_obj_get(view, "extensions"),
+                                                 "EXT_meshopt_compression");
+    if (yyjson_mut_is_obj(meshopt)) {
+      r = gltf_repack_rebase(s, out, meshopt,
+                             "root.bufferViews[].extensions.EXT_meshopt_compression.buffer", out_err);
+      if (r != GLTF_OK) return r;
+    }
+  }
+  return GLTF_OK;
+}
+
+// Copies the source root with "buffers" replaced by the merged buffer and the
+// fallback buffers (copied as written).
+static gltf_result gltf_repack_json(gltf_repack_state* s,
+                                    const char* bin_uri,
+                                    uint32_t write_flags,
+                                    gltf_error* out_err) {
+  s->out = yyjson_mut_doc_new(NULL);
+  yyjson_mut_val* root = s->out ? yyjson_mut_obj(s->out) : NULL;
+  if (!root) {
+    gltf_set_err(out_err, "out of memory", "root", 1, 1);
+    return GLTF_ERR_IO;
+  }
+  yyjson_mut_doc_set_root(s->out, root);
+
+  size_t idx, max;
+  yyjson_val *key, *val;
+  yyjson_obj_foreach(yyjson_doc_get_root(s->doc), idx, max, key, val) {
+    yyjson_mut_val* v = NULL;
+    if (strcmp(yyjson_get_str(key), "buffers") == 0) {
+      // The merged source buffers (and their data URI text) are never copied.
+      if (s->source_count == 0) continue;
+      v = yyjson_mut_arr(s->out);
+      if (v && s->merged_count > 0) {
+        yyjson_mut_val* merged = yyjson_mut_obj(s->out);
+        if (!merged || !yyjson_mut_obj_add_uint(s->out, merged, "byteLength", s->total) ||
+            (bin_uri && !yyjson_mut_obj_add_str(s->out, merged, "uri", bin_uri)) ||
+            !yyjson_mut_arr_append(v, merged)) {
+          v = NULL;
+        }
+      }
+      for (uint32_t i = 0; v && i < s->source_count; i++) {
+        if (!s->sources[i].fallback) continue;
+        yyjson_mut_val* fallback = yyjson_val_mut_copy(s->out, yyjson_arr_get(val, i));
+        if (!fallback || !yyjson_mut_arr_append(v, fallback)) v = NULL;
+      }
+    } else {
+      v = yyjson_val_mut_copy(s->out, val);
+      if (v && strcmp(yyjson_get_str(key), "bufferViews") == 0) {
+        gltf_result r = gltf_repack_buffer_views(s, s->out, v, out_err);
+        if (r != GLTF_OK) return r;
+      }
+    }
+    yyjson_mut_val* k = yyjson_val_mut_copy(s->out, key);
+    if (!v || !k || !yyjson_mut_obj_add(root, k, v)) {
+      gltf_set_err(out_err, "out of memory", "root", 1, 1);
+      return GLTF_ERR_IO;
+    }
+  }
+
+  yyjson_write_err err;
+  s->out_json = yyjson_mut_write_opts(s->out, write_flags, NULL, &s->out_json_len, &err);
+  if (!s->out_json) {
+    gltf_set_err(out_err, err.msg, "root", 1, 1);
+    return GLTF_ERR_IO;
+  }
+  return GLTF_OK;
+}
+
+
+// ----------------------------------------------------------------------------
+// Writing
+// ----------------------------------------------------------------------------
+
+static int gltf_repack_write_fill(FILE* f, uint8_t byte, uint64_t count) {
+  uint8_t fill[256];
+  memset(fill, byte, sizeof fill);
+  while (count > 0) {
+    const size_t n = count < sizeof fill ? (size_t)count : sizeof fill;
+    if (fwrite(fill, 1, n, f) != n) return 0;
+    count -= n;
+  }
+  return 1;
+}
+
+static int gltf_repack_write_u32(FILE* f, uint32_t v) {
+  const uint8_t b[4] = { (uint8_t)v, (uint8_t)(v >> 8u), (uint8_t)(v >> 16u), (uint8_t)(v >> 24u) };
+  return fwrite(b, 1, 4, f) == 4;
+}
+
+// Writes the merged buffer: every source at its offset, zero-filled gaps.
+static int gltf_repack_write_bin(FILE* f, const gltf_repack_state* s) {
+  uint64_t pos = 0;
+  for (uint32_t i = 0; i < s->source_count; i++) {
+    const gltf_repack_source* src = &s->sources[i];
+    if (src->fallback) continue;
+    if (!gltf_repack_write_fill(f, 0u, src->offset - pos)) return 0;
+    if (src->byte_length > 0 && fwrite(src->data, 1, src->byte_length, f) != src->byte_length) return 0;
+    pos = src->offset + src->byte_length;
+  }
+  return 1;
+}
+
+static int gltf_repack_write_glb(FILE* f, const gltf_repack_state* s) {
+  const uint64_t json_chunk = gltf_repack_align(s->out_json_len, 4u);
+  const uint64_t bin_chunk = gltf_repack_align(s->total, 4u);
+  return gltf_repack_write_u32(f, 0x46546C67u) && // 'glTF'
+         gltf_repack_write_u32(f, 2u) &&
+         gltf_repack_write_u32(f, (uint32_t)(12u + 8u + json_chunk + (s->merged_count ? 8u + bin_chunk : 0u))) &&
+         gltf_repack_write_u32(f, (uint32_t)json_chunk) &&
+         gltf_repack_write_u32(f, 0x4E4F534Au) && // 'JSON'
+         fwrite(s->out_json, 1, s->out_json_len, f) == s->out_json_len &&
+         gltf_repack_write_fill(f, (uint8_t)' ', json_chunk - s->out_json_len) &&
+         (s->merged_count == 0 ||
+          (gltf_repack_write_u32(f, (uint32_t)bin_chunk) &&
+           gltf_repack_write_u32(f, 0x004E4942u) && // 'BIN\0'
+           gltf_repack_write_bin(f, s) &&
+           gltf_repack_write_fill(f, 0u, bin_chunk - s->total)));
+}
+
+typedef enum gltf_repack_part {
+  GLTF_REPACK_PART_GLB,
+  GLTF_REPACK_PART_JSON,
+  GLTF_REPACK_PART_BIN
+} gltf_repack_part;
+
+// Writes one output part to path + ".tmp" and returns the malloc'd temporary
+// path (NULL on failure).
+static char* gltf_repack_write_tmp(const gltf_repack_state* s, const char* path, gltf_repack_part part) {
+  const size_t path_len = strlen(path);
+  char* tmp = (char*)malloc(path_len + 5u);
+  if (!tmp) return NULL;
+  memcpy(tmp, path, path_len);
+  memcpy(tmp + path_len, ".tmp", 5u);
+
+  FILE* f = fopen(tmp, "wb");
+  int ok = f != NULL;
+  if (ok) {
+    switch (part) {
+      case GLTF_REPACK_PART_GLB:  ok = gltf_repack_write_glb(f, s); break;
+      case GLTF_REPACK_PART_JSON: ok = fwrite(s->out_json, 1, s->out_json_len, f) == s->out_json_len; break;
+      case GLTF_REPACK_PART_BIN:  ok = gltf_repack_write_bin(f, s); break;
+    }
+  }
+  if (f && fclose(f) != 0) ok = 0;
+  if (!ok) {
+    if (f) (void)remove(tmp);
+    free(tmp);
+    return NULL;
+  }
+  return tmp;
+}
+
+// The default .bin uri: the leaf of out_path with its extension replaced.
+static char* gltf_repack_default_bin_uri(const char* out_path) {
+  const char* leaf = out_path + gltf_fs_dir_len(out_path);
+  const char* dot = strrchr(leaf, '.');
+  const size_t stem = dot && dot != leaf ? (size_t)(dot - leaf) : strlen(leaf);
+  char* uri = (char*)malloc(stem + 5u);
+  if (!uri) return NULL;
+  memcpy(uri, leaf, stem);
+  memcpy(uri + stem, ".bin", 5u);
+  return uri;
+}
+
+
+// ----------------------------------------------------------------------------
+// Public API
+// ----------------------------------------------------------------------------
+
+gltf_result gltf_repack_file(const char* in_path,
+                             const char* out_path,
+                             const gltf_repack_options* opts,
+                             gltf_error* out_err) {
+  if (!in_path || !out_path || !opts || !out_err) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+  const uint32_t alignment = opts->alignment ? opts->alignment : GLTF_REPACK_DEFAULT_ALIGNMENT;
+  if ((opts->format != GLTF_REPACK_GLB && opts->format != GLTF_REPACK_GLTF) ||
+      alignment < 4u || (alignment & (alignment - 1u)) != 0u) {
+    gltf_set_err(out_err, "invalid repack options", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+  const int glb = opts->format == GLTF_REPACK_GLB;
+
+  gltf_repack_state s;
+  memset(&s, 0, sizeof s);
+  char* default_uri = NULL;
+  const char* bin_uri = NULL;
+  char* bin_path = NULL;
+
+  gltf_result r = gltf_repack_read(&s, in_path, out_err);
+  if (r == GLTF_OK) r = gltf_repack_sources(&s, in_path, alignment, out_err);
+
+  if (r == GLTF_OK && !glb && s.merged_count > 0) {
+    default_uri = opts->bin_uri ? NULL : gltf_repack_default_bin_uri(out_path);
+    bin_uri = opts->bin_uri ? opts->bin_uri : default_uri;
+    bin_path = bin_uri ? gltf_fs_join_dir_leaf(out_path, gltf_fs_dir_len(out_path), bin_uri) : NULL;
+    if (!bin_path) {
+      gltf_set_err(out_err, "out of memory", "root", 1, 1);
+      r = GLTF_ERR_IO;
+    }
+  }
+  if (r == GLTF_OK) {
+    const uint32_t write_flags = (opts->flags & GLTF_REPACK_PRETTY_JSON) ? YYJSON_WRITE_PRETTY : 0u;
+    r = gltf_repack_json(&s, bin_uri, write_flags, out_err);
+  }
+  if (r == GLTF_OK && glb &&
+      12u + 8u + gltf_repack_align(s.out_json_len, 4u) + 8u + gltf_repack_align(s.total, 4u) > UINT32_MAX) {
+    gltf_set_err(out_err, "glb exceeds 4 GiB", "root", 1, 1);
+    r = GLTF_ERR_RANGE;
+  }
+
+  if (r == GLTF_OK) {
+    // Both files are complete before either replaces an existing one.
+    char* tmp = gltf_repack_write_tmp(&s, out_path, glb ? GLTF_REPACK_PART_GLB : GLTF_REPACK_PART_JSON);
+    char* bin_tmp = (tmp && bin_path) ? gltf_repack_write_tmp(&s, bin_path, GLTF_REPACK_PART_BIN) : NULL;
+    int ok = tmp && (!bin_path || bin_tmp);
+    ok = ok && (!bin_tmp || gltf_fs_replace_file(bin_tmp, bin_path) == GLTF_FS_OK);
+    ok = ok && gltf_fs_replace_file(tmp, out_path) == GLTF_FS_OK;
+    if (!ok) {
+      if (tmp) (void)remove(tmp);
+      if (bin_tmp) (void)remove(bin_tmp);
+      gltf_set_err(out_err, "failed to write file", out_path, 1, 1);
+      r = GLTF_ERR_IO;
+    }
+    free(bin_tmp);
+    free(tmp);
+  }
+
+  free(bin_path);
+  free(default_uri);
+  gltf_repack_state_free(&s);
+  if (r == GLTF_OK) gltf_set_err(out_err, NULL, NULL, 0, 0);
+  return r;
+}
@@ -0,0 +1,196 @@
+// Minimal educational glTF 2.0 loader (C11).
+//
+// Internal SIMD selection shared by the vectorized kernels.
+//
+// Scope:
+//   - detects which instruction sets the translation unit is compiled for
+//   - pulls in the matching intrinsics headers
+//   - gltf_f32x4: a minimal 4-wide float vector shared by the math kernels
+//
+// Flags (each defined to 0 or 1):
+//   - GLTF_SIMD_SSE2 : x86/x64 with SSE2 (always on for x64)
+//   - GLTF_SIMD_SSSE3: x86/x64 compiled with SSSE3 (e.g. -mssse3; implied by AVX)
+//   - GLTF_SIMD_AVX2 : x86/x64 compiled with AVX2 (e.g. -mavx2, /arch:AVX2)
+//   - GLTF_SIMD_NEON : AArch64 Advanced SIMD
+//
+// Notes:
+//   - Selection is compile-time only; there is no runtime CPU dispatch.
+//   - Building with GLTF_ENABLE_SIMD=0 forces every kernel onto its scalar path.
+//   - Every SIMD kernel must produce bit-identical results to its scalar fallback.
+//   - This is an internal header and is not part of the public API.
+
+#pragma once
+
+#ifndef GLTF_ENABLE_SIMD
+#define GLTF_ENABLE_SIMD 1
+#endif
+
+#if GLTF_ENABLE_SIMD && (defined(__SSE2__) || defined(_M_X64) || \
+                         (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define GLTF_SIMD_SSE2 1
+#include <emmintrin.h>
+#else
+#define GLTF_SIMD_SSE2 0
+#endif
+
+#if GLTF_SIMD_SSE2 && (defined(__SSSE3__) || defined(__AVX__))
+#define GLTF_SIMD_SSSE3 1
+#include <tmmintrin.h>
+#else
+#define GLTF_SIMD_SSSE3 0
+#endif
+
+#if GLTF_SIMD_SSE2 && defined(__AVX2__)
+#define GLTF_SIMD_AVX2 1
+#include <immintrin.h>
+#else
+#define GLTF_SIMD_AVX2 0
+#endif
+
+#if GLTF_ENABLE_SIMD && (defined(__ARM_NEON) || defined(_M_ARM64)) && \
+    (defined(__aarch64__) || defined(_M_ARM64))
+#define GLTF_SIMD_NEON 1
+#include <arm_neon.h>
+#else
+#define GLTF_SIMD_NEON 0
+#endif
+
+// Host byte order: raw little-endian buffer data can be copied as-is.
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+#define GLTF_HOST_LITTLE_ENDIAN (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#elif defined(_WIN32)
+#define GLTF_HOST_LITTLE_ENDIAN 1
+#else
+#define GLTF_HOST_LITTLE_ENDIAN 0
+#endif
+
+
+// ----------------------------------------------------------------------------
+// gltf_f32x4 (4 x float)
+// ----------------------------------------------------------------------------
+//
+// Only the operations the kernels need. Each backend performs exactly one IEEE
+// operation per lane per call, so results match the scalar fallback as long as
+// the compiler does not contract the scalar code into FMAs.
+
+#if GLTF_SIMD_SSE2
+
+typedef __m128 gltf_f32x4;
+
+static inline gltf_f32x4 gltf_f32x4_load(const float* p) { return _mm_loadu_ps(p); }
+static inline void gltf_f32x4_store(float* p, gltf_f32x4 v) { _mm_storeu_ps(p, v); }
+static inline gltf_f32x4 gltf_f32x4_set1(float v) { return _mm_set1_ps(v); }
+static inline gltf_f32x4 gltf_f32x4_add(gltf_f32x4 a, gltf_f32x4 b) { return _mm_add_ps(a, b); }
+static inline gltf_f32x4 gltf_f32x4_sub(gltf_f32x4 a, gltf_f32x4 b) { return _mm_sub_ps(a, b); }
+static inline gltf_f32x4 gltf_f32x4_mul(gltf_f32x4 a, gltf_f32x4 b) { return _mm_mul_ps(a, b); }
+static inline gltf_f32x4 gltf_f32x4_div(gltf_f32x4 a, gltf_f32x4 b) { return _mm_div_ps(a, b); }
+// a < b ? a : b and a > b ? a : b per lane (so a NaN in a yields b).
+static inline gltf_f32x4 gltf_f32x4_min(gltf_f32x4 a, gltf_f32x4 b) { return _mm_min_ps(a, b); }
+static inline gltf_f32x4 gltf_f32x4_max(gltf_f32x4 a, gltf_f32x4 b) { return _mm_max_ps(a, b); }
+static inline gltf_f32x4 gltf_f32x4_abs(gltf_f32x4 a) {
+  return _mm_and_ps(a, _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF)));
+}
+// a < b ? t : f per lane.
+static inline gltf_f32x4 gltf_f32x4_select_lt(gltf_f32x4 a, gltf_f32x4 b, gltf_f32x4 t, gltf_f32x4 f) {
+  const __m128 m = _mm_cmplt_ps(a, b);
+  return _mm_or_ps(_mm_and_ps(m, t), _mm_andnot_ps(m, f));
+}
+
+// Transposes the 4x4 matrix whose rows are a, b, c, d.
+static inline void gltf_f32x4_transpose(gltf_f32x4* a, gltf_f32x4* b, gltf_f32x4* c, gltf_f32x4* d) {
+  _MM_TRANSPOSE4_PS(*a, *b, *c, *d);
+}
+
+#elif GLTF_SIMD_NEON
+
+typedef float32x4_t gltf_f32x4;
+
+static inline gltf_f32x4 gltf_f32x4_load(const float* p) { return vld1q_f32(p); }
+static inline void gltf_f32x4_store(float* p, gltf_f32x4 v) { vst1q_f32(p, v); }
+static inline gltf_f32x4 gltf_f32x4_set1(float v) { return vdupq_n_f32(v); }
+static inline gltf_f32x4 gltf_f32x4_add(gltf_f32x4 a, gltf_f32x4 b) { return vaddq_f32(a, b); }
+static inline gltf_f32x4 gltf_f32x4_sub(gltf_f32x4 a, gltf_f32x4 b) { return vsubq_f32(a, b); }
+static inline gltf_f32x4 gltf_f32x4_mul(gltf_f32x4 a, gltf_f32x4 b) { return vmulq_f32(a, b); }
+static inline gltf_f32x4 gltf_f32x4_div(gltf_f32x4 a, gltf_f32x4 b) { return vdivq_f32(a, b); }
+// Compare-and-select rather than vminq/vmaxq, which propagate NaNs.
+static inline gltf_f32x4 gltf_f32x4_min(gltf_f32x4 a, gltf_f32x4 b) { return vbslq_f32(vcltq_f32(a, b), a, b); }
+static inline gltf_f32x4 gltf_f32x4_max(gltf_f32x4 a, gltf_f32x4 b) { return vbslq_f32(vcgtq_f32(a, b), a, b); }
+static inline gltf_f32x4 gltf_f32x4_abs(gltf_f32x4 a) { return vabsq_f32(a); }
+static inline gltf_f32x4 gltf_f32x4_select_lt(gltf_f32x4 a, gltf_f32x4 b, gltf_f32x4 t, gltf_f32x4 f) {
+  return vbslq_f32(vcltq_f32(a, b), t, f);
+}
+
+static inline void gltf_f32x4_transpose(gltf_f32x4* a, gltf_f32x4* b, gltf_f32x4* c, gltf_f32x4* d) {
+  const float32x4x2_t ab = vtrnq_f32(*a, *b); // (a0 b0 a2 b2), (a1 b1 a3 b3)
+  const float32x4x2_t cd = vtrnq_f32(*c, *d); // (c0 d0 c2 d2), (c1 d1 c3 d3)
+  *a = vcombine_f32(vget_low_f32(ab.val[0]), vget_low_f32(cd.val[0]));
+  *b = vcombine_f32(vget_low_f32(ab.val[1]), vget_low_f32(cd.val[1]));
+  *c = vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0]));
+  *d = vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1]));
+}
+
+#else
+
+#include <math.h>
+
+typedef struct gltf_f32x4 {
+  float v[4];
+} gltf_f32x4;
+
+static inline gltf_f32x4 gltf_f32x4_load(const float* p) {
+  gltf_f32x4 r;
+  for (int i = 0; i < 4; i++) r.v[i] = p[i];
+  return r;
+}
+static inline void gltf_f32x4_store(float* p, gltf_f32x4 v) {
+  for (int i = 0; i < 4; i++) p[i] = v.v[i];
+}
+static inline gltf_f32x4 gltf_f32x4_set1(float x) {
+  gltf_f32x4 r;
+  for (int i = 0; i < 4; i++) r.v[i] = x;
+  return r;
+}
+static inline gltf_f32x4 gltf_f32x4_add(gltf_f32x4 a, gltf_f32x4 b) {
+  for (int i = 0; i < 4; i++) a.v[i] = a.v[i] + b.v[i];
+  return a;
+}
+static inline gltf_f32x4 gltf_f32x4_sub(gltf_f32x4 a, gltf_f32x4 b) {
+  for (int i = 0; i < 4; i++) a.v[i] = a.v[i] - b.v[i];
+  return a;
+}
+static inline gltf_f32x4 gltf_f32x4_mul(gltf_f32x4 a, gltf_f32x4 b) {
+  for (int i = 0; i < 4; i++) a.v[i] = a.v[i] * b.v[i];
+  return a;
+}
+static inline gltf_f32x4 gltf_f32x4_div(gltf_f32x4 a, gltf_f32x4 b) {
+  for (int i = 0; i < 4; i++) a.v[i] = a.v[i] / b.v[i];
+  return a;
+}
+static inline gltf_f32x4 gltf_f32x4_min(gltf_f32x4 a, gltf_f32x4 b) {
+  for (int i = 0; i < 4; i++) a.v[i] = a.v[i] < b.v[i] ? a.v[i] : b.v[i];
+  return a;
+}
+static inline gltf_f32x4 gltf_f32x4_max(gltf_f32x4 a, gltf_f32x4 b) {
+  for (int i = 0; i < 4; i++) a.v[i] = a.v[i] > b.v[i] ? a.v[i] : b.v[i];
+  return a;
+}
+static inline gltf_f32x4 gltf_f32x4_abs(gltf_f32x4 a) {
+  for (int i = 0; i < 4; i++) a.v[i] = fabsf(a.v[i]);
+  return a;
+}
+static inline gltf_f32x4 gltf_f32x4_select_lt(gltf_f32x4 a, gltf_f32x4 b, gltf_f32x4 t, gltf_f32x4 f) {
+  for (int i = 0; i < 4; i++) t.v[i] = a.v[i] < b.v[i] ? t.v[i] : f.v[i];
+  return t;
+}
+static inline void gltf_f32x4_transpose(gltf_f32x4* a, gltf_f32x4* b, gltf_f32x4* c, gltf_f32x4* d) {
+  gltf_f32x4* rows[4] = { a, b, c, d };
+  float m[4][4];
+  for (int r = 0; r < 4; r++) {
+    for (int k = 0; k < 4; k++) m[k][r] = rows[r]->v[k];
+  }
+  for (int r = 0; r < 4; r++) {
+    for (int k = 0; k < 4; k++) rows[r]->v[k] = m[r][k];
+  }
+}
+
+#endif
@@ -0,0 +1,218 @@
+// Minimal educational glTF 2.0 loader (C11).
+//
+// This module implements load statistics (gltf_load_options.stats).
+//
+// Responsibilities:
+//   - time load stages with a monotonic clock and report them to the trace hook
+//   - count the JSON parser's allocations through a wrapping yyjson_alc
+//   - classify loaded buffers and sum bytes read, mapped and decoded, and the
+//     time spent on file I/O and on base64 decoding
+//   - record document block, string pool and index list usage
+//
+// Notes:
+//   - The loaders call these hooks unconditionally; each returns at once for a
+//     NULL stats pointer, and GLTF_ENABLE_STATS=0 replaces them with empty
+//     inline functions (see gltf_internal.h).
+//   - Only the loading thread writes the stats; buffer tasks time themselves
+//     into their job and are summed and classified after they have all
+//     finished.
+//   - Public API contracts are documented in include/gltf/gltf.h.
+
+
+// clock_gettime is POSIX, not C11; request it explicitly (before any include).
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "gltf_internal.h"
+
+#ifndef _WIN32
+#include <time.h>
+#endif
+
+
+// ----------------------------------------------------------------------------
+// Stage names (always available)
+// ----------------------------------------------------------------------------
+
+const char* gltf_load_stage_name(gltf_load_stage stage) {
+  static const char* const k_names[GLTF_LOAD_STAGE_COUNT] = {
+    "read", "json", "presize", "scenes", "nodes", "meshes", "accessors",
+    "buffer_views", "buffers", "images", "samplers", "textures", "materials", "index",
+  };
+  if ((unsigned)stage >= (unsigned)GLTF_LOAD_STAGE_COUNT) return "unknown";
+  return k_names[stage];
+}
+
+#if GLTF_ENABLE_STATS
+
+// ----------------------------------------------------------------------------
+// Timing
+// ----------------------------------------------------------------------------
+
+static double gltf_stats_now(void) {
+#ifdef _WIN32
+  LARGE_INTEGER freq, t;
+  QueryPerformanceFrequency(&freq);
+  QueryPerformanceCounter(&t);
+  return (double)t.QuadPart / (double)freq.QuadPart;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+void gltf_stats_reset(gltf_load_stats* s) {
+  if (!s) return;
+  gltf_buffer_stats* buffers = s->buffers;
+  const uint32_t buffers_cap = s->buffers_cap;
+  const gltf_load_trace_fn trace = s->trace;
+  void* trace_user = s->trace_user;
+
+  memset(s, 0, sizeof *s);
+  s->buffers = buffers;
+  s->buffers_cap = buffers_cap;
+  s->trace = trace;
+  s->trace_user = trace_user;
+  s->collected = 1u;
+  if (buffers) memset(buffers, 0, (size_t)buffers_cap * sizeof(gltf_buffer_stats));
+}
+
+double gltf_stats_begin(gltf_load_stats* s, gltf_load_stage stage) {
+  if (!s) return 0.0;
+  if (s->trace) s->trace(s->trace_user, stage, 0, 0.0);
+  return gltf_stats_now();
+}
+
+void gltf_stats_end(gltf_load_stats* s, gltf_load_stage stage, double t0) {
+  if (!s) return;
+  const double dt = gltf_stats_now() - t0;
+  s->stage_seconds[stage] += dt;
+  if (s->trace) s->trace(s->trace_user, stage, 1, dt);
+}
+
+double gltf_stats_clock(const gltf_load_stats* s) {
+  return s ? gltf_stats_now() : 0.0;
+}
+
+void gltf_stats_buffer_time(gltf_load_stats* s, uint32_t index, int data_uri, double seconds) {
+  if (!s) return;
+  if (data_uri) {
+    s->data_uri_seconds += seconds;
+  } else {
+    s->buffer_io_seconds += seconds;
+  }
+  if (s->buffers && index < s->buffers_cap) s->buffers[index].seconds += seconds;
+}
+
+// ----------------------------------------------------------------------------
+// Memory
+// ----------------------------------------------------------------------------
+
+void gltf_stats_heap(gltf_load_stats* s, uint64_t bytes) {
+  if (s) s->heap_bytes += bytes;
+}
+
+void gltf_stats_file(gltf_load_stats* s, uint64_t file_bytes, uint64_t heap_bytes) {
+  if (!s) return;
+  s->file_bytes = file_bytes;
+  s->heap_bytes += heap_bytes;
+}
+
+static void* gltf_stats_alc_malloc(void* user, size_t size) {
+  gltf_stats_alc* w = (gltf_stats_alc*)user;
+  void* p = w->inner.malloc(w->inner.ctx, size);
+  if (p) {
+    w->stats->json_alloc_bytes += size;
+    w->stats->json_alloc_count++;
+    w->stats->heap_bytes += size;
+  }
+  return p;
+}
+
+static void* gltf_stats_alc_realloc(void* user, void* ptr, size_t old_size, size_t size) {
+  gltf_stats_alc* w = (gltf_stats_alc*)user;
+  void* p = w->inner.realloc(w->inner.ctx, ptr, old_size, size);
+  if (p) {
+    const uint64_t grown = size > old_size ? (uint64_t)(size - old_size) : 0u;
+    w->stats->json_alloc_bytes += grown;
+    w->stats->json_alloc_count++;
+    w->stats->heap_bytes += grown;
+  }
+  return p;
+}
+
+static void gltf_stats_alc_free(void* user, void* ptr) {
+  gltf_stats_alc* w = (gltf_stats_alc*)user;
+  w->inner.free(w->inner.ctx, ptr);
+}
+
+yyjson_alc gltf_stats_json_alc(gltf_load_stats* s, const yyjson_alc* alc, gltf_stats_alc* w) {
+  if (!s) return *alc;
+  w->inner = *alc;
+  w->stats = s;
+  const yyjson_alc counting = { gltf_stats_alc_malloc, gltf_stats_alc_realloc, gltf_stats_alc_free, w };
+  return counting;
+}
+
+void gltf_stats_block(gltf_load_stats* s, size_t block_bytes) {
+  if (!s) return;
+  s->block_bytes = block_bytes;
+  s->heap_bytes += block_bytes;
+}
+
+// ----------------------------------------------------------------------------
+// Buffers and document usage
+// ----------------------------------------------------------------------------
+
+void gltf_stats_buffers(gltf_load_stats* s,
+                        const gltf_doc* doc,
+                        yyjson_val* root,
+                        const gltf_load_context* ctx) {
+  if (!s || !doc) return;
+  yyjson_val* buffers_val = yyjson_obj_get(root, "buffers");
+  s->buffer_count = doc->buffer_count;
+
+  for (uint32_t i = 0; i < doc->buffer_count; i++) {
+    const gltf_buffer* b = &doc->buffers[i];
+    yyjson_val* uri_val = yyjson_obj_get(yyjson_arr_get(buffers_val, i), "uri");
+    const char* uri = yyjson_get_str(uri_val);
+    gltf_buffer_stats bs = { GLTF_BUFFER_STATS_NONE, 0u, 0u, 0.0 };
+    if (s->buffers && i < s->buffers_cap) bs.seconds = s->buffers[i].seconds;
+
+    if (!b->pending && (b->data || b->byte_length == 0u)) {
+      bs.bytes = b->byte_length;
+      if (!uri) {
+        bs.source = GLTF_BUFFER_STATS_GLB_BIN;
+        bs.source_bytes = ctx->internal_bin_size;
+      } else if (strncmp(uri, "data:", 5) == 0) {
+        bs.source = GLTF_BUFFER_STATS_DATA_URI;
+        bs.source_bytes = yyjson_get_len(uri_val);
+        s->data_uri_bytes += bs.bytes;
+        s->data_uri_text_bytes += bs.source_bytes;
+      } else if (b->storage == GLTF_BUFFER_MAPPED) {
+        bs.source = GLTF_BUFFER_STATS_FILE_MAPPED;
+        bs.source_bytes = bs.bytes;
+        s->buffer_mapped_bytes += bs.bytes;
+      } else {
+        bs.source = GLTF_BUFFER_STATS_FILE_READ;
+        bs.source_bytes = bs.bytes;
+        s->buffer_read_bytes += bs.bytes;
+      }
+      if (b->storage == GLTF_BUFFER_OWNED) s->heap_bytes += bs.bytes;
+    }
+    if (s->buffers && i < s->buffers_cap) s->buffers[i] = bs;
+  }
+}
+
+void gltf_stats_doc(gltf_load_stats* s, const gltf_doc* doc) {
+  if (!s || !doc) return;
+  s->block_used_bytes = s->block_bytes - (uint64_t)(doc->block_end - doc->block_next);
+  s->string_cap_bytes = doc->arena.cap;
+  s->string_used_bytes = doc->arena.size;
+  s->index_cap = doc->indices_cap;
+  s->index_used = doc->indices_count;
+}
+
+#endif // GLTF_ENABLE_STATS
@@ -0,0 +1,239 @@
+// Minimal educational glTF 2.0 loader (C11).
+//
+// Threads and the built-in thread pool.
+//
+// Responsibilities:
+//   - start/join platform threads (pthread / Win32)
+//   - gltf_thread_pool: fixed workers that execute gltf_dispatch_fn jobs
+//
+// Notes:
+//   - One job runs at a time; tasks are claimed with an atomic counter, so the
+//     cost per task is one fetch-add.
+//   - The dispatching thread runs tasks too and then waits for the workers to
+//     leave the job, so no worker can still see a job after dispatch returns.
+//
+// Public API contracts are documented in include/gltf/gltf.h.
+
+
+#include "gltf_internal.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+
+// ----------------------------------------------------------------------------
+// Threads
+// ----------------------------------------------------------------------------
+
+
+typedef struct gltf_thread_start_ctx {
+  gltf_thread_main fn;
+  void* arg;
+} gltf_thread_start_ctx;
+
+#ifdef _WIN32
+
+static DWORD WINAPI gltf_thread_entry(LPVOID p) {
+  gltf_thread_start_ctx ctx = *(gltf_thread_start_ctx*)p;
+  free(p);
+  ctx.fn(ctx.arg);
+  return 0;
+}
+
+#else
+
+static void* gltf_thread_entry(void* p) {
+  gltf_thread_start_ctx ctx = *(gltf_thread_start_ctx*)p;
+  free(p);
+  ctx.fn(ctx.arg);
+  return NULL;
+}
+
+#endif
+
+int gltf_thread_start(gltf_thread* t, gltf_thread_main fn, void* arg) {
+  gltf_thread_start_ctx* ctx = (gltf_thread_start_ctx*)malloc(sizeof(*ctx));
+  if (!ctx) return 0;
+  ctx->fn = fn;
+  ctx->arg = arg;
+#ifdef _WIN32
+  *t = CreateThread(NULL, 0, gltf_thread_entry, ctx, 0, NULL);
+  if (!*t) {
+    free(ctx);
+    return 0;
+  }
+#else
+  if (pthread_create(t, NULL, gltf_thread_entry, ctx) != 0) {
+    free(ctx);
+    return 0;
+  }
+#endif
+  return 1;
+}
+
+void gltf_thread_join(gltf_thread t) {
+#ifdef _WIN32
+  (void)WaitForSingleObject(t, INFINITE);
+  (void)CloseHandle(t);
+#else
+  (void)pthread_join(t, NULL);
+#endif
+}
+
+uint32_t gltf_cpu_count(void) {
+#ifdef _WIN32
+  SYSTEM_INFO si;
+  GetSystemInfo(&si);
+  return si.dwNumberOfProcessors ? (uint32_t)si.dwNumberOfProcessors : 1u;
+#else
+  const long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return n > 0 ? (uint32_t)n : 1u;
+#endif
+}
+
+
+// ----------------------------------------------------------------------------
+// Thread pool
+// ----------------------------------------------------------------------------
+
+
+struct gltf_thread_pool {
+  gltf_thread* threads;
+  uint32_t thread_count;    // threads successfully started
+
+  gltf_mutex dispatch_lock; // serializes gltf_thread_pool_dispatch() callers
+  gltf_mutex lock;          // guards everything below
+  gltf_cond wake;           // workers: a job was posted or shutdown requested
+  gltf_cond idle;           // dispatcher: the last worker left the job
+
+  gltf_task_fn task;
+  void* task_user;
+  uint32_t task_count;
+  volatile uint32_t next_task; // atomic; next task index to claim
+  uint32_t generation;         // bumped for every job
+  uint32_t busy_workers;       // workers that have not finished the job yet
+  int shutdown;
+};
+
+static void pool_run_tasks(gltf_thread_pool* pool) {
+  for (;;) {
+    const uint32_t i = gltf_atomic_fetch_add_u32(&pool->next_task, 1u);
+    if (i >= pool->task_count) break;
+    pool->task(pool->task_user, i);
+  }
+}
+
+static void pool_worker(void* arg) {
+  gltf_thread_pool* pool = (gltf_thread_pool*)arg;
+  uint32_t seen = 0;
+
+  gltf_mutex_lock(&pool->lock);
+  for (;;) {
+    while (!pool->shutdown && pool->generation == seen) gltf_cond_wait(&pool->wake, &pool->lock);
+    if (pool->shutdown) break;
+    seen = pool->generation;
+    gltf_mutex_unlock(&pool->lock);
+
+    pool_run_tasks(pool);
+
+    gltf_mutex_lock(&pool->lock);
+    if (--pool->busy_workers == 0) gltf_cond_broadcast(&pool->idle);
+  }
+  gltf_mutex_unlock(&pool->lock);
+}
+
+gltf_result gltf_thread_pool_create(uint32_t thread_count,
+                                    gltf_thread_pool** out_pool,
+                                    gltf_error* out_err) {
+  if (!out_pool) {
+    gltf_set_err_if(out_err, "invalid args", NULL, 0, 0);
+    return GLTF_ERR_INVALID;
+  }
+  *out_pool = NULL;
+
+  if (thread_count == 0) thread_count = gltf_cpu_count() - 1u;
+
+  gltf_thread_pool* pool = (gltf_thread_pool*)calloc(1, sizeof(*pool));
+  if (!pool) {
+    gltf_set_err_if(out_err, "oom", NULL, 0, 0);
+    return GLTF_ERR_IO;
+  }
+  if (thread_count > 0) {
+    pool->threads = (gltf_thread*)malloc((size_t)thread_count * sizeof(pool->threads[0]));
+    if (!pool->threads) {
+      free(pool);
+      gltf_set_err_if(out_err, "oom", NULL, 0, 0);
+      return GLTF_ERR_IO;
+    }
+  }
+
+  gltf_mutex_init(&pool->dispatch_lock);
+  gltf_mutex_init(&pool->lock);
+  gltf_cond_init(&pool->wake);
+  gltf_cond_init(&pool->idle);
+
+  for (uint32_t i = 0; i < thread_count; i++) {
+    if (!gltf_thread_start(&pool->threads[i], pool_worker, pool)) {
+      gltf_thread_pool_free(pool);
+      gltf_set_err_if(out_err, "failed to start worker thread", NULL, 0, 0);
+      return GLTF_ERR_IO;
+    }
+    pool->thread_count++;
+  }
+
+  *out_pool = pool;
+  return GLTF_OK;
+}
+
+void gltf_thread_pool_free(gltf_thread_pool* pool) {
+  if (!pool) return;
+
+  gltf_mutex_lock(&pool->lock);
+  pool->shutdown = 1;
+  gltf_cond_broadcast(&pool->wake);
+  gltf_mutex_unlock(&pool->lock);
+
+  for (uint32_t i = 0; i < pool->thread_count; i++) gltf_thread_join(pool->threads[i]);
+
+  gltf_cond_destroy(&pool->idle);
+  gltf_cond_destroy(&pool->wake);
+  gltf_mutex_destroy(&pool->lock);
+  gltf_mutex_destroy(&pool->dispatch_lock);
+  free(pool->threads);
+  free(pool);
+}
+
+void gltf_thread_pool_dispatch(void* pool_ptr,
+                               uint32_t task_count,
+                               gltf_task_fn task,
+                               void* task_user) {
+  gltf_thread_pool* pool = (gltf_thread_pool*)pool_ptr;
+  if (!task || task_count == 0) return;
+
+  // Nothing to share: skip the wake-up round trip.
+  if (!pool || pool->thread_count == 0 || task_count == 1) {
+    for (uint32_t i = 0; i < task_count; i++) task(task_user, i);
+    return;
+  }
+
+  gltf_mutex_lock(&pool->dispatch_lock);
+
+  gltf_mutex_lock(&pool->lock);
+  pool->task = task;
+  pool->task_user = task_user;
+  pool->task_count = task_count;
+  pool->next_task = 0;
+  pool->busy_workers = pool->thread_count;
+  pool->generation++;
+  gltf_cond_broadcast(&pool->wake);
+  gltf_mutex_unlock(&pool->lock);
+
+  pool_run_tasks(pool);
+
+  gltf_mutex_lock(&pool->lock);
+  while (pool->busy_workers > 0) gltf_cond_wait(&pool->idle, &pool->lock);
+  gltf_mutex_unlock(&pool->lock);
+
+  gltf_mutex_unlock(&pool->dispatch_lock);
+}
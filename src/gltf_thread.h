@@ -0,0 +1,139 @@
+// Minimal educational glTF 2.0 loader (C11).
+//
+// Internal threading primitives (thread start/join live in gltf_thread.c).
+//
+// Scope:
+//   - a plain mutex (pthread / SRWLOCK)
+//   - a condition variable paired with that mutex
+//   - thread start/join (used by the built-in thread pool in gltf_thread.c)
+//   - acquire/release loads and stores on uint32_t for double-checked
+//     initialization (GCC/Clang __atomic builtins, MSVC Interlocked*)
+//
+// Notes:
+//   - C11 <threads.h>/<stdatomic.h> are not available on every toolchain we
+//     build with (MSVC, older macOS), so the platform APIs are used directly.
+//   - This is an internal header and is not part of the public API.
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+
+// ----------------------------------------------------------------------------
+// Mutex
+// ----------------------------------------------------------------------------
+
+#ifdef _WIN32
+
+typedef SRWLOCK gltf_mutex;
+
+static inline void gltf_mutex_init(gltf_mutex* m) { InitializeSRWLock(m); }
+static inline void gltf_mutex_destroy(gltf_mutex* m) { (void)m; }
+static inline void gltf_mutex_lock(gltf_mutex* m) { AcquireSRWLockExclusive(m); }
+static inline void gltf_mutex_unlock(gltf_mutex* m) { ReleaseSRWLockExclusive(m); }
+
+#else
+
+typedef pthread_mutex_t gltf_mutex;
+
+static inline void gltf_mutex_init(gltf_mutex* m) { (void)pthread_mutex_init(m, NULL); }
+static inline void gltf_mutex_destroy(gltf_mutex* m) { (void)pthread_mutex_destroy(m); }
+static inline void gltf_mutex_lock(gltf_mutex* m) { (void)pthread_mutex_lock(m); }
+static inline void gltf_mutex_unlock(gltf_mutex* m) { (void)pthread_mutex_unlock(m); }
+
+#endif
+
+
+// ----------------------------------------------------------------------------
+// Condition variable
+// ----------------------------------------------------------------------------
+
+#ifdef _WIN32
+
+typedef CONDITION_VARIABLE gltf_cond;
+
+static inline void gltf_cond_init(gltf_cond* c) { InitializeConditionVariable(c); }
+static inline void gltf_cond_destroy(gltf_cond* c) { (void)c; }
+static inline void gltf_cond_wait(gltf_cond* c, gltf_mutex* m) {
+  (void)SleepConditionVariableSRW(c, m, INFINITE, 0);
+}
+static inline void gltf_cond_broadcast(gltf_cond* c) { WakeAllConditionVariable(c); }
+
+#else
+
+typedef pthread_cond_t gltf_cond;
+
+static inline void gltf_cond_init(gltf_cond* c) { (void)pthread_cond_init(c, NULL); }
+static inline void gltf_cond_destroy(gltf_cond* c) { (void)pthread_cond_destroy(c); }
+static inline void gltf_cond_wait(gltf_cond* c, gltf_mutex* m) { (void)pthread_cond_wait(c, m); }
+static inline void gltf_cond_broadcast(gltf_cond* c) { (void)pthread_cond_broadcast(c); }
+
+#endif
+
+
+// ----------------------------------------------------------------------------
+// Threads
+// ----------------------------------------------------------------------------
+
+typedef void (*gltf_thread_main)(void* arg);
+
+#ifdef _WIN32
+typedef HANDLE gltf_thread;
+#else
+typedef pthread_t gltf_thread;
+#endif
+
+// Starts fn(arg) on a new thread. Returns 1 on success.
+int gltf_thread_start(gltf_thread* t, gltf_thread_main fn, void* arg);
+
+// Waits for a thread started by gltf_thread_start() to return.
+void gltf_thread_join(gltf_thread t);
+
+// Number of logical CPUs (at least 1).
+uint32_t gltf_cpu_count(void);
+
+
+// ----------------------------------------------------------------------------
+// Atomics (uint32_t)
+// ----------------------------------------------------------------------------
+
+#if defined(_MSC_VER) && !defined(__clang__)
+
+static inline uint32_t gltf_atomic_load_acquire_u32(const volatile uint32_t* p) {
+  return (uint32_t)InterlockedCompareExchange((volatile LONG*)(uintptr_t)p, 0, 0);
+}
+
+static inline void gltf_atomic_store_release_u32(volatile uint32_t* p, uint32_t v) {
+  (void)InterlockedExchange((volatile LONG*)p, (LONG)v);
+}
+
+// Returns the value before the addition.
+static inline uint32_t gltf_atomic_fetch_add_u32(volatile uint32_t* p, uint32_t v) {
+  return (uint32_t)InterlockedExchangeAdd((volatile LONG*)p, (LONG)v);
+}
+
+#else
+
+static inline uint32_t gltf_atomic_load_acquire_u32(const volatile uint32_t* p) {
+  return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static inline void gltf_atomic_store_release_u32(volatile uint32_t* p, uint32_t v) {
+  __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+
+// Returns the value before the addition.
+static inline uint32_t gltf_atomic_fetch_add_u32(volatile uint32_t* p, uint32_t v) {
+  return __atomic_fetch_add(p, v, __ATOMIC_ACQ_REL);
+}
+
+#endif
@@ -4,6 +4,7 @@
 //
 // Responsibilities:
 //   - compute derived values from accessor spans (e.g. bounds)
+//   - combine mesh bounds with world matrices into per-node world bounds
 //
 // Notes:
 //   - Public API contracts are documented in include/gltf/gltf.h.
@@ -12,36 +13,41 @@
 
 #include "gltf_internal.h"
 
+#include <math.h>
+
 
 // ----------------------------------------------------------------------------
 // Utilities
 // ----------------------------------------------------------------------------
 
-// Computes an AABB for the first three components of each element.
-//
-// Notes:
-//   - Uses gltf_decode_component_to_f32(); integer/normalized accessors are
-//     decoded as floats.
-
+// Applies accessor normalization to one raw component value (as stored in
+// accessor.min/max), matching gltf_decode_component_to_f32().
+static float aabb_normalize_raw(float v, uint32_t component_type, int normalized) {
+  if (!normalized) return v;
+  switch (component_type) {
+  case GLTF_COMP_U8: return v / 255.0f;
+  case GLTF_COMP_I8: return (v / 127.0f < -1.0f) ? -1.0f : v / 127.0f;
+  case GLTF_COMP_U16: return v / 65535.0f;
+  case GLTF_COMP_I16: return (v / 32767.0f < -1.0f) ? -1.0f : v / 32767.0f;
+  default: return v;
+  }
+}
 
-gltf_result gltf_compute_aabb_pos3_f32_span(const gltf_doc* doc,
-                                            uint32_t accessor_index,
-                                            float out_min3[3],
-                                            float out_max3[3],
-                                            gltf_error* out_err) {
+gltf_result gltf_accessor_aabb3(const gltf_doc* doc,
+                                uint32_t accessor_index,
+                                uint32_t flags,
+                                float out_min3[3],
+                                float out_max3[3],
+                                gltf_error* out_err) {
   if (!doc || !out_min3 || !out_max3) {
     gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
     return GLTF_ERR_INVALID;
   }
-  gltf_span span;
-  gltf_result r = gltf_accessor_span(doc, accessor_index, &span, out_err);
-  if (r != GLTF_OK) {
-    return r;
-  }
-  if (!span.ptr && span.count > 0) {
-    gltf_set_err(out_err, "span has no data", "root", 1, 1);
+  if (accessor_index >= doc->accessor_count) {
+    gltf_set_err(out_err, "accessor out of range", "root.accessors[]", 1, 1);
     return GLTF_ERR_PARSE;
   }
+
   const gltf_accessor* a = &doc->accessors[accessor_index];
   uint32_t comp_count = 0;
   if (!gltf_accessor_component_count(a->type, &comp_count)) {
@@ -52,44 +58,197 @@ gltf_result gltf_compute_aabb_pos3_f32_span(const gltf_doc* doc,
     gltf_set_err(out_err, "accessor has less than 3 components", "root.accessors[].type", 1, 1);
     return GLTF_ERR_PARSE;
   }
-  uint32_t comp_size = 0;
-  if (!gltf_component_size_bytes(a->component_type, &comp_size)) {
-    gltf_set_err(out_err, "invalid componentType", "root.accessors[].componentType", 1, 1);
+
+  // Short-circuit: accessor.min/max describe the data without touching it.
+  if ((flags & GLTF_AABB_USE_ACCESSOR_BOUNDS) && a->has_bounds) {
+    for (uint32_t c = 0; c < 3; c++) {
+      out_min3[c] = aabb_normalize_raw(a->min[c], a->component_type, a->normalized);
+      out_max3[c] = aabb_normalize_raw(a->max[c], a->component_type, a->normalized);
+    }
+    return GLTF_OK;
+  }
+
+  gltf_span span;
+  gltf_result r = gltf_accessor_span(doc, accessor_index, &span, out_err);
+  if (r != GLTF_OK) {
+    return r;
+  }
+  if (span.count == 0) {
+    gltf_set_err(out_err, "accessor has no elements", "root.accessors[].count", 1, 1);
     return GLTF_ERR_PARSE;
   }
-  // Initialize bounds from element 0.
-  {
-    const uint8_t* p = span.ptr;
+  if (!span.ptr) {
+    gltf_set_err(out_err, "span has no data", "root", 1, 1);
+    return GLTF_ERR_PARSE;
+  }
+
+  float lo[3], hi[3];
+  r = gltf_decode_minmax3_f32(span.ptr,
+                              (size_t)span.stride,
+                              (size_t)span.count,
+                              a->component_type,
+                              a->normalized ? 1 : 0,
+                              lo,
+                              hi);
+  if (r != GLTF_OK) {
+    gltf_set_err(out_err, "unsupported componentType for bounds", "root.accessors[].componentType", 1, 1);
+    return r;
+  }
+  memcpy(out_min3, lo, sizeof lo);
+  memcpy(out_max3, hi, sizeof hi);
+  return GLTF_OK;
+}
+
+gltf_result gltf_compute_aabb_pos3_f32_span(const gltf_doc* doc,
+                                            uint32_t accessor_index,
+                                            float out_min3[3],
+                                            float out_max3[3],
+                                            gltf_error* out_err) {
+  return gltf_accessor_aabb3(doc, accessor_index, GLTF_AABB_DEFAULT, out_min3, out_max3, out_err);
+}
+
+gltf_result gltf_mesh_aabb(const gltf_doc* doc,
+                           uint32_t mesh_index,
+                           uint32_t flags,
+                           float out_min3[3],
+                           float out_max3[3],
+                           gltf_error* out_err) {
+  if (!doc || !out_min3 || !out_max3) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+  if (mesh_index >= doc->mesh_count) {
+    gltf_set_err(out_err, "mesh out of range", "root.meshes[]", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+
+  const gltf_mesh* mesh = &doc->meshes[mesh_index];
+  float lo[3] = { INFINITY, INFINITY, INFINITY };
+  float hi[3] = { -INFINITY, -INFINITY, -INFINITY };
+  int any = 0;
+
+  for (uint32_t i = 0; i < mesh->primitive_count; i++) {
+    const uint32_t prim = mesh->primitive_first + i;
+    uint32_t pos_accessor = 0;
+    if (!gltf_doc_primitive_find_attribute(doc, prim, GLTF_ATTR_POSITION, 0, &pos_accessor)) {
+      continue;
+    }
+
+    float pmin[3], pmax[3];
+    gltf_result r = gltf_accessor_aabb3(doc, pos_accessor, flags, pmin, pmax, out_err);
+    if (r != GLTF_OK) return r;
+
     for (uint32_t c = 0; c < 3; c++) {
-      float v = 0.0f;
-      r = gltf_decode_component_to_f32(p + (size_t)c * (size_t)comp_size,
-                                       a->component_type,
-                                       a->normalized ? 1 : 0,
-                                       &v);
-      if (r != GLTF_OK) {
-        gltf_set_err(out_err, "failed to decode component", "root.accessors[]", 1, 1);
-        return r;
-      }
-      out_min3[c] = v;
-      out_max3[c] = v;
+      if (pmin[c] < lo[c]) lo[c] = pmin[c];
+      if (pmax[c] > hi[c]) hi[c] = pmax[c];
     }
+    any = 1;
   }
-  // Process remaining elements.
-  for (uint32_t i = 1; i < span.count; i++) {
-    const uint8_t* p = span.ptr + (size_t)i * (size_t)span.stride;
-    for (uint32_t c = 0; c < 3; c++) {
-      float v = 0.0f;
-      r = gltf_decode_component_to_f32(p + (size_t)c * (size_t)comp_size,
-                                       a->component_type,
-                                       a->normalized ? 1 : 0,
-                                       &v);
-      if (r != GLTF_OK) {
-        gltf_set_err(out_err, "failed to decode component", "root.accessors[]", 1, 1);
-        return r;
+
+  if (!any) {
+    gltf_set_err(out_err,
+                 "mesh has no POSITION attribute",
+                 "root.meshes[].primitives[].attributes.POSITION",
+                 1,
+                 1);
+    return GLTF_ERR_PARSE;
+  }
+  memcpy(out_min3, lo, sizeof lo);
+  memcpy(out_max3, hi, sizeof hi);
+  return GLTF_OK;
+}
+
+// Transforms an AABB by an affine column-major matrix (Arvo's method): each
+// output axis is the translation plus, per input axis, the smaller/larger of
+// the two scaled extents.
+static void aabb_transform(const float m[16],
+                           const float in_min3[3],
+                           const float in_max3[3],
+                           float out_min3[3],
+                           float out_max3[3]) {
+  for (uint32_t row = 0; row < 3; row++) {
+    float lo = m[12 + row];
+    float hi = m[12 + row];
+    for (uint32_t col = 0; col < 3; col++) {
+      const float e = m[col * 4 + row];
+      const float a = e * in_min3[col];
+      const float b = e * in_max3[col];
+      lo += (a < b) ? a : b;
+      hi += (a < b) ? b : a;
+    }
+    out_min3[row] = lo;
+    out_max3[row] = hi;
+  }
+}
+
+static int mesh_has_position(const gltf_doc* doc, uint32_t mesh_index) {
+  const gltf_mesh* mesh = &doc->meshes[mesh_index];
+  for (uint32_t i = 0; i < mesh->primitive_count; i++) {
+    uint32_t acc = 0;
+    if (gltf_doc_primitive_find_attribute(doc, mesh->primitive_first + i, GLTF_ATTR_POSITION, 0, &acc)) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+gltf_result gltf_compute_node_world_aabbs(const gltf_doc* doc,
+                                          const gltf_world_cache* cache,
+                                          uint32_t flags,
+                                          float* out_min3,
+                                          float* out_max3,
+                                          uint8_t* out_has_bounds,
+                                          gltf_error* out_err) {
+  if (!doc || !cache || (doc->node_count > 0 && (!out_min3 || !out_max3))) {
+    gltf_set_err(out_err, "invalid arguments", "root", 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+
+  // Mesh-space boxes are computed once per mesh, on first use.
+  uint8_t* mesh_state = NULL; // 0 = not computed, 1 = valid, 2 = no POSITION
+  float* mesh_box = NULL;     // mesh_count * 6 floats (min xyz, max xyz)
+  if (doc->mesh_count > 0) {
+    mesh_state = (uint8_t*)calloc(doc->mesh_count, sizeof(*mesh_state));
+    mesh_box = (float*)malloc((size_t)doc->mesh_count * 6u * sizeof(*mesh_box));
+    if (!mesh_state || !mesh_box) {
+      free(mesh_state);
+      free(mesh_box);
+      gltf_set_err(out_err, "out of memory", "root", 1, 1);
+      return GLTF_ERR_IO;
+    }
+  }
+
+  gltf_result r = GLTF_OK;
+  for (uint32_t n = 0; n < doc->node_count; n++) {
+    float* dmin = &out_min3[(size_t)n * 3u];
+    float* dmax = &out_max3[(size_t)n * 3u];
+    dmin[0] = dmin[1] = dmin[2] = INFINITY;
+    dmax[0] = dmax[1] = dmax[2] = -INFINITY;
+    if (out_has_bounds) out_has_bounds[n] = 0;
+
+    const int32_t mesh = doc->nodes[n].mesh;
+    if (mesh < 0 || (uint32_t)mesh >= doc->mesh_count) continue;
+
+    float world[16];
+    if (!gltf_world_matrix(doc, cache, n, world)) continue;  // not in this scene
+
+    float* box = &mesh_box[(size_t)mesh * 6u];
+    if (mesh_state[mesh] == 0) {
+      if (!mesh_has_position(doc, (uint32_t)mesh)) {
+        mesh_state[mesh] = 2u;
+        continue;
       }
-      if (v < out_min3[c]) out_min3[c] = v;
-      if (v > out_max3[c]) out_max3[c] = v;
+      r = gltf_mesh_aabb(doc, (uint32_t)mesh, flags, &box[0], &box[3], out_err);
+      if (r != GLTF_OK) break;
+      mesh_state[mesh] = 1u;
     }
+    if (mesh_state[mesh] != 1u) continue;
+
+    aabb_transform(world, &box[0], &box[3], dmin, dmax);
+    if (out_has_bounds) out_has_bounds[n] = 1;
   }
-  return GLTF_OK;
+
+  free(mesh_state);
+  free(mesh_box);
+  return r;
 }
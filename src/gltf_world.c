@@ -8,11 +8,20 @@
 //   - expose helper APIs:
 //       * gltf_node_local_matrix()  (TRS/matrix -> mat4)
 //       * gltf_world_matrix()       (read computed world mat4)
+//   - hold per-cache local overrides and recompute only dirty subtrees
+//   - optional SoA TRS layout with 4-wide local matrix composition
+//   - optional parallel evaluation, one depth level at a time
 //
 // Notes:
 //   - World matrices are computed only for nodes reachable from scene roots.
-//   - A node can exist in doc->nodes[] but remain UNVISITED for a scene.
+//   - A node can exist in doc->nodes[] but remain unreachable for a scene.
+//   - World matrices are stored per node and shared by all scenes; each scene
+//     keeps its own flattened order and a valid flag.
+//   - The scene hierarchy is flattened once per scene into a parent-before-child
+//     order (breadth-first, grouped by depth); evaluation is then a linear loop.
 //   - Matrix convention is column-major: m[col*4 + row] (OpenGL/glTF).
+//   - SoA caches compose every local matrix in a separate pass (four nodes per
+//     step), then walk the depth levels with a 4-wide matrix multiply.
 //
 // Public API contracts are documented in include/gltf/gltf.h.
 
@@ -26,13 +35,28 @@
 // ----------------------------------------------------------------------------
 
 
+static gltf_result overrides_reserve(gltf_world_cache* cache, gltf_error* out_err);
+static void soa_load_doc_trs(const gltf_doc* doc, gltf_world_cache* cache, uint32_t node);
+
 gltf_result gltf_world_cache_create(const gltf_doc* doc,
                                     gltf_world_cache** out_cache,
                                     gltf_error* out_err) {
+  return gltf_world_cache_create_ex(doc, GLTF_WORLD_CACHE_DEFAULT, out_cache, out_err);
+}
+
+gltf_result gltf_world_cache_create_ex(const gltf_doc* doc,
+                                       uint32_t flags,
+                                       gltf_world_cache** out_cache,
+                                       gltf_error* out_err) {
+  if (out_cache) *out_cache = NULL;
   if (!doc || !out_cache) {
     gltf_set_err_if(out_err, "invalid args", NULL, 0, 0);
     return GLTF_ERR_INVALID;
   }
+  if (flags & ~(uint32_t)GLTF_WORLD_CACHE_SOA) {
+    gltf_set_err_if(out_err, "unknown world cache flags", NULL, 0, 0);
+    return GLTF_ERR_INVALID;
+  }
 
   gltf_world_cache* cache = (gltf_world_cache*)calloc(1, sizeof(*cache));
   if (!cache) {
@@ -40,28 +64,42 @@ gltf_result gltf_world_cache_create(const gltf_doc* doc,
     return GLTF_ERR_IO;
   }
 
+  const size_t n = doc->node_count ? (size_t)doc->node_count : 1u;
   cache->node_count = doc->node_count;
+  cache->flags = flags;
   cache->scene_index = UINT32_MAX;
-  cache->valid = 0;
-
-  cache->state = (uint8_t*)malloc((size_t)doc->node_count *
-                                  sizeof(cache->state[0]));
-  if (!cache->state) {
-    free(cache);
+  cache->scene_count = doc->scene_count;
+  cache->gen = 1;
+
+  // Per-node state is sized here, once; scene orders are allocated on first use.
+  cache->world_m16 = (float*)malloc(n * 16u * sizeof(cache->world_m16[0]));
+  cache->world_parent = (uint32_t*)malloc(n * sizeof(cache->world_parent[0]));
+  cache->world_gen = (uint32_t*)calloc(n, sizeof(cache->world_gen[0]));
+  cache->stamp = (uint32_t*)calloc(n, sizeof(cache->stamp[0]));
+  cache->stack = (uint32_t*)malloc(n * sizeof(cache->stack[0]));
+  cache->scenes = (gltf_world_scene*)calloc(doc->scene_count ? doc->scene_count : 1u,
+                                            sizeof(cache->scenes[0]));
+  if (!cache->world_m16 || !cache->world_parent || !cache->world_gen || !cache->stamp ||
+      !cache->stack || !cache->scenes) {
+    gltf_world_cache_free(cache);
     gltf_set_err_if(out_err, "oom", NULL, 0, 0);
     return GLTF_ERR_IO;
   }
 
-  cache->world_m16 = (float*)malloc((size_t)doc->node_count * 16u *
-                                    sizeof(cache->world_m16[0]));
-  if (!cache->world_m16) {
-    free(cache->state);
-    free(cache);
-    gltf_set_err_if(out_err, "oom", NULL, 0, 0);
-    return GLTF_ERR_IO;
+  if (flags & GLTF_WORLD_CACHE_SOA) {
+    // Padding lanes hold identity TRS so full 4-wide blocks are always valid.
+    const uint32_t stride = (doc->node_count + 3u) & ~3u;
+    cache->soa_stride = stride;
+    cache->soa_trs = (float*)malloc(((size_t)stride ? stride : 4u) * 10u * sizeof(float));
+    cache->soa_local_m16 = (float*)malloc(((size_t)stride ? stride : 4u) * 16u * sizeof(float));
+    if (!cache->soa_trs || !cache->soa_local_m16 || overrides_reserve(cache, out_err) != GLTF_OK) {
+      gltf_world_cache_free(cache);
+      gltf_set_err_if(out_err, "oom", NULL, 0, 0);
+      return GLTF_ERR_IO;
+    }
+    for (uint32_t i = 0; i < stride; i++) soa_load_doc_trs(doc, cache, i);
   }
 
-  memset(cache->state, 0, (size_t)doc->node_count * sizeof(cache->state[0]));
   *out_cache = cache;
 
   return GLTF_OK;
@@ -69,8 +107,25 @@ gltf_result gltf_world_cache_create(const gltf_doc* doc,
 
 void gltf_world_cache_free(gltf_world_cache* cache) {
   if (!cache) return;
+  if (cache->scenes) {
+    for (uint32_t i = 0; i < cache->scene_count; i++) {
+      free(cache->scenes[i].order);
+      free(cache->scenes[i].parent);
+      free(cache->scenes[i].order_pos);
+      free(cache->scenes[i].level_first);
+    }
+  }
+  free(cache->scenes);
   free(cache->world_m16);
-  free(cache->state);
+  free(cache->world_parent);
+  free(cache->world_gen);
+  free(cache->stamp);
+  free(cache->stack);
+  free(cache->local_m16);
+  free(cache->local_flags);
+  free(cache->dirty);
+  free(cache->soa_trs);
+  free(cache->soa_local_m16);
   free(cache);
 }
 
@@ -89,6 +144,92 @@ static inline const float* world_ptr_ro(const gltf_world_cache* c,
   return &c->world_m16[(size_t)node * 16u];
 }
 
+// Scene gltf_world_matrix() answers for, or NULL.
+static inline const gltf_world_scene* current_scene(const gltf_world_cache* c) {
+  return c->scene_index < c->scene_count ? &c->scenes[c->scene_index] : NULL;
+}
+
+// Starts a new evaluation pass: stamp[node] == epoch marks nodes recomputed by it.
+static uint32_t next_epoch(gltf_world_cache* c) {
+  if (++c->epoch == 0) {
+    memset(c->stamp, 0, (size_t)c->node_count * sizeof(c->stamp[0]));
+    c->epoch = 1;
+  }
+  return c->epoch;
+}
+
+// Makes every stored matrix stale and every scene invalid.
+static void next_gen(gltf_world_cache* c) {
+  if (++c->gen == 0) {
+    memset(c->world_gen, 0, (size_t)c->node_count * sizeof(c->world_gen[0]));
+    c->gen = 1;
+  }
+  for (uint32_t i = 0; i < c->scene_count; i++) c->scenes[i].valid = 0;
+}
+
+
+// ----------------------------------------------------------------------------
+// SoA TRS storage (GLTF_WORLD_CACHE_SOA)
+// ----------------------------------------------------------------------------
+
+
+enum {
+  SOA_TX = 0, SOA_TY, SOA_TZ,
+  SOA_RX, SOA_RY, SOA_RZ, SOA_RW,
+  SOA_SX, SOA_SY, SOA_SZ,
+  SOA_STREAMS
+};
+
+static inline float* soa_stream(gltf_world_cache* c, uint32_t k) {
+  return &c->soa_trs[(size_t)k * c->soa_stride];
+}
+
+static void soa_store_trs(gltf_world_cache* c,
+                          uint32_t node,
+                          const float t[3],
+                          const float r[4],
+                          const float s[3]) {
+  for (uint32_t i = 0; i < 3u; i++) soa_stream(c, SOA_TX + i)[node] = t[i];
+  for (uint32_t i = 0; i < 4u; i++) soa_stream(c, SOA_RX + i)[node] = r[i];
+  for (uint32_t i = 0; i < 3u; i++) soa_stream(c, SOA_SX + i)[node] = s[i];
+}
+
+// Document TRS for node (identity for padding lanes past node_count).
+static void soa_load_doc_trs(const gltf_doc* doc, gltf_world_cache* cache, uint32_t node) {
+  static const float k_t[3] = { 0.f, 0.f, 0.f };
+  static const float k_r[4] = { 0.f, 0.f, 0.f, 1.f };
+  static const float k_s[3] = { 1.f, 1.f, 1.f };
+  if (node < doc->node_count) {
+    const gltf_node* n = &doc->nodes[node];
+    soa_store_trs(cache, node, n->translation, n->rotation, n->scale);
+  } else {
+    soa_store_trs(cache, node, k_t, k_r, k_s);
+  }
+}
+
+// Scalar T * R * S from the SoA streams (used for single-node updates).
+static void soa_local_matrix(const gltf_world_cache* cache, uint32_t node, float out_m16[16]) {
+  const size_t st = cache->soa_stride;
+  const float* p = cache->soa_trs + node;
+  const float t[3] = { p[SOA_TX * st], p[SOA_TY * st], p[SOA_TZ * st] };
+  const float r[4] = { p[SOA_RX * st], p[SOA_RY * st], p[SOA_RZ * st], p[SOA_RW * st] };
+  const float s[3] = { p[SOA_SX * st], p[SOA_SY * st], p[SOA_SZ * st] };
+  mat4_from_quat(out_m16, r);
+  mat4_apply_scale(out_m16, s);
+  mat4_apply_translation(out_m16, t);
+}
+
+// Composes soa_local_m16 for nodes [4 * block_first, 4 * block_end), four per step.
+static void soa_compose_locals(gltf_world_cache* cache, uint32_t block_first, uint32_t block_end) {
+  for (uint32_t b = block_first * 4u; b < block_end * 4u; b += 4u) {
+    gltf_f32x4 t[3], q[4], s[3];
+    for (uint32_t i = 0; i < 3u; i++) t[i] = gltf_f32x4_load(soa_stream(cache, SOA_TX + i) + b);
+    for (uint32_t i = 0; i < 4u; i++) q[i] = gltf_f32x4_load(soa_stream(cache, SOA_RX + i) + b);
+    for (uint32_t i = 0; i < 3u; i++) s[i] = gltf_f32x4_load(soa_stream(cache, SOA_SX + i) + b);
+    mat4_compose_trs_x4(t, q, s, &cache->soa_local_m16[(size_t)b * 16u]);
+  }
+}
+
 
 // ----------------------------------------------------------------------------
 // Public helpers: world matrix getter + local matrix builder
@@ -102,12 +243,11 @@ int gltf_world_matrix(const gltf_doc* doc,
   if (!doc || !cache || !out_m16) return 0;
   if (node_index >= doc->node_count) return 0;
   if (cache->node_count != doc->node_count) return 0;
-  if (!cache->valid) return 0;
-  if (!cache->state || !cache->world_m16) return 0;
+  const gltf_world_scene* sc = current_scene(cache);
+  if (!sc || !sc->valid) return 0;
 
   // Return only if the node was actually computed for this scene.
-  // DONE == 2 by convention.
-  if (cache->state[node_index] != 2u) return 0;
+  if (sc->order_pos[node_index] == UINT32_MAX) return 0;
 
   const float* src = world_ptr_ro(cache, node_index);
   memcpy(out_m16, src, 16u * sizeof(float));
@@ -144,133 +284,430 @@ int gltf_node_local_matrix(const gltf_doc* doc,
 
 
 // ----------------------------------------------------------------------------
-// DFS (iterative) evaluation
+// Local overrides
 // ----------------------------------------------------------------------------
 
 
-typedef struct gltf_dfs_frame {
-  uint32_t node;     // current node being processed
-  uint32_t parent;   // parent node index, or UINT32_MAX if root
-  uint32_t child_i;  // next child index to process (0..children.count)
-} gltf_dfs_frame;
+// Local matrix used for evaluation: the cache override if any, else the document's.
+// SoA caches keep TRS (document or overridden) in soa_trs; a document matrix
+// still wins over the document TRS.
+static inline void cache_local_matrix(const gltf_doc* doc,
+                                      const gltf_world_cache* cache,
+                                      uint32_t node,
+                                      float out_m16[16]) {
+  const uint8_t lf = cache->local_flags ? cache->local_flags[node] : 0u;
+  if (lf & GLTF_WORLD_LOCAL_OVERRIDE) {
+    memcpy(out_m16, &cache->local_m16[(size_t)node * 16u], 16u * sizeof(float));
+    return;
+  }
+  if (cache->soa_trs && ((lf & GLTF_WORLD_LOCAL_TRS) || !doc->nodes[node].has_matrix)) {
+    soa_local_matrix(cache, node, out_m16);
+    return;
+  }
+  (void)gltf_node_local_matrix(doc, node, out_m16);
+}
 
-static inline void stack_push(gltf_dfs_frame* stack,
-                              uint32_t* top,
-                              gltf_dfs_frame f) {
-  stack[(*top)++] = f;
+// Same as cache_local_matrix(), but points at soa_local_m16 (composed by
+// soa_compose_locals()) instead of copying when possible.
+static inline const float* soa_cache_local_ptr(const gltf_doc* doc,
+                                               const gltf_world_cache* cache,
+                                               uint32_t node) {
+  const uint8_t lf = cache->local_flags[node];
+  if (lf & GLTF_WORLD_LOCAL_OVERRIDE) return &cache->local_m16[(size_t)node * 16u];
+  if (!(lf & GLTF_WORLD_LOCAL_TRS) && doc->nodes[node].has_matrix) return doc->nodes[node].matrix;
+  return &cache->soa_local_m16[(size_t)node * 16u];
 }
 
-static inline gltf_dfs_frame* stack_peek(gltf_dfs_frame* stack,
-                                         uint32_t top) {
-  return &stack[top - 1];
+// Allocates the override/dirty-tracking arrays on first use.
+static gltf_result overrides_reserve(gltf_world_cache* cache, gltf_error* out_err) {
+  if (cache->local_flags) return GLTF_OK;
+
+  const size_t n = cache->node_count ? (size_t)cache->node_count : 1u;
+  cache->local_m16 = (float*)malloc(n * 16u * sizeof(float));
+  cache->local_flags = (uint8_t*)calloc(n, sizeof(uint8_t));
+  cache->dirty = (uint32_t*)malloc(n * sizeof(uint32_t));
+  if (!cache->local_m16 || !cache->local_flags || !cache->dirty) {
+    free(cache->local_m16);
+    free(cache->local_flags);
+    free(cache->dirty);
+    cache->local_m16 = NULL;
+    cache->local_flags = NULL;
+    cache->dirty = NULL;
+    gltf_set_err_if(out_err, "oom", NULL, 0, 0);
+    return GLTF_ERR_IO;
+  }
+  cache->dirty_count = 0;
+  return GLTF_OK;
 }
 
-static inline void stack_pop(uint32_t* top) {
-  (*top)--;
+static void mark_dirty(gltf_world_cache* cache, uint32_t node) {
+  if (cache->local_flags[node] & GLTF_WORLD_LOCAL_DIRTY) return;
+  cache->local_flags[node] |= GLTF_WORLD_LOCAL_DIRTY;
+  cache->dirty[cache->dirty_count++] = node;
 }
 
-// Evaluate one node: compute world = parent_world * local(node).
-//
-// State machine:
-//   - UNVISITED (0) -> VISITING (1) when world matrix is written
-//   - VISITING (1)  indicates a cycle if seen again while on stack
-//   - DONE (2)      is set when all children are processed (dfs_step exit)
-static gltf_result eval_one_node(const gltf_doc* doc,
-                                 gltf_world_cache* cache,
-                                 uint32_t node,
-                                 const float parent_world[16],
-                                 gltf_error* out_err) {
-  if (!doc || !cache || !parent_world) {
-    gltf_set_err_if(out_err, "invalid arguments", NULL, 1, 1);
+static gltf_result override_begin(const gltf_doc* doc,
+                                  gltf_world_cache* cache,
+                                  uint32_t node_index,
+                                  gltf_error* out_err) {
+  if (!doc || !cache) {
+    gltf_set_err_if(out_err, "invalid args", NULL, 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+  if (cache->node_count != doc->node_count) {
+    gltf_set_err_if(out_err, "cache/doc node_count mismatch", NULL, 0, 0);
     return GLTF_ERR_INVALID;
   }
-  if (node >= doc->node_count) {
+  if (node_index >= doc->node_count) {
     gltf_set_err_if(out_err, "node index out of range", NULL, 1, 1);
     return GLTF_ERR_INVALID;
   }
-  
-  const uint8_t node_state = cache->state[node];
+  return overrides_reserve(cache, out_err);
+}
 
-  if (node_state == 2u) return GLTF_OK; // DONE
-  if (node_state == 1u) {               // VISITING -> cycle
-    gltf_set_err_if(out_err, "cycle in node graph", NULL, 1, 1);
+gltf_result gltf_world_cache_set_local_trs(const gltf_doc* doc,
+                                           gltf_world_cache* cache,
+                                           uint32_t node_index,
+                                           const float translation[3],
+                                           const float rotation[4],
+                                           const float scale[3],
+                                           gltf_error* out_err) {
+  gltf_result r = override_begin(doc, cache, node_index, out_err);
+  if (r != GLTF_OK) return r;
+
+  const gltf_node* n = &doc->nodes[node_index];
+  const float* t = translation ? translation : n->translation;
+  const float* q = rotation ? rotation : n->rotation;
+  const float* s = scale ? scale : n->scale;
+
+  if (cache->soa_trs) {
+    // SoA caches keep TRS overrides in the streams; a matrix override is dropped.
+    soa_store_trs(cache, node_index, t, q, s);
+    cache->local_flags[node_index] &= (uint8_t)~GLTF_WORLD_LOCAL_OVERRIDE;
+    cache->local_flags[node_index] |= GLTF_WORLD_LOCAL_TRS;
+  } else {
+    float* m = &cache->local_m16[(size_t)node_index * 16u];
+    mat4_from_quat(m, q);
+    mat4_apply_scale(m, s);
+    mat4_apply_translation(m, t);
+    cache->local_flags[node_index] |= GLTF_WORLD_LOCAL_OVERRIDE;
+  }
+  mark_dirty(cache, node_index);
+  return GLTF_OK;
+}
+
+gltf_result gltf_world_cache_set_local_matrix(const gltf_doc* doc,
+                                              gltf_world_cache* cache,
+                                              uint32_t node_index,
+                                              const float m16[16],
+                                              gltf_error* out_err) {
+  if (!m16) {
+    gltf_set_err_if(out_err, "invalid args", NULL, 1, 1);
     return GLTF_ERR_INVALID;
   }
+  gltf_result r = override_begin(doc, cache, node_index, out_err);
+  if (r != GLTF_OK) return r;
 
-  // UNVISITED -> VISITING (world becomes available for children).
-  cache->state[node] = 1u;
+  memcpy(&cache->local_m16[(size_t)node_index * 16u], m16, 16u * sizeof(float));
+  cache->local_flags[node_index] |= GLTF_WORLD_LOCAL_OVERRIDE;
+  mark_dirty(cache, node_index);
+  return GLTF_OK;
+}
 
-  float local[16];
-  if (!gltf_node_local_matrix(doc, node, local)) {
-    gltf_set_err_if(out_err, "failed to compute local matrix", NULL, 1, 1);
-    return GLTF_ERR_INVALID;
+gltf_result gltf_world_cache_clear_local(const gltf_doc* doc,
+                                         gltf_world_cache* cache,
+                                         uint32_t node_index,
+                                         gltf_error* out_err) {
+  gltf_result r = override_begin(doc, cache, node_index, out_err);
+  if (r != GLTF_OK) return r;
+
+  const uint8_t mask = GLTF_WORLD_LOCAL_OVERRIDE | GLTF_WORLD_LOCAL_TRS;
+  if (cache->local_flags[node_index] & mask) {
+    if (cache->local_flags[node_index] & GLTF_WORLD_LOCAL_TRS) {
+      soa_load_doc_trs(doc, cache, node_index);
+    }
+    cache->local_flags[node_index] &= (uint8_t)~mask;
+    mark_dirty(cache, node_index);
   }
+  return GLTF_OK;
+}
 
-  float* out_world = world_ptr(cache, node);
-  mat4_mul(parent_world, local, out_world);
 
+// ----------------------------------------------------------------------------
+// Scene flattening (built once per scene)
+// ----------------------------------------------------------------------------
+
+
+static void order_reset(gltf_world_scene* sc) {
+  for (uint32_t i = 0; i < sc->order_count; i++) {
+    sc->order_pos[sc->order[i]] = UINT32_MAX;
+  }
+  sc->order_count = 0;
+  sc->level_count = 0;
+  sc->built = 0;
+  sc->valid = 0;
+}
+
+static void order_append(gltf_world_scene* sc, uint32_t node, uint32_t parent) {
+  sc->order_pos[node] = sc->order_count;
+  sc->parent[node] = parent;
+  sc->order[sc->order_count++] = node;
+}
+
+static gltf_result scene_reserve(gltf_world_cache* cache, gltf_world_scene* sc, gltf_error* out_err) {
+  if (sc->order) return GLTF_OK;
+
+  const size_t n = cache->node_count ? (size_t)cache->node_count : 1u;
+  sc->order = (uint32_t*)malloc(n * sizeof(sc->order[0]));
+  sc->parent = (uint32_t*)malloc(n * sizeof(sc->parent[0]));
+  sc->order_pos = (uint32_t*)malloc(n * sizeof(sc->order_pos[0]));
+  sc->level_first = (uint32_t*)malloc(((size_t)cache->node_count + 1u) * sizeof(sc->level_first[0]));
+  if (!sc->order || !sc->parent || !sc->order_pos || !sc->level_first) {
+    free(sc->order);
+    free(sc->parent);
+    free(sc->order_pos);
+    free(sc->level_first);
+    memset(sc, 0, sizeof(*sc));
+    gltf_set_err_if(out_err, "oom", NULL, 0, 0);
+    return GLTF_ERR_IO;
+  }
+  for (size_t i = 0; i < cache->node_count; i++) sc->order_pos[i] = UINT32_MAX;
   return GLTF_OK;
 }
 
-// One iterative DFS step on the explicit stack.
+// Returns 1 if the child edges between the nodes in sc->order contain a cycle
+// (Kahn's algorithm: nodes left with a parent after peeling are on one), -1
+// when out of memory. Child ranges were validated by build_order().
+static int order_has_cycle(const gltf_doc* doc, const gltf_world_scene* sc) {
+  const uint32_t n = sc->order_count;
+  uint32_t* indeg = (uint32_t*)calloc(n ? n : 1u, sizeof(uint32_t));
+  uint32_t* queue = (uint32_t*)malloc((n ? n : 1u) * sizeof(uint32_t));
+  if (!indeg || !queue) {
+    free(indeg);
+    free(queue);
+    return -1;
+  }
+
+  for (uint32_t k = 0; k < n; k++) {
+    const gltf_range_u32 cr = doc->nodes[sc->order[k]].children;
+    for (uint32_t c = 0; c < cr.count; c++) indeg[sc->order_pos[doc->indices_u32[cr.first + c]]]++;
+  }
+  uint32_t tail = 0;
+  for (uint32_t k = 0; k < n; k++) {
+    if (indeg[k] == 0u) queue[tail++] = k;
+  }
+  for (uint32_t head = 0; head < tail; head++) {
+    const gltf_range_u32 cr = doc->nodes[sc->order[queue[head]]].children;
+    for (uint32_t c = 0; c < cr.count; c++) {
+      const uint32_t pos = sc->order_pos[doc->indices_u32[cr.first + c]];
+      if (--indeg[pos] == 0u) queue[tail++] = pos;
+    }
+  }
+
+  free(indeg);
+  free(queue);
+  return tail != n;
+}
+
+// Breadth-first flattening of the scene: roots first, then each depth level.
 //
-// Behavior:
-//   - If frame.node is UNVISITED: compute its world matrix (VISITING).
-//   - Then iterate its children one by one by pushing new frames.
-//   - When all children processed: mark DONE and pop the frame.
-static gltf_result dfs_step(const gltf_doc* doc,
-                            gltf_world_cache* cache,
-                            gltf_dfs_frame* stack,
-                            uint32_t* top,
-                            const float identity[16],
-                            gltf_error* out_err) {
-  if (!doc || !cache || !stack || !top || !identity) {
-    gltf_set_err_if(out_err, "invalid arguments", NULL, 1, 1);
+// A node reachable more than once is evaluated under its first parent. Such
+// graphs are then checked for a cycle, which fails the build.
+static gltf_result build_order(const gltf_doc* doc,
+                               gltf_world_cache* cache,
+                               uint32_t scene_index,
+                               gltf_error* out_err) {
+  gltf_world_scene* sc = &cache->scenes[scene_index];
+  gltf_result r = scene_reserve(cache, sc, out_err);
+  if (r != GLTF_OK) return r;
+  order_reset(sc);
+
+  const gltf_scene* scene = &doc->scenes[scene_index];
+  const uint32_t root_first = scene->nodes.first;
+  const uint32_t root_count = scene->nodes.count;
+
+  if (root_first > doc->indices_count ||
+      root_count > doc->indices_count - root_first) {
+    gltf_set_err_if(out_err, "scene.nodes out of bounds", NULL, 1, 1);
     return GLTF_ERR_INVALID;
   }
-  if (*top == 0) {
-    gltf_set_err_if(out_err, "empty stack", NULL, 1, 1);
-    return GLTF_ERR_INVALID;
+
+  for (uint32_t i = 0; i < root_count; i++) {
+    const uint32_t node = doc->indices_u32[root_first + i];
+    if (node >= doc->node_count) {
+      gltf_set_err_if(out_err, "root node index out of range", NULL, 0, 0);
+      order_reset(sc);
+      return GLTF_ERR_INVALID;
+    }
+    // Roots listed twice are evaluated once.
+    if (sc->order_pos[node] == UINT32_MAX) order_append(sc, node, UINT32_MAX);
   }
 
-  gltf_dfs_frame* f = stack_peek(stack, *top);
-  uint32_t node = f->node;
+  sc->level_first[0] = 0;
+  uint32_t level_begin = 0;
+  int shared = 0; // some child was reached through a second parent
+  while (level_begin < sc->order_count) {
+    const uint32_t level_end = sc->order_count;
+    sc->level_first[++sc->level_count] = level_end;
+
+    for (uint32_t k = level_begin; k < level_end; k++) {
+      const uint32_t node = sc->order[k];
+      const gltf_range_u32 cr = doc->nodes[node].children;
+      if (cr.first > doc->indices_count ||
+          cr.count > doc->indices_count - cr.first) {
+        gltf_set_err_if(out_err, "childen range out of bounds", NULL, 1, 1);
+        order_reset(sc);
+        return GLTF_ERR_INVALID;
+      }
+
+      for (uint32_t c = 0; c < cr.count; c++) {
+        const uint32_t child = doc->indices_u32[cr.first + c];
+        if (child >= doc->node_count) {
+          gltf_set_err_if(out_err, "child index out of range", NULL, 1, 1);
+          order_reset(sc);
+          return GLTF_ERR_INVALID;
+        }
+        if (sc->order_pos[child] != UINT32_MAX) {
+          shared = 1;
+          continue;  // already reached through another parent (or a cycle)
+        }
+        order_append(sc, child, node);
+      }
+    }
+    level_begin = level_end;
+  }
 
-  if (cache->state[node] == 0u) {
-    const float* parent_world = f->parent == UINT32_MAX
-                                  ? identity
-                                  : world_ptr_ro(cache, f->parent);
-    return eval_one_node(doc, cache, node, parent_world, out_err);
+  // A tree never revisits a node, so only shared children can close a cycle.
+  if (shared) {
+    const int cycle = order_has_cycle(doc, sc);
+    if (cycle != 0) {
+      if (cycle < 0) {
+        gltf_set_err_if(out_err, "oom", NULL, 0, 0);
+      } else {
+        gltf_set_err_if(out_err, "cycle in node graph", NULL, 1, 1);
+      }
+      order_reset(sc);
+      return cycle < 0 ? GLTF_ERR_IO : GLTF_ERR_INVALID;
+    }
   }
 
-  // DESCEND / EXIT
-  gltf_range_u32 cr = doc->nodes[node].children;
-  if (cr.first > doc->indices_count ||
-      cr.count > doc->indices_count - cr.first) {
-    gltf_set_err_if(out_err, "childen range out of bounds", NULL, 1, 1);
-    return GLTF_ERR_INVALID;
+  sc->built = 1;
+  return GLTF_OK;
+}
+
+
+// ----------------------------------------------------------------------------
+// Node evaluation
+// ----------------------------------------------------------------------------
+
+
+// world(node) = world(parent) * local(node), recording the parent it used.
+static inline void eval_node(const gltf_doc* doc,
+                             gltf_world_cache* cache,
+                             uint32_t node,
+                             uint32_t parent) {
+  float* out_world = world_ptr(cache, node);
+
+  if (cache->soa_trs) {
+    // Local matrices were composed up front by soa_compose_locals().
+    const float* local = soa_cache_local_ptr(doc, cache, node);
+    if (parent == UINT32_MAX) {
+      memcpy(out_world, local, 16u * sizeof(float));
+    } else {
+      mat4_mul_f32x4(world_ptr_ro(cache, parent), local, out_world);
+    }
+  } else if (parent == UINT32_MAX) {
+    cache_local_matrix(doc, cache, node, out_world);
+  } else {
+    float local[16];
+    cache_local_matrix(doc, cache, node, local);
+    mat4_mul(world_ptr_ro(cache, parent), local, out_world);
   }
 
-  if (f->child_i < cr.count) {
-    uint32_t child = doc->indices_u32[cr.first + f->child_i];
-    f->child_i++;
+  cache->world_parent[node] = parent;
+  cache->world_gen[node] = cache->gen;
+  cache->stamp[node] = cache->epoch;
+}
 
-    if (child >= doc->node_count) {
-      gltf_set_err_if(out_err, "child index out of range", NULL, 1, 1);
-      return GLTF_ERR_INVALID;
+// Evaluates order[k_first .. k_end) of sc; parents must already be up to date.
+// Nodes already current under the same parent are skipped unless that parent
+// was recomputed by this pass.
+static void eval_order_range(const gltf_doc* doc,
+                             gltf_world_cache* cache,
+                             const gltf_world_scene* sc,
+                             uint32_t k_first,
+                             uint32_t k_end) {
+  const uint32_t gen = cache->gen;
+  const uint32_t epoch = cache->epoch;
+  for (uint32_t k = k_first; k < k_end; k++) {
+    const uint32_t node = sc->order[k];
+    const uint32_t parent = sc->parent[node];
+
+    if (cache->world_gen[node] == gen) {
+      if (cache->world_parent[node] != parent) {
+        // Another scene evaluated this node under a different parent.
+        gltf_atomic_store_release_u32(&cache->conflict, 1u);
+      } else if (parent == UINT32_MAX || cache->stamp[parent] != epoch) {
+        continue;
+      }
     }
+    eval_node(doc, cache, node, parent);
+  }
+}
 
-    stack_push(stack, top, (gltf_dfs_frame){
-      .node = child,
-      .parent = node,
-      .child_i = 0u,
-    });
-    return GLTF_OK;
+// Recomputes pending dirty nodes and their descendants wherever they have been
+// computed, following world_parent links (so every scene sharing them stays
+// valid). Dirty nodes that are not current are left for the next evaluation.
+static void apply_dirty(const gltf_doc* doc, gltf_world_cache* cache) {
+  if (!cache->local_flags || cache->dirty_count == 0) return;
+
+  const uint32_t gen = cache->gen;
+  (void)next_epoch(cache);
+  if (cache->soa_trs) {
+    // Dirty nodes read soa_local_m16; refresh just their entry.
+    for (uint32_t i = 0; i < cache->dirty_count; i++) {
+      const uint32_t node = cache->dirty[i];
+      soa_local_matrix(cache, node, &cache->soa_local_m16[(size_t)node * 16u]);
+    }
   }
 
-  cache->state[node] = 2u; // DONE
-  stack_pop(top);
-  return GLTF_OK;
+  for (uint32_t i = 0; i < cache->dirty_count; i++) {
+    const uint32_t start = cache->dirty[i];
+    if (cache->world_gen[start] != gen) continue;
+
+    // A dirty ancestor's subtree already covers this node.
+    int covered = 0;
+    for (uint32_t p = cache->world_parent[start]; p != UINT32_MAX; p = cache->world_parent[p]) {
+      if (cache->local_flags[p] & GLTF_WORLD_LOCAL_DIRTY) {
+        covered = 1;
+        break;
+      }
+    }
+    if (covered) continue;
+
+    uint32_t top = 0;
+    cache->stack[top++] = start;
+    while (top > 0) {
+      const uint32_t node = cache->stack[--top];
+      eval_node(doc, cache, node, cache->world_parent[node]);
+
+      // Children ranges were validated when the orders were built. Only follow
+      // edges the stored matrices use (a node reached twice keeps one parent).
+      const gltf_range_u32 cr = doc->nodes[node].children;
+      for (uint32_t c = 0; c < cr.count; c++) {
+        const uint32_t child = doc->indices_u32[cr.first + c];
+        if (cache->world_gen[child] == gen && cache->world_parent[child] == node &&
+            cache->stamp[child] != cache->epoch) {
+          cache->stack[top++] = child;
+        }
+      }
+    }
+  }
+
+  for (uint32_t i = 0; i < cache->dirty_count; i++) {
+    cache->local_flags[cache->dirty[i]] &= (uint8_t)~GLTF_WORLD_LOCAL_DIRTY;
+  }
+  cache->dirty_count = 0;
 }
 
 
@@ -279,10 +716,68 @@ static gltf_result dfs_step(const gltf_doc* doc,
 // ----------------------------------------------------------------------------
 
 
-gltf_result gltf_compute_world_matrices(const gltf_doc* doc,
-                                        uint32_t scene_index,
-                                        gltf_world_cache* cache,
-                                        gltf_error* out_err) {
+// Nodes per parallel task; below two chunks a level runs on the calling thread.
+#define GLTF_WORLD_TASK_GRAIN 256u
+
+// One dispatched job: items [first, first + count) split into 'chunk'-sized tasks.
+typedef struct world_task {
+  const gltf_doc* doc;
+  gltf_world_cache* cache;
+  const gltf_world_scene* scene;
+  uint32_t first;
+  uint32_t count;
+  uint32_t chunk;
+} world_task;
+
+static void world_task_range(const world_task* t, uint32_t task_index, uint32_t* out_first, uint32_t* out_end) {
+  const uint32_t off = task_index * t->chunk;
+  const uint32_t n = (t->count - off < t->chunk) ? t->count - off : t->chunk;
+  *out_first = t->first + off;
+  *out_end = t->first + off + n;
+}
+
+static void world_eval_task(void* user, uint32_t task_index) {
+  const world_task* t = (const world_task*)user;
+  uint32_t k0, k1;
+  world_task_range(t, task_index, &k0, &k1);
+  eval_order_range(t->doc, t->cache, t->scene, k0, k1);
+}
+
+static void world_compose_task(void* user, uint32_t task_index) {
+  const world_task* t = (const world_task*)user;
+  uint32_t b0, b1;
+  world_task_range(t, task_index, &b0, &b1);
+  soa_compose_locals(t->cache, b0, b1);
+}
+
+// Runs fn over [first, first + count) through dispatch, or inline when the
+// range is too small to be worth splitting.
+static void world_run(const world_task* proto,
+                      gltf_dispatch_fn dispatch,
+                      void* dispatch_user,
+                      gltf_task_fn fn,
+                      uint32_t first,
+                      uint32_t count,
+                      uint32_t grain) {
+  world_task t = *proto;
+  t.first = first;
+  t.count = count;
+  t.chunk = count;
+  if (!dispatch || count < 2u * grain) {
+    if (count > 0) fn(&t, 0);
+    return;
+  }
+  const uint32_t tasks = (count + grain - 1u) / grain;
+  t.chunk = (count + tasks - 1u) / tasks;
+  dispatch(dispatch_user, (count + t.chunk - 1u) / t.chunk, fn, &t);
+}
+
+static gltf_result compute_world(const gltf_doc* doc,
+                                 uint32_t scene_index,
+                                 gltf_world_cache* cache,
+                                 gltf_dispatch_fn dispatch,
+                                 void* dispatch_user,
+                                 gltf_error* out_err) {
   if (!doc || !cache) {
     gltf_set_err_if(out_err, "invalid args", NULL, 1, 1);
     return GLTF_ERR_INVALID;
@@ -291,72 +786,97 @@ gltf_result gltf_compute_world_matrices(const gltf_doc* doc,
     gltf_set_err_if(out_err, "cache/doc node_count mismatch", NULL, 0, 0);
     return GLTF_ERR_INVALID;
   }
+  if (cache->scene_count != doc->scene_count) {
+    gltf_set_err_if(out_err, "cache/doc scene_count mismatch", NULL, 0, 0);
+    return GLTF_ERR_INVALID;
+  }
   if (scene_index >= doc->scene_count) {
     gltf_set_err_if(out_err, "scene index out of range", NULL, 1, 1);
     return GLTF_ERR_INVALID;
   }
 
-  cache->valid = 0;
   cache->scene_index = scene_index;
-  memset(cache->state, 0, (size_t)doc->node_count * sizeof(cache->state[0]));
-
-  const gltf_scene* scene = &doc->scenes[scene_index];
+  gltf_world_scene* sc = &cache->scenes[scene_index];
 
-  if (!scene->nodes.count) {
-    cache->valid = 1;
-    return GLTF_OK;
+  if (!sc->built) {
+    gltf_result r = build_order(doc, cache, scene_index, out_err);
+    if (r != GLTF_OK) return r;
   }
 
-  uint32_t node_offset = scene->nodes.first;
-  uint32_t node_count = scene->nodes.count;
+  // Pending overrides first: updated subtrees stay current for every scene.
+  apply_dirty(doc, cache);
+  if (sc->valid) return GLTF_OK;
 
-  if (node_offset > doc->indices_count ||
-      node_count > doc->indices_count - node_offset) {
-    gltf_set_err_if(out_err, "scene.nodes out of bounds", NULL, 1, 1);
-    return GLTF_ERR_INVALID;
+  (void)next_epoch(cache);
+  cache->conflict = 0;
+
+  // SoA: compose every local matrix first (independent per node).
+  const world_task proto = { doc, cache, sc, 0, 0, 0 };
+  if (cache->soa_trs) {
+    world_run(&proto, dispatch, dispatch_user, world_compose_task,
+              0, cache->soa_stride / 4u, GLTF_WORLD_TASK_GRAIN / 4u);
   }
 
-  float I[16];
-  mat4_identity(I);
+  if (!dispatch) {
+    // Parents precede children: one linear pass, world = parent_world * local.
+    eval_order_range(doc, cache, sc, 0, sc->order_count);
+  } else {
+    // A level only reads the one before it, so its nodes are independent.
+    for (uint32_t d = 0; d < sc->level_count; d++) {
+      const uint32_t k0 = sc->level_first[d];
+      const uint32_t k1 = sc->level_first[d + 1u];
+      world_run(&proto, dispatch, dispatch_user, world_eval_task, k0, k1 - k0, GLTF_WORLD_TASK_GRAIN);
+    }
+  }
 
-  gltf_dfs_frame* stack = (gltf_dfs_frame*)malloc(sizeof(*stack) * (size_t)doc->node_count);
-  if (!stack) {
-    gltf_set_err_if(out_err, "oom", NULL, 1, 1);
-    return GLTF_ERR_IO;
+  if (gltf_atomic_load_acquire_u32(&cache->conflict)) {
+    // Matrices other scenes relied on were replaced: only this scene's survive.
+    next_gen(cache);
+    for (uint32_t k = 0; k < sc->order_count; k++) cache->world_gen[sc->order[k]] = cache->gen;
   }
 
-  gltf_result r = GLTF_OK;
- 
-  // Run a separate DFS for each scene root.
-  for (uint32_t i = 0; i < node_count; i++) {
-    uint32_t top = 0;
-    uint32_t node_index = doc->indices_u32[node_offset + i];
+  sc->valid = 1;
+  return GLTF_OK;
+}
 
-    if (node_index >= doc->node_count) {
-      gltf_set_err_if(out_err, "root node index out of range", NULL, 0, 0);
-      r = GLTF_ERR_INVALID;
-      break;
-    }
+gltf_result gltf_compute_world_matrices(const gltf_doc* doc,
+                                        uint32_t scene_index,
+                                        gltf_world_cache* cache,
+                                        gltf_error* out_err) {
+  return compute_world(doc, scene_index, cache, NULL, NULL, out_err);
+}
 
-    // If this root was already processed by a previous root traversal,
-    // we can skip it (prevents extra stack churn in weird scenes).
-    if (cache->state[node_index] == 2u) continue;
+gltf_result gltf_compute_world_matrices_parallel(const gltf_doc* doc,
+                                                 uint32_t scene_index,
+                                                 gltf_world_cache* cache,
+                                                 gltf_dispatch_fn dispatch,
+                                                 void* dispatch_user,
+                                                 gltf_error* out_err) {
+  return compute_world(doc, scene_index, cache, dispatch, dispatch_user, out_err);
+}
 
-    stack_push(stack, &top, (gltf_dfs_frame){
-      .node = node_index,
-      .parent = UINT32_MAX,
-      .child_i = 0u,
-    });
 
-    while (top > 0) {
-      r = dfs_step(doc, cache, stack, &top, I, out_err);
-      if (r != GLTF_OK) break;
-    }
-    if (r != GLTF_OK) break;
-  }
+// ----------------------------------------------------------------------------
+// Public API: incremental update (dirty subtrees)
+// ----------------------------------------------------------------------------
 
-  free(stack);
 
-  if (r == GLTF_OK) cache->valid = 1;
-  return r;
+gltf_result gltf_update_world_matrices(const gltf_doc* doc,
+                                       gltf_world_cache* cache,
+                                       gltf_error* out_err) {
+  if (!doc || !cache) {
+    gltf_set_err_if(out_err, "invalid args", NULL, 1, 1);
+    return GLTF_ERR_INVALID;
+  }
+  if (cache->node_count != doc->node_count) {
+    gltf_set_err_if(out_err, "cache/doc node_count mismatch", NULL, 0, 0);
+    return GLTF_ERR_INVALID;
+  }
+  const gltf_world_scene* sc = current_scene(cache);
+  if (!sc || !sc->valid) {
+    gltf_set_err_if(out_err, "world matrices not computed", NULL, 0, 0);
+    return GLTF_ERR_INVALID;
+  }
+  apply_dirty(doc, cache);
+  return GLTF_OK;
 }
@@ -0,0 +1,144 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern gltf_doc* g_doc;
+
+// 37 elements: large enough for every SIMD width plus a scalar tail.
+#define T08_COUNT 37u
+#define T08_BIN_SIZE 1264u
+
+static const char* k_t08_json =
+  "{"
+  "\"asset\":{\"version\":\"2.0\"},"
+  "\"buffers\":[{\"byteLength\":1264}],"
+  "\"bufferViews\":["
+    "{\"buffer\":0,\"byteOffset\":0,\"byteLength\":148},"
+    "{\"buffer\":0,\"byteOffset\":148,\"byteLength\":74},"
+    "{\"buffer\":0,\"byteOffset\":224,\"byteLength\":148},"
+    "{\"buffer\":0,\"byteOffset\":372,\"byteLength\":222},"
+    "{\"buffer\":0,\"byteOffset\":596,\"byteLength\":592,\"byteStride\":16},"
+    "{\"buffer\":0,\"byteOffset\":1188,\"byteLength\":74}"
+  "],"
+  "\"accessors\":["
+    "{\"bufferView\":0,\"componentType\":5121,\"normalized\":true,\"count\":37,\"type\":\"VEC4\"},"
+    "{\"bufferView\":1,\"componentType\":5120,\"normalized\":true,\"count\":37,\"type\":\"VEC2\"},"
+    "{\"bufferView\":2,\"componentType\":5123,\"normalized\":true,\"count\":37,\"type\":\"VEC2\"},"
+    "{\"bufferView\":3,\"componentType\":5122,\"normalized\":true,\"count\":37,\"type\":\"VEC3\"},"
+    "{\"bufferView\":4,\"componentType\":5126,\"count\":37,\"type\":\"VEC3\"},"
+    "{\"bufferView\":5,\"componentType\":5123,\"count\":37,\"type\":\"SCALAR\"}"
+  "]"
+  "}";
+
+static void t08_build_bin(uint8_t bin[T08_BIN_SIZE]) {
+  uint32_t seed = 12345u;
+  for (uint32_t i = 0; i < T08_BIN_SIZE; i++) {
+    seed = seed * 1664525u + 1013904223u;
+    bin[i] = (uint8_t)(seed >> 24u);
+  }
+  // Signed MIN values must decode to exactly -1.0f.
+  bin[148] = 0x80u;
+  bin[372] = 0x00u;
+  bin[373] = 0x80u;
+
+  // Interleaved f32 VEC3 with stride 16 (real floats, no NaNs).
+  for (uint32_t e = 0; e < T08_COUNT; e++) {
+    float v[4] = { (float)e * 0.5f, -(float)e, (float)e * 1.25f + 3.0f, 99.0f };
+    memcpy(bin + 596u + e * 16u, v, sizeof v);
+  }
+}
+
+static void t08_load(uint8_t** out_glb) {
+  static uint8_t bin[T08_BIN_SIZE];
+  t08_build_bin(bin);
+
+  size_t size = 0;
+  uint8_t* glb = test_build_glb(k_t08_json, bin, T08_BIN_SIZE, &size);
+  gltf_error err = {0};
+  gltf_result rc = gltf_load_glb_bytes(glb, size, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_glb_bytes");
+  *out_glb = glb;
+}
+
+void test_08_read_f32_range_matches_per_element(void) {
+  uint8_t* glb = NULL;
+  t08_load(&glb);
+
+  for (uint32_t acc = 0; acc < gltf_doc_accessor_count(g_doc); acc++) {
+    uint32_t count = 0, comp = 0, type = 0;
+    int norm = 0;
+    TEST_ASSERT_EQUAL_INT(1, gltf_doc_accessor_info(g_doc, acc, &count, &comp, &type, &norm));
+    TEST_ASSERT_EQUAL_UINT32(T08_COUNT, count);
+
+    float bulk[T08_COUNT * 4u];
+    gltf_error err = {0};
+    gltf_result rc = gltf_accessor_read_f32_range(g_doc, acc, 0, count, bulk, 0, &err);
+    test_assert_ok(rc, &err, "gltf_accessor_read_f32_range");
+
+    const uint32_t comps = (type == GLTF_ACCESSOR_SCALAR) ? 1u : type == GLTF_ACCESSOR_VEC2 ? 2u
+                           : type == GLTF_ACCESSOR_VEC3 ? 3u : 4u;
+    for (uint32_t e = 0; e < count; e++) {
+      float one[16];
+      rc = gltf_accessor_read_f32(g_doc, acc, e, one, 16, &err);
+      test_assert_ok(rc, &err, "gltf_accessor_read_f32");
+      // Bit-exact match with the scalar decoder.
+      TEST_ASSERT_EQUAL_MEMORY(one, &bulk[e * comps], comps * sizeof(float));
+    }
+  }
+
+  // Normalized signed MIN clamps to -1.
+  float v[2];
+  gltf_error err = {0};
+  TEST_ASSERT_EQUAL_INT(GLTF_OK, gltf_accessor_read_f32_range(g_doc, 1, 0, 1, v, 0, &err));
+  TEST_ASSERT_EQUAL_FLOAT(-1.0f, v[0]);
+  float w[3];
+  TEST_ASSERT_EQUAL_INT(GLTF_OK, gltf_accessor_read_f32_range(g_doc, 3, 0, 1, w, 0, &err));
+  TEST_ASSERT_EQUAL_FLOAT(-1.0f, w[0]);
+
+  free(glb);
+}
+
+void test_08_read_f32_range_strided_subrange(void) {
+  uint8_t* glb = NULL;
+  t08_load(&glb);
+
+  // Sub-range of the u16 VEC2 accessor written with a padded destination stride.
+  float dst[20 * 5];
+  for (uint32_t i = 0; i < 20u * 5u; i++) dst[i] = 42.0f;
+
+  gltf_error err = {0};
+  gltf_result rc = gltf_accessor_read_f32_range(g_doc, 2, 5, 20, dst, 5, &err);
+  test_assert_ok(rc, &err, "gltf_accessor_read_f32_range(strided)");
+
+  for (uint32_t e = 0; e < 20u; e++) {
+    float one[16];
+    rc = gltf_accessor_read_f32(g_doc, 2, 5u + e, one, 16, &err);
+    test_assert_ok(rc, &err, "gltf_accessor_read_f32");
+    TEST_ASSERT_EQUAL_MEMORY(one, &dst[e * 5u], 2u * sizeof(float));
+    TEST_ASSERT_EQUAL_FLOAT(42.0f, dst[e * 5u + 2u]);
+    TEST_ASSERT_EQUAL_FLOAT(42.0f, dst[e * 5u + 4u]);
+  }
+
+  // Interleaved source (byteStride 16) into a packed destination.
+  float pos[T08_COUNT * 3u];
+  rc = gltf_accessor_read_f32_range(g_doc, 4, 0, T08_COUNT, pos, 0, &err);
+  test_assert_ok(rc, &err, "gltf_accessor_read_f32_range(interleaved)");
+  TEST_ASSERT_EQUAL_FLOAT(18.0f, pos[36u * 3u + 0u]);
+  TEST_ASSERT_EQUAL_FLOAT(-36.0f, pos[36u * 3u + 1u]);
+  TEST_ASSERT_EQUAL_FLOAT(48.0f, pos[36u * 3u + 2u]);
+
+  // Range and stride validation.
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID,
+                        gltf_accessor_read_f32_range(g_doc, 2, 30, 8, dst, 0, &err));
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID,
+                        gltf_accessor_read_f32_range(g_doc, 2, 0, 1, dst, 1, &err));
+  TEST_ASSERT_EQUAL_INT(GLTF_OK, gltf_accessor_read_f32_range(g_doc, 2, 37, 0, dst, 0, &err));
+
+  free(glb);
+}
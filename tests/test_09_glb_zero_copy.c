@@ -0,0 +1,116 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern gltf_doc* g_doc;
+
+static const char* k_t09_json =
+  "{"
+  "\"asset\":{\"version\":\"2.0\",\"generator\":\"t09 \\\"escaped\\\"\"},"
+  "\"buffers\":[{\"byteLength\":44}],"
+  "\"bufferViews\":["
+    "{\"buffer\":0,\"byteOffset\":0,\"byteLength\":36},"
+    "{\"buffer\":0,\"byteOffset\":36,\"byteLength\":6}"
+  "],"
+  "\"accessors\":["
+    "{\"bufferView\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"},"
+    "{\"bufferView\":1,\"componentType\":5123,\"count\":3,\"type\":\"SCALAR\"}"
+  "],"
+  "\"meshes\":[{\"name\":\"tri\",\"primitives\":[{\"attributes\":{\"POSITION\":0},\"indices\":1}]}],"
+  "\"nodes\":[{\"mesh\":0}],"
+  "\"scenes\":[{\"nodes\":[0]}],"
+  "\"scene\":0"
+  "}";
+
+static uint8_t* t09_build(size_t* out_size, uint32_t* out_bin_offset) {
+  uint8_t bin[44];
+  memset(bin, 0, sizeof bin);
+  const float pos[9] = { 0, 0, 0, 1, 0, 0, 0, 1, 0 };
+  const uint16_t idx[3] = { 0, 1, 2 };
+  memcpy(bin, pos, sizeof pos);
+  memcpy(bin + 36, idx, sizeof idx);
+
+  uint8_t* glb = test_build_glb(k_t09_json, bin, sizeof bin, out_size);
+  *out_bin_offset = (uint32_t)(*out_size - 44u);
+  return glb;
+}
+
+void test_09_glb_borrow_bin(void) {
+  size_t size = 0;
+  uint32_t bin_off = 0;
+  uint8_t* glb = t09_build(&size, &bin_off);
+
+  gltf_load_options opts = {0};
+  opts.flags = GLTF_LOAD_BORROW_BIN;
+
+  gltf_error err = {0};
+  gltf_result rc = gltf_load_glb_bytes_ex(glb, size, &opts, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_glb_bytes_ex(BORROW_BIN)");
+
+  // POSITION points straight into the caller's BIN chunk.
+  gltf_span pos = {0};
+  rc = gltf_mesh_primitive_position_span(g_doc, 0, 0, &pos, &err);
+  test_assert_ok(rc, &err, "position_span");
+  TEST_ASSERT_TRUE(pos.ptr == glb + bin_off);
+
+  uint32_t i2 = 0;
+  rc = gltf_mesh_primitive_read_index_u32(g_doc, 0, 0, 2, &i2, &err);
+  test_assert_ok(rc, &err, "read_index_u32");
+  TEST_ASSERT_EQUAL_UINT32(2u, i2);
+
+  // gltf_free() must not release borrowed memory; free the doc first.
+  gltf_free(g_doc);
+  g_doc = NULL;
+  free(glb);
+}
+
+void test_09_glb_json_insitu(void) {
+  size_t size = 0;
+  uint32_t bin_off = 0;
+  uint8_t* glb = t09_build(&size, &bin_off);
+
+  uint8_t* ref = (uint8_t*)malloc(size);
+  TEST_ASSERT_NOT_NULL(ref);
+  memcpy(ref, glb, size);
+
+  gltf_load_options opts = {0};
+  opts.flags = GLTF_LOAD_JSON_INSITU | GLTF_LOAD_BORROW_BIN;
+
+  gltf_error err = {0};
+  gltf_result rc = gltf_load_glb_bytes_ex(glb, size, &opts, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_glb_bytes_ex(JSON_INSITU)");
+
+  TEST_ASSERT_EQUAL_STRING("t09 \"escaped\"", gltf_doc_asset_generator(g_doc));
+  TEST_ASSERT_EQUAL_STRING("tri", gltf_doc_mesh_name(g_doc, 0));
+
+  // The BIN chunk header and payload are restored/untouched.
+  TEST_ASSERT_EQUAL_MEMORY(ref + bin_off - 8u, glb + bin_off - 8u, size - (bin_off - 8u));
+
+  free(ref);
+  gltf_free(g_doc);
+  g_doc = NULL;
+  free(glb);
+}
+
+void test_09_glb_json_insitu_without_bin(void) {
+  const char* json = "{\"asset\":{\"version\":\"2.0\"},\"nodes\":[{\"name\":\"only\"}]}";
+  size_t size = 0;
+  uint8_t* glb = test_build_glb(json, NULL, 0, &size);
+
+  // JSON chunk is the last thing in the blob: no padding to borrow, falls back to a copy.
+  gltf_load_options opts = {0};
+  opts.flags = GLTF_LOAD_JSON_INSITU;
+
+  gltf_error err = {0};
+  gltf_result rc = gltf_load_glb_bytes_ex(glb, size, &opts, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_glb_bytes_ex(no BIN)");
+  TEST_ASSERT_EQUAL_UINT32(1u, gltf_doc_node_count(g_doc));
+
+  free(glb);
+}
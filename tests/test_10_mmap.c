@@ -0,0 +1,66 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef GLTF_REPO_ROOT
+#error "GLTF_REPO_ROOT must be defined by the build system"
+#endif
+
+extern gltf_doc* g_doc;
+
+// Loads path twice (read vs. mmap) and checks that every accessor span has
+// identical bytes.
+static void t10_compare_read_and_mmap(const char* path) {
+  gltf_error err = {0};
+  gltf_doc* ref = NULL;
+  gltf_result rc = gltf_load_file(path, &ref, &err);
+  test_assert_ok(rc, &err, "gltf_load_file");
+
+  gltf_load_options opts = {0};
+  opts.flags = GLTF_LOAD_MMAP;
+  rc = gltf_load_file_ex(path, &opts, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_file_ex(MMAP)");
+
+  TEST_ASSERT_EQUAL_UINT32(gltf_doc_accessor_count(ref), gltf_doc_accessor_count(g_doc));
+  TEST_ASSERT_TRUE(gltf_doc_accessor_count(g_doc) > 0);
+
+  for (uint32_t a = 0; a < gltf_doc_accessor_count(g_doc); a++) {
+    gltf_span sa = {0}, sb = {0};
+    test_assert_ok(gltf_accessor_span(ref, a, &sa, &err), &err, "span(read)");
+    test_assert_ok(gltf_accessor_span(g_doc, a, &sb, &err), &err, "span(mmap)");
+    TEST_ASSERT_EQUAL_UINT32(sa.count, sb.count);
+    TEST_ASSERT_EQUAL_UINT32(sa.stride, sb.stride);
+    TEST_ASSERT_TRUE(sa.ptr != sb.ptr);
+    for (uint32_t e = 0; e < sa.count; e++) {
+      TEST_ASSERT_EQUAL_MEMORY(sa.ptr + (size_t)e * sa.stride,
+                               sb.ptr + (size_t)e * sb.stride,
+                               sa.elem_size);
+    }
+  }
+
+  gltf_free(ref);
+}
+
+void test_10_mmap_external_buffers(void) {
+  t10_compare_read_and_mmap(GLTF_REPO_ROOT "/tests/fixtures/02_plane.gltf");
+}
+
+void test_10_mmap_glb(void) {
+  t10_compare_read_and_mmap(GLTF_REPO_ROOT "/tests/fixtures/07-basic.glb");
+}
+
+void test_10_mmap_missing_file(void) {
+  gltf_load_options opts = {0};
+  opts.flags = GLTF_LOAD_MMAP;
+  gltf_error err = {0};
+  gltf_result rc = gltf_load_file_ex(GLTF_REPO_ROOT "/tests/fixtures/does-not-exist.gltf",
+                                     &opts, &g_doc, &err);
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_IO, rc);
+  TEST_ASSERT_NULL(g_doc);
+}
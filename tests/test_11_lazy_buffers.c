@@ -0,0 +1,73 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef GLTF_REPO_ROOT
+#error "GLTF_REPO_ROOT must be defined by the build system"
+#endif
+
+extern gltf_doc* g_doc;
+
+static void t11_load_lazy(const char* path, uint32_t extra_flags) {
+  gltf_load_options opts = {0};
+  opts.flags = GLTF_LOAD_LAZY_BUFFERS | extra_flags;
+  gltf_error err = {0};
+  gltf_result rc = gltf_load_file_ex(path, &opts, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_file_ex(LAZY_BUFFERS)");
+}
+
+static void t11_check_plane_positions(void) {
+  float p[4 * 3];
+  gltf_error err = {0};
+  gltf_result rc = gltf_accessor_read_f32_range(g_doc, 0, 0, 4, p, 0, &err);
+  test_assert_ok(rc, &err, "read_f32_range");
+  TEST_ASSERT_EQUAL_FLOAT(-1.0f, p[0]);
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, p[1]);
+  TEST_ASSERT_EQUAL_FLOAT(1.0f, p[2]);
+
+  uint32_t i5 = 0;
+  rc = gltf_mesh_primitive_read_index_u32(g_doc, 0, 0, 5, &i5, &err);
+  test_assert_ok(rc, &err, "read_index_u32");
+  TEST_ASSERT_TRUE(i5 < 4u);
+}
+
+void test_11_lazy_external_buffer(void) {
+  t11_load_lazy(GLTF_REPO_ROOT "/tests/fixtures/02_plane.gltf", 0);
+  t11_check_plane_positions();
+}
+
+void test_11_lazy_mmap_and_data_uri(void) {
+  t11_load_lazy(GLTF_REPO_ROOT "/tests/fixtures/02_plane.gltf", GLTF_LOAD_MMAP);
+  t11_check_plane_positions();
+  gltf_free(g_doc);
+  g_doc = NULL;
+
+  t11_load_lazy(GLTF_REPO_ROOT "/tests/fixtures/02_plane_embedded.gltf", 0);
+  t11_check_plane_positions();
+}
+
+void test_11_lazy_missing_buffer_fails_on_first_touch(void) {
+  const char* path = GLTF_REPO_ROOT "/tests/fixtures/10-missing-buffer.gltf";
+
+  // Eager loading reports the missing file immediately.
+  gltf_error err = {0};
+  gltf_doc* eager = NULL;
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_IO, gltf_load_file(path, &eager, &err));
+  TEST_ASSERT_NULL(eager);
+
+  // Lazy loading succeeds; metadata is available without touching the buffer.
+  t11_load_lazy(path, 0);
+  TEST_ASSERT_EQUAL_STRING("Lazy", gltf_doc_node_name(g_doc, 0));
+
+  gltf_span sp = {0};
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_IO, gltf_accessor_span(g_doc, 0, &sp, &err));
+  TEST_ASSERT_NOT_NULL(err.message);
+  // Still failing (and retried) on the next touch.
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_IO, gltf_accessor_span(g_doc, 0, &sp, &err));
+}
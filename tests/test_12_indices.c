@@ -0,0 +1,126 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern gltf_doc* g_doc;
+
+// 37 indices per accessor: covers every SIMD width plus a scalar tail.
+#define T12_COUNT 37u
+#define T12_BIN_SIZE 488u
+
+static const char* k_t12_json =
+  "{"
+  "\"asset\":{\"version\":\"2.0\"},"
+  "\"buffers\":[{\"byteLength\":488}],"
+  "\"bufferViews\":["
+    "{\"buffer\":0,\"byteOffset\":0,\"byteLength\":37},"
+    "{\"buffer\":0,\"byteOffset\":40,\"byteLength\":74},"
+    "{\"buffer\":0,\"byteOffset\":116,\"byteLength\":148},"
+    "{\"buffer\":0,\"byteOffset\":264,\"byteLength\":146,\"byteStride\":4},"
+    "{\"buffer\":0,\"byteOffset\":412,\"byteLength\":12}"
+  "],"
+  "\"accessors\":["
+    "{\"bufferView\":0,\"componentType\":5121,\"count\":37,\"type\":\"SCALAR\"},"
+    "{\"bufferView\":1,\"componentType\":5123,\"count\":37,\"type\":\"SCALAR\"},"
+    "{\"bufferView\":2,\"componentType\":5125,\"count\":37,\"type\":\"SCALAR\"},"
+    "{\"bufferView\":3,\"componentType\":5123,\"count\":37,\"type\":\"SCALAR\"},"
+    "{\"bufferView\":4,\"componentType\":5126,\"count\":1,\"type\":\"VEC3\"}"
+  "]"
+  "}";
+
+static uint8_t s_t12_bin[T12_BIN_SIZE];
+
+static void t12_load(uint8_t** out_glb) {
+  uint32_t seed = 777u;
+  for (uint32_t i = 0; i < T12_BIN_SIZE; i++) {
+    seed = seed * 1664525u + 1013904223u;
+    s_t12_bin[i] = (uint8_t)(seed >> 24u);
+  }
+  // Force extremes that exercise the unsigned min/max paths.
+  s_t12_bin[116u + 5u * 4u + 3u] = 0xFFu;
+  s_t12_bin[40u + 9u * 2u + 1u] = 0xFFu;
+
+  size_t size = 0;
+  uint8_t* glb = test_build_glb(k_t12_json, s_t12_bin, T12_BIN_SIZE, &size);
+  gltf_error err = {0};
+  gltf_result rc = gltf_load_glb_bytes(glb, size, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_glb_bytes");
+  *out_glb = glb;
+}
+
+static uint32_t t12_expected(uint32_t accessor, uint32_t i) {
+  const uint8_t* b = s_t12_bin;
+  switch (accessor) {
+  case 0: return b[i];
+  case 1: return (uint32_t)b[40u + i * 2u] | ((uint32_t)b[41u + i * 2u] << 8u);
+  case 2: {
+    const uint8_t* p = b + 116u + i * 4u;
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8u) | ((uint32_t)p[2] << 16u) |
+           ((uint32_t)p[3] << 24u);
+  }
+  default: return (uint32_t)b[264u + i * 4u] | ((uint32_t)b[265u + i * 4u] << 8u);
+  }
+}
+
+void test_12_read_indices_u32_widen_and_minmax(void) {
+  uint8_t* glb = NULL;
+  t12_load(&glb);
+
+  for (uint32_t acc = 0; acc < 4u; acc++) {
+    // Every sub-range start exercises misaligned SIMD loads and varying tails.
+    for (uint32_t first = 0; first < 5u; first++) {
+      const uint32_t count = T12_COUNT - first;
+      uint32_t dst[T12_COUNT];
+      uint32_t lo = 0, hi = 0;
+      gltf_error err = {0};
+      gltf_result rc = gltf_accessor_read_indices_u32(g_doc, acc, first, count, dst, &lo, &hi, &err);
+      test_assert_ok(rc, &err, "gltf_accessor_read_indices_u32");
+
+      uint32_t want_lo = UINT32_MAX, want_hi = 0;
+      for (uint32_t i = 0; i < count; i++) {
+        const uint32_t v = t12_expected(acc, first + i);
+        TEST_ASSERT_EQUAL_UINT32(v, dst[i]);
+        if (v < want_lo) want_lo = v;
+        if (v > want_hi) want_hi = v;
+      }
+      TEST_ASSERT_EQUAL_UINT32(want_lo, lo);
+      TEST_ASSERT_EQUAL_UINT32(want_hi, hi);
+    }
+  }
+
+  free(glb);
+}
+
+void test_12_read_indices_u32_validation(void) {
+  uint8_t* glb = NULL;
+  t12_load(&glb);
+
+  uint32_t dst[T12_COUNT];
+  uint32_t lo = 1, hi = 1;
+  gltf_error err = {0};
+
+  // Empty range.
+  TEST_ASSERT_EQUAL_INT(GLTF_OK,
+                        gltf_accessor_read_indices_u32(g_doc, 1, 37, 0, dst, &lo, &hi, &err));
+  TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, lo);
+  TEST_ASSERT_EQUAL_UINT32(0u, hi);
+
+  // Min/max outputs are optional.
+  TEST_ASSERT_EQUAL_INT(GLTF_OK,
+                        gltf_accessor_read_indices_u32(g_doc, 2, 0, 4, dst, NULL, NULL, &err));
+
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID,
+                        gltf_accessor_read_indices_u32(g_doc, 1, 30, 8, dst, &lo, &hi, &err));
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID,
+                        gltf_accessor_read_indices_u32(g_doc, 9, 0, 1, dst, &lo, &hi, &err));
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_PARSE,
+                        gltf_accessor_read_indices_u32(g_doc, 4, 0, 1, dst, &lo, &hi, &err));
+
+  free(glb);
+}
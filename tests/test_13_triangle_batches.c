@@ -0,0 +1,225 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern gltf_doc* g_doc;
+
+// 2100 vertices/indices: strips and fans span more than two full batches.
+#define T13_N 2100u
+#define T13_POS_BYTES (T13_N * 12u)
+#define T13_BIN_SIZE (T13_POS_BYTES + T13_N * 2u)
+
+// Primitives: 0 TRIANGLES, 1 TRIANGLE_STRIP, 2 TRIANGLE_FAN (all indexed), 3 strip without indices.
+static const char* k_t13_json =
+  "{"
+  "\"asset\":{\"version\":\"2.0\"},"
+  "\"buffers\":[{\"byteLength\":29400}],"
+  "\"bufferViews\":["
+    "{\"buffer\":0,\"byteOffset\":0,\"byteLength\":25200},"
+    "{\"buffer\":0,\"byteOffset\":25200,\"byteLength\":4200}"
+  "],"
+  "\"accessors\":["
+    "{\"bufferView\":0,\"componentType\":5126,\"count\":2100,\"type\":\"VEC3\"},"
+    "{\"bufferView\":1,\"componentType\":5123,\"count\":2100,\"type\":\"SCALAR\"}"
+  "],"
+  "\"meshes\":[{\"primitives\":["
+    "{\"attributes\":{\"POSITION\":0},\"indices\":1,\"mode\":4},"
+    "{\"attributes\":{\"POSITION\":0},\"indices\":1,\"mode\":5},"
+    "{\"attributes\":{\"POSITION\":0},\"indices\":1,\"mode\":6},"
+    "{\"attributes\":{\"POSITION\":0},\"mode\":5}"
+  "]}]"
+  "}";
+
+static uint32_t t13_index(uint32_t prim, uint32_t i) {
+  return (prim == 3u) ? i : (i * 7u) % T13_N;
+}
+
+static gltf_tri t13_expected(uint32_t prim, uint32_t t) {
+  gltf_tri tri;
+  if (prim == 0u) {
+    tri.i0 = t13_index(prim, t * 3u + 0u);
+    tri.i1 = t13_index(prim, t * 3u + 1u);
+    tri.i2 = t13_index(prim, t * 3u + 2u);
+  } else if (prim == 2u) {
+    tri.i0 = t13_index(prim, 0u);
+    tri.i1 = t13_index(prim, t + 1u);
+    tri.i2 = t13_index(prim, t + 2u);
+  } else {
+    tri.i0 = t13_index(prim, t + ((t & 1u) ? 1u : 0u));
+    tri.i1 = t13_index(prim, t + ((t & 1u) ? 0u : 1u));
+    tri.i2 = t13_index(prim, t + 2u);
+  }
+  return tri;
+}
+
+static uint8_t* t13_load(void) {
+  uint8_t* bin = (uint8_t*)calloc(1, T13_BIN_SIZE);
+  TEST_ASSERT_NOT_NULL(bin);
+  for (uint32_t i = 0; i < T13_N; i++) {
+    const uint32_t v = (i * 7u) % T13_N;
+    bin[T13_POS_BYTES + i * 2u + 0u] = (uint8_t)(v & 0xFFu);
+    bin[T13_POS_BYTES + i * 2u + 1u] = (uint8_t)(v >> 8u);
+  }
+
+  size_t size = 0;
+  uint8_t* glb = test_build_glb(k_t13_json, bin, T13_BIN_SIZE, &size);
+  free(bin);
+
+  gltf_error err = {0};
+  gltf_result rc = gltf_load_glb_bytes(glb, size, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_glb_bytes");
+  return glb;
+}
+
+typedef struct t13_batch_state {
+  uint32_t prim;
+  uint32_t next;
+  uint32_t calls;
+  uint32_t mismatches;
+} t13_batch_state;
+
+static gltf_iter_result t13_on_batch(const gltf_tri* tris,
+                                     uint32_t tri_first,
+                                     uint32_t tri_count,
+                                     void* user) {
+  t13_batch_state* st = (t13_batch_state*)user;
+  if (tri_first != st->next) st->mismatches++;
+  for (uint32_t k = 0; k < tri_count; k++) {
+    const gltf_tri e = t13_expected(st->prim, tri_first + k);
+    if (tris[k].i0 != e.i0 || tris[k].i1 != e.i1 || tris[k].i2 != e.i2) st->mismatches++;
+  }
+  st->next = tri_first + tri_count;
+  st->calls++;
+  return GLTF_ITER_CONTINUE;
+}
+
+void test_13_triangle_batches_match_topology(void) {
+  uint8_t* glb = t13_load();
+  const uint32_t want_counts[4] = { T13_N / 3u, T13_N - 2u, T13_N - 2u, T13_N - 2u };
+
+  for (uint32_t prim = 0; prim < 4u; prim++) {
+    gltf_error err = {0};
+    uint32_t tri_count = 0;
+    gltf_result rc = gltf_doc_primitive_triangle_count(g_doc, prim, &tri_count, &err);
+    test_assert_ok(rc, &err, "gltf_doc_primitive_triangle_count");
+    TEST_ASSERT_EQUAL_UINT32(want_counts[prim], tri_count);
+
+    // Odd batch size keeps strip parity changing between batches.
+    t13_batch_state st = { prim, 0, 0, 0 };
+    rc = gltf_doc_primitive_iterate_triangle_batches(g_doc, prim, 333, t13_on_batch, &st, &err);
+    test_assert_ok(rc, &err, "gltf_doc_primitive_iterate_triangle_batches");
+    TEST_ASSERT_EQUAL_UINT32(0u, st.mismatches);
+    TEST_ASSERT_EQUAL_UINT32(tri_count, st.next);
+    TEST_ASSERT_EQUAL_UINT32((tri_count + 332u) / 333u, st.calls);
+
+    // Default batch size.
+    t13_batch_state st2 = { prim, 0, 0, 0 };
+    rc = gltf_doc_primitive_iterate_triangle_batches(g_doc, prim, 0, t13_on_batch, &st2, &err);
+    test_assert_ok(rc, &err, "gltf_doc_primitive_iterate_triangle_batches(default)");
+    TEST_ASSERT_EQUAL_UINT32(0u, st2.mismatches);
+    TEST_ASSERT_EQUAL_UINT32((tri_count + GLTF_TRI_BATCH_MAX - 1u) / GLTF_TRI_BATCH_MAX, st2.calls);
+  }
+
+  free(glb);
+}
+
+void test_13_read_triangles_ranges(void) {
+  uint8_t* glb = t13_load();
+
+  gltf_tri* tris = (gltf_tri*)malloc(sizeof(gltf_tri) * T13_N);
+  TEST_ASSERT_NOT_NULL(tris);
+
+  for (uint32_t prim = 0; prim < 4u; prim++) {
+    gltf_error err = {0};
+    uint32_t tri_count = 0;
+    test_assert_ok(gltf_doc_primitive_triangle_count(g_doc, prim, &tri_count, &err), &err, "count");
+
+    // Whole primitive in one call (more than GLTF_TRI_BATCH_MAX triangles).
+    gltf_result rc = gltf_doc_primitive_read_triangles(g_doc, prim, 0, tri_count, tris, &err);
+    test_assert_ok(rc, &err, "gltf_doc_primitive_read_triangles");
+    for (uint32_t t = 0; t < tri_count; t++) {
+      const gltf_tri e = t13_expected(prim, t);
+      TEST_ASSERT_EQUAL_UINT32(e.i0, tris[t].i0);
+      TEST_ASSERT_EQUAL_UINT32(e.i1, tris[t].i1);
+      TEST_ASSERT_EQUAL_UINT32(e.i2, tris[t].i2);
+    }
+
+    // Sub-range starting at an odd triangle.
+    rc = gltf_doc_primitive_read_triangles(g_doc, prim, 101, 50, tris, &err);
+    test_assert_ok(rc, &err, "gltf_doc_primitive_read_triangles(sub-range)");
+    for (uint32_t k = 0; k < 50u; k++) {
+      const gltf_tri e = t13_expected(prim, 101u + k);
+      TEST_ASSERT_EQUAL_UINT32(e.i0, tris[k].i0);
+      TEST_ASSERT_EQUAL_UINT32(e.i1, tris[k].i1);
+      TEST_ASSERT_EQUAL_UINT32(e.i2, tris[k].i2);
+    }
+
+    TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID,
+                          gltf_doc_primitive_read_triangles(g_doc, prim, tri_count, 1, tris, &err));
+    TEST_ASSERT_EQUAL_INT(GLTF_OK,
+                          gltf_doc_primitive_read_triangles(g_doc, prim, tri_count, 0, tris, &err));
+  }
+
+  free(tris);
+  free(glb);
+}
+
+void test_13_triangle_work_items_cover_doc(void) {
+  uint8_t* glb = t13_load();
+
+  gltf_error err = {0};
+  uint32_t n_items = 0;
+  gltf_result rc = gltf_doc_triangle_work_items(g_doc, 300, NULL, 0, &n_items, &err);
+  test_assert_ok(rc, &err, "gltf_doc_triangle_work_items(count)");
+  // 700 triangles -> 3 items, each 2098-triangle primitive -> 7 items.
+  TEST_ASSERT_EQUAL_UINT32(3u + 3u * 7u, n_items);
+
+  gltf_tri_work_item items[24];
+  uint32_t n_small = 0;
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID,
+                        gltf_doc_triangle_work_items(g_doc, 300, items, 4, &n_small, &err));
+  TEST_ASSERT_EQUAL_UINT32(n_items, n_small);
+
+  rc = gltf_doc_triangle_work_items(g_doc, 300, items, 24, &n_items, &err);
+  test_assert_ok(rc, &err, "gltf_doc_triangle_work_items");
+
+  // Processing items in any order (here: reversed, odd batch size) covers
+  // every triangle exactly once with the same winding as a full iteration.
+  uint32_t covered[4] = { 0, 0, 0, 0 };
+  for (uint32_t i = n_items; i-- > 0;) {
+    const gltf_tri_work_item* it = &items[i];
+    TEST_ASSERT_TRUE(it->tri_count > 0u && it->tri_count <= 300u);
+
+    t13_batch_state st = { it->primitive_index, it->tri_first, 0, 0 };
+    rc = gltf_doc_primitive_iterate_triangle_range(
+      g_doc, it->primitive_index, it->tri_first, it->tri_count, 77, t13_on_batch, &st, &err);
+    test_assert_ok(rc, &err, "gltf_doc_primitive_iterate_triangle_range");
+    TEST_ASSERT_EQUAL_UINT32(0u, st.mismatches);
+    TEST_ASSERT_EQUAL_UINT32(it->tri_first + it->tri_count, st.next);
+    covered[it->primitive_index] += it->tri_count;
+  }
+  TEST_ASSERT_EQUAL_UINT32(T13_N / 3u, covered[0]);
+  TEST_ASSERT_EQUAL_UINT32(T13_N - 2u, covered[1]);
+  TEST_ASSERT_EQUAL_UINT32(T13_N - 2u, covered[3]);
+
+  // Per-primitive split and range validation.
+  rc = gltf_doc_primitive_triangle_work_items(g_doc, 1, 1000, items, 24, &n_items, &err);
+  test_assert_ok(rc, &err, "gltf_doc_primitive_triangle_work_items");
+  TEST_ASSERT_EQUAL_UINT32(3u, n_items);
+  TEST_ASSERT_EQUAL_UINT32(700u, items[0].tri_count);
+  TEST_ASSERT_EQUAL_UINT32(1399u, items[2].tri_first);
+  TEST_ASSERT_EQUAL_UINT32(699u, items[2].tri_count);
+
+  t13_batch_state st = { 1, 0, 0, 0 };
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID,
+                        gltf_doc_primitive_iterate_triangle_range(
+                          g_doc, 1, 2000, 200, 0, t13_on_batch, &st, &err));
+
+  free(glb);
+}
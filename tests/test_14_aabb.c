@@ -0,0 +1,213 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern gltf_doc* g_doc;
+
+#define T14_COUNT 37u
+#define T14_BIN_SIZE 1224u
+
+// Accessors:
+//   0 F32 VEC3 with exact min/max       4 U16 VEC3 packed (6-byte elements, ends the buffer)
+//   1 I16 normalized VEC3, stride 8     5 F32 VEC3 with deliberately wrong min/max
+//   2 U8 VEC3, stride 4                 6 U8 normalized VEC3 with raw min/max
+//   3 I8 normalized VEC3 packed
+// Scene: node 0 (translation 10,0,0) -> node 1 (scale 2, mesh 0); node 2 (mesh 0) is not in the scene.
+static const char* k_t14_json =
+  "{"
+  "\"asset\":{\"version\":\"2.0\"},"
+  "\"buffers\":[{\"byteLength\":1224}],"
+  "\"bufferViews\":["
+    "{\"buffer\":0,\"byteOffset\":0,\"byteLength\":444},"
+    "{\"buffer\":0,\"byteOffset\":444,\"byteLength\":294,\"byteStride\":8},"
+    "{\"buffer\":0,\"byteOffset\":740,\"byteLength\":147,\"byteStride\":4},"
+    "{\"buffer\":0,\"byteOffset\":888,\"byteLength\":111},"
+    "{\"buffer\":0,\"byteOffset\":1000,\"byteLength\":222}"
+  "],"
+  "\"accessors\":["
+    "{\"bufferView\":0,\"componentType\":5126,\"count\":37,\"type\":\"VEC3\","
+     "\"min\":[-9,-35,3],\"max\":[9,1,48]},"
+    "{\"bufferView\":1,\"componentType\":5122,\"normalized\":true,\"count\":37,\"type\":\"VEC3\"},"
+    "{\"bufferView\":2,\"componentType\":5121,\"count\":37,\"type\":\"VEC3\"},"
+    "{\"bufferView\":3,\"componentType\":5120,\"normalized\":true,\"count\":37,\"type\":\"VEC3\"},"
+    "{\"bufferView\":4,\"componentType\":5123,\"count\":37,\"type\":\"VEC3\"},"
+    "{\"bufferView\":0,\"componentType\":5126,\"count\":37,\"type\":\"VEC3\","
+     "\"min\":[-100,-100,-100],\"max\":[100,100,100]},"
+    "{\"bufferView\":2,\"componentType\":5121,\"normalized\":true,\"count\":37,\"type\":\"VEC3\","
+     "\"min\":[0,0,0],\"max\":[255,51,255]}"
+  "],"
+  "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0}}]}],"
+  "\"nodes\":["
+    "{\"children\":[1],\"translation\":[10,0,0]},"
+    "{\"mesh\":0,\"scale\":[2,2,2]},"
+    "{\"mesh\":0}"
+  "],"
+  "\"scenes\":[{\"nodes\":[0]}],"
+  "\"scene\":0"
+  "}";
+
+static uint8_t* t14_load(void) {
+  static uint8_t bin[T14_BIN_SIZE];
+  uint32_t seed = 4242u;
+  for (uint32_t i = 0; i < T14_BIN_SIZE; i++) {
+    seed = seed * 1664525u + 1013904223u;
+    bin[i] = (uint8_t)(seed >> 24u);
+  }
+  for (uint32_t e = 0; e < T14_COUNT; e++) {
+    const float v[3] = { (float)e * 0.5f - 9.0f, 1.0f - (float)e, (float)e * 1.25f + 3.0f };
+    memcpy(bin + e * 12u, v, sizeof v);
+  }
+  // Signed MIN values (decode to -1.0f) in the normalized accessors.
+  bin[444u + 7u * 8u + 2u] = 0x00u;
+  bin[444u + 7u * 8u + 3u] = 0x80u;
+  bin[888u + 5u * 3u + 1u] = 0x80u;
+
+  size_t size = 0;
+  uint8_t* glb = test_build_glb(k_t14_json, bin, T14_BIN_SIZE, &size);
+  gltf_error err = {0};
+  gltf_result rc = gltf_load_glb_bytes(glb, size, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_glb_bytes");
+  return glb;
+}
+
+void test_14_accessor_aabb_all_encodings(void) {
+  uint8_t* glb = t14_load();
+
+  for (uint32_t acc = 0; acc < 5u; acc++) {
+    float lo[3] = { INFINITY, INFINITY, INFINITY };
+    float hi[3] = { -INFINITY, -INFINITY, -INFINITY };
+    gltf_error err = {0};
+    for (uint32_t e = 0; e < T14_COUNT; e++) {
+      float v[16];
+      test_assert_ok(gltf_accessor_read_f32(g_doc, acc, e, v, 16, &err), &err, "read_f32");
+      for (uint32_t c = 0; c < 3u; c++) {
+        if (v[c] < lo[c]) lo[c] = v[c];
+        if (v[c] > hi[c]) hi[c] = v[c];
+      }
+    }
+
+    float amin[3], amax[3];
+    gltf_result rc = gltf_accessor_aabb3(g_doc, acc, GLTF_AABB_DEFAULT, amin, amax, &err);
+    test_assert_ok(rc, &err, "gltf_accessor_aabb3");
+    TEST_ASSERT_EQUAL_MEMORY(lo, amin, sizeof lo);
+    TEST_ASSERT_EQUAL_MEMORY(hi, amax, sizeof hi);
+  }
+
+  float amin[3], amax[3];
+  gltf_error err = {0};
+  TEST_ASSERT_EQUAL_INT(GLTF_OK, gltf_accessor_aabb3(g_doc, 1, 0, amin, amax, &err));
+  TEST_ASSERT_EQUAL_FLOAT(-1.0f, amin[1]);
+
+  // Legacy entry point shares the implementation.
+  TEST_ASSERT_EQUAL_INT(GLTF_OK, gltf_compute_aabb_pos3_f32_span(g_doc, 0, amin, amax, &err));
+  TEST_ASSERT_EQUAL_FLOAT(-9.0f, amin[0]);
+  TEST_ASSERT_EQUAL_FLOAT(48.0f, amax[2]);
+
+  free(glb);
+}
+
+void test_14_accessor_aabb_uses_bounds(void) {
+  uint8_t* glb = t14_load();
+  float amin[3], amax[3];
+  gltf_error err = {0};
+
+  // Scanning ignores accessor.min/max ...
+  TEST_ASSERT_EQUAL_INT(GLTF_OK, gltf_accessor_aabb3(g_doc, 5, GLTF_AABB_DEFAULT, amin, amax, &err));
+  TEST_ASSERT_EQUAL_FLOAT(-9.0f, amin[0]);
+  TEST_ASSERT_EQUAL_FLOAT(1.0f, amax[1]);
+
+  // ... the flag trusts them.
+  TEST_ASSERT_EQUAL_INT(GLTF_OK,
+                        gltf_accessor_aabb3(g_doc, 5, GLTF_AABB_USE_ACCESSOR_BOUNDS, amin, amax, &err));
+  TEST_ASSERT_EQUAL_FLOAT(-100.0f, amin[0]);
+  TEST_ASSERT_EQUAL_FLOAT(100.0f, amax[2]);
+
+  // Normalized accessors report normalized bounds.
+  TEST_ASSERT_EQUAL_INT(GLTF_OK,
+                        gltf_accessor_aabb3(g_doc, 6, GLTF_AABB_USE_ACCESSOR_BOUNDS, amin, amax, &err));
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, amin[0]);
+  TEST_ASSERT_EQUAL_FLOAT(1.0f, amax[0]);
+  TEST_ASSERT_EQUAL_FLOAT(51.0f / 255.0f, amax[1]);
+
+  // Accessors without bounds fall back to scanning.
+  float smin[3], smax[3];
+  TEST_ASSERT_EQUAL_INT(GLTF_OK,
+                        gltf_accessor_aabb3(g_doc, 2, GLTF_AABB_USE_ACCESSOR_BOUNDS, amin, amax, &err));
+  TEST_ASSERT_EQUAL_INT(GLTF_OK, gltf_accessor_aabb3(g_doc, 2, GLTF_AABB_DEFAULT, smin, smax, &err));
+  TEST_ASSERT_EQUAL_MEMORY(smin, amin, sizeof smin);
+  TEST_ASSERT_EQUAL_MEMORY(smax, amax, sizeof smax);
+  free(glb);
+  gltf_free(g_doc);
+  g_doc = NULL;
+
+  // Malformed bounds are ignored (they only feed this fast path): the load
+  // succeeds and the accessor is scanned instead.
+  const float bin[6] = { -1.0f, 2.0f, 3.0f, 4.0f, -5.0f, 6.0f };
+  static const char* const k_bad[] = {
+    "\"min\":[0,0],\"max\":[1,1]",
+    "\"min\":[0,0,\"x\"],\"max\":[1,1,1]",
+    "\"min\":7,\"max\":[1,1,1]",
+  };
+  for (uint32_t k = 0; k < 3u; k++) {
+    char json[512];
+    (void)snprintf(json, sizeof json,
+                   "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":24}],"
+                   "\"bufferViews\":[{\"buffer\":0,\"byteLength\":24}],"
+                   "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":2,"
+                   "\"type\":\"VEC3\",%s}]}",
+                   k_bad[k]);
+    size_t size = 0;
+    glb = test_build_glb(json, bin, sizeof bin, &size);
+    test_assert_ok(gltf_load_glb_bytes(glb, size, &g_doc, &err), &err, "gltf_load_glb_bytes(bad bounds)");
+    TEST_ASSERT_EQUAL_INT(GLTF_OK,
+                          gltf_accessor_aabb3(g_doc, 0, GLTF_AABB_USE_ACCESSOR_BOUNDS, amin, amax, &err));
+    TEST_ASSERT_EQUAL_FLOAT(-1.0f, amin[0]);
+    TEST_ASSERT_EQUAL_FLOAT(-5.0f, amin[1]);
+    TEST_ASSERT_EQUAL_FLOAT(6.0f, amax[2]);
+    free(glb);
+    gltf_free(g_doc);
+    g_doc = NULL;
+  }
+}
+
+void test_14_node_world_aabbs(void) {
+  uint8_t* glb = t14_load();
+  gltf_error err = {0};
+
+  float mmin[3], mmax[3];
+  test_assert_ok(gltf_mesh_aabb(g_doc, 0, GLTF_AABB_USE_ACCESSOR_BOUNDS, mmin, mmax, &err), &err,
+                 "gltf_mesh_aabb");
+  TEST_ASSERT_EQUAL_FLOAT(-35.0f, mmin[1]);
+
+  gltf_world_cache* cache = NULL;
+  test_assert_ok(gltf_world_cache_create(g_doc, &cache, &err), &err, "gltf_world_cache_create");
+  test_assert_ok(gltf_compute_world_matrices(g_doc, 0, cache, &err), &err, "compute_world");
+
+  float wmin[3 * 3], wmax[3 * 3];
+  uint8_t has[3];
+  gltf_result rc = gltf_compute_node_world_aabbs(g_doc, cache, GLTF_AABB_DEFAULT, wmin, wmax, has, &err);
+  test_assert_ok(rc, &err, "gltf_compute_node_world_aabbs");
+
+  TEST_ASSERT_EQUAL_UINT8(0, has[0]); // no mesh
+  TEST_ASSERT_EQUAL_UINT8(1, has[1]);
+  TEST_ASSERT_EQUAL_UINT8(0, has[2]); // not reached by scene 0
+
+  // world = translate(10,0,0) * scale(2)
+  TEST_ASSERT_EQUAL_FLOAT(10.0f + 2.0f * -9.0f, wmin[3 + 0]);
+  TEST_ASSERT_EQUAL_FLOAT(10.0f + 2.0f * 9.0f, wmax[3 + 0]);
+  TEST_ASSERT_EQUAL_FLOAT(2.0f * -35.0f, wmin[3 + 1]);
+  TEST_ASSERT_EQUAL_FLOAT(2.0f * 1.0f, wmax[3 + 1]);
+  TEST_ASSERT_EQUAL_FLOAT(2.0f * 3.0f, wmin[3 + 2]);
+  TEST_ASSERT_EQUAL_FLOAT(2.0f * 48.0f, wmax[3 + 2]);
+  TEST_ASSERT_TRUE(wmin[0] > wmax[0]); // empty box
+
+  gltf_world_cache_free(cache);
+  free(glb);
+}
@@ -0,0 +1,186 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern gltf_doc* g_doc;
+
+static uint8_t* t15_load(const char* json) {
+  size_t size = 0;
+  uint8_t* glb = test_build_glb(json, NULL, 0, &size);
+  gltf_error err = {0};
+  gltf_result rc = gltf_load_glb_bytes(glb, size, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_glb_bytes");
+  return glb;
+}
+
+// Scene 0: 0 -> {1, 2}, 2 -> 3.  Scene 1: 2 (as a root) and 4; node 5 is unreachable.
+static const char* k_t15_tree_json =
+  "{"
+  "\"asset\":{\"version\":\"2.0\"},"
+  "\"nodes\":["
+    "{\"children\":[1,2],\"translation\":[1,0,0]},"
+    "{\"translation\":[0,2,0]},"
+    "{\"children\":[3],\"translation\":[0,0,3]},"
+    "{\"scale\":[2,2,2],\"translation\":[4,0,0]},"
+    "{\"translation\":[5,0,0]},"
+    "{\"translation\":[6,0,0]}"
+  "],"
+  "\"scenes\":[{\"nodes\":[0]},{\"nodes\":[2,4,2]}]"
+  "}";
+
+void test_15_world_order_tree_and_scene_switch(void) {
+  uint8_t* glb = t15_load(k_t15_tree_json);
+  gltf_error err = {0};
+
+  gltf_world_cache* cache = NULL;
+  test_assert_ok(gltf_world_cache_create(g_doc, &cache, &err), &err, "gltf_world_cache_create");
+
+  float m[16];
+  // Evaluate scene 0 twice (second run reuses the flattened order), then 1, then 0 again.
+  const uint32_t scenes[4] = { 0, 0, 1, 0 };
+  for (uint32_t run = 0; run < 4u; run++) {
+    test_assert_ok(gltf_compute_world_matrices(g_doc, scenes[run], cache, &err), &err, "compute");
+
+    if (scenes[run] == 0u) {
+      TEST_ASSERT_EQUAL_INT(1, gltf_world_matrix(g_doc, cache, 3, m));
+      TEST_ASSERT_EQUAL_FLOAT(5.0f, m[12]); // 1 + 4
+      TEST_ASSERT_EQUAL_FLOAT(3.0f, m[14]);
+      TEST_ASSERT_EQUAL_FLOAT(2.0f, m[0]);
+      TEST_ASSERT_EQUAL_INT(1, gltf_world_matrix(g_doc, cache, 1, m));
+      TEST_ASSERT_EQUAL_FLOAT(1.0f, m[12]);
+      TEST_ASSERT_EQUAL_FLOAT(2.0f, m[13]);
+      TEST_ASSERT_EQUAL_INT(0, gltf_world_matrix(g_doc, cache, 4, m));
+    } else {
+      // Node 2 is a root here: its world is its local matrix.
+      TEST_ASSERT_EQUAL_INT(1, gltf_world_matrix(g_doc, cache, 2, m));
+      TEST_ASSERT_EQUAL_FLOAT(0.0f, m[12]);
+      TEST_ASSERT_EQUAL_FLOAT(3.0f, m[14]);
+      TEST_ASSERT_EQUAL_INT(1, gltf_world_matrix(g_doc, cache, 3, m));
+      TEST_ASSERT_EQUAL_FLOAT(4.0f, m[12]);
+      TEST_ASSERT_EQUAL_INT(1, gltf_world_matrix(g_doc, cache, 4, m));
+      TEST_ASSERT_EQUAL_INT(0, gltf_world_matrix(g_doc, cache, 0, m));
+      TEST_ASSERT_EQUAL_INT(0, gltf_world_matrix(g_doc, cache, 1, m));
+    }
+    TEST_ASSERT_EQUAL_INT(0, gltf_world_matrix(g_doc, cache, 5, m));
+  }
+
+  gltf_world_cache_free(cache);
+  free(glb);
+}
+
+void test_15_world_order_rejects_cycles(void) {
+  static const char* k_cycle_json =
+    "{"
+    "\"asset\":{\"version\":\"2.0\"},"
+    "\"nodes\":[{\"children\":[1]},{\"children\":[2]},{\"children\":[0]}],"
+    "\"scenes\":[{\"nodes\":[0]}]"
+    "}";
+  uint8_t* glb = t15_load(k_cycle_json);
+  gltf_error err = {0};
+
+  gltf_world_cache* cache = NULL;
+  test_assert_ok(gltf_world_cache_create(g_doc, &cache, &err), &err, "gltf_world_cache_create");
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_compute_world_matrices(g_doc, 0, cache, &err));
+
+  float m[16];
+  TEST_ASSERT_EQUAL_INT(0, gltf_world_matrix(g_doc, cache, 0, m));
+  // The failure is sticky: the order is rebuilt (and rejected) on the next call.
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_compute_world_matrices(g_doc, 0, cache, &err));
+
+  gltf_world_cache_free(cache);
+  free(glb);
+
+  // Cycles reached through a second parent (1 <-> 2 under 0) or a self loop;
+  // a child shared by two parents without a cycle is still evaluated.
+  static const char* const k_graphs[3] = {
+    "{\"asset\":{\"version\":\"2.0\"},"
+    "\"nodes\":[{\"children\":[1,2]},{\"children\":[2]},{\"children\":[1]}],"
+    "\"scenes\":[{\"nodes\":[0]}]}",
+    "{\"asset\":{\"version\":\"2.0\"},"
+    "\"nodes\":[{\"children\":[1]},{\"children\":[1]}],"
+    "\"scenes\":[{\"nodes\":[0]}]}",
+    "{\"asset\":{\"version\":\"2.0\"},"
+    "\"nodes\":[{\"children\":[1,2]},{\"children\":[2]},{\"translation\":[0,0,5]}],"
+    "\"scenes\":[{\"nodes\":[0]}]}",
+  };
+  for (uint32_t g = 0; g < 3u; g++) {
+    gltf_free(g_doc);
+    g_doc = NULL;
+    glb = t15_load(k_graphs[g]);
+    test_assert_ok(gltf_world_cache_create(g_doc, &cache, &err), &err, "gltf_world_cache_create");
+    if (g < 2u) {
+      TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_compute_world_matrices(g_doc, 0, cache, &err));
+      TEST_ASSERT_EQUAL_INT(0, gltf_world_matrix(g_doc, cache, 1, m));
+    } else {
+      test_assert_ok(gltf_compute_world_matrices(g_doc, 0, cache, &err), &err, "compute(shared child)");
+      TEST_ASSERT_EQUAL_INT(1, gltf_world_matrix(g_doc, cache, 2, m));
+      TEST_ASSERT_EQUAL_FLOAT(5.0f, m[14]);
+    }
+    gltf_world_cache_free(cache);
+    free(glb);
+  }
+}
+
+void test_15_world_dirty_subtree_update(void) {
+  uint8_t* glb = t15_load(k_t15_tree_json);
+  gltf_error err = {0};
+
+  gltf_world_cache* cache = NULL;
+  test_assert_ok(gltf_world_cache_create(g_doc, &cache, &err), &err, "gltf_world_cache_create");
+
+  // Not computed yet.
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_update_world_matrices(g_doc, cache, &err));
+  test_assert_ok(gltf_compute_world_matrices(g_doc, 0, cache, &err), &err, "compute");
+  test_assert_ok(gltf_update_world_matrices(g_doc, cache, &err), &err, "update(no-op)");
+
+  // Move node 2 (parent of 3) and override node 0 with a matrix; node 4 is
+  // outside scene 0 and is dropped by the update.
+  const float t2[3] = { 0.0f, 0.0f, 7.0f };
+  test_assert_ok(gltf_world_cache_set_local_trs(g_doc, cache, 2, t2, NULL, NULL, &err), &err, "set_trs");
+  test_assert_ok(gltf_world_cache_set_local_trs(g_doc, cache, 4, t2, NULL, NULL, &err), &err, "set_trs");
+  float m0[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 10, 0, 1 };
+  test_assert_ok(gltf_world_cache_set_local_matrix(g_doc, cache, 0, m0, &err), &err, "set_matrix");
+
+  float m[16];
+  TEST_ASSERT_EQUAL_INT(1, gltf_world_matrix(g_doc, cache, 3, m));
+  TEST_ASSERT_EQUAL_FLOAT(3.0f, m[14]); // unchanged until the update
+
+  test_assert_ok(gltf_update_world_matrices(g_doc, cache, &err), &err, "update");
+  TEST_ASSERT_EQUAL_INT(1, gltf_world_matrix(g_doc, cache, 3, m));
+  TEST_ASSERT_EQUAL_FLOAT(4.0f, m[12]);
+  TEST_ASSERT_EQUAL_FLOAT(10.0f, m[13]);
+  TEST_ASSERT_EQUAL_FLOAT(7.0f, m[14]);
+  TEST_ASSERT_EQUAL_INT(1, gltf_world_matrix(g_doc, cache, 1, m));
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, m[12]);
+  TEST_ASSERT_EQUAL_FLOAT(12.0f, m[13]);
+
+  // Incremental and full evaluation agree.
+  float inc[6][16], full[6][16];
+  for (uint32_t n = 0; n < 4u; n++) TEST_ASSERT_EQUAL_INT(1, gltf_world_matrix(g_doc, cache, n, inc[n]));
+  test_assert_ok(gltf_compute_world_matrices(g_doc, 0, cache, &err), &err, "compute");
+  for (uint32_t n = 0; n < 4u; n++) {
+    TEST_ASSERT_EQUAL_INT(1, gltf_world_matrix(g_doc, cache, n, full[n]));
+    TEST_ASSERT_EQUAL_MEMORY(full[n], inc[n], sizeof full[n]);
+  }
+
+  // Overrides carry over to other scenes; clearing restores the document.
+  test_assert_ok(gltf_compute_world_matrices(g_doc, 1, cache, &err), &err, "compute(scene 1)");
+  TEST_ASSERT_EQUAL_INT(1, gltf_world_matrix(g_doc, cache, 4, m));
+  TEST_ASSERT_EQUAL_FLOAT(7.0f, m[14]);
+  test_assert_ok(gltf_world_cache_clear_local(g_doc, cache, 2, &err), &err, "clear_local");
+  test_assert_ok(gltf_update_world_matrices(g_doc, cache, &err), &err, "update");
+  TEST_ASSERT_EQUAL_INT(1, gltf_world_matrix(g_doc, cache, 3, m));
+  TEST_ASSERT_EQUAL_FLOAT(3.0f, m[14]);
+
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID,
+                        gltf_world_cache_set_local_trs(g_doc, cache, 99, t2, NULL, NULL, &err));
+
+  gltf_world_cache_free(cache);
+  free(glb);
+}
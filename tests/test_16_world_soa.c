@@ -0,0 +1,100 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern gltf_doc* g_doc;
+
+// 7 nodes (not a multiple of 4): rotated/scaled TRS chain, a matrix node in the
+// middle and a leaf below it. 0 -> {1, 4}, 1 -> 2, 2 -> 3, 4 -> {5, 6}.
+static const char* k_t16_json =
+  "{"
+  "\"asset\":{\"version\":\"2.0\"},"
+  "\"nodes\":["
+    "{\"children\":[1,4],\"translation\":[1,2,3],\"rotation\":[0,0.7071068,0,0.7071068]},"
+    "{\"children\":[2],\"scale\":[2,1,0.5],\"rotation\":[0.1825742,0.3651484,0.5477226,0.7302967]},"
+    "{\"children\":[3],\"matrix\":[0,1,0,0, -1,0,0,0, 0,0,1,0, 3,4,5,1]},"
+    "{\"translation\":[0,1,0]},"
+    "{\"children\":[5,6],\"translation\":[-2,0,0],\"scale\":[3,3,3]},"
+    "{\"rotation\":[0.5,0.5,0.5,0.5]},"
+    "{\"translation\":[0.25,0.5,0.75]}"
+  "],"
+  "\"scenes\":[{\"nodes\":[0]}]"
+  "}";
+
+static void t16_assert_same(gltf_world_cache* a, gltf_world_cache* b) {
+  for (uint32_t node = 0; node < gltf_doc_node_count(g_doc); node++) {
+    float ma[16], mb[16];
+    TEST_ASSERT_EQUAL_INT(1, gltf_world_matrix(g_doc, a, node, ma));
+    TEST_ASSERT_EQUAL_INT(1, gltf_world_matrix(g_doc, b, node, mb));
+    for (int i = 0; i < 16; i++) TEST_ASSERT_FLOAT_WITHIN(1e-5f, ma[i], mb[i]);
+  }
+}
+
+void test_16_world_soa_matches_default(void) {
+  size_t size = 0;
+  uint8_t* glb = test_build_glb(k_t16_json, NULL, 0, &size);
+  gltf_error err = {0};
+  test_assert_ok(gltf_load_glb_bytes(glb, size, &g_doc, &err), &err, "gltf_load_glb_bytes");
+
+  gltf_world_cache* ref = NULL;
+  gltf_world_cache* soa = NULL;
+  test_assert_ok(gltf_world_cache_create(g_doc, &ref, &err), &err, "create");
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID,
+                        gltf_world_cache_create_ex(g_doc, 1u << 7, &soa, &err));
+  TEST_ASSERT_NULL(soa);
+  test_assert_ok(gltf_world_cache_create_ex(g_doc, GLTF_WORLD_CACHE_SOA, &soa, &err), &err,
+                 "create_ex");
+
+  test_assert_ok(gltf_compute_world_matrices(g_doc, 0, ref, &err), &err, "compute(ref)");
+  test_assert_ok(gltf_compute_world_matrices(g_doc, 0, soa, &err), &err, "compute(soa)");
+  t16_assert_same(ref, soa);
+
+  // The matrix node (2) still uses its document matrix: leaf 3 sits at 2's
+  // origin plus the rotated (0,1,0).
+  float m[16];
+  TEST_ASSERT_EQUAL_INT(1, gltf_world_matrix(g_doc, soa, 2, m));
+  float leaf[16];
+  TEST_ASSERT_EQUAL_INT(1, gltf_world_matrix(g_doc, soa, 3, leaf));
+  TEST_ASSERT_FLOAT_WITHIN(1e-5f, m[12] + m[4], leaf[12]);
+
+  // Same overrides on both caches, through incremental and full evaluation.
+  const float t[3] = { 0.5f, -1.0f, 2.0f };
+  const float r[4] = { 0.0f, 0.0f, 0.3826834f, 0.9238795f };
+  const float m16[16] = { 1,0,0,0, 0,1,0,0, 0,0,1,0, 7,8,9,1 };
+  for (int pass = 0; pass < 2; pass++) {
+    gltf_world_cache* c = pass ? soa : ref;
+    test_assert_ok(gltf_world_cache_set_local_trs(g_doc, c, 2, t, r, NULL, &err), &err, "trs(2)");
+    test_assert_ok(gltf_world_cache_set_local_trs(g_doc, c, 4, NULL, NULL, t, &err), &err, "trs(4)");
+    test_assert_ok(gltf_world_cache_set_local_matrix(g_doc, c, 5, m16, &err), &err, "matrix(5)");
+    test_assert_ok(gltf_update_world_matrices(g_doc, c, &err), &err, "update");
+  }
+  t16_assert_same(ref, soa);
+
+  test_assert_ok(gltf_compute_world_matrices(g_doc, 0, soa, &err), &err, "compute(soa)");
+  t16_assert_same(ref, soa);
+
+  // A TRS override replacing a matrix override, then clearing restores the document.
+  for (int pass = 0; pass < 2; pass++) {
+    gltf_world_cache* c = pass ? soa : ref;
+    test_assert_ok(gltf_world_cache_set_local_trs(g_doc, c, 5, t, NULL, NULL, &err), &err, "trs(5)");
+    test_assert_ok(gltf_world_cache_clear_local(g_doc, c, 2, &err), &err, "clear(2)");
+    test_assert_ok(gltf_update_world_matrices(g_doc, c, &err), &err, "update");
+  }
+  t16_assert_same(ref, soa);
+  TEST_ASSERT_EQUAL_INT(1, gltf_world_matrix(g_doc, soa, 2, leaf));
+  TEST_ASSERT_FLOAT_WITHIN(1e-5f, m[12], leaf[12]);
+
+  test_assert_ok(gltf_compute_world_matrices(g_doc, 0, soa, &err), &err, "compute(soa)");
+  test_assert_ok(gltf_compute_world_matrices(g_doc, 0, ref, &err), &err, "compute(ref)");
+  t16_assert_same(ref, soa);
+
+  gltf_world_cache_free(soa);
+  gltf_world_cache_free(ref);
+  free(glb);
+}
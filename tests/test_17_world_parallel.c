@@ -0,0 +1,117 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern gltf_doc* g_doc;
+
+#define T17_ROOTS 700u
+#define T17_NODES (T17_ROOTS * 3u)
+
+// T17_ROOTS roots r, each with a child c and grandchild g: levels of 700 nodes.
+static char* t17_build_json(void) {
+  const size_t cap = (size_t)T17_NODES * 120u + 4096u;
+  char* json = (char*)malloc(cap);
+  TEST_ASSERT_NOT_NULL(json);
+  size_t n = (size_t)snprintf(json, cap, "{\"asset\":{\"version\":\"2.0\"},\"nodes\":[");
+  for (uint32_t r = 0; r < T17_ROOTS; r++) {
+    const uint32_t base = r * 3u;
+    const float f = (float)r * 0.01f;
+    n += (size_t)snprintf(json + n, cap - n,
+                          "%s{\"children\":[%u],\"translation\":[%g,0,1],\"rotation\":[0,0.6,0,0.8]},"
+                          "{\"children\":[%u],\"scale\":[2,%g,1]},"
+                          "{\"translation\":[1,2,3],\"rotation\":[0.6,0,0,0.8]}",
+                          r ? "," : "", base + 1u, (double)f, base + 2u, (double)(1.0f + f));
+  }
+  n += (size_t)snprintf(json + n, cap - n, "],\"scenes\":[{\"nodes\":[");
+  for (uint32_t r = 0; r < T17_ROOTS; r++) {
+    n += (size_t)snprintf(json + n, cap - n, "%s%u", r ? "," : "", r * 3u);
+  }
+  n += (size_t)snprintf(json + n, cap - n, "]}]}");
+  TEST_ASSERT_TRUE(n < cap);
+  return json;
+}
+
+// Runs tasks serially in reverse order: any order must give the same result.
+static void t17_reverse_dispatch(void* user, uint32_t task_count, gltf_task_fn task, void* task_user) {
+  uint32_t* calls = (uint32_t*)user;
+  (*calls)++;
+  for (uint32_t i = task_count; i-- > 0;) task(task_user, i);
+}
+
+static void t17_count_task(void* user, uint32_t task_index) {
+  uint32_t* hits = (uint32_t*)user;
+  hits[task_index] += task_index + 1u;
+}
+
+void test_17_thread_pool_runs_every_task_once(void) {
+  gltf_error err = {0};
+  gltf_thread_pool* pool = NULL;
+  test_assert_ok(gltf_thread_pool_create(3, &pool, &err), &err, "gltf_thread_pool_create");
+
+  static uint32_t hits[1000];
+  for (uint32_t run = 0; run < 20u; run++) {
+    memset(hits, 0, sizeof(hits));
+    const uint32_t count = 1u + run * 49u;
+    gltf_thread_pool_dispatch(pool, count, t17_count_task, hits);
+    for (uint32_t i = 0; i < 1000u; i++) {
+      TEST_ASSERT_EQUAL_UINT32(i < count ? i + 1u : 0u, hits[i]);
+    }
+  }
+  gltf_thread_pool_free(pool);
+
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_thread_pool_create(1, NULL, &err));
+}
+
+void test_17_world_parallel_matches_serial(void) {
+  char* json = t17_build_json();
+  size_t size = 0;
+  uint8_t* glb = test_build_glb(json, NULL, 0, &size);
+  free(json);
+  gltf_error err = {0};
+  test_assert_ok(gltf_load_glb_bytes(glb, size, &g_doc, &err), &err, "gltf_load_glb_bytes");
+
+  gltf_thread_pool* pool = NULL;
+  test_assert_ok(gltf_thread_pool_create(3, &pool, &err), &err, "gltf_thread_pool_create");
+
+  for (uint32_t flags = 0; flags <= GLTF_WORLD_CACHE_SOA; flags++) {
+    gltf_world_cache* ref = NULL;
+    gltf_world_cache* par = NULL;
+    test_assert_ok(gltf_world_cache_create_ex(g_doc, flags, &ref, &err), &err, "create(ref)");
+    test_assert_ok(gltf_world_cache_create_ex(g_doc, flags, &par, &err), &err, "create(par)");
+    test_assert_ok(gltf_compute_world_matrices(g_doc, 0, ref, &err), &err, "compute");
+
+    uint32_t calls = 0;
+    for (int run = 0; run < 3; run++) {
+      if (run == 0) {
+        test_assert_ok(gltf_compute_world_matrices_parallel(g_doc, 0, par, t17_reverse_dispatch,
+                                                            &calls, &err),
+                       &err, "compute_parallel(reverse)");
+      } else {
+        test_assert_ok(gltf_compute_world_matrices_parallel(g_doc, 0, par, gltf_thread_pool_dispatch,
+                                                            pool, &err),
+                       &err, "compute_parallel(pool)");
+      }
+      for (uint32_t node = 0; node < T17_NODES; node++) {
+        float a[16], b[16];
+        TEST_ASSERT_EQUAL_INT(1, gltf_world_matrix(g_doc, ref, node, a));
+        TEST_ASSERT_EQUAL_INT(1, gltf_world_matrix(g_doc, par, node, b));
+        TEST_ASSERT_EQUAL_MEMORY(a, b, sizeof(a));
+      }
+    }
+    // Three 700-node levels are split; SoA adds the local composition pass.
+    TEST_ASSERT_EQUAL_UINT32(flags ? 4u : 3u, calls);
+
+    gltf_world_cache_free(par);
+    gltf_world_cache_free(ref);
+  }
+
+  gltf_thread_pool_free(pool);
+  free(glb);
+}
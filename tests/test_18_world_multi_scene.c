@@ -0,0 +1,97 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern gltf_doc* g_doc;
+
+// Scene 0: 0 -> 1.  Scene 1: 0 -> 1 and 2 -> 3 (shares node 0's subtree).
+// Scene 2 uses node 1 as a root (non-conforming, but accepted).
+static const char* k_t18_json =
+  "{"
+  "\"asset\":{\"version\":\"2.0\"},"
+  "\"nodes\":["
+    "{\"children\":[1],\"translation\":[1,0,0]},"
+    "{\"translation\":[0,2,0]},"
+    "{\"children\":[3],\"translation\":[0,0,3]},"
+    "{\"scale\":[2,2,2],\"translation\":[4,0,0]}"
+  "],"
+  "\"scenes\":[{\"nodes\":[0]},{\"nodes\":[0,2]},{\"nodes\":[1]}]"
+  "}";
+
+// Checks every node of the scene against a fresh single-use cache.
+static void t18_assert_scene(gltf_world_cache* cache, uint32_t scene, const float* t0) {
+  gltf_error err = {0};
+  gltf_world_cache* ref = NULL;
+  test_assert_ok(gltf_world_cache_create(g_doc, &ref, &err), &err, "create(ref)");
+  if (t0) {
+    test_assert_ok(gltf_world_cache_set_local_trs(g_doc, ref, 0, t0, NULL, NULL, &err), &err, "trs(ref)");
+  }
+  test_assert_ok(gltf_compute_world_matrices(g_doc, scene, ref, &err), &err, "compute(ref)");
+  for (uint32_t node = 0; node < 4u; node++) {
+    float a[16], b[16];
+    const int in_scene = gltf_world_matrix(g_doc, ref, node, a);
+    TEST_ASSERT_EQUAL_INT(in_scene, gltf_world_matrix(g_doc, cache, node, b));
+    if (in_scene) TEST_ASSERT_EQUAL_MEMORY(a, b, sizeof(a));
+  }
+  gltf_world_cache_free(ref);
+}
+
+void test_18_world_scene_switch_reuses_shared_nodes(void) {
+  size_t size = 0;
+  uint8_t* glb = test_build_glb(k_t18_json, NULL, 0, &size);
+  gltf_error err = {0};
+  test_assert_ok(gltf_load_glb_bytes(glb, size, &g_doc, &err), &err, "gltf_load_glb_bytes");
+
+  gltf_world_cache* cache = NULL;
+  test_assert_ok(gltf_world_cache_create(g_doc, &cache, &err), &err, "create");
+
+  // Alternate between the two LOD-style scenes.
+  const uint32_t scenes[5] = { 0, 1, 0, 1, 1 };
+  for (uint32_t i = 0; i < 5u; i++) {
+    test_assert_ok(gltf_compute_world_matrices(g_doc, scenes[i], cache, &err), &err, "compute");
+    t18_assert_scene(cache, scenes[i], NULL);
+  }
+
+  // An override on the shared root, applied while scene 1 is current, is
+  // visible in scene 0 without recomputing it.
+  const float t[3] = { -5.0f, 0.0f, 0.0f };
+  test_assert_ok(gltf_world_cache_set_local_trs(g_doc, cache, 0, t, NULL, NULL, &err), &err, "trs");
+  test_assert_ok(gltf_update_world_matrices(g_doc, cache, &err), &err, "update");
+  t18_assert_scene(cache, 1, t);
+  test_assert_ok(gltf_compute_world_matrices(g_doc, 0, cache, &err), &err, "compute(0)");
+  t18_assert_scene(cache, 0, t);
+
+  float m[16];
+  TEST_ASSERT_EQUAL_INT(1, gltf_world_matrix(g_doc, cache, 1, m));
+  TEST_ASSERT_EQUAL_FLOAT(-5.0f, m[12]);
+  TEST_ASSERT_EQUAL_FLOAT(2.0f, m[13]);
+  TEST_ASSERT_EQUAL_INT(0, gltf_world_matrix(g_doc, cache, 3, m));
+
+  // Scene 2 evaluates node 1 as a root; the other scenes must notice.
+  test_assert_ok(gltf_compute_world_matrices(g_doc, 2, cache, &err), &err, "compute(2)");
+  TEST_ASSERT_EQUAL_INT(1, gltf_world_matrix(g_doc, cache, 1, m));
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, m[12]);
+  TEST_ASSERT_EQUAL_INT(0, gltf_world_matrix(g_doc, cache, 0, m));
+  for (uint32_t s = 0; s < 2u; s++) {
+    test_assert_ok(gltf_compute_world_matrices(g_doc, s, cache, &err), &err, "compute");
+    t18_assert_scene(cache, s, t);
+  }
+
+  // Clearing the override while scene 2 is current.
+  test_assert_ok(gltf_compute_world_matrices(g_doc, 2, cache, &err), &err, "compute(2)");
+  test_assert_ok(gltf_world_cache_clear_local(g_doc, cache, 0, &err), &err, "clear");
+  test_assert_ok(gltf_update_world_matrices(g_doc, cache, &err), &err, "update");
+  for (uint32_t s = 0; s < 3u; s++) {
+    test_assert_ok(gltf_compute_world_matrices(g_doc, s, cache, &err), &err, "compute");
+    t18_assert_scene(cache, s, NULL);
+  }
+
+  gltf_world_cache_free(cache);
+  free(glb);
+}
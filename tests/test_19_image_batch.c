@@ -0,0 +1,53 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#ifndef GLTF_REPO_ROOT
+#error "GLTF_REPO_ROOT must be defined by the build system"
+#endif
+
+extern gltf_doc* g_doc;
+
+void test_19_image_decode_batch(void) {
+  gltf_error err = {0};
+  gltf_result rc = gltf_load_file(GLTF_REPO_ROOT "/tests/fixtures/06-datauri.gltf", &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_file");
+
+  gltf_thread_pool* pool = NULL;
+  test_assert_ok(gltf_thread_pool_create(2, &pool, &err), &err, "gltf_thread_pool_create");
+
+  // Same image several times plus one bad index.
+  const uint32_t indices[5] = { 0, 0, 7, 0, 0 };
+  gltf_image_decode_result results[5];
+  memset(results, 0, sizeof(results));
+
+  rc = gltf_image_decode_rgba8_batch(g_doc, indices, 5, results, gltf_thread_pool_dispatch, pool, &err);
+  gltf_thread_pool_free(pool);
+
+#if GLTF_ENABLE_IMAGES
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_RANGE, rc);
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_RANGE, results[2].result);
+  TEST_ASSERT_NULL(results[2].pixels.pixels);
+  for (uint32_t i = 0; i < 5u; i++) {
+    if (i == 2u) continue;
+    TEST_ASSERT_EQUAL_INT(GLTF_OK, results[i].result);
+    TEST_ASSERT_EQUAL_UINT32(1u, results[i].pixels.width);
+    TEST_ASSERT_EQUAL_UINT32(1u, results[i].pixels.height);
+    TEST_ASSERT_EQUAL_UINT8(255u, results[i].pixels.pixels[0]);
+    TEST_ASSERT_EQUAL_UINT8(255u, results[i].pixels.pixels[3]);
+    gltf_image_pixels_free(&results[i].pixels);
+  }
+#else
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_UNSUPPORTED, rc);
+  for (uint32_t i = 0; i < 5u; i++) TEST_ASSERT_NULL(results[i].pixels.pixels);
+#endif
+
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID,
+                        gltf_image_decode_rgba8_batch(g_doc, NULL, 1, results, NULL, NULL, &err));
+  TEST_ASSERT_EQUAL_INT(GLTF_OK, gltf_image_decode_rgba8_batch(g_doc, NULL, 0, NULL, NULL, NULL, &err));
+}
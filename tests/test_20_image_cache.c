@@ -0,0 +1,122 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#ifndef GLTF_REPO_ROOT
+#error "GLTF_REPO_ROOT must be defined by the build system"
+#endif
+
+extern gltf_doc* g_doc;
+
+#define T20_DATAURI GLTF_REPO_ROOT "/tests/fixtures/06-datauri.gltf"
+#define T20_MATERIALS GLTF_REPO_ROOT "/tests/fixtures/05-materials.gltf"
+
+void test_20_image_cache_shares_entries(void) {
+  gltf_error err = {0};
+  gltf_image_cache* cache = NULL;
+  test_assert_ok(gltf_image_cache_create(0, &cache, &err), &err, "gltf_image_cache_create");
+
+  gltf_doc* other = NULL;
+  test_assert_ok(gltf_load_file(T20_DATAURI, &g_doc, &err), &err, "gltf_load_file");
+  test_assert_ok(gltf_load_file(T20_DATAURI, &other, &err), &err, "gltf_load_file");
+
+  const gltf_image_pixels* a = NULL;
+  const gltf_image_pixels* b = NULL;
+  gltf_result rc = gltf_image_cache_acquire_rgba8(cache, g_doc, 0, &a, &err);
+
+#if GLTF_ENABLE_IMAGES
+  test_assert_ok(rc, &err, "gltf_image_cache_acquire_rgba8");
+  // Same data URI in another document hits the same entry.
+  test_assert_ok(gltf_image_cache_acquire_rgba8(cache, other, 0, &b, &err), &err, "acquire(other)");
+  TEST_ASSERT_EQUAL_PTR(a, b);
+  TEST_ASSERT_EQUAL_UINT32(1u, a->width);
+  TEST_ASSERT_EQUAL_UINT8(255u, a->pixels[3]);
+
+  // Entries outlive the document they were decoded from.
+  gltf_free(other);
+  other = NULL;
+
+  gltf_image_cache_stats st;
+  gltf_image_cache_get_stats(cache, &st);
+  TEST_ASSERT_EQUAL_UINT32(1u, st.entries);
+  TEST_ASSERT_EQUAL_UINT64(1u, st.misses);
+  TEST_ASSERT_EQUAL_UINT64(1u, st.hits);
+  TEST_ASSERT_EQUAL_UINT64(4u, st.bytes);
+  gltf_image_cache_release(cache, a);
+  gltf_image_cache_release(cache, b);
+
+  // URI images: keyed by resolved path, shared across documents.
+  gltf_free(g_doc);
+  g_doc = NULL;
+  test_assert_ok(gltf_load_file(T20_MATERIALS, &g_doc, &err), &err, "gltf_load_file");
+  test_assert_ok(gltf_load_file(T20_MATERIALS, &other, &err), &err, "gltf_load_file");
+  test_assert_ok(gltf_image_cache_acquire_rgba8(cache, g_doc, 0, &a, &err), &err, "acquire(uri)");
+  test_assert_ok(gltf_image_cache_acquire_rgba8(cache, other, 0, &b, &err), &err, "acquire(uri, other)");
+  TEST_ASSERT_EQUAL_PTR(a, b);
+  TEST_ASSERT_EQUAL_UINT32(a->width * 4u, a->stride_bytes);
+  gltf_image_cache_release(cache, a);
+  gltf_image_cache_release(cache, b);
+
+  gltf_image_cache_get_stats(cache, &st);
+  TEST_ASSERT_EQUAL_UINT32(2u, st.entries);
+  TEST_ASSERT_EQUAL_UINT64(2u, st.hits);
+#else
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_UNSUPPORTED, rc);
+  TEST_ASSERT_NULL(a);
+  (void)b;
+#endif
+
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_RANGE, gltf_image_cache_acquire_rgba8(cache, g_doc, 99, &a, &err));
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_image_cache_acquire_rgba8(NULL, g_doc, 0, &a, &err));
+
+  gltf_free(other);
+  gltf_image_cache_free(cache);
+}
+
+void test_20_image_cache_budget_eviction(void) {
+  gltf_error err = {0};
+  test_assert_ok(gltf_load_file(T20_DATAURI, &g_doc, &err), &err, "gltf_load_file");
+
+  gltf_image_cache* cache = NULL;
+  test_assert_ok(gltf_image_cache_create(1, &cache, &err), &err, "gltf_image_cache_create");
+
+#if GLTF_ENABLE_IMAGES
+  const gltf_image_pixels* p = NULL;
+  test_assert_ok(gltf_image_cache_acquire_rgba8(cache, g_doc, 0, &p, &err), &err, "acquire");
+
+  // Over budget but referenced: kept.
+  gltf_image_cache_stats st;
+  gltf_image_cache_get_stats(cache, &st);
+  TEST_ASSERT_EQUAL_UINT32(1u, st.entries);
+  TEST_ASSERT_EQUAL_UINT64(0u, st.evictions);
+
+  // Last release makes it evictable.
+  gltf_image_cache_release(cache, p);
+  gltf_image_cache_get_stats(cache, &st);
+  TEST_ASSERT_EQUAL_UINT32(0u, st.entries);
+  TEST_ASSERT_EQUAL_UINT64(0u, st.bytes);
+  TEST_ASSERT_EQUAL_UINT64(1u, st.evictions);
+
+  // Unlimited budget keeps it; shrinking the budget evicts it.
+  gltf_image_cache_set_budget(cache, 0);
+  test_assert_ok(gltf_image_cache_acquire_rgba8(cache, g_doc, 0, &p, &err), &err, "acquire");
+  gltf_image_cache_release(cache, p);
+  gltf_image_cache_get_stats(cache, &st);
+  TEST_ASSERT_EQUAL_UINT32(1u, st.entries);
+  TEST_ASSERT_EQUAL_UINT64(2u, st.misses);
+
+  gltf_image_cache_set_budget(cache, 1);
+  gltf_image_cache_get_stats(cache, &st);
+  TEST_ASSERT_EQUAL_UINT32(0u, st.entries);
+  TEST_ASSERT_EQUAL_UINT64(2u, st.evictions);
+#endif
+
+  gltf_image_cache_release(cache, NULL);
+  gltf_image_cache_free(cache);
+  gltf_image_cache_free(NULL);
+}
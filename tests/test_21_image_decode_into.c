@@ -0,0 +1,96 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef GLTF_REPO_ROOT
+#error "GLTF_REPO_ROOT must be defined by the build system"
+#endif
+
+extern gltf_doc* g_doc;
+
+void test_21_image_info_and_decode_into(void) {
+  gltf_error err = {0};
+  gltf_result rc = gltf_load_file(GLTF_REPO_ROOT "/tests/fixtures/05-materials.gltf", &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_file");
+
+  gltf_image_info info = {0};
+  rc = gltf_image_get_info(g_doc, 2, &info, &err);
+
+#if GLTF_ENABLE_IMAGES
+  // Image 2 is an 8-bit RGB PNG.
+  test_assert_ok(rc, &err, "gltf_image_get_info");
+  TEST_ASSERT_EQUAL_UINT32(1024u, info.width);
+  TEST_ASSERT_EQUAL_UINT32(1024u, info.height);
+  TEST_ASSERT_EQUAL_UINT32(3u, info.channels);
+
+  gltf_image_pixels rgba = {0};
+  test_assert_ok(gltf_image_decode_rgba8(g_doc, 2, &rgba, &err), &err, "gltf_image_decode_rgba8");
+
+  // Native channels with a padded pitch (the last row needs no padding);
+  // padding bytes must stay untouched.
+  const uint32_t pitch = info.width * 3u + 13u;
+  const size_t size = (size_t)info.width * 4u * info.height;
+  uint8_t* dst = (uint8_t*)malloc(size);
+  TEST_ASSERT_NOT_NULL(dst);
+  memset(dst, 0xCD, size);
+
+  gltf_image_info written = {0};
+  rc = gltf_image_decode_into(g_doc, 2, 0, dst, (size_t)pitch * info.height - 13u, pitch, &written, &err);
+  test_assert_ok(rc, &err, "gltf_image_decode_into(rgb)");
+  TEST_ASSERT_EQUAL_UINT32(3u, written.channels);
+  for (uint32_t y = 0; y < info.height; y += 97u) {
+    for (uint32_t x = 0; x < info.width; x++) {
+      TEST_ASSERT_EQUAL_MEMORY(&rgba.pixels[(size_t)y * rgba.stride_bytes + x * 4u],
+                               &dst[(size_t)y * pitch + x * 3u], 3);
+    }
+    TEST_ASSERT_EQUAL_UINT8(0xCDu, dst[(size_t)y * pitch + info.width * 3u]);
+  }
+
+  // Tightly packed RGBA matches the allocating decoder bit for bit.
+  test_assert_ok(gltf_image_decode_into(g_doc, 2, 4, dst, size, 0, NULL, &err), &err,
+                 "gltf_image_decode_into(rgba)");
+  TEST_ASSERT_EQUAL_MEMORY(rgba.pixels, dst, size);
+
+  // Single channel fits in a quarter of the RGBA footprint.
+  test_assert_ok(gltf_image_decode_into(g_doc, 2, 1, dst, (size_t)info.width * info.height, 0,
+                                        &written, &err), &err, "gltf_image_decode_into(grey)");
+  TEST_ASSERT_EQUAL_UINT32(1u, written.channels);
+
+  // Size and pitch validation happens before decoding.
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID,
+                        gltf_image_decode_into(g_doc, 2, 4, dst, size / 2u, 0, NULL, &err));
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID,
+                        gltf_image_decode_into(g_doc, 2, 3, dst, size, info.width, NULL, &err));
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID,
+                        gltf_image_decode_into(g_doc, 2, 5, dst, size, 0, NULL, &err));
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_RANGE,
+                        gltf_image_decode_into(g_doc, 9, 4, dst, size, 0, NULL, &err));
+
+  free(dst);
+  gltf_image_pixels_free(&rgba);
+
+  // Data URI images are probed from the decoded payload.
+  gltf_free(g_doc);
+  g_doc = NULL;
+  rc = gltf_load_file(GLTF_REPO_ROOT "/tests/fixtures/06-datauri.gltf", &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_file");
+  test_assert_ok(gltf_image_get_info(g_doc, 0, &info, &err), &err, "gltf_image_get_info(datauri)");
+  TEST_ASSERT_EQUAL_UINT32(1u, info.width);
+  TEST_ASSERT_EQUAL_UINT32(4u, info.channels);
+  uint8_t px[2] = { 0u, 0u };
+  test_assert_ok(gltf_image_decode_into(g_doc, 0, 2, px, sizeof px, 0, NULL, &err), &err,
+                 "gltf_image_decode_into(datauri)");
+  TEST_ASSERT_EQUAL_UINT8(255u, px[1]);
+#else
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_UNSUPPORTED, rc);
+  uint8_t px[4];
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_UNSUPPORTED,
+                        gltf_image_decode_into(g_doc, 0, 4, px, sizeof px, 0, NULL, &err));
+#endif
+}
@@ -0,0 +1,135 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef GLTF_REPO_ROOT
+#error "GLTF_REPO_ROOT must be defined by the build system"
+#endif
+
+extern gltf_doc* g_doc;
+
+static void t22_pattern(uint8_t* rgba, uint32_t w, uint32_t h) {
+  uint32_t seed = 777u;
+  for (uint32_t i = 0; i < w * h * 4u; i++) {
+    seed = seed * 1664525u + 1013904223u;
+    rgba[i] = (uint8_t)(seed >> 24u);
+  }
+}
+
+void test_22_mips_box_layout_and_values(void) {
+  // 5x3 with odd edges: 5x3 -> 2x1 -> 1x1.
+  uint8_t rgba[5 * 3 * 4];
+  for (uint32_t i = 0; i < sizeof rgba; i++) rgba[i] = (uint8_t)(i * 4u);
+
+  gltf_error err = {0};
+  gltf_mip_chain chain;
+  gltf_result rc = gltf_image_build_mips_rgba8(rgba, 5, 3, 0, GLTF_MIP_BOX, 0, NULL, NULL, &chain, &err);
+  test_assert_ok(rc, &err, "gltf_image_build_mips_rgba8");
+
+  TEST_ASSERT_EQUAL_UINT32(3u, chain.level_count);
+  TEST_ASSERT_EQUAL_UINT32(2u, chain.levels[1].width);
+  TEST_ASSERT_EQUAL_UINT32(1u, chain.levels[1].height);
+  TEST_ASSERT_EQUAL_UINT32(1u, chain.levels[2].width);
+  TEST_ASSERT_EQUAL(sizeof rgba, chain.levels[1].offset);
+  TEST_ASSERT_EQUAL(sizeof rgba + 8u + 4u, chain.size);
+  TEST_ASSERT_EQUAL_MEMORY(rgba, chain.data, sizeof rgba);
+
+  // Level 1 texel (0,0): average of texels (0,0),(1,0),(0,1),(1,1).
+  const uint8_t* l1 = chain.data + chain.levels[1].offset;
+  for (uint32_t c = 0; c < 4u; c++) {
+    const uint32_t sum = rgba[0 + c] + rgba[4 + c] + rgba[20 + c] + rgba[24 + c];
+    TEST_ASSERT_UINT8_WITHIN(1u, (uint8_t)((sum + 2u) / 4u), l1[c]);
+  }
+  gltf_mip_chain_free(&chain);
+  TEST_ASSERT_NULL(chain.data);
+
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID,
+                        gltf_image_build_mips_rgba8(rgba, 5, 3, 8, GLTF_MIP_BOX, 0, NULL, NULL, &chain, &err));
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID,
+                        gltf_image_build_mips_rgba8(rgba, 0, 3, 0, GLTF_MIP_BOX, 0, NULL, NULL, &chain, &err));
+}
+
+void test_22_mips_kaiser_srgb_parallel(void) {
+  enum { W = 300, H = 200 };
+  uint8_t* rgba = (uint8_t*)malloc(W * H * 4);
+  TEST_ASSERT_NOT_NULL(rgba);
+  t22_pattern(rgba, W, H);
+
+  gltf_error err = {0};
+  gltf_mip_chain serial, parallel;
+  test_assert_ok(gltf_image_build_mips_rgba8(rgba, W, H, 0, GLTF_MIP_KAISER, GLTF_MIP_SRGB, NULL, NULL,
+                                             &serial, &err), &err, "build(serial)");
+
+  gltf_thread_pool* pool = NULL;
+  test_assert_ok(gltf_thread_pool_create(3, &pool, &err), &err, "gltf_thread_pool_create");
+  test_assert_ok(gltf_image_build_mips_rgba8(rgba, W, H, 0, GLTF_MIP_KAISER, GLTF_MIP_SRGB,
+                                             gltf_thread_pool_dispatch, pool, &parallel, &err), &err,
+                 "build(parallel)");
+  gltf_thread_pool_free(pool);
+
+  TEST_ASSERT_EQUAL_UINT32(9u, serial.level_count);
+  TEST_ASSERT_EQUAL(serial.size, parallel.size);
+  TEST_ASSERT_EQUAL_MEMORY(serial.data, parallel.data, serial.size);
+  gltf_mip_chain_free(&serial);
+  gltf_mip_chain_free(&parallel);
+
+  // A flat image stays flat through every level in linear and sRGB mode.
+  for (uint32_t i = 0; i < W * H; i++) {
+    rgba[i * 4u + 0u] = 200u;
+    rgba[i * 4u + 1u] = 40u;
+    rgba[i * 4u + 2u] = 128u;
+    rgba[i * 4u + 3u] = 77u;
+  }
+  for (uint32_t pass = 0; pass < 2u; pass++) {
+    test_assert_ok(gltf_image_build_mips_rgba8(rgba, W, H, 0, GLTF_MIP_KAISER, pass ? GLTF_MIP_SRGB : 0u,
+                                               NULL, NULL, &serial, &err), &err, "build(flat)");
+    const gltf_mip_level* last = &serial.levels[serial.level_count - 1u];
+    const uint8_t* px = serial.data + last->offset;
+    TEST_ASSERT_UINT8_WITHIN(1u, 200u, px[0]);
+    TEST_ASSERT_UINT8_WITHIN(1u, 40u, px[1]);
+    TEST_ASSERT_UINT8_WITHIN(1u, 128u, px[2]);
+    TEST_ASSERT_EQUAL_UINT8(77u, px[3]);
+    gltf_mip_chain_free(&serial);
+  }
+  free(rgba);
+}
+
+void test_22_mips_from_document(void) {
+  gltf_error err = {0};
+  gltf_result rc = gltf_load_file(GLTF_REPO_ROOT "/tests/fixtures/05-materials.gltf", &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_file");
+
+  // Image 1 is the base color texture; 0 (normal) and 2 (metal/rough) are data.
+  TEST_ASSERT_EQUAL_INT(0, gltf_image_is_srgb(g_doc, 0));
+  TEST_ASSERT_EQUAL_INT(1, gltf_image_is_srgb(g_doc, 1));
+  TEST_ASSERT_EQUAL_INT(0, gltf_image_is_srgb(g_doc, 2));
+  TEST_ASSERT_EQUAL_INT(0, gltf_image_is_srgb(g_doc, 9));
+
+  gltf_mip_chain chain;
+  rc = gltf_image_decode_mips_rgba8(g_doc, 2, GLTF_MIP_BOX, GLTF_MIP_SRGB_FROM_MATERIALS, NULL, NULL,
+                                    &chain, &err);
+#if GLTF_ENABLE_IMAGES
+  test_assert_ok(rc, &err, "gltf_image_decode_mips_rgba8");
+  TEST_ASSERT_EQUAL_UINT32(11u, chain.level_count);
+
+  gltf_image_pixels base = {0};
+  test_assert_ok(gltf_image_decode_rgba8(g_doc, 2, &base, &err), &err, "gltf_image_decode_rgba8");
+  TEST_ASSERT_EQUAL_MEMORY(base.pixels, chain.data, (size_t)base.stride_bytes * base.height);
+
+  gltf_mip_chain ref;
+  test_assert_ok(gltf_image_build_mips_rgba8(base.pixels, base.width, base.height, base.stride_bytes,
+                                             GLTF_MIP_BOX, 0, NULL, NULL, &ref, &err), &err, "build(ref)");
+  TEST_ASSERT_EQUAL_MEMORY(ref.data, chain.data, ref.size);
+  gltf_mip_chain_free(&ref);
+  gltf_image_pixels_free(&base);
+  gltf_mip_chain_free(&chain);
+#else
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_UNSUPPORTED, rc);
+#endif
+}
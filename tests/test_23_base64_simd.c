@@ -0,0 +1,114 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern gltf_doc* g_doc;
+
+// Long enough for several AVX2/NEON blocks plus a scalar tail.
+#define T23_LEN 1000u
+
+static const char k_t23_alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Encodes src as base64, inserting a JSON-escaped "\r\n" every 'wrap' output
+// characters (0 = never).
+static size_t t23_encode(const uint8_t* src, size_t n, char* out, size_t wrap) {
+  size_t o = 0, col = 0;
+  for (size_t i = 0; i < n; i += 3u) {
+    const uint32_t b0 = src[i];
+    const uint32_t b1 = (i + 1u < n) ? src[i + 1u] : 0u;
+    const uint32_t b2 = (i + 2u < n) ? src[i + 2u] : 0u;
+    const uint32_t v = (b0 << 16u) | (b1 << 8u) | b2;
+    const char q[4] = { k_t23_alphabet[(v >> 18u) & 63u], k_t23_alphabet[(v >> 12u) & 63u],
+                        (i + 1u < n) ? k_t23_alphabet[(v >> 6u) & 63u] : '=',
+                        (i + 2u < n) ? k_t23_alphabet[v & 63u] : '=' };
+    for (int k = 0; k < 4; k++) {
+      if (wrap && col == wrap) {
+        memcpy(out + o, "\\r\\n", 4);
+        o += 4u;
+        col = 0;
+      }
+      out[o++] = q[k];
+      col++;
+    }
+  }
+  out[o] = '\0';
+  return o;
+}
+
+// Loads a single-buffer document whose u8 SCALAR accessor covers the payload.
+static gltf_result t23_load(const char* payload, uint32_t byte_len, gltf_error* err) {
+  const size_t cap = strlen(payload) + 512u;
+  char* json = (char*)malloc(cap);
+  TEST_ASSERT_NOT_NULL(json);
+  (void)snprintf(json, cap,
+                 "{\"asset\":{\"version\":\"2.0\"},"
+                 "\"buffers\":[{\"byteLength\":%u,\"uri\":\"data:application/octet-stream;base64,%s\"}],"
+                 "\"bufferViews\":[{\"buffer\":0,\"byteLength\":%u}],"
+                 "\"accessors\":[{\"bufferView\":0,\"componentType\":5121,\"count\":%u,\"type\":\"SCALAR\"}]}",
+                 byte_len, payload, byte_len, byte_len);
+  gltf_result rc = gltf_load_json_string((uint8_t*)json, (uint32_t)strlen(json), &g_doc, err);
+  free(json);
+  return rc;
+}
+
+static void t23_expect(const uint8_t* src, uint32_t n) {
+  static float v[T23_LEN];
+  gltf_error err = {0};
+  test_assert_ok(gltf_accessor_read_f32_range(g_doc, 0, 0, n, v, 0, &err), &err, "read_f32_range");
+  for (uint32_t i = 0; i < n; i++) TEST_ASSERT_EQUAL_FLOAT((float)src[i], v[i]);
+}
+
+void test_23_base64_bulk_matches_scalar(void) {
+  static uint8_t src[T23_LEN];
+  static char b64[T23_LEN * 2u];
+  uint32_t seed = 99u;
+  for (uint32_t i = 0; i < T23_LEN; i++) {
+    seed = seed * 1664525u + 1013904223u;
+    src[i] = (uint8_t)(seed >> 24u);
+  }
+
+  // Every tail length (0/1/2 padding) with and without line wrapping.
+  const uint32_t lens[3] = { T23_LEN, T23_LEN - 1u, T23_LEN - 2u };
+  const size_t wraps[2] = { 0u, 76u };
+  for (uint32_t w = 0; w < 2u; w++) {
+    for (uint32_t l = 0; l < 3u; l++) {
+      t23_encode(src, lens[l], b64, wraps[w]);
+      gltf_error err = {0};
+      test_assert_ok(t23_load(b64, lens[l], &err), &err, "gltf_load_json_string");
+      t23_expect(src, lens[l]);
+      gltf_free(g_doc);
+      g_doc = NULL;
+    }
+  }
+}
+
+void test_23_base64_bulk_rejects_invalid(void) {
+  static uint8_t src[T23_LEN];
+  static char b64[T23_LEN * 2u];
+  for (uint32_t i = 0; i < T23_LEN; i++) src[i] = (uint8_t)(i * 7u);
+  const size_t n = t23_encode(src, T23_LEN, b64, 0);
+
+  // Bad bytes inside what would be a vector block, and padding mid-stream.
+  const size_t at[3] = { 5u, 500u, n - 40u };
+  const char bad[3] = { '*', '=', '!' };
+  for (uint32_t k = 0; k < 3u; k++) {
+    const char saved = b64[at[k]];
+    b64[at[k]] = bad[k];
+    gltf_error err = {0};
+    TEST_ASSERT_EQUAL_INT(GLTF_ERR_PARSE, t23_load(b64, T23_LEN, &err));
+    TEST_ASSERT_NULL(g_doc);
+    b64[at[k]] = saved;
+  }
+
+  // Sanity: the untouched payload still loads.
+  gltf_error err = {0};
+  test_assert_ok(t23_load(b64, T23_LEN, &err), &err, "gltf_load_json_string");
+  t23_expect(src, T23_LEN);
+}
@@ -0,0 +1,87 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern gltf_doc* g_doc;
+
+#define T24_FIXTURE GLTF_REPO_ROOT "/tests/fixtures/08-datauri-buffers.gltf"
+
+// Expected bytes of buffer b in 08-datauri-buffers.gltf (37, 1 and 300 bytes).
+static uint8_t t24_expected(uint32_t b, uint32_t i) {
+  if (b == 0) return (uint8_t)((i * 37u + 11u) & 255u);
+  if (b == 1) return 200u;
+  return (uint8_t)((i * i + 3u) & 255u);
+}
+
+static void t24_check_buffers(const gltf_doc* doc) {
+  static const uint32_t k_counts[3] = { 37u, 1u, 300u };
+  TEST_ASSERT_EQUAL_UINT32(3u, gltf_doc_accessor_count(doc));
+
+  for (uint32_t acc = 0; acc < 3u; acc++) {
+    float v[300];
+    gltf_error err = {0};
+    gltf_result rc = gltf_accessor_read_f32_range(doc, acc, 0, k_counts[acc], v, 0, &err);
+    test_assert_ok(rc, &err, "gltf_accessor_read_f32_range");
+    for (uint32_t i = 0; i < k_counts[acc]; i++) {
+      TEST_ASSERT_EQUAL_FLOAT((float)t24_expected(acc, i), v[i]);
+    }
+  }
+}
+
+void test_24_datauri_buffers_from_file(void) {
+  gltf_error err = {0};
+
+  // Eager: payloads decoded over the file text.
+  gltf_result rc = gltf_load_file(T24_FIXTURE, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_file");
+  t24_check_buffers(g_doc);
+  gltf_free(g_doc);
+  g_doc = NULL;
+
+  // Lazy: payloads decoded on first use from the arena copy.
+  gltf_load_options opts = {0};
+  opts.flags = GLTF_LOAD_LAZY_BUFFERS;
+  rc = gltf_load_file_ex(T24_FIXTURE, &opts, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_file_ex(lazy)");
+  t24_check_buffers(g_doc);
+}
+
+void test_24_datauri_buffers_from_memory(void) {
+  FILE* f = fopen(T24_FIXTURE, "rb");
+  TEST_ASSERT_NOT_NULL(f);
+  char text[4096];
+  const size_t n = fread(text, 1, sizeof(text), f);
+  fclose(f);
+  TEST_ASSERT_TRUE(n > 0 && n < sizeof(text));
+
+  // The caller's text is never decoded over.
+  char copy[4096];
+  memcpy(copy, text, n);
+  gltf_error err = {0};
+  gltf_result rc = gltf_load_json_string((uint8_t*)text, (uint32_t)n, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_json_string");
+  t24_check_buffers(g_doc);
+  TEST_ASSERT_EQUAL_MEMORY(copy, text, n);
+
+#if GLTF_ENABLE_IMAGES
+  // Data-URI images are decoded once per document and shared by later calls.
+  gltf_free(g_doc);
+  g_doc = NULL;
+  rc = gltf_load_file(GLTF_REPO_ROOT "/tests/fixtures/06-datauri.gltf", &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_file(06-datauri)");
+  for (int pass = 0; pass < 2; pass++) {
+    gltf_image_info info = {0};
+    rc = gltf_image_get_info(g_doc, 0, &info, &err);
+    test_assert_ok(rc, &err, "gltf_image_get_info");
+    TEST_ASSERT_EQUAL_UINT32(1u, info.width);
+    TEST_ASSERT_EQUAL_UINT32(1u, info.height);
+  }
+#endif
+}
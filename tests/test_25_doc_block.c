@@ -0,0 +1,159 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern gltf_doc* g_doc;
+
+#define T25_NODES 600u
+
+// Allocator that counts live blocks so tests can see what the loader keeps.
+typedef struct t25_counter {
+  int live;
+  int mallocs;
+} t25_counter;
+
+static void* t25_malloc(void* user, size_t size) {
+  t25_counter* c = (t25_counter*)user;
+  void* p = malloc(size);
+  if (p) {
+    c->live++;
+    c->mallocs++;
+  }
+  return p;
+}
+
+static void* t25_realloc(void* user, void* ptr, size_t old_size, size_t size) {
+  (void)old_size;
+  t25_counter* c = (t25_counter*)user;
+  void* p = realloc(ptr, size);
+  if (p && !ptr) {
+    c->live++;
+    c->mallocs++;
+  }
+  return p;
+}
+
+static void t25_free(void* user, void* ptr) {
+  t25_counter* c = (t25_counter*)user;
+  if (ptr) c->live--;
+  free(ptr);
+}
+
+void test_25_doc_block_custom_allocator(void) {
+  t25_counter counter = {0};
+  const gltf_allocator alc = { t25_malloc, t25_realloc, t25_free, &counter };
+  gltf_load_options opts = {0};
+  opts.allocator = &alc;
+
+  // .gltf with external buffer, images and materials: one block survives the load.
+  gltf_error err = {0};
+  gltf_result rc = gltf_load_file_ex(GLTF_REPO_ROOT "/tests/fixtures/05-materials.gltf",
+                                     &opts, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_file_ex(allocator)");
+  TEST_ASSERT_TRUE(counter.mallocs >= 2); // JSON tree + document block
+  TEST_ASSERT_EQUAL_INT(1, counter.live);
+
+  TEST_ASSERT_TRUE(gltf_doc_image_count(g_doc) >= 3u);
+  for (uint32_t i = 0; i < gltf_doc_image_count(g_doc); i++) {
+    const gltf_image* img = NULL;
+    TEST_ASSERT_EQUAL_INT(1, gltf_doc_image(g_doc, i, &img));
+    TEST_ASSERT_NOT_NULL(img->uri);
+    TEST_ASSERT_NOT_NULL(img->resolved);
+    const size_t n = strlen(img->resolved), u = strlen(img->uri);
+    TEST_ASSERT_TRUE(n > u);
+    TEST_ASSERT_EQUAL_STRING(img->uri, img->resolved + (n - u));
+  }
+
+  gltf_free(g_doc);
+  g_doc = NULL;
+  TEST_ASSERT_EQUAL_INT(0, counter.live);
+
+  // GLB from memory.
+  static const char* json =
+    "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":4}],"
+    "\"nodes\":[{\"name\":\"a\",\"children\":[1]},{\"name\":\"b\"}],\"scenes\":[{\"nodes\":[0]}]}";
+  const uint8_t bin[4] = { 1, 2, 3, 4 };
+  size_t size = 0;
+  uint8_t* glb = test_build_glb(json, bin, 4u, &size);
+  rc = gltf_load_glb_bytes_ex(glb, size, &opts, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_glb_bytes_ex(allocator)");
+  TEST_ASSERT_EQUAL_INT(1, counter.live);
+  TEST_ASSERT_EQUAL_STRING("b", gltf_doc_node_name(g_doc, 1));
+  uint32_t child = 0;
+  TEST_ASSERT_EQUAL_INT(1, gltf_doc_node_child(g_doc, 0, 0, &child));
+  TEST_ASSERT_EQUAL_UINT32(1u, child);
+  gltf_free(g_doc);
+  g_doc = NULL;
+  TEST_ASSERT_EQUAL_INT(0, counter.live);
+
+  // Streamed GLB: staging buffers come from the allocator too; the BIN chunk
+  // stays with the document and goes back when the document is freed.
+  gltf_glb_stream* st = NULL;
+  test_assert_ok(gltf_glb_stream_create(&opts, &st, &err), &err, "gltf_glb_stream_create(allocator)");
+  test_assert_ok(gltf_glb_stream_feed(st, glb, 24u, &err), &err, "feed(json header)");
+  TEST_ASSERT_EQUAL_INT(2, counter.live); // stream + JSON chunk
+  gltf_glb_stream_free(st);
+  TEST_ASSERT_EQUAL_INT(0, counter.live);
+
+  const int mallocs = counter.mallocs;
+  test_assert_ok(gltf_glb_stream_create(&opts, &st, &err), &err, "gltf_glb_stream_create(allocator)");
+  test_assert_ok(gltf_glb_stream_feed(st, glb, size, &err), &err, "feed(all)");
+  test_assert_ok(gltf_glb_stream_finish(st, &g_doc, &err), &err, "gltf_glb_stream_finish");
+  TEST_ASSERT_TRUE(counter.mallocs - mallocs >= 4); // stream, JSON, BIN, document
+  TEST_ASSERT_EQUAL_INT(2, counter.live);          // document block + BIN chunk
+  TEST_ASSERT_EQUAL_STRING("b", gltf_doc_node_name(g_doc, 1));
+  gltf_free(g_doc);
+  g_doc = NULL;
+  TEST_ASSERT_EQUAL_INT(0, counter.live);
+
+  // Incomplete allocators are rejected.
+  const gltf_allocator partial = { t25_malloc, NULL, t25_free, &counter };
+  opts.allocator = &partial;
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_load_glb_bytes_ex(glb, size, &opts, &g_doc, &err));
+  TEST_ASSERT_NULL(g_doc);
+  free(glb);
+}
+
+void test_25_doc_block_presize_many_strings(void) {
+  // Far more string and index bytes than any small default capacity.
+  const size_t cap = (size_t)T25_NODES * 96u + 256u;
+  char* json = (char*)malloc(cap);
+  TEST_ASSERT_NOT_NULL(json);
+  size_t o = (size_t)snprintf(json, cap, "{\"asset\":{\"version\":\"2.0\",\"generator\":\"t25\"},"
+                                         "\"scenes\":[{\"name\":\"root\",\"nodes\":[0]}],\"nodes\":[");
+  for (uint32_t i = 0; i < T25_NODES; i++) {
+    o += (size_t)snprintf(json + o, cap - o, "%s{\"name\":\"node_%04u_padding_padding_padding\"", i ? "," : "", i);
+    if (i + 1u < T25_NODES) o += (size_t)snprintf(json + o, cap - o, ",\"children\":[%u]", i + 1u);
+    o += (size_t)snprintf(json + o, cap - o, "}");
+  }
+  o += (size_t)snprintf(json + o, cap - o, "]}");
+  TEST_ASSERT_TRUE(o < cap);
+
+  gltf_error err = {0};
+  gltf_result rc = gltf_load_json_string((uint8_t*)json, (uint32_t)o, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_json_string");
+  free(json);
+
+  TEST_ASSERT_EQUAL_UINT32(T25_NODES, gltf_doc_node_count(g_doc));
+  TEST_ASSERT_EQUAL_STRING("root", gltf_doc_scene_name(g_doc, 0));
+  for (uint32_t i = 0; i < T25_NODES; i++) {
+    char expect[64];
+    (void)snprintf(expect, sizeof expect, "node_%04u_padding_padding_padding", i);
+    TEST_ASSERT_EQUAL_STRING(expect, gltf_doc_node_name(g_doc, i));
+
+    uint32_t child = 0;
+    if (i + 1u < T25_NODES) {
+      TEST_ASSERT_EQUAL_INT(1, gltf_doc_node_child(g_doc, i, 0, &child));
+      TEST_ASSERT_EQUAL_UINT32(i + 1u, child);
+    } else {
+      TEST_ASSERT_EQUAL_UINT32(0u, gltf_doc_node_child_count(g_doc, i));
+    }
+  }
+}
@@ -0,0 +1,248 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern gltf_doc* g_doc;
+
+#define T26_FIXTURES GLTF_REPO_ROOT "/tests/fixtures/"
+#define T26_OUT GLTF_TEST_OUT_DIR "/t26_"
+
+static uint8_t* t26_read(const char* path, size_t* out_size) {
+  FILE* f = fopen(path, "rb");
+  TEST_ASSERT_NOT_NULL(f);
+  TEST_ASSERT_EQUAL_INT(0, fseek(f, 0, SEEK_END));
+  const long size = ftell(f);
+  TEST_ASSERT_TRUE(size > 0);
+  TEST_ASSERT_EQUAL_INT(0, fseek(f, 0, SEEK_SET));
+  uint8_t* data = (uint8_t*)malloc((size_t)size);
+  TEST_ASSERT_NOT_NULL(data);
+  TEST_ASSERT_EQUAL_size_t((size_t)size, fread(data, 1, (size_t)size, f));
+  fclose(f);
+  *out_size = (size_t)size;
+  return data;
+}
+
+static void t26_write(const char* path, const void* data, size_t size) {
+  FILE* f = fopen(path, "wb");
+  TEST_ASSERT_NOT_NULL(f);
+  TEST_ASSERT_EQUAL_size_t(size, fwrite(data, 1, size, f));
+  TEST_ASSERT_EQUAL_INT(0, fclose(f));
+}
+
+static void t26_assert_str(const char* a, const char* b) {
+  if (!a || !b) {
+    TEST_ASSERT_TRUE(a == b);
+  } else {
+    TEST_ASSERT_EQUAL_STRING(a, b);
+  }
+}
+
+// Compares everything the public API exposes for the fixtures used here.
+static void t26_assert_same(const gltf_doc* a, const gltf_doc* b) {
+  TEST_ASSERT_EQUAL_UINT32(gltf_doc_node_count(a), gltf_doc_node_count(b));
+  TEST_ASSERT_EQUAL_UINT32(gltf_doc_mesh_count(a), gltf_doc_mesh_count(b));
+  TEST_ASSERT_EQUAL_UINT32(gltf_doc_accessor_count(a), gltf_doc_accessor_count(b));
+  TEST_ASSERT_EQUAL_UINT32(gltf_doc_material_count(a), gltf_doc_material_count(b));
+  TEST_ASSERT_EQUAL_UINT32(gltf_doc_texture_count(a), gltf_doc_texture_count(b));
+  TEST_ASSERT_EQUAL_UINT32(gltf_doc_image_count(a), gltf_doc_image_count(b));
+
+  for (uint32_t i = 0; i < gltf_doc_node_count(a); i++) {
+    t26_assert_str(gltf_doc_node_name(a, i), gltf_doc_node_name(b, i));
+  }
+
+  for (uint32_t acc = 0; acc < gltf_doc_accessor_count(a); acc++) {
+    uint32_t count = 0, comp = 0, type = 0;
+    int norm = 0;
+    TEST_ASSERT_EQUAL_INT(1, gltf_doc_accessor_info(a, acc, &count, &comp, &type, &norm));
+
+    float* va = (float*)calloc((size_t)count * 16u + 1u, sizeof(float));
+    float* vb = (float*)calloc((size_t)count * 16u + 1u, sizeof(float));
+    TEST_ASSERT_NOT_NULL(va);
+    TEST_ASSERT_NOT_NULL(vb);
+    gltf_error err = {0};
+    test_assert_ok(gltf_accessor_read_f32_range(a, acc, 0, count, va, 16, &err), &err, "read(source)");
+    test_assert_ok(gltf_accessor_read_f32_range(b, acc, 0, count, vb, 16, &err), &err, "read(baked)");
+    TEST_ASSERT_EQUAL_MEMORY(va, vb, (size_t)count * 16u * sizeof(float));
+    free(va);
+    free(vb);
+  }
+
+  for (uint32_t i = 0; i < gltf_doc_material_count(a); i++) {
+    const gltf_material* ma = NULL;
+    const gltf_material* mb = NULL;
+    TEST_ASSERT_EQUAL_INT(1, gltf_doc_material(a, i, &ma));
+    TEST_ASSERT_EQUAL_INT(1, gltf_doc_material(b, i, &mb));
+    t26_assert_str(ma->name, mb->name);
+  }
+
+  for (uint32_t i = 0; i < gltf_doc_image_count(a); i++) {
+    const gltf_image* ia = NULL;
+    const gltf_image* ib = NULL;
+    TEST_ASSERT_EQUAL_INT(1, gltf_doc_image(a, i, &ia));
+    TEST_ASSERT_EQUAL_INT(1, gltf_doc_image(b, i, &ib));
+    t26_assert_str(ia->name, ib->name);
+    t26_assert_str(ia->uri, ib->uri);
+    t26_assert_str(ia->resolved, ib->resolved);
+    t26_assert_str(ia->mime_type, ib->mime_type);
+  }
+}
+
+static void t26_roundtrip(const char* src, const char* baked, uint32_t bake_flags) {
+  gltf_error err = {0};
+  gltf_result rc = gltf_load_file(src, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_file");
+
+  rc = gltf_doc_save_baked(g_doc, baked, bake_flags, &err);
+  test_assert_ok(rc, &err, "gltf_doc_save_baked");
+
+  gltf_doc* loaded = NULL;
+  rc = gltf_load_baked(baked, NULL, &loaded, &err);
+  test_assert_ok(rc, &err, "gltf_load_baked");
+  t26_assert_same(g_doc, loaded);
+  gltf_free(loaded);
+}
+
+void test_26_baked_roundtrip_external_buffers(void) {
+  // External .bin buffers are referenced by path and loaded on first use.
+  t26_roundtrip(T26_FIXTURES "03-tri.gltf", T26_OUT "03-tri.gltfb", GLTF_BAKE_DEFAULT);
+  gltf_free(g_doc);
+  g_doc = NULL;
+
+  t26_roundtrip(T26_FIXTURES "05-materials.gltf", T26_OUT "05-materials.gltfb", GLTF_BAKE_DEFAULT);
+  gltf_free(g_doc);
+  g_doc = NULL;
+
+  // Re-baking over an existing file replaces it.
+  t26_roundtrip(T26_FIXTURES "05-materials.gltf", T26_OUT "05-materials.gltfb", GLTF_BAKE_DEFAULT);
+}
+
+void test_26_baked_embedded_buffers_and_glb(void) {
+  // GLTF_BAKE_BUFFERS: the baked file no longer needs the .bin next to it.
+  t26_roundtrip(T26_FIXTURES "03-tri.gltf", T26_OUT "03-tri-embedded.gltfb", GLTF_BAKE_BUFFERS);
+  size_t plain = 0, embedded = 0;
+  free(t26_read(T26_OUT "03-tri.gltfb", &plain));
+  free(t26_read(T26_OUT "03-tri-embedded.gltfb", &embedded));
+  TEST_ASSERT_TRUE(embedded > plain);
+  gltf_free(g_doc);
+  g_doc = NULL;
+
+  // GLB bytes: the BIN chunk is embedded and the source blob can go away.
+  static const char* k_json =
+    "{\"asset\":{\"version\":\"2.0\"},"
+    "\"nodes\":[{\"name\":\"a\"},{\"name\":\"b\"}],"
+    "\"buffers\":[{\"byteLength\":16}],"
+    "\"bufferViews\":[{\"buffer\":0,\"byteLength\":16}],"
+    "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":4,\"type\":\"SCALAR\"}]}";
+  const float bin[4] = { 1.5f, -2.0f, 3.25f, 8.0f };
+  size_t glb_size = 0;
+  uint8_t* glb = test_build_glb(k_json, bin, sizeof bin, &glb_size);
+
+  gltf_error err = {0};
+  gltf_result rc = gltf_load_glb_bytes(glb, glb_size, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_glb_bytes");
+  rc = gltf_doc_save_baked(g_doc, T26_OUT "glb.gltfb", GLTF_BAKE_DEFAULT, &err);
+  test_assert_ok(rc, &err, "gltf_doc_save_baked(glb)");
+  gltf_free(g_doc);
+  g_doc = NULL;
+  free(glb);
+
+  rc = gltf_load_baked(T26_OUT "glb.gltfb", NULL, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_baked(glb)");
+  TEST_ASSERT_EQUAL_STRING("b", gltf_doc_node_name(g_doc, 1));
+  float v[4];
+  test_assert_ok(gltf_accessor_read_f32_range(g_doc, 0, 0, 4, v, 0, &err), &err, "read");
+  TEST_ASSERT_EQUAL_MEMORY(bin, v, sizeof v);
+}
+
+void test_26_baked_rejects_bad_files(void) {
+  gltf_error err = {0};
+  gltf_result rc = gltf_load_file(T26_FIXTURES "08-datauri-buffers.gltf", &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_file");
+  rc = gltf_doc_save_baked(g_doc, T26_OUT "08.gltfb", GLTF_BAKE_DEFAULT, &err);
+  test_assert_ok(rc, &err, "gltf_doc_save_baked");
+
+  size_t size = 0;
+  uint8_t* bytes = t26_read(T26_OUT "08.gltfb", &size);
+  gltf_doc* doc = (gltf_doc*)(uintptr_t)1u;
+
+  // Truncated.
+  t26_write(T26_OUT "bad.gltfb", bytes, size / 2u);
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_PARSE, gltf_load_baked(T26_OUT "bad.gltfb", NULL, &doc, &err));
+  TEST_ASSERT_NULL(doc);
+
+  // Another format version.
+  bytes[4] ^= 0xFFu;
+  t26_write(T26_OUT "bad.gltfb", bytes, size);
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_UNSUPPORTED, gltf_load_baked(T26_OUT "bad.gltfb", NULL, &doc, &err));
+  bytes[4] ^= 0xFFu;
+
+  // Not a baked file at all.
+  bytes[0] ^= 0xFFu;
+  t26_write(T26_OUT "bad.gltfb", bytes, size);
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_PARSE, gltf_load_baked(T26_OUT "bad.gltfb", NULL, &doc, &err));
+  bytes[0] ^= 0xFFu;
+
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_IO, gltf_load_baked(T26_OUT "missing.gltfb", NULL, &doc, &err));
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_load_baked(NULL, NULL, &doc, &err));
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID,
+                        gltf_doc_save_baked(NULL, T26_OUT "bad.gltfb", GLTF_BAKE_DEFAULT, &err));
+
+  // The intact file still loads.
+  t26_write(T26_OUT "bad.gltfb", bytes, size);
+  rc = gltf_load_baked(T26_OUT "bad.gltfb", NULL, &doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_baked");
+  t26_assert_same(g_doc, doc);
+  gltf_free(doc);
+  free(bytes);
+}
+
+void test_26_baked_cached_load_invalidates(void) {
+  const char* src = T26_OUT "cached.gltf";
+  const char* cache = T26_OUT "cached.gltfb";
+  (void)remove(cache);
+
+  size_t size = 0;
+  uint8_t* bytes = t26_read(T26_FIXTURES "08-datauri-buffers.gltf", &size);
+  t26_write(src, bytes, size);
+  free(bytes);
+
+  // Miss: parses the source and writes the cache.
+  gltf_error err = {0};
+  gltf_result rc = gltf_load_file_cached(src, cache, NULL, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_file_cached(miss)");
+  TEST_ASSERT_EQUAL_UINT32(3u, gltf_doc_accessor_count(g_doc));
+
+  gltf_doc* baked = NULL;
+  rc = gltf_load_baked(cache, NULL, &baked, &err);
+  test_assert_ok(rc, &err, "gltf_load_baked(cache)");
+  gltf_free(baked);
+
+  // Hit.
+  gltf_doc* again = NULL;
+  rc = gltf_load_file_cached(src, cache, NULL, &again, &err);
+  test_assert_ok(rc, &err, "gltf_load_file_cached(hit)");
+  t26_assert_same(g_doc, again);
+  gltf_free(again);
+
+  // The source changes: the stale cache is ignored and rebuilt.
+  bytes = t26_read(T26_FIXTURES "01-minimal.gltf", &size);
+  t26_write(src, bytes, size);
+  free(bytes);
+
+  rc = gltf_load_file_cached(src, cache, NULL, &again, &err);
+  test_assert_ok(rc, &err, "gltf_load_file_cached(stale)");
+  TEST_ASSERT_EQUAL_UINT32(0u, gltf_doc_accessor_count(again));
+  gltf_free(again);
+
+  rc = gltf_load_file_cached(src, cache, NULL, &again, &err);
+  test_assert_ok(rc, &err, "gltf_load_file_cached(rebuilt)");
+  TEST_ASSERT_EQUAL_UINT32(0u, gltf_doc_accessor_count(again));
+  gltf_free(again);
+}
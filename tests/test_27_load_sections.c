@@ -0,0 +1,182 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern gltf_doc* g_doc;
+
+#define T27_MATERIALS GLTF_REPO_ROOT "/tests/fixtures/05-materials.gltf"
+
+// Allocator that tracks live bytes (size stored in a 16-byte prefix).
+static void* t27_malloc(void* user, size_t size) {
+  uint8_t* p = (uint8_t*)malloc(size + 16u);
+  if (!p) return NULL;
+  memcpy(p, &size, sizeof size);
+  *(size_t*)user += size;
+  return p + 16u;
+}
+
+static void* t27_realloc(void* user, void* ptr, size_t old_size, size_t size) {
+  void* p = t27_malloc(user, size);
+  if (p && ptr) {
+    memcpy(p, ptr, old_size < size ? old_size : size);
+    size_t prev = 0;
+    memcpy(&prev, (uint8_t*)ptr - 16u, sizeof prev);
+    *(size_t*)user -= prev;
+    free((uint8_t*)ptr - 16u);
+  }
+  return p;
+}
+
+static void t27_free(void* user, void* ptr) {
+  size_t size = 0;
+  memcpy(&size, (uint8_t*)ptr - 16u, sizeof size);
+  *(size_t*)user -= size;
+  free((uint8_t*)ptr - 16u);
+}
+
+static size_t t27_block_bytes(uint32_t sections) {
+  size_t live = 0;
+  const gltf_allocator alc = { t27_malloc, t27_realloc, t27_free, &live };
+  gltf_load_options opts = {0};
+  opts.allocator = &alc;
+  opts.sections = sections;
+
+  gltf_doc* doc = NULL;
+  gltf_error err = {0};
+  test_assert_ok(gltf_load_file_ex(T27_MATERIALS, &opts, &doc, &err), &err, "gltf_load_file_ex");
+  const size_t bytes = live;
+  gltf_free(doc);
+  TEST_ASSERT_EQUAL_size_t(0u, live);
+  return bytes;
+}
+
+void test_27_load_sections_geometry_only(void) {
+  gltf_error err = {0};
+  gltf_doc* full = NULL;
+  test_assert_ok(gltf_load_file(T27_MATERIALS, &full, &err), &err, "gltf_load_file");
+  TEST_ASSERT_TRUE(gltf_doc_material_count(full) > 0u);
+
+  gltf_load_options opts = {0};
+  opts.sections = GLTF_LOAD_SECTION_GEOMETRY;
+  gltf_result rc = gltf_load_file_ex(T27_MATERIALS, &opts, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_file_ex(geometry)");
+
+  TEST_ASSERT_EQUAL_UINT32(0u, gltf_doc_material_count(g_doc));
+  TEST_ASSERT_EQUAL_UINT32(0u, gltf_doc_texture_count(g_doc));
+  TEST_ASSERT_EQUAL_UINT32(0u, gltf_doc_image_count(g_doc));
+  TEST_ASSERT_EQUAL_UINT32(0u, gltf_doc_sampler_count(g_doc));
+  TEST_ASSERT_EQUAL_UINT32(gltf_doc_node_count(full), gltf_doc_node_count(g_doc));
+  TEST_ASSERT_EQUAL_UINT32(gltf_doc_mesh_count(full), gltf_doc_mesh_count(g_doc));
+  TEST_ASSERT_EQUAL_INT32(gltf_doc_default_scene(full), gltf_doc_default_scene(g_doc));
+  TEST_ASSERT_EQUAL_UINT32(gltf_doc_accessor_count(full), gltf_doc_accessor_count(g_doc));
+
+  uint32_t count = 0, comp = 0, type = 0;
+  int norm = 0;
+  TEST_ASSERT_EQUAL_INT(1, gltf_doc_accessor_info(g_doc, 0, &count, &comp, &type, &norm));
+  float* a = (float*)malloc((size_t)count * 16u * sizeof(float));
+  float* b = (float*)malloc((size_t)count * 16u * sizeof(float));
+  TEST_ASSERT_NOT_NULL(a);
+  TEST_ASSERT_NOT_NULL(b);
+  test_assert_ok(gltf_accessor_read_f32_range(full, 0, 0, count, a, 16, &err), &err, "read(full)");
+  test_assert_ok(gltf_accessor_read_f32_range(g_doc, 0, 0, count, b, 16, &err), &err, "read(geometry)");
+  for (uint32_t e = 0; e < count; e++) {
+    TEST_ASSERT_EQUAL_MEMORY(&a[e * 16u], &b[e * 16u], sizeof(float));
+  }
+  free(a);
+  free(b);
+  gltf_free(full);
+
+  // Skipped sections are not sized either.
+  TEST_ASSERT_TRUE(t27_block_bytes(GLTF_LOAD_SECTION_GEOMETRY) < t27_block_bytes(0u));
+  TEST_ASSERT_TRUE(t27_block_bytes(GLTF_LOAD_SECTION_SCENES) < t27_block_bytes(GLTF_LOAD_SECTION_GEOMETRY));
+}
+
+void test_27_load_sections_skip_buffers(void) {
+  // Images only: no buffer I/O, no geometry, no scene graph.
+  gltf_load_options opts = {0};
+  opts.sections = GLTF_LOAD_SECTION_IMAGES;
+  gltf_error err = {0};
+  gltf_result rc = gltf_load_file_ex(T27_MATERIALS, &opts, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_file_ex(images)");
+  TEST_ASSERT_TRUE(gltf_doc_image_count(g_doc) >= 3u);
+  TEST_ASSERT_NOT_NULL(gltf_image_resolved_uri(g_doc, 0));
+  TEST_ASSERT_EQUAL_UINT32(0u, gltf_doc_node_count(g_doc));
+  TEST_ASSERT_EQUAL_UINT32(0u, gltf_doc_mesh_count(g_doc));
+  TEST_ASSERT_EQUAL_UINT32(0u, gltf_doc_accessor_count(g_doc));
+  TEST_ASSERT_EQUAL_UINT32(0u, gltf_doc_material_count(g_doc));
+  TEST_ASSERT_EQUAL_INT32(-1, gltf_doc_default_scene(g_doc));
+  gltf_free(g_doc);
+  g_doc = NULL;
+
+  // A missing buffer file only fails loads that ask for buffers.
+  const char* missing = GLTF_REPO_ROOT "/tests/fixtures/10-missing-buffer.gltf";
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_IO, gltf_load_file(missing, &g_doc, &err));
+  TEST_ASSERT_NULL(g_doc);
+
+  opts.sections = GLTF_LOAD_SECTION_SCENES | GLTF_LOAD_SECTION_MESHES | GLTF_LOAD_SECTION_ACCESSORS;
+  rc = gltf_load_file_ex(missing, &opts, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_file_ex(no buffers)");
+  TEST_ASSERT_EQUAL_STRING("Lazy", gltf_doc_node_name(g_doc, 0));
+  TEST_ASSERT_EQUAL_UINT32(1u, gltf_doc_accessor_count(g_doc));
+  float v[3];
+  TEST_ASSERT_NOT_EQUAL(GLTF_OK, gltf_accessor_read_f32(g_doc, 0, 0, v, 3, &err));
+}
+
+void test_27_load_sections_image_buffer_view(void) {
+  // An image stored in a bufferView pulls in bufferViews and buffers.
+  static const char* k_json =
+    "{\"asset\":{\"version\":\"2.0\"},"
+    "\"nodes\":[{\"name\":\"n\"}],"
+    "\"buffers\":[{\"byteLength\":8}],"
+    "\"bufferViews\":[{\"buffer\":0,\"byteLength\":8}],"
+    "\"images\":[{\"bufferView\":0,\"mimeType\":\"image/png\"}]}";
+  const uint8_t bin[8] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+  size_t size = 0;
+  uint8_t* glb = test_build_glb(k_json, bin, sizeof bin, &size);
+
+  gltf_load_options opts = {0};
+  opts.sections = GLTF_LOAD_SECTION_IMAGES;
+  gltf_error err = {0};
+  gltf_result rc = gltf_load_glb_bytes_ex(glb, size, &opts, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_glb_bytes_ex(images)");
+  TEST_ASSERT_EQUAL_UINT32(0u, gltf_doc_node_count(g_doc));
+
+  const gltf_image* img = NULL;
+  TEST_ASSERT_EQUAL_INT(1, gltf_doc_image(g_doc, 0, &img));
+  TEST_ASSERT_EQUAL_INT(GLTF_IMAGE_BUFFER_VIEW, img->kind);
+  TEST_ASSERT_EQUAL_STRING("image/png", img->mime_type);
+  free(glb);
+}
+
+void test_27_load_sections_cached(void) {
+  const char* cache = GLTF_TEST_OUT_DIR "/t27_materials.gltfb";
+  (void)remove(cache);
+
+  // A geometry-only cache cannot serve a full load, and is rebuilt.
+  gltf_load_options opts = {0};
+  opts.sections = GLTF_LOAD_SECTION_GEOMETRY;
+  gltf_error err = {0};
+  gltf_result rc = gltf_load_file_cached(T27_MATERIALS, cache, &opts, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_file_cached(geometry)");
+  TEST_ASSERT_EQUAL_UINT32(0u, gltf_doc_material_count(g_doc));
+  gltf_free(g_doc);
+  g_doc = NULL;
+
+  rc = gltf_load_file_cached(T27_MATERIALS, cache, NULL, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_file_cached(all)");
+  TEST_ASSERT_TRUE(gltf_doc_material_count(g_doc) > 0u);
+  gltf_free(g_doc);
+  g_doc = NULL;
+
+  // A full cache serves the subset.
+  rc = gltf_load_file_cached(T27_MATERIALS, cache, &opts, &g_doc, &err);
+  test_assert_ok(rc, &err, "gltf_load_file_cached(subset)");
+  TEST_ASSERT_TRUE(gltf_doc_mesh_count(g_doc) > 0u);
+}
@@ -0,0 +1,184 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern gltf_doc* g_doc;
+
+#define T28_FILES 5u       // external buffers
+#define T28_BUFFERS 7u     // + 2 data: URI buffers
+#define T28_FILE_BYTES 64u
+#define T28_OUT GLTF_TEST_OUT_DIR "/t28_"
+
+static uint8_t t28_expected(uint32_t b, uint32_t i) {
+  if (b >= T28_FILES) return (uint8_t)(i + (b - T28_FILES) * 4u); // AAECAw== / BAUGBw==
+  return (uint8_t)((i * 7u + b * 13u) & 255u);
+}
+
+// Writes a .gltf with T28_FILES external .bin buffers and two data: URIs,
+// one u8 SCALAR accessor per buffer. skip_file < T28_FILES leaves that .bin out.
+static void t28_write_asset(const char* gltf_path, uint32_t skip_file) {
+  char json[4096];
+  size_t n = (size_t)snprintf(json, sizeof json, "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[");
+  for (uint32_t b = 0; b < T28_FILES; b++) {
+    char bin_path[512];
+    (void)snprintf(bin_path, sizeof bin_path, T28_OUT "buffer%u.bin", b);
+    (void)remove(bin_path);
+    if (b != skip_file) {
+      uint8_t bytes[T28_FILE_BYTES];
+      for (uint32_t i = 0; i < T28_FILE_BYTES; i++) bytes[i] = t28_expected(b, i);
+      FILE* f = fopen(bin_path, "wb");
+      TEST_ASSERT_NOT_NULL(f);
+      TEST_ASSERT_EQUAL_size_t(sizeof bytes, fwrite(bytes, 1, sizeof bytes, f));
+      TEST_ASSERT_EQUAL_INT(0, fclose(f));
+    }
+    n += (size_t)snprintf(json + n, sizeof json - n, "{\"byteLength\":%u,\"uri\":\"t28_buffer%u.bin\"},",
+                          T28_FILE_BYTES, b);
+  }
+  n += (size_t)snprintf(json + n, sizeof json - n,
+                        "{\"byteLength\":4,\"uri\":\"data:application/octet-stream;base64,AAECAw==\"},"
+                        "{\"byteLength\":4,\"uri\":\"data:application/octet-stream;base64,BAUGBw==\"}],"
+                        "\"bufferViews\":[");
+  for (uint32_t b = 0; b < T28_BUFFERS; b++) {
+    n += (size_t)snprintf(json + n, sizeof json - n, "%s{\"buffer\":%u,\"byteLength\":%u}",
+                          b ? "," : "", b, b < T28_FILES ? T28_FILE_BYTES : 4u);
+  }
+  n += (size_t)snprintf(json + n, sizeof json - n, "],\"accessors\":[");
+  for (uint32_t b = 0; b < T28_BUFFERS; b++) {
+    n += (size_t)snprintf(json + n, sizeof json - n,
+                          "%s{\"bufferView\":%u,\"componentType\":5121,\"count\":%u,\"type\":\"SCALAR\"}",
+                          b ? "," : "", b, b < T28_FILES ? T28_FILE_BYTES : 4u);
+  }
+  n += (size_t)snprintf(json + n, sizeof json - n, "]}");
+  TEST_ASSERT_TRUE(n < sizeof json);
+
+  FILE* f = fopen(gltf_path, "wb");
+  TEST_ASSERT_NOT_NULL(f);
+  TEST_ASSERT_EQUAL_size_t(n, fwrite(json, 1, n, f));
+  TEST_ASSERT_EQUAL_INT(0, fclose(f));
+}
+
+static void t28_check(const gltf_doc* doc) {
+  TEST_ASSERT_EQUAL_UINT32(T28_BUFFERS, gltf_doc_accessor_count(doc));
+  for (uint32_t b = 0; b < T28_BUFFERS; b++) {
+    float v[T28_FILE_BYTES];
+    const uint32_t count = b < T28_FILES ? T28_FILE_BYTES : 4u;
+    gltf_error err = {0};
+    test_assert_ok(gltf_accessor_read_f32_range(doc, b, 0, count, v, 0, &err), &err, "read");
+    for (uint32_t i = 0; i < count; i++) TEST_ASSERT_EQUAL_FLOAT((float)t28_expected(b, i), v[i]);
+  }
+}
+
+// Records the task count, then runs the tasks in reverse order.
+static void t28_reverse_dispatch(void* user, uint32_t task_count, gltf_task_fn task, void* task_user) {
+  *(uint32_t*)user += task_count;
+  for (uint32_t i = task_count; i-- > 0;) task(task_user, i);
+}
+
+void test_28_parallel_buffer_loads(void) {
+  const char* path = T28_OUT "asset.gltf";
+  t28_write_asset(path, T28_FILES);
+
+  // One task per buffer that needs reading or decoding.
+  uint32_t tasks = 0;
+  gltf_load_options opts = {0};
+  opts.dispatch = t28_reverse_dispatch;
+  opts.dispatch_user = &tasks;
+  gltf_error err = {0};
+  test_assert_ok(gltf_load_file_ex(path, &opts, &g_doc, &err), &err, "gltf_load_file_ex(reverse)");
+  TEST_ASSERT_EQUAL_UINT32(T28_BUFFERS, tasks);
+  t28_check(g_doc);
+  gltf_free(g_doc);
+  g_doc = NULL;
+
+  // Built-in pool, memory-mapped files.
+  gltf_thread_pool* pool = NULL;
+  test_assert_ok(gltf_thread_pool_create(3, &pool, &err), &err, "gltf_thread_pool_create");
+  opts.dispatch = gltf_thread_pool_dispatch;
+  opts.dispatch_user = pool;
+  for (uint32_t run = 0; run < 2u; run++) {
+    opts.flags = run ? GLTF_LOAD_MMAP : GLTF_LOAD_DEFAULT;
+    test_assert_ok(gltf_load_file_ex(path, &opts, &g_doc, &err), &err, "gltf_load_file_ex(pool)");
+    t28_check(g_doc);
+    gltf_free(g_doc);
+    g_doc = NULL;
+  }
+
+  // Lazy buffers are not read up front: nothing is dispatched.
+  tasks = 0;
+  opts.flags = GLTF_LOAD_LAZY_BUFFERS;
+  opts.dispatch = t28_reverse_dispatch;
+  opts.dispatch_user = &tasks;
+  test_assert_ok(gltf_load_file_ex(path, &opts, &g_doc, &err), &err, "gltf_load_file_ex(lazy)");
+  TEST_ASSERT_EQUAL_UINT32(0u, tasks);
+  t28_check(g_doc);
+  gltf_free(g_doc);
+  g_doc = NULL;
+
+  // A missing file fails the load like the serial path.
+  t28_write_asset(path, 2u);
+  opts.flags = GLTF_LOAD_DEFAULT;
+  opts.dispatch = gltf_thread_pool_dispatch;
+  opts.dispatch_user = pool;
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_IO, gltf_load_file_ex(path, &opts, &g_doc, &err));
+  TEST_ASSERT_NULL(g_doc);
+  TEST_ASSERT_EQUAL_STRING("root.buffers[].uri", err.path);
+
+  gltf_thread_pool_free(pool);
+}
+
+void test_28_load_files_batch(void) {
+  t28_write_asset(T28_OUT "batch.gltf", T28_FILES);
+  const char* paths[] = {
+    T28_OUT "batch.gltf",
+    GLTF_REPO_ROOT "/tests/fixtures/05-materials.gltf",
+    GLTF_REPO_ROOT "/tests/fixtures/07-basic.glb",
+    GLTF_REPO_ROOT "/tests/fixtures/does-not-exist.gltf",
+    GLTF_REPO_ROOT "/tests/fixtures/03-tri.gltf",
+  };
+  const uint32_t count = (uint32_t)(sizeof paths / sizeof paths[0]);
+  gltf_load_result results[5];
+
+  gltf_error err = {0};
+  gltf_thread_pool* pool = NULL;
+  test_assert_ok(gltf_thread_pool_create(2, &pool, &err), &err, "gltf_thread_pool_create");
+
+  // The options' own dispatch would re-enter the pool; it is not used per file.
+  gltf_load_options opts = {0};
+  opts.dispatch = gltf_thread_pool_dispatch;
+  opts.dispatch_user = pool;
+  gltf_result rc = gltf_load_files(paths, count, &opts, results, gltf_thread_pool_dispatch, pool, &err);
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_IO, rc);
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_IO, results[3].result);
+  TEST_ASSERT_NULL(results[3].doc);
+
+  for (uint32_t i = 0; i < count; i++) {
+    if (i == 3u) continue;
+    test_assert_ok(results[i].result, &results[i].error, "gltf_load_files entry");
+    TEST_ASSERT_NOT_NULL(results[i].doc);
+  }
+  t28_check(results[0].doc);
+  TEST_ASSERT_TRUE(gltf_doc_material_count(results[1].doc) > 0u);
+  TEST_ASSERT_TRUE(gltf_doc_mesh_count(results[2].doc) > 0u);
+
+  // Same documents when loaded serially.
+  for (uint32_t i = 0; i < count; i++) {
+    if (i == 3u) continue;
+    gltf_doc* serial = NULL;
+    test_assert_ok(gltf_load_file(paths[i], &serial, &err), &err, "gltf_load_file");
+    TEST_ASSERT_EQUAL_UINT32(gltf_doc_accessor_count(serial), gltf_doc_accessor_count(results[i].doc));
+    TEST_ASSERT_EQUAL_UINT32(gltf_doc_node_count(serial), gltf_doc_node_count(results[i].doc));
+    gltf_free(serial);
+    gltf_free(results[i].doc);
+  }
+
+  TEST_ASSERT_EQUAL_INT(GLTF_OK, gltf_load_files(NULL, 0, NULL, NULL, NULL, NULL, &err));
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_load_files(paths, count, NULL, NULL, NULL, NULL, &err));
+  gltf_thread_pool_free(pool);
+}
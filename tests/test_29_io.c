@@ -0,0 +1,221 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern gltf_doc* g_doc;
+
+#define T29_FIXTURES GLTF_REPO_ROOT "/tests/fixtures/"
+#define T29_MAX_FILES 8u
+
+// Memory-backed gltf_io: files are read from disk once into a table (the
+// "cache") and then served from it.
+typedef struct t29_file {
+  char path[512];
+  uint8_t* data;
+  size_t size;
+} t29_file;
+
+typedef struct t29_io {
+  t29_file files[T29_MAX_FILES];
+  uint32_t file_count;
+  uint32_t opens, closes, reads, maps, releases;
+} t29_io;
+
+static void* t29_open(void* user, const char* path) {
+  t29_io* io = (t29_io*)user;
+  io->opens++;
+  for (uint32_t i = 0; i < io->file_count; i++) {
+    if (strcmp(io->files[i].path, path) == 0) return &io->files[i];
+  }
+
+  FILE* f = fopen(path, "rb");
+  if (!f || io->file_count == T29_MAX_FILES) {
+    if (f) fclose(f);
+    io->opens--;
+    return NULL;
+  }
+  t29_file* e = &io->files[io->file_count++];
+  (void)snprintf(e->path, sizeof e->path, "%s", path);
+  fseek(f, 0, SEEK_END);
+  e->size = (size_t)ftell(f);
+  fseek(f, 0, SEEK_SET);
+  e->data = (uint8_t*)malloc(e->size ? e->size : 1u);
+  TEST_ASSERT_NOT_NULL(e->data);
+  TEST_ASSERT_EQUAL_size_t(e->size, fread(e->data, 1, e->size, f));
+  fclose(f);
+  return e;
+}
+
+static int t29_size(void* user, void* file, uint64_t* out_size) {
+  (void)user;
+  *out_size = ((const t29_file*)file)->size;
+  return 1;
+}
+
+static int t29_read(void* user, void* file, uint64_t offset, void* dst, size_t size) {
+  const t29_file* e = (const t29_file*)file;
+  ((t29_io*)user)->reads++;
+  if (offset > e->size || size > e->size - offset) return 0;
+  memcpy(dst, e->data + offset, size);
+  return 1;
+}
+
+static const uint8_t* t29_map(void* user, void* file, size_t size) {
+  const t29_file* e = (const t29_file*)file;
+  ((t29_io*)user)->maps++;
+  return size == e->size ? e->data : NULL;
+}
+
+static void t29_release(void* user, const uint8_t* data, size_t size) {
+  (void)data;
+  (void)size;
+  ((t29_io*)user)->releases++;
+}
+
+static void t29_close(void* user, void* file) {
+  (void)file;
+  ((t29_io*)user)->closes++;
+}
+
+static gltf_io t29_make_io(t29_io* state, int with_map) {
+  memset(state, 0, sizeof *state);
+  gltf_io io = { t29_open, t29_size, t29_read, NULL, NULL, t29_close, state };
+  if (with_map) {
+    io.map = t29_map;
+    io.release = t29_release;
+  }
+  return io;
+}
+
+static void t29_free_files(t29_io* state) {
+  for (uint32_t i = 0; i < state->file_count; i++) free(state->files[i].data);
+  state->file_count = 0;
+}
+
+// 1 if p lies inside a file held by the io.
+static int t29_served(const t29_io* state, const uint8_t* p) {
+  for (uint32_t i = 0; i < state->file_count; i++) {
+    const t29_file* e = &state->files[i];
+    if (p >= e->data && p < e->data + e->size) return 1;
+  }
+  return 0;
+}
+
+// Accessor 0 of doc reads the same as the OS-loaded path.
+static void t29_check_matches(const char* path, const gltf_doc* doc) {
+  gltf_error err = {0};
+  gltf_doc* ref = NULL;
+  test_assert_ok(gltf_load_file(path, &ref, &err), &err, "gltf_load_file");
+  TEST_ASSERT_EQUAL_UINT32(gltf_doc_accessor_count(ref), gltf_doc_accessor_count(doc));
+
+  gltf_span a, b;
+  test_assert_ok(gltf_accessor_span(ref, 0, &a, &err), &err, "span(ref)");
+  test_assert_ok(gltf_accessor_span(doc, 0, &b, &err), &err, "span(io)");
+  TEST_ASSERT_EQUAL_UINT32(a.count, b.count);
+  TEST_ASSERT_EQUAL_UINT32(a.stride, b.stride);
+  TEST_ASSERT_EQUAL_MEMORY(a.ptr, b.ptr, (size_t)(a.count - 1u) * a.stride + a.elem_size);
+  gltf_free(ref);
+}
+
+void test_29_io_serves_buffers_in_place(void) {
+  t29_io state;
+  const gltf_io io = t29_make_io(&state, 1);
+  gltf_load_options opts = {0};
+  opts.io = &io;
+  gltf_error err = {0};
+
+  // .gltf with an external buffer: the buffer is the io's memory.
+  const char* path = T29_FIXTURES "05-materials.gltf";
+  test_assert_ok(gltf_load_file_ex(path, &opts, &g_doc, &err), &err, "gltf_load_file_ex(gltf)");
+  gltf_span span;
+  test_assert_ok(gltf_accessor_span(g_doc, 0, &span, &err), &err, "span");
+  TEST_ASSERT_TRUE(t29_served(&state, span.ptr));
+  TEST_ASSERT_EQUAL_UINT32(state.opens, state.closes);
+  TEST_ASSERT_TRUE(state.maps > state.releases);
+  t29_check_matches(path, g_doc);
+
+#if GLTF_ENABLE_IMAGES
+  // URI images are mapped for the decode and released afterwards.
+  const uint32_t maps = state.maps;
+  gltf_image_info info = {0};
+  test_assert_ok(gltf_image_get_info(g_doc, 0, &info, &err), &err, "gltf_image_get_info");
+  TEST_ASSERT_TRUE(info.width > 0u);
+  TEST_ASSERT_EQUAL_UINT32(maps + 1u, state.maps);
+#endif
+
+  gltf_free(g_doc);
+  g_doc = NULL;
+  TEST_ASSERT_EQUAL_UINT32(state.maps, state.releases);
+
+  // .glb: buffers[0] borrows the BIN chunk of the mapped file.
+  path = T29_FIXTURES "07-basic.glb";
+  test_assert_ok(gltf_load_file_ex(path, &opts, &g_doc, &err), &err, "gltf_load_file_ex(glb)");
+  test_assert_ok(gltf_accessor_span(g_doc, 0, &span, &err), &err, "span");
+  TEST_ASSERT_TRUE(t29_served(&state, span.ptr));
+  t29_check_matches(path, g_doc);
+  gltf_free(g_doc);
+  g_doc = NULL;
+  TEST_ASSERT_EQUAL_UINT32(state.maps, state.releases);
+
+  // Lazy buffers are opened through io on first use.
+  path = T29_FIXTURES "03-tri.gltf";
+  opts.flags = GLTF_LOAD_LAZY_BUFFERS;
+  test_assert_ok(gltf_load_file_ex(path, &opts, &g_doc, &err), &err, "gltf_load_file_ex(lazy)");
+  const uint32_t opens = state.opens;
+  test_assert_ok(gltf_accessor_span(g_doc, 0, &span, &err), &err, "span");
+  TEST_ASSERT_EQUAL_UINT32(opens + 1u, state.opens);
+  TEST_ASSERT_TRUE(t29_served(&state, span.ptr));
+  gltf_free(g_doc);
+  g_doc = NULL;
+  TEST_ASSERT_EQUAL_UINT32(state.maps, state.releases);
+  TEST_ASSERT_EQUAL_UINT32(state.opens, state.closes);
+
+  t29_free_files(&state);
+}
+
+void test_29_io_reads_without_map(void) {
+  t29_io state;
+  gltf_io io = t29_make_io(&state, 0);
+  gltf_load_options opts = {0};
+  opts.io = &io;
+  gltf_error err = {0};
+
+  // Without map every file is read into memory the document owns.
+  const char* paths[] = { T29_FIXTURES "05-materials.gltf", T29_FIXTURES "07-basic.glb" };
+  for (uint32_t i = 0; i < 2u; i++) {
+    test_assert_ok(gltf_load_file_ex(paths[i], &opts, &g_doc, &err), &err, "gltf_load_file_ex");
+    gltf_span span;
+    test_assert_ok(gltf_accessor_span(g_doc, 0, &span, &err), &err, "span");
+    TEST_ASSERT_FALSE(t29_served(&state, span.ptr));
+    t29_check_matches(paths[i], g_doc);
+    gltf_free(g_doc);
+    g_doc = NULL;
+  }
+  TEST_ASSERT_EQUAL_UINT32(0u, state.maps);
+  TEST_ASSERT_TRUE(state.reads >= 3u);
+  TEST_ASSERT_EQUAL_UINT32(state.opens, state.closes);
+
+  // Files the io cannot open fail like missing files.
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_IO, gltf_load_file_ex(T29_FIXTURES "missing.gltf", &opts, &g_doc, &err));
+  TEST_ASSERT_NULL(g_doc);
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_IO,
+                        gltf_load_file_ex(T29_FIXTURES "10-missing-buffer.gltf", &opts, &g_doc, &err));
+  TEST_ASSERT_NULL(g_doc);
+
+  // map and release come together.
+  io.map = t29_map;
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_load_file_ex(paths[0], &opts, &g_doc, &err));
+  io.map = NULL;
+  io.close = NULL;
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_load_file_ex(paths[0], &opts, &g_doc, &err));
+  TEST_ASSERT_NULL(g_doc);
+
+  t29_free_files(&state);
+}
@@ -0,0 +1,182 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern gltf_doc* g_doc;
+
+static uint8_t* t30_read_file(const char* path, size_t* out_size) {
+  FILE* f = fopen(path, "rb");
+  TEST_ASSERT_NOT_NULL(f);
+  fseek(f, 0, SEEK_END);
+  const long n = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  uint8_t* data = (uint8_t*)malloc((size_t)n);
+  TEST_ASSERT_NOT_NULL(data);
+  TEST_ASSERT_EQUAL_size_t((size_t)n, fread(data, 1, (size_t)n, f));
+  fclose(f);
+  *out_size = (size_t)n;
+  return data;
+}
+
+void test_30_glb_stream_views_become_ready(void) {
+  static const char* k_json =
+    "{\"asset\":{\"version\":\"2.0\"},"
+    "\"buffers\":[{\"byteLength\":16}],"
+    "\"bufferViews\":[{\"buffer\":0,\"byteLength\":8},{\"buffer\":0,\"byteOffset\":8,\"byteLength\":8}],"
+    "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":2,\"type\":\"SCALAR\"},"
+    "{\"bufferView\":1,\"componentType\":5126,\"count\":2,\"type\":\"SCALAR\"}]}";
+  const float bin[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+  size_t size = 0;
+  uint8_t* glb = test_build_glb(k_json, bin, sizeof bin, &size);
+  const size_t bin_start = size - sizeof bin;
+
+  gltf_glb_stream* s = NULL;
+  gltf_error err = {0};
+  test_assert_ok(gltf_glb_stream_create(NULL, &s, &err), &err, "gltf_glb_stream_create");
+
+  // No document until the BIN chunk header is in.
+  test_assert_ok(gltf_glb_stream_feed(s, glb, bin_start - 1u, &err), &err, "feed(json)");
+  TEST_ASSERT_NULL(gltf_glb_stream_doc(s));
+  TEST_ASSERT_EQUAL_INT(0, gltf_glb_stream_buffer_view_ready(s, 0));
+  test_assert_ok(gltf_glb_stream_feed(s, glb + bin_start - 1u, 1u, &err), &err, "feed(bin header)");
+  const gltf_doc* doc = gltf_glb_stream_doc(s);
+  TEST_ASSERT_NOT_NULL(doc);
+  TEST_ASSERT_EQUAL_UINT32(2u, gltf_doc_accessor_count(doc));
+  TEST_ASSERT_EQUAL_INT(0, gltf_glb_stream_buffer_view_ready(s, 0));
+
+  // Views become ready as their last byte arrives.
+  test_assert_ok(gltf_glb_stream_feed(s, glb + bin_start, 7u, &err), &err, "feed(7)");
+  TEST_ASSERT_EQUAL_INT(0, gltf_glb_stream_buffer_view_ready(s, 0));
+  test_assert_ok(gltf_glb_stream_feed(s, glb + bin_start + 7u, 1u, &err), &err, "feed(8)");
+  TEST_ASSERT_EQUAL_INT(1, gltf_glb_stream_buffer_view_ready(s, 0));
+  TEST_ASSERT_EQUAL_INT(0, gltf_glb_stream_buffer_view_ready(s, 1));
+  TEST_ASSERT_EQUAL_INT(0, gltf_glb_stream_buffer_view_ready(s, 2));
+
+  float v[2];
+  test_assert_ok(gltf_accessor_read_f32_range(doc, 0, 0, 2, v, 0, &err), &err, "read(view 0)");
+  TEST_ASSERT_EQUAL_FLOAT(1.0f, v[0]);
+  TEST_ASSERT_EQUAL_FLOAT(2.0f, v[1]);
+
+  test_assert_ok(gltf_glb_stream_feed(s, glb + bin_start + 8u, 8u, &err), &err, "feed(rest)");
+  TEST_ASSERT_EQUAL_INT(1, gltf_glb_stream_buffer_view_ready(s, 1));
+
+  // The finished document is the one that was streamed.
+  test_assert_ok(gltf_glb_stream_finish(s, &g_doc, &err), &err, "gltf_glb_stream_finish");
+  TEST_ASSERT_EQUAL_PTR(doc, g_doc);
+  test_assert_ok(gltf_accessor_read_f32_range(g_doc, 1, 0, 2, v, 0, &err), &err, "read(view 1)");
+  TEST_ASSERT_EQUAL_FLOAT(3.0f, v[0]);
+  TEST_ASSERT_EQUAL_FLOAT(4.0f, v[1]);
+  free(glb);
+}
+
+void test_30_glb_stream_sparse_waits_for_views(void) {
+  // Accessor 0: base view 0 (1, 2) with element 1 replaced by view 2 (9).
+  static const char* k_json =
+    "{\"asset\":{\"version\":\"2.0\"},"
+    "\"buffers\":[{\"byteLength\":16}],"
+    "\"bufferViews\":[{\"buffer\":0,\"byteLength\":8},{\"buffer\":0,\"byteOffset\":8,\"byteLength\":4},"
+    "{\"buffer\":0,\"byteOffset\":12,\"byteLength\":4}],"
+    "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":2,\"type\":\"SCALAR\","
+    "\"sparse\":{\"count\":1,\"indices\":{\"bufferView\":1,\"componentType\":5123},"
+    "\"values\":{\"bufferView\":2}}}]}";
+  uint8_t bin[16] = {0};
+  const float base[2] = { 1.0f, 2.0f }, value = 9.0f;
+  memcpy(bin, base, sizeof base);
+  bin[8] = 1u; // u16 index 1
+  memcpy(bin + 12, &value, sizeof value);
+  size_t size = 0;
+  uint8_t* glb = test_build_glb(k_json, bin, sizeof bin, &size);
+  const size_t bin_start = size - sizeof bin;
+
+  gltf_glb_stream* s = NULL;
+  gltf_error err = {0};
+  test_assert_ok(gltf_glb_stream_create(NULL, &s, &err), &err, "gltf_glb_stream_create");
+  test_assert_ok(gltf_glb_stream_feed(s, glb, bin_start + 12u, &err), &err, "feed(no values)");
+  const gltf_doc* doc = gltf_glb_stream_doc(s);
+  TEST_ASSERT_NOT_NULL(doc);
+  TEST_ASSERT_EQUAL_INT(0, gltf_glb_stream_buffer_view_ready(s, 2));
+
+  // The values have not arrived: nothing is cached from the missing bytes.
+  gltf_span span;
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_IO, gltf_accessor_span(doc, 0, &span, &err));
+  TEST_ASSERT_EQUAL_STRING("buffer view not ready", err.message);
+
+  test_assert_ok(gltf_glb_stream_feed(s, glb + bin_start + 12u, 4u, &err), &err, "feed(values)");
+  float v[2];
+  test_assert_ok(gltf_accessor_read_f32_range(doc, 0, 0, 2, v, 0, &err), &err, "read(streamed)");
+  TEST_ASSERT_EQUAL_FLOAT(1.0f, v[0]);
+  TEST_ASSERT_EQUAL_FLOAT(9.0f, v[1]);
+
+  test_assert_ok(gltf_glb_stream_finish(s, &g_doc, &err), &err, "gltf_glb_stream_finish");
+  test_assert_ok(gltf_accessor_read_f32_range(g_doc, 0, 0, 2, v, 0, &err), &err, "read(finished)");
+  TEST_ASSERT_EQUAL_FLOAT(9.0f, v[1]);
+  free(glb);
+}
+
+void test_30_glb_stream_matches_whole_file(void) {
+  size_t size = 0;
+  uint8_t* glb = t30_read_file(GLTF_REPO_ROOT "/tests/fixtures/07-basic.glb", &size);
+  gltf_error err = {0};
+  gltf_doc* ref = NULL;
+  test_assert_ok(gltf_load_glb_bytes(glb, size, &ref, &err), &err, "gltf_load_glb_bytes");
+
+  const size_t pieces[] = { 1u, 5u, 37u, 4096u };
+  for (uint32_t p = 0; p < 4u; p++) {
+    gltf_glb_stream* s = NULL;
+    test_assert_ok(gltf_glb_stream_create(NULL, &s, &err), &err, "gltf_glb_stream_create");
+    for (size_t off = 0; off < size; off += pieces[p]) {
+      const size_t n = size - off < pieces[p] ? size - off : pieces[p];
+      test_assert_ok(gltf_glb_stream_feed(s, glb + off, n, &err), &err, "gltf_glb_stream_feed");
+    }
+    test_assert_ok(gltf_glb_stream_finish(s, &g_doc, &err), &err, "gltf_glb_stream_finish");
+
+    TEST_ASSERT_EQUAL_UINT32(gltf_doc_mesh_count(ref), gltf_doc_mesh_count(g_doc));
+    TEST_ASSERT_EQUAL_UINT32(gltf_doc_accessor_count(ref), gltf_doc_accessor_count(g_doc));
+    for (uint32_t a = 0; a < gltf_doc_accessor_count(ref); a++) {
+      gltf_span x, y;
+      test_assert_ok(gltf_accessor_span(ref, a, &x, &err), &err, "span(ref)");
+      test_assert_ok(gltf_accessor_span(g_doc, a, &y, &err), &err, "span(stream)");
+      TEST_ASSERT_EQUAL_UINT32(x.count, y.count);
+      TEST_ASSERT_EQUAL_MEMORY(x.ptr, y.ptr, (size_t)(x.count - 1u) * x.stride + x.elem_size);
+    }
+    gltf_free(g_doc);
+    g_doc = NULL;
+  }
+  gltf_free(ref);
+
+  // Bytes past the header's length fail the stream, and it stays failed.
+  gltf_glb_stream* s = NULL;
+  test_assert_ok(gltf_glb_stream_create(NULL, &s, &err), &err, "gltf_glb_stream_create");
+  test_assert_ok(gltf_glb_stream_feed(s, glb, size, &err), &err, "feed(all)");
+  const uint8_t extra[4] = {0};
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_glb_stream_feed(s, extra, sizeof extra, &err));
+  TEST_ASSERT_NULL(gltf_glb_stream_doc(s));
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_glb_stream_finish(s, &g_doc, &err));
+  TEST_ASSERT_NULL(g_doc);
+
+  // An incomplete file cannot be finished; abandoning a stream frees it.
+  test_assert_ok(gltf_glb_stream_create(NULL, &s, &err), &err, "gltf_glb_stream_create");
+  test_assert_ok(gltf_glb_stream_feed(s, glb, size - 4u, &err), &err, "feed(partial)");
+  TEST_ASSERT_NOT_NULL(gltf_glb_stream_doc(s));
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_glb_stream_finish(s, &g_doc, &err));
+  TEST_ASSERT_NULL(g_doc);
+
+  test_assert_ok(gltf_glb_stream_create(NULL, &s, &err), &err, "gltf_glb_stream_create");
+  test_assert_ok(gltf_glb_stream_feed(s, glb, size / 2u, &err), &err, "feed(half)");
+  gltf_glb_stream_free(s);
+
+  // Bad containers are rejected as soon as the header arrives.
+  glb[0] = 'x';
+  test_assert_ok(gltf_glb_stream_create(NULL, &s, &err), &err, "gltf_glb_stream_create");
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_glb_stream_feed(s, glb, 12u, &err));
+  TEST_ASSERT_EQUAL_STRING("bad magic", err.message);
+  gltf_glb_stream_free(s);
+  free(glb);
+}
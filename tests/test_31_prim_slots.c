@@ -0,0 +1,126 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern gltf_doc* g_doc;
+
+// 3 vertices: POSITION (f32 VEC3) at 0, TEXCOORD (f32 VEC2) at 36, COLOR_0
+// (normalized u8 VEC4) at 60, u16 indices at 72.
+static const char* k_t31_json =
+  "{\"asset\":{\"version\":\"2.0\"},"
+  "\"buffers\":[{\"byteLength\":80}],"
+  "\"bufferViews\":[{\"buffer\":0,\"byteLength\":36},{\"buffer\":0,\"byteOffset\":36,\"byteLength\":24},"
+  "{\"buffer\":0,\"byteOffset\":60,\"byteLength\":12},{\"buffer\":0,\"byteOffset\":72,\"byteLength\":6}],"
+  "\"accessors\":["
+  "{\"bufferView\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"},"
+  "{\"bufferView\":1,\"componentType\":5126,\"count\":3,\"type\":\"VEC2\"},"
+  "{\"bufferView\":2,\"componentType\":5121,\"normalized\":true,\"count\":3,\"type\":\"VEC4\"},"
+  "{\"bufferView\":3,\"componentType\":5123,\"count\":3,\"type\":\"SCALAR\"},"
+  "{\"bufferView\":1,\"componentType\":5126,\"count\":9,\"type\":\"VEC3\"}],"
+  "\"meshes\":[{\"primitives\":["
+  "{\"attributes\":{\"POSITION\":0,\"TEXCOORD_0\":1,\"TEXCOORD_5\":1,\"COLOR_0\":2},\"indices\":3},"
+  "{\"attributes\":{\"POSITION\":0,\"NORMAL\":4}},"
+  "{\"attributes\":{\"POSITION\":0}}]}]}";
+
+static uint8_t* t31_build(size_t* out_size) {
+  uint8_t bin[80];
+  memset(bin, 0, sizeof bin);
+  for (uint32_t i = 0; i < 15u; i++) {
+    const float f = (float)i;
+    memcpy(bin + i * 4u, &f, sizeof f);
+  }
+  for (uint32_t i = 0; i < 12u; i++) bin[60u + i] = (uint8_t)(i * 20u);
+  const uint16_t idx[3] = { 2, 1, 0 };
+  memcpy(bin + 72, idx, sizeof idx);
+  return test_build_glb(k_t31_json, bin, sizeof bin, out_size);
+}
+
+void test_31_prim_view_fills_slots(void) {
+  size_t size = 0;
+  uint8_t* glb = t31_build(&size);
+  gltf_error err = {0};
+  test_assert_ok(gltf_load_glb_bytes(glb, size, &g_doc, &err), &err, "gltf_load_glb_bytes");
+
+  gltf_draw_primitive_view view;
+  test_assert_ok(gltf_mesh_primitive_view(g_doc, 0, 0, &view, &err), &err, "gltf_mesh_primitive_view");
+  const uint32_t expected_mask = (1u << GLTF_ATTR_SLOT_POSITION) | (1u << GLTF_ATTR_SLOT_TEXCOORD_0) |
+                                 (1u << GLTF_ATTR_SLOT_COLOR_0);
+  TEST_ASSERT_EQUAL_HEX32(expected_mask, view.attribute_mask);
+  TEST_ASSERT_EQUAL_HEX32(1u << GLTF_ATTR_SLOT_COLOR_0, view.normalized_mask);
+  TEST_ASSERT_EQUAL_UINT32(GLTF_COMP_U8, view.attribute_component_type[GLTF_ATTR_SLOT_COLOR_0]);
+  TEST_ASSERT_EQUAL_UINT32(GLTF_COMP_F32, view.attribute_component_type[GLTF_ATTR_SLOT_POSITION]);
+  TEST_ASSERT_EQUAL_UINT32(0u, view.attribute_component_type[GLTF_ATTR_SLOT_NORMAL]);
+  TEST_ASSERT_NULL(view.attributes[GLTF_ATTR_SLOT_NORMAL].ptr);
+  TEST_ASSERT_EQUAL_PTR(view.attributes[GLTF_ATTR_SLOT_POSITION].ptr, view.positions.ptr);
+  TEST_ASSERT_EQUAL_UINT32(view.attributes[GLTF_ATTR_SLOT_POSITION].count, view.positions.count);
+
+  // Same spans as the accessor queries.
+  const uint32_t slot_accessor[] = { GLTF_ATTR_SLOT_POSITION, 0u, GLTF_ATTR_SLOT_TEXCOORD_0, 1u,
+                                     GLTF_ATTR_SLOT_COLOR_0, 2u };
+  for (uint32_t i = 0; i < 6u; i += 2u) {
+    gltf_span sp;
+    test_assert_ok(gltf_accessor_span(g_doc, slot_accessor[i + 1u], &sp, &err), &err, "gltf_accessor_span");
+    const gltf_span* got = &view.attributes[slot_accessor[i]];
+    TEST_ASSERT_EQUAL_PTR(sp.ptr, got->ptr);
+    TEST_ASSERT_EQUAL_UINT32(sp.count, got->count);
+    TEST_ASSERT_EQUAL_UINT32(sp.stride, got->stride);
+    TEST_ASSERT_EQUAL_UINT32(sp.elem_size, got->elem_size);
+  }
+  TEST_ASSERT_EQUAL_UINT32(3u, view.index_count);
+  TEST_ASSERT_EQUAL_UINT32(GLTF_COMP_U16, view.index_component_type);
+  uint16_t first = 0;
+  memcpy(&first, view.indices.ptr, sizeof first);
+  TEST_ASSERT_EQUAL_UINT16(2u, first);
+
+  // Sets without a slot are still found.
+  uint32_t acc = 0;
+  TEST_ASSERT_EQUAL_INT(1, gltf_doc_primitive_find_attribute(g_doc, 0, GLTF_ATTR_TEXCOORD, 5, &acc));
+  TEST_ASSERT_EQUAL_UINT32(1u, acc);
+  TEST_ASSERT_EQUAL_INT(0, gltf_doc_primitive_find_attribute(g_doc, 0, GLTF_ATTR_TEXCOORD, 1, &acc));
+
+  // A slot whose accessor overruns its view fails the view, not POSITION.
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_PARSE, gltf_mesh_primitive_view(g_doc, 0, 1, &view, &err));
+  TEST_ASSERT_EQUAL_STRING("accessor range out of bufferView bounds", err.message);
+  gltf_span pos;
+  test_assert_ok(gltf_mesh_primitive_position_span(g_doc, 0, 1, &pos, &err), &err, "position_span");
+  TEST_ASSERT_EQUAL_UINT32(3u, pos.count);
+
+  // Non-indexed: index_count is the vertex count.
+  test_assert_ok(gltf_mesh_primitive_view(g_doc, 0, 2, &view, &err), &err, "view(non-indexed)");
+  TEST_ASSERT_EQUAL_UINT32(3u, view.index_count);
+  TEST_ASSERT_NULL(view.indices.ptr);
+  TEST_ASSERT_EQUAL_UINT32(0u, view.index_component_type);
+  free(glb);
+}
+
+void test_31_prim_view_lazy_and_baked(void) {
+  // Slots resolve lazily loaded buffers on first use.
+  const char* path = GLTF_REPO_ROOT "/tests/fixtures/03-tri.gltf";
+  gltf_load_options opts = {0};
+  opts.flags = GLTF_LOAD_LAZY_BUFFERS;
+  gltf_error err = {0};
+  test_assert_ok(gltf_load_file_ex(path, &opts, &g_doc, &err), &err, "gltf_load_file_ex(lazy)");
+  gltf_draw_primitive_view lazy;
+  test_assert_ok(gltf_mesh_primitive_view(g_doc, 0, 0, &lazy, &err), &err, "view(lazy)");
+  TEST_ASSERT_NOT_NULL(lazy.positions.ptr);
+
+  // Baked documents keep their slot tables.
+  const char* cache = GLTF_TEST_OUT_DIR "/t31_tri.gltfb";
+  test_assert_ok(gltf_doc_save_baked(g_doc, cache, GLTF_BAKE_BUFFERS, &err), &err, "gltf_doc_save_baked");
+  gltf_doc* baked = NULL;
+  test_assert_ok(gltf_load_baked(cache, NULL, &baked, &err), &err, "gltf_load_baked");
+  gltf_draw_primitive_view view;
+  test_assert_ok(gltf_mesh_primitive_view(baked, 0, 0, &view, &err), &err, "view(baked)");
+  TEST_ASSERT_EQUAL_UINT32(lazy.attribute_mask, view.attribute_mask);
+  TEST_ASSERT_EQUAL_UINT32(lazy.index_count, view.index_count);
+  TEST_ASSERT_EQUAL_MEMORY(lazy.positions.ptr, view.positions.ptr,
+                           (size_t)(view.positions.count - 1u) * view.positions.stride + view.positions.elem_size);
+  gltf_free(baked);
+}
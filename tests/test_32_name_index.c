@@ -0,0 +1,144 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern gltf_doc* g_doc;
+
+#define T32_NODES 300u
+
+// Node i is named from a small pool (with duplicates) or left unnamed.
+static const char* const k_t32_names[] = { "collider_b", "body", "collider_a", "collider", "coll", "", "arm_l" };
+#define T32_NAME_COUNT (uint32_t)(sizeof k_t32_names / sizeof k_t32_names[0])
+
+static const char* t32_node_name(uint32_t i, char* buf, size_t cap) {
+  if (i % 11u == 10u) return NULL;
+  if (i % 3u == 0u) {
+    (void)snprintf(buf, cap, "%s_%u", k_t32_names[i % T32_NAME_COUNT], i);
+    return buf;
+  }
+  return k_t32_names[i % T32_NAME_COUNT];
+}
+
+static uint8_t* t32_build(size_t* out_size) {
+  const size_t cap = 64u * T32_NODES + 512u;
+  char* json = (char*)malloc(cap);
+  TEST_ASSERT_NOT_NULL(json);
+  size_t n = (size_t)snprintf(json, cap, "{\"asset\":{\"version\":\"2.0\"},\"nodes\":[");
+  for (uint32_t i = 0; i < T32_NODES; i++) {
+    char buf[64];
+    const char* name = t32_node_name(i, buf, sizeof buf);
+    if (name) {
+      n += (size_t)snprintf(json + n, cap - n, "%s{\"name\":\"%s\"}", i ? "," : "", name);
+    } else {
+      n += (size_t)snprintf(json + n, cap - n, "%s{}", i ? "," : "");
+    }
+  }
+  n += (size_t)snprintf(json + n, cap - n,
+                        "],\"meshes\":[{\"name\":\"rock\",\"primitives\":[]},{\"primitives\":[]},"
+                        "{\"name\":\"rock_big\",\"primitives\":[]}],"
+                        "\"materials\":[{\"name\":\"stone\"},{\"name\":\"moss\"},{\"name\":\"stone\"}]}");
+  TEST_ASSERT_TRUE(n < cap);
+  uint8_t* glb = test_build_glb(json, NULL, 0, out_size);
+  free(json);
+  return glb;
+}
+
+// Indexed and scanning lookups agree for every query.
+static void t32_check_same(const gltf_doc* indexed, const gltf_doc* plain) {
+  static const char* const prefixes[] = { "", "c", "coll", "collider", "collider_", "collider_a", "body_",
+                                          "zzz", "arm_l_2", "collider_b_1" };
+  uint32_t a[T32_NODES], b[T32_NODES];
+  for (uint32_t p = 0; p < (uint32_t)(sizeof prefixes / sizeof prefixes[0]); p++) {
+    const uint32_t caps[] = { 0u, 1u, 7u, T32_NODES };
+    for (uint32_t c = 0; c < 4u; c++) {
+      memset(a, 0xAB, sizeof a);
+      memset(b, 0xAB, sizeof b);
+      const uint32_t na = gltf_doc_find_name_prefix(indexed, GLTF_NAME_NODE, prefixes[p], a, caps[c]);
+      const uint32_t nb = gltf_doc_find_name_prefix(plain, GLTF_NAME_NODE, prefixes[p], b, caps[c]);
+      TEST_ASSERT_EQUAL_UINT32(nb, na);
+      TEST_ASSERT_EQUAL_MEMORY(b, a, sizeof a);
+    }
+  }
+  for (uint32_t i = 0; i < T32_NODES; i++) {
+    const char* name = gltf_doc_node_name(plain, i);
+    if (!name) continue;
+    const int32_t found = gltf_doc_find_name(indexed, GLTF_NAME_NODE, name);
+    TEST_ASSERT_EQUAL_INT32(gltf_doc_find_name(plain, GLTF_NAME_NODE, name), found);
+    TEST_ASSERT_TRUE(found >= 0 && (uint32_t)found <= i);
+    TEST_ASSERT_EQUAL_STRING(name, gltf_doc_node_name(indexed, (uint32_t)found));
+  }
+}
+
+void test_32_name_index_matches_scan(void) {
+  size_t size = 0;
+  uint8_t* glb = t32_build(&size);
+  gltf_error err = {0};
+  gltf_doc* plain = NULL;
+  test_assert_ok(gltf_load_glb_bytes(glb, size, &plain, &err), &err, "gltf_load_glb_bytes");
+  gltf_load_options opts = {0};
+  opts.flags = GLTF_LOAD_NAME_INDEX;
+  test_assert_ok(gltf_load_glb_bytes_ex(glb, size, &opts, &g_doc, &err), &err, "gltf_load_glb_bytes_ex");
+  t32_check_same(g_doc, plain);
+
+  // Duplicates resolve to the lowest index; prefixes come back in name order.
+  TEST_ASSERT_EQUAL_INT32(1, gltf_doc_find_name(g_doc, GLTF_NAME_NODE, "body"));
+  TEST_ASSERT_EQUAL_INT32(-1, gltf_doc_find_name(g_doc, GLTF_NAME_NODE, "bod"));
+  TEST_ASSERT_EQUAL_INT32(5, gltf_doc_find_name(g_doc, GLTF_NAME_NODE, ""));
+  uint32_t idx[4];
+  TEST_ASSERT_EQUAL_UINT32(2u, gltf_doc_find_name_prefix(g_doc, GLTF_NAME_NODE, "collider_a_9", idx, 4u));
+  TEST_ASSERT_EQUAL_UINT32(9u, idx[0]);
+  TEST_ASSERT_EQUAL_UINT32(93u, idx[1]);
+
+  // Meshes and materials.
+  TEST_ASSERT_EQUAL_INT32(2, gltf_doc_find_name(g_doc, GLTF_NAME_MESH, "rock_big"));
+  TEST_ASSERT_EQUAL_UINT32(2u, gltf_doc_find_name_prefix(g_doc, GLTF_NAME_MESH, "rock", idx, 4u));
+  TEST_ASSERT_EQUAL_UINT32(0u, idx[0]);
+  TEST_ASSERT_EQUAL_UINT32(2u, idx[1]);
+  TEST_ASSERT_EQUAL_INT32(0, gltf_doc_find_name(g_doc, GLTF_NAME_MATERIAL, "stone"));
+  TEST_ASSERT_EQUAL_INT32(1, gltf_doc_find_name(plain, GLTF_NAME_MATERIAL, "moss"));
+  TEST_ASSERT_EQUAL_UINT32(3u, gltf_doc_find_name_prefix(g_doc, GLTF_NAME_MATERIAL, "", NULL, 0u));
+
+  // Bad arguments.
+  TEST_ASSERT_EQUAL_INT32(-1, gltf_doc_find_name(NULL, GLTF_NAME_NODE, "body"));
+  TEST_ASSERT_EQUAL_INT32(-1, gltf_doc_find_name(g_doc, GLTF_NAME_KIND_COUNT, "body"));
+  TEST_ASSERT_EQUAL_UINT32(0u, gltf_doc_find_name_prefix(g_doc, GLTF_NAME_NODE, NULL, idx, 4u));
+
+  gltf_free(plain);
+  free(glb);
+}
+
+void test_32_name_index_stream_and_baked(void) {
+  size_t size = 0;
+  uint8_t* glb = t32_build(&size);
+  gltf_error err = {0};
+  gltf_doc* plain = NULL;
+  test_assert_ok(gltf_load_glb_bytes(glb, size, &plain, &err), &err, "gltf_load_glb_bytes");
+
+  // Streamed documents honour the flag.
+  gltf_load_options opts = {0};
+  opts.flags = GLTF_LOAD_NAME_INDEX;
+  gltf_glb_stream* s = NULL;
+  test_assert_ok(gltf_glb_stream_create(&opts, &s, &err), &err, "gltf_glb_stream_create");
+  test_assert_ok(gltf_glb_stream_feed(s, glb, size, &err), &err, "gltf_glb_stream_feed");
+  test_assert_ok(gltf_glb_stream_finish(s, &g_doc, &err), &err, "gltf_glb_stream_finish");
+  t32_check_same(g_doc, plain);
+
+  // Baked documents keep the index.
+  const char* cache = GLTF_TEST_OUT_DIR "/t32_names.gltfb";
+  test_assert_ok(gltf_doc_save_baked(g_doc, cache, GLTF_BAKE_BUFFERS, &err), &err, "gltf_doc_save_baked");
+  gltf_doc* baked = NULL;
+  test_assert_ok(gltf_load_baked(cache, NULL, &baked, &err), &err, "gltf_load_baked");
+  t32_check_same(baked, plain);
+  TEST_ASSERT_EQUAL_INT32(0, gltf_doc_find_name(baked, GLTF_NAME_MATERIAL, "stone"));
+  gltf_free(baked);
+
+  gltf_free(plain);
+  free(glb);
+}
@@ -0,0 +1,234 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern gltf_doc* g_doc;
+
+// 4 vertices: POSITION f32 VEC3 at 0, NORMAL f32 VEC3 at 48, TEXCOORD_0 f32
+// VEC2 at 96, COLOR_0 normalized u8 VEC3 (stride 4) at 128, JOINTS_0 u8 VEC4
+// at 144.
+static const char* k_t33_json =
+  "{\"asset\":{\"version\":\"2.0\"},"
+  "\"buffers\":[{\"byteLength\":160}],"
+  "\"bufferViews\":[{\"buffer\":0,\"byteLength\":48},{\"buffer\":0,\"byteOffset\":48,\"byteLength\":48},"
+  "{\"buffer\":0,\"byteOffset\":96,\"byteLength\":32},{\"buffer\":0,\"byteOffset\":128,\"byteLength\":16,\"byteStride\":4},"
+  "{\"buffer\":0,\"byteOffset\":144,\"byteLength\":16}],"
+  "\"accessors\":["
+  "{\"bufferView\":0,\"componentType\":5126,\"count\":4,\"type\":\"VEC3\"},"
+  "{\"bufferView\":1,\"componentType\":5126,\"count\":4,\"type\":\"VEC3\"},"
+  "{\"bufferView\":2,\"componentType\":5126,\"count\":4,\"type\":\"VEC2\"},"
+  "{\"bufferView\":3,\"componentType\":5121,\"normalized\":true,\"count\":4,\"type\":\"VEC3\"},"
+  "{\"bufferView\":4,\"componentType\":5121,\"count\":4,\"type\":\"VEC4\"},"
+  "{\"bufferView\":2,\"componentType\":5126,\"count\":2,\"type\":\"VEC2\"}],"
+  "\"meshes\":[{\"primitives\":["
+  "{\"attributes\":{\"POSITION\":0,\"NORMAL\":1,\"TEXCOORD_0\":2,\"COLOR_0\":3,\"JOINTS_0\":4}},"
+  "{\"attributes\":{\"POSITION\":0,\"TEXCOORD_0\":5}}]}]}";
+
+static const float k_t33_normals[12] = { 0, 0, 1, 1, 0, 0, 0, 0, -1, 0, -1, 0 };
+static const float k_t33_uvs[8] = { 1.0f, 0.5f, -2.0f, 65520.0f, 1e-7f, 0.0f, -0.0f, 0.333333f };
+
+static uint8_t* t33_build(size_t* out_size) {
+  uint8_t bin[160];
+  memset(bin, 0, sizeof bin);
+  for (uint32_t i = 0; i < 12u; i++) {
+    const float p = (float)i * 0.25f;
+    memcpy(bin + i * 4u, &p, sizeof p);
+  }
+  memcpy(bin + 48, k_t33_normals, sizeof k_t33_normals);
+  memcpy(bin + 96, k_t33_uvs, sizeof k_t33_uvs);
+  for (uint32_t v = 0; v < 4u; v++) {
+    for (uint32_t k = 0; k < 3u; k++) bin[128u + v * 4u + k] = (uint8_t)(v * 60u + k * 30u);
+    for (uint32_t k = 0; k < 4u; k++) bin[144u + v * 4u + k] = (uint8_t)(v * 4u + k);
+  }
+  return test_build_glb(k_t33_json, bin, sizeof bin, out_size);
+}
+
+// Layout under test (36 bytes): position f32x3, octahedral normal, uv f16x2,
+// color unorm8x4, joints u16x4, and the absent TANGENT as snorm8x4.
+static const gltf_vertex_attrib k_t33_attribs[] = {
+  { GLTF_ATTR_SLOT_POSITION, GLTF_VERTEX_F32, 3, 0 },
+  { GLTF_ATTR_SLOT_NORMAL, GLTF_VERTEX_OCT_SNORM16, 0, 12 },
+  { GLTF_ATTR_SLOT_TEXCOORD_0, GLTF_VERTEX_F16, 2, 16 },
+  { GLTF_ATTR_SLOT_COLOR_0, GLTF_VERTEX_UNORM8, 4, 20 },
+  { GLTF_ATTR_SLOT_JOINTS_0, GLTF_VERTEX_U16, 4, 24 },
+  { GLTF_ATTR_SLOT_TANGENT, GLTF_VERTEX_SNORM8, 4, 32 },
+};
+#define T33_STRIDE 36u
+
+static gltf_vertex_layout t33_layout(void) {
+  gltf_vertex_layout layout = { k_t33_attribs, (uint32_t)(sizeof k_t33_attribs / sizeof k_t33_attribs[0]),
+                                T33_STRIDE };
+  return layout;
+}
+
+static uint16_t t33_u16(const uint8_t* p) {
+  uint16_t v;
+  memcpy(&v, p, sizeof v);
+  return v;
+}
+
+static int16_t t33_i16(const uint8_t* p) {
+  int16_t v;
+  memcpy(&v, p, sizeof v);
+  return v;
+}
+
+// Straightforward binary16 reference (round to nearest even via rint()).
+static uint16_t t33_ref_f16(float f) {
+  const uint16_t sign = signbit(f) ? 0x8000u : 0u;
+  if (isnan(f)) return (uint16_t)(sign | 0x7E00u);
+  const double a = fabs((double)f);
+  if (a >= 65520.0) return (uint16_t)(sign | 0x7C00u);
+  if (a < ldexp(1.0, -14)) return (uint16_t)(sign | (uint16_t)rint(a * ldexp(1.0, 24)));
+  int e = 0;
+  (void)frexp(a, &e);
+  e -= 1;
+  double m = rint((ldexp(a, -e) - 1.0) * 1024.0);
+  if (m >= 1024.0) {
+    m = 0.0;
+    e++;
+  }
+  if (e > 15) return (uint16_t)(sign | 0x7C00u);
+  return (uint16_t)(sign | (uint16_t)((e + 15) << 10) | (uint16_t)m);
+}
+
+void test_33_pack_formats(void) {
+  size_t size = 0;
+  uint8_t* glb = t33_build(&size);
+  gltf_error err = {0};
+  test_assert_ok(gltf_load_glb_bytes(glb, size, &g_doc, &err), &err, "gltf_load_glb_bytes");
+
+  uint32_t vertex_count = 0;
+  test_assert_ok(gltf_doc_primitive_vertex_count(g_doc, 0, &vertex_count, &err), &err, "vertex_count");
+  TEST_ASSERT_EQUAL_UINT32(4u, vertex_count);
+
+  const gltf_vertex_layout layout = t33_layout();
+  uint8_t out[4 * T33_STRIDE];
+  test_assert_ok(gltf_doc_primitive_pack_vertices(g_doc, 0, &layout, 0, 4, out, &err), &err, "pack");
+
+  static const int16_t oct[8] = { 0, 0, 32767, 0, 32767, 32767, 0, -32767 };
+  static const uint16_t f16[8] = { 0x3C00u, 0x3800u, 0xC000u, 0x7C00u, 0x0002u, 0x0000u, 0x8000u, 0x3555u };
+  for (uint32_t v = 0; v < 4u; v++) {
+    const uint8_t* o = out + v * T33_STRIDE;
+    float pos[3];
+    memcpy(pos, o, sizeof pos);
+    for (uint32_t k = 0; k < 3u; k++) TEST_ASSERT_EQUAL_FLOAT((float)(v * 3u + k) * 0.25f, pos[k]);
+
+    TEST_ASSERT_EQUAL_INT16(oct[v * 2u], t33_i16(o + 12));
+    TEST_ASSERT_EQUAL_INT16(oct[v * 2u + 1u], t33_i16(o + 14));
+
+    TEST_ASSERT_EQUAL_HEX16(f16[v * 2u], t33_u16(o + 16));
+    TEST_ASSERT_EQUAL_HEX16(f16[v * 2u + 1u], t33_u16(o + 18));
+
+    // VEC3 color: alpha defaults to 1.
+    for (uint32_t k = 0; k < 3u; k++) TEST_ASSERT_EQUAL_UINT8(v * 60u + k * 30u, o[20 + k]);
+    TEST_ASSERT_EQUAL_UINT8(255u, o[23]);
+
+    for (uint32_t k = 0; k < 4u; k++) TEST_ASSERT_EQUAL_UINT16(v * 4u + k, t33_u16(o + 24 + k * 2u));
+
+    // Absent tangent: (0, 0, 0, 1).
+    TEST_ASSERT_EQUAL_HEX32(0x7F000000u, (uint32_t)o[32] | (uint32_t)o[33] << 8 | (uint32_t)o[34] << 16 |
+                                           (uint32_t)o[35] << 24);
+  }
+
+  // A sub-range lands at the start of dst.
+  uint8_t part[2 * T33_STRIDE];
+  test_assert_ok(gltf_doc_primitive_pack_vertices(g_doc, 0, &layout, 2, 2, part, &err), &err, "pack(range)");
+  TEST_ASSERT_EQUAL_MEMORY(out + 2 * T33_STRIDE, part, sizeof part);
+
+  // Errors.
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_doc_primitive_pack_vertices(g_doc, 0, &layout, 3, 2, part, &err));
+  TEST_ASSERT_EQUAL_STRING("vertex range out of range", err.message);
+  gltf_vertex_layout bad = layout;
+  bad.stride = 35u;
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_doc_primitive_pack_vertices(g_doc, 0, &bad, 0, 1, part, &err));
+  TEST_ASSERT_EQUAL_STRING("invalid vertex layout", err.message);
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_PARSE, gltf_doc_primitive_pack_vertices(g_doc, 1, &layout, 0, 1, part, &err));
+  TEST_ASSERT_EQUAL_STRING("attribute count smaller than POSITION count", err.message);
+  free(glb);
+}
+
+void test_33_pack_conversions_and_batch(void) {
+  // f16 and snorm16 over a spread of values, including the edge cases.
+  enum { N = 1024 };
+  float* values = (float*)malloc(N * 4u * sizeof(float));
+  TEST_ASSERT_NOT_NULL(values);
+  uint32_t seed = 12345u;
+  for (uint32_t i = 0; i < N * 4u; i++) {
+    seed = seed * 1664525u + 1013904223u;
+    const float unit = (float)(seed >> 8) / 16777216.0f;
+    values[i] = (unit - 0.5f) * ldexpf(1.0f, (int)(seed % 40u) - 28);
+  }
+  const float edges[] = { 0.0f, -0.0f, 1.0f, -1.0f, 65504.0f, 65519.99f, 65520.0f, 6.1035156e-05f,
+                          6.1e-05f, 2.9802322e-08f, 2.98e-08f, 1e-30f, INFINITY, -INFINITY, NAN, 0.5f };
+  memcpy(values, edges, sizeof edges);
+
+  char json[1024];
+  (void)snprintf(json, sizeof json,
+                 "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":%u}],"
+                 "\"bufferViews\":[{\"buffer\":0,\"byteLength\":%u}],"
+                 "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":%u,\"type\":\"VEC4\"},"
+                 "{\"bufferView\":0,\"componentType\":5126,\"count\":%u,\"type\":\"VEC3\"}],"
+                 "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":1,\"TANGENT\":0}}]}]}",
+                 N * 16u, N * 16u, N, N);
+  size_t size = 0;
+  uint8_t* glb = test_build_glb(json, values, N * 16u, &size);
+  gltf_error err = {0};
+  test_assert_ok(gltf_load_glb_bytes(glb, size, &g_doc, &err), &err, "gltf_load_glb_bytes");
+
+  static const gltf_vertex_attrib attribs[] = {
+    { GLTF_ATTR_SLOT_TANGENT, GLTF_VERTEX_F16, 4, 0 },
+    { GLTF_ATTR_SLOT_TANGENT, GLTF_VERTEX_SNORM16, 4, 8 },
+  };
+  const gltf_vertex_layout layout = { attribs, 2u, 16u };
+  uint8_t* out = (uint8_t*)malloc(N * 16u);
+  TEST_ASSERT_NOT_NULL(out);
+  test_assert_ok(gltf_doc_primitive_pack_vertices(g_doc, 0, &layout, 0, N, out, &err), &err, "pack");
+
+  for (uint32_t i = 0; i < N * 4u; i++) {
+    const float v = values[i];
+    TEST_ASSERT_EQUAL_HEX16(t33_ref_f16(v), t33_u16(out + (i / 4u) * 16u + (i % 4u) * 2u));
+    const float c = isnan(v) ? 1.0f : (v < -1.0f ? -1.0f : (v > 1.0f ? 1.0f : v));
+    const float scaled = c * 32767.0f;
+    TEST_ASSERT_EQUAL_INT16((int16_t)rint((double)scaled), t33_i16(out + (i / 4u) * 16u + 8u + (i % 4u) * 2u));
+  }
+
+  // Ranges packed through the thread pool match the single call.
+  gltf_thread_pool* pool = NULL;
+  test_assert_ok(gltf_thread_pool_create(3, &pool, &err), &err, "gltf_thread_pool_create");
+  uint8_t* par = (uint8_t*)calloc(N, 16u);
+  TEST_ASSERT_NOT_NULL(par);
+  gltf_vertex_pack_job jobs[5];
+  memset(jobs, 0, sizeof jobs);
+  for (uint32_t j = 0; j < 5u; j++) {
+    jobs[j].primitive_index = 0;
+    jobs[j].first = j * 200u;
+    jobs[j].count = j < 4u ? 200u : N - 800u;
+    jobs[j].dst = par + (size_t)jobs[j].first * 16u;
+  }
+  test_assert_ok(gltf_doc_pack_vertices_batch(g_doc, &layout, jobs, 5u, gltf_thread_pool_dispatch, pool, &err),
+                 &err, "gltf_doc_pack_vertices_batch");
+  TEST_ASSERT_EQUAL_MEMORY(out, par, N * 16u);
+
+  // A failing job is reported; the others still run.
+  jobs[1].first = N;
+  memset(par, 0, N * 16u);
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_doc_pack_vertices_batch(g_doc, &layout, jobs, 5u, NULL, NULL, &err));
+  TEST_ASSERT_EQUAL_STRING("vertex range out of range", err.message);
+  TEST_ASSERT_EQUAL_INT(GLTF_OK, jobs[4].result);
+  TEST_ASSERT_EQUAL_MEMORY(out + 800u * 16u, par + 800u * 16u, (N - 800u) * 16u);
+
+  gltf_thread_pool_free(pool);
+  free(par);
+  free(out);
+  free(glb);
+  free(values);
+}
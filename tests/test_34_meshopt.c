@@ -0,0 +1,243 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern gltf_doc* g_doc;
+
+// G x G quad grid, triangles shuffled so the source order has poor locality.
+#define T34_G 32u
+#define T34_VERTS ((T34_G + 1u) * (T34_G + 1u))
+#define T34_TRIS (T34_G * T34_G * 2u)
+
+typedef struct t34_mesh {
+  float pos[T34_VERTS * 3u];
+  uint32_t idx[T34_TRIS * 3u];
+} t34_mesh;
+
+static void t34_make(t34_mesh* m) {
+  for (uint32_t y = 0; y <= T34_G; y++) {
+    for (uint32_t x = 0; x <= T34_G; x++) {
+      float* p = m->pos + (y * (T34_G + 1u) + x) * 3u;
+      p[0] = (float)x;
+      p[1] = (float)y;
+      p[2] = (float)((x * 7u + y * 3u) % 5u) * 0.25f;
+    }
+  }
+  uint32_t t = 0;
+  for (uint32_t y = 0; y < T34_G; y++) {
+    for (uint32_t x = 0; x < T34_G; x++) {
+      const uint32_t a = y * (T34_G + 1u) + x;
+      const uint32_t quad[6] = { a, a + 1u, a + T34_G + 1u, a + 1u, a + T34_G + 2u, a + T34_G + 1u };
+      memcpy(m->idx + t * 3u, quad, sizeof quad);
+      t += 2u;
+    }
+  }
+  uint32_t seed = 12345u;
+  for (uint32_t i = T34_TRIS - 1u; i > 0; i--) {
+    seed = seed * 1664525u + 1013904223u;
+    const uint32_t j = (seed >> 8) % (i + 1u);
+    uint32_t tmp[3];
+    memcpy(tmp, m->idx + i * 3u, sizeof tmp);
+    memcpy(m->idx + i * 3u, m->idx + j * 3u, sizeof tmp);
+    memcpy(m->idx + j * 3u, tmp, sizeof tmp);
+  }
+}
+
+// Primitive 0: the indexed grid. Primitive 1: a non-indexed strip over the
+// same positions.
+static uint8_t* t34_build(t34_mesh* m, size_t* out_size) {
+  t34_make(m);
+  char json[1024];
+  (void)snprintf(json, sizeof json,
+                 "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":%u}],"
+                 "\"bufferViews\":[{\"buffer\":0,\"byteLength\":%u},"
+                 "{\"buffer\":0,\"byteOffset\":%u,\"byteLength\":%u}],"
+                 "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":%u,\"type\":\"VEC3\"},"
+                 "{\"bufferView\":1,\"componentType\":5125,\"count\":%u,\"type\":\"SCALAR\"}],"
+                 "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0},\"indices\":1},"
+                 "{\"attributes\":{\"POSITION\":0},\"mode\":5}]}]}",
+                 (unsigned)sizeof *m, (unsigned)sizeof m->pos, (unsigned)sizeof m->pos, (unsigned)sizeof m->idx,
+                 T34_VERTS, T34_TRIS * 3u);
+  return test_build_glb(json, (const uint8_t*)m, sizeof *m, out_size);
+}
+
+static uint32_t t34_index(const gltf_optimized_indices* o, uint32_t i) {
+  if (o->index_component_type == GLTF_COMP_U16) return ((const uint16_t*)o->indices)[i];
+  return ((const uint32_t*)o->indices)[i];
+}
+
+// Rotates a triangle so its smallest index comes first (winding kept).
+static void t34_canon(uint32_t* t) {
+  while (t[0] > t[1] || t[0] > t[2]) {
+    const uint32_t a = t[0];
+    t[0] = t[1];
+    t[1] = t[2];
+    t[2] = a;
+  }
+}
+
+static int t34_tri_cmp(const void* pa, const void* pb) {
+  const uint32_t* a = (const uint32_t*)pa;
+  const uint32_t* b = (const uint32_t*)pb;
+  for (uint32_t k = 0; k < 3u; k++) {
+    if (a[k] != b[k]) return a[k] < b[k] ? -1 : 1;
+  }
+  return 0;
+}
+
+// The optimized buffer holds the same triangles (through vertex_remap when
+// present) as the primitive's own list.
+static void t34_assert_same_triangles(const gltf_optimized_indices* o, uint32_t primitive_index) {
+  uint32_t tri_count = 0;
+  gltf_error err = {0};
+  test_assert_ok(gltf_doc_primitive_triangle_count(g_doc, primitive_index, &tri_count, &err), &err, "tri count");
+  TEST_ASSERT_EQUAL_UINT32(tri_count * 3u, o->index_count);
+
+  uint32_t* want = (uint32_t*)malloc((size_t)tri_count * 3u * sizeof(uint32_t));
+  uint32_t* got = (uint32_t*)malloc((size_t)tri_count * 3u * sizeof(uint32_t));
+  TEST_ASSERT_NOT_NULL(want);
+  TEST_ASSERT_NOT_NULL(got);
+  test_assert_ok(gltf_doc_primitive_read_triangles(g_doc, primitive_index, 0, tri_count, (gltf_tri*)want, &err),
+                 &err, "read_triangles");
+  for (uint32_t i = 0; i < o->index_count; i++) {
+    const uint32_t v = t34_index(o, i);
+    TEST_ASSERT_TRUE(v < o->vertex_count);
+    got[i] = o->vertex_remap ? o->vertex_remap[v] : v;
+  }
+  for (uint32_t t = 0; t < tri_count; t++) {
+    t34_canon(want + t * 3u);
+    t34_canon(got + t * 3u);
+  }
+  qsort(want, tri_count, 3u * sizeof(uint32_t), t34_tri_cmp);
+  qsort(got, tri_count, 3u * sizeof(uint32_t), t34_tri_cmp);
+  TEST_ASSERT_EQUAL_MEMORY(want, got, (size_t)tri_count * 3u * sizeof(uint32_t));
+  free(want);
+  free(got);
+}
+
+static float t34_acmr(const gltf_optimized_indices* o) {
+  uint32_t* idx = (uint32_t*)malloc((size_t)o->index_count * sizeof(uint32_t));
+  TEST_ASSERT_NOT_NULL(idx);
+  for (uint32_t i = 0; i < o->index_count; i++) idx[i] = t34_index(o, i);
+  float acmr = 0.0f;
+  gltf_error err = {0};
+  test_assert_ok(gltf_analyze_vertex_cache(idx, o->index_count, o->vertex_count, 0, &acmr, &err), &err, "acmr");
+  free(idx);
+  return acmr;
+}
+
+void test_34_meshopt_vertex_cache_and_fetch(void) {
+  static t34_mesh mesh;
+  size_t size = 0;
+  uint8_t* glb = t34_build(&mesh, &size);
+  gltf_error err = {0};
+  test_assert_ok(gltf_load_glb_bytes(glb, size, &g_doc, &err), &err, "gltf_load_glb_bytes");
+
+  // FIFO model: two triangles sharing an edge miss 4 times.
+  const uint32_t pair[6] = { 0, 1, 2, 2, 1, 3 };
+  float acmr = 0.0f;
+  test_assert_ok(gltf_analyze_vertex_cache(pair, 6u, 4u, 0, &acmr, &err), &err, "acmr(pair)");
+  TEST_ASSERT_EQUAL_FLOAT(2.0f, acmr);
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_analyze_vertex_cache(pair, 6u, 3u, 0, &acmr, &err));
+  test_assert_ok(gltf_analyze_vertex_cache(mesh.idx, T34_TRIS * 3u, T34_VERTS, 0, &acmr, &err), &err, "acmr(src)");
+  const float source_acmr = acmr;
+  TEST_ASSERT_TRUE(source_acmr > 2.0f);
+
+  // Flags 0: same order, smallest index type.
+  gltf_mesh_opt_options opts = {0};
+  gltf_optimized_indices o;
+  test_assert_ok(gltf_doc_primitive_optimize_indices(g_doc, 0, &opts, &o, &err), &err, "optimize(none)");
+  TEST_ASSERT_EQUAL_UINT32(GLTF_COMP_U16, o.index_component_type);
+  TEST_ASSERT_NULL(o.vertex_remap);
+  TEST_ASSERT_EQUAL_UINT32(T34_VERTS, o.vertex_count);
+  for (uint32_t i = 0; i < o.index_count; i++) TEST_ASSERT_EQUAL_UINT32(mesh.idx[i], t34_index(&o, i));
+  gltf_optimized_indices_free(&o);
+  TEST_ASSERT_NULL(o.indices);
+
+  // Vertex cache (NULL options): the same triangles with far fewer misses.
+  test_assert_ok(gltf_doc_primitive_optimize_indices(g_doc, 0, NULL, &o, &err), &err, "optimize(cache)");
+  t34_assert_same_triangles(&o, 0);
+  const float cache_acmr = t34_acmr(&o);
+  TEST_ASSERT_TRUE(cache_acmr < 0.9f);
+  gltf_optimized_indices_free(&o);
+
+  // Everything, as u32: fetch order numbers vertices by first use.
+  opts.flags = GLTF_MESH_OPT_VERTEX_CACHE | GLTF_MESH_OPT_OVERDRAW | GLTF_MESH_OPT_VERTEX_FETCH;
+  opts.index_component_type = GLTF_COMP_U32;
+  test_assert_ok(gltf_doc_primitive_optimize_indices(g_doc, 0, &opts, &o, &err), &err, "optimize(all)");
+  TEST_ASSERT_EQUAL_UINT32(GLTF_COMP_U32, o.index_component_type);
+  TEST_ASSERT_NOT_NULL(o.vertex_remap);
+  TEST_ASSERT_EQUAL_UINT32(T34_VERTS, o.vertex_count);
+  t34_assert_same_triangles(&o, 0);
+  uint32_t next = 0;
+  for (uint32_t i = 0; i < o.index_count; i++) {
+    const uint32_t v = t34_index(&o, i);
+    TEST_ASSERT_TRUE(v <= next);
+    if (v == next) next++;
+  }
+  TEST_ASSERT_TRUE(t34_acmr(&o) < source_acmr);
+  gltf_optimized_indices_free(&o);
+
+  // Bad options.
+  opts.index_component_type = GLTF_COMP_U8;
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_doc_primitive_optimize_indices(g_doc, 0, &opts, &o, &err));
+  opts.index_component_type = 0;
+  opts.flags = 1u << 7;
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_doc_primitive_optimize_indices(g_doc, 0, &opts, &o, &err));
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_doc_primitive_optimize_indices(g_doc, 2, NULL, &o, &err));
+  gltf_optimized_indices_free(NULL);
+  free(glb);
+}
+
+void test_34_meshopt_batch(void) {
+  static t34_mesh mesh;
+  size_t size = 0;
+  uint8_t* glb = t34_build(&mesh, &size);
+  gltf_error err = {0};
+  test_assert_ok(gltf_load_glb_bytes(glb, size, &g_doc, &err), &err, "gltf_load_glb_bytes");
+
+  gltf_mesh_opt_options opts = {0};
+  opts.flags = GLTF_MESH_OPT_VERTEX_CACHE | GLTF_MESH_OPT_OVERDRAW | GLTF_MESH_OPT_VERTEX_FETCH;
+
+  // Threaded results match serial calls, strips included.
+  gltf_mesh_opt_job jobs[4];
+  memset(jobs, 0, sizeof jobs);
+  for (uint32_t i = 0; i < 4u; i++) jobs[i].primitive_index = i % 2u;
+  gltf_thread_pool* pool = NULL;
+  test_assert_ok(gltf_thread_pool_create(3, &pool, &err), &err, "gltf_thread_pool_create");
+  test_assert_ok(gltf_doc_optimize_indices_batch(g_doc, &opts, jobs, 4u, gltf_thread_pool_dispatch, pool, &err),
+                 &err, "batch");
+  for (uint32_t i = 0; i < 4u; i++) {
+    TEST_ASSERT_EQUAL_INT(GLTF_OK, jobs[i].result);
+    gltf_optimized_indices serial;
+    test_assert_ok(gltf_doc_primitive_optimize_indices(g_doc, i % 2u, &opts, &serial, &err), &err, "serial");
+    TEST_ASSERT_EQUAL_UINT32(serial.index_count, jobs[i].out.index_count);
+    TEST_ASSERT_EQUAL_UINT32(serial.index_component_type, jobs[i].out.index_component_type);
+    TEST_ASSERT_EQUAL_UINT32(serial.vertex_count, jobs[i].out.vertex_count);
+    TEST_ASSERT_EQUAL_MEMORY(serial.indices, jobs[i].out.indices, (size_t)serial.index_count * 2u);
+    TEST_ASSERT_EQUAL_MEMORY(serial.vertex_remap, jobs[i].out.vertex_remap, serial.vertex_count * sizeof(uint32_t));
+    t34_assert_same_triangles(&jobs[i].out, i % 2u);
+    gltf_optimized_indices_free(&serial);
+    gltf_optimized_indices_free(&jobs[i].out);
+  }
+
+  // A failed job reports its own error; the others still succeed.
+  jobs[0].primitive_index = 0;
+  jobs[1].primitive_index = 9;
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID,
+                        gltf_doc_optimize_indices_batch(g_doc, &opts, jobs, 2u, gltf_thread_pool_dispatch, pool, &err));
+  TEST_ASSERT_EQUAL_INT(GLTF_OK, jobs[0].result);
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, jobs[1].result);
+  TEST_ASSERT_NULL(jobs[1].out.indices);
+  gltf_optimized_indices_free(&jobs[0].out);
+
+  gltf_thread_pool_free(pool);
+  free(glb);
+}
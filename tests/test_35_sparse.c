@@ -0,0 +1,187 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern gltf_doc* g_doc;
+
+// BIN layout:
+//   0   base VEC3 f32 x 4, byteStride 16 (view 0)
+//   64  u16 indices { 1, 3 }              (view 1)
+//   68  VEC3 f32 x 2 values               (view 2)
+//   92  u8 indices { 0, 2 }               (view 3)
+//   96  u16 indices { 1, 9 }              (view 4, 9 is out of range)
+static const char* k_t35_json =
+  "{\"asset\":{\"version\":\"2.0\"},"
+  "\"buffers\":[{\"byteLength\":100}],"
+  "\"bufferViews\":[{\"buffer\":0,\"byteLength\":64,\"byteStride\":16},"
+  "{\"buffer\":0,\"byteOffset\":64,\"byteLength\":4},{\"buffer\":0,\"byteOffset\":68,\"byteLength\":24},"
+  "{\"buffer\":0,\"byteOffset\":92,\"byteLength\":2},{\"buffer\":0,\"byteOffset\":96,\"byteLength\":4}],"
+  "\"accessors\":["
+  "{\"bufferView\":0,\"componentType\":5126,\"count\":4,\"type\":\"VEC3\","
+  "\"sparse\":{\"count\":2,\"indices\":{\"bufferView\":1,\"componentType\":5123},\"values\":{\"bufferView\":2}}},"
+  "{\"componentType\":5126,\"count\":3,\"type\":\"VEC3\","
+  "\"sparse\":{\"count\":2,\"indices\":{\"bufferView\":3,\"componentType\":5121},\"values\":{\"bufferView\":2}}},"
+  "{\"bufferView\":0,\"componentType\":5126,\"count\":4,\"type\":\"VEC3\","
+  "\"sparse\":{\"count\":2,\"indices\":{\"bufferView\":4,\"componentType\":5123},\"values\":{\"bufferView\":2}}},"
+  "{\"bufferView\":0,\"componentType\":5126,\"count\":4,\"type\":\"VEC3\"}],"
+  "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0}}]}]}";
+
+static uint8_t* t35_build(size_t* out_size) {
+  uint8_t bin[100];
+  memset(bin, 0xEE, sizeof bin);
+  for (uint32_t v = 0; v < 4u; v++) {
+    for (uint32_t k = 0; k < 3u; k++) {
+      const float f = (float)(v * 10u + k);
+      memcpy(bin + v * 16u + k * 4u, &f, sizeof f);
+    }
+  }
+  const uint16_t idx16[2] = { 1, 3 };
+  memcpy(bin + 64, idx16, sizeof idx16);
+  for (uint32_t i = 0; i < 6u; i++) {
+    const float f = -(float)(i + 1u);
+    memcpy(bin + 68u + i * 4u, &f, sizeof f);
+  }
+  bin[92] = 0;
+  bin[93] = 2;
+  const uint16_t bad16[2] = { 1, 9 };
+  memcpy(bin + 96, bad16, sizeof bad16);
+  return test_build_glb(k_t35_json, bin, sizeof bin, out_size);
+}
+
+// Accessor 0 after the sparse values are applied.
+static const float k_t35_dense0[12] = { 0, 1, 2, -1, -2, -3, 20, 21, 22, -4, -5, -6 };
+// Accessor 1: zeros with values at 0 and 2.
+static const float k_t35_dense1[9] = { -1, -2, -3, 0, 0, 0, -4, -5, -6 };
+
+static void t35_check_doc(const gltf_doc* doc) {
+  gltf_error err = {0};
+  gltf_span sp;
+  test_assert_ok(gltf_accessor_span(doc, 0, &sp, &err), &err, "span(0)");
+  TEST_ASSERT_EQUAL_UINT32(4u, sp.count);
+  TEST_ASSERT_EQUAL_UINT32(12u, sp.stride);
+  TEST_ASSERT_EQUAL_UINT32(12u, sp.elem_size);
+  TEST_ASSERT_EQUAL_MEMORY(k_t35_dense0, sp.ptr, sizeof k_t35_dense0);
+
+  // Materialized once: later spans share the copy.
+  gltf_span again;
+  test_assert_ok(gltf_accessor_span(doc, 0, &again, &err), &err, "span(0) again");
+  TEST_ASSERT_EQUAL_PTR(sp.ptr, again.ptr);
+
+  float out[12];
+  test_assert_ok(gltf_accessor_read_f32_range(doc, 1, 0, 3, out, 0, &err), &err, "read_f32_range(1)");
+  TEST_ASSERT_EQUAL_FLOAT_ARRAY(k_t35_dense1, out, 9);
+
+  // Primitive attributes go through the same copy.
+  gltf_span pos;
+  test_assert_ok(gltf_mesh_primitive_position_span(doc, 0, 0, &pos, &err), &err, "position_span");
+  TEST_ASSERT_EQUAL_PTR(sp.ptr, pos.ptr);
+
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_PARSE, gltf_accessor_span(doc, 2, &sp, &err));
+  TEST_ASSERT_EQUAL_STRING("sparse index out of range", err.message);
+
+  // The dense accessor over the same view is untouched.
+  test_assert_ok(gltf_accessor_read_f32(doc, 3, 1, out, 3, &err), &err, "read_f32(3)");
+  TEST_ASSERT_EQUAL_FLOAT(10.0f, out[0]);
+}
+
+typedef struct t35_race {
+  const gltf_doc* doc;
+  const uint8_t* ptr[8];
+  gltf_result result[8];
+} t35_race;
+
+static void t35_race_task(void* user, uint32_t task_index) {
+  t35_race* r = (t35_race*)user;
+  gltf_span sp;
+  r->result[task_index] = gltf_accessor_span(r->doc, task_index % 2u, &sp, NULL);
+  r->ptr[task_index] = r->result[task_index] == GLTF_OK ? sp.ptr : NULL;
+}
+
+void test_35_sparse_materializes_once(void) {
+  size_t size = 0;
+  uint8_t* glb = t35_build(&size);
+  gltf_error err = {0};
+  test_assert_ok(gltf_load_glb_bytes(glb, size, &g_doc, &err), &err, "gltf_load_glb_bytes");
+
+  TEST_ASSERT_EQUAL_UINT32(2u, gltf_doc_accessor_sparse_count(g_doc, 0));
+  TEST_ASSERT_EQUAL_UINT32(0u, gltf_doc_accessor_sparse_count(g_doc, 3));
+  TEST_ASSERT_EQUAL_UINT32(0u, gltf_doc_accessor_sparse_count(g_doc, 9));
+
+  // First use from several threads at once.
+  t35_race race;
+  memset(&race, 0, sizeof race);
+  race.doc = g_doc;
+  gltf_thread_pool* pool = NULL;
+  test_assert_ok(gltf_thread_pool_create(4, &pool, &err), &err, "gltf_thread_pool_create");
+  gltf_thread_pool_dispatch(pool, 8u, t35_race_task, &race);
+  gltf_thread_pool_free(pool);
+  for (uint32_t i = 0; i < 8u; i++) {
+    TEST_ASSERT_EQUAL_INT(GLTF_OK, race.result[i]);
+    TEST_ASSERT_EQUAL_PTR(race.ptr[i % 2u], race.ptr[i]);
+  }
+
+  t35_check_doc(g_doc);
+  free(glb);
+}
+
+void test_35_sparse_baked_and_invalid(void) {
+  size_t size = 0;
+  uint8_t* glb = t35_build(&size);
+  gltf_error err = {0};
+  test_assert_ok(gltf_load_glb_bytes(glb, size, &g_doc, &err), &err, "gltf_load_glb_bytes");
+  gltf_span sp;
+  test_assert_ok(gltf_accessor_span(g_doc, 0, &sp, &err), &err, "span(0)");
+
+  // Baked documents keep the sparse sections and rebuild the copies.
+  const char* cache = GLTF_TEST_OUT_DIR "/t35_sparse.gltfb";
+  test_assert_ok(gltf_doc_save_baked(g_doc, cache, GLTF_BAKE_BUFFERS, &err), &err, "gltf_doc_save_baked");
+  gltf_doc* baked = NULL;
+  test_assert_ok(gltf_load_baked(cache, NULL, &baked, &err), &err, "gltf_load_baked");
+  t35_check_doc(baked);
+  gltf_free(baked);
+  free(glb);
+
+  static const char* const bad[] = {
+    "\"sparse\":{\"count\":0,\"indices\":{\"bufferView\":0,\"componentType\":5123},\"values\":{\"bufferView\":0}}",
+    "\"sparse\":{\"count\":2,\"indices\":{\"bufferView\":0,\"componentType\":5126},\"values\":{\"bufferView\":0}}",
+    "\"sparse\":{\"count\":2,\"indices\":{\"bufferView\":0,\"componentType\":5123}}",
+    "\"sparse\":[]",
+  };
+  for (uint32_t i = 0; i < (uint32_t)(sizeof bad / sizeof bad[0]); i++) {
+    char json[512];
+    (void)snprintf(json, sizeof json,
+                   "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":16}],"
+                   "\"bufferViews\":[{\"buffer\":0,\"byteLength\":16}],"
+                   "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":4,\"type\":\"SCALAR\",%s}]}",
+                   bad[i]);
+    uint8_t bin[16] = {0};
+    glb = test_build_glb(json, bin, sizeof bin, &size);
+    gltf_doc* doc = NULL;
+    TEST_ASSERT_EQUAL_INT(GLTF_ERR_PARSE, gltf_load_glb_bytes(glb, size, &doc, &err));
+    TEST_ASSERT_NULL(doc);
+    free(glb);
+  }
+
+  // Sparse views are range-checked with the accessor.
+  const char* overrun =
+    "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":16}],"
+    "\"bufferViews\":[{\"buffer\":0,\"byteLength\":16}],"
+    "\"accessors\":[{\"componentType\":5126,\"count\":8,\"type\":\"SCALAR\","
+    "\"sparse\":{\"count\":8,\"indices\":{\"bufferView\":0,\"componentType\":5123},"
+    "\"values\":{\"bufferView\":0,\"byteOffset\":4}}}]}";
+  gltf_free(g_doc);
+  g_doc = NULL;
+  uint8_t bin[16] = {0};
+  glb = test_build_glb(overrun, bin, sizeof bin, &size);
+  test_assert_ok(gltf_load_glb_bytes(glb, size, &g_doc, &err), &err, "gltf_load_glb_bytes(overrun)");
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_PARSE, gltf_accessor_span(g_doc, 0, &sp, &err));
+  TEST_ASSERT_EQUAL_STRING("sparse range out of bufferView bounds", err.message);
+  free(glb);
+}
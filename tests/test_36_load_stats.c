@@ -0,0 +1,290 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern gltf_doc* g_doc;
+
+#ifndef GLTF_ENABLE_STATS
+#define GLTF_ENABLE_STATS 1
+#endif
+
+#define T36_OUT GLTF_TEST_OUT_DIR "/t36_"
+#define T36_DATA_URI "data:application/octet-stream;base64,AAECAwQFBgc="
+
+// Begin/end events seen by the trace hook, in order.
+typedef struct t36_trace {
+  uint32_t count;
+  gltf_load_stage stage[64];
+  int end[64];
+} t36_trace;
+
+static void t36_trace_fn(void* user, gltf_load_stage stage, int end, double seconds) {
+  t36_trace* t = (t36_trace*)user;
+  TEST_ASSERT_TRUE(seconds >= 0.0);
+  if (!end) TEST_ASSERT_TRUE(seconds == 0.0);
+  if (t->count < 64u) {
+    t->stage[t->count] = stage;
+    t->end[t->count] = end;
+  }
+  t->count++;
+}
+
+// Every begin is followed by the end of the same stage, stages only move forward.
+static void t36_check_trace(const t36_trace* t, gltf_load_stage last) {
+  TEST_ASSERT_TRUE(t->count >= 2u && t->count <= 64u);
+  TEST_ASSERT_EQUAL_UINT32(0u, t->count % 2u);
+  for (uint32_t i = 0; i < t->count; i += 2u) {
+    TEST_ASSERT_EQUAL_INT(0, t->end[i]);
+    TEST_ASSERT_EQUAL_INT(1, t->end[i + 1u]);
+    TEST_ASSERT_EQUAL_INT(t->stage[i], t->stage[i + 1u]);
+    if (i) TEST_ASSERT_TRUE(t->stage[i] > t->stage[i - 2u]);
+  }
+  TEST_ASSERT_EQUAL_INT(last, t->stage[t->count - 1u]);
+}
+
+// Buffer time is split by source and lies within the BUFFERS stage.
+static void t36_check_buffer_seconds(const gltf_load_stats* stats, const gltf_buffer_stats* buffers) {
+  TEST_ASSERT_TRUE(buffers[0].seconds >= 0.0 && buffers[1].seconds >= 0.0);
+  TEST_ASSERT_TRUE(buffers[2].seconds == 0.0);
+  TEST_ASSERT_TRUE(stats->data_uri_seconds == buffers[0].seconds);
+  TEST_ASSERT_TRUE(stats->buffer_io_seconds == buffers[1].seconds);
+  TEST_ASSERT_TRUE(stats->data_uri_seconds + stats->buffer_io_seconds <=
+                   stats->stage_seconds[GLTF_LOAD_STAGE_BUFFERS] + 1e-6);
+}
+
+// Runs the tasks in order on the calling thread.
+static void t36_serial_dispatch(void* user, uint32_t task_count, gltf_task_fn task, void* task_user) {
+  (void)user;
+  for (uint32_t i = 0; i < task_count; i++) task(task_user, i);
+}
+
+static long t36_write_gltf(const char* path, const char* body) {
+  FILE* f = fopen(path, "wb");
+  TEST_ASSERT_NOT_NULL(f);
+  const size_t n = strlen(body);
+  TEST_ASSERT_EQUAL_size_t(n, fwrite(body, 1, n, f));
+  TEST_ASSERT_EQUAL_INT(0, fclose(f));
+  return (long)n;
+}
+
+void test_36_load_stats_gltf(void) {
+  uint8_t bin[16];
+  for (uint32_t i = 0; i < sizeof bin; i++) bin[i] = (uint8_t)i;
+  FILE* f = fopen(T36_OUT "buffer.bin", "wb");
+  TEST_ASSERT_NOT_NULL(f);
+  TEST_ASSERT_EQUAL_size_t(sizeof bin, fwrite(bin, 1, sizeof bin, f));
+  TEST_ASSERT_EQUAL_INT(0, fclose(f));
+
+  const char* path = T36_OUT "asset.gltf";
+  const long file_size = t36_write_gltf(path,
+    "{\"asset\":{\"version\":\"2.0\"},\"scene\":0,\"scenes\":[{\"nodes\":[0,1]}],"
+    "\"nodes\":[{\"name\":\"a\",\"mesh\":0},{\"name\":\"b\"}],"
+    "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0}}]}],"
+    "\"buffers\":[{\"byteLength\":8,\"uri\":\"" T36_DATA_URI "\"},"
+    "{\"byteLength\":16,\"uri\":\"t36_buffer.bin\"}],"
+    "\"bufferViews\":[{\"buffer\":1,\"byteLength\":12}],"
+    "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":1,\"type\":\"VEC3\"}]}");
+
+  gltf_buffer_stats buffers[3];
+  memset(buffers, 0xAB, sizeof buffers);
+  t36_trace trace;
+  memset(&trace, 0, sizeof trace);
+  gltf_load_stats stats;
+  memset(&stats, 0xCD, sizeof stats); // outputs are cleared by the load
+  stats.buffers = buffers;
+  stats.buffers_cap = 3u;
+  stats.trace = t36_trace_fn;
+  stats.trace_user = &trace;
+
+  gltf_load_options opts;
+  memset(&opts, 0, sizeof opts);
+  opts.stats = &stats;
+  gltf_error err = {0};
+  test_assert_ok(gltf_load_file_ex(path, &opts, &g_doc, &err), &err, "gltf_load_file_ex");
+
+  // Inputs survive the load.
+  TEST_ASSERT_EQUAL_PTR(buffers, stats.buffers);
+  TEST_ASSERT_EQUAL_UINT32(3u, stats.buffers_cap);
+  TEST_ASSERT_TRUE(stats.trace == t36_trace_fn);
+
+#if GLTF_ENABLE_STATS
+  TEST_ASSERT_EQUAL_UINT32(1u, stats.collected);
+  TEST_ASSERT_EQUAL_UINT64((uint64_t)file_size, stats.file_bytes);
+  TEST_ASSERT_EQUAL_UINT32(2u, stats.buffer_count);
+
+  TEST_ASSERT_EQUAL_UINT32(GLTF_BUFFER_STATS_DATA_URI, buffers[0].source);
+  TEST_ASSERT_EQUAL_UINT64(8u, buffers[0].bytes);
+  TEST_ASSERT_EQUAL_UINT64(strlen(T36_DATA_URI), buffers[0].source_bytes);
+  TEST_ASSERT_EQUAL_UINT32(GLTF_BUFFER_STATS_FILE_READ, buffers[1].source);
+  TEST_ASSERT_EQUAL_UINT64(16u, buffers[1].bytes);
+  TEST_ASSERT_EQUAL_UINT32(GLTF_BUFFER_STATS_NONE, buffers[2].source); // cleared, past buffer_count
+  TEST_ASSERT_EQUAL_UINT64(8u, stats.data_uri_bytes);
+  TEST_ASSERT_EQUAL_UINT64(strlen(T36_DATA_URI), stats.data_uri_text_bytes);
+  TEST_ASSERT_EQUAL_UINT64(16u, stats.buffer_read_bytes);
+  TEST_ASSERT_EQUAL_UINT64(0u, stats.buffer_mapped_bytes);
+  t36_check_buffer_seconds(&stats, buffers);
+
+  TEST_ASSERT_TRUE(stats.block_bytes > 0u);
+  TEST_ASSERT_TRUE(stats.block_used_bytes > 0u && stats.block_used_bytes <= stats.block_bytes);
+  TEST_ASSERT_TRUE(stats.string_used_bytes > 0u && stats.string_used_bytes <= stats.string_cap_bytes);
+  TEST_ASSERT_EQUAL_UINT32(2u, stats.index_used); // scene node list
+  TEST_ASSERT_TRUE(stats.index_used <= stats.index_cap);
+  TEST_ASSERT_TRUE(stats.json_alloc_count > 0u && stats.json_alloc_bytes > 0u);
+  TEST_ASSERT_TRUE(stats.heap_bytes >= stats.block_bytes + stats.json_alloc_bytes + 16u + (uint64_t)file_size);
+
+  for (uint32_t s = 0; s < GLTF_LOAD_STAGE_COUNT; s++) TEST_ASSERT_TRUE(stats.stage_seconds[s] >= 0.0);
+  TEST_ASSERT_EQUAL_INT(GLTF_LOAD_STAGE_READ, trace.stage[0]);
+  t36_check_trace(&trace, GLTF_LOAD_STAGE_INDEX);
+#else
+  (void)file_size;
+  TEST_ASSERT_EQUAL_UINT32(0u, stats.collected);
+  TEST_ASSERT_EQUAL_UINT32(0u, trace.count);
+#endif
+
+  TEST_ASSERT_EQUAL_STRING("read", gltf_load_stage_name(GLTF_LOAD_STAGE_READ));
+  TEST_ASSERT_EQUAL_STRING("buffer_views", gltf_load_stage_name(GLTF_LOAD_STAGE_BUFFER_VIEWS));
+  TEST_ASSERT_EQUAL_STRING("index", gltf_load_stage_name(GLTF_LOAD_STAGE_INDEX));
+  TEST_ASSERT_EQUAL_STRING("unknown", gltf_load_stage_name(GLTF_LOAD_STAGE_COUNT));
+
+  // Lazy buffers are not loaded, so they are not counted.
+  gltf_free(g_doc);
+  g_doc = NULL;
+  opts.flags = GLTF_LOAD_LAZY_BUFFERS;
+  memset(&trace, 0, sizeof trace);
+  test_assert_ok(gltf_load_file_ex(path, &opts, &g_doc, &err), &err, "gltf_load_file_ex(lazy)");
+#if GLTF_ENABLE_STATS
+  TEST_ASSERT_EQUAL_UINT32(GLTF_BUFFER_STATS_NONE, buffers[0].source);
+  TEST_ASSERT_EQUAL_UINT32(GLTF_BUFFER_STATS_NONE, buffers[1].source);
+  TEST_ASSERT_EQUAL_UINT64(0u, stats.data_uri_bytes + stats.buffer_read_bytes);
+  TEST_ASSERT_TRUE(stats.data_uri_seconds == 0.0 && stats.buffer_io_seconds == 0.0);
+  TEST_ASSERT_TRUE(buffers[0].seconds == 0.0 && buffers[1].seconds == 0.0);
+  t36_check_trace(&trace, GLTF_LOAD_STAGE_INDEX);
+#endif
+
+  // Dispatched buffer tasks time themselves; the load sums them afterwards.
+  gltf_free(g_doc);
+  g_doc = NULL;
+  opts.flags = 0u;
+  opts.dispatch = t36_serial_dispatch;
+  memset(&trace, 0, sizeof trace);
+  test_assert_ok(gltf_load_file_ex(path, &opts, &g_doc, &err), &err, "gltf_load_file_ex(dispatch)");
+#if GLTF_ENABLE_STATS
+  TEST_ASSERT_EQUAL_UINT32(GLTF_BUFFER_STATS_DATA_URI, buffers[0].source);
+  TEST_ASSERT_EQUAL_UINT32(GLTF_BUFFER_STATS_FILE_READ, buffers[1].source);
+  t36_check_buffer_seconds(&stats, buffers);
+  t36_check_trace(&trace, GLTF_LOAD_STAGE_INDEX);
+#endif
+}
+
+void test_36_load_stats_glb_and_failure(void) {
+  const char* json =
+    "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":12}],"
+    "\"bufferViews\":[{\"buffer\":0,\"byteLength\":12}],"
+    "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":1,\"type\":\"VEC3\"}]}";
+  const float bin[3] = { 1.0f, 2.0f, 3.0f };
+  size_t size = 0;
+  uint8_t* glb = test_build_glb(json, bin, sizeof bin, &size);
+
+  gltf_buffer_stats buffers[1];
+  gltf_load_stats stats;
+  memset(&stats, 0, sizeof stats);
+  stats.buffers = buffers;
+  stats.buffers_cap = 1u;
+  gltf_load_options opts;
+  memset(&opts, 0, sizeof opts);
+  opts.stats = &stats;
+  gltf_error err = {0};
+
+  test_assert_ok(gltf_load_glb_bytes_ex(glb, size, &opts, &g_doc, &err), &err, "gltf_load_glb_bytes_ex");
+#if GLTF_ENABLE_STATS
+  TEST_ASSERT_EQUAL_UINT32(1u, stats.collected);
+  TEST_ASSERT_EQUAL_UINT64(size, stats.file_bytes);
+  TEST_ASSERT_EQUAL_UINT32(GLTF_BUFFER_STATS_GLB_BIN, buffers[0].source);
+  TEST_ASSERT_EQUAL_UINT64(12u, buffers[0].bytes);
+  TEST_ASSERT_EQUAL_UINT64(12u, buffers[0].source_bytes);
+  TEST_ASSERT_TRUE(buffers[0].seconds == 0.0); // borrowed, nothing read or decoded
+  TEST_ASSERT_TRUE(stats.stage_seconds[GLTF_LOAD_STAGE_READ] == 0.0);
+  // The GLB copy of the BIN chunk and the JSON text are heap bytes too.
+  TEST_ASSERT_TRUE(stats.heap_bytes >= stats.block_bytes + stats.json_alloc_bytes + 12u);
+#endif
+  free(glb);
+
+  // A failing stage still reports its end; later stages are not run.
+  const char* bad =
+    "{\"asset\":{\"version\":\"2.0\"},\"nodes\":[{\"mesh\":\"x\"}]}";
+  glb = test_build_glb(bad, NULL, 0, &size);
+  t36_trace trace;
+  memset(&trace, 0, sizeof trace);
+  stats.trace = t36_trace_fn;
+  stats.trace_user = &trace;
+  gltf_doc* doc = NULL;
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_PARSE, gltf_load_glb_bytes_ex(glb, size, &opts, &doc, &err));
+  TEST_ASSERT_NULL(doc);
+#if GLTF_ENABLE_STATS
+  TEST_ASSERT_EQUAL_INT(GLTF_LOAD_STAGE_JSON, trace.stage[0]);
+  t36_check_trace(&trace, GLTF_LOAD_STAGE_NODES);
+  TEST_ASSERT_EQUAL_UINT32(0u, stats.buffer_count);
+#else
+  TEST_ASSERT_EQUAL_UINT32(0u, trace.count);
+#endif
+  free(glb);
+}
+
+void test_36_load_stats_embedded_buffer_block(void) {
+  // One embedded 192 KiB buffer plus an external one.
+  enum { T36_BIG = 196608 };
+  const size_t text_len = (size_t)T36_BIG / 3u * 4u;
+  const char* head = "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":196608,"
+                     "\"uri\":\"data:application/octet-stream;base64,";
+  const char* tail = "\"},{\"byteLength\":16,\"uri\":\"t36_buffer.bin\"}]}";
+  const size_t cap = strlen(head) + text_len + strlen(tail) + 1u;
+  char* json = (char*)malloc(cap);
+  TEST_ASSERT_NOT_NULL(json);
+  size_t o = strlen(head);
+  memcpy(json, head, o);
+  memset(json + o, 'A', text_len);
+  o += text_len;
+  memcpy(json + o, tail, strlen(tail) + 1u);
+
+  uint8_t bin[16] = {0};
+  FILE* f = fopen(T36_OUT "buffer.bin", "wb");
+  TEST_ASSERT_NOT_NULL(f);
+  TEST_ASSERT_EQUAL_size_t(sizeof bin, fwrite(bin, 1, sizeof bin, f));
+  TEST_ASSERT_EQUAL_INT(0, fclose(f));
+  const char* path = T36_OUT "embedded.gltf";
+  (void)t36_write_gltf(path, json);
+  free(json);
+
+  gltf_load_stats stats;
+  memset(&stats, 0, sizeof stats);
+  gltf_load_options opts;
+  memset(&opts, 0, sizeof opts);
+  opts.stats = &stats;
+  gltf_error err = {0};
+
+  // Decoded from the JSON text: the URI never reaches the string pool, so
+  // the block is sized by the document, not by the payload.
+  for (uint32_t pass = 0; pass < 2u; pass++) {
+    opts.flags = pass ? GLTF_LOAD_LAZY_BUFFERS : 0u;
+    test_assert_ok(gltf_load_file_ex(path, &opts, &g_doc, &err), &err, "gltf_load_file_ex(embedded)");
+#if GLTF_ENABLE_STATS
+    TEST_ASSERT_TRUE(stats.string_used_bytes <= stats.string_cap_bytes);
+    // Spare room: the external buffer's resolved path (kept for baking).
+    TEST_ASSERT_TRUE(stats.string_cap_bytes - stats.string_used_bytes < 1024u);
+    if (pass) {
+      TEST_ASSERT_TRUE(stats.string_used_bytes > text_len); // lazy keeps the URI
+    } else {
+      TEST_ASSERT_TRUE(stats.block_bytes < text_len / 16u);
+    }
+#endif
+    gltf_free(g_doc);
+    g_doc = NULL;
+  }
+}
@@ -0,0 +1,278 @@
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include "test_helpers.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern gltf_doc* g_doc;
+
+#define T37_OUT GLTF_TEST_OUT_DIR "/t37_"
+
+static void t37_write(const char* path, const void* data, size_t size) {
+  FILE* f = fopen(path, "wb");
+  TEST_ASSERT_NOT_NULL(f);
+  TEST_ASSERT_EQUAL_size_t(size, fwrite(data, 1, size, f));
+  TEST_ASSERT_EQUAL_INT(0, fclose(f));
+}
+
+// Reads a whole file into a NUL-terminated malloc'd buffer.
+static uint8_t* t37_read(const char* path, size_t* out_size) {
+  FILE* f = fopen(path, "rb");
+  TEST_ASSERT_NOT_NULL(f);
+  TEST_ASSERT_EQUAL_INT(0, fseek(f, 0, SEEK_END));
+  const long n = ftell(f);
+  TEST_ASSERT_TRUE(n >= 0);
+  TEST_ASSERT_EQUAL_INT(0, fseek(f, 0, SEEK_SET));
+  uint8_t* data = (uint8_t*)malloc((size_t)n + 1u);
+  TEST_ASSERT_NOT_NULL(data);
+  TEST_ASSERT_EQUAL_size_t((size_t)n, fread(data, 1, (size_t)n, f));
+  TEST_ASSERT_EQUAL_INT(0, fclose(f));
+  data[n] = 0;
+  *out_size = (size_t)n;
+  return data;
+}
+
+static uint32_t t37_u32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8u) | ((uint32_t)p[2] << 16u) | ((uint32_t)p[3] << 24u);
+}
+
+static void t37_check_f32(uint32_t accessor, uint32_t count, const float* expected) {
+  float v[8];
+  gltf_error err = {0};
+  test_assert_ok(gltf_accessor_read_f32_range(g_doc, accessor, 0, count, v, 0, &err), &err, "read_f32_range");
+  for (uint32_t i = 0; i < count; i++) TEST_ASSERT_TRUE(v[i] == expected[i]);
+}
+
+// .gltf with a data URI and an external buffer -> one GLB with an aligned BIN chunk.
+void test_37_repack_gltf_to_glb(void) {
+  const float ext[3] = { 3.0f, 4.0f, 5.0f };
+  t37_write(T37_OUT "ext.bin", ext, sizeof ext);
+  const char* json =
+    "{\"asset\":{\"version\":\"2.0\"},\"extras\":{\"keep\":true},"
+    "\"buffers\":[{\"byteLength\":8,\"uri\":\"data:application/octet-stream;base64,AACAPwAAAEA=\"},"
+    "{\"byteLength\":12,\"uri\":\"t37_ext.bin\"}],"
+    "\"bufferViews\":[{\"buffer\":0,\"byteLength\":8},"
+    "{\"buffer\":1,\"byteOffset\":4,\"byteLength\":8,"
+    "\"extensions\":{\"EXT_meshopt_compression\":{\"buffer\":1,\"byteLength\":8,\"byteStride\":4,"
+    "\"count\":2,\"mode\":\"ATTRIBUTES\"}}}],"
+    "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":2,\"type\":\"SCALAR\"},"
+    "{\"bufferView\":1,\"componentType\":5126,\"count\":2,\"type\":\"SCALAR\"}]}";
+  t37_write(T37_OUT "src.gltf", json, strlen(json));
+
+  gltf_repack_options opts;
+  memset(&opts, 0, sizeof opts);
+  opts.format = GLTF_REPACK_GLB;
+  gltf_error err = {0};
+  test_assert_ok(gltf_repack_file(T37_OUT "src.gltf", T37_OUT "out.glb", &opts, &err), &err, "gltf_repack_file");
+
+  size_t size = 0;
+  uint8_t* glb = t37_read(T37_OUT "out.glb", &size);
+  TEST_ASSERT_EQUAL_UINT32(0x46546C67u, t37_u32(glb));
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)size, t37_u32(glb + 8));
+  const uint32_t json_len = t37_u32(glb + 12);
+  TEST_ASSERT_EQUAL_UINT32(0u, json_len % 4u);
+  char* out_json = (char*)malloc(json_len + 1u);
+  TEST_ASSERT_NOT_NULL(out_json);
+  memcpy(out_json, glb + 20, json_len);
+  out_json[json_len] = 0;
+
+  // One merged buffer: data URI at 0, external file at 16 (default alignment).
+  TEST_ASSERT_NOT_NULL(strstr(out_json, "\"buffers\":[{\"byteLength\":28}]"));
+  TEST_ASSERT_NOT_NULL(strstr(out_json, "{\"buffer\":0,\"byteOffset\":20,\"byteLength\":8,"));
+  TEST_ASSERT_NOT_NULL(strstr(out_json, "{\"buffer\":0,\"byteLength\":8,\"byteStride\":4,"
+                                        "\"count\":2,\"mode\":\"ATTRIBUTES\",\"byteOffset\":16}"));
+  TEST_ASSERT_NOT_NULL(strstr(out_json, "\"extras\":{\"keep\":true}"));
+  TEST_ASSERT_NULL(strstr(out_json, "data:"));
+
+  const uint8_t* bin = glb + 20 + json_len;
+  TEST_ASSERT_EQUAL_UINT32(28u, t37_u32(bin));
+  TEST_ASSERT_EQUAL_UINT32(0x004E4942u, t37_u32(bin + 4));
+  TEST_ASSERT_EQUAL_size_t(size, (size_t)(bin - glb) + 8u + 28u);
+  static const uint8_t k_zeros[8] = {0};
+  TEST_ASSERT_EQUAL_MEMORY(k_zeros, bin + 8 + 8, 8); // alignment gap
+  TEST_ASSERT_EQUAL_MEMORY(ext, bin + 8 + 16, sizeof ext);
+  free(out_json);
+  free(glb);
+
+  test_assert_ok(gltf_load_file(T37_OUT "out.glb", &g_doc, &err), &err, "gltf_load_file");
+  const float a0[2] = { 1.0f, 2.0f };
+  const float a1[2] = { 4.0f, 5.0f };
+  t37_check_f32(0, 2, a0);
+  t37_check_f32(1, 2, a1);
+}
+
+// GLB (BIN chunk + data URI) -> pretty .gltf + .bin, then back to GLB.
+void test_37_repack_glb_to_gltf(void) {
+  const char* json =
+    "{\"asset\":{\"version\":\"2.0\"},"
+    "\"buffers\":[{\"byteLength\":8},"
+    "{\"byteLength\":16,\"uri\":\"data:application/octet-stream;base64,AADAQAAA4EAAAABBAAAQQQ==\"}],"
+    "\"bufferViews\":[{\"buffer\":1,\"byteOffset\":8,\"byteLength\":8},{\"buffer\":0,\"byteLength\":8}],"
+    "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":2,\"type\":\"SCALAR\"},"
+    "{\"bufferView\":1,\"componentType\":5126,\"count\":2,\"type\":\"SCALAR\"}]}";
+  const float bin[2] = { 1.0f, 2.0f };
+  size_t size = 0;
+  uint8_t* glb = test_build_glb(json, bin, sizeof bin, &size);
+  t37_write(T37_OUT "src.glb", glb, size);
+  free(glb);
+
+  gltf_repack_options opts;
+  memset(&opts, 0, sizeof opts);
+  opts.format = GLTF_REPACK_GLTF;
+  opts.flags = GLTF_REPACK_PRETTY_JSON;
+  opts.alignment = 64u;
+  gltf_error err = {0};
+  test_assert_ok(gltf_repack_file(T37_OUT "src.glb", T37_OUT "out.gltf", &opts, &err), &err, "gltf_repack_file");
+
+  size_t text_size = 0;
+  uint8_t* text = t37_read(T37_OUT "out.gltf", &text_size);
+  TEST_ASSERT_NOT_NULL(strstr((const char*)text, "\"uri\": \"t37_out.bin\""));
+  TEST_ASSERT_NOT_NULL(strstr((const char*)text, "\"byteLength\": 80"));
+  TEST_ASSERT_NOT_NULL(strchr((const char*)text, '\n'));
+  free(text);
+
+  size_t bin_size = 0;
+  uint8_t* merged = t37_read(T37_OUT "out.bin", &bin_size);
+  TEST_ASSERT_EQUAL_size_t(80u, bin_size);
+  TEST_ASSERT_EQUAL_MEMORY(bin, merged, sizeof bin);
+  free(merged);
+
+  test_assert_ok(gltf_load_file(T37_OUT "out.gltf", &g_doc, &err), &err, "gltf_load_file(gltf)");
+  const float a0[2] = { 8.0f, 9.0f };
+  const float a1[2] = { 1.0f, 2.0f };
+  t37_check_f32(0, 2, a0);
+  t37_check_f32(1, 2, a1);
+  gltf_free(g_doc);
+  g_doc = NULL;
+
+  // Back to GLB: the single external buffer becomes the BIN chunk.
+  opts.format = GLTF_REPACK_GLB;
+  opts.flags = 0;
+  opts.alignment = 0;
+  test_assert_ok(gltf_repack_file(T37_OUT "out.gltf", T37_OUT "round.glb", &opts, &err), &err, "gltf_repack_file(glb)");
+  test_assert_ok(gltf_load_file(T37_OUT "round.glb", &g_doc, &err), &err, "gltf_load_file(glb)");
+  t37_check_f32(0, 2, a0);
+  t37_check_f32(1, 2, a1);
+}
+
+// Uri-less meshopt fallback buffers keep no bytes and move after the merged buffer.
+void test_37_repack_meshopt_fallback(void) {
+  const char* json =
+    "{\"asset\":{\"version\":\"2.0\"},"
+    "\"extensionsUsed\":[\"EXT_meshopt_compression\"],"
+    "\"buffers\":[{\"byteLength\":64,\"extensions\":{\"EXT_meshopt_compression\":{\"fallback\":true}}},"
+    "{\"byteLength\":8,\"uri\":\"data:application/octet-stream;base64,AACAPwAAAEA=\"}],"
+    "\"bufferViews\":[{\"buffer\":0,\"byteLength\":64,"
+    "\"extensions\":{\"EXT_meshopt_compression\":{\"buffer\":1,\"byteOffset\":4,\"byteLength\":4,"
+    "\"byteStride\":4,\"count\":16,\"mode\":\"ATTRIBUTES\"}}},"
+    "{\"buffer\":1,\"byteLength\":8}]}";
+  t37_write(T37_OUT "meshopt.gltf", json, strlen(json));
+
+  gltf_repack_options opts;
+  memset(&opts, 0, sizeof opts);
+  opts.format = GLTF_REPACK_GLB;
+  gltf_error err = {0};
+  test_assert_ok(gltf_repack_file(T37_OUT "meshopt.gltf", T37_OUT "meshopt.glb", &opts, &err), &err,
+                 "gltf_repack_file");
+
+  size_t size = 0;
+  uint8_t* glb = t37_read(T37_OUT "meshopt.glb", &size);
+  const uint32_t json_len = t37_u32(glb + 12);
+  char* out_json = (char*)malloc(json_len + 1u);
+  TEST_ASSERT_NOT_NULL(out_json);
+  memcpy(out_json, glb + 20, json_len);
+  out_json[json_len] = 0;
+
+  TEST_ASSERT_NOT_NULL(strstr(out_json, "\"buffers\":[{\"byteLength\":8},"
+                                        "{\"byteLength\":64,\"extensions\":{\"EXT_meshopt_compression\":"
+                                        "{\"fallback\":true}}}]"));
+  TEST_ASSERT_NOT_NULL(strstr(out_json, "\"bufferViews\":[{\"buffer\":1,\"byteLength\":64,"
+                                        "\"extensions\":{\"EXT_meshopt_compression\":{\"buffer\":0,"
+                                        "\"byteOffset\":4,"));
+  TEST_ASSERT_NOT_NULL(strstr(out_json, "{\"buffer\":0,\"byteLength\":8}]"));
+
+  // The BIN chunk only holds the merged bytes, no zeros for the fallback.
+  const uint8_t* bin = glb + 20 + json_len;
+  const float expected[2] = { 1.0f, 2.0f };
+  TEST_ASSERT_EQUAL_UINT32(8u, t37_u32(bin));
+  TEST_ASSERT_EQUAL_MEMORY(expected, bin + 8, sizeof expected);
+  TEST_ASSERT_EQUAL_size_t(size, (size_t)(bin - glb) + 8u + 8u);
+  free(out_json);
+  free(glb);
+
+  // Only fallback buffers: no merged buffer, no .bin file.
+  const char* only =
+    "{\"asset\":{\"version\":\"2.0\"},"
+    "\"buffers\":[{\"byteLength\":16,\"extensions\":{\"EXT_meshopt_compression\":{\"fallback\":true}}}],"
+    "\"bufferViews\":[{\"buffer\":0,\"byteLength\":16}]}";
+  t37_write(T37_OUT "fallback_only.gltf", only, strlen(only));
+  (void)remove(T37_OUT "fallback_out.bin");
+  opts.format = GLTF_REPACK_GLTF;
+  test_assert_ok(gltf_repack_file(T37_OUT "fallback_only.gltf", T37_OUT "fallback_out.gltf", &opts, &err), &err,
+                 "gltf_repack_file(fallback only)");
+  uint8_t* text = t37_read(T37_OUT "fallback_out.gltf", &size);
+  TEST_ASSERT_NOT_NULL(strstr((const char*)text, "\"buffers\":[{\"byteLength\":16,"));
+  TEST_ASSERT_NULL(strstr((const char*)text, "\"uri\""));
+  free(text);
+  FILE* f = fopen(T37_OUT "fallback_out.bin", "rb");
+  TEST_ASSERT_NULL(f);
+}
+
+void test_37_repack_failures(void) {
+  gltf_repack_options opts;
+  memset(&opts, 0, sizeof opts);
+  gltf_error err = {0};
+
+  // Invalid options.
+  opts.format = GLTF_REPACK_GLB;
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_repack_file(NULL, T37_OUT "x.glb", &opts, &err));
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_repack_file(T37_OUT "src.gltf", T37_OUT "x.glb", NULL, &err));
+  opts.format = 3u;
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_repack_file(T37_OUT "src.gltf", T37_OUT "x.glb", &opts, &err));
+  opts.format = GLTF_REPACK_GLB;
+  opts.alignment = 24u;
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_repack_file(T37_OUT "src.gltf", T37_OUT "x.glb", &opts, &err));
+  opts.alignment = 2u;
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_INVALID, gltf_repack_file(T37_OUT "src.gltf", T37_OUT "x.glb", &opts, &err));
+  opts.alignment = 0;
+
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_IO, gltf_repack_file(T37_OUT "missing.gltf", T37_OUT "x.glb", &opts, &err));
+
+  // Bad buffer references and sizes; the previous output is left untouched.
+  const char* existing = "keep";
+  t37_write(T37_OUT "x.glb", existing, 4);
+  const char* bad_view =
+    "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":4,"
+    "\"uri\":\"data:application/octet-stream;base64,AAAAAA==\"}],"
+    "\"bufferViews\":[{\"buffer\":1,\"byteLength\":4}]}";
+  t37_write(T37_OUT "bad.gltf", bad_view, strlen(bad_view));
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_PARSE, gltf_repack_file(T37_OUT "bad.gltf", T37_OUT "x.glb", &opts, &err));
+
+  const char* bad_len =
+    "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":16,\"uri\":\"t37_ext.bin\"}]}";
+  t37_write(T37_OUT "bad.gltf", bad_len, strlen(bad_len));
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_PARSE, gltf_repack_file(T37_OUT "bad.gltf", T37_OUT "x.glb", &opts, &err));
+
+  const char* no_uri = "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":4}]}";
+  t37_write(T37_OUT "bad.gltf", no_uri, strlen(no_uri));
+  TEST_ASSERT_EQUAL_INT(GLTF_ERR_PARSE, gltf_repack_file(T37_OUT "bad.gltf", T37_OUT "x.glb", &opts, &err));
+
+  size_t size = 0;
+  uint8_t* kept = t37_read(T37_OUT "x.glb", &size);
+  TEST_ASSERT_EQUAL_size_t(4u, size);
+  TEST_ASSERT_EQUAL_MEMORY(existing, kept, 4);
+  free(kept);
+
+  // No buffers: no BIN chunk and no .bin file.
+  const char* empty = "{\"asset\":{\"version\":\"2.0\"}}";
+  t37_write(T37_OUT "empty.gltf", empty, strlen(empty));
+  test_assert_ok(gltf_repack_file(T37_OUT "empty.gltf", T37_OUT "x.glb", &opts, &err), &err, "repack(empty)");
+  uint8_t* glb = t37_read(T37_OUT "x.glb", &size);
+  TEST_ASSERT_EQUAL_size_t(20u + t37_u32(glb + 12), size);
+  free(glb);
+}
@@ -0,0 +1,78 @@
+// Shared helpers for tests that build small glTF documents in memory.
+//
+// Header-only; every function is static so each test file gets its own copy.
+
+#pragma once
+
+#include "unity.h"
+
+#include "gltf/gltf.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void test_write_u32_le(uint8_t* p, uint32_t v) {
+  p[0] = (uint8_t)(v & 0xFFu);
+  p[1] = (uint8_t)((v >> 8u) & 0xFFu);
+  p[2] = (uint8_t)((v >> 16u) & 0xFFu);
+  p[3] = (uint8_t)((v >> 24u) & 0xFFu);
+}
+
+// Builds a GLB container from a JSON string and an optional BIN payload.
+// The JSON chunk is padded with spaces and the BIN chunk with zeros.
+// Returns a malloc'd blob (caller frees) and writes its size to *out_size.
+static uint8_t* test_build_glb(const char* json,
+                               const void* bin,
+                               uint32_t bin_len,
+                               size_t* out_size) {
+  const uint32_t json_len = (uint32_t)strlen(json);
+  const uint32_t json_padded = (json_len + 3u) & ~3u;
+  const uint32_t bin_padded = (bin_len + 3u) & ~3u;
+  const uint32_t total = 12u + 8u + json_padded + (bin ? 8u + bin_padded : 0u);
+
+  uint8_t* glb = (uint8_t*)calloc(1, total);
+  TEST_ASSERT_NOT_NULL(glb);
+
+  test_write_u32_le(glb + 0, 0x46546C67u); // 'glTF'
+  test_write_u32_le(glb + 4, 2u);
+  test_write_u32_le(glb + 8, total);
+
+  uint32_t off = 12u;
+  test_write_u32_le(glb + off + 0, json_padded);
+  test_write_u32_le(glb + off + 4, 0x4E4F534Au); // 'JSON'
+  off += 8u;
+  memcpy(glb + off, json, json_len);
+  memset(glb + off + json_len, 0x20, json_padded - json_len);
+  off += json_padded;
+
+  if (bin) {
+    test_write_u32_le(glb + off + 0, bin_padded);
+    test_write_u32_le(glb + off + 4, 0x004E4942u); // 'BIN\0'
+    off += 8u;
+    memcpy(glb + off, bin, bin_len);
+    off += bin_padded;
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(total, off);
+  *out_size = (size_t)total;
+  return glb;
+}
+
+// Fails the current test with the error details if rc != GLTF_OK.
+static void test_assert_ok(gltf_result rc, const gltf_error* err, const char* what) {
+  if (rc != GLTF_OK) {
+    char buf[512];
+    (void)snprintf(buf,
+                   sizeof(buf),
+                   "%s failed rc=%d msg=%s path=%s line=%d col=%d",
+                   what,
+                   rc,
+                   (err && err->message) ? err->message : "(null)",
+                   (err && err->path) ? err->path : "(null)",
+                   err ? err->line : 0,
+                   err ? err->col : 0);
+    TEST_FAIL_MESSAGE(buf);
+  }
+}
@@ -20,6 +20,77 @@ void test_05_materials(void);
 void test_06_images_datauri(void);
 void test_07_load_glb(void);
 void test_07_load_glb_from_mem(void);
+void test_08_read_f32_range_matches_per_element(void);
+void test_08_read_f32_range_strided_subrange(void);
+void test_09_glb_borrow_bin(void);
+void test_09_glb_json_insitu(void);
+void test_09_glb_json_insitu_without_bin(void);
+void test_10_mmap_external_buffers(void);
+void test_10_mmap_glb(void);
+void test_10_mmap_missing_file(void);
+void test_11_lazy_external_buffer(void);
+void test_11_lazy_mmap_and_data_uri(void);
+void test_11_lazy_missing_buffer_fails_on_first_touch(void);
+void test_12_read_indices_u32_widen_and_minmax(void);
+void test_12_read_indices_u32_validation(void);
+void test_13_triangle_batches_match_topology(void);
+void test_13_read_triangles_ranges(void);
+void test_13_triangle_work_items_cover_doc(void);
+void test_14_accessor_aabb_all_encodings(void);
+void test_14_accessor_aabb_uses_bounds(void);
+void test_14_node_world_aabbs(void);
+void test_15_world_order_tree_and_scene_switch(void);
+void test_15_world_order_rejects_cycles(void);
+void test_15_world_dirty_subtree_update(void);
+void test_16_world_soa_matches_default(void);
+void test_17_thread_pool_runs_every_task_once(void);
+void test_17_world_parallel_matches_serial(void);
+void test_18_world_scene_switch_reuses_shared_nodes(void);
+void test_19_image_decode_batch(void);
+void test_20_image_cache_shares_entries(void);
+void test_20_image_cache_budget_eviction(void);
+void test_21_image_info_and_decode_into(void);
+void test_22_mips_box_layout_and_values(void);
+void test_22_mips_kaiser_srgb_parallel(void);
+void test_22_mips_from_document(void);
+void test_23_base64_bulk_matches_scalar(void);
+void test_23_base64_bulk_rejects_invalid(void);
+void test_24_datauri_buffers_from_file(void);
+void test_24_datauri_buffers_from_memory(void);
+void test_25_doc_block_custom_allocator(void);
+void test_25_doc_block_presize_many_strings(void);
+void test_26_baked_roundtrip_external_buffers(void);
+void test_26_baked_embedded_buffers_and_glb(void);
+void test_26_baked_rejects_bad_files(void);
+void test_26_baked_cached_load_invalidates(void);
+void test_27_load_sections_geometry_only(void);
+void test_27_load_sections_skip_buffers(void);
+void test_27_load_sections_image_buffer_view(void);
+void test_27_load_sections_cached(void);
+void test_28_parallel_buffer_loads(void);
+void test_28_load_files_batch(void);
+void test_29_io_serves_buffers_in_place(void);
+void test_29_io_reads_without_map(void);
+void test_30_glb_stream_views_become_ready(void);
+void test_30_glb_stream_sparse_waits_for_views(void);
+void test_30_glb_stream_matches_whole_file(void);
+void test_31_prim_view_fills_slots(void);
+void test_31_prim_view_lazy_and_baked(void);
+void test_32_name_index_matches_scan(void);
+void test_32_name_index_stream_and_baked(void);
+void test_33_pack_formats(void);
+void test_33_pack_conversions_and_batch(void);
+void test_34_meshopt_vertex_cache_and_fetch(void);
+void test_34_meshopt_batch(void);
+void test_35_sparse_materializes_once(void);
+void test_35_sparse_baked_and_invalid(void);
+void test_36_load_stats_gltf(void);
+void test_36_load_stats_glb_and_failure(void);
+void test_36_load_stats_embedded_buffer_block(void);
+void test_37_repack_gltf_to_glb(void);
+void test_37_repack_glb_to_gltf(void);
+void test_37_repack_meshopt_fallback(void);
+void test_37_repack_failures(void);
 
 void setUp(void) {
     g_doc = NULL;
@@ -49,5 +120,76 @@ int main(void) {
   RUN_TEST(test_06_images_datauri);
   RUN_TEST(test_07_load_glb);
   RUN_TEST(test_07_load_glb_from_mem);
+  RUN_TEST(test_08_read_f32_range_matches_per_element);
+  RUN_TEST(test_08_read_f32_range_strided_subrange);
+  RUN_TEST(test_09_glb_borrow_bin);
+  RUN_TEST(test_09_glb_json_insitu);
+  RUN_TEST(test_09_glb_json_insitu_without_bin);
+  RUN_TEST(test_10_mmap_external_buffers);
+  RUN_TEST(test_10_mmap_glb);
+  RUN_TEST(test_10_mmap_missing_file);
+  RUN_TEST(test_11_lazy_external_buffer);
+  RUN_TEST(test_11_lazy_mmap_and_data_uri);
+  RUN_TEST(test_11_lazy_missing_buffer_fails_on_first_touch);
+  RUN_TEST(test_12_read_indices_u32_widen_and_minmax);
+  RUN_TEST(test_12_read_indices_u32_validation);
+  RUN_TEST(test_13_triangle_batches_match_topology);
+  RUN_TEST(test_13_read_triangles_ranges);
+  RUN_TEST(test_13_triangle_work_items_cover_doc);
+  RUN_TEST(test_14_accessor_aabb_all_encodings);
+  RUN_TEST(test_14_accessor_aabb_uses_bounds);
+  RUN_TEST(test_14_node_world_aabbs);
+  RUN_TEST(test_15_world_order_tree_and_scene_switch);
+  RUN_TEST(test_15_world_order_rejects_cycles);
+  RUN_TEST(test_15_world_dirty_subtree_update);
+  RUN_TEST(test_16_world_soa_matches_default);
+  RUN_TEST(test_17_thread_pool_runs_every_task_once);
+  RUN_TEST(test_17_world_parallel_matches_serial);
+  RUN_TEST(test_18_world_scene_switch_reuses_shared_nodes);
+  RUN_TEST(test_19_image_decode_batch);
+  RUN_TEST(test_20_image_cache_shares_entries);
+  RUN_TEST(test_20_image_cache_budget_eviction);
+  RUN_TEST(test_21_image_info_and_decode_into);
+  RUN_TEST(test_22_mips_box_layout_and_values);
+  RUN_TEST(test_22_mips_kaiser_srgb_parallel);
+  RUN_TEST(test_22_mips_from_document);
+  RUN_TEST(test_23_base64_bulk_matches_scalar);
+  RUN_TEST(test_23_base64_bulk_rejects_invalid);
+  RUN_TEST(test_24_datauri_buffers_from_file);
+  RUN_TEST(test_24_datauri_buffers_from_memory);
+  RUN_TEST(test_25_doc_block_custom_allocator);
+  RUN_TEST(test_25_doc_block_presize_many_strings);
+  RUN_TEST(test_26_baked_roundtrip_external_buffers);
+  RUN_TEST(test_26_baked_embedded_buffers_and_glb);
+  RUN_TEST(test_26_baked_rejects_bad_files);
+  RUN_TEST(test_26_baked_cached_load_invalidates);
+  RUN_TEST(test_27_load_sections_geometry_only);
+  RUN_TEST(test_27_load_sections_skip_buffers);
+  RUN_TEST(test_27_load_sections_image_buffer_view);
+  RUN_TEST(test_27_load_sections_cached);
+  RUN_TEST(test_28_parallel_buffer_loads);
+  RUN_TEST(test_28_load_files_batch);
+  RUN_TEST(test_29_io_serves_buffers_in_place);
+  RUN_TEST(test_29_io_reads_without_map);
+  RUN_TEST(test_30_glb_stream_views_become_ready);
+  RUN_TEST(test_30_glb_stream_sparse_waits_for_views);
+  RUN_TEST(test_30_glb_stream_matches_whole_file);
+  RUN_TEST(test_31_prim_view_fills_slots);
+  RUN_TEST(test_31_prim_view_lazy_and_baked);
+  RUN_TEST(test_32_name_index_matches_scan);
+  RUN_TEST(test_32_name_index_stream_and_baked);
+  RUN_TEST(test_33_pack_formats);
+  RUN_TEST(test_33_pack_conversions_and_batch);
+  RUN_TEST(test_34_meshopt_vertex_cache_and_fetch);
+  RUN_TEST(test_34_meshopt_batch);
+  RUN_TEST(test_35_sparse_materializes_once);
+  RUN_TEST(test_35_sparse_baked_and_invalid);
+  RUN_TEST(test_36_load_stats_gltf);
+  RUN_TEST(test_36_load_stats_glb_and_failure);
+  RUN_TEST(test_36_load_stats_embedded_buffer_block);
+  RUN_TEST(test_37_repack_gltf_to_glb);
+  RUN_TEST(test_37_repack_glb_to_gltf);
+  RUN_TEST(test_37_repack_meshopt_fallback);
+  RUN_TEST(test_37_repack_failures);
   return UNITY_END();
 }